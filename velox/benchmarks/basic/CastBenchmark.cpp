@@ -64,6 +64,20 @@ int main(int argc, char** argv) {
       [](auto row) { return fmt::format("2024-05-{:02d}", 1 + row % 30); });
   auto invalidDateStrings = vectorMaker.flatVector<std::string>(
       vectorSize, [](auto row) { return fmt::format("2024-05...{}", row); });
+  auto bigintStrings = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return std::to_string(row * 1'234'567'891L); });
+  auto doubleStrings = vectorMaker.flatVector<std::string>(
+      vectorSize,
+      [](auto row) { return fmt::format("{}.{:02d}", row * 37, row % 100); });
+  auto timestampStrings =
+      vectorMaker.flatVector<std::string>(vectorSize, [](auto row) {
+        return fmt::format(
+            "2024-05-{:02d} 12:{:02d}:{:02d}.123",
+            1 + row % 30,
+            row % 60,
+            row / 60 % 60);
+      });
 
   emptyInput->resize(vectorSize);
   validInput->resize(vectorSize);
@@ -106,6 +120,16 @@ int main(int argc, char** argv) {
           "tryexpr_cast_invalid_input", "try(cast (invalid_date as timestamp))")
       .addExpression("cast_valid", "cast(valid_date as timestamp)");
 
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "cast_varchar_as_number",
+          vectorMaker.rowVector(
+              {"bigint_string", "double_string", "timestamp_string"},
+              {bigintStrings, doubleStrings, timestampStrings}))
+      .addExpression("cast_bigint", "cast(bigint_string as bigint)")
+      .addExpression("cast_double", "cast(double_string as double)")
+      .addExpression("cast_timestamp", "cast(timestamp_string as timestamp)");
+
   benchmarkBuilder
       .addBenchmarkSet(
           "cast_timestamp_as_varchar",
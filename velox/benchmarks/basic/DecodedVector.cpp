@@ -48,6 +48,15 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     for (size_t i = 0; i < 5; ++i) {
       dictionaryNestedVector_ = fuzzer.fuzzDictionary(dictionaryNestedVector_);
     }
+
+    // Generate nested dictionary vector with nulls added by the dictionaries.
+    opts.nullRatio = 0.1;
+    VectorFuzzer nullsFuzzer(opts, pool(), FLAGS_fuzzer_seed);
+    dictionaryNestedWithNullsVector_ = fuzzer.fuzzFlat(BIGINT());
+    for (size_t i = 0; i < 5; ++i) {
+      dictionaryNestedWithNullsVector_ =
+          nullsFuzzer.fuzzDictionary(dictionaryNestedWithNullsVector_);
+    }
   }
 
   // Runs a fast path over a flat vector (no decoding).
@@ -118,6 +127,12 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
   }
 
+  // Measure time to decode a 5-way nested dictionary vector where the
+  // dictionaries add nulls.
+  void decodeDictionary5NestedWithNulls() {
+    DecodedVector decodedVector(*dictionaryNestedWithNullsVector_, rows_);
+  }
+
  private:
   void decodedRun(const DecodedVector& decodedVector) {
     size_t sum = 0;
@@ -133,6 +148,7 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
   VectorPtr constantVector_;
   VectorPtr dictionaryVector_;
   VectorPtr dictionaryNestedVector_;
+  VectorPtr dictionaryNestedWithNullsVector_;
 
   SelectivityVector rows_;
 };
@@ -185,6 +201,10 @@ BENCHMARK(decodeDictionary5Nested) {
   run([&] { benchmark->decodeDictionary5Nested(); });
 }
 
+BENCHMARK(decodeDictionary5NestedWithNulls) {
+  run([&] { benchmark->decodeDictionary5NestedWithNulls(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/String.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/hash/Hash.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/file/tests/FaultyFileSystem.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/dwio/parquet/RegisterParquetReader.h"
+#include "velox/dwio/parquet/RegisterParquetWriter.h"
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+/// Benchmarks end-to-end selective scans through the Hive connector. Each
+/// benchmark scans a generated file with a filter on a BIGINT 'key' column and
+/// loads all other columns. The benchmarks are the cross product of the file
+/// formats, column types, column counts, filter selectivities and cache modes
+/// given by the flags below. The name of a benchmark is
+/// <format>_<column type>_<columns>cols_<selectivity>pct_<cache mode>.
+///
+/// Remote storage is emulated by --storage_latency_us, which delays each read
+/// of the data files.
+
+DEFINE_string(
+    formats,
+    "dwrf,parquet",
+    "Comma separated file formats. Parquet needs VELOX_ENABLE_PARQUET.");
+
+DEFINE_string(
+    column_types,
+    "bigint,varchar,nested",
+    "Comma separated types of the scanned columns besides the key column. "
+    "'nested' cycles through ARRAY, MAP and ROW columns.");
+
+DEFINE_string(
+    num_columns,
+    "1,16",
+    "Comma separated numbers of scanned columns besides the key column.");
+
+DEFINE_string(
+    selectivity_pcts,
+    "0.1,1,10,100",
+    "Comma separated percentages of rows that pass the filter.");
+
+DEFINE_string(
+    cache_modes,
+    "cold,warm",
+    "Comma separated cache modes. 'cold' clears the caches before each scan. "
+    "'warm' scans data that is in the memory cache. 'ssd' clears only the "
+    "memory cache before each scan so that data comes from the SSD cache. "
+    "Caching requires --cache_gb > 0 and 'ssd' requires --ssd_cache_gb > 0.");
+
+DEFINE_int32(num_rows, 1'000'000, "Number of rows in each file.");
+
+DEFINE_int32(batch_size, 10'000, "Number of rows in each written batch.");
+
+DEFINE_int32(cache_gb, 4, "Size of the memory cache in GB. 0 means no cache.");
+
+DEFINE_string(ssd_path, "", "Directory for the SSD cache.");
+
+DEFINE_int32(ssd_cache_gb, 0, "Size of the SSD cache in GB.");
+
+DEFINE_int32(
+    storage_latency_us,
+    0,
+    "Delay in microseconds added to each read of the data files to emulate "
+    "remote storage like S3. 0 reads local files directly.");
+
+DEFINE_int32(num_drivers, 4, "Number of drivers of the scan.");
+
+DEFINE_int32(num_splits, 8, "Number of splits per file.");
+
+DEFINE_int32(num_io_threads, 8, "Threads for speculative IO.");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+const std::string kHiveConnectorId = "test-hive";
+
+// The values of the filtered 'key' column are in [0, kFilterRange).
+constexpr int64_t kFilterRange = 1'000'000;
+
+enum class CacheMode { kCold, kWarm, kSsd };
+
+CacheMode toCacheMode(const std::string& name) {
+  if (name == "cold") {
+    return CacheMode::kCold;
+  }
+  if (name == "warm") {
+    return CacheMode::kWarm;
+  }
+  if (name == "ssd") {
+    return CacheMode::kSsd;
+  }
+  VELOX_USER_FAIL("Unknown cache mode: {}", name);
+}
+
+template <typename T>
+std::vector<T> splitFlag(const std::string& value) {
+  std::vector<T> result;
+  folly::splitTo<T>(',', value, std::back_inserter(result), true);
+  return result;
+}
+
+class ScanBenchmark {
+ public:
+  void initialize() {
+    if (FLAGS_cache_gb) {
+      memory::MemoryManagerOptions options;
+      options.useMmapAllocator = true;
+      options.allocatorCapacity = FLAGS_cache_gb * (1LL << 30);
+      options.useMmapArena = true;
+      options.mmapArenaCapacityRatio = 1;
+      memory::MemoryManager::testingSetInstance(options);
+      std::unique_ptr<cache::SsdCache> ssdCache;
+      if (FLAGS_ssd_cache_gb) {
+        constexpr int32_t kNumSsdShards = 16;
+        ssdExecutor_ =
+            std::make_unique<folly::IOThreadPoolExecutor>(kNumSsdShards);
+        const cache::SsdCache::Config config(
+            FLAGS_ssd_path,
+            static_cast<uint64_t>(FLAGS_ssd_cache_gb) << 30,
+            kNumSsdShards,
+            ssdExecutor_.get());
+        ssdCache = std::make_unique<cache::SsdCache>(config);
+      }
+      cache_ = cache::AsyncDataCache::create(
+          memory::memoryManager()->allocator(), std::move(ssdCache));
+      cache::AsyncDataCache::setInstance(cache_.get());
+    } else {
+      memory::MemoryManager::testingSetInstance({});
+    }
+    rootPool_ = memory::memoryManager()->addRootPool("ScanBenchmark");
+
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    parse::registerTypeResolver();
+    filesystems::registerLocalFileSystem();
+    tests::utils::registerFaultyFileSystem();
+    if (FLAGS_storage_latency_us > 0) {
+      tests::utils::faultyFileSystem()->setFileInjectionDelay(
+          FLAGS_storage_latency_us,
+          {tests::utils::FaultFileOperation::Type::kRead,
+           tests::utils::FaultFileOperation::Type::kReadv});
+    }
+    dwrf::registerDwrfReaderFactory();
+    dwrf::registerDwrfWriterFactory();
+    parquet::registerParquetReaderFactory();
+    parquet::registerParquetWriterFactory();
+
+    ioExecutor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(
+                kHiveConnectorId,
+                std::make_shared<core::MemConfig>(),
+                ioExecutor_.get());
+    connector::registerConnector(hiveConnector);
+  }
+
+  void shutdown() {
+    connector::unregisterConnector(kHiveConnectorId);
+    if (cache_) {
+      cache_->shutdown();
+    }
+  }
+
+  void registerBenchmarks() {
+    for (const auto& formatName : splitFlag<std::string>(FLAGS_formats)) {
+      const auto format = dwio::common::toFileFormat(formatName);
+      for (const auto& columnType :
+           splitFlag<std::string>(FLAGS_column_types)) {
+        for (auto numColumns : splitFlag<int32_t>(FLAGS_num_columns)) {
+          const auto rowType = makeRowType(columnType, numColumns);
+          const auto path = writeFile(format, rowType);
+          for (auto pct : splitFlag<double>(FLAGS_selectivity_pcts)) {
+            for (const auto& cacheMode :
+                 splitFlag<std::string>(FLAGS_cache_modes)) {
+              addBenchmark(
+                  fmt::format(
+                      "{}_{}_{}cols_{}pct_{}",
+                      formatName,
+                      columnType,
+                      numColumns,
+                      pct,
+                      cacheMode),
+                  path,
+                  format,
+                  rowType,
+                  pct,
+                  toCacheMode(cacheMode));
+            }
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  // Returns the type of a file with a BIGINT 'key' column and
+  // 'numColumns' columns of 'columnType'.
+  static RowTypePtr makeRowType(
+      const std::string& columnType,
+      int32_t numColumns) {
+    std::vector<std::string> names = {"key"};
+    std::vector<TypePtr> types = {BIGINT()};
+    for (auto i = 0; i < numColumns; ++i) {
+      names.push_back(fmt::format("c{}", i));
+      if (columnType == "bigint") {
+        types.push_back(BIGINT());
+      } else if (columnType == "varchar") {
+        types.push_back(VARCHAR());
+      } else if (columnType == "nested") {
+        switch (i % 3) {
+          case 0:
+            types.push_back(ARRAY(BIGINT()));
+            break;
+          case 1:
+            types.push_back(MAP(INTEGER(), VARCHAR()));
+            break;
+          default:
+            types.push_back(ROW({"x", "y"}, {BIGINT(), VARCHAR()}));
+        }
+      } else {
+        VELOX_USER_FAIL("Unknown column type: {}", columnType);
+      }
+    }
+    return ROW(std::move(names), std::move(types));
+  }
+
+  // Writes FLAGS_num_rows of random data of 'rowType' to a file of 'format'
+  // and returns its path. The 'key' column is a hash of the row number, so
+  // that the rows passing a range filter are spread over the file.
+  std::string writeFile(
+      dwio::common::FileFormat format,
+      const RowTypePtr& rowType) {
+    const auto path = fmt::format(
+        "{}/{}_{}.{}",
+        directory_->getPath(),
+        rowType->size() - 1,
+        std::hash<std::string>()(rowType->toString()),
+        dwio::common::toString(format));
+    auto writePool = rootPool_->addAggregateChild("write");
+    auto leafPool = rootPool_->addLeafChild("data");
+
+    dwio::common::WriterOptions options;
+    options.schema = rowType;
+    options.memoryPool = writePool.get();
+    auto writer = dwio::common::getWriterFactory(format)->createWriter(
+        dwio::common::FileSink::create(path, {.pool = leafPool.get()}),
+        options);
+
+    VectorFuzzer::Options fuzzerOptions;
+    fuzzerOptions.vectorSize = FLAGS_batch_size;
+    fuzzerOptions.nullRatio = 0.05;
+    fuzzerOptions.stringLength = 20;
+    fuzzerOptions.stringVariableLength = true;
+    fuzzerOptions.containerLength = 5;
+    fuzzerOptions.containerVariableLength = true;
+    VectorFuzzer fuzzer(fuzzerOptions, leafPool.get(), 1);
+    for (int64_t start = 0; start < FLAGS_num_rows; start += FLAGS_batch_size) {
+      const auto size = std::min<int64_t>(
+          FLAGS_batch_size, FLAGS_num_rows - start);
+      auto filter = BaseVector::create<FlatVector<int64_t>>(
+          BIGINT(), size, leafPool.get());
+      for (auto row = 0; row < size; ++row) {
+        filter->set(
+            row, folly::hash::twang_mix64(start + row) % kFilterRange);
+      }
+      std::vector<VectorPtr> children = {filter};
+      for (column_index_t i = 1; i < rowType->size(); ++i) {
+        children.push_back(fuzzer.fuzzFlat(rowType->childAt(i), size));
+      }
+      writer->write(std::make_shared<RowVector>(
+          leafPool.get(), rowType, nullptr, size, std::move(children)));
+    }
+    writer->close();
+
+    if (FLAGS_storage_latency_us > 0) {
+      return tests::utils::FaultyFileSystem::scheme() + path;
+    }
+    return path;
+  }
+
+  void addBenchmark(
+      const std::string& name,
+      const std::string& path,
+      dwio::common::FileFormat format,
+      const RowTypePtr& rowType,
+      double pct,
+      CacheMode cacheMode) {
+    folly::addBenchmark(
+        __FILE__,
+        name,
+        [this, path, format, rowType, pct, cacheMode](unsigned iterations) {
+          {
+            folly::BenchmarkSuspender suspender;
+            prepareCache(path, format, rowType, pct, cacheMode);
+          }
+          for (unsigned i = 0; i < iterations; ++i) {
+            if (cacheMode != CacheMode::kWarm) {
+              folly::BenchmarkSuspender suspender;
+              clearCache(cacheMode);
+            }
+            scan(path, format, rowType, pct);
+          }
+          return iterations;
+        });
+  }
+
+  // Fills the caches for 'cacheMode' with the data read by a scan.
+  void prepareCache(
+      const std::string& path,
+      dwio::common::FileFormat format,
+      const RowTypePtr& rowType,
+      double pct,
+      CacheMode cacheMode) {
+    if (cacheMode == CacheMode::kCold) {
+      return;
+    }
+    VELOX_USER_CHECK_NOT_NULL(cache_, "Cache mode needs --cache_gb > 0");
+    scan(path, format, rowType, pct);
+    if (cacheMode == CacheMode::kSsd) {
+      auto* ssdCache = cache_->ssdCache();
+      VELOX_USER_CHECK_NOT_NULL(ssdCache, "'ssd' needs --ssd_cache_gb > 0");
+      cache_->saveToSsd();
+      ssdCache->testingWaitForWriteToFinish();
+    }
+  }
+
+  void clearCache(CacheMode cacheMode) {
+    if (!cache_) {
+      return;
+    }
+    cache_->testingClear();
+    if (cacheMode == CacheMode::kCold && cache_->ssdCache()) {
+      cache_->ssdCache()->testingClear();
+    }
+  }
+
+  // Scans the file at 'path' with a filter passing 'pct' percent of the rows
+  // and loads all columns by counting their non-null values.
+  void scan(
+      const std::string& path,
+      dwio::common::FileFormat format,
+      const RowTypePtr& rowType,
+      double pct) {
+    std::vector<std::string> aggregates;
+    for (const auto& name : rowType->names()) {
+      aggregates.push_back(fmt::format("count({})", name));
+    }
+    core::PlanNodeId scanId;
+    CursorParameters params;
+    params.planNode =
+        PlanBuilder()
+            .tableScan(
+                rowType,
+                {fmt::format(
+                    "key < {}",
+                    static_cast<int64_t>(kFilterRange * pct / 100))})
+            .capturePlanNodeId(scanId)
+            .partialAggregation({}, aggregates)
+            .localPartition(std::vector<std::string>{})
+            .finalAggregation()
+            .planNode();
+    params.maxDrivers = FLAGS_num_drivers;
+
+    bool noMoreSplits = false;
+    auto addSplits = [&](Task* task) {
+      if (noMoreSplits) {
+        return;
+      }
+      for (auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+               path, FLAGS_num_splits, format)) {
+        task->addSplit(scanId, Split(std::move(split)));
+      }
+      task->noMoreSplits(scanId);
+      noMoreSplits = true;
+    };
+    auto results = readCursor(params, addSplits).second;
+    folly::doNotOptimizeAway(results);
+  }
+
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ssdExecutor_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  const std::shared_ptr<TempDirectoryPath> directory_ =
+      TempDirectoryPath::create();
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  ScanBenchmark benchmark;
+  benchmark.initialize();
+  benchmark.registerBenchmarks();
+  folly::runBenchmarks();
+  benchmark.shutdown();
+  return 0;
+}
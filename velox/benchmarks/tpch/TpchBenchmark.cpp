@@ -19,7 +19,10 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -28,6 +31,7 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/process/Profiler.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/dwio/common/Options.h"
@@ -67,6 +71,22 @@ void ensureTaskCompletion(exec::Task* task) {
   ASSERT_TRUE(waitForTaskCompletion(task));
 }
 
+// Returns the user and system CPU time of the process in nanoseconds.
+std::pair<int64_t, int64_t> processCpuNanos() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  auto tvNanos = [](struct timeval tv) {
+    return tv.tv_sec * 1000000000 + tv.tv_usec * 1000;
+  };
+  return {tvNanos(usage.ru_utime), tvNanos(usage.ru_stime)};
+}
+
+template <typename T>
+T median(std::vector<T> values) {
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
 void printResults(const std::vector<RowVectorPtr>& results, std::ostream& out) {
   out << "Results:" << std::endl;
   bool printType = true;
@@ -184,6 +204,40 @@ DEFINE_int32(
 
 DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
 
+DEFINE_string(
+    json_output,
+    "",
+    "If set, runs the queries in --queries --num_repeats times each and "
+    "writes their times and per operator statistics to this file as JSON");
+
+DEFINE_string(
+    queries,
+    "",
+    "Comma separated TPC-H query numbers to run with --json_output. Runs all "
+    "supported queries if empty");
+
+DEFINE_string(
+    baseline_json,
+    "",
+    "File written by --json_output for an earlier build. Queries whose median "
+    "time is more than --regression_pct slower than in this file are reported "
+    "and make the benchmark exit with an error");
+
+DEFINE_int32(
+    regression_pct,
+    10,
+    "Percentage of slowdown against --baseline_json reported as a regression");
+
+DEFINE_string(
+    profile_dir,
+    "",
+    "If set, profiles the queries run with --json_output with Linux perf and "
+    "writes the reports of query n under <profile_dir>/q<n>");
+
+// The TPC-H queries supported by TpchQueryBuilder.
+const std::vector<int32_t> kTpchQueries = {
+    1, 3, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22};
+
 struct RunStats {
   std::map<std::string, std::string> flags;
   int64_t micros{0};
@@ -280,45 +334,172 @@ class TpchBenchmark {
 
   std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
       const TpchPlan& tpchPlan) {
-    int32_t repeat = 0;
+    for (int32_t repeat = 1;; ++repeat) {
+      auto result = runOnce(tpchPlan);
+      if (!result.first || repeat >= FLAGS_num_repeats) {
+        return result;
+      }
+    }
+  }
+
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> runOnce(
+      const TpchPlan& tpchPlan) {
     try {
-      for (;;) {
-        CursorParameters params;
-        params.maxDrivers = FLAGS_num_drivers;
-        params.planNode = tpchPlan.plan;
-        params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
-            std::to_string(FLAGS_split_preload_per_driver);
-        const int numSplitsPerFile = FLAGS_num_splits_per_file;
-
-        bool noMoreSplits = false;
-        auto addSplits = [&](exec::Task* task) {
-          if (!noMoreSplits) {
-            for (const auto& entry : tpchPlan.dataFiles) {
-              for (const auto& path : entry.second) {
-                auto const splits =
-                    HiveConnectorTestBase::makeHiveConnectorSplits(
-                        path, numSplitsPerFile, tpchPlan.dataFileFormat);
-                for (const auto& split : splits) {
-                  task->addSplit(entry.first, exec::Split(split));
-                }
+      CursorParameters params;
+      params.maxDrivers = FLAGS_num_drivers;
+      params.planNode = tpchPlan.plan;
+      params.queryConfigs[core::QueryConfig::kMaxSplitPreloadPerDriver] =
+          std::to_string(FLAGS_split_preload_per_driver);
+      const int numSplitsPerFile = FLAGS_num_splits_per_file;
+
+      bool noMoreSplits = false;
+      auto addSplits = [&](exec::Task* task) {
+        if (!noMoreSplits) {
+          for (const auto& entry : tpchPlan.dataFiles) {
+            for (const auto& path : entry.second) {
+              auto const splits =
+                  HiveConnectorTestBase::makeHiveConnectorSplits(
+                      path, numSplitsPerFile, tpchPlan.dataFileFormat);
+              for (const auto& split : splits) {
+                task->addSplit(entry.first, exec::Split(split));
               }
-              task->noMoreSplits(entry.first);
             }
+            task->noMoreSplits(entry.first);
           }
-          noMoreSplits = true;
-        };
-        auto result = readCursor(params, addSplits);
-        ensureTaskCompletion(result.first->task().get());
-        if (++repeat >= FLAGS_num_repeats) {
-          return result;
         }
-      }
+        noMoreSplits = true;
+      };
+      auto result = readCursor(params, addSplits);
+      ensureTaskCompletion(result.first->task().get());
+      return result;
     } catch (const std::exception& e) {
       LOG(ERROR) << "Query terminated with: " << e.what();
       return {nullptr, std::vector<RowVectorPtr>()};
     }
   }
 
+  // Runs 'queryId' --num_repeats times. Returns the times of the runs and the
+  // per operator statistics of the last run.
+  folly::dynamic runQueryJson(int32_t queryId) {
+    const auto plan = queryBuilder->getQueryPlan(queryId);
+    folly::dynamic query = folly::dynamic::object("query", queryId);
+    folly::dynamic wallMicros = folly::dynamic::array;
+    folly::dynamic userNanos = folly::dynamic::array;
+    folly::dynamic systemNanos = folly::dynamic::array;
+    std::vector<int64_t> times;
+    if (!FLAGS_profile_dir.empty()) {
+      process::Profiler::start(
+          fmt::format("{}/q{}", FLAGS_profile_dir, queryId));
+    }
+    for (auto i = 0; i < FLAGS_num_repeats; ++i) {
+      const auto [startUser, startSystem] = processCpuNanos();
+      uint64_t micros = 0;
+      std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> result;
+      {
+        MicrosecondTimer timer(&micros);
+        result = runOnce(plan);
+      }
+      const auto [endUser, endSystem] = processCpuNanos();
+      if (!result.first) {
+        query["error"] = true;
+        break;
+      }
+      times.push_back(micros);
+      wallMicros.push_back(static_cast<int64_t>(micros));
+      userNanos.push_back(endUser - startUser);
+      systemNanos.push_back(endSystem - startSystem);
+      if (i == FLAGS_num_repeats - 1) {
+        const auto stats = result.first->task()->taskStats();
+        query["peakMemoryBytes"] = result.first->task()->pool()->peakBytes();
+        query["operators"] = toPlanStatsJson(stats);
+      }
+    }
+    if (!FLAGS_profile_dir.empty()) {
+      process::Profiler::stop();
+    }
+    query["wallMicros"] = wallMicros;
+    query["userNanos"] = userNanos;
+    query["systemNanos"] = systemNanos;
+    if (!times.empty()) {
+      query["medianWallMicros"] = median(times);
+    }
+    return query;
+  }
+
+  // Runs the queries in --queries and writes the results to --json_output.
+  // Returns the number of regressions against --baseline_json.
+  int32_t runJson() {
+    std::vector<int32_t> queryIds;
+    if (FLAGS_queries.empty()) {
+      queryIds = kTpchQueries;
+    } else {
+      folly::splitTo<int32_t>(
+          ',', FLAGS_queries, std::back_inserter(queryIds));
+    }
+    folly::dynamic queries = folly::dynamic::array;
+    for (auto queryId : queryIds) {
+      LOG(INFO) << "Running q" << queryId;
+      queries.push_back(runQueryJson(queryId));
+    }
+    folly::dynamic flags = folly::dynamic::object;
+    for (const auto* flag :
+         {"data_format",
+          "num_drivers",
+          "num_repeats",
+          "num_splits_per_file",
+          "cache_gb",
+          "ssd_cache_gb"}) {
+      std::string value;
+      gflags::GetCommandLineOption(flag, &value);
+      flags[flag] = value;
+    }
+    folly::dynamic json =
+        folly::dynamic::object("flags", flags)("queries", queries);
+    VELOX_CHECK(
+        folly::writeFile(folly::toPrettyJson(json), FLAGS_json_output.c_str()),
+        "Failed to write {}",
+        FLAGS_json_output);
+    return FLAGS_baseline_json.empty() ? 0 : compareWithBaseline(queries);
+  }
+
+  // Prints the median times of 'queries' next to the ones in --baseline_json.
+  // Returns the number of queries that are more than --regression_pct slower.
+  int32_t compareWithBaseline(const folly::dynamic& queries) {
+    std::string text;
+    VELOX_CHECK(
+        folly::readFile(FLAGS_baseline_json.c_str(), text),
+        "Failed to read {}",
+        FLAGS_baseline_json);
+    std::unordered_map<int64_t, int64_t> baselineMicros;
+    for (const auto& query : folly::parseJson(text)["queries"]) {
+      if (query.count("medianWallMicros")) {
+        baselineMicros[query["query"].asInt()] =
+            query["medianWallMicros"].asInt();
+      }
+    }
+    int32_t numRegressions = 0;
+    for (const auto& query : queries) {
+      const auto queryId = query["query"].asInt();
+      auto it = baselineMicros.find(queryId);
+      if (it == baselineMicros.end() || !query.count("medianWallMicros")) {
+        continue;
+      }
+      const auto micros = query["medianWallMicros"].asInt();
+      const auto pct = 100.0 * (micros - it->second) / it->second;
+      const bool regression = pct > FLAGS_regression_pct;
+      numRegressions += regression;
+      std::cout << fmt::format(
+                       "q{}: {} vs {} baseline ({:+.1f}%){}",
+                       queryId,
+                       succinctMicros(micros),
+                       succinctMicros(it->second),
+                       pct,
+                       regression ? " REGRESSION" : "")
+                << std::endl;
+    }
+    return numRegressions;
+  }
+
   void runMain(std::ostream& out, RunStats& runStats) {
     if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
       folly::runBenchmarks();
@@ -422,17 +603,12 @@ class TpchBenchmark {
       std::stringstream result;
       uint64_t micros = 0;
       {
-        struct rusage start;
-        getrusage(RUSAGE_SELF, &start);
+        const auto [startUser, startSystem] = processCpuNanos();
         MicrosecondTimer timer(&micros);
         runMain(result, stats);
-        struct rusage final;
-        getrusage(RUSAGE_SELF, &final);
-        auto tvNanos = [](struct timeval tv) {
-          return tv.tv_sec * 1000000000 + tv.tv_usec * 1000;
-        };
-        stats.userNanos = tvNanos(final.ru_utime) - tvNanos(start.ru_utime);
-        stats.systemNanos = tvNanos(final.ru_stime) - tvNanos(start.ru_stime);
+        const auto [endUser, endSystem] = processCpuNanos();
+        stats.userNanos = endUser - startUser;
+        stats.systemNanos = endSystem - startSystem;
       }
       stats.micros = micros;
       stats.output = result.str();
@@ -594,7 +770,10 @@ int tpchBenchmarkMain() {
   queryBuilder =
       std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
   queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
+  int32_t numRegressions = 0;
+  if (!FLAGS_json_output.empty()) {
+    numRegressions = benchmark.runJson();
+  } else if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
@@ -602,5 +781,5 @@ int tpchBenchmarkMain() {
   }
   benchmark.shutdown();
   queryBuilder.reset();
-  return 0;
+  return numRegressions > 0 ? 1 : 0;
 }
@@ -61,6 +61,27 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Sets bit 'firstBit + i' of 'result' if 'hashes[i]' may be in 'this' and
+  // clears it otherwise, for 'numHashes' hashes. Each probe touches one
+  // word. The word for a hash is prefetched a few hashes before it is
+  // tested, so that the cache misses of a large filter overlap.
+  void mayContain(
+      const uint64_t* hashes,
+      int32_t numHashes,
+      uint64_t* result,
+      int32_t firstBit = 0) const {
+    constexpr int32_t kPrefetchDistance = 8;
+    const auto* bloom = bits_.data();
+    const int32_t bloomSize = bits_.size();
+    for (auto i = 0; i < numHashes; ++i) {
+      if (i + kPrefetchDistance < numHashes) {
+        __builtin_prefetch(
+            &bloom[bloomIndex(bloomSize, hashes[i + kPrefetchDistance])]);
+      }
+      bits::setBit(result, firstBit + i, test(bloom, bloomSize, hashes[i]));
+    }
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -443,6 +443,28 @@ void registerVeloxMetrics() {
   DEFINE_HISTOGRAM_METRIC(
       kMetricSpillWriteTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
 
+  // The number of spill reads from storage, which is the number of read calls
+  // to velox filesystem.
+  DEFINE_METRIC(kMetricSpillReadsCount, facebook::velox::StatType::COUNT);
+
+  // The number of bytes read from spilled files.
+  DEFINE_METRIC(kMetricSpillReadBytes, facebook::velox::StatType::SUM);
+
+  // The distribution of the amount of time spent on reading spilled rows from
+  // disk in range of [0, 600s] with 20 buckets. It is configured to report the
+  // latency at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(
+      kMetricSpillReadTimeMs, 30'000, 0, 600'000, 50, 90, 99, 100);
+
+  // The distribution of the spill levels that the recursively spilling
+  // operators spill at in range of [0, 8] with 8 buckets. It is configured to
+  // report the level at P50, P90, P99, and P100 percentiles.
+  DEFINE_HISTOGRAM_METRIC(kMetricSpillLevel, 1, 0, 8, 50, 90, 99, 100);
+
+  // The number of rows spilled again after having been restored from a spilled
+  // partition. The ratio to spill_rows_count is the spill amplification.
+  DEFINE_METRIC(kMetricRespilledRowsCount, facebook::velox::StatType::SUM);
+
   // Tracks the number of times that we hit the max spill level limit.
   DEFINE_METRIC(
       kMetricMaxSpillLevelExceededCount, facebook::velox::StatType::COUNT);
@@ -135,6 +135,17 @@ constexpr folly::StringPiece kMetricSpillFlushTimeMs{
 constexpr folly::StringPiece kMetricSpillWriteTimeMs{
     "velox.spill_write_time_ms"};
 
+constexpr folly::StringPiece kMetricSpillReadsCount{"velox.spill_reads_count"};
+
+constexpr folly::StringPiece kMetricSpillReadBytes{"velox.spill_read_bytes"};
+
+constexpr folly::StringPiece kMetricSpillReadTimeMs{"velox.spill_read_time_ms"};
+
+constexpr folly::StringPiece kMetricSpillLevel{"velox.spill_level"};
+
+constexpr folly::StringPiece kMetricRespilledRowsCount{
+    "velox.spill_respilled_rows_count"};
+
 constexpr folly::StringPiece kMetricSpillMemoryBytes{
     "velox.spill_memory_bytes"};
 
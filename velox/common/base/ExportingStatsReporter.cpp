@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/ExportingStatsReporter.h"
+
+#include <fmt/format.h>
+#include <folly/json.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+namespace {
+
+static_assert((ExportingStatsReporter::kNumShards &
+               (ExportingStatsReporter::kNumShards - 1)) == 0);
+
+uint64_t currentTimeNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+std::string_view statTypeName(StatType statType) {
+  switch (statType) {
+    case StatType::AVG:
+      return "avg";
+    case StatType::SUM:
+      return "sum";
+    case StatType::RATE:
+      return "rate";
+    case StatType::COUNT:
+      return "count";
+  }
+  VELOX_UNREACHABLE();
+}
+
+// Replaces the characters that are not allowed in Prometheus metric names
+// with '_'.
+std::string prometheusName(const std::string& name) {
+  std::string result = name;
+  for (size_t i = 0; i < result.size(); ++i) {
+    const char c = result[i];
+    const bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+        c == '_' || c == ':' || (i > 0 && c >= '0' && c <= '9');
+    if (!valid) {
+      result[i] = '_';
+    }
+  }
+  return result;
+}
+
+// Returns the value at percentile 'pct' by linear interpolation inside the
+// bucket that contains it.
+int64_t estimatePercentile(
+    const MetricSnapshot::Histogram& histogram,
+    int64_t min,
+    int64_t max,
+    int32_t pct) {
+  if (histogram.count == 0) {
+    return 0;
+  }
+  const double rank = std::max<double>(1, pct / 100.0 * histogram.count);
+  uint64_t before = 0;
+  for (size_t i = 0; i < histogram.upperBounds.size(); ++i) {
+    const auto count = histogram.bucketCounts[i];
+    if (before + count >= rank) {
+      const int64_t lower = i == 0 ? min : histogram.upperBounds[i - 1];
+      const int64_t upper = histogram.upperBounds[i];
+      return lower +
+          static_cast<int64_t>((upper - lower) * ((rank - before) / count));
+    }
+    before += count;
+  }
+  return max;
+}
+
+folly::dynamic otelDataPoint(uint64_t startTimeNs, uint64_t timeNs) {
+  // OTLP JSON encodes 64-bit integers as strings.
+  return folly::dynamic::object(
+      "startTimeUnixNano", std::to_string(startTimeNs))(
+      "timeUnixNano", std::to_string(timeNs));
+}
+
+} // namespace
+
+ExportingStatsReporter::Histogram::Histogram(
+    int64_t _bucketWidth,
+    int64_t _min,
+    int64_t _max,
+    std::vector<int32_t> _pcts)
+    : bucketWidth(_bucketWidth),
+      min(_min),
+      max(_max),
+      pcts(std::move(_pcts)),
+      numBuckets((max - min + bucketWidth - 1) / bucketWidth + 1) {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    shards.push_back(std::make_unique<HistogramShard>(numBuckets));
+  }
+}
+
+size_t ExportingStatsReporter::Histogram::bucket(int64_t value) const {
+  if (value > max) {
+    return numBuckets - 1;
+  }
+  if (value <= min) {
+    return 0;
+  }
+  return (value - min - 1) / bucketWidth;
+}
+
+ExportingStatsReporter::ExportingStatsReporter()
+    : startTimeNs_(currentTimeNs()) {}
+
+// static
+size_t ExportingStatsReporter::shardIndex() {
+  static thread_local const size_t index =
+      std::hash<std::thread::id>{}(std::this_thread::get_id()) &
+      (kNumShards - 1);
+  return index;
+}
+
+void ExportingStatsReporter::registerMetric(
+    std::string_view key,
+    StatType statType) const {
+  std::unique_lock<folly::SharedMutex> l(mutex_);
+  auto& metric = metrics_[std::string(key)];
+  if (metric == nullptr) {
+    metric = std::make_unique<Metric>();
+  }
+  if (std::find(
+          metric->statTypes.begin(), metric->statTypes.end(), statType) ==
+      metric->statTypes.end()) {
+    metric->statTypes.push_back(statType);
+  }
+}
+
+void ExportingStatsReporter::registerHistogram(
+    std::string_view key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  VELOX_CHECK_GT(bucketWidth, 0, "Histogram {} has no bucket width", key);
+  VELOX_CHECK_LT(min, max, "Histogram {} has an empty range", key);
+  std::unique_lock<folly::SharedMutex> l(mutex_);
+  auto& histogram = histograms_[std::string(key)];
+  if (histogram == nullptr) {
+    histogram = std::make_unique<Histogram>(bucketWidth, min, max, pcts);
+  }
+}
+
+void ExportingStatsReporter::addValue(std::string_view key, size_t value)
+    const {
+  Metric* metric;
+  {
+    std::shared_lock<folly::SharedMutex> l(mutex_);
+    auto it = metrics_.find(key);
+    if (it == metrics_.end()) {
+      return;
+    }
+    metric = it->second.get();
+  }
+  auto& shard = metric->shards[shardIndex()];
+  shard.sum.fetch_add(value, std::memory_order_relaxed);
+  shard.count.fetch_add(1, std::memory_order_relaxed);
+  metric->last.store(value, std::memory_order_relaxed);
+}
+
+void ExportingStatsReporter::addHistogramValue(
+    std::string_view key,
+    size_t value) const {
+  Histogram* histogram;
+  {
+    std::shared_lock<folly::SharedMutex> l(mutex_);
+    auto it = histograms_.find(key);
+    if (it == histograms_.end()) {
+      return;
+    }
+    histogram = it->second.get();
+  }
+  auto& shard = *histogram->shards[shardIndex()];
+  const int64_t bucketValue =
+      std::min<size_t>(value, std::numeric_limits<int64_t>::max());
+  shard.buckets[histogram->bucket(bucketValue)].fetch_add(
+      1, std::memory_order_relaxed);
+  shard.sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+void ExportingStatsReporter::registerMetricExportType(
+    const char* key,
+    StatType statType) const {
+  registerMetric(key, statType);
+}
+
+void ExportingStatsReporter::registerMetricExportType(
+    folly::StringPiece key,
+    StatType statType) const {
+  registerMetric(std::string_view(key.data(), key.size()), statType);
+}
+
+void ExportingStatsReporter::registerHistogramMetricExportType(
+    const char* key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  registerHistogram(key, bucketWidth, min, max, pcts);
+}
+
+void ExportingStatsReporter::registerHistogramMetricExportType(
+    folly::StringPiece key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  registerHistogram(
+      std::string_view(key.data(), key.size()), bucketWidth, min, max, pcts);
+}
+
+void ExportingStatsReporter::addMetricValue(
+    const std::string& key,
+    size_t value) const {
+  addValue(key, value);
+}
+
+void ExportingStatsReporter::addMetricValue(const char* key, size_t value)
+    const {
+  addValue(key, value);
+}
+
+void ExportingStatsReporter::addMetricValue(
+    folly::StringPiece key,
+    size_t value) const {
+  addValue(std::string_view(key.data(), key.size()), value);
+}
+
+void ExportingStatsReporter::addHistogramMetricValue(
+    const std::string& key,
+    size_t value) const {
+  addHistogramValue(key, value);
+}
+
+void ExportingStatsReporter::addHistogramMetricValue(
+    const char* key,
+    size_t value) const {
+  addHistogramValue(key, value);
+}
+
+void ExportingStatsReporter::addHistogramMetricValue(
+    folly::StringPiece key,
+    size_t value) const {
+  addHistogramValue(std::string_view(key.data(), key.size()), value);
+}
+
+std::vector<MetricSnapshot> ExportingStatsReporter::snapshot() const {
+  std::vector<MetricSnapshot> result;
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  for (const auto& [key, metric] : metrics_) {
+    uint64_t sum = 0;
+    uint64_t count = 0;
+    for (const auto& shard : metric->shards) {
+      sum += shard.sum.load(std::memory_order_relaxed);
+      count += shard.count.load(std::memory_order_relaxed);
+    }
+    for (auto statType : metric->statTypes) {
+      MetricSnapshot snapshot;
+      snapshot.name = metric->statTypes.size() == 1
+          ? key
+          : fmt::format("{}.{}", key, statTypeName(statType));
+      snapshot.statType = statType;
+      switch (statType) {
+        case StatType::AVG:
+          snapshot.value = metric->last.load(std::memory_order_relaxed);
+          break;
+        case StatType::COUNT:
+          snapshot.value = count;
+          break;
+        case StatType::SUM:
+        case StatType::RATE:
+          snapshot.value = sum;
+          break;
+      }
+      result.push_back(std::move(snapshot));
+    }
+  }
+
+  for (const auto& [key, histogram] : histograms_) {
+    MetricSnapshot::Histogram values;
+    values.bucketCounts.resize(histogram->numBuckets);
+    for (const auto& shard : histogram->shards) {
+      for (size_t i = 0; i < histogram->numBuckets; ++i) {
+        values.bucketCounts[i] +=
+            shard->buckets[i].load(std::memory_order_relaxed);
+      }
+      values.sum += shard->sum.load(std::memory_order_relaxed);
+    }
+    // Derive the count from the buckets so that the two stay consistent
+    // while other threads are recording.
+    for (auto count : values.bucketCounts) {
+      values.count += count;
+    }
+    for (size_t i = 0; i + 1 < histogram->numBuckets; ++i) {
+      const int64_t bound =
+          histogram->min + static_cast<int64_t>(i + 1) * histogram->bucketWidth;
+      values.upperBounds.push_back(std::min(bound, histogram->max));
+    }
+    values.pcts = histogram->pcts;
+    for (auto pct : histogram->pcts) {
+      values.pctValues.push_back(
+          estimatePercentile(values, histogram->min, histogram->max, pct));
+    }
+    MetricSnapshot snapshot;
+    snapshot.name = key;
+    snapshot.histogram = std::move(values);
+    result.push_back(std::move(snapshot));
+  }
+  l.unlock();
+
+  std::sort(result.begin(), result.end(), [](const auto& a, const auto& b) {
+    return a.name < b.name;
+  });
+  return result;
+}
+
+std::string ExportingStatsReporter::toPrometheus() const {
+  return toPrometheusText(snapshot());
+}
+
+std::string ExportingStatsReporter::toOpenTelemetry() const {
+  return folly::toJson(
+      toOpenTelemetryJson(snapshot(), startTimeNs_, currentTimeNs()));
+}
+
+std::string toPrometheusText(const std::vector<MetricSnapshot>& metrics) {
+  std::string out;
+  for (const auto& metric : metrics) {
+    const auto name = prometheusName(metric.name);
+    if (!metric.histogram.has_value()) {
+      const bool gauge = metric.statType == StatType::AVG;
+      out += fmt::format(
+          "# TYPE {} {}\n{} {}\n",
+          name,
+          gauge ? "gauge" : "counter",
+          name,
+          metric.value);
+      continue;
+    }
+    const auto& histogram = metric.histogram.value();
+    out += fmt::format("# TYPE {} histogram\n", name);
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < histogram.upperBounds.size(); ++i) {
+      cumulative += histogram.bucketCounts[i];
+      out += fmt::format(
+          "{}_bucket{{le=\"{}\"}} {}\n",
+          name,
+          histogram.upperBounds[i],
+          cumulative);
+    }
+    out += fmt::format(
+        "{}_bucket{{le=\"+Inf\"}} {}\n{}_sum {}\n{}_count {}\n",
+        name,
+        histogram.count,
+        name,
+        histogram.sum,
+        name,
+        histogram.count);
+  }
+  return out;
+}
+
+folly::dynamic toOpenTelemetryJson(
+    const std::vector<MetricSnapshot>& metrics,
+    uint64_t startTimeNs,
+    uint64_t timeNs) {
+  // Values of 'aggregationTemporality' in the OTLP protocol.
+  constexpr int32_t kCumulative = 2;
+
+  auto otelMetrics = folly::dynamic::array();
+  for (const auto& metric : metrics) {
+    auto point = otelDataPoint(startTimeNs, timeNs);
+    auto otelMetric = folly::dynamic::object("name", metric.name);
+    if (!metric.histogram.has_value()) {
+      point["asInt"] = std::to_string(metric.value);
+      if (metric.statType == StatType::AVG) {
+        otelMetric["gauge"] =
+            folly::dynamic::object("dataPoints", folly::dynamic::array(point));
+      } else {
+        otelMetric["sum"] = folly::dynamic::object(
+            "dataPoints", folly::dynamic::array(point))(
+            "aggregationTemporality", kCumulative)("isMonotonic", true);
+      }
+      otelMetrics.push_back(std::move(otelMetric));
+      continue;
+    }
+    const auto& histogram = metric.histogram.value();
+    auto bucketCounts = folly::dynamic::array();
+    for (auto count : histogram.bucketCounts) {
+      bucketCounts.push_back(std::to_string(count));
+    }
+    auto bounds = folly::dynamic::array();
+    for (auto bound : histogram.upperBounds) {
+      bounds.push_back(static_cast<double>(bound));
+    }
+    point["count"] = std::to_string(histogram.count);
+    point["sum"] = static_cast<double>(histogram.sum);
+    point["bucketCounts"] = std::move(bucketCounts);
+    point["explicitBounds"] = std::move(bounds);
+    otelMetric["histogram"] = folly::dynamic::object(
+        "dataPoints", folly::dynamic::array(point))(
+        "aggregationTemporality", kCumulative);
+    otelMetrics.push_back(std::move(otelMetric));
+  }
+
+  auto scopeMetrics = folly::dynamic::object(
+      "scope", folly::dynamic::object("name", "velox"))(
+      "metrics", std::move(otelMetrics));
+  auto resource = folly::dynamic::object(
+      "attributes",
+      folly::dynamic::array(folly::dynamic::object("key", "service.name")(
+          "value", folly::dynamic::object("stringValue", "velox"))));
+  return folly::dynamic::object(
+      "resourceMetrics",
+      folly::dynamic::array(folly::dynamic::object("resource", resource)(
+          "scopeMetrics", folly::dynamic::array(scopeMetrics))));
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/SharedMutex.h>
+#include <folly/container/F14Map.h>
+#include <folly/dynamic.h>
+#include <folly/lang/Align.h>
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::velox {
+
+/// Point in time value of one exported metric.
+struct MetricSnapshot {
+  /// The key the metric is registered with. If a key is registered with more
+  /// than one StatType, the lower case type name is appended as a suffix, e.g.
+  /// 'velox.my_stat.sum'.
+  std::string name;
+
+  /// Set for metrics defined with DEFINE_METRIC.
+  std::optional<StatType> statType;
+
+  /// The sum of the recorded values for SUM and RATE, the number of recorded
+  /// values for COUNT and the last recorded value for AVG.
+  uint64_t value{0};
+
+  struct Histogram {
+    /// Inclusive upper bounds of the buckets. The last bucket counts the
+    /// values above the histogram max and has no explicit bound.
+    std::vector<int64_t> upperBounds;
+    /// Number of values per bucket. Has one more element than 'upperBounds'.
+    std::vector<uint64_t> bucketCounts;
+    uint64_t count{0};
+    uint64_t sum{0};
+    /// The percentiles the histogram is registered with and their values
+    /// estimated from the buckets.
+    std::vector<int32_t> pcts;
+    std::vector<int64_t> pctValues;
+  };
+
+  /// Set for metrics defined with DEFINE_HISTOGRAM_METRIC.
+  std::optional<Histogram> histogram;
+};
+
+/// BaseStatsReporter that aggregates the recorded values in process and
+/// exports them on demand in Prometheus text format or as OpenTelemetry OTLP
+/// JSON. The application serves the exported text from its own HTTP endpoint
+/// or pushes it to a collector. Usage:
+///
+///   folly::Singleton<facebook::velox::BaseStatsReporter> reporter([]() {
+///     return new facebook::velox::ExportingStatsReporter();
+///   });
+///   ...
+///   BaseStatsReporter::registered = true;
+///   registerVeloxMetrics();
+///   ...
+///   auto* exporter = dynamic_cast<ExportingStatsReporter*>(
+///       folly::Singleton<BaseStatsReporter>::try_get().get());
+///   std::string body = exporter->toPrometheus();
+///
+/// Recording a value takes a shared lock on the metric registry and updates
+/// relaxed atomics in a shard picked by the recording thread. Scraping sums
+/// up the shards. Values recorded for keys that were not registered are
+/// dropped.
+class ExportingStatsReporter : public BaseStatsReporter {
+ public:
+  /// Number of shards used for each counter and histogram. Must be a power of
+  /// 2.
+  static constexpr size_t kNumShards = 16;
+
+  ExportingStatsReporter();
+
+  void registerMetricExportType(const char* key, StatType statType)
+      const override;
+
+  void registerMetricExportType(folly::StringPiece key, StatType statType)
+      const override;
+
+  void registerHistogramMetricExportType(
+      const char* key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override;
+
+  void registerHistogramMetricExportType(
+      folly::StringPiece key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override;
+
+  void addMetricValue(const std::string& key, size_t value = 1)
+      const override;
+
+  void addMetricValue(const char* key, size_t value = 1) const override;
+
+  void addMetricValue(folly::StringPiece key, size_t value = 1)
+      const override;
+
+  void addHistogramMetricValue(const std::string& key, size_t value)
+      const override;
+
+  void addHistogramMetricValue(const char* key, size_t value) const override;
+
+  void addHistogramMetricValue(folly::StringPiece key, size_t value)
+      const override;
+
+  /// Returns the current values of all the registered metrics sorted by name.
+  std::vector<MetricSnapshot> snapshot() const;
+
+  /// Returns all the registered metrics in Prometheus text exposition format.
+  std::string toPrometheus() const;
+
+  /// Returns all the registered metrics as an OTLP ExportMetricsServiceRequest
+  /// in JSON encoding.
+  std::string toOpenTelemetry() const;
+
+ private:
+  struct alignas(folly::hardware_destructive_interference_size) Shard {
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> count{0};
+  };
+
+  struct Metric {
+    std::vector<StatType> statTypes;
+    Shard shards[kNumShards];
+    std::atomic<uint64_t> last{0};
+  };
+
+  struct alignas(folly::hardware_destructive_interference_size)
+      HistogramShard {
+    explicit HistogramShard(size_t numBuckets)
+        : buckets(new std::atomic<uint64_t>[numBuckets]()) {}
+
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets;
+    std::atomic<uint64_t> sum{0};
+  };
+
+  struct Histogram {
+    Histogram(
+        int64_t _bucketWidth,
+        int64_t _min,
+        int64_t _max,
+        std::vector<int32_t> _pcts);
+
+    // Returns the bucket for 'value'. Values below 'min' go to the first
+    // bucket and values above 'max' to the last one.
+    size_t bucket(int64_t value) const;
+
+    const int64_t bucketWidth;
+    const int64_t min;
+    const int64_t max;
+    const std::vector<int32_t> pcts;
+    // Buckets of 'bucketWidth' between 'min' and 'max' plus one overflow
+    // bucket.
+    const size_t numBuckets;
+    std::vector<std::unique_ptr<HistogramShard>> shards;
+  };
+
+  static size_t shardIndex();
+
+  void registerMetric(std::string_view key, StatType statType) const;
+
+  void registerHistogram(
+      std::string_view key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const;
+
+  void addValue(std::string_view key, size_t value) const;
+
+  void addHistogramValue(std::string_view key, size_t value) const;
+
+  // Time of creation. Used as the start of the cumulative OpenTelemetry
+  // metrics.
+  const uint64_t startTimeNs_;
+
+  mutable folly::SharedMutex mutex_;
+  // Metrics and histograms are never removed, so the recording threads can
+  // use the pointers after releasing 'mutex_'.
+  mutable folly::F14FastMap<std::string, std::unique_ptr<Metric>> metrics_;
+  mutable folly::F14FastMap<std::string, std::unique_ptr<Histogram>>
+      histograms_;
+};
+
+/// Formats 'metrics' in Prometheus text exposition format. Metric names are
+/// sanitized to [a-zA-Z0-9_:], e.g. 'velox.driver_yield_count' is exported as
+/// 'velox_driver_yield_count'. SUM, RATE and COUNT metrics are exported as
+/// counters, AVG metrics as gauges and histograms as Prometheus histograms
+/// with cumulative 'le' buckets.
+std::string toPrometheusText(const std::vector<MetricSnapshot>& metrics);
+
+/// Formats 'metrics' as an OTLP ExportMetricsServiceRequest. SUM, RATE and
+/// COUNT metrics are exported as cumulative monotonic sums starting at
+/// 'startTimeNs', AVG metrics as gauges and histograms as cumulative explicit
+/// bucket histograms.
+folly::dynamic toOpenTelemetryJson(
+    const std::vector<MetricSnapshot>& metrics,
+    uint64_t startTimeNs,
+    uint64_t timeNs);
+
+} // namespace facebook::velox
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+/// Computes remainders of the division by a divisor that is fixed at
+/// construction with multiplications and shifts instead of a division
+/// instruction. See Lemire, Kaser and Kurz, "Faster Remainder by Direct
+/// Computation" (2019). The results are exact and equal to the '%' operator.
+/// Used for taking hashes modulo a partition or bucket count, where a 64-bit
+/// division would dominate the cost per row.
+class FastModulo {
+ public:
+  explicit FastModulo(uint32_t divisor)
+      : divisor_(divisor),
+        m32_(~uint64_t{0} / checkDivisor(divisor) + 1),
+        m64_(~__uint128_t{0} / divisor + 1) {}
+
+  uint32_t divisor() const {
+    return divisor_;
+  }
+
+  /// Returns 'x' % divisor().
+  uint32_t mod32(uint32_t x) const {
+    const uint64_t lowBits = m32_ * x;
+    return (static_cast<__uint128_t>(lowBits) * divisor_) >> 64;
+  }
+
+  /// Returns 'x' % divisor().
+  uint32_t mod64(uint64_t x) const {
+    const __uint128_t lowBits = m64_ * x;
+    // High 64 bits of the 192-bit product of 'lowBits' and 'divisor_'.
+    const __uint128_t bottom =
+        (static_cast<__uint128_t>(static_cast<uint64_t>(lowBits)) *
+         divisor_) >>
+        64;
+    const __uint128_t top = (lowBits >> 64) * divisor_;
+    return (bottom + top) >> 64;
+  }
+
+ private:
+  static uint32_t checkDivisor(uint32_t divisor) {
+    VELOX_CHECK_GT(divisor, 0);
+    return divisor;
+  }
+
+  const uint32_t divisor_;
+  // ceil(2^64 / divisor_). 0 if divisor_ is 1.
+  const uint64_t m32_;
+  // ceil(2^128 / divisor_). 0 if divisor_ is 1.
+  const __uint128_t m64_;
+};
+
+} // namespace facebook::velox
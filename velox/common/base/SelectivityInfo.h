@@ -47,6 +47,15 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  /// Halves the accumulated counts and time so that recent measurements weigh
+  /// more than old ones when the data changes over time.
+  void decay() {
+    const auto numDropped = numIn_ - numOut_;
+    numIn_ /= 2;
+    numOut_ = numIn_ - numDropped / 2;
+    timeClocks_ /= 2;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <cstring>
 #include <numeric>
+#include <string_view>
 
 #if XSIMD_WITH_NEON
 namespace xsimd::types {
@@ -1436,4 +1438,41 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename A>
+int64_t findSubstring(
+    const char* data,
+    int64_t size,
+    const char* needle,
+    int64_t needleSize,
+    const A&) {
+  if (needleSize == 0) {
+    return 0;
+  }
+  if (needleSize > size) {
+    return -1;
+  }
+  using Batch = xsimd::batch<uint8_t, A>;
+  constexpr int64_t kBatch = Batch::size;
+  const auto first = Batch::broadcast(static_cast<uint8_t>(needle[0]));
+  const auto last =
+      Batch::broadcast(static_cast<uint8_t>(needle[needleSize - 1]));
+  auto* bytes = reinterpret_cast<const uint8_t*>(data);
+  int64_t offset = 0;
+  for (; offset + needleSize - 1 + kBatch <= size; offset += kBatch) {
+    uint64_t bits = toBitMask(
+        (Batch::load_unaligned(bytes + offset) == first) &
+        (Batch::load_unaligned(bytes + offset + needleSize - 1) == last));
+    while (bits) {
+      const auto candidate = offset + __builtin_ctzll(bits);
+      if (std::memcmp(data + candidate, needle, needleSize) == 0) {
+        return candidate;
+      }
+      bits &= bits - 1;
+    }
+  }
+  const auto position = std::string_view(data + offset, size - offset)
+                            .find(std::string_view(needle, needleSize));
+  return position == std::string_view::npos ? -1 : offset + position;
+}
+
 } // namespace facebook::velox::simd
@@ -497,6 +497,18 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Returns the offset of the first occurrence of 'needle' of 'needleSize' bytes
+// in 'data' of 'size' bytes or -1 if there is none. Compares the first and
+// last byte of 'needle' at a batch of positions at a time and checks only the
+// positions where both match.
+template <typename A = xsimd::default_arch>
+int64_t findSubstring(
+    const char* data,
+    int64_t size,
+    const char* needle,
+    int64_t needleSize,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
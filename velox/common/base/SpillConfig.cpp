@@ -33,7 +33,11 @@ SpillConfig::SpillConfig(
     uint64_t _maxSpillRunRows,
     uint64_t _writerFlushThresholdSize,
     const std::string& _compressionKind,
-    const std::string& _fileCreateConfig)
+    const std::string& _fileCreateConfig,
+    bool _encodeSortedRuns,
+    bool _asyncIo,
+    SpillFileOffloadCB _offloadCb,
+    bool _joinSerializedRows)
     : getSpillDirPathCb(std::move(_getSpillDirPathCb)),
       updateAndCheckSpillLimitCb(std::move(_updateAndCheckSpillLimitCb)),
       fileNamePrefix(std::move(_fileNamePrefix)),
@@ -50,7 +54,11 @@ SpillConfig::SpillConfig(
       maxSpillRunRows(_maxSpillRunRows),
       writerFlushThresholdSize(_writerFlushThresholdSize),
       compressionKind(common::stringToCompressionKind(_compressionKind)),
-      fileCreateConfig(_fileCreateConfig) {
+      fileCreateConfig(_fileCreateConfig),
+      encodeSortedRuns(_encodeSortedRuns),
+      asyncIo(_asyncIo),
+      offloadCb(std::move(_offloadCb)),
+      joinSerializedRows(_joinSerializedRows) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
@@ -37,6 +37,11 @@ namespace facebook::velox::common {
 /// Implementations can use it to ensure the path exists before returning.
 using GetSpillDirectoryPathCB = std::function<std::string_view()>;
 
+/// The callback invoked when a spill file of 'fileSize' bytes is finished.
+/// Returns the directory to move the file to, or an empty string to keep the
+/// file in the local spill directory.
+using SpillFileOffloadCB = std::function<std::string(uint64_t fileSize)>;
+
 /// The callback used to update the aggregated spill bytes of a query. If the
 /// query spill limit is set, the callback throws if the aggregated spilled
 /// bytes exceed the set limit.
@@ -60,7 +65,11 @@ struct SpillConfig {
       uint64_t _maxSpillRunRows,
       uint64_t _writerFlushThresholdSize,
       const std::string& _compressionKind,
-      const std::string& _fileCreateConfig = {});
+      const std::string& _fileCreateConfig = {},
+      bool _encodeSortedRuns = false,
+      bool _asyncIo = false,
+      SpillFileOffloadCB _offloadCb = nullptr,
+      bool _joinSerializedRows = false);
 
   /// Returns the spilling level with given 'startBitOffset' and
   /// 'numPartitionBits'.
@@ -73,6 +82,12 @@ struct SpillConfig {
   /// the max hash join spill limit.
   bool exceedSpillLevelLimit(uint8_t startBitOffset) const;
 
+  /// Returns the executor for asynchronous spill file writes and read-ahead,
+  /// nullptr if spill IO is synchronous.
+  folly::Executor* ioExecutor() const {
+    return asyncIo ? executor : nullptr;
+  }
+
   /// A callback function that returns the spill directory path. Implementations
   /// can use it to ensure the path exists before returning.
   GetSpillDirectoryPathCB getSpillDirPathCb;
@@ -132,5 +147,23 @@ struct SpillConfig {
 
   /// Custom options passed to velox::FileSystem to create spill WriteFile.
   std::string fileCreateConfig;
+
+  /// If true, sorted spill runs are written with the runs of equal values of
+  /// each column dictionary encoded before compression.
+  bool encodeSortedRuns{false};
+
+  /// If true and 'executor' is set, spill files are written in the background
+  /// on 'executor' while the next batch is serialized, and the next buffer of
+  /// a spill file is read ahead on 'executor' when reading spilled data.
+  bool asyncIo{false};
+
+  /// If set, finished spill files are moved to the directory it returns, for
+  /// example on a remote object store, to free local spill space. Spilled data
+  /// is read back from the moved files.
+  SpillFileOffloadCB offloadCb;
+
+  /// If true, the hash join tables are spilled as serialized RowContainer rows
+  /// with the join keys as separate columns for repartitioning.
+  bool joinSerializedRows{false};
 };
 } // namespace facebook::velox::common
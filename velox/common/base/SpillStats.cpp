@@ -301,12 +301,22 @@ void updateGlobalSpillWriteStats(
 void updateGlobalSpillReadStats(
     uint64_t spillReadBytes,
     uint64_t spillRadTimeUs) {
+  RECORD_METRIC_VALUE(kMetricSpillReadsCount);
+  RECORD_METRIC_VALUE(kMetricSpillReadBytes, spillReadBytes);
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricSpillReadTimeMs, spillRadTimeUs / 1'000);
   auto statsLocked = localSpillStats().wlock();
   ++statsLocked->spillReads;
   statsLocked->spillReadBytes += spillReadBytes;
   statsLocked->spillReadTimeUs += spillRadTimeUs;
 }
 
+void updateGlobalSpillLevelStats(int32_t level, uint64_t numRows) {
+  RECORD_HISTOGRAM_METRIC_VALUE(kMetricSpillLevel, level);
+  if (level > 0) {
+    RECORD_METRIC_VALUE(kMetricRespilledRowsCount, numRows);
+  }
+}
+
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes) {
   RECORD_METRIC_VALUE(kMetricSpilledInputBytes, spilledInputBytes);
   auto statsLocked = localSpillStats().wlock();
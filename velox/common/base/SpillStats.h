@@ -145,6 +145,10 @@ void updateGlobalSpillReadStats(
     uint64_t spillReadBytes,
     uint64_t spillRadTimeUs);
 
+/// Updates the stats of the rows spilled at spill 'level' by the operators
+/// that spill recursively.
+void updateGlobalSpillLevelStats(int32_t level, uint64_t numRows);
+
 /// Increments the spill memory bytes.
 void updateGlobalSpillMemoryBytes(uint64_t spilledInputBytes);
 
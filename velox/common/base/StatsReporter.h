@@ -20,8 +20,9 @@
 #include <memory>
 
 /// StatsReporter designed to assist in reporting various metrics of the
-/// application that uses velox library. The library itself does not implement
-/// the StatsReporter and it should be implemented by the application.
+/// application that uses velox library. The application either implements the
+/// StatsReporter for its monitoring service or uses ExportingStatsReporter,
+/// which exports the metrics in Prometheus or OpenTelemetry format.
 ///
 /// To initialize the reporter singleton in your application use this pattern
 /// (note that MyReporter should implement the abstract class
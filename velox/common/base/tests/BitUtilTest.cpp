@@ -159,6 +159,29 @@ TEST_F(BitUtilTest, reverseBits) {
   }
 }
 
+TEST_F(BitUtilTest, reverseAndNegateBits) {
+  uint8_t bytes[100];
+  for (size_t i = 0; i < 100; i++) {
+    bytes[i] = rand();
+  }
+
+  // Sizes that are and are not multiples of 8 bytes.
+  for (auto numBytes : {0, 1, 7, 8, 9, 64, 99}) {
+    SCOPED_TRACE(numBytes);
+    uint8_t expected[100];
+    memcpy(expected, bytes, numBytes);
+    reverseBits(expected, numBytes);
+    negate(reinterpret_cast<char*>(expected), numBytes * 8);
+
+    uint8_t actual[100];
+    memcpy(actual, bytes, numBytes);
+    reverseAndNegateBits(actual, numBytes);
+    for (auto i = 0; i < numBytes; i++) {
+      ASSERT_EQ(actual[i], expected[i]) << i;
+    }
+  }
+}
+
 TEST_F(BitUtilTest, isAllSet) {
   std::vector<uint64_t> data(100);
   fillBits(&data[0], 11, 222, true);
@@ -42,6 +42,29 @@ TEST_F(BloomFilterTest, basic) {
   EXPECT_GT(2, 100 * numFalsePositives / kSize);
 }
 
+TEST_F(BloomFilterTest, batch) {
+  constexpr int32_t kSize = 1024;
+  BloomFilter bloom;
+  bloom.reset(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int32_t>()(i));
+  }
+  std::vector<uint64_t> hashes;
+  for (auto i = 0; i < 2 * kSize; ++i) {
+    hashes.push_back(folly::hasher<int32_t>()(i));
+  }
+  // Results start at bit 3 and the other bits stay set.
+  std::vector<uint64_t> result(bits::nwords(2 * kSize + 3), ~0UL);
+  bloom.mayContain(hashes.data(), hashes.size(), result.data(), 3);
+  for (auto i = 0; i < hashes.size(); ++i) {
+    EXPECT_EQ(bloom.mayContain(hashes[i]), bits::isBitSet(result.data(), i + 3))
+        << i;
+  }
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(bits::isBitSet(result.data(), i));
+  }
+}
+
 TEST_F(BloomFilterTest, serialize) {
   constexpr int32_t kSize = 1024;
   BloomFilter bloom;
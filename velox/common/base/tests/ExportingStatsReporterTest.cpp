@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/ExportingStatsReporter.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "velox/common/base/tests/GTestUtils.h"
+
+namespace facebook::velox {
+namespace {
+
+const MetricSnapshot& findMetric(
+    const std::vector<MetricSnapshot>& metrics,
+    const std::string& name) {
+  for (const auto& metric : metrics) {
+    if (metric.name == name) {
+      return metric;
+    }
+  }
+  VELOX_FAIL("Metric {} not found", name);
+}
+
+TEST(ExportingStatsReporterTest, counters) {
+  ExportingStatsReporter reporter;
+  reporter.registerMetricExportType("velox.sum", StatType::SUM);
+  reporter.registerMetricExportType("velox.count", StatType::COUNT);
+  reporter.registerMetricExportType("velox.avg", StatType::AVG);
+  reporter.registerMetricExportType("velox.both", StatType::SUM);
+  reporter.registerMetricExportType("velox.both", StatType::COUNT);
+
+  reporter.addMetricValue("velox.sum", 10);
+  reporter.addMetricValue(std::string("velox.sum"), 20);
+  reporter.addMetricValue(folly::StringPiece("velox.sum"));
+  reporter.addMetricValue("velox.count", 100);
+  reporter.addMetricValue("velox.count", 100);
+  reporter.addMetricValue("velox.avg", 5);
+  reporter.addMetricValue("velox.avg", 7);
+  reporter.addMetricValue("velox.both", 3);
+  reporter.addMetricValue("velox.both", 4);
+  // Not registered.
+  reporter.addMetricValue("velox.unknown", 1);
+
+  const auto metrics = reporter.snapshot();
+  ASSERT_EQ(metrics.size(), 5);
+  EXPECT_EQ(findMetric(metrics, "velox.sum").value, 31);
+  EXPECT_EQ(findMetric(metrics, "velox.count").value, 2);
+  EXPECT_EQ(findMetric(metrics, "velox.avg").value, 7);
+  EXPECT_EQ(findMetric(metrics, "velox.both.sum").value, 7);
+  EXPECT_EQ(findMetric(metrics, "velox.both.count").value, 2);
+
+  const auto text = reporter.toPrometheus();
+  EXPECT_NE(
+      text.find("# TYPE velox_sum counter\nvelox_sum 31\n"), std::string::npos);
+  EXPECT_NE(
+      text.find("# TYPE velox_avg gauge\nvelox_avg 7\n"), std::string::npos);
+  EXPECT_NE(text.find("velox_both_count 2\n"), std::string::npos);
+  EXPECT_EQ(text.find("unknown"), std::string::npos);
+}
+
+TEST(ExportingStatsReporterTest, histogram) {
+  ExportingStatsReporter reporter;
+  reporter.registerHistogramMetricExportType(
+      "velox.latency", 10, 0, 100, {50, 90, 100});
+  reporter.registerHistogramMetricExportType(
+      folly::StringPiece("velox.unaligned"), 30, 0, 100, {});
+  for (auto i = 1; i <= 100; ++i) {
+    reporter.addHistogramMetricValue("velox.latency", i);
+  }
+  // Above max.
+  reporter.addHistogramMetricValue("velox.latency", 1'000);
+  reporter.addHistogramMetricValue("velox.unaligned", 95);
+  reporter.addHistogramMetricValue("velox.unaligned", 101);
+
+  const auto metrics = reporter.snapshot();
+  ASSERT_EQ(metrics.size(), 2);
+  const auto& latency = findMetric(metrics, "velox.latency").histogram.value();
+  ASSERT_EQ(latency.upperBounds.size(), 10);
+  ASSERT_EQ(latency.bucketCounts.size(), 11);
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_EQ(latency.upperBounds[i], (i + 1) * 10);
+    EXPECT_EQ(latency.bucketCounts[i], 10);
+  }
+  EXPECT_EQ(latency.bucketCounts[10], 1);
+  EXPECT_EQ(latency.count, 101);
+  EXPECT_EQ(latency.sum, 5'050 + 1'000);
+  EXPECT_EQ(latency.pctValues, std::vector<int64_t>({50, 90, 100}));
+
+  const auto& unaligned =
+      findMetric(metrics, "velox.unaligned").histogram.value();
+  EXPECT_EQ(unaligned.upperBounds, std::vector<int64_t>({30, 60, 90, 100}));
+  EXPECT_EQ(unaligned.bucketCounts, std::vector<uint64_t>({0, 0, 0, 1, 1}));
+
+  const auto text = reporter.toPrometheus();
+  EXPECT_NE(text.find("# TYPE velox_latency histogram\n"), std::string::npos);
+  EXPECT_NE(
+      text.find("velox_latency_bucket{le=\"10\"} 10\n"), std::string::npos);
+  EXPECT_NE(
+      text.find("velox_latency_bucket{le=\"100\"} 100\n"), std::string::npos);
+  EXPECT_NE(
+      text.find("velox_latency_bucket{le=\"+Inf\"} 101\n"), std::string::npos);
+  EXPECT_NE(text.find("velox_latency_sum 6050\n"), std::string::npos);
+  EXPECT_NE(text.find("velox_latency_count 101\n"), std::string::npos);
+
+  VELOX_ASSERT_THROW(
+      reporter.registerHistogramMetricExportType("velox.bad", 0, 0, 10, {}),
+      "Histogram velox.bad has no bucket width");
+}
+
+TEST(ExportingStatsReporterTest, openTelemetry) {
+  ExportingStatsReporter reporter;
+  reporter.registerMetricExportType("velox.sum", StatType::SUM);
+  reporter.registerMetricExportType("velox.avg", StatType::AVG);
+  reporter.registerHistogramMetricExportType("velox.latency", 50, 0, 100, {});
+  reporter.addMetricValue("velox.sum", 3);
+  reporter.addMetricValue("velox.avg", 4);
+  reporter.addHistogramMetricValue("velox.latency", 60);
+
+  const auto json = folly::parseJson(reporter.toOpenTelemetry());
+  const auto& scope = json["resourceMetrics"][0]["scopeMetrics"][0];
+  EXPECT_EQ(scope["scope"]["name"], "velox");
+  const auto& metrics = scope["metrics"];
+  ASSERT_EQ(metrics.size(), 3);
+
+  EXPECT_EQ(metrics[0]["name"], "velox.avg");
+  EXPECT_EQ(metrics[0]["gauge"]["dataPoints"][0]["asInt"], "4");
+
+  EXPECT_EQ(metrics[1]["name"], "velox.latency");
+  const auto& histogram = metrics[1]["histogram"];
+  EXPECT_EQ(histogram["aggregationTemporality"], 2);
+  const auto& point = histogram["dataPoints"][0];
+  EXPECT_EQ(point["count"], "1");
+  EXPECT_EQ(point["sum"], 60.0);
+  EXPECT_EQ(point["explicitBounds"], folly::dynamic::array(50.0, 100.0));
+  EXPECT_EQ(point["bucketCounts"], folly::dynamic::array("0", "1", "0"));
+
+  EXPECT_EQ(metrics[2]["name"], "velox.sum");
+  const auto& sum = metrics[2]["sum"];
+  EXPECT_TRUE(sum["isMonotonic"].asBool());
+  EXPECT_EQ(sum["dataPoints"][0]["asInt"], "3");
+  EXPECT_LE(
+      std::stoull(sum["dataPoints"][0]["startTimeUnixNano"].asString()),
+      std::stoull(sum["dataPoints"][0]["timeUnixNano"].asString()));
+}
+
+TEST(ExportingStatsReporterTest, concurrentRecording) {
+  ExportingStatsReporter reporter;
+  reporter.registerMetricExportType("velox.sum", StatType::SUM);
+  reporter.registerHistogramMetricExportType("velox.latency", 10, 0, 100, {});
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumValues = 10'000;
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < kNumValues; ++j) {
+        reporter.addMetricValue("velox.sum", 2);
+        reporter.addHistogramMetricValue("velox.latency", j % 100);
+        if (j % 1'000 == 0) {
+          reporter.snapshot();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto metrics = reporter.snapshot();
+  EXPECT_EQ(
+      findMetric(metrics, "velox.sum").value, 2 * kNumThreads * kNumValues);
+  const auto& latency = findMetric(metrics, "velox.latency").histogram.value();
+  EXPECT_EQ(latency.count, kNumThreads * kNumValues);
+}
+
+} // namespace
+} // namespace facebook::velox
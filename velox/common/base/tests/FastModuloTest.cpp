@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/FastModulo.h"
+
+#include <folly/Random.h>
+#include <gtest/gtest.h>
+
+namespace facebook::velox {
+namespace {
+
+TEST(FastModuloTest, basic) {
+  const std::vector<uint32_t> divisors = {
+      1, 2, 3, 7, 10, 64, 100, 1'000, 4'096, 65'537, 1u << 31, UINT32_MAX};
+  const std::vector<uint64_t> edgeValues = {
+      0, 1, 2, 63, 64, 99, 100, UINT32_MAX, 1ULL << 32, UINT64_MAX};
+  folly::Random::DefaultGenerator rng(1);
+  for (auto divisor : divisors) {
+    SCOPED_TRACE(divisor);
+    FastModulo modulo(divisor);
+    EXPECT_EQ(modulo.divisor(), divisor);
+    std::vector<uint64_t> values = edgeValues;
+    for (auto i = 0; i < 1'000; ++i) {
+      values.push_back(folly::Random::rand64(rng));
+    }
+    for (auto value : values) {
+      ASSERT_EQ(modulo.mod64(value), value % divisor) << value;
+      const auto value32 = static_cast<uint32_t>(value);
+      ASSERT_EQ(modulo.mod32(value32), value32 % divisor) << value32;
+    }
+  }
+}
+
+TEST(FastModuloTest, zeroDivisor) {
+  EXPECT_THROW(FastModulo(0), VeloxRuntimeError);
+}
+
+} // namespace
+} // namespace facebook::velox
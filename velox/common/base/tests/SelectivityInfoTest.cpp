@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SelectivityInfo.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+
+TEST(SelectivityInfoTest, decay) {
+  SelectivityInfo info;
+  { SelectivityTimer timer(info, 101); }
+  info.addOutput(10);
+
+  info.decay();
+  EXPECT_EQ(50, info.numIn());
+  // Keeps half of the 91 dropped rows.
+  EXPECT_EQ(5, info.numOut());
+
+  info.decay();
+  info.decay();
+  EXPECT_EQ(12, info.numIn());
+  EXPECT_LE(info.numOut(), info.numIn());
+
+  // Recent measurements dominate after decaying.
+  for (auto i = 0; i < 10; ++i) {
+    info.decay();
+  }
+  { SelectivityTimer timer(info, 100); }
+  info.addOutput(100);
+  EXPECT_EQ(100, info.numIn());
+  EXPECT_EQ(100, info.numOut());
+}
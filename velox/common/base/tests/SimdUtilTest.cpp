@@ -453,6 +453,32 @@ TEST_F(SimdUtilTest, memEqualUnsafe) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+TEST_F(SimdUtilTest, findSubstring) {
+  std::string data(200, 'a');
+  auto find = [&](std::string_view needle) {
+    return simd::findSubstring(
+        data.data(), data.size(), needle.data(), needle.size());
+  };
+  EXPECT_EQ(find(""), 0);
+  EXPECT_EQ(find("a"), 0);
+  EXPECT_EQ(find("b"), -1);
+  EXPECT_EQ(find(std::string(201, 'a')), -1);
+
+  // Matches in the SIMD loop, at the end of a batch and in the tail.
+  for (auto position : {0, 31, 32, 63, 100, 190, 195}) {
+    std::fill(data.begin(), data.end(), 'a');
+    data.replace(position, 5, "bxcyb");
+    EXPECT_EQ(find("bxcyb"), position);
+    EXPECT_EQ(find("b"), position);
+    // First and last bytes match but the middle does not.
+    EXPECT_EQ(find("bxxyb"), -1);
+  }
+  std::fill(data.begin(), data.end(), 'a');
+  data.replace(40, 3, "bab");
+  data.replace(150, 3, "bcb");
+  EXPECT_EQ(find("bcb"), 150);
+}
+
 TEST_F(SimdUtilTest, memcpyTime) {
   constexpr int64_t kMaxMove = 128;
   constexpr int64_t kSize = (128 << 20) + kMaxMove;
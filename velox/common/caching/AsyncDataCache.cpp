@@ -25,11 +25,68 @@
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 
+#include <folly/compression/Compression.h>
+#include <shared_mutex>
+
 namespace facebook::velox::cache {
 
 using memory::MachinePageCount;
 using memory::MemoryAllocator;
 
+namespace {
+// Entries that compress to more than this fraction of their size are not
+// worth keeping compressed.
+constexpr double kMaxCompressionRatio = 0.75;
+
+// Returns the LZ4 compressed first 'size' bytes of 'data'.
+std::string compressData(const memory::Allocation& data, int32_t size) {
+  std::unique_ptr<folly::IOBuf> chain;
+  int32_t remaining = size;
+  for (auto i = 0; i < data.numRuns() && remaining > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto bytes = std::min<int32_t>(remaining, run.numBytes());
+    auto buffer = folly::IOBuf::wrapBuffer(run.data<char>(), bytes);
+    if (chain == nullptr) {
+      chain = std::move(buffer);
+    } else {
+      chain->prependChain(std::move(buffer));
+    }
+    remaining -= bytes;
+  }
+  VELOX_CHECK_EQ(remaining, 0);
+  const auto compressed =
+      folly::io::getCodec(folly::io::CodecType::LZ4)->compress(chain.get());
+  std::string result;
+  result.reserve(compressed->computeChainDataLength());
+  for (const auto range : *compressed) {
+    result.append(reinterpret_cast<const char*>(range.data()), range.size());
+  }
+  return result;
+}
+
+// Decompresses 'compressed' into the first 'size' bytes of 'data'.
+void decompressData(
+    const std::string& compressed,
+    int32_t size,
+    memory::Allocation& data) {
+  const auto input =
+      folly::IOBuf::wrapBuffer(compressed.data(), compressed.size());
+  const auto uncompressed =
+      folly::io::getCodec(folly::io::CodecType::LZ4)
+          ->uncompress(input.get(), size);
+  VELOX_CHECK_EQ(uncompressed->computeChainDataLength(), size);
+  folly::io::Cursor cursor(uncompressed.get());
+  int32_t remaining = size;
+  for (auto i = 0; i < data.numRuns() && remaining > 0; ++i) {
+    const auto run = data.runAt(i);
+    const auto bytes = std::min<int32_t>(remaining, run.numBytes());
+    cursor.pull(run.data<char>(), bytes);
+    remaining -= bytes;
+  }
+  VELOX_CHECK_EQ(remaining, 0);
+}
+} // namespace
+
 AsyncDataCacheEntry::AsyncDataCacheEntry(CacheShard* shard) : shard_(shard) {
   accessStats_.reset();
 }
@@ -42,11 +99,13 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
   VELOX_CHECK(isExclusive());
   numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
+  bool overQuota;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<folly::SharedMutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
+    overQuota = shard_->isOverQuotaLocked(tag_);
   }
   if (promise != nullptr) {
     promise->setValue(true);
@@ -61,7 +120,9 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
     hook(*this);
   }
 
-  if (!ssdSavable) {
+  // The entries of a tag over its quota are evicted first and not worth
+  // writing to SSD.
+  if (!ssdSavable || overQuota) {
     return;
   }
 
@@ -74,6 +135,14 @@ void AsyncDataCacheEntry::setExclusiveToShared(bool ssdSavable) {
   }
 }
 
+void AsyncDataCacheEntry::setTag(uint64_t tag) {
+  VELOX_CHECK(isExclusive());
+  if (tag == tag_) {
+    return;
+  }
+  shard_->setEntryTag(this, tag);
+}
+
 void AsyncDataCacheEntry::release() {
   VELOX_CHECK_NE(0, numPins_);
   if (numPins_ == kExclusive) {
@@ -156,13 +225,30 @@ std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntry() {
   return newEntry;
 }
 
+CacheShard::CacheShard(AsyncDataCache* cache) : cache_(cache) {
+  const auto& options = cache_->options();
+  if (options.admissionFrequency > 0) {
+    frequencySketch_ =
+        std::make_unique<FrequencySketch>(options.admissionSketchWidth);
+  }
+}
+
+uint8_t CacheShard::countAccess(RawFileCacheKey key) {
+  const auto hash = bits::hashMix(key.fileNum, key.offset);
+  frequencySketch_->increment(hash);
+  return frequencySketch_->estimate(hash);
+}
+
 CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  if (auto pin = findShared(key, size); !pin.empty()) {
+    return pin;
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<folly::SharedMutex> l(mutex_);
     ++eventCounter_;
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
@@ -176,7 +262,6 @@ CachePin CacheShard::findOrCreate(
       }
 
       if (foundEntry->size() >= size) {
-        foundEntry->touch();
         // The entry is in a readable state. Add a pin.
         if (foundEntry->isPrefetch()) {
           foundEntry->isFirstUse_ = true;
@@ -184,6 +269,24 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += foundEntry->size();
+          if (frequencySketch_ != nullptr &&
+              countAccess(key) >= cache_->options().admissionFrequency &&
+              !foundEntry->isAdmitted_) {
+            foundEntry->isAdmitted_ = true;
+            ++numAdmissionPromotions_;
+          }
+        }
+        // An entry that is not admitted stays first in line for eviction.
+        if (foundEntry->isAdmitted_) {
+          foundEntry->touch();
+        }
+        if (foundEntry->isCompressed()) {
+          // Decompress outside of 'mutex_'. Others wait for the exclusive
+          // entry like for a load.
+          foundEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
+          ++numDecompress_;
+          l.unlock();
+          return decompressEntry(foundEntry);
         }
         ++foundEntry->numPins_;
         CachePin pin;
@@ -221,12 +324,198 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    entryToInit->isAdmitted_ = frequencySketch_ == nullptr ||
+        countAccess(key) >= cache_->options().admissionFrequency;
+    if (!entryToInit->isAdmitted_) {
+      ++numAdmissionRejects_;
+      entryToInit->makeEvictable();
+    }
   }
   return initEntry(key, entryToInit);
 }
 
+CachePin CacheShard::findShared(RawFileCacheKey key, uint64_t size) {
+  // Admission counts every access in 'frequencySketch_', which is not thread
+  // safe.
+  if (frequencySketch_ != nullptr) {
+    return CachePin();
+  }
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  const auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* foundEntry = it->second;
+  // An entry becomes exclusive, is compressed or stops being a prefetch only
+  // under the exclusive lock, so these hold until 'l' is released.
+  if (foundEntry->isExclusive() || foundEntry->size() < size ||
+      foundEntry->isPrefetch() || foundEntry->isCompressed() ||
+      !foundEntry->isAdmitted_) {
+    return CachePin();
+  }
+  numHit_.fetch_add(1, std::memory_order_relaxed);
+  hitBytes_.fetch_add(foundEntry->size(), std::memory_order_relaxed);
+  foundEntry->touch();
+  ++foundEntry->numPins_;
+  CachePin pin;
+  pin.setEntry(foundEntry);
+  return pin;
+}
+
+CachePin CacheShard::decompressEntry(AsyncDataCacheEntry* entry) {
+  VELOX_CHECK(entry->isExclusive());
+  VELOX_CHECK(entry->data_.empty());
+  CachePin pin;
+  // Releasing the pin on error removes the exclusive entry and wakes up
+  // waiters.
+  pin.setEntry(entry);
+  {
+    ClockTimer t(allocClocks_);
+    const auto sizePages = memory::AllocationTraits::numPages(entry->size_);
+    if (!cache_->allocator()->allocateNonContiguous(sizePages, entry->data_)) {
+      _VELOX_THROW(
+          VeloxRuntimeError,
+          error_source::kErrorSourceRuntime.c_str(),
+          error_code::kNoCacheSpace.c_str(),
+          /* isRetriable */ true,
+          "Failed to allocate {} bytes for decompressing cache entry",
+          entry->size_);
+    }
+    cache_->incrementCachedPages(entry->data_.numPages());
+  }
+  // 'compressedData_' is not accessed by others while 'entry' is exclusive.
+  decompressData(entry->compressedData_, entry->size_, entry->data_);
+  {
+    std::lock_guard<folly::SharedMutex> l(mutex_);
+    clearCompressedLocked(entry);
+  }
+  entry->setExclusiveToShared(/*ssdSavable=*/false);
+  return pin;
+}
+
+void CacheShard::clearCompressedLocked(AsyncDataCacheEntry* entry) {
+  if (!entry->isCompressed()) {
+    return;
+  }
+  cache_->incrementCompressedBytes(-entry->compressedData_.size());
+  entry->compressedData_.clear();
+  entry->compressedData_.shrink_to_fit();
+}
+
+void CacheShard::setTagQuota(uint64_t tag, uint64_t maxBytes) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  if (maxBytes == 0) {
+    tagQuotas_.erase(tag);
+  } else {
+    tagQuotas_[tag] = maxBytes;
+  }
+}
+
+void CacheShard::setEntryTag(AsyncDataCacheEntry* entry, uint64_t tag) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  clearTagLocked(entry);
+  if (tag == 0) {
+    return;
+  }
+  entry->tag_ = tag;
+  tagBytes_[tag] += entry->size_;
+}
+
+void CacheShard::clearTagLocked(AsyncDataCacheEntry* entry) {
+  if (entry->tag_ == 0) {
+    return;
+  }
+  auto it = tagBytes_.find(entry->tag_);
+  VELOX_CHECK(it != tagBytes_.end());
+  it->second -= entry->size_;
+  VELOX_CHECK_GE(it->second, 0);
+  if (it->second == 0) {
+    tagBytes_.erase(it);
+  }
+  entry->tag_ = 0;
+}
+
+bool CacheShard::isOverQuotaLocked(uint64_t tag) const {
+  if (tag == 0 || tagQuotas_.empty()) {
+    return false;
+  }
+  const auto quotaIt = tagQuotas_.find(tag);
+  if (quotaIt == tagQuotas_.end()) {
+    return false;
+  }
+  const auto bytesIt = tagBytes_.find(tag);
+  return bytesIt != tagBytes_.end() && bytesIt->second > quotaIt->second;
+}
+
+bool CacheShard::shouldCompress(const AsyncDataCacheEntry& entry) const {
+  const auto maxCompressedBytes = cache_->options().maxCompressedBytes;
+  // Entries that are explicitly made evictable, not admitted, prefetched or
+  // pending a write to SSD are not kept.
+  return maxCompressedBytes > 0 && entry.key_.fileNum.hasValue() &&
+      !entry.isCompressed() && !entry.data_.empty() && entry.isAdmitted() &&
+      entry.accessStats_.lastUse != 0 && !entry.isPrefetch_ &&
+      !entry.ssdSaveable() &&
+      cache_->compressedBytes() + entry.size_ * kMaxCompressionRatio <=
+      maxCompressedBytes;
+}
+
+uint64_t CacheShard::compressEntries(
+    const std::vector<AsyncDataCacheEntry*>& entries,
+    MachinePageCount pagesToAcquire,
+    memory::Allocation& acquired,
+    std::vector<memory::Allocation>& toFree) {
+  uint64_t freedBytes = 0;
+  for (auto* entry : entries) {
+    std::string compressed;
+    try {
+      compressed = compressData(entry->data_, entry->size_);
+    } catch (const std::exception& e) {
+      VELOX_CACHE_LOG_EVERY_MS(WARNING, 1'000)
+          << "Failed to compress cache entry: " << e.what();
+    }
+    bool keep = false;
+    if (!compressed.empty() &&
+        compressed.size() <= entry->size_ * kMaxCompressionRatio) {
+      keep = cache_->incrementCompressedBytes(compressed.size()) <=
+          cache_->options().maxCompressedBytes;
+      if (!keep) {
+        // Other threads have filled the compressed tier meanwhile.
+        cache_->incrementCompressedBytes(-compressed.size());
+      }
+    }
+
+    std::unique_ptr<folly::SharedPromise<bool>> promise;
+    {
+      std::lock_guard<folly::SharedMutex> l(mutex_);
+      if (keep) {
+        entry->compressedData_ = std::move(compressed);
+        freedBytes += entry->data_.byteSize();
+        const auto numPages = entry->data_.numPages();
+        if (pagesToAcquire > 0) {
+          pagesToAcquire =
+              numPages > pagesToAcquire ? 0 : pagesToAcquire - numPages;
+          acquired.appendMove(entry->data_);
+        } else {
+          toFree.push_back(std::move(entry->data_));
+        }
+        // The compressed entry gets a new lifetime in cache.
+        entry->accessStats_.reset();
+        ++numCompress_;
+      } else {
+        entry->makeEvictable();
+      }
+      entry->numPins_ = 0;
+      promise = entry->movePromise();
+    }
+    if (promise != nullptr) {
+      promise->setValue(true);
+    }
+  }
+  return freedBytes;
+}
+
 void CacheShard::makeEvictable(RawFileCacheKey key) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it == entryMap_.end()) {
     return;
@@ -235,7 +524,7 @@ void CacheShard::makeEvictable(RawFileCacheKey key) {
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::shared_lock<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -323,7 +612,7 @@ void CoalescedLoad::setEndState(State endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -331,6 +620,7 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  clearTagLocked(entry);
   if (!entry->key_.fileNum.hasValue()) {
     return;
   }
@@ -352,6 +642,7 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
     cache_->incrementCachedPages(-numPages);
     cache_->allocator()->freeNonContiguous(entry->data());
   }
+  clearCompressedLocked(entry);
   entry->tinyData_.clear();
   entry->tinyData_.shrink_to_fit();
   entry->size_ = 0;
@@ -366,11 +657,13 @@ uint64_t CacheShard::evict(
   const bool skipSsdSaveable = ssdCache && ssdCache->writeInProgress();
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
+  std::vector<AsyncDataCacheEntry*> toCompress;
+  int64_t compressPending = 0;
   int64_t tinyEvicted = 0;
   int64_t largeEvicted = 0;
   int32_t evictSaveableSkipped = 0;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     const size_t size = entries_.size();
     if (size == 0) {
       return 0;
@@ -405,13 +698,26 @@ uint64_t CacheShard::evict(
       }
 
       int32_t score = 0;
+      bool overQuota = false;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
+           (overQuota = isOverQuotaLocked(candidate->tag_)) ||
            (score = candidate->score(now)) >= evictionThreshold_)) {
-        if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
+        if (skipSsdSaveable && candidate->ssdSaveable() &&
+            candidate->isAdmitted() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
         }
+        if (!evictAllUnpinned && !overQuota && shouldCompress(*candidate)) {
+          // Compressed outside of 'mutex_'.
+          candidate->numPins_ = AsyncDataCacheEntry::kExclusive;
+          toCompress.push_back(candidate);
+          compressPending += candidate->data_.byteSize();
+          if (largeEvicted + tinyEvicted + compressPending > bytesToFree) {
+            break;
+          }
+          continue;
+        }
         largeEvicted += candidate->data_.byteSize();
         if (pagesToAcquire > 0) {
           const auto candidatePages = candidate->data().numPages();
@@ -426,22 +732,35 @@ uint64_t CacheShard::evict(
         tinyEvicted += candidate->tinyData_.size();
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
+        clearCompressedLocked(candidate);
+        clearTagLocked(candidate);
         candidate->size_ = 0;
 
         removeEntryLocked(candidate);
         emptySlots_.push_back(entryIndex);
         tryAddFreeEntry(std::move(*iter));
         ++numEvict_;
+        numEvictOverQuota_ += overQuota;
         if (score > 0) {
           sumEvictScore_ += score;
         }
-        if (largeEvicted + tinyEvicted > bytesToFree) {
+        if (largeEvicted + tinyEvicted + compressPending > bytesToFree) {
           break;
         }
       }
     }
   }
 
+  if (!toCompress.empty()) {
+    // The pages given to 'acquired' by the loop above are not acquired again.
+    const auto acquiredPages = acquired.numPages();
+    largeEvicted += compressEntries(
+        toCompress,
+        pagesToAcquire > acquiredPages ? pagesToAcquire - acquiredPages : 0,
+        acquired,
+        toFree);
+  }
+
   ClockTimer t(allocClocks_);
   freeAllocations(toFree);
   cache_->incrementCachedPages(
@@ -501,7 +820,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -520,6 +839,11 @@ void CacheShard::updateStats(CacheStats& stats) {
       stats.prefetchBytes += entry->size();
     }
     ++stats.numEntries;
+    if (entry->isCompressed()) {
+      ++stats.numCompressed;
+      stats.compressedSize += entry->compressedData_.size();
+      continue;
+    }
     stats.tinySize += entry->tinyData_.size();
     stats.tinyPadding += entry->tinyData_.capacity() - entry->tinyData_.size();
     if (entry->tinyData_.empty()) {
@@ -535,11 +859,16 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numWaitExclusive += numWaitExclusive_;
   stats.numAgedOut += numAgedOut_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numAdmissionRejects += numAdmissionRejects_;
+  stats.numAdmissionPromotions += numAdmissionPromotions_;
+  stats.numCompress += numCompress_;
+  stats.numDecompress += numDecompress_;
+  stats.numEvictOverQuota += numEvictOverQuota_;
   stats.allocClocks += allocClocks_;
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch. If SSD save is slower
   // than storage read, we must not have a situation where SSD save pins
   // everything and stops reading.
@@ -547,7 +876,7 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   VELOX_CHECK(cache_->ssdCache()->writeInProgress());
   for (auto& entry : entries_) {
     if (entry && (entry->ssdFile_ == nullptr) && !entry->isExclusive() &&
-        entry->ssdSaveable()) {
+        entry->ssdSaveable() && entry->isAdmitted()) {
       CachePin pin;
       ++entry->numPins_;
       pin.setEntry(entry.get());
@@ -572,7 +901,7 @@ bool CacheShard::removeFileEntries(
   int64_t pagesRemoved = 0;
   std::vector<memory::Allocation> toFree;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
 
     auto entryIndex = -1;
     for (auto& cacheEntry : entries_) {
@@ -620,6 +949,12 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
   result.numAgedOut = numAgedOut - other.numAgedOut;
   result.allocClocks = allocClocks - other.allocClocks;
   result.sumEvictScore = sumEvictScore - other.sumEvictScore;
+  result.numAdmissionRejects = numAdmissionRejects - other.numAdmissionRejects;
+  result.numAdmissionPromotions =
+      numAdmissionPromotions - other.numAdmissionPromotions;
+  result.numCompress = numCompress - other.numCompress;
+  result.numDecompress = numDecompress - other.numDecompress;
+  result.numEvictOverQuota = numEvictOverQuota - other.numEvictOverQuota;
   if (ssdStats != nullptr && other.ssdStats != nullptr) {
     result.ssdStats =
         std::make_shared<SsdCacheStats>(*ssdStats - *other.ssdStats);
@@ -629,8 +964,18 @@ CacheStats CacheStats::operator-(CacheStats& other) const {
 
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
-    : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
+    std::unique_ptr<SsdCache> ssdCache,
+    const Options& options)
+    : allocator_(allocator),
+      ssdCache_(std::move(ssdCache)),
+      options_(options),
+      cachedPages_(0) {
+  VELOX_CHECK_GE(options_.admissionFrequency, 0);
+  VELOX_CHECK_GE(options_.maxCompressedBytes, 0);
+  VELOX_CHECK(
+      options_.maxCompressedBytes == 0 ||
+          folly::io::hasCodec(folly::io::CodecType::LZ4),
+      "Compressed cache entries require LZ4 support");
   for (auto i = 0; i < kNumShards; ++i) {
     shards_.push_back(std::make_unique<CacheShard>(this));
   }
@@ -641,8 +986,10 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    const Options& options) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator, std::move(ssdCache), options);
   allocator->registerCache(cache);
   return cache;
 }
@@ -911,6 +1258,42 @@ bool AsyncDataCache::removeFileEntries(
   return success;
 }
 
+void AsyncDataCache::setTagQuota(uint64_t tag, double share) {
+  VELOX_CHECK_NE(tag, 0);
+  VELOX_CHECK_GE(share, 0);
+  VELOX_CHECK_LE(share, 1);
+  // Entries are spread evenly over the shards.
+  const uint64_t shardBytes = share == 0
+      ? 0
+      : std::max<uint64_t>(1, share * allocator_->capacity() / kNumShards);
+  for (auto& shard : shards_) {
+    shard->setTagQuota(tag, shardBytes);
+  }
+}
+
+CachedFilesSummary AsyncDataCache::cachedFilesSummary() const {
+  folly::F14FastMap<uint64_t, uint64_t> fileNumBytes;
+  for (auto& shard : shards_) {
+    shard->addCachedFileBytes(fileNumBytes);
+  }
+  if (ssdCache_ != nullptr) {
+    ssdCache_->addCachedFileBytes(fileNumBytes);
+  }
+
+  CachedFilesSummary summary;
+  summary.files.reset(fileNumBytes.size());
+  for (const auto& [fileNum, bytes] : fileNumBytes) {
+    auto fileName = fileIds().string(fileNum);
+    if (fileName.empty()) {
+      // The file was dropped from 'fileIds()' after the entry was read.
+      continue;
+    }
+    summary.files.insert(CachedFilesSummary::hashFileName(fileName));
+    summary.fileBytes[std::move(fileName)] += bytes;
+  }
+  return summary;
+}
+
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
   for (auto& shard : shards_) {
@@ -1037,9 +1420,20 @@ CoalesceIoStats readPins(
       std::move(readFunc));
 }
 
+void CacheShard::addCachedFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) {
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry != nullptr && entry->key_.fileNum.hasValue() &&
+        !entry->isExclusive()) {
+      fileBytes[entry->key_.fileNum.id()] += entry->size();
+    }
+  }
+}
+
 std::vector<AsyncDataCacheEntry*> CacheShard::testingCacheEntries() const {
   std::vector<AsyncDataCacheEntry*> entries;
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   entries.reserve(entries_.size());
   for (const auto& entry : entries_) {
     entries.push_back(entry.get());
@@ -21,13 +21,16 @@
 #include <fmt/format.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/container/F14Set.h>
+#include <folly/SharedMutex.h>
 #include <folly/futures/SharedPromise.h>
 #include "folly/GLog.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
@@ -62,8 +65,9 @@ inline AccessTime accessTime() {
 }
 
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  // Updated by concurrent hits in CacheShard::findOrCreate().
+  tsan_atomic<AccessTime> lastUse{0};
+  tsan_atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -245,6 +249,21 @@ class AsyncDataCacheEntry {
     return ssdSaveable_;
   }
 
+  /// False if the key of 'this' was not accessed often enough to displace
+  /// other entries when 'this' was created. Such entries are evicted first
+  /// and not written to SSD until hit often enough.
+  bool isAdmitted() const {
+    return isAdmitted_;
+  }
+
+  /// True if the data of 'this' is held LZ4 compressed and 'data_' is empty.
+  /// See AsyncDataCache::Options::maxCompressedBytes. A compressed entry is
+  /// never pinned: pinning it through CacheShard::findOrCreate decompresses
+  /// it first.
+  bool isCompressed() const {
+    return !compressedData_.empty();
+  }
+
   void setTrackingId(TrackingId id) {
     trackingId_ = id;
   }
@@ -253,6 +272,16 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  /// Sets the quota tag of 'this', e.g. a table or tenant. The size of
+  /// 'this' counts against the quota of 'tag' given to
+  /// AsyncDataCache::setTagQuota() while 'this' is in the cache. 0 means no
+  /// tag. Must be called while 'this' is exclusive.
+  void setTag(uint64_t tag);
+
+  uint64_t tag() const {
+    return tag_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -298,10 +327,15 @@ class AsyncDataCacheEntry {
   // page (kTinyDataSize).
   std::string tinyData_;
 
+  // LZ4 compressed copy of the data if 'this' is in the compressed tier.
+  // 'data_' is then empty.
+  std::string compressedData_;
+
   std::unique_ptr<folly::SharedPromise<bool>> promise_;
   int32_t size_{0};
 
-  // Setting this from 0 to 1 or to kExclusive requires owning shard_->mutex_.
+  // Setting this from 0 to 1 requires owning shard_->mutex_ in shared mode.
+  // Setting this to kExclusive requires owning it in exclusive mode.
   std::atomic<int32_t> numPins_{0};
 
   AccessStats accessStats_;
@@ -319,6 +353,9 @@ class AsyncDataCacheEntry {
   // Group id. Used for deciding if 'this' should be written to SSD.
   uint64_t groupId_{0};
 
+  // Quota tag. See setTag(). Set inside the shard mutex.
+  tsan_atomic<uint64_t> tag_{0};
+
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
@@ -335,6 +372,9 @@ class AsyncDataCacheEntry {
   // True if this should be saved to SSD.
   std::atomic<bool> ssdSaveable_{false};
 
+  // See isAdmitted(). Set inside the shard mutex.
+  tsan_atomic<bool> isAdmitted_{true};
+
   friend class CacheShard;
   friend class CachePin;
 };
@@ -498,6 +538,10 @@ struct CacheStats {
   int32_t numEntries{0};
   /// Number of entries that do not cache anything.
   int32_t numEmptyEntries{0};
+  /// Number of entries held compressed in memory.
+  int32_t numCompressed{0};
+  /// Total size of the compressed data of entries in 'numCompressed'.
+  int64_t compressedSize{0};
   /// Number of entries pinned for shared access.
   int32_t numShared{0};
   /// Number of entries pinned for exclusive access.
@@ -535,22 +579,59 @@ struct CacheStats {
   /// Sum of scores of evicted entries. This serves to infer an average
   /// lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  /// Number of new entries not admitted for retention because their key was
+  /// accessed less than AsyncDataCache::Options::admissionFrequency times.
+  int64_t numAdmissionRejects{0};
+  /// Number of hits that admitted a previously rejected entry.
+  int64_t numAdmissionPromotions{0};
+  /// Number of entries compressed instead of being evicted.
+  int64_t numCompress{0};
+  /// Number of compressed entries decompressed on a hit.
+  int64_t numDecompress{0};
+  /// Number of entries evicted because their tag was over its quota.
+  int64_t numEvictOverQuota{0};
 
   /// Ssd cache stats that include both snapshot and cumulative stats.
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
   CacheStats operator-(CacheStats& other) const;
 
+  /// Returns the fraction of lookups that hit.
+  double hitRate() const {
+    const auto numLookups = numHit + numNew;
+    return numLookups == 0 ? 0 : static_cast<double>(numHit) / numLookups;
+  }
+
   std::string toString() const;
 };
 
+/// Summary of the files that have data in an AsyncDataCache and its SsdCache.
+/// An embedding engine can poll this and send 'files' to its scheduler so
+/// that splits are assigned to workers that have their data cached.
+struct CachedFilesSummary {
+  /// Number of bytes cached in memory and on SSD by file name.
+  folly::F14FastMap<std::string, uint64_t> fileBytes;
+
+  /// Bloom filter of the names in 'fileBytes'. Use hashFileName() to probe.
+  BloomFilter<> files;
+
+  static uint64_t hashFileName(std::string_view fileName) {
+    return folly::hasher<std::string_view>()(fileName);
+  }
+
+  /// Returns false if 'fileName' has no cached data and true if it may have.
+  bool mayContain(std::string_view fileName) const {
+    return files.isSet() && files.mayContain(hashFileName(fileName));
+  }
+};
+
 /// Collection of cache entries whose key hashes to the same shard of
 /// the hash number space.  The cache population is divided into shards
 /// to decrease contention on the mutex for the key to entry mapping
 /// and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* cache) : cache_(cache) {}
+  explicit CacheShard(AsyncDataCache* cache);
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -568,7 +649,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  folly::SharedMutex& mutex() {
     return mutex_;
   }
 
@@ -613,6 +694,21 @@ class CacheShard {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the sizes of the readable entries of 'this' to 'fileBytes', keyed
+  /// by file number.
+  void addCachedFileBytes(folly::F14FastMap<uint64_t, uint64_t>& fileBytes);
+
+  /// Sets the bytes entries tagged 'tag' may hold in 'this' before they are
+  /// evicted ahead of others. 0 removes the quota.
+  void setTagQuota(uint64_t tag, uint64_t maxBytes);
+
+  /// Sets the tag of 'entry' and charges its size to the tag.
+  void setEntryTag(AsyncDataCacheEntry* entry, uint64_t tag);
+
+  /// True if the entries tagged 'tag' hold more than the quota of 'tag'. Must
+  /// be called inside 'mutex_'.
+  bool isOverQuotaLocked(uint64_t tag) const;
+
   auto& allocClocks() {
     return allocClocks_;
   }
@@ -635,13 +731,49 @@ class CacheShard {
 
   CachePin initEntry(RawFileCacheKey key, AsyncDataCacheEntry* entry);
 
+  // Returns a shared pin on the entry for 'key' if it is readable and can be
+  // pinned without changing the shard, else an empty pin. Takes 'mutex_' in
+  // shared mode only, so that concurrent hits do not serialize.
+  CachePin findShared(RawFileCacheKey key, uint64_t size);
+
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
+  // True if 'entry' should be compressed instead of evicted. Must be called
+  // inside 'mutex_'.
+  bool shouldCompress(const AsyncDataCacheEntry& entry) const;
+
+  // Compresses the data of each of 'entries', which are pinned exclusive by
+  // evict(), and moves the freed allocations to 'acquired' up to
+  // 'pagesToAcquire' and the rest to 'toFree'. An entry that does not
+  // compress well is made evictable instead. Returns the freed bytes.
+  uint64_t compressEntries(
+      const std::vector<AsyncDataCacheEntry*>& entries,
+      memory::MachinePageCount pagesToAcquire,
+      memory::Allocation& acquired,
+      std::vector<memory::Allocation>& toFree);
+
+  // Decompresses 'entry', which has been pinned exclusive by findOrCreate(),
+  // and returns a shared pin on it.
+  CachePin decompressEntry(AsyncDataCacheEntry* entry);
+
+  // Drops the compressed data of 'entry'. Must be called inside 'mutex_'.
+  void clearCompressedLocked(AsyncDataCacheEntry* entry);
+
+  // Removes the size of 'entry' from the bytes of its tag and clears the tag.
+  // Must be called inside 'mutex_'.
+  void clearTagLocked(AsyncDataCacheEntry* entry);
+
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
+  // Counts an access to 'key' and returns its estimated number of recent
+  // accesses. Must be called inside 'mutex_' when 'frequencySketch_' is set.
+  uint8_t countAccess(RawFileCacheKey key);
+
   AsyncDataCache* const cache_;
 
-  mutable std::mutex mutex_;
+  // Exclusive for changes to the shard and its entries. Hits that only pin an
+  // entry take it in shared mode.
+  mutable folly::SharedMutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -657,10 +789,11 @@ class CacheShard {
   uint32_t eventCounter_{0};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
-  // Cumulative count of cache hits.
-  uint64_t numHit_{0};
-  // Cumulative Sum of bytes in cache hits.
-  uint64_t hitBytes_{0};
+  // Cumulative count of cache hits. Incremented under a shared 'mutex_'.
+  std::atomic<uint64_t> numHit_{0};
+  // Cumulative Sum of bytes in cache hits. Incremented under a shared
+  // 'mutex_'.
+  std::atomic<uint64_t> hitBytes_{0};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{0};
   // Cumulative count of new entry creation.
@@ -675,6 +808,23 @@ class CacheShard {
   // Cumulative sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+  // Access counts for admission. Set if the cache has an admission frequency.
+  std::unique_ptr<FrequencySketch> frequencySketch_;
+  // Cumulative count of new entries not admitted.
+  uint64_t numAdmissionRejects_{0};
+  // Cumulative count of rejected entries admitted on a hit.
+  uint64_t numAdmissionPromotions_{0};
+  // Cumulative count of entries compressed instead of evicted.
+  uint64_t numCompress_{0};
+  // Cumulative count of compressed entries decompressed on a hit.
+  uint64_t numDecompress_{0};
+  // Bytes of the tagged entries by tag.
+  folly::F14FastMap<uint64_t, int64_t> tagBytes_;
+  // Max bytes of entries by tag in 'this'.
+  folly::F14FastMap<uint64_t, uint64_t> tagQuotas_;
+  // Cumulative count of entries evicted for being over the quota of their
+  // tag.
+  uint64_t numEvictOverQuota_{0};
   // Tracker of cumulative time spent in allocating/freeing MemoryAllocator
   // space for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -682,15 +832,51 @@ class CacheShard {
 
 class AsyncDataCache : public memory::Cache {
  public:
+  struct Options {
+    Options(
+        int32_t _admissionFrequency = 0,
+        int32_t _admissionSketchWidth = 1 << 16,
+        int64_t _maxCompressedBytes = 0)
+        : admissionFrequency(_admissionFrequency),
+          admissionSketchWidth(_admissionSketchWidth),
+          maxCompressedBytes(_maxCompressedBytes) {}
+
+    /// If non-zero, a new entry is admitted for retention only if its key
+    /// has been looked up at least this many times recently, counting the
+    /// lookup that creates it. Entries that are not admitted are evicted
+    /// first and are not written to SSD until they are hit often enough, so
+    /// that one-off scans do not displace frequently used data.
+    int32_t admissionFrequency;
+
+    /// Number of counters per row of the access frequency sketch of each
+    /// shard.
+    int32_t admissionSketchWidth;
+
+    /// If non-zero, admitted entries that are picked for eviction are
+    /// instead LZ4 compressed and kept in memory for another round, as long
+    /// as the compressed data of all entries stays under this many bytes.
+    /// The compressed data is not allocated from the cache's allocator, so
+    /// this is memory on top of the cache capacity. A hit on a compressed
+    /// entry decompresses it back into the cache. Entries that compress to
+    /// more than 3/4 of their size are evicted as usual.
+    int64_t maxCompressedBytes;
+  };
+
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      const Options& options = {});
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      const Options& options = {});
+
+  const Options& options() const {
+    return options_;
+  }
 
   static AsyncDataCache* getInstance();
 
@@ -757,6 +943,15 @@ class AsyncDataCache : public memory::Cache {
     return prefetchPages_.fetch_add(pages) + pages;
   }
 
+  /// Adds 'bytes' to the size of compressed entries and returns the new size.
+  int64_t incrementCompressedBytes(int64_t bytes) {
+    return compressedBytes_.fetch_add(bytes) + bytes;
+  }
+
+  int64_t compressedBytes() const {
+    return compressedBytes_;
+  }
+
   SsdCache* ssdCache() const {
     return ssdCache_.get();
   }
@@ -815,6 +1010,17 @@ class AsyncDataCache : public memory::Cache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Returns the files that have data in 'this' or in 'ssdCache_'. The
+  /// summary is a snapshot and may be stale right after it is made.
+  CachedFilesSummary cachedFilesSummary() const;
+
+  /// Limits the entries with AsyncDataCacheEntry::tag() 'tag' to 'share' of
+  /// the capacity of the cache. The entries of a tag over its quota are
+  /// evicted first regardless of their access history, are not kept
+  /// compressed and are not written to SSD, so that one tag cannot crowd out
+  /// the others. 'share' is between 0 and 1. 0 removes the quota.
+  void setTagQuota(uint64_t tag, double share);
+
   /// Drops all unpinned entries. Pins stay valid.
   void testingClear();
 
@@ -840,12 +1046,15 @@ class AsyncDataCache : public memory::Cache {
 
   memory::MemoryAllocator* const allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
+  const Options options_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
   // Number of pages that are allocated and not yet loaded or loaded
   // but not yet hit for the first time.
   std::atomic<memory::MachinePageCount> prefetchPages_{0};
+  // Total size of the compressed data of compressed entries.
+  std::atomic<int64_t> compressedBytes_{0};
 
   // Approximate counter of bytes allocated to cover misses. When this
   // exceeds 'nextSsdScoreSize_' we update the SSD admission criteria.
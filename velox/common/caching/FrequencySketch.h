@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+/// Approximate access counts of keys for cache admission, as in TinyLFU. This
+/// is a count-min sketch with 4 rows of small saturating counters. After 10
+/// increments per counter of a row, all counters are halved so that the
+/// counts reflect recent accesses. Not thread safe.
+class FrequencySketch {
+ public:
+  /// Counters saturate at this value.
+  static constexpr uint8_t kMaxCount = 15;
+
+  /// 'width' is the number of counters per row and is rounded up to a power
+  /// of 2.
+  explicit FrequencySketch(int32_t width)
+      : width_(bits::nextPowerOfTwo(width)),
+        sampleSize_(10 * width_),
+        counters_(kNumRows * width_) {
+    VELOX_CHECK_GT(width, 0);
+  }
+
+  /// Counts an access to the key with 'hash'.
+  void increment(uint64_t hash) {
+    for (auto row = 0; row < kNumRows; ++row) {
+      auto& counter = counters_[index(hash, row)];
+      if (counter < kMaxCount) {
+        ++counter;
+      }
+    }
+    if (++numIncrements_ >= sampleSize_) {
+      age();
+    }
+  }
+
+  /// Returns the estimated number of recent accesses to the key with 'hash'.
+  /// This may overestimate but does not underestimate.
+  uint8_t estimate(uint64_t hash) const {
+    uint8_t count = kMaxCount;
+    for (auto row = 0; row < kNumRows; ++row) {
+      count = std::min(count, counters_[index(hash, row)]);
+    }
+    return count;
+  }
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+
+  size_t index(uint64_t hash, int32_t row) const {
+    // Each row uses a different mix of the hash.
+    return row * width_ + (bits::hashMix(hash, row) & (width_ - 1));
+  }
+
+  void age() {
+    for (auto& counter : counters_) {
+      counter >>= 1;
+    }
+    numIncrements_ /= 2;
+  }
+
+  const uint64_t width_;
+  const uint64_t sampleSize_;
+  uint64_t numIncrements_{0};
+  std::vector<uint8_t> counters_;
+};
+
+} // namespace facebook::velox::cache
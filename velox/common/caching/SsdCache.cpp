@@ -66,7 +66,8 @@ SsdCache::SsdCache(const Config& config)
         config.disableFileCow,
         config.checksumEnabled,
         checksumReadVerificationEnabled,
-        executor_);
+        executor_,
+        config.lazyCheckpointRecovery);
     files_.push_back(std::make_unique<SsdFile>(fileConfig));
   }
 }
@@ -165,6 +166,13 @@ bool SsdCache::removeFileEntries(
   return success;
 }
 
+void SsdCache::addCachedFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  for (const auto& file : files_) {
+    file->addCachedFileBytes(fileBytes);
+  }
+}
+
 SsdCacheStats SsdCache::stats() const {
   SsdCacheStats stats;
   for (auto& file : files_) {
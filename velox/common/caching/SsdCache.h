@@ -37,7 +37,8 @@ class SsdCache {
         uint64_t _checkpointIntervalBytes = 0,
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
-        bool _checksumReadVerificationEnabled = false)
+        bool _checksumReadVerificationEnabled = false,
+        bool _lazyCheckpointRecovery = false)
         : filePrefix(_filePrefix),
           maxBytes(_maxBytes),
           numShards(_numShards),
@@ -45,7 +46,8 @@ class SsdCache {
           disableFileCow(_disableFileCow),
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(_checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          lazyCheckpointRecovery(_lazyCheckpointRecovery){};
 
     std::string filePrefix;
     uint64_t maxBytes;
@@ -67,6 +69,11 @@ class SsdCache {
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
 
+    /// If true, each shard reads its checkpoint on 'executor' after
+    /// construction. A shard serves misses and drops writes until its
+    /// checkpoint is read, so that the cache is usable right after restart.
+    bool lazyCheckpointRecovery;
+
     std::string toString() const {
       return fmt::format(
           "{} shards, capacity {}, checkpoint size {}, file cow {}, checksum {}, read verification {}",
@@ -127,6 +134,11 @@ class SsdCache {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the sizes of the entries of all SsdFiles to 'fileBytes', keyed by
+  /// file number.
+  void addCachedFileBytes(
+      folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
@@ -128,7 +128,8 @@ SsdFile::SsdFile(const Config& config)
           config.checksumEnabled && config.checksumReadVerificationEnabled),
       shardId_(config.shardId),
       checkpointIntervalBytes_(config.checkpointIntervalBytes),
-      executor_(config.executor) {
+      executor_(config.executor),
+      lazyCheckpointRecovery_(config.lazyCheckpointRecovery) {
   process::TraceContext trace("SsdFile::SsdFile");
   int32_t oDirect = 0;
 #ifdef linux
@@ -169,6 +170,14 @@ SsdFile::SsdFile(const Config& config)
   }
 }
 
+SsdFile::~SsdFile() {
+  testingWaitForRecovery();
+}
+
+void SsdFile::testingWaitForRecovery() {
+  recoveryFuture_.wait();
+}
+
 void SsdFile::pinRegion(uint64_t offset) {
   std::lock_guard<std::shared_mutex> l(mutex_);
   pinRegionLocked(offset);
@@ -186,6 +195,9 @@ void SsdFile::unpinRegion(uint64_t offset) {
 SsdPin SsdFile::find(RawFileCacheKey key) {
   FileCacheKey ssdKey{StringIdLease(fileIds(), key.fileNum), key.offset};
   SsdRun run;
+  if (recovering_) {
+    return SsdPin();
+  }
   {
     std::lock_guard<std::shared_mutex> l(mutex_);
     if (suspended_) {
@@ -355,6 +367,17 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
       ++it;
     }
   }
+  if (numUnverified_ > 0) {
+    for (auto it = unverifiedOffsets_.begin();
+         it != unverifiedOffsets_.end();) {
+      if (regionSet.count(regionIndex(*it)) != 0) {
+        it = unverifiedOffsets_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    numUnverified_ = unverifiedOffsets_.size();
+  }
   for (const auto region : regions) {
     // While the region is being filled, it may get score from hits. When it is
     // full, it will get a score boost to be a little ahead of the best.
@@ -366,6 +389,11 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
 
 void SsdFile::write(std::vector<CachePin>& pins) {
   process::TraceContext trace("SsdFile::write");
+  if (recovering_) {
+    // The regions of the checkpoint being read must not be overwritten.
+    ++stats_.writeSsdDropped;
+    return;
+  }
   // Sorts the pins by their file/offset. In this way what is adjacent in
   // storage is likely adjacent on SSD.
   std::sort(pins.begin(), pins.end());
@@ -538,6 +566,16 @@ void SsdFile::testingDeleteFile() {
   }
 }
 
+void SsdFile::addCachedFileBytes(
+    folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    if (key.fileNum.hasValue()) {
+      fileBytes[key.fileNum.id()] += run.size();
+    }
+  }
+}
+
 bool SsdFile::removeFileEntries(
     const folly::F14FastSet<uint64_t>& filesToRemove,
     folly::F14FastSet<uint64_t>& filesRetained) {
@@ -679,7 +717,7 @@ inline const char* asChar(const T* ptr) {
 void SsdFile::checkpoint(bool force) {
   process::TraceContext trace("SsdFile::checkpoint");
   std::lock_guard<std::shared_mutex> l(mutex_);
-  if (!needCheckpoint(force)) {
+  if (recovering_ || !needCheckpoint(force)) {
     return;
   }
 
@@ -834,17 +872,38 @@ void SsdFile::initializeCheckpoint() {
         folly::errnoStr(errno));
   }
 
+  if (!hasCheckpoint) {
+    return;
+  }
+  if (lazyCheckpointRecovery_ && executor_ != nullptr) {
+    recovering_ = true;
+    auto [promise, future] = folly::makePromiseContract<folly::Unit>();
+    recoveryFuture_ = std::move(future);
+    executor_->add([this,
+                    promise = std::move(promise),
+                    state = std::move(state)]() mutable {
+      recoverFromCheckpoint(state);
+      recovering_ = false;
+      promise.setValue();
+    });
+    return;
+  }
+  recoverFromCheckpoint(state);
+}
+
+void SsdFile::recoverFromCheckpoint(std::ifstream& state) {
   try {
-    if (hasCheckpoint) {
-      state.exceptions(std::ifstream::failbit);
-      readCheckpoint(state);
-    }
+    state.exceptions(std::ifstream::failbit);
+    readCheckpoint(state);
   } catch (const std::exception& e) {
     ++stats_.readCheckpointErrors;
     try {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
+      std::lock_guard<std::shared_mutex> l(mutex_);
       entries_.clear();
+      unverifiedOffsets_.clear();
+      numUnverified_ = 0;
       deleteCheckpoint(true);
     } catch (const std::exception&) {
     }
@@ -869,10 +928,24 @@ uint32_t SsdFile::checksumEntry(const AsyncDataCacheEntry& entry) const {
   return crc.checksum();
 }
 
+bool SsdFile::takeUnverified(uint64_t offset) {
+  if (numUnverified_ == 0) {
+    return false;
+  }
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  if (unverifiedOffsets_.erase(offset) == 0) {
+    return false;
+  }
+  numUnverified_ = unverifiedOffsets_.size();
+  return true;
+}
+
 void SsdFile::maybeVerifyChecksum(
     const AsyncDataCacheEntry& entry,
     const SsdRun& ssdRun) {
-  if (!checksumReadVerificationEnabled_) {
+  // Entries from a lazily read checkpoint are verified on first read even if
+  // read verification is off, since the checkpoint is not checked up front.
+  if (!checksumReadVerificationEnabled_ && !takeUnverified(ssdRun.offset())) {
     return;
   }
 
@@ -931,7 +1004,7 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       maxRegions,
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
-  numRegions_ = readNumber<int32_t>(state);
+  const auto numRegions = readNumber<int32_t>(state);
   std::vector<double> scores(maxRegions);
   state.read(asChar(scores.data()), maxRegions_ * sizeof(double));
   std::unordered_map<uint64_t, StringIdLease> idMap;
@@ -955,6 +1028,8 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
   for (auto region : evicted) {
     evictedMap.insert(region);
   }
+  folly::F14FastMap<FileCacheKey, SsdRun> entries;
+  folly::F14FastSet<uint64_t> unverifiedOffsets;
   for (;;) {
     const auto fileNum = readNumber<uint64_t>(state);
     if (fileNum == kCheckpointEndMarker) {
@@ -973,12 +1048,21 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       auto it = idMap.find(fileNum);
       VELOX_CHECK(it != idMap.end());
       FileCacheKey key{it->second, offset};
-      entries_[std::move(key)] = run;
+      entries[std::move(key)] = run;
+      if (lazyCheckpointRecovery_ && checkpoinHasChecksum &&
+          checksumEnabled_) {
+        unverifiedOffsets.insert(run.offset());
+      }
     }
   }
+  // The state is successfully read. Install the entries, the access frequency
+  // scores and evicted regions.
+  std::lock_guard<std::shared_mutex> l(mutex_);
   ++stats_.checkpointsRead;
-  // The state is successfully read. Install the access frequency scores and
-  // evicted regions.
+  numRegions_ = numRegions;
+  entries_ = std::move(entries);
+  unverifiedOffsets_ = std::move(unverifiedOffsets);
+  numUnverified_ = unverifiedOffsets_.size();
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
   // Set the writable regions by deduplicated evicted regions.
   writableRegions_.clear();
@@ -239,7 +239,8 @@ class SsdFile {
         bool _disableFileCow = false,
         bool _checksumEnabled = false,
         bool _checksumReadVerificationEnabled = false,
-        folly::Executor* _executor = nullptr)
+        folly::Executor* _executor = nullptr,
+        bool _lazyCheckpointRecovery = false)
         : fileName(_fileName),
           shardId(_shardId),
           maxRegions(_maxRegions),
@@ -248,7 +249,8 @@ class SsdFile {
           checksumEnabled(_checksumEnabled),
           checksumReadVerificationEnabled(
               _checksumEnabled && _checksumReadVerificationEnabled),
-          executor(_executor){};
+          executor(_executor),
+          lazyCheckpointRecovery(_lazyCheckpointRecovery){};
 
     /// Name of cache file, used as prefix for checkpoint files.
     const std::string fileName;
@@ -274,6 +276,13 @@ class SsdFile {
 
     /// Executor for async fsync in checkpoint.
     folly::Executor* executor;
+
+    /// If true and 'executor' is set, the checkpoint is read on 'executor'
+    /// after construction instead of in the constructor. Until it is read,
+    /// lookups miss and writes are dropped. If checksums are enabled, each
+    /// recovered entry is verified against its checksum on its first read,
+    /// also when read verification is off.
+    bool lazyCheckpointRecovery;
   };
 
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
@@ -282,6 +291,9 @@ class SsdFile {
   /// filename.
   SsdFile(const Config& config);
 
+  /// Waits for a lazy checkpoint recovery in progress.
+  ~SsdFile();
+
   /// Adds entries of 'pins' to this file. 'pins' must be in read mode and
   /// those pins that are successfully added to SSD are marked as being on SSD.
   /// The file of the entries must be a file that is backed by 'this'.
@@ -342,6 +354,11 @@ class SsdFile {
       const folly::F14FastSet<uint64_t>& filesToRemove,
       folly::F14FastSet<uint64_t>& filesRetained);
 
+  /// Adds the sizes of the entries of 'this' to 'fileBytes', keyed by file
+  /// number.
+  void addCachedFileBytes(
+      folly::F14FastMap<uint64_t, uint64_t>& fileBytes) const;
+
   /// Writes a checkpoint state that can be recovered from. The
   /// checkpoint is serialized on 'mutex_'. If 'force' is false,
   /// rechecks that at least 'checkpointIntervalBytes_' have been
@@ -396,6 +413,14 @@ class SsdFile {
     return checksumReadVerificationEnabled_;
   }
 
+  /// Returns true while the checkpoint is being read on the executor.
+  bool isRecovering() const {
+    return recovering_;
+  }
+
+  /// Waits until a lazy checkpoint recovery in progress is finished.
+  void testingWaitForRecovery();
+
  private:
   // Magic number separating file names from cache entry data in checkpoint
   // file.
@@ -439,6 +464,14 @@ class SsdFile {
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
+  // Reads the checkpoint from 'state' and resets the checkpoint if this
+  // fails.
+  void recoverFromCheckpoint(std::ifstream& state);
+
+  // Returns true if 'offset' holds an entry recovered from checkpoint whose
+  // checksum has not been verified, and marks the entry verified.
+  bool takeUnverified(uint64_t offset);
+
   // Reads a checkpoint state file and sets 'this' accordingly if read is
   // successful. Return true for successful read. A failed read deletes the
   // checkpoint and leaves the log truncated open.
@@ -563,6 +596,23 @@ class SsdFile {
 
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
+
+  // See Config::lazyCheckpointRecovery.
+  const bool lazyCheckpointRecovery_;
+
+  // True while the checkpoint is read on 'executor_'.
+  tsan_atomic<bool> recovering_{false};
+
+  // Realized when the checkpoint read on 'executor_' is finished.
+  folly::SemiFuture<folly::Unit> recoveryFuture_{folly::makeSemiFuture()};
+
+  // Offsets of entries recovered from a checkpoint with checksums whose
+  // checksum is verified on first read.
+  folly::F14FastSet<uint64_t> unverifiedOffsets_;
+
+  // Size of 'unverifiedOffsets_'. Read without 'mutex_' to skip the check
+  // once all recovered entries are verified.
+  std::atomic<int64_t> numUnverified_{0};
 };
 
 } // namespace facebook::velox::cache
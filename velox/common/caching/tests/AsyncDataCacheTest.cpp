@@ -27,6 +27,7 @@
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/compression/Compression.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
@@ -95,7 +96,8 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<bool> {
   void initializeCache(
       uint64_t maxBytes,
       int64_t ssdBytes = 0,
-      uint64_t checkpointIntervalBytes = 0) {
+      uint64_t checkpointIntervalBytes = 0,
+      const AsyncDataCache::Options& cacheOptions = {}) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -131,7 +133,8 @@ class AsyncDataCacheTest : public ::testing::TestWithParam<bool> {
     options.trackDefaultUsage = true;
     manager_ = std::make_unique<memory::MemoryManager>(options);
     allocator_ = static_cast<memory::MmapAllocator*>(manager_->allocator());
-    cache_ = AsyncDataCache::create(allocator_, std::move(ssdCache));
+    cache_ = AsyncDataCache::create(
+        allocator_, std::move(ssdCache), cacheOptions);
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -1277,6 +1280,256 @@ TEST_P(AsyncDataCacheTest, makeEvictable) {
 
 // TODO: add concurrent fuzzer test.
 
+TEST_P(AsyncDataCacheTest, admission) {
+  constexpr int kDataSize = 4096;
+  initializeCache(64 << 20, 0, 0, AsyncDataCache::Options(2));
+  auto lookup = [&](uint64_t offset) {
+    auto pin =
+        cache_->findOrCreate({filenames_[0].id(), offset}, kDataSize, nullptr);
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared();
+    }
+    return pin.entry();
+  };
+
+  // The first lookup of a key creates an entry that is first in line for
+  // eviction.
+  auto* entry = lookup(0);
+  ASSERT_FALSE(entry->isAdmitted());
+  ASSERT_EQ(entry->testingAccessStats().lastUse, 0);
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numAdmissionRejects, 1);
+  ASSERT_EQ(stats.numAdmissionPromotions, 0);
+
+  // A hit admits the entry.
+  ASSERT_EQ(lookup(0), entry);
+  ASSERT_TRUE(entry->isAdmitted());
+  ASSERT_NE(entry->testingAccessStats().lastUse, 0);
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numAdmissionRejects, 1);
+  ASSERT_EQ(stats.numAdmissionPromotions, 1);
+  ASSERT_EQ(stats.numHit, 1);
+  ASSERT_EQ(stats.numNew, 1);
+  ASSERT_EQ(stats.hitRate(), 0.5);
+
+  // A one-off scan creates entries that are evicted before the admitted
+  // entry.
+  const auto now = accessTime();
+  for (auto i = 1; i <= 10; ++i) {
+    auto* scanEntry = lookup(i * kDataSize);
+    ASSERT_FALSE(scanEntry->isAdmitted());
+    ASSERT_GT(scanEntry->score(now), entry->score(now));
+  }
+
+  // Without an admission frequency all entries are admitted.
+  initializeCache(64 << 20);
+  ASSERT_TRUE(lookup(0)->isAdmitted());
+  ASSERT_EQ(cache_->refreshStats().numAdmissionRejects, 0);
+}
+
+TEST_P(AsyncDataCacheTest, compressedEntries) {
+  if (!folly::io::hasCodec(folly::io::CodecType::LZ4)) {
+    GTEST_SKIP() << "LZ4 is not supported";
+  }
+  constexpr int64_t kDataSize = 128 << 10;
+  constexpr int64_t kMaxCompressedBytes = 1 << 20;
+  initializeCache(16 << 20, 0, 0, {0, 1 << 16, kMaxCompressedBytes});
+  // Fills entries with a byte that depends on the offset so that they
+  // compress well.
+  auto fill = [&](int32_t fileIndex, int32_t numEntries) {
+    for (auto i = 0; i < numEntries; ++i) {
+      const uint64_t offset = i * kDataSize;
+      auto pin = cache_->findOrCreate(
+          {filenames_[fileIndex].id(), offset}, kDataSize, nullptr);
+      ASSERT_TRUE(pin.entry()->isExclusive());
+      auto& data = pin.entry()->data();
+      for (auto run = 0; run < data.numRuns(); ++run) {
+        ::memset(
+            data.runAt(run).data<char>(),
+            i % 100,
+            data.runAt(run).numBytes());
+      }
+      pin.entry()->setExclusiveToShared(false);
+    }
+  };
+
+  // Twice the cache capacity. The eviction compresses entries until the
+  // compressed tier is full.
+  fill(0, 64);
+  fill(1, 64);
+  auto stats = cache_->refreshStats();
+  ASSERT_GT(stats.numCompress, 0);
+  ASSERT_GT(stats.numCompressed, 0);
+  ASSERT_LE(stats.compressedSize, kMaxCompressedBytes);
+  ASSERT_EQ(stats.compressedSize, cache_->compressedBytes());
+  ASSERT_EQ(stats.numDecompress, 0);
+
+  AsyncDataCacheEntry* compressed = nullptr;
+  for (auto* entry : cache_->testingCacheEntries()) {
+    if (entry->isCompressed()) {
+      ASSERT_TRUE(entry->data().empty());
+      ASSERT_EQ(entry->numPins(), 0);
+      compressed = entry;
+      break;
+    }
+  }
+  ASSERT_NE(compressed, nullptr);
+
+  // A hit decompresses the entry and returns a shared pin.
+  const RawFileCacheKey key{
+      compressed->key().fileNum.id(),
+      static_cast<uint64_t>(compressed->offset())};
+  const char expected = (key.offset / kDataSize) % 100;
+  auto pin = cache_->findOrCreate(key, kDataSize, nullptr);
+  ASSERT_EQ(pin.entry(), compressed);
+  ASSERT_TRUE(pin.entry()->isShared());
+  ASSERT_FALSE(pin.entry()->isCompressed());
+  const auto& data = pin.entry()->data();
+  int64_t bytesChecked = 0;
+  for (auto run = 0; run < data.numRuns() && bytesChecked < kDataSize;
+       ++run) {
+    const auto* chars = data.runAt(run).data<char>();
+    const auto numBytes = std::min<int64_t>(
+        kDataSize - bytesChecked, data.runAt(run).numBytes());
+    for (auto i = 0; i < numBytes; ++i) {
+      ASSERT_EQ(chars[i], expected);
+    }
+    bytesChecked += numBytes;
+  }
+  ASSERT_EQ(bytesChecked, kDataSize);
+  stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numDecompress, 1);
+  ASSERT_EQ(stats.compressedSize, cache_->compressedBytes());
+  pin.clear();
+
+  // Clearing the cache drops the compressed entries.
+  cache_->testingClear();
+  ASSERT_EQ(cache_->compressedBytes(), 0);
+  ASSERT_EQ(cache_->refreshStats().numCompressed, 0);
+}
+
+TEST_P(AsyncDataCacheTest, cachedFilesSummary) {
+  constexpr int kDataSize = 4096;
+  initializeCache(64 << 20);
+  ASSERT_TRUE(cache_->cachedFilesSummary().fileBytes.empty());
+
+  std::vector<CachePin> pins;
+  for (auto i = 0; i < 3; ++i) {
+    pins.push_back(cache_->findOrCreate(
+        {filenames_[i % 2].id(), static_cast<uint64_t>(i * kDataSize)},
+        kDataSize,
+        nullptr));
+  }
+  // Entries being loaded are not counted.
+  ASSERT_TRUE(cache_->cachedFilesSummary().fileBytes.empty());
+  for (auto& pin : pins) {
+    pin.entry()->setExclusiveToShared();
+  }
+
+  const auto summary = cache_->cachedFilesSummary();
+  ASSERT_EQ(summary.fileBytes.size(), 2);
+  ASSERT_EQ(summary.fileBytes.at("testing_file_0"), 2 * kDataSize);
+  ASSERT_EQ(summary.fileBytes.at("testing_file_1"), kDataSize);
+  ASSERT_TRUE(summary.mayContain("testing_file_0"));
+  ASSERT_TRUE(summary.mayContain("testing_file_1"));
+  ASSERT_EQ(summary.fileBytes.count("testing_file_2"), 0);
+}
+
+TEST_P(AsyncDataCacheTest, tagQuota) {
+  constexpr int64_t kDataSize = 128 << 10;
+  constexpr int64_t kCacheSize = 16 << 20;
+  initializeCache(kCacheSize);
+  auto load = [&](int32_t fileIndex, int32_t numEntries, uint64_t tag) {
+    for (auto i = 0; i < numEntries; ++i) {
+      auto pin = cache_->findOrCreate(
+          {filenames_[fileIndex].id(), static_cast<uint64_t>(i * kDataSize)},
+          kDataSize,
+          nullptr);
+      if (pin.empty()) {
+        continue;
+      }
+      if (pin.entry()->isExclusive()) {
+        pin.entry()->setTag(tag);
+        ASSERT_EQ(pin.entry()->tag(), tag);
+        pin.entry()->setExclusiveToShared();
+      }
+    }
+  };
+  auto tagBytes = [&](uint64_t tag) {
+    int64_t bytes = 0;
+    for (auto* entry : cache_->testingCacheEntries()) {
+      if (entry != nullptr && entry->tag() == tag) {
+        bytes += entry->size();
+      }
+    }
+    return bytes;
+  };
+
+  // Tag 1 takes half the cache and is hit often so that it would be retained
+  // over new entries.
+  for (auto i = 0; i < 10; ++i) {
+    load(0, 64, 1);
+  }
+  ASSERT_EQ(tagBytes(1), 64 * kDataSize);
+  ASSERT_EQ(cache_->refreshStats().numEvictOverQuota, 0);
+
+  // With a quota of a quarter of the cache, tag 1 is evicted first when tag 2
+  // needs space.
+  cache_->setTagQuota(1, 0.25);
+  load(1, 128, 2);
+  ASSERT_GT(cache_->refreshStats().numEvictOverQuota, 0);
+  ASSERT_LE(tagBytes(1), kCacheSize / 4 + 4 * kDataSize);
+  ASSERT_GT(tagBytes(2), 0);
+
+  // Removing the quota stops the preferential eviction.
+  cache_->setTagQuota(1, 0);
+  const auto numEvictOverQuota = cache_->refreshStats().numEvictOverQuota;
+  load(0, 128, 1);
+  ASSERT_EQ(cache_->refreshStats().numEvictOverQuota, numEvictOverQuota);
+
+  // Evicted entries are no longer counted.
+  cache_->testingClear();
+  ASSERT_EQ(tagBytes(1), 0);
+  ASSERT_EQ(tagBytes(2), 0);
+  VELOX_ASSERT_THROW(cache_->setTagQuota(0, 0.5), "");
+  VELOX_ASSERT_THROW(cache_->setTagQuota(1, 2), "");
+}
+
+TEST_P(AsyncDataCacheTest, concurrentHits) {
+  constexpr int kDataSize = 4096;
+  constexpr int kNumEntries = 16;
+  constexpr int kNumThreads = 8;
+  constexpr int kNumHits = 10'000;
+  initializeCache(64 << 20);
+  for (auto i = 0; i < kNumEntries; ++i) {
+    auto pin = cache_->findOrCreate(
+        {filenames_[0].id(), static_cast<uint64_t>(i * kDataSize)},
+        kDataSize,
+        nullptr);
+    pin.entry()->setExclusiveToShared();
+  }
+
+  runThreads(kNumThreads, [&](int32_t threadIndex) {
+    for (auto i = 0; i < kNumHits; ++i) {
+      const uint64_t offset = ((threadIndex + i) % kNumEntries) * kDataSize;
+      auto pin = cache_->findOrCreate(
+          {filenames_[0].id(), offset}, kDataSize, nullptr);
+      ASSERT_TRUE(pin.entry()->isShared());
+      ASSERT_EQ(pin.entry()->offset(), offset);
+    }
+  });
+
+  const auto stats = cache_->refreshStats();
+  ASSERT_EQ(stats.numHit, kNumThreads * kNumHits);
+  ASSERT_EQ(stats.hitBytes, int64_t(kNumThreads) * kNumHits * kDataSize);
+  ASSERT_EQ(stats.numNew, kNumEntries);
+  ASSERT_EQ(stats.numShared, 0);
+  for (auto* entry : cache_->testingCacheEntries()) {
+    ASSERT_EQ(entry->numPins(), 0);
+    ASSERT_GE(entry->testingAccessStats().numUses, 1);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     AsyncDataCacheTest,
     AsyncDataCacheTest,
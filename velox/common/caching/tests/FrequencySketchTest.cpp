@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch(1'000);
+  EXPECT_EQ(sketch.estimate(1), 0);
+  for (auto i = 0; i < 5; ++i) {
+    sketch.increment(1);
+  }
+  sketch.increment(2);
+  EXPECT_EQ(sketch.estimate(1), 5);
+  EXPECT_EQ(sketch.estimate(2), 1);
+  EXPECT_EQ(sketch.estimate(3), 0);
+
+  // Counts saturate.
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(2);
+  }
+  EXPECT_EQ(sketch.estimate(2), FrequencySketch::kMaxCount);
+}
+
+TEST(FrequencySketchTest, aging) {
+  // The width is rounded up to 1024, so counters halve after 10240
+  // increments.
+  FrequencySketch sketch(1'000);
+  for (auto i = 0; i < 8; ++i) {
+    sketch.increment(1);
+  }
+  for (uint64_t i = 0; i < 10'240 - 8; ++i) {
+    sketch.increment(1'000 + i);
+  }
+  // The estimate may be inflated by collisions with the other keys.
+  EXPECT_GE(sketch.estimate(1), 4);
+  EXPECT_LT(sketch.estimate(1), 8);
+}
@@ -21,6 +21,7 @@
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include <fcntl.h>
+#include <folly/executors/ManualExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -82,7 +83,9 @@ class SsdFileTest : public testing::Test {
       uint64_t checkpointIntervalBytes = 0,
       bool checksumEnabled = false,
       bool checksumReadVerificationEnabled = false,
-      bool disableFileCow = false) {
+      bool disableFileCow = false,
+      folly::Executor* executor = nullptr,
+      bool lazyCheckpointRecovery = false) {
     SsdFile::Config config(
         fmt::format("{}/ssdtest", tempDirectory_->getPath()),
         0, // shardId
@@ -90,7 +93,9 @@ class SsdFileTest : public testing::Test {
         checkpointIntervalBytes,
         disableFileCow,
         checksumEnabled,
-        checksumReadVerificationEnabled);
+        checksumReadVerificationEnabled,
+        executor,
+        lazyCheckpointRecovery);
     ssdFile_ = std::make_unique<SsdFile>(config);
   }
 
@@ -521,6 +526,58 @@ TEST_F(SsdFileTest, fileCorruption) {
   populateCache(allEntries);
 }
 
+TEST_F(SsdFileTest, lazyCheckpointRecovery) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  const uint64_t checkpointIntervalBytes = 3 * SsdFile::kRegionSize;
+  FLAGS_ssd_verify_write = true;
+  initializeCache(kSsdSize, checkpointIntervalBytes, true, false);
+
+  std::vector<TestEntry> allEntries;
+  {
+    auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+  }
+  ssdFile_->checkpoint(true);
+  corruptSsdFile(fmt::format("{}/ssdtest", tempDirectory_->getPath()));
+
+  folly::ManualExecutor executor;
+  initializeSsdFile(
+      kSsdSize,
+      checkpointIntervalBytes,
+      true,
+      false,
+      false,
+      &executor,
+      true);
+  // The file serves misses and drops writes until the checkpoint is read.
+  ASSERT_TRUE(ssdFile_->isRecovering());
+  EXPECT_EQ(checkEntries(allEntries), 0);
+  {
+    auto pins = makePins(fileName_.id(), 0, 4096, 4096, 4096);
+    ssdFile_->write(pins);
+    EXPECT_EQ(pins[0].entry()->ssdFile(), nullptr);
+  }
+  EXPECT_EQ(ssdFile_->testingStats().writeSsdDropped, 1);
+
+  executor.drain();
+  ssdFile_->testingWaitForRecovery();
+  ASSERT_FALSE(ssdFile_->isRecovering());
+  EXPECT_EQ(ssdFile_->testingStats().checkpointsRead, 1);
+  // Entries at the front are intact. The recovered entries are verified on
+  // first read although read verification is off, so the corrupted entries at
+  // the end fail to load.
+  EXPECT_EQ(checkEntries({allEntries.begin(), allEntries.begin() + 10}), 10);
+  EXPECT_EQ(ssdFile_->testingStats().readSsdCorruptions, 0);
+  VELOX_ASSERT_THROW(
+      checkEntries({allEntries.end() - 1, allEntries.end()}),
+      "Corrupt SSD cache entry");
+  EXPECT_EQ(ssdFile_->testingStats().readSsdCorruptions, 1);
+}
+
 TEST_F(SsdFileTest, recoverFromCheckpointWithChecksum) {
   constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
   const uint64_t checkpointIntervalBytes = 3 * SsdFile::kRegionSize;
@@ -16,6 +16,8 @@
 
 #include <fcntl.h>
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
@@ -279,6 +281,47 @@ TEST_P(LocalFileTest, readFileDestructor) {
   }
 }
 
+TEST_P(LocalFileTest, preadvAsync) {
+  if (useFaultyFs_) {
+    return;
+  }
+  auto tempFile = exec::test::TempFilePath::create();
+  const auto& filename = tempFile->getPath();
+  auto fs = filesystems::getFileSystem(filename, {});
+  fs->remove(filename);
+  {
+    auto writeFile = fs->openFileForWrite(filename);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  for (auto* fileExecutor : {static_cast<folly::Executor*>(nullptr),
+                             static_cast<folly::Executor*>(executor.get())}) {
+    LocalReadFile readFile(filename, fileExecutor);
+    ASSERT_EQ(readFile.hasPreadvAsync(), fileExecutor != nullptr);
+    std::string head(5, '\0');
+    std::string tail(5, '\0');
+    std::vector<folly::Range<char*>> buffers = {
+        folly::Range<char*>(head.data(), head.size()),
+        folly::Range<char*>(nullptr, 5 + kOneMB),
+        folly::Range<char*>(tail.data(), tail.size())};
+    ASSERT_EQ(readFile.preadvAsync(0, buffers).get(), 15 + kOneMB);
+    ASSERT_EQ(head, "aaaaa");
+    ASSERT_EQ(tail, "ddddd");
+
+    // A read past the end returns the bytes up to the end.
+    std::string pastEnd(10, '\0');
+    ASSERT_EQ(
+        readFile
+            .preadvAsync(
+                10 + kOneMB,
+                {folly::Range<char*>(pastEnd.data(), pastEnd.size())})
+            .get(),
+        5);
+  }
+}
+
 TEST_P(LocalFileTest, mkdir) {
   auto tempFolder = exec::test::TempDirectoryPath::create(useFaultyFs_);
 
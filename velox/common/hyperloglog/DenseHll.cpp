@@ -15,6 +15,7 @@
  */
 #include "velox/common/hyperloglog/DenseHll.h"
 
+#include <array>
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
@@ -205,12 +206,15 @@ struct DenseHllView {
 int64_t cardinalityImpl(const DenseHllView& hll) {
   auto numBuckets = 1 << hll.indexBitLength;
 
-  int32_t baselineCount = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    if (hll.getDelta(i) == 0) {
-      baselineCount++;
-    }
+  // Histogram of the deltas, two per byte. The harmonic mean then takes one
+  // term per distinct delta instead of one per bucket.
+  std::array<int32_t, kMaxDelta + 1> deltaCounts{};
+  const auto* deltas = reinterpret_cast<const uint8_t*>(hll.deltas);
+  for (int i = 0; i < numBuckets / 2; i++) {
+    ++deltaCounts[deltas[i] >> kBitsPerBucket];
+    ++deltaCounts[deltas[i] & kBucketMask];
   }
+  const int32_t baselineCount = deltaCounts[0];
 
   // If baseline is zero, then baselineCount is the number of buckets with value
   // 0.
@@ -219,11 +223,22 @@ int64_t cardinalityImpl(const DenseHllView& hll) {
     return std::round(linearCounting(baselineCount, numBuckets));
   }
 
+  // Buckets at kMaxDelta with an overflow are added with their full value.
+  double overflowSum = 0;
+  for (int i = 0; i < hll.overflows; i++) {
+    if (hll.getDelta(hll.overflowBuckets[i]) == kMaxDelta) {
+      --deltaCounts[kMaxDelta];
+      int value = hll.baseline + kMaxDelta + hll.overflowValues[i];
+      overflowSum += 1.0 / (1L << value);
+    }
+  }
+
   double sum = 0;
-  for (int i = 0; i < numBuckets; i++) {
-    int value = hll.getValue(i);
-    sum += 1.0 / (1L << value);
+  for (int delta = 0; delta <= kMaxDelta; delta++) {
+    sum += deltaCounts[delta] /
+        static_cast<double>(1L << (hll.baseline + delta));
   }
+  sum += overflowSum;
 
   double estimate = (alpha(hll.indexBitLength) * numBuckets * numBuckets) / sum;
   estimate = correctBias(estimate, hll.indexBitLength);
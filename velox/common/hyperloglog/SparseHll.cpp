@@ -57,6 +57,24 @@ int searchIndex(
   return -(low + 1);
 }
 
+// Inserts a sparse 'entry' into 'denseHll'.
+inline void insertIntoDense(uint32_t entry, DenseHll& denseHll) {
+  auto indexBitLength = denseHll.indexBitLength();
+  auto index = entry >> (32 - indexBitLength);
+  auto shiftedValue = entry << indexBitLength;
+  auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
+
+  // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
+  // were zeros, so look at the entry value, which contains the number of
+  // leading 0 *after* kIndexBitLength.
+  auto bits = kIndexBitLength - indexBitLength;
+  if (zeros >= bits) {
+    zeros = bits + decodeValue(entry);
+  }
+
+  denseHll.insert(index, zeros + 1);
+}
+
 common::InputByteStream initializeInputStream(const char* serialized) {
   common::InputByteStream stream(serialized);
 
@@ -162,6 +180,9 @@ SparseHll::SparseHll(const char* serialized, HashStringAllocator* allocator)
 }
 
 void SparseHll::mergeWith(const SparseHll& other) {
+  if (&other == this) {
+    return;
+  }
   auto size = other.entries_.size();
   // This check prevents merge aggregation from being performed on
   // empty_approx_set(), an empty HyperLogLog. The merge function typically does
@@ -187,39 +208,46 @@ void SparseHll::mergeWith(const char* serialized) {
 void SparseHll::mergeWith(size_t otherSize, const uint32_t* otherEntries) {
   VELOX_CHECK_GT(otherSize, 0);
 
-  auto size = entries_.size();
-  std::vector<uint32_t> merged(size + otherSize);
+  // Merges in place from the back so that no temporary buffer is needed.
+  // Entries with the same bucket in both instances leave a gap at the front of
+  // the merged entries that is closed at the end.
+  const int64_t size = entries_.size();
+  const int64_t totalSize = size + otherSize;
+  entries_.resize(totalSize);
+  auto* entries = entries_.data();
 
-  int pos = 0;
-  int leftPos = 0;
-  int rightPos = 0;
+  int64_t pos = totalSize - 1;
+  int64_t leftPos = size - 1;
+  int64_t rightPos = otherSize - 1;
 
-  while (leftPos < size && rightPos < otherSize) {
-    auto left = decodeIndex(entries_[leftPos]);
+  while (leftPos >= 0 && rightPos >= 0) {
+    auto left = decodeIndex(entries[leftPos]);
     auto right = decodeIndex(otherEntries[rightPos]);
-    if (left < right) {
-      merged[pos++] = entries_[leftPos++];
-    } else if (left > right) {
-      merged[pos++] = otherEntries[rightPos++];
+    if (left > right) {
+      entries[pos--] = entries[leftPos--];
+    } else if (left < right) {
+      entries[pos--] = otherEntries[rightPos--];
     } else {
       auto value = std::max(
-          decodeValue(entries_[leftPos++]),
-          decodeValue(otherEntries[rightPos++]));
-      merged[pos++] = encode(left, value);
+          decodeValue(entries[leftPos--]),
+          decodeValue(otherEntries[rightPos--]));
+      entries[pos--] = encode(left, value);
     }
   }
 
-  while (leftPos < size) {
-    merged[pos++] = entries_[leftPos++];
-  }
-
-  while (rightPos < otherSize) {
-    merged[pos++] = otherEntries[rightPos++];
+  while (rightPos >= 0) {
+    entries[pos--] = otherEntries[rightPos--];
   }
 
-  entries_.resize(pos);
-  for (auto i = 0; i < pos; i++) {
-    entries_[i] = merged[i];
+  // The remaining entries in [0, leftPos] are already in place.
+  const auto numLeft = leftPos + 1;
+  const auto firstMerged = pos + 1;
+  if (firstMerged > numLeft) {
+    std::memmove(
+        entries + numLeft,
+        entries + firstMerged,
+        (totalSize - firstMerged) * sizeof(uint32_t));
+    entries_.resize(numLeft + totalSize - firstMerged);
   }
 }
 
@@ -237,23 +265,18 @@ void SparseHll::verify() const {
 }
 
 void SparseHll::toDense(DenseHll& denseHll) const {
-  auto indexBitLength = denseHll.indexBitLength();
+  for (auto entry : entries_) {
+    insertIntoDense(entry, denseHll);
+  }
+}
 
-  for (auto i = 0; i < entries_.size(); i++) {
-    auto entry = entries_[i];
-    auto index = entry >> (32 - indexBitLength);
-    auto shiftedValue = entry << indexBitLength;
-    auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
-
-    // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
-    // were zeros, so look at the entry value, which contains the number of
-    // leading 0 *after* kIndexBitLength.
-    auto bits = kIndexBitLength - indexBitLength;
-    if (zeros >= bits) {
-      zeros = bits + decodeValue(entry);
-    }
+// static
+void SparseHll::toDense(const char* serialized, DenseHll& denseHll) {
+  auto stream = initializeInputStream(serialized);
 
-    denseHll.insert(index, zeros + 1);
+  auto size = stream.read<int16_t>();
+  for (auto i = 0; i < size; i++) {
+    insertIntoDense(stream.read<uint32_t>(), denseHll);
   }
 }
 
@@ -79,6 +79,7 @@ class SparseHllTest : public ::testing::Test {
     ASSERT_EQ(
         SparseHll::cardinality(hllLeftSerialized.data()),
         expected.cardinality());
+    ASSERT_EQ(hllLeftSerialized, serialize(11, expected));
   }
 
   SparseHll roundTrip(SparseHll& hll) {
@@ -207,6 +208,14 @@ TEST_P(SparseHllToDenseTest, toDense) {
   sparseHll.toDense(denseHll);
   ASSERT_EQ(denseHll.cardinality(), expectedHll.cardinality());
   ASSERT_EQ(serialize(denseHll), serialize(expectedHll));
+
+  // Merge the serialized form.
+  std::string serializedSparse;
+  serializedSparse.resize(sparseHll.serializedSize());
+  sparseHll.serialize(indexBitLength, serializedSparse.data());
+  DenseHll fromSerialized{indexBitLength, &allocator_};
+  SparseHll::toDense(serializedSparse.data(), fromSerialized);
+  ASSERT_EQ(serialize(fromSerialized), serialize(expectedHll));
 }
 
 TEST_P(SparseHllToDenseTest, testNumberOfZeros) {
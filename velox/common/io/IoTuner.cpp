@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoTuner.h"
+
+#include <algorithm>
+
+namespace facebook::velox::io {
+
+// static
+std::string_view IoTuner::backend(std::string_view fileName) {
+  const auto pos = fileName.find("://");
+  if (pos == std::string_view::npos) {
+    return "file";
+  }
+  return fileName.substr(0, pos);
+}
+
+void IoTuner::recordRead(
+    std::string_view fileName,
+    uint64_t bytes,
+    uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& samples = backends_[std::string(backend(fileName))];
+  samples.count = samples.count * config_.decay + 1;
+  samples.sumBytes = samples.sumBytes * config_.decay + x;
+  samples.sumMicros = samples.sumMicros * config_.decay + y;
+  samples.sumBytesSquared = samples.sumBytesSquared * config_.decay + x * x;
+  samples.sumBytesMicros = samples.sumBytesMicros * config_.decay + x * y;
+  ++samples.numSamples;
+}
+
+std::optional<IoTuner::Estimate> IoTuner::estimate(
+    std::string_view fileName) const {
+  Samples samples;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto it = backends_.find(backend(fileName));
+    if (it == backends_.end()) {
+      return std::nullopt;
+    }
+    samples = it->second;
+  }
+  if (samples.numSamples < config_.minSamples) {
+    return std::nullopt;
+  }
+  const auto meanBytes = samples.sumBytes / samples.count;
+  const auto meanMicros = samples.sumMicros / samples.count;
+  const auto varianceBytes =
+      samples.sumBytesSquared / samples.count - meanBytes * meanBytes;
+  // The reads must differ in size to tell latency from throughput.
+  if (varianceBytes <= 1e-6 * meanBytes * meanBytes) {
+    return std::nullopt;
+  }
+  const auto covariance =
+      samples.sumBytesMicros / samples.count - meanBytes * meanMicros;
+  const auto microsPerByte = covariance / varianceBytes;
+  if (microsPerByte <= 0) {
+    return std::nullopt;
+  }
+
+  Estimate estimate;
+  estimate.latencyUs = std::max(0.0, meanMicros - microsPerByte * meanBytes);
+  estimate.bytesPerUs = 1 / microsPerByte;
+  const auto latencyBytes = estimate.latencyUs * estimate.bytesPerUs;
+  estimate.coalesceDistance = std::clamp<double>(
+      latencyBytes, config_.minCoalesceDistance, config_.maxCoalesceDistance);
+  estimate.loadQuantum = std::clamp<double>(
+      latencyBytes * config_.quantumLatencyMultiple,
+      config_.minLoadQuantum,
+      config_.maxLoadQuantum);
+  return estimate;
+}
+
+// static
+ReaderOptions IoTuner::tunedOptions(
+    const ReaderOptions& options,
+    std::string_view fileName) {
+  ReaderOptions tuned(options);
+  if (options.ioTuner() == nullptr) {
+    return tuned;
+  }
+  const auto estimate = options.ioTuner()->estimate(fileName);
+  if (estimate.has_value()) {
+    tuned.setMaxCoalesceDistance(estimate->coalesceDistance);
+    tuned.setLoadQuantum(estimate->loadQuantum);
+  }
+  return tuned;
+}
+
+} // namespace facebook::velox::io
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/io/Options.h"
+
+namespace facebook::velox::io {
+
+/// Adapts the coalescing distance and the load quantum of reads to the
+/// latency and throughput measured for each storage backend, e.g. local disk,
+/// S3 or HDFS. Each read of 'bytes' that takes 'micros' is a sample of
+/// micros = latency + bytes / throughput, and the two are fitted by least
+/// squares over exponentially decaying samples. A gap between two reads is
+/// worth reading if it takes less time than the latency of a separate
+/// request, so that the coalesce distance is latency * throughput. The load
+/// quantum is a multiple of this, so that the latency is a small part of the
+/// time of each request. Thread safe.
+class IoTuner {
+ public:
+  struct Config {
+    /// Limits of the coalesce distance.
+    int32_t minCoalesceDistance{4 << 10};
+    int32_t maxCoalesceDistance{16 << 20};
+
+    /// Limits of the load quantum.
+    int32_t minLoadQuantum{1 << 20};
+    int32_t maxLoadQuantum{64 << 20};
+
+    /// Load quantum as a multiple of latency * throughput.
+    double quantumLatencyMultiple{4};
+
+    /// Number of samples after which a backend is tuned.
+    int32_t minSamples{16};
+
+    /// Weight of the previous samples when adding a sample.
+    double decay{0.98};
+  };
+
+  /// Read cost model of a backend.
+  struct Estimate {
+    double latencyUs;
+    double bytesPerUs;
+    int32_t coalesceDistance;
+    int32_t loadQuantum;
+  };
+
+  explicit IoTuner(Config config = {}) : config_(config) {}
+
+  /// Records a read of 'bytes' from 'fileName' that took 'micros'.
+  void recordRead(std::string_view fileName, uint64_t bytes, uint64_t micros);
+
+  /// Returns the estimate for the backend of 'fileName' or std::nullopt if
+  /// there are not enough samples with different sizes.
+  std::optional<Estimate> estimate(std::string_view fileName) const;
+
+  /// Returns 'options' with the coalesce distance and load quantum set for the
+  /// backend of 'fileName' if 'options' has an IoTuner that has an estimate
+  /// for it. Otherwise returns 'options' unchanged.
+  static ReaderOptions tunedOptions(
+      const ReaderOptions& options,
+      std::string_view fileName);
+
+  /// Returns the backend of 'fileName', i.e. the scheme of the path like
+  /// "s3", or "file" for paths without a scheme.
+  static std::string_view backend(std::string_view fileName);
+
+ private:
+  // Exponentially decaying sums for a least squares fit.
+  struct Samples {
+    double count{0};
+    double sumBytes{0};
+    double sumMicros{0};
+    double sumBytesSquared{0};
+    double sumBytesMicros{0};
+    int64_t numSamples{0};
+  };
+
+  const Config config_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, Samples> backends_;
+};
+
+} // namespace facebook::velox::io
@@ -20,6 +20,8 @@
 
 namespace facebook::velox::io {
 
+class IoTuner;
+
 constexpr uint64_t DEFAULT_AUTO_PRELOAD_SIZE =
     (static_cast<const uint64_t>((1ul << 20) * 72));
 
@@ -77,6 +79,8 @@ class ReaderOptions {
     prefetchRowGroups_ = other.prefetchRowGroups_;
     loadQuantum_ = other.loadQuantum_;
     noCacheRetention_ = other.noCacheRetention_;
+    ioTuner_ = other.ioTuner_;
+    cacheTag_ = other.cacheTag_;
     return *this;
   }
 
@@ -163,6 +167,30 @@ class ReaderOptions {
     noCacheRetention_ = noCacheRetention;
   }
 
+  /// Sets a tuner that measures reads and adapts the coalesce distance and
+  /// load quantum of readers made with 'this' to their storage backend. See
+  /// IoTuner.
+  ReaderOptions& setIoTuner(std::shared_ptr<IoTuner> ioTuner) {
+    ioTuner_ = std::move(ioTuner);
+    return *this;
+  }
+
+  const std::shared_ptr<IoTuner>& ioTuner() const {
+    return ioTuner_;
+  }
+
+  /// Sets the tag of the cache entries loaded by readers made with 'this',
+  /// e.g. a table or tenant id. See AsyncDataCache::setTagQuota(). 0 means no
+  /// tag.
+  ReaderOptions& setCacheTag(uint64_t cacheTag) {
+    cacheTag_ = cacheTag;
+    return *this;
+  }
+
+  uint64_t cacheTag() const {
+    return cacheTag_;
+  }
+
  protected:
   velox::memory::MemoryPool* memoryPool_;
   uint64_t autoPreloadLength_;
@@ -172,5 +200,7 @@ class ReaderOptions {
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
   int32_t prefetchRowGroups_{kDefaultPrefetchRowGroups};
   bool noCacheRetention_{false};
+  std::shared_ptr<IoTuner> ioTuner_;
+  uint64_t cacheTag_{0};
 };
 } // namespace facebook::velox::io
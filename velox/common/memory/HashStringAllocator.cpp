@@ -333,8 +333,15 @@ void HashStringAllocator::freeRestOfBlock(Header* header, int32_t keepBytes) {
   free(newHeader);
 }
 
-int32_t HashStringAllocator::freeListIndex(int size) {
-  return std::min(size - kMinAlloc, kNumFreeLists - 1);
+// static
+int32_t HashStringAllocator::freeListIndex(int32_t size) {
+  if (size <= kMaxAlloc) {
+    return size - kMinAlloc;
+  }
+  // 0 below kLargeFreeListUnit, then 1 + log2 of the number of units.
+  const int32_t largeIndex =
+      64 - bits::countLeadingZeros<uint64_t>(size / kLargeFreeListUnit);
+  return kNumSmallFreeLists + std::min(largeIndex, kNumLargeFreeLists - 1);
 }
 
 void HashStringAllocator::removeFromFreeList(Header* header) {
@@ -546,45 +553,62 @@ inline bool HashStringAllocator::storeStringFast(
   const auto roundedBytes = std::max(numBytes, kMinAlloc);
 
   Header* header = nullptr;
-  if (free_[kNumFreeLists - 1].empty()) {
-    if (roundedBytes >= kMaxAlloc) {
-      return false;
-    }
+  if (roundedBytes <= kMaxAlloc) {
+    // Reuses a free block close to the requested size before splitting the
+    // largest free block so that blocks freed by skewed groups get recycled
+    // instead of growing the footprint.
     const auto index = freeListIndex(roundedBytes);
-    const auto available =
-        bits::findFirstBit(freeNonEmpty_, index, kNumFreeLists);
-    if (available < 0) {
-      return false;
-    }
-    header = allocateFromFreeList(roundedBytes, true, true, available);
-    VELOX_CHECK_NOT_NULL(header);
-  } else {
-    auto& freeList = free_[kNumFreeLists - 1];
-    header = headerOf(freeList.next());
-    const auto spaceTaken = roundedBytes + sizeof(Header);
-    if (spaceTaken > header->size()) {
-      return false;
+    const auto available = bits::findFirstBit(
+        freeNonEmpty_,
+        index,
+        std::min(index + kMaxBestFitDistance, kNumSmallFreeLists));
+    if (available >= 0) {
+      header = allocateFromFreeList(roundedBytes, true, true, available);
+      VELOX_CHECK_NOT_NULL(header);
     }
-    if (header->size() - spaceTaken > kMaxAlloc) {
-      // The entry after allocation stays in the largest free list.
-      // The size at the end of the block is changed in place.
-      reinterpret_cast<int32_t*>(header->end())[-1] -= spaceTaken;
-      auto* freeHeader = new (header->begin() + roundedBytes)
-          Header(header->size() - spaceTaken);
-      freeHeader->setFree();
-      header->clearFree();
-      ::memcpy(freeHeader->begin(), header->begin(), sizeof(CompactDoubleList));
-      freeList.nextMoved(
-          reinterpret_cast<CompactDoubleList*>(freeHeader->begin()));
-      header->setSize(roundedBytes);
-      freeBytes_ -= spaceTaken;
-      cumulativeBytes_ += roundedBytes;
+  }
+  if (header == nullptr) {
+    if (free_[kNumFreeLists - 1].empty()) {
+      if (roundedBytes >= kMaxAlloc) {
+        return false;
+      }
+      const auto index = freeListIndex(roundedBytes);
+      const auto available =
+          bits::findFirstBit(freeNonEmpty_, index, kNumFreeLists);
+      if (available < 0) {
+        return false;
+      }
+      header = allocateFromFreeList(roundedBytes, true, true, available);
+      VELOX_CHECK_NOT_NULL(header);
     } else {
-      header =
-          allocateFromFreeList(roundedBytes, true, true, kNumFreeLists - 1);
-      if (!header) {
+      auto& freeList = free_[kNumFreeLists - 1];
+      header = headerOf(freeList.next());
+      const auto spaceTaken = roundedBytes + sizeof(Header);
+      if (spaceTaken > header->size()) {
         return false;
       }
+      if (freeListIndex(header->size() - spaceTaken) == kNumFreeLists - 1) {
+        // The entry after allocation stays in the largest free list.
+        // The size at the end of the block is changed in place.
+        reinterpret_cast<int32_t*>(header->end())[-1] -= spaceTaken;
+        auto* freeHeader = new (header->begin() + roundedBytes)
+            Header(header->size() - spaceTaken);
+        freeHeader->setFree();
+        header->clearFree();
+        ::memcpy(
+            freeHeader->begin(), header->begin(), sizeof(CompactDoubleList));
+        freeList.nextMoved(
+            reinterpret_cast<CompactDoubleList*>(freeHeader->begin()));
+        header->setSize(roundedBytes);
+        freeBytes_ -= spaceTaken;
+        cumulativeBytes_ += roundedBytes;
+      } else {
+        header =
+            allocateFromFreeList(roundedBytes, true, true, kNumFreeLists - 1);
+        if (!header) {
+          return false;
+        }
+      }
     }
   }
 
@@ -725,11 +749,7 @@ int64_t HashStringAllocator::checkConsistency() const {
           "free list previous link inconsistent");
       const auto size = headerOf(free)->size();
       VELOX_CHECK_GE(size, kMinAlloc);
-      if (size - kMinAlloc < kNumFreeLists - 1) {
-        VELOX_CHECK_EQ(size - kMinAlloc, i);
-      } else {
-        VELOX_CHECK_GE(size - kMinAlloc, kNumFreeLists - 1);
-      }
+      VELOX_CHECK_EQ(freeListIndex(size), i);
       bytesInFreeList += size + sizeof(Header);
     }
   }
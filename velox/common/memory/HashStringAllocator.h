@@ -321,6 +321,14 @@ class HashStringAllocator : public StreamArena {
     return cumulativeBytes_;
   }
 
+  /// Returns the fraction of the memory of the slabs of 'this' that is in free
+  /// blocks. A high value after many frees means the live data is spread thin
+  /// over the slabs.
+  double fragmentation() const {
+    const auto slabBytes = pool_.allocatedBytes();
+    return slabBytes == 0 ? 0 : static_cast<double>(freeBytes_) / slabBytes;
+  }
+
   /// Checks the free space accounting and consistency of Headers. Throws when
   /// detects corruption. Returns the number of allocated payload bytes,
   /// excluding headers, continue links and other overhead.
@@ -341,7 +349,19 @@ class HashStringAllocator : public StreamArena {
  private:
   static constexpr int32_t kUnitSize = 16 * memory::AllocationTraits::kPageSize;
   static constexpr int32_t kMinContiguous = 48;
-  static constexpr int32_t kNumFreeLists = kMaxAlloc - kMinAlloc + 2;
+  // There is one free list for each size up to kMaxAlloc.
+  static constexpr int32_t kNumSmallFreeLists = kMaxAlloc - kMinAlloc + 1;
+  // Free blocks larger than kMaxAlloc are kept in one list per power of two
+  // multiple of kLargeFreeListUnit. The last list has the blocks of at least
+  // kLargeFreeListUnit << (kNumLargeFreeLists - 2) bytes, e.g. new slabs.
+  static constexpr int32_t kLargeFreeListUnit =
+      memory::AllocationTraits::kPageSize;
+  static constexpr int32_t kNumLargeFreeLists = 5;
+  static constexpr int32_t kNumFreeLists =
+      kNumSmallFreeLists + kNumLargeFreeLists;
+  // Max number of size classes above the requested size searched for a free
+  // block before a string is carved out of the largest free block.
+  static constexpr int32_t kMaxBestFitDistance = 64;
 
   void newRange(
       int32_t bytes,
@@ -390,7 +410,7 @@ class HashStringAllocator : public StreamArena {
   bool storeStringFast(const char* bytes, int32_t size, char* destination);
 
   // Returns the free list index for 'size'.
-  int32_t freeListIndex(int size);
+  static int32_t freeListIndex(int32_t size);
 
   // Circular list of free blocks.
   CompactDoubleList free_[kNumFreeLists];
@@ -51,6 +51,8 @@ std::shared_ptr<MemoryAllocator> createAllocator(
     mmapOptions.capacity = options.allocatorCapacity;
     mmapOptions.useMmapArena = options.useMmapArena;
     mmapOptions.mmapArenaCapacityRatio = options.mmapArenaCapacityRatio;
+    mmapOptions.numNumaNodes = options.numNumaNodes;
+    mmapOptions.hugePageMinSizeClass = options.hugePageMinSizeClass;
     return std::make_shared<MmapAllocator>(mmapOptions);
   } else {
     return std::make_shared<MallocAllocator>(
@@ -73,6 +75,7 @@ std::unique_ptr<MemoryArbitrator> createArbitrator(
        .memoryReclaimWaitMs = options.memoryReclaimWaitMs,
        .globalArbitrationEnabled = options.globalArbitrationEnabled,
        .arbitrationStateCheckCb = options.arbitrationStateCheckCb,
+       .candidatePolicy = options.arbitratorCandidatePolicy,
        .checkUsageLeak = options.checkUsageLeak});
 }
 
@@ -99,6 +102,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
       coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      poolThreadCacheBytes_(options.poolThreadCacheBytes),
+      poolAllocationSampleRate_(options.poolAllocationSampleRate),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       poolGrowCb_([&](MemoryPool* pool, uint64_t targetBytes) {
         return growPool(pool, targetBytes);
@@ -226,6 +231,8 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.debugEnabled = debugEnabled_;
   options.coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_;
+  options.threadCacheBytes = poolThreadCacheBytes_;
+  options.allocationSampleRate = poolAllocationSampleRate_;
 
   std::unique_lock guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
@@ -81,6 +81,14 @@ struct MemoryManagerOptions {
   /// Terminates the process and generates a core file on an allocation failure
   bool coreOnAllocationFailureEnabled{false};
 
+  /// If not zero, sets MemoryPool::Options::threadCacheBytes of the root memory
+  /// pools created by addRootPool() and so of their thread-safe leaf pools.
+  int64_t poolThreadCacheBytes{0};
+
+  /// If not zero, sets MemoryPool::Options::allocationSampleRate of the root
+  /// memory pools created by addRootPool() and so of their leaf pools.
+  uint32_t poolAllocationSampleRate{0};
+
   /// ================== 'MemoryAllocator' settings ==================
   /// Specifies the max memory allocation capacity in bytes enforced by
   /// MemoryAllocator, default unlimited.
@@ -105,6 +113,19 @@ struct MemoryManagerOptions {
   /// NOTE: this only applies for MmapAllocator.
   int32_t mmapArenaCapacityRatio{10};
 
+  /// Number of NUMA nodes with separate size classes. If greater than 1,
+  /// allocations are served from memory of the node of the allocating thread
+  /// when possible.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  int32_t numNumaNodes{1};
+
+  /// If not 0, size classes with at least this many machine pages per size
+  /// class page use transparent huge pages.
+  ///
+  /// NOTE: this only applies for MmapAllocator.
+  uint64_t hugePageMinSizeClass{0};
+
   /// If not zero, reserve 'smallAllocationReservePct'% of space from
   /// 'allocatorCapacity' for ad hoc small allocations. And those allocations
   /// are delegated to std::malloc. If 'maxMallocBytes' is 0, this value will be
@@ -188,6 +209,10 @@ struct MemoryManagerOptions {
   /// potential deadlock when reclaim memory from the task of the request memory
   /// pool.
   MemoryArbitrationStateCheckCB arbitrationStateCheckCb{nullptr};
+
+  /// The policy that orders the query memory pools to reclaim used memory
+  /// from. See MemoryArbitrator::Config::candidatePolicy.
+  std::string arbitratorCandidatePolicy{};
 };
 
 /// 'MemoryManager' is responsible for creating allocator, arbitrator and
@@ -315,6 +340,8 @@ class MemoryManager {
   const bool checkUsageLeak_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t poolThreadCacheBytes_;
+  const uint32_t poolAllocationSampleRate_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
@@ -357,6 +357,13 @@ Stats Stats::operator-(const Stats& other) const {
     result.sizes[i] = sizes[i] - other.sizes[i];
   }
   result.numAdvise = numAdvise - other.numAdvise;
+  result.numHugePageBytes = numHugePageBytes;
+  result.numaNodes = numaNodes;
+  for (auto i = 0; i < numaNodes.size() && i < other.numaNodes.size(); ++i) {
+    result.numaNodes[i].numAllocations -= other.numaNodes[i].numAllocations;
+    result.numaNodes[i].numRemoteAllocations -=
+        other.numaNodes[i].numRemoteAllocations;
+  }
   return result;
 }
 
@@ -395,6 +402,17 @@ std::string Stats::toString() const {
         sizes[i].clocks() >> 20,
         sizes[i].numAllocations);
   }
+  if (numHugePageBytes > 0) {
+    out << fmt::format("Huge pages: {}MB\n", numHugePageBytes >> 20);
+  }
+  for (auto i = 0; i < numaNodes.size(); ++i) {
+    out << fmt::format(
+        "NUMA node {}: {}MB allocated {} Allocations {} remote\n",
+        i,
+        AllocationTraits::pageBytes(numaNodes[i].numAllocatedPages) >> 20,
+        numaNodes[i].numAllocations,
+        numaNodes[i].numRemoteAllocations);
+  }
   return out.str();
 }
 
@@ -413,6 +431,13 @@ void MemoryAllocator::useHugePages(
       maybeRange.value().data(),
       maybeRange.value().size(),
       enable ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+  // Counts the advised range even if madvise fails so that enabling and
+  // disabling for the same allocation cancel out.
+  if (enable) {
+    numHugePageBytes_ += maybeRange.value().size();
+  } else {
+    numHugePageBytes_ -= maybeRange.value().size();
+  }
   if (rc != 0) {
     VELOX_MEM_LOG(WARNING) << "madvise hugepage errno="
                            << folly ::errnoStr(errno);
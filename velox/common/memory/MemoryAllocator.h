@@ -137,6 +137,28 @@ struct Stats {
 
   /// Cumulative count of pages advised away, if the allocator exposes this.
   int64_t numAdvise{0};
+
+  /// Counters of the memory of one NUMA node.
+  struct NumaNodeStats {
+    /// Cumulative count of size class allocations served by the node.
+    int64_t numAllocations{0};
+
+    /// Cumulative count of allocations served by the node for threads running
+    /// on another node whose own size classes had no space.
+    int64_t numRemoteAllocations{0};
+
+    /// Number of machine pages currently allocated from the node.
+    int64_t numAllocatedPages{0};
+  };
+
+  /// Counters for each NUMA node. Empty if the allocator does not keep
+  /// separate memory per node.
+  std::vector<NumaNodeStats> numaNodes;
+
+  /// Bytes of allocated memory in address ranges advised to be backed by
+  /// transparent huge pages. Covers contiguous allocations and size classes
+  /// configured to use huge pages.
+  int64_t numHugePageBytes{0};
 };
 
 class MemoryAllocator;
@@ -343,7 +365,9 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   virtual MachinePageCount numMapped() const = 0;
 
   virtual Stats stats() const {
-    return stats_;
+    auto stats = stats_;
+    stats.numHugePageBytes = numHugePageBytes_;
+    return stats;
   }
 
   virtual std::string toString() const = 0;
@@ -476,6 +500,10 @@ class MemoryAllocator : public std::enable_shared_from_this<MemoryAllocator> {
   // for the address range.
   void useHugePages(const ContiguousAllocation& data, bool enable);
 
+  // Bytes of allocated memory advised to use huge pages. See
+  // Stats::numHugePageBytes.
+  std::atomic<int64_t> numHugePageBytes_{0};
+
   // The machine page counts corresponding to different sizes in order
   // of increasing size.
   const std::vector<MachinePageCount>
@@ -88,6 +88,12 @@ class MemoryArbitrator {
     /// memory pool.
     MemoryArbitrationStateCheckCB arbitrationStateCheckCb{nullptr};
 
+    /// The name of the policy that orders the query memory pools to reclaim
+    /// used memory from. If empty, the arbitrator uses its default policy. The
+    /// shared arbitrator policies are registered through
+    /// SharedArbitrator::registerCandidatePolicy().
+    std::string candidatePolicy{};
+
     /// If true, do sanity check on the arbitrator state on destruction.
     ///
     /// TODO: deprecate this flag after all the existing memory leak use cases
@@ -137,6 +143,15 @@ class MemoryArbitrator {
   /// bytes.
   virtual uint64_t growCapacity(MemoryPool* pool, uint64_t bytes) = 0;
 
+  /// Returns true if a memory arbitration request from root memory 'pool' is
+  /// running and sets 'future' which is fulfilled when 'pool' has no more
+  /// running or queued requests. The default implementation returns false.
+  virtual bool checkArbitrationRunning(
+      MemoryPool* /*unused*/,
+      ContinueFuture* /*unused*/) {
+    return false;
+  }
+
   /// Invoked by the memory manager to grow a memory pool's capacity.
   /// 'pool' is the memory pool to request to grow. 'candidates' is a list
   /// of query root pools to participate in the memory arbitration. The memory
@@ -391,6 +406,19 @@ class MemoryReclaimer {
   /// error exposure.
   virtual void abort(MemoryPool* pool, const std::exception_ptr& error);
 
+  /// Returns the arbitration priority of the query of the root memory pool
+  /// this reclaimer is set on. An arbitration policy that respects priorities
+  /// reclaims memory from the queries with lower priority first.
+  virtual int32_t priority() const {
+    return 0;
+  }
+
+  /// Returns the start time in milliseconds since epoch of the query of the
+  /// root memory pool this reclaimer is set on, 0 if unknown.
+  virtual uint64_t startTimeMs() const {
+    return 0;
+  }
+
  protected:
   MemoryReclaimer() = default;
 };
@@ -16,6 +16,7 @@
 
 #include "velox/common/memory/MemoryPool.h"
 
+#include <folly/hash/Hash.h>
 #include <signal.h>
 #include <set>
 
@@ -23,6 +24,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/testutil/TestValue.h"
 
 #include <re2/re2.h>
@@ -157,6 +159,14 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     recordFreeDbg(__VA_ARGS__);        \
   }
+#define SAMPLE_RECORD_ALLOC(...)                    \
+  if (FOLLY_UNLIKELY(allocationSampleRate_ != 0)) { \
+    recordAllocSample(__VA_ARGS__);                 \
+  }
+#define SAMPLE_RECORD_FREE(...)                     \
+  if (FOLLY_UNLIKELY(allocationSampleRate_ != 0)) { \
+    recordFreeSample(__VA_ARGS__);                  \
+  }
 #define DEBUG_LEAK_CHECK()             \
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
@@ -222,7 +232,9 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       debugEnabled_(options.debugEnabled),
-      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled) {
+      coreOnAllocationFailureEnabled_(options.coreOnAllocationFailureEnabled),
+      threadCacheBytes_(options.threadCacheBytes),
+      allocationSampleRate_(options.allocationSampleRate) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -431,9 +443,49 @@ MemoryPoolImpl::MemoryPoolImpl(
       isRoot() || (destructionCb_ == nullptr && growCapacityCb_ == nullptr),
       "Only root memory pool allows to set destruction and capacity grow callbacks: {}",
       name_);
+  if (isLeaf() && threadSafe_ && threadCacheBytes_ > 0) {
+    threadCaches_ = std::make_unique<folly::ThreadLocal<ThreadCache>>(
+        [this]() { return new ThreadCache(this); });
+  }
+}
+
+MemoryPoolImpl::ThreadCache::~ThreadCache() {
+  for (auto i = 0; i < freeLists_.size(); ++i) {
+    const int64_t size = 1L << i;
+    for (auto* buffer : freeLists_[i]) {
+      pool_->allocator_->freeBytes(buffer, size);
+      pool_->release(size);
+    }
+  }
+}
+
+void* MemoryPoolImpl::ThreadCache::allocate(int64_t size) {
+  if (size <= 0 || size > kMaxThreadCachedBytes) {
+    return nullptr;
+  }
+  auto& freeList = freeLists_[__builtin_ctzll(size)];
+  if (freeList.empty()) {
+    return nullptr;
+  }
+  void* buffer = freeList.back();
+  freeList.pop_back();
+  cachedBytes_ -= size;
+  return buffer;
+}
+
+bool MemoryPoolImpl::ThreadCache::free(void* p, int64_t size) {
+  if (size <= 0 || size > kMaxThreadCachedBytes ||
+      cachedBytes_ + size > pool_->threadCacheBytes_) {
+    return false;
+  }
+  freeLists_[__builtin_ctzll(size)].push_back(p);
+  cachedBytes_ += size;
+  return true;
 }
 
 MemoryPoolImpl::~MemoryPoolImpl() {
+  // Returns the thread cached buffers before checking for leaks.
+  threadCaches_.reset();
   DEBUG_LEAK_CHECK();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
@@ -490,7 +542,12 @@ MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
 
 void* MemoryPoolImpl::allocate(int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
-  const auto alignedSize = sizeAlign(size);
+  const auto alignedSize = allocationSize(size);
+  if (void* buffer = allocateFromThreadCache(alignedSize)) {
+    DEBUG_RECORD_ALLOC(buffer, size);
+    SAMPLE_RECORD_ALLOC(buffer, size);
+    return buffer;
+  }
   reserve(alignedSize);
   void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
@@ -503,13 +560,20 @@ void* MemoryPoolImpl::allocate(int64_t size) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_RECORD_ALLOC(buffer, size);
   return buffer;
 }
 
 void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto size = sizeEach * numEntries;
-  const auto alignedSize = sizeAlign(size);
+  const auto alignedSize = allocationSize(size);
+  if (void* buffer = allocateFromThreadCache(alignedSize)) {
+    ::memset(buffer, 0, alignedSize);
+    DEBUG_RECORD_ALLOC(buffer, size);
+    SAMPLE_RECORD_ALLOC(buffer, size);
+    return buffer;
+  }
   reserve(alignedSize);
   void* buffer = allocator_->allocateZeroFilled(alignedSize);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
@@ -523,15 +587,18 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_RECORD_ALLOC(buffer, size);
   return buffer;
 }
 
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
-  const auto alignedNewSize = sizeAlign(newSize);
-  reserve(alignedNewSize);
-
-  void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
+  const auto alignedNewSize = allocationSize(newSize);
+  void* newP = allocateFromThreadCache(alignedNewSize);
+  if (newP == nullptr) {
+    reserve(alignedNewSize);
+    newP = allocator_->allocateBytes(alignedNewSize, alignment_);
+  }
   if (FOLLY_UNLIKELY(newP == nullptr)) {
     release(alignedNewSize);
     handleAllocationFailure(fmt::format(
@@ -543,6 +610,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  SAMPLE_RECORD_ALLOC(newP, newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -552,8 +620,12 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
 
 void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
-  const auto alignedSize = sizeAlign(size);
+  const auto alignedSize = allocationSize(size);
   DEBUG_RECORD_FREE(p, size);
+  SAMPLE_RECORD_FREE(p, size);
+  if (threadCaches_ != nullptr && (*threadCaches_)->free(p, alignedSize)) {
+    return;
+  }
   allocator_->freeBytes(p, alignedSize);
   release(alignedSize);
 }
@@ -571,6 +643,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  SAMPLE_RECORD_FREE(out);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -591,6 +664,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_RECORD_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -599,6 +673,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   DEBUG_RECORD_FREE(allocation);
+  SAMPLE_RECORD_FREE(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(freedBytes);
@@ -622,6 +697,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  SAMPLE_RECORD_FREE(out);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -643,6 +719,7 @@ void MemoryPoolImpl::allocateContiguous(
         allocator_->getAndClearFailureMessage()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_RECORD_ALLOC(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -652,6 +729,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const int64_t bytesToFree = allocation.size();
   DEBUG_RECORD_FREE(allocation);
+  SAMPLE_RECORD_FREE(allocation);
   allocator_->freeContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(bytesToFree);
@@ -722,7 +800,9 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .debugEnabled = debugEnabled_,
-          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_});
+          .coreOnAllocationFailureEnabled = coreOnAllocationFailureEnabled_,
+          .threadCacheBytes = threadCacheBytes_,
+          .allocationSampleRate = allocationSampleRate_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -1037,6 +1117,10 @@ void MemoryPoolImpl::leaveArbitration() noexcept {
   }
 }
 
+bool MemoryPoolImpl::checkArbitrationRunning(ContinueFuture* future) const {
+  return manager_->arbitrator()->checkArbitrationRunning(root(), future);
+}
+
 uint64_t MemoryPoolImpl::shrink(uint64_t targetBytes) {
   if (parent_ != nullptr) {
     return toImpl(parent_)->shrink(targetBytes);
@@ -1232,6 +1316,107 @@ void MemoryPoolImpl::leakCheckDbg() {
   VELOX_FAIL(buf.str());
 }
 
+void MemoryPoolImpl::recordAllocSample(const void* addr, uint64_t size) {
+  if (numSampleCandidates_++ % allocationSampleRate_ != 0) {
+    return;
+  }
+  process::StackTrace callStack;
+  const auto& frames = callStack.getStack();
+  const uint64_t siteKey =
+      folly::hash::fnv64_buf(frames.data(), frames.size() * sizeof(void*));
+  std::lock_guard<std::mutex> l(sampleMutex_);
+  auto it = allocationSites_.find(siteKey);
+  if (it == allocationSites_.end()) {
+    const auto* debugInfo = process::GetThreadDebugInfo();
+    it = allocationSites_
+             .emplace(
+                 siteKey,
+                 AllocationSite{
+                     std::move(callStack),
+                     debugInfo == nullptr ? "" : debugInfo->taskId_})
+             .first;
+  }
+  auto& site = it->second;
+  ++site.numAllocs;
+  site.bytes += size;
+  site.peakBytes = std::max(site.peakBytes, site.bytes);
+  allocationSamples_[addr] = {siteKey, static_cast<int64_t>(size)};
+}
+
+void MemoryPoolImpl::recordAllocSample(const Allocation& allocation) {
+  if (!allocation.empty()) {
+    recordAllocSample(allocation.runAt(0).data(), allocation.byteSize());
+  }
+}
+
+void MemoryPoolImpl::recordAllocSample(const ContiguousAllocation& allocation) {
+  if (!allocation.empty()) {
+    recordAllocSample(allocation.data(), allocation.size());
+  }
+}
+
+void MemoryPoolImpl::recordFreeSample(const void* addr, uint64_t /*unused*/) {
+  std::lock_guard<std::mutex> l(sampleMutex_);
+  auto it = allocationSamples_.find(addr);
+  if (it == allocationSamples_.end()) {
+    return;
+  }
+  auto siteIt = allocationSites_.find(it->second.siteKey);
+  VELOX_CHECK(siteIt != allocationSites_.end());
+  siteIt->second.bytes -= it->second.size;
+  allocationSamples_.erase(it);
+}
+
+void MemoryPoolImpl::recordFreeSample(const Allocation& allocation) {
+  if (!allocation.empty()) {
+    recordFreeSample(allocation.runAt(0).data(), allocation.byteSize());
+  }
+}
+
+void MemoryPoolImpl::recordFreeSample(const ContiguousAllocation& allocation) {
+  if (!allocation.empty()) {
+    recordFreeSample(allocation.data(), allocation.size());
+  }
+}
+
+std::vector<MemoryPoolImpl::AllocationSite> MemoryPoolImpl::topAllocationSites(
+    size_t maxSites) const {
+  std::vector<AllocationSite> sites;
+  {
+    std::lock_guard<std::mutex> l(sampleMutex_);
+    sites.reserve(allocationSites_.size());
+    for (const auto& [key, site] : allocationSites_) {
+      sites.push_back(site);
+    }
+  }
+  std::sort(
+      sites.begin(),
+      sites.end(),
+      [](const AllocationSite& lhs, const AllocationSite& rhs) {
+        return lhs.bytes > rhs.bytes;
+      });
+  if (sites.size() > maxSites) {
+    sites.resize(maxSites);
+  }
+  return sites;
+}
+
+std::string MemoryPoolImpl::allocationSitesToString(size_t maxSites) const {
+  std::stringstream out;
+  out << "Top allocation sites of " << name_ << " sampled 1 in "
+      << allocationSampleRate_ << ":\n";
+  for (const auto& site : topAllocationSites(maxSites)) {
+    out << "======== " << succinctBytes(site.bytes * allocationSampleRate_)
+        << " allocated, peak "
+        << succinctBytes(site.peakBytes * allocationSampleRate_) << ", "
+        << site.numAllocs << " sampled allocations"
+        << (site.taskId.empty() ? "" : ", task " + site.taskId)
+        << " ========\n"
+        << site.callStack.toString();
+  }
+  return out.str();
+}
+
 void MemoryPoolImpl::handleAllocationFailure(
     const std::string& failureMessage) {
   if (coreOnAllocationFailureEnabled_) {
@@ -23,6 +23,7 @@
 #include <queue>
 
 #include <fmt/format.h>
+#include <folly/ThreadLocal.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -160,6 +161,20 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// Terminates the process and generates a core file on an allocation
     /// failure
     bool coreOnAllocationFailureEnabled{false};
+
+    /// If not zero, each thread keeps up to this many bytes of the memory it
+    /// frees to a thread-safe leaf memory pool for reuse by its later
+    /// allocations from the same pool. A reused allocation takes neither the
+    /// pool mutex nor goes to the memory allocator. The cached memory stays
+    /// counted as used by the pool until the thread exits or the pool is
+    /// destroyed. Allocations of up to MemoryPoolImpl::kMaxThreadCachedBytes
+    /// are rounded up to a power of two when this is set.
+    int64_t threadCacheBytes{0};
+
+    /// If not zero, records the call stack of one in this many allocations
+    /// from a leaf memory pool and aggregates the allocated bytes by call
+    /// stack. See MemoryPoolImpl::topAllocationSites().
+    uint32_t allocationSampleRate{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -379,6 +394,14 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// corresponding method.
   virtual void leaveArbitration() noexcept = 0;
 
+  /// Returns true if a memory arbitration request from the query of this
+  /// memory pool is running and sets 'future' which is fulfilled when the
+  /// query has no more running requests. A query driver uses this to go off
+  /// thread instead of blocking its thread in a queued arbitration request.
+  virtual bool checkArbitrationRunning(ContinueFuture* /*unused*/) const {
+    return false;
+  }
+
   /// Function estimates the number of reclaimable bytes and returns in
   /// 'reclaimableBytes'. If the 'reclaimer' is not set, the function returns
   /// std::nullopt. Otherwise, it will invoke the corresponding method of the
@@ -537,6 +560,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool debugEnabled_;
   const bool coreOnAllocationFailureEnabled_;
+  const int64_t threadCacheBytes_;
+  const uint32_t allocationSampleRate_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -576,6 +601,10 @@ class MemoryPoolImpl : public MemoryPool {
   /// otherwise false.
   using GrowCapacityCallback = std::function<bool(MemoryPool*, uint64_t)>;
 
+  /// The largest allocation kept in the thread caches of a memory pool with
+  /// Options::threadCacheBytes set.
+  static constexpr int64_t kMaxThreadCachedBytes = 32 << 10;
+
   MemoryPoolImpl(
       MemoryManager* manager,
       const std::string& name,
@@ -650,6 +679,8 @@ class MemoryPoolImpl : public MemoryPool {
 
   void leaveArbitration() noexcept override;
 
+  bool checkArbitrationRunning(ContinueFuture* future) const override;
+
   std::optional<uint64_t> reclaimableBytes() const override;
 
   uint64_t reclaim(
@@ -721,6 +752,30 @@ class MemoryPoolImpl : public MemoryPool {
     return debugAllocRecords_;
   }
 
+  /// The allocations sampled from one call stack if
+  /// Options::allocationSampleRate is set.
+  struct AllocationSite {
+    /// The call stack of the first sampled allocation.
+    process::StackTrace callStack;
+    /// The task id in the ThreadDebugInfo of the first sampled allocation.
+    std::string taskId;
+    /// The number of sampled allocations.
+    uint64_t numAllocs{0};
+    /// The bytes of the sampled allocations that are not freed yet.
+    int64_t bytes{0};
+    /// The max of 'bytes' so far.
+    int64_t peakBytes{0};
+  };
+
+  /// Returns up to 'maxSites' allocation sites with the most sampled bytes not
+  /// freed yet first. Multiply the bytes by Options::allocationSampleRate to
+  /// estimate the actual bytes.
+  std::vector<AllocationSite> topAllocationSites(size_t maxSites) const;
+
+  /// Returns the top 'maxSites' allocation sites with their estimated bytes
+  /// and call stacks in human readable form.
+  std::string allocationSitesToString(size_t maxSites) const;
+
   static void setDebugPoolNameRegex(const std::string& regex) {
     debugPoolNameRegex() = regex;
   }
@@ -766,6 +821,26 @@ class MemoryPoolImpl : public MemoryPool {
     return (remainder == 0) ? size : (size + alignment_ - remainder);
   }
 
+  // Returns the number of bytes to allocate for a 'size' bytes buffer. This is
+  // 'size' aligned, rounded up to a power of two if it can be thread cached so
+  // that the buffers of a cache size class are interchangeable.
+  FOLLY_ALWAYS_INLINE int64_t allocationSize(int64_t size) {
+    const auto alignedSize = sizeAlign(size);
+    if (threadCaches_ == nullptr || alignedSize > kMaxThreadCachedBytes) {
+      return alignedSize;
+    }
+    return bits::nextPowerOfTwo(alignedSize);
+  }
+
+  // Returns a buffer of 'alignedSize' bytes from the calling thread's cache or
+  // nullptr if there is none. The returned buffer is already counted as used.
+  FOLLY_ALWAYS_INLINE void* allocateFromThreadCache(int64_t alignedSize) {
+    if (threadCaches_ == nullptr) {
+      return nullptr;
+    }
+    return (*threadCaches_)->allocate(alignedSize);
+  }
+
   // Returns a rounded up delta based on adding 'delta' to 'size'. Adding the
   // rounded delta to 'size' will result in 'size' a quantized size, rounded to
   // the MB or 8MB for larger sizes.
@@ -990,8 +1065,45 @@ class MemoryPoolImpl : public MemoryPool {
   // pool is enabled.
   void leakCheckDbg();
 
+  // Invoked to sample the allocation site of a buffer allocation if
+  // 'allocationSampleRate_' is set.
+  void recordAllocSample(const void* addr, uint64_t size);
+  void recordAllocSample(const Allocation& allocation);
+  void recordAllocSample(const ContiguousAllocation& allocation);
+
+  // Invoked to account a freed allocation to its site if it was sampled.
+  void recordFreeSample(const void* addr, uint64_t size);
+  void recordFreeSample(const Allocation& allocation);
+  void recordFreeSample(const ContiguousAllocation& allocation);
+
   void handleAllocationFailure(const std::string& failureMessage);
 
+  // One thread cache free list per power of two up to kMaxThreadCachedBytes.
+  static constexpr int32_t kNumThreadCacheSizes = 16;
+
+  // Caches the buffers freed by one thread to a memory pool for reuse by the
+  // same thread. There is one free list per power of two size.
+  class ThreadCache {
+   public:
+    explicit ThreadCache(MemoryPoolImpl* pool) : pool_(pool) {}
+
+    // Returns the cached buffers to the memory allocator and releases their
+    // reservation from the memory pool.
+    ~ThreadCache();
+
+    // Returns a cached buffer of 'size' bytes or nullptr if there is none.
+    void* allocate(int64_t size);
+
+    // Keeps buffer 'p' of 'size' bytes for reuse. Returns false if 'p' is not
+    // cached as the cache is full or 'size' is too large.
+    bool free(void* p, int64_t size);
+
+   private:
+    MemoryPoolImpl* const pool_;
+    int64_t cachedBytes_{0};
+    std::array<std::vector<void*>, kNumThreadCacheSizes> freeLists_;
+  };
+
   MemoryManager* const manager_;
   MemoryAllocator* const allocator_;
   const GrowCapacityCallback growCapacityCb_;
@@ -1061,6 +1173,28 @@ class MemoryPoolImpl : public MemoryPool {
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // A sampled allocation with the key of its site in 'allocationSites_'.
+  struct AllocationSample {
+    uint64_t siteKey;
+    int64_t size;
+  };
+
+  // The count of allocations used to pick every 'allocationSampleRate_'th one.
+  std::atomic_uint64_t numSampleCandidates_{0};
+
+  // Mutex for 'allocationSites_' and 'allocationSamples_'.
+  mutable std::mutex sampleMutex_;
+
+  // Map from the hash of a call stack to its sampled allocations.
+  std::unordered_map<uint64_t, AllocationSite> allocationSites_;
+
+  // Map from the address of a sampled allocation not freed yet to its sample.
+  std::unordered_map<const void*, AllocationSample> allocationSamples_;
+
+  // Per thread caches of freed buffers. Only set for a thread-safe leaf memory
+  // pool with 'threadCacheBytes_' set.
+  std::unique_ptr<folly::ThreadLocal<ThreadCache>> threadCaches_;
 };
 
 /// An Allocator backed by a memory pool for STL containers.
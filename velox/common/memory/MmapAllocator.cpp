@@ -17,6 +17,11 @@
 #include "velox/common/memory/MmapAllocator.h"
 
 #include <sys/mman.h>
+#ifdef linux
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Portability.h"
@@ -24,6 +29,51 @@
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+namespace {
+// Returns the NUMA node of the CPU the calling thread runs on. Refreshed every
+// 'kRefreshInterval' calls so that a thread that moves to another node follows
+// without a system call per allocation.
+int32_t currentNumaNode() {
+#ifdef linux
+  static constexpr int32_t kRefreshInterval = 1024;
+  thread_local int32_t node = 0;
+  thread_local int32_t numCalls = 0;
+  if (numCalls++ % kRefreshInterval == 0) {
+    unsigned cpu;
+    unsigned nodeId;
+    if (::syscall(SYS_getcpu, &cpu, &nodeId, nullptr) == 0) {
+      node = nodeId;
+    }
+  }
+  return node;
+#else
+  return 0;
+#endif
+}
+
+// Asks the kernel to back [address, address + bytes) with memory of 'node'
+// when it faults the pages in. The kernel falls back to other nodes if 'node'
+// has no free memory.
+void bindToNumaNode(void* address, size_t bytes, int32_t node) {
+#ifdef linux
+  const uint64_t nodeMask = 1UL << node;
+  // The kernel ignores the last bit of 'maxnode'.
+  const auto rc = ::syscall(
+      SYS_mbind,
+      address,
+      bytes,
+      MPOL_PREFERRED,
+      &nodeMask,
+      sizeof(nodeMask) * 8 + 1,
+      0);
+  if (rc != 0) {
+    VELOX_MEM_LOG(WARNING) << "mbind to NUMA node " << node
+                           << " failed: " << folly::errnoStr(errno);
+  }
+#endif
+}
+} // namespace
+
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
@@ -34,9 +84,22 @@ MmapAllocator::MmapAllocator(const Options& options)
               : options.capacity * options.smallAllocationReservePct / 100),
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
-          64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+          64 * sizeClassSizes_.back())),
+      numNumaNodes_(options.numNumaNodes) {
+  VELOX_CHECK_GE(numNumaNodes_, 1);
+  VELOX_CHECK_LE(numNumaNodes_, 64);
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size,
+          size,
+          numNumaNodes_ > 1 ? node : kNoNumaNode,
+          options.hugePageMinSizeClass > 0 &&
+              size >= options.hugePageMinSizeClass));
+    }
+  }
+  if (numNumaNodes_ > 1) {
+    numaNodeCounters_ = std::vector<NumaNodeCounters>(numNumaNodes_);
   }
 
   if (useMmapArena_) {
@@ -91,14 +154,20 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   ++numAllocations_;
   numAllocatedPages_ += sizeMix.totalPages;
   MachinePageCount newMapsNeeded = 0;
+  const int32_t numaNode =
+      numNumaNodes_ > 1 ? currentNumaNode() % numNumaNodes_ : 0;
   for (int i = 0; i < sizeMix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[sizeMix.sizeIndices[i]]),
         sizeMix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[sizeMix.sizeIndices[i]]->allocate(
-              sizeMix.sizeCounts[i], newMapsNeeded, out);
+          success = allocateFromSizeClass(
+              sizeMix.sizeIndices[i],
+              sizeMix.sizeCounts[i],
+              numaNode,
+              newMapsNeeded,
+              out);
         });
     if (success && ((i > 0) || (sizeMix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -140,6 +209,41 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
   return false;
 }
 
+bool MmapAllocator::allocateFromSizeClass(
+    int32_t sizeIndex,
+    ClassPageCount numPages,
+    int32_t numaNode,
+    MachinePageCount& numUnmapped,
+    Allocation& out) {
+  const auto numSizes = sizeClassSizes_.size();
+  const auto unitSize = sizeClassSizes_[sizeIndex];
+  for (auto i = 0; i < numNumaNodes_; ++i) {
+    const auto node = (numaNode + i) % numNumaNodes_;
+    auto& sizeClass = sizeClasses_[node * numSizes + sizeIndex];
+    const auto previousPages = out.numPages();
+    const bool success = sizeClass->allocate(numPages, numUnmapped, out);
+    // A failed allocation may have allocated part of the pages.
+    const ClassPageCount numAllocated =
+        (out.numPages() - previousPages) / unitSize;
+    if ((numAllocated > 0) && sizeClass->usesHugePages()) {
+      numHugePageBytes_ += AllocationTraits::pageBytes(numAllocated * unitSize);
+    }
+    if ((numAllocated > 0) && (numNumaNodes_ > 1)) {
+      auto& counters = numaNodeCounters_[node];
+      ++counters.numAllocations;
+      if (i > 0) {
+        ++counters.numRemoteAllocations;
+      }
+      counters.numAllocatedPages += numAllocated * unitSize;
+    }
+    if (success) {
+      return true;
+    }
+    numPages -= numAllocated;
+  }
+  return false;
+}
+
 bool MmapAllocator::ensureEnoughMappedPages(int32_t newMappedNeeded) {
   if (testingHasInjectedFailure(InjectedFailure::kMadvise)) {
     return false;
@@ -194,10 +298,16 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
+    if ((pages > 0) && sizeClass->usesHugePages()) {
+      numHugePageBytes_ -= AllocationTraits::pageBytes(pages);
+    }
+    if ((pages > 0) && (numNumaNodes_ > 1)) {
+      numaNodeCounters_[i / sizeClassSizes_.size()].numAllocatedPages -= pages;
+    }
     numFreed += pages;
   }
   allocation.clear();
@@ -508,10 +618,15 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode,
+    bool useHugePages)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
+      useHugePages_(useHugePages),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
       mappedFreeLookup_((capacity_ / kPagesPerLookupBit / 64) + kSimdTail),
@@ -537,6 +652,15 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode != kNoNumaNode) {
+    bindToNumaNode(address_, byteSize_, numaNode);
+  }
+#ifdef linux
+  if (useHugePages_ && ::madvise(address_, byteSize_, MADV_HUGEPAGE) != 0) {
+    VELOX_MEM_LOG(WARNING) << "madvise hugepage for sizeClass " << unitSize_
+                           << " failed: " << folly::errnoStr(errno);
+  }
+#endif
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -950,6 +1074,19 @@ bool MmapAllocator::checkConsistency() const {
   return numErrors == 0;
 }
 
+Stats MmapAllocator::stats() const {
+  auto stats = stats_;
+  stats.numAdvise = numAdvisedPages_;
+  stats.numHugePageBytes = numHugePageBytes_;
+  for (const auto& counters : numaNodeCounters_) {
+    stats.numaNodes.push_back(
+        {static_cast<int64_t>(counters.numAllocations),
+         static_cast<int64_t>(counters.numRemoteAllocations),
+         counters.numAllocatedPages});
+  }
+  return stats;
+}
+
 bool MmapAllocator::useMalloc(uint64_t bytes) {
   return (maxMallocBytes_ != 0) && (bytes <= maxMallocBytes_);
 }
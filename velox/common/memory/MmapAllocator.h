@@ -78,6 +78,20 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// Number of NUMA nodes to keep separate size classes for. If greater than
+    /// 1, each node gets its own set of size classes whose memory is placed on
+    /// that node when possible. Allocations are served from the size classes
+    /// of the node of the allocating thread and fall back to the other nodes
+    /// if these have no space. Each set of size classes reserves address space
+    /// for the whole 'capacity'.
+    int32_t numNumaNodes = 1;
+
+    /// If not 0, the address ranges of size classes with at least this many
+    /// machine pages per size class page are advised to be backed by
+    /// transparent huge pages. Pages freed and advised away later split the
+    /// containing huge page.
+    MachinePageCount hugePageMinSizeClass = 0;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -151,22 +165,30 @@ class MmapAllocator : public MemoryAllocator {
     return numMallocBytes_.readFull();
   }
 
-  Stats stats() const override {
-    auto stats = stats_;
-    stats.numAdvise = numAdvisedPages_;
-    return stats;
+  Stats stats() const override;
+
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
   }
 
   std::string toString() const override;
 
  private:
   static constexpr uint64_t kAllSet = 0xffffffffffffffff;
+  static constexpr int32_t kNoNumaNode = -1;
 
   // Represents a range of virtual addresses used for allocating entries of
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    /// If 'numaNode' is not kNoNumaNode, the memory of 'this' is preferably
+    /// placed on 'numaNode'. If 'useHugePages' is true, the memory of 'this'
+    /// is advised to be backed by transparent huge pages.
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = kNoNumaNode,
+        bool useHugePages = false);
 
     ~SizeClass();
 
@@ -174,6 +196,10 @@ class MmapAllocator : public MemoryAllocator {
       return unitSize_;
     }
 
+    bool usesHugePages() const {
+      return useHugePages_;
+    }
+
     // Allocates 'numPages' from 'this' and appends these to *out.
     // '*numUnmapped' is incremented by the number of pages that are not backed
     // by memory.
@@ -274,6 +300,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    // True if the address range is advised to use transparent huge pages.
+    const bool useHugePages_;
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
@@ -320,6 +349,16 @@ class MmapAllocator : public MemoryAllocator {
       const SizeMix& sizeMix,
       Allocation& out) override;
 
+  // Allocates 'numPages' of size class 'sizeIndex' into 'out', starting with
+  // the size class of 'numaNode' and continuing with the size classes of the
+  // other nodes for the pages 'numaNode' could not provide.
+  bool allocateFromSizeClass(
+      int32_t sizeIndex,
+      ClassPageCount numPages,
+      int32_t numaNode,
+      MachinePageCount& numUnmapped,
+      Allocation& out);
+
   bool allocateContiguousWithoutRetry(
       MachinePageCount numPages,
       Allocation* collateral,
@@ -406,8 +445,22 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // Number of NUMA nodes with their own size classes.
+  const int32_t numNumaNodes_;
+
+  // The size classes of NUMA node 'n' are at [n * sizeClassSizes_.size(), (n +
+  // 1) * sizeClassSizes_.size()).
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
+  struct NumaNodeCounters {
+    std::atomic<uint64_t> numAllocations{0};
+    std::atomic<uint64_t> numRemoteAllocations{0};
+    std::atomic<int64_t> numAllocatedPages{0};
+  };
+
+  // Counters for each NUMA node if 'numNumaNodes_' > 1.
+  std::vector<NumaNodeCounters> numaNodeCounters_;
+
   // Statistics.
   std::atomic<uint64_t> numAllocations_ = 0;
   std::atomic<uint64_t> numAllocatedPages_ = 0;
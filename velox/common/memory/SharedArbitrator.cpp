@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/memory/SharedArbitrator.h"
+#include <folly/Synchronized.h>
 #include <mutex>
 
 #include "velox/common/base/Exceptions.h"
@@ -142,10 +143,75 @@ const SharedArbitrator::Candidate& findCandidateWithLargestCapacity(
   VELOX_CHECK_NE(candidateIdx, -1);
   return candidates[candidateIdx];
 }
+
+using CandidatePolicyMap =
+    std::unordered_map<std::string, SharedArbitrator::CandidatePolicyFactory>;
+
+folly::Synchronized<CandidatePolicyMap>& candidatePolicies() {
+  static folly::Synchronized<CandidatePolicyMap> policies{CandidatePolicyMap{
+      {SharedArbitrator::kPriorityCandidatePolicy, []() {
+         return std::make_unique<SharedArbitrator::PriorityCandidatePolicy>();
+       }}}};
+  return policies;
+}
+
+std::unique_ptr<SharedArbitrator::CandidatePolicy> createCandidatePolicy(
+    const std::string& name) {
+  if (name.empty()) {
+    return std::make_unique<SharedArbitrator::CandidatePolicy>();
+  }
+  auto policies = candidatePolicies().rlock();
+  auto it = policies->find(name);
+  VELOX_USER_CHECK(
+      it != policies->end(), "Arbitration policy {} not registered", name);
+  return it->second();
+}
 } // namespace
 
+void SharedArbitrator::CandidatePolicy::sortForSpill(
+    std::vector<Candidate>& candidates) const {
+  sortCandidatesByReclaimableUsedCapacity(candidates);
+}
+
+void SharedArbitrator::CandidatePolicy::sortForAbort(
+    std::vector<Candidate>& candidates) const {
+  sortCandidatesByUsage(candidates);
+}
+
+void SharedArbitrator::PriorityCandidatePolicy::sortForSpill(
+    std::vector<Candidate>& candidates) const {
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const Candidate& lhs, const Candidate& rhs) {
+        // Lower priority, later start and more reclaimable bytes go first.
+        return std::tie(lhs.priority, rhs.startTimeMs, rhs.reclaimableBytes) <
+            std::tie(rhs.priority, lhs.startTimeMs, lhs.reclaimableBytes);
+      });
+}
+
+void SharedArbitrator::PriorityCandidatePolicy::sortForAbort(
+    std::vector<Candidate>& candidates) const {
+  std::sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const Candidate& lhs, const Candidate& rhs) {
+        // Lower priority, later start and more reserved bytes go first.
+        return std::tie(lhs.priority, rhs.startTimeMs, rhs.reservedBytes) <
+            std::tie(rhs.priority, lhs.startTimeMs, lhs.reservedBytes);
+      });
+}
+
+// static
+bool SharedArbitrator::registerCandidatePolicy(
+    const std::string& name,
+    CandidatePolicyFactory factory) {
+  return candidatePolicies().wlock()->emplace(name, std::move(factory)).second;
+}
+
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
     : MemoryArbitrator(config),
+      candidatePolicy_(createCandidatePolicy(config.candidatePolicy)),
       freeReservedCapacity_(reservedCapacity_),
       freeNonReservedCapacity_(capacity_ - freeReservedCapacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
@@ -153,10 +219,11 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] PRIORITY[{}]]",
       pool->root()->name(),
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      priority);
 }
 
 SharedArbitrator::~SharedArbitrator() {
@@ -182,11 +249,14 @@ void SharedArbitrator::getCandidateStats(
   op->candidates.reserve(op->candidatePools.size());
   for (const auto& pool : op->candidatePools) {
     const bool selfCandidate = op->requestRoot == pool.get();
+    auto* reclaimer = pool->reclaimer();
     op->candidates.push_back(
         {freeCapacityOnly ? 0 : reclaimableUsedCapacity(*pool, selfCandidate),
          reclaimableFreeCapacity(*pool, selfCandidate),
          pool->reservedBytes(),
-         pool.get()});
+         pool.get(),
+         reclaimer == nullptr ? 0 : reclaimer->priority(),
+         reclaimer == nullptr ? 0 : reclaimer->startTimeMs()});
   }
 }
 
@@ -679,14 +749,13 @@ uint64_t SharedArbitrator::reclaimFreeMemoryFromCandidates(
 uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
     ArbitrationOperation* op,
     uint64_t reclaimTargetBytes) {
-  // Sort candidate memory pools based on their reclaimable used capacity.
-  sortCandidatesByReclaimableUsedCapacity(op->candidates);
+  candidatePolicy_->sortForSpill(op->candidates);
 
   uint64_t reclaimedBytes{0};
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(reclaimedBytes, reclaimTargetBytes);
     if (candidate.reclaimableBytes == 0) {
-      break;
+      continue;
     }
     reclaimedBytes +=
         reclaim(candidate.pool, reclaimTargetBytes - reclaimedBytes, false);
@@ -701,13 +770,13 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesBySpill(
 uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidatesByAbort(
     ArbitrationOperation* op,
     uint64_t reclaimTargetBytes) {
-  sortCandidatesByUsage(op->candidates);
+  candidatePolicy_->sortForAbort(op->candidates);
 
   uint64_t freedBytes{0};
   for (const auto& candidate : op->candidates) {
     VELOX_CHECK_LT(freedBytes, reclaimTargetBytes);
     if (candidate.pool->capacity() == 0) {
-      break;
+      continue;
     }
     try {
       VELOX_MEM_POOL_ABORTED(fmt::format(
@@ -969,6 +1038,7 @@ void SharedArbitrator::startArbitration(ArbitrationOperation* op) {
 
 void SharedArbitrator::finishArbitration(ArbitrationOperation* op) {
   ContinuePromise resumePromise{ContinuePromise::makeEmpty()};
+  std::vector<ContinuePromise> offThreadPromises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK_GT(numPending_, 0);
@@ -982,6 +1052,7 @@ void SharedArbitrator::finishArbitration(ArbitrationOperation* op) {
           op->requestRoot->name());
       auto* runningArbitration = it->second.get();
       if (runningArbitration->waitPromises.empty()) {
+        offThreadPromises = std::move(runningArbitration->resumePromises);
         arbitrationQueues_.erase(it);
       } else {
         resumePromise = std::move(runningArbitration->waitPromises.back());
@@ -992,6 +1063,24 @@ void SharedArbitrator::finishArbitration(ArbitrationOperation* op) {
   if (resumePromise.valid()) {
     resumePromise.setValue();
   }
+  for (auto& promise : offThreadPromises) {
+    promise.setValue();
+  }
+}
+
+bool SharedArbitrator::checkArbitrationRunning(
+    MemoryPool* pool,
+    ContinueFuture* future) {
+  VELOX_CHECK_NOT_NULL(future);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = arbitrationQueues_.find(pool);
+  if (it == arbitrationQueues_.end()) {
+    return false;
+  }
+  it->second->resumePromises.emplace_back(
+      fmt::format("Wait for arbitration of {}", pool->name()));
+  *future = it->second->resumePromises.back().getSemiFuture();
+  return true;
 }
 
 bool SharedArbitrator::isUnderArbitration(MemoryPool* pool) const {
@@ -58,6 +58,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       bool allowSpill = true,
       bool force = false) override final;
 
+  bool checkArbitrationRunning(MemoryPool* pool, ContinueFuture* future)
+      final;
+
   Stats stats() const final;
 
   std::string kind() const override;
@@ -70,10 +73,49 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     int64_t freeBytes{0};
     int64_t reservedBytes{0};
     MemoryPool* pool;
+    /// The priority and start time reported by the reclaimer of 'pool'.
+    int32_t priority{0};
+    uint64_t startTimeMs{0};
 
     std::string toString() const;
   };
 
+  /// Orders the candidate memory pools to reclaim used memory from. The
+  /// default policy spills the candidates with the most reclaimable memory
+  /// first and aborts the ones with the most reserved memory first.
+  class CandidatePolicy {
+   public:
+    virtual ~CandidatePolicy() = default;
+
+    /// Sorts 'candidates' in the order to reclaim used memory by spilling.
+    virtual void sortForSpill(std::vector<Candidate>& candidates) const;
+
+    /// Sorts 'candidates' in the order to abort.
+    virtual void sortForAbort(std::vector<Candidate>& candidates) const;
+  };
+
+  /// Reclaims from the candidates with lower priority first. Among the ones
+  /// with the same priority, the most recently started query goes first as it
+  /// loses the least work, then the default order applies.
+  class PriorityCandidatePolicy : public CandidatePolicy {
+   public:
+    void sortForSpill(std::vector<Candidate>& candidates) const override;
+
+    void sortForAbort(std::vector<Candidate>& candidates) const override;
+  };
+
+  using CandidatePolicyFactory =
+      std::function<std::unique_ptr<CandidatePolicy>()>;
+
+  /// The name of PriorityCandidatePolicy in Config::candidatePolicy.
+  static inline const std::string kPriorityCandidatePolicy{"PRIORITY"};
+
+  /// Registers 'factory' to create the policy for Config::candidatePolicy
+  /// 'name'. Returns false if 'name' is already registered.
+  static bool registerCandidatePolicy(
+      const std::string& name,
+      CandidatePolicyFactory factory);
+
   /// Returns 'freeCapacity' back to the arbitrator for testing.
   void testingFreeCapacity(uint64_t freeCapacity);
 
@@ -168,6 +210,10 @@ class SharedArbitrator : public memory::MemoryArbitrator {
     // for the serial execution.
     std::vector<ContinuePromise> waitPromises;
 
+    // The promises of the drivers of the query that went off thread instead
+    // of issuing a request. Fulfilled when this queue is removed.
+    std::vector<ContinuePromise> resumePromises;
+
     explicit ArbitrationQueue(ArbitrationOperation* op) : current(op) {
       VELOX_CHECK_NOT_NULL(current);
     }
@@ -349,6 +395,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   void updateArbitrationRequestStats();
   void updateArbitrationFailureStats();
 
+  const std::unique_ptr<CandidatePolicy> candidatePolicy_;
+
   // Lock used to protect the arbitrator state.
   mutable std::mutex mutex_;
   tsan_atomic<uint64_t> freeReservedCapacity_{0};
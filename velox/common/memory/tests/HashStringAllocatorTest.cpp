@@ -157,6 +157,24 @@ TEST_F(HashStringAllocatorTest, allocate) {
   EXPECT_LE(allocator_->retainedSize() - allocator_->freeSpace(), 250);
 }
 
+TEST_F(HashStringAllocatorTest, fragmentation) {
+  EXPECT_EQ(allocator_->fragmentation(), 0);
+  std::vector<HSA::Header*> headers;
+  for (auto i = 0; i < 10'000; ++i) {
+    headers.push_back(allocate(100));
+  }
+  const auto initial = allocator_->fragmentation();
+  for (auto i = 0; i < headers.size(); i += 2) {
+    allocator_->free(headers[i]);
+  }
+  EXPECT_GT(allocator_->fragmentation(), initial + 0.2);
+  for (auto i = 1; i < headers.size(); i += 2) {
+    allocator_->free(headers[i]);
+  }
+  EXPECT_GT(allocator_->fragmentation(), 0.9);
+  EXPECT_LE(allocator_->fragmentation(), 1);
+}
+
 TEST_F(HashStringAllocatorTest, allocateLarge) {
   // Verify that allocate() can handle sizes larger than the largest class size
   // supported by memory allocators, that is, 256 pages.
@@ -670,5 +688,28 @@ TEST_F(HashStringAllocatorTest, storeStringFast) {
   allocator_->checkConsistency();
 }
 
+TEST_F(HashStringAllocatorTest, storeStringReusesFreedBlocks) {
+  std::vector<std::string> strings;
+  std::vector<StringView> views;
+  for (auto i = 0; i < 3; ++i) {
+    strings.push_back(std::string(100, 'a' + i));
+    views.push_back(StringView(strings.back()));
+    allocator_->copyMultipart(
+        views.back(), reinterpret_cast<char*>(&views.back()), 0);
+  }
+  // The freed middle block is reused for a string of a close size instead of
+  // splitting the slab remainder.
+  const auto* freedData = views[1].data();
+  allocator_->free(HashStringAllocator::headerOf(freedData));
+  std::string smaller(90, 'x');
+  StringView sv(smaller);
+  allocator_->copyMultipart(sv, reinterpret_cast<char*>(&sv), 0);
+  ASSERT_EQ(sv.data(), freedData);
+  ASSERT_EQ(sv, StringView(smaller));
+  ASSERT_EQ(views[0], StringView(strings[0]));
+  ASSERT_EQ(views[2], StringView(strings[2]));
+  allocator_->checkConsistency();
+}
+
 } // namespace
 } // namespace facebook::velox
@@ -475,6 +475,66 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNumaNodes) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numNumaNodes = 2;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  ASSERT_EQ(mmapAllocator->numNumaNodes(), 2);
+
+  std::vector<Allocation> allocations(10);
+  for (auto i = 0; i < allocations.size(); ++i) {
+    ASSERT_TRUE(mmapAllocator->allocateNonContiguous(
+        (i + 1) * mmapAllocator->largestSizeClass() + 1, allocations[i]));
+  }
+  auto stats = mmapAllocator->stats();
+  ASSERT_EQ(stats.numaNodes.size(), 2);
+  int64_t numAllocatedPages = 0;
+  int64_t numAllocations = 0;
+  for (const auto& node : stats.numaNodes) {
+    numAllocatedPages += node.numAllocatedPages;
+    numAllocations += node.numAllocations;
+  }
+  ASSERT_EQ(numAllocatedPages, mmapAllocator->numAllocated());
+  ASSERT_GE(numAllocations, allocations.size());
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+  ASSERT_NE(stats.toString().find("NUMA node 1"), std::string::npos);
+
+  for (auto& allocation : allocations) {
+    mmapAllocator->freeNonContiguous(allocation);
+  }
+  stats = mmapAllocator->stats();
+  for (const auto& node : stats.numaNodes) {
+    ASSERT_EQ(node.numAllocatedPages, 0);
+  }
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+}
+
+TEST_P(MemoryAllocatorTest, mmapAllocatorHugePageSizeClasses) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.hugePageMinSizeClass = 256;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+
+  // 256 pages come from the largest size class, the extra page from the
+  // smallest.
+  Allocation allocation;
+  ASSERT_TRUE(mmapAllocator->allocateNonContiguous(257, allocation));
+  ASSERT_EQ(
+      mmapAllocator->stats().numHugePageBytes,
+      AllocationTraits::pageBytes(256));
+  mmapAllocator->freeNonContiguous(allocation);
+  ASSERT_EQ(mmapAllocator->stats().numHugePageBytes, 0);
+  ASSERT_TRUE(mmapAllocator->checkConsistency());
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
@@ -616,6 +616,85 @@ TEST_P(MemoryPoolTest, allocateZeroFilled) {
   ASSERT_EQ(0, pool->usedBytes());
 }
 
+TEST_P(MemoryPoolTest, threadCache) {
+  MemoryManager manager{{.poolThreadCacheBytes = 64 * KB}};
+  auto root = manager.addRootPool();
+  auto pool = root->addLeafChild("threadCache", isLeafThreadSafe_);
+
+  void* buffer = pool->allocate(100);
+  const auto usedBytes = pool->usedBytes();
+  pool->free(buffer, 100);
+  if (!isLeafThreadSafe_) {
+    // Only thread-safe leaf pools cache.
+    ASSERT_EQ(pool->usedBytes(), 0);
+    return;
+  }
+  // The cached buffer stays used and is reused for the same size class.
+  ASSERT_EQ(pool->usedBytes(), usedBytes);
+  ASSERT_EQ(pool->allocate(120), buffer);
+  auto* zeroFilled = static_cast<char*>(pool->allocateZeroFilled(1, 120));
+  pool->free(zeroFilled, 120);
+  ASSERT_EQ(pool->allocateZeroFilled(10, 12), zeroFilled);
+  for (auto i = 0; i < 120; ++i) {
+    ASSERT_EQ(zeroFilled[i], 0);
+  }
+  pool->free(zeroFilled, 120);
+  pool->free(buffer, 120);
+
+  // Buffers over the cache size limit are freed.
+  std::vector<void*> buffers;
+  for (auto i = 0; i < 4; ++i) {
+    buffers.push_back(pool->allocate(32 * KB));
+  }
+  const auto usedBeforeFree = pool->usedBytes();
+  for (auto* large : buffers) {
+    pool->free(large, 32 * KB);
+  }
+  ASSERT_LT(pool->usedBytes(), usedBeforeFree);
+  ASSERT_GT(pool->usedBytes(), 0);
+
+  // Destroying the pool returns the cached buffers.
+  pool.reset();
+  ASSERT_EQ(root->usedBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, allocationSampling) {
+  MemoryManager manager{{.poolAllocationSampleRate = 2}};
+  auto root = manager.addRootPool();
+  auto pool = root->addLeafChild("allocationSampling", isLeafThreadSafe_);
+  auto* poolImpl = static_cast<MemoryPoolImpl*>(pool.get());
+
+  std::vector<void*> buffers;
+  for (auto i = 0; i < 8; ++i) {
+    buffers.push_back(pool->allocate(1024));
+  }
+  void* other = pool->allocate(64);
+  auto sites = poolImpl->topAllocationSites(10);
+  // Every other allocation is sampled. The 4 sampled allocations in the loop
+  // share a site.
+  ASSERT_EQ(sites.size(), 2);
+  ASSERT_EQ(sites[0].numAllocs, 4);
+  ASSERT_EQ(sites[0].bytes, 4 * 1024);
+  ASSERT_EQ(sites[1].numAllocs, 1);
+  ASSERT_EQ(sites[1].bytes, 64);
+  ASSERT_EQ(poolImpl->topAllocationSites(1).size(), 1);
+  ASSERT_THAT(
+      poolImpl->allocationSitesToString(1),
+      testing::HasSubstr("8.00KB allocated"));
+
+  for (auto* buffer : buffers) {
+    pool->free(buffer, 1024);
+  }
+  pool->free(other, 64);
+  sites = poolImpl->topAllocationSites(10);
+  ASSERT_EQ(sites.size(), 2);
+  for (const auto& site : sites) {
+    ASSERT_EQ(site.bytes, 0);
+  }
+  ASSERT_EQ(std::max(sites[0].peakBytes, sites[1].peakBytes), 4 * 1024);
+  ASSERT_TRUE(poolImpl->topAllocationSites(0).empty());
+}
+
 TEST_P(MemoryPoolTest, alignmentCheck) {
   std::vector<uint16_t> alignments = {
       0,
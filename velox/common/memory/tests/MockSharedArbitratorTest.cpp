@@ -546,6 +546,47 @@ TEST_F(MockSharedArbitrationTest, constructor) {
       stats, kMemoryCapacity, kMemoryCapacity, reservedCapacity);
 }
 
+TEST_F(MockSharedArbitrationTest, priorityCandidatePolicy) {
+  auto makeCandidates = []() {
+    std::vector<SharedArbitrator::Candidate> candidates(4);
+    const std::vector<int32_t> priorities{1, 0, 0, 0};
+    const std::vector<uint64_t> startTimes{10, 10, 20, 20};
+    for (auto i = 0; i < candidates.size(); ++i) {
+      candidates[i].reclaimableBytes = (i + 1) * 100;
+      candidates[i].reservedBytes = (4 - i) * 100;
+      candidates[i].priority = priorities[i];
+      candidates[i].startTimeMs = startTimes[i];
+    }
+    return candidates;
+  };
+  auto reclaimableBytes =
+      [](const std::vector<SharedArbitrator::Candidate>& candidates) {
+        std::vector<int64_t> bytes;
+        for (const auto& candidate : candidates) {
+          bytes.push_back(candidate.reclaimableBytes);
+        }
+        return bytes;
+      };
+
+  SharedArbitrator::PriorityCandidatePolicy policy;
+  auto candidates = makeCandidates();
+  policy.sortForSpill(candidates);
+  ASSERT_EQ(
+      reclaimableBytes(candidates), std::vector<int64_t>({400, 300, 200, 100}));
+  candidates = makeCandidates();
+  policy.sortForAbort(candidates);
+  ASSERT_EQ(
+      reclaimableBytes(candidates), std::vector<int64_t>({300, 400, 200, 100}));
+
+  ASSERT_FALSE(SharedArbitrator::registerCandidatePolicy(
+      SharedArbitrator::kPriorityCandidatePolicy, nullptr));
+  MemoryManagerOptions options;
+  options.arbitratorKind = "SHARED";
+  options.arbitratorCandidatePolicy = "unknown";
+  VELOX_ASSERT_THROW(
+      MemoryManager{options}, "Arbitration policy unknown not registered");
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrationStateCheck) {
   const int memCapacity = 256 * MB;
   const int minPoolCapacity = 32 * MB;
@@ -1214,6 +1255,44 @@ DEBUG_ONLY_TEST_F(
   ASSERT_EQ(allocationCount, 2);
 }
 
+DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, checkArbitrationRunning) {
+  const int64_t memoryCapacity = 512 << 20;
+  const uint64_t memoryPoolInitCapacity = memoryCapacity / 4;
+  setupMemory(memoryCapacity, 0, memoryPoolInitCapacity, 0);
+  auto task = addTask(memoryCapacity);
+  auto* op = task->addMemoryOp(true);
+  ContinueFuture future{ContinueFuture::makeEmpty()};
+  ASSERT_FALSE(task->pool()->checkArbitrationRunning(&future));
+
+  folly::EventCount arbitrationWait;
+  std::atomic_bool arbitrationWaitFlag{true};
+  folly::EventCount resumeWait;
+  std::atomic_bool resumeWaitFlag{true};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::memory::SharedArbitrator::runLocalArbitration",
+      std::function<void(const SharedArbitrator*)>(
+          ([&](const SharedArbitrator* /*unused*/) {
+            arbitrationWaitFlag = false;
+            arbitrationWait.notifyAll();
+            resumeWait.await([&]() { return !resumeWaitFlag.load(); });
+          })));
+
+  auto allocationThread = std::thread([&]() {
+    auto* buffer = op->allocate(memoryCapacity / 2);
+    op->free(buffer);
+  });
+  arbitrationWait.await([&]() { return !arbitrationWaitFlag.load(); });
+  ASSERT_TRUE(task->pool()->checkArbitrationRunning(&future));
+  ASSERT_TRUE(future.valid());
+  ASSERT_FALSE(future.isReady());
+
+  resumeWaitFlag = false;
+  resumeWait.notifyAll();
+  allocationThread.join();
+  ASSERT_TRUE(future.isReady());
+  ASSERT_FALSE(task->pool()->checkArbitrationRunning(&future));
+}
+
 // This test verifies local arbitration runs from different queries don't have
 // to block waiting each other.
 DEBUG_ONLY_TEST_F(
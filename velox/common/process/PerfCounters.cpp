@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#endif
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+
+constexpr int32_t kNumCounters = 4;
+
+// The perf event group of a thread. The first event is the group leader.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    constexpr std::array<uint64_t, kNumCounters> kConfigs = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+    fds_.fill(-1);
+    for (auto i = 0; i < kNumCounters; ++i) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = kConfigs[i];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      // The leader starts disabled and enables the group once complete.
+      attr.disabled = i == 0;
+      fds_[i] = syscall(
+          __NR_perf_event_open,
+          &attr,
+          0, // The calling thread.
+          -1, // Any CPU.
+          i == 0 ? -1 : fds_[0],
+          0);
+      if (fds_[i] < 0) {
+        closeAll();
+        return;
+      }
+    }
+    if (ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) != 0) {
+      closeAll();
+    }
+  }
+
+  ~ThreadCounters() {
+    closeAll();
+  }
+
+  bool available() const {
+    return fds_[0] >= 0;
+  }
+
+  PerfCounterValues read() const {
+    if (!available()) {
+      return {};
+    }
+    // PERF_FORMAT_GROUP reads the number of events followed by their values.
+    std::array<uint64_t, 1 + kNumCounters> buffer;
+    if (::read(fds_[0], buffer.data(), sizeof(buffer)) != sizeof(buffer) ||
+        buffer[0] != kNumCounters) {
+      return {};
+    }
+    return {buffer[1], buffer[2], buffer[3], buffer[4]};
+  }
+
+ private:
+  void closeAll() {
+    for (auto& fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+        fd = -1;
+      }
+    }
+  }
+
+  std::array<int, kNumCounters> fds_;
+};
+
+const ThreadCounters& threadCounters() {
+  thread_local ThreadCounters counters;
+  return counters;
+}
+
+} // namespace
+
+// static
+bool PerfCounters::available() {
+  return threadCounters().available();
+}
+
+// static
+PerfCounterValues PerfCounters::read() {
+  return threadCounters().read();
+}
+
+#else
+
+// static
+bool PerfCounters::available() {
+  return false;
+}
+
+// static
+PerfCounterValues PerfCounters::read() {
+  return {};
+}
+
+#endif
+
+} // namespace facebook::velox::process
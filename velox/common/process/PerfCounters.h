@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+namespace facebook::velox::process {
+
+/// Hardware counters of a thread in user mode.
+struct PerfCounterValues {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  /// Last level cache misses.
+  uint64_t cacheMisses{0};
+  uint64_t branchMisses{0};
+
+  PerfCounterValues operator-(const PerfCounterValues& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        cacheMisses - other.cacheMisses,
+        branchMisses - other.branchMisses};
+  }
+};
+
+/// Reads the hardware counters of the calling thread with perf_event_open on
+/// Linux. The counters are opened as a group on the first use in a thread and
+/// are read with one system call. Counters are not available on other
+/// platforms, if the kernel does not allow perf events for the process, e.g.
+/// with perf_event_paranoid > 2, or if the hardware has no such counters,
+/// e.g. in some virtual machines.
+class PerfCounters {
+ public:
+  /// Returns true if the counters of the calling thread can be read.
+  static bool available();
+
+  /// Returns the counters of the calling thread since it opened them. Returns
+  /// zeros if not available().
+  static PerfCounterValues read();
+};
+
+/// Keeps track of the hardware counters of the calling thread from
+/// construction to destruction and passes the difference to 'func' on
+/// destruction. Does not read the counters if they are not available.
+template <typename F>
+class DeltaPerfCounters {
+ public:
+  explicit DeltaPerfCounters(F&& func)
+      : available_(PerfCounters::available()),
+        start_(available_ ? PerfCounters::read() : PerfCounterValues{}),
+        func_(std::move(func)) {}
+
+  ~DeltaPerfCounters() {
+    if (available_) {
+      func_(PerfCounters::read() - start_);
+    }
+  }
+
+ private:
+  const bool available_;
+  const PerfCounterValues start_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <thread>
+
+namespace facebook::velox::process {
+namespace {
+
+int64_t work() {
+  volatile int64_t sum = 0;
+  for (auto i = 0; i < 1'000'000; ++i) {
+    sum = sum + i;
+  }
+  return sum;
+}
+
+TEST(PerfCountersTest, delta) {
+  std::optional<PerfCounterValues> delta;
+  {
+    DeltaPerfCounters counters(
+        [&](const PerfCounterValues& values) { delta = values; });
+    work();
+  }
+  if (!PerfCounters::available()) {
+    // No perf events in this environment.
+    ASSERT_FALSE(delta.has_value());
+    const auto values = PerfCounters::read();
+    ASSERT_EQ(values.cycles, 0);
+    ASSERT_EQ(values.instructions, 0);
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  ASSERT_TRUE(delta.has_value());
+  // The loop runs a few instructions per iteration.
+  ASSERT_GT(delta->instructions, 1'000'000);
+  ASSERT_GT(delta->cycles, 0);
+}
+
+TEST(PerfCountersTest, perThread) {
+  const bool available = PerfCounters::available();
+  const auto before = PerfCounters::read();
+  // Work on another thread is not counted on this one.
+  std::thread([&]() {
+    ASSERT_EQ(PerfCounters::available(), available);
+    work();
+  }).join();
+  const auto delta = PerfCounters::read() - before;
+  ASSERT_LT(delta.instructions, 1'000'000);
+}
+
+} // namespace
+} // namespace facebook::velox::process
@@ -25,15 +25,38 @@
 
 #pragma once
 
+#include <folly/Synchronized.h>
+
 #include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/FileProperties.h"
+#include "velox/type/Type.h"
 
 namespace facebook::velox {
 
+namespace dwio::common {
+class ColumnStatistics;
+class TypeWithId;
+} // namespace dwio::common
+
 class Config;
 
+/// File level statistics parsed from the footer of a data file.
+struct FileStatistics {
+  uint64_t numRows;
+
+  std::shared_ptr<const dwio::common::TypeWithId> typeWithId;
+
+  /// Statistics of the top level columns, indexed like the children of
+  /// 'typeWithId'. Null for a column without statistics.
+  std::vector<std::shared_ptr<dwio::common::ColumnStatistics>> columnStats;
+
+  /// Table schema the reader was opened with. Column names in 'typeWithId'
+  /// come from it, so the statistics only apply to readers with the same one.
+  RowTypePtr fileSchema;
+};
+
 // See the file comment.
 struct FileHandle {
   std::shared_ptr<ReadFile> file;
@@ -48,6 +71,11 @@ struct FileHandle {
   // example to decide placing on SSD.
   StringIdLease groupId;
 
+  // File level statistics, set by the first split that opens a reader on the
+  // file. Later splits of the file, from the same or other queries, test their
+  // filters against these before reading the footer.
+  folly::Synchronized<std::shared_ptr<const FileStatistics>> statistics;
+
   // We'll want to have a hash map here to record the identifier->byte range
   // mappings. Different formats may have different identifiers, so we may need
   // a union of maps. For example in orc you need 3 integers (I think, to be
@@ -65,6 +65,12 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* session) const {
       config_->get<uint32_t>(kMaxPartitionsPerWriters, 100));
 }
 
+bool HiveConfig::partitionedWriteSortFallback(const Config* session) const {
+  return session->get<bool>(
+      kPartitionedWriteSortFallbackSession,
+      config_->get<bool>(kPartitionedWriteSortFallback, false));
+}
+
 bool HiveConfig::immutablePartitions() const {
   return config_->get<bool>(kImmutablePartitions, false);
 }
@@ -120,6 +126,14 @@ std::optional<uint32_t> HiveConfig::s3MaxConnections() const {
       config_->get<uint32_t>(kS3MaxConnections));
 }
 
+uint32_t HiveConfig::s3IoThreads() const {
+  return config_->get<uint32_t>(kS3IoThreads, 0);
+}
+
+uint32_t HiveConfig::s3MaxConcurrentRequestsPerFile() const {
+  return config_->get<uint32_t>(kS3MaxConcurrentRequestsPerFile, 4);
+}
+
 std::string HiveConfig::gcsEndpoint() const {
   return config_->get<std::string>(kGCSEndpoint, std::string(""));
 }
@@ -172,6 +186,22 @@ int32_t HiveConfig::prefetchRowGroups() const {
   return config_->get<int32_t>(kPrefetchRowGroups, 1);
 }
 
+int32_t HiveConfig::maxParallelUnitLoads() const {
+  return config_->get<int32_t>(kMaxParallelUnitLoads, 1);
+}
+
+int32_t HiveConfig::prefetchStripes() const {
+  return config_->get<int32_t>(kPrefetchStripes, 0);
+}
+
+uint64_t HiveConfig::prefetchStripesMaxBytes() const {
+  return config_->get<uint64_t>(kPrefetchStripesMaxBytes, 256 << 20);
+}
+
+bool HiveConfig::integerDictionaryOutput() const {
+  return config_->get<bool>(kIntegerDictionaryOutput, false);
+}
+
 int32_t HiveConfig::loadQuantum() const {
   return config_->get<int32_t>(kLoadQuantum, 8 << 20);
 }
@@ -231,6 +261,17 @@ uint64_t HiveConfig::sortWriterMaxOutputBytes(const Config* session) const {
       core::CapacityUnit::BYTE);
 }
 
+bool HiveConfig::sortWriterZOrder(const Config* session) const {
+  return session->get<bool>(
+      kSortWriterZOrderSession, config_->get<bool>(kSortWriterZOrder, false));
+}
+
+bool HiveConfig::parallelWriterClose(const Config* session) const {
+  return session->get<bool>(
+      kParallelWriterCloseSession,
+      config_->get<bool>(kParallelWriterClose, false));
+}
+
 uint64_t HiveConfig::footerEstimatedSize() const {
   return config_->get<uint64_t>(kFooterEstimatedSize, 1UL << 20);
 }
@@ -239,6 +280,14 @@ uint64_t HiveConfig::filePreloadThreshold() const {
   return config_->get<uint64_t>(kFilePreloadThreshold, 8UL << 20);
 }
 
+uint64_t HiveConfig::parquetFooterCacheBytes() const {
+  return config_->get<uint64_t>(kParquetFooterCacheBytes, 0);
+}
+
+uint64_t HiveConfig::icebergPositionalDeleteCacheBytes() const {
+  return config_->get<uint64_t>(kIcebergPositionalDeleteCacheBytes, 0);
+}
+
 bool HiveConfig::s3UseProxyFromEnv() const {
   return config_->get<bool>(kS3UseProxyFromEnv, false);
 }
@@ -260,4 +309,9 @@ bool HiveConfig::cacheNoRetention(const Config* session) const {
       config_->get<bool>(kCacheNoRetention, /*defaultValue=*/false));
 }
 
+uint64_t HiveConfig::cacheTag(const Config* session) const {
+  return session->get<uint64_t>(
+      kCacheTagSession, config_->get<uint64_t>(kCacheTag, /*defaultValue=*/0));
+}
+
 } // namespace facebook::velox::connector::hive
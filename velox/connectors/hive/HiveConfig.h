@@ -52,6 +52,15 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWritersSession =
       "max_partitions_per_writers";
 
+  /// If true, a writer of an unbucketed partitioned table that sees more
+  /// partitions than kMaxPartitionsPerWriters does not fail. The input from
+  /// that point on is sorted on the partition keys, spilling if needed, and
+  /// the remaining partitions are written one at a time on close.
+  static constexpr const char* kPartitionedWriteSortFallback =
+      "partitioned-write-sort-fallback";
+  static constexpr const char* kPartitionedWriteSortFallbackSession =
+      "partitioned_write_sort_fallback";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -98,6 +107,16 @@ class HiveConfig {
   /// Maximum concurrent TCP connections for a single http client.
   static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
 
+  /// Number of threads of the S3 file system used to run range reads and part
+  /// uploads in parallel. This bounds the number of parallel requests in the
+  /// process. 0 runs all requests on the calling thread.
+  static constexpr const char* kS3IoThreads = "hive.s3.io-threads";
+
+  /// Maximum number of parallel range reads or part uploads of a single file
+  /// if 'hive.s3.io-threads' is set.
+  static constexpr const char* kS3MaxConcurrentRequestsPerFile =
+      "hive.s3.max-concurrent-requests-per-file";
+
   /// The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -142,6 +161,25 @@ class HiveConfig {
   /// The number of prefetch rowgroups
   static constexpr const char* kPrefetchRowGroups = "prefetch-rowgroups";
 
+  /// The number of stripes of a split that are loaded concurrently on the
+  /// connector executor. Stripes are loaded one at a time if this is 1.
+  static constexpr const char* kMaxParallelUnitLoads =
+      "max-parallel-unit-loads";
+
+  /// The number of stripes after the one being read that are loaded ahead of
+  /// the reader on the connector executor. Used when stripes are not loaded in
+  /// parallel. Stripes are not prefetched if this is 0.
+  static constexpr const char* kPrefetchStripes = "prefetch-stripes";
+
+  /// The maximum IO size in bytes of the stripes loaded ahead of the reader.
+  static constexpr const char* kPrefetchStripesMaxBytes =
+      "prefetch-stripes-max-bytes";
+
+  /// Whether dictionary encoded integer columns of DWRF files are returned as
+  /// dictionary vectors over the stripe dictionary.
+  static constexpr const char* kIntegerDictionaryOutput =
+      "integer-dictionary-output";
+
   /// The total size in bytes for a direct coalesce request.
   static constexpr const char* kLoadQuantum = "load-quantum";
 
@@ -161,6 +199,16 @@ class HiveConfig {
   /// meta data together. Optimization to decrease the small IO requests
   static constexpr const char* kFilePreloadThreshold = "file-preload-threshold";
 
+  /// Capacity in bytes of the process-wide cache of parsed Parquet footers.
+  /// Disabled if 0.
+  static constexpr const char* kParquetFooterCacheBytes =
+      "parquet-footer-cache-bytes";
+
+  /// Capacity in bytes of the process-wide cache of the deleted positions of
+  /// base files read from Iceberg positional delete files. Disabled if 0.
+  static constexpr const char* kIcebergPositionalDeleteCacheBytes =
+      "iceberg-positional-delete-cache-bytes";
+
   /// Maximum stripe size in orc writer.
   static constexpr const char* kOrcWriterMaxStripeSize =
       "hive.orc.writer.stripe-max-size";
@@ -203,6 +251,22 @@ class HiveConfig {
   static constexpr const char* kSortWriterMaxOutputBytesSession =
       "sort_writer_max_output_bytes";
 
+  /// If true, the sort writer orders the rows of a file on the Z-order curve
+  /// over the sort columns instead of on the sort columns one after another.
+  /// This clusters the rows on all the sort columns, so that the min/max
+  /// statistics of stripes and row groups are selective for each of them.
+  static constexpr const char* kSortWriterZOrder = "sort-writer-z-order";
+  static constexpr const char* kSortWriterZOrderSession =
+      "sort_writer_z_order";
+
+  /// If true, the data sink closes its file writers in parallel on the
+  /// connector executor when it finishes. Closing a writer flushes its last
+  /// stripe and completes the upload of the file, so closing many writers one
+  /// after another makes a long tail at the end of a write.
+  static constexpr const char* kParallelWriterClose = "parallel-writer-close";
+  static constexpr const char* kParallelWriterCloseSession =
+      "parallel_writer_close";
+
   static constexpr const char* kS3UseProxyFromEnv =
       "hive.s3.use-proxy-from-env";
 
@@ -215,11 +279,18 @@ class HiveConfig {
   static constexpr const char* kCacheNoRetention = "cache.no_retention";
   static constexpr const char* kCacheNoRetentionSession = "cache.no_retention";
 
+  /// Tag of the cache entries loaded by scans, e.g. a table or tenant id, for
+  /// AsyncDataCache::setTagQuota().
+  static constexpr const char* kCacheTag = "cache.tag";
+  static constexpr const char* kCacheTagSession = "cache.tag";
+
   InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* session) const;
 
   uint32_t maxPartitionsPerWriters(const Config* session) const;
 
+  bool partitionedWriteSortFallback(const Config* session) const;
+
   bool immutablePartitions() const;
 
   bool s3UseVirtualAddressing() const;
@@ -246,6 +317,10 @@ class HiveConfig {
 
   std::optional<uint32_t> s3MaxConnections() const;
 
+  uint32_t s3IoThreads() const;
+
+  uint32_t s3MaxConcurrentRequestsPerFile() const;
+
   std::string gcsEndpoint() const;
 
   std::string gcsScheme() const;
@@ -270,6 +345,14 @@ class HiveConfig {
 
   int32_t prefetchRowGroups() const;
 
+  int32_t maxParallelUnitLoads() const;
+
+  int32_t prefetchStripes() const;
+
+  uint64_t prefetchStripesMaxBytes() const;
+
+  bool integerDictionaryOutput() const;
+
   int32_t loadQuantum() const;
 
   int32_t numCacheFileHandles() const;
@@ -292,10 +375,18 @@ class HiveConfig {
 
   uint64_t sortWriterMaxOutputBytes(const Config* session) const;
 
+  bool sortWriterZOrder(const Config* session) const;
+
+  bool parallelWriterClose(const Config* session) const;
+
   uint64_t footerEstimatedSize() const;
 
   uint64_t filePreloadThreshold() const;
 
+  uint64_t parquetFooterCacheBytes() const;
+
+  uint64_t icebergPositionalDeleteCacheBytes() const;
+
   bool s3UseProxyFromEnv() const;
 
   /// Returns the timestamp unit used when writing timestamps into Parquet
@@ -309,6 +400,9 @@ class HiveConfig {
   /// locality.
   bool cacheNoRetention(const Config* session) const;
 
+  /// Returns the tag of the cache entries loaded by scans. 0 means no tag.
+  uint64_t cacheTag(const Config* session) const;
+
   HiveConfig(std::shared_ptr<const Config> config) {
     VELOX_CHECK_NOT_NULL(
         config, "Config is null for HiveConfig initialization");
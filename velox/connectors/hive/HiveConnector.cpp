@@ -21,6 +21,7 @@
 #include "velox/connectors/hive/HiveDataSink.h"
 #include "velox/connectors/hive/HiveDataSource.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 // Meta's buck build system needs this check.
 #ifdef VELOX_ENABLE_GCS
 #include "velox/connectors/hive/storage_adapters/gcs/RegisterGCSFileSystem.h" // @manual
@@ -40,6 +41,7 @@
 #ifdef VELOX_ENABLE_PARQUET
 #include "velox/dwio/parquet/RegisterParquetReader.h" // @manual
 #include "velox/dwio/parquet/RegisterParquetWriter.h" // @manual
+#include "velox/dwio/parquet/reader/FileMetaDataCache.h" // @manual
 #endif
 #include "velox/expression/FieldReference.h"
 
@@ -72,6 +74,16 @@ HiveConnector::HiveConnector(
     LOG(INFO) << "Hive connector " << connectorId()
               << " created with file handle cache disabled";
   }
+// Meta's buck build system needs this check.
+#ifdef VELOX_ENABLE_PARQUET
+  if (hiveConfig_->parquetFooterCacheBytes() > 0) {
+    parquet::FileMetaDataCache::create(hiveConfig_->parquetFooterCacheBytes());
+  }
+#endif
+  if (hiveConfig_->icebergPositionalDeleteCacheBytes() > 0) {
+    iceberg::PositionalDeleteCache::create(
+        hiveConfig_->icebergPositionalDeleteCacheBytes());
+  }
 }
 
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
@@ -105,7 +117,8 @@ std::unique_ptr<DataSink> HiveConnector::createDataSink(
       hiveInsertHandle,
       connectorQueryCtx,
       commitStrategy,
-      hiveConfig_);
+      hiveConfig_,
+      executor_);
 }
 
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
@@ -540,6 +540,12 @@ void configureReaderOptions(
   readerOptions.setPrefetchRowGroups(hiveConfig->prefetchRowGroups());
   readerOptions.setNoCacheRetention(
       hiveConfig->cacheNoRetention(sessionProperties));
+  readerOptions.setCacheTag(hiveConfig->cacheTag(sessionProperties));
+  if (hiveSplit->properties.has_value() &&
+      hiveSplit->properties->modificationTime.has_value()) {
+    readerOptions.setFileVersion(
+        std::to_string(hiveSplit->properties->modificationTime.value()));
+  }
 
   if (readerOptions.fileFormat() != dwio::common::FileFormat::UNKNOWN) {
     VELOX_CHECK(
@@ -613,19 +619,46 @@ bool applyPartitionFilter(
   }
 }
 
-} // namespace
+// Tests the filter of 'child' against the value of the partition key of the
+// same name. A null partition value passes if the filter accepts nulls.
+bool testPartitionFilter(
+    const common::ScanSpec& child,
+    const std::optional<std::string>& value,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle,
+    const std::string& filePath) {
+  auto* filter = child.filter();
+  bool passed;
+  if (value.has_value()) {
+    auto handlesIter = partitionKeysHandle.find(child.fieldName());
+    VELOX_CHECK(handlesIter != partitionKeysHandle.end());
+    passed = applyPartitionFilter(
+        handlesIter->second->dataType(), value.value(), filter);
+  } else {
+    passed = !filter->isDeterministic() || filter->testNull();
+  }
+  if (!passed) {
+    VLOG(1) << "Skipping " << filePath
+            << " based on the value of partition key " << child.fieldName();
+  }
+  return passed;
+}
 
-bool testFilters(
+// Tests the filters in 'scanSpec' against the partition keys and the file
+// level statistics of a file with 'totalRows' rows. 'columnStatistics' returns
+// the statistics of a top level column given its index in 'fileTypeWithId'.
+template <typename ColumnStatisticsFunc>
+bool testFiltersImpl(
     const common::ScanSpec* scanSpec,
-    const dwio::common::Reader* reader,
+    uint64_t totalRows,
+    const dwio::common::TypeWithId& fileTypeWithId,
+    ColumnStatisticsFunc columnStatistics,
     const std::string& filePath,
     const std::unordered_map<std::string, std::optional<std::string>>&
         partitionKey,
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle) {
-  auto totalRows = reader->numberOfRows();
-  const auto& fileTypeWithId = reader->typeWithId();
-  const auto& rowType = reader->rowType();
+  const auto& rowType = fileTypeWithId.type()->asRow();
   for (const auto& child : scanSpec->children()) {
     if (child->filter()) {
       const auto& name = child->fieldName();
@@ -633,19 +666,13 @@ bool testFilters(
       // By design, the partition key columns for Iceberg tables are included in
       // the data files to facilitate partition transform and partition
       // evolution, so we need to test both cases.
-      if (!rowType->containsChild(name) || iter != partitionKey.end()) {
-        if (iter != partitionKey.end() && iter->second.has_value()) {
-          auto handlesIter = partitionKeysHandle.find(name);
-          VELOX_CHECK(handlesIter != partitionKeysHandle.end());
-
-          // This is a non-null partition key
-          return applyPartitionFilter(
-              handlesIter->second->dataType(),
-              iter->second.value(),
-              child->filter());
+      if (iter != partitionKey.end()) {
+        if (!testPartitionFilter(
+                *child, iter->second, partitionKeysHandle, filePath)) {
+          return false;
         }
-        // Column is missing, most likely due to schema evolution. Or it's a
-        // partition key but the partition value is NULL.
+      } else if (!rowType.containsChild(name)) {
+        // Column is missing, most likely due to schema evolution.
         if (child->filter()->isDeterministic() &&
             !child->filter()->testNull()) {
           VLOG(1) << "Skipping " << filePath
@@ -654,13 +681,14 @@ bool testFilters(
           return false;
         }
       } else {
-        const auto& typeWithId = fileTypeWithId->childByName(name);
-        auto columnStats = reader->columnStatistics(typeWithId->id());
+        const auto index = rowType.getChildIdx(name);
+        const auto& typeWithId = fileTypeWithId.childAt(index);
+        auto columnStats = columnStatistics(index, typeWithId->id());
         if (columnStats != nullptr &&
             !testFilter(
                 child->filter(),
                 columnStats.get(),
-                totalRows.value(),
+                totalRows,
                 typeWithId->type())) {
           VLOG(1) << "Skipping " << filePath
                   << " based on stats and filter for column "
@@ -674,6 +702,96 @@ bool testFilters(
   return true;
 }
 
+} // namespace
+
+bool testFilters(
+    const common::ScanSpec* scanSpec,
+    const dwio::common::Reader* reader,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  const auto totalRows = reader->numberOfRows();
+  return testFiltersImpl(
+      scanSpec,
+      totalRows.value_or(0),
+      *reader->typeWithId(),
+      [&](uint32_t /*index*/, uint32_t id) {
+        // Statistics cannot be tested without the number of rows.
+        return totalRows.has_value()
+            ? reader->columnStatistics(id)
+            : std::unique_ptr<dwio::common::ColumnStatistics>();
+      },
+      filePath,
+      partitionKey,
+      partitionKeysHandle);
+}
+
+bool testFilters(
+    const common::ScanSpec* scanSpec,
+    const FileStatistics& fileStats,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  return testFiltersImpl(
+      scanSpec,
+      fileStats.numRows,
+      *fileStats.typeWithId,
+      [&](uint32_t index, uint32_t /*id*/) {
+        return fileStats.columnStats[index];
+      },
+      filePath,
+      partitionKey,
+      partitionKeysHandle);
+}
+
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle) {
+  if (partitionKey.empty()) {
+    return true;
+  }
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    auto iter = partitionKey.find(child->fieldName());
+    if (iter != partitionKey.end() &&
+        !testPartitionFilter(
+            *child, iter->second, partitionKeysHandle, filePath)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<const FileStatistics> makeFileStatistics(
+    const dwio::common::Reader& reader,
+    const RowTypePtr& fileSchema) {
+  const auto numRows = reader.numberOfRows();
+  if (!numRows.has_value()) {
+    return nullptr;
+  }
+  auto stats = std::make_shared<FileStatistics>();
+  stats->numRows = numRows.value();
+  stats->typeWithId = reader.typeWithId();
+  stats->fileSchema = fileSchema;
+  const auto numColumns = stats->typeWithId->size();
+  stats->columnStats.reserve(numColumns);
+  for (uint32_t i = 0; i < numColumns; ++i) {
+    stats->columnStats.push_back(
+        reader.columnStatistics(stats->typeWithId->childAt(i)->id()));
+  }
+  return stats;
+}
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
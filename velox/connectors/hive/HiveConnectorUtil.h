@@ -92,6 +92,33 @@ bool testFilters(
     const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle);
 
+/// Same as above, testing the filters against statistics cached from an
+/// earlier reader of the file.
+bool testFilters(
+    const common::ScanSpec* scanSpec,
+    const FileStatistics& fileStats,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle);
+
+/// Tests only the filters on partition keys, which needs no access to the
+/// file. Returns false if the split can be skipped without opening the file.
+bool testPartitionFilters(
+    const common::ScanSpec* scanSpec,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey,
+    const std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
+        partitionKeysHandle);
+
+/// Returns the file level statistics of the file read by 'reader' for caching
+/// in its FileHandle, or null if the reader does not know its row count.
+std::shared_ptr<const FileStatistics> makeFileStatistics(
+    const dwio::common::Reader& reader,
+    const RowTypePtr& fileSchema);
+
 std::unique_ptr<dwio::common::BufferedInput> createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts,
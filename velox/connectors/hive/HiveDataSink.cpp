@@ -16,15 +16,19 @@
 
 #include "velox/connectors/hive/HiveDataSink.h"
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/HivePartitionUtil.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/core/ITypedExpr.h"
+#include "velox/dwio/catalog/fbhive/FileUtils.h"
 #include "velox/dwio/common/SortingWriter.h"
+#include "velox/dwio/common/ZOrder.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/SortBuffer.h"
 
@@ -354,7 +358,8 @@ HiveDataSink::HiveDataSink(
     std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
     const ConnectorQueryCtx* connectorQueryCtx,
     CommitStrategy commitStrategy,
-    const std::shared_ptr<const HiveConfig>& hiveConfig)
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    folly::Executor* executor)
     : inputType_(std::move(inputType)),
       insertTableHandle_(std::move(insertTableHandle)),
       connectorQueryCtx_(connectorQueryCtx),
@@ -387,7 +392,16 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())),
-      spillConfig_(connectorQueryCtx->spillConfig()) {
+      spillConfig_(connectorQueryCtx->spillConfig()),
+      sortFallback_(
+          isPartitioned() && !isBucketed() &&
+          hiveConfig_->partitionedWriteSortFallback(
+              connectorQueryCtx->sessionProperties())),
+      closeExecutor_(
+          hiveConfig_->parallelWriterClose(
+              connectorQueryCtx->sessionProperties())
+              ? executor
+              : nullptr) {
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
         bucketCount_, maxBucketCount(), "bucketCount exceeds the limit");
@@ -419,13 +433,29 @@ HiveDataSink::HiveDataSink(
       }
     }
   }
+  if (sortWrite() &&
+      hiveConfig_->sortWriterZOrder(connectorQueryCtx->sessionProperties())) {
+    const auto dataType = getNonPartitionTypes(dataChannels_, inputType_);
+    for (const auto column : sortColumnIndices_) {
+      VELOX_USER_CHECK(
+          dwio::common::isZOrderKeyType(dataType->childAt(column)),
+          "Unsupported Z-order sort column type: {}",
+          dataType->childAt(column)->toString());
+    }
+    zOrderColumns_ = std::move(sortColumnIndices_);
+    sortColumnIndices_ = {static_cast<column_index_t>(dataType->size())};
+    sortCompareFlags_ = {
+        {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue}};
+  }
 }
 
 bool HiveDataSink::canReclaim() const {
-  // Currently, we only support memory reclaim on dwrf file writer.
+  // Currently, we only support memory reclaim on dwrf and parquet file
+  // writers.
+  const auto format = insertTableHandle_->tableStorageFormat();
   return (spillConfig_ != nullptr) &&
-      (insertTableHandle_->tableStorageFormat() ==
-       dwio::common::FileFormat::DWRF);
+      (format == dwio::common::FileFormat::DWRF ||
+       format == dwio::common::FileFormat::PARQUET);
 }
 
 void HiveDataSink::appendData(RowVectorPtr input) {
@@ -438,14 +468,25 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     return;
   }
 
-  // Compute partition and bucket numbers.
-  computePartitionAndBucketIds(input);
-
   // Lazy load all the input columns.
   for (column_index_t i = 0; i < input->childrenSize(); ++i) {
     input->childAt(i)->loadedVector();
   }
 
+  // Once the partitions exceed the open writer limit, the input is sorted on
+  // the partition keys and written on close.
+  if (partitionSortBuffer_ != nullptr) {
+    partitionSortBuffer_->addInput(input);
+    return;
+  }
+
+  // Compute partition and bucket numbers.
+  if (!computePartitionAndBucketIds(input)) {
+    startPartitionSort();
+    partitionSortBuffer_->addInput(input);
+    return;
+  }
+
   // All inputs belong to a single non-bucketed partition. The partition id
   // must be zero.
   if (!isBucketed() && partitionIdGenerator_->numPartitions() == 1) {
@@ -490,15 +531,131 @@ std::string HiveDataSink::stateString(State state) {
   }
 }
 
-void HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
+bool HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
   VELOX_CHECK(isPartitioned() || isBucketed());
   if (isPartitioned()) {
-    partitionIdGenerator_->run(input, partitionIds_);
+    if (!sortFallback_) {
+      partitionIdGenerator_->run(input, partitionIds_);
+    } else if (!partitionIdGenerator_->tryRun(input, partitionIds_)) {
+      return false;
+    }
   }
 
   if (isBucketed()) {
     bucketFunction_->partition(*input, bucketIds_);
   }
+  return true;
+}
+
+void HiveDataSink::startPartitionSort() {
+  VELOX_CHECK(sortFallback_);
+  VELOX_CHECK_NULL(partitionSortBuffer_);
+  auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  partitionSortPool_ = connectorPool->addLeafChild(
+      fmt::format("{}.partitionSort", connectorPool->name()));
+  if (connectorPool->reclaimer() != nullptr) {
+    partitionSortPool_->setReclaimer(exec::MemoryReclaimer::create());
+  }
+  partitionSortSpillStats_ =
+      std::make_unique<folly::Synchronized<common::SpillStats>>();
+  std::vector<CompareFlags> compareFlags(
+      partitionChannels_.size(),
+      {true, true, false, CompareFlags::NullHandlingMode::kNullAsValue});
+  partitionSortBuffer_ = std::make_unique<exec::SortBuffer>(
+      inputType_,
+      partitionChannels_,
+      compareFlags,
+      partitionSortPool_.get(),
+      &nonReclaimableSection_,
+      spillConfig_,
+      partitionSortSpillStats_.get());
+}
+
+void HiveDataSink::writeSortedPartitions() {
+  partitionSortBuffer_->noMoreInput();
+  const auto* session = connectorQueryCtx_->sessionProperties();
+  const auto maxOutputRows = hiveConfig_->sortWriterMaxOutputRows(session);
+  const bool lowerCase = hiveConfig_->isPartitionPathAsLowerCase(session);
+
+  // Partitions that got a writer before the input was sorted keep writing to
+  // it.
+  folly::F14FastMap<std::string, uint32_t> partitionWriters;
+  for (const auto& [id, index] : writerIndexMap_) {
+    partitionWriters.emplace(
+        writerInfo_[index]->writerParameters.partitionName().value(), index);
+  }
+
+  std::vector<std::string> keyNames;
+  std::vector<TypePtr> keyTypes;
+  for (auto channel : partitionChannels_) {
+    keyNames.push_back(inputType_->nameOf(channel));
+    keyTypes.push_back(inputType_->childAt(channel));
+  }
+  // The partition key values of the current partition.
+  auto partitionValues = BaseVector::create<RowVector>(
+      ROW(std::move(keyNames), std::move(keyTypes)),
+      1,
+      connectorQueryCtx_->memoryPool());
+
+  std::optional<uint32_t> writerIndex;
+  bool closeWriter = false;
+  uint32_t nextPartitionId = maxOpenWriters_;
+  auto startPartition = [&](const RowVectorPtr& input, vector_size_t row) {
+    if (closeWriter) {
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerIndex.value());
+      writers_[writerIndex.value()]->close();
+    }
+    for (auto i = 0; i < partitionChannels_.size(); ++i) {
+      partitionValues->childAt(i)->copy(
+          input->childAt(partitionChannels_[i]).get(), 0, row, 1);
+    }
+    const auto partitionName = dwio::catalog::fbhive::FileUtils::makePartName(
+        extractPartitionKeyValues(partitionValues, 0), lowerCase);
+    auto it = partitionWriters.find(partitionName);
+    closeWriter = it == partitionWriters.end();
+    writerIndex = closeWriter
+        ? appendWriter(HiveWriterId{nextPartitionId++}, partitionName)
+        : it->second;
+  };
+  auto isNewPartition = [&](const RowVectorPtr& input, vector_size_t row) {
+    if (!writerIndex.has_value()) {
+      return true;
+    }
+    for (auto i = 0; i < partitionChannels_.size(); ++i) {
+      if (!input->childAt(partitionChannels_[i])
+               ->equalValueAt(partitionValues->childAt(i).get(), row, 0)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  while (auto output = partitionSortBuffer_->getOutput(maxOutputRows)) {
+    vector_size_t start = 0;
+    for (vector_size_t row = 0; row < output->size(); ++row) {
+      if (!isNewPartition(output, row)) {
+        continue;
+      }
+      if (row > start) {
+        write(
+            writerIndex.value(),
+            std::static_pointer_cast<RowVector>(
+                output->slice(start, row - start)));
+      }
+      startPartition(output, row);
+      start = row;
+    }
+    write(
+        writerIndex.value(),
+        start == 0 ? output
+                   : std::static_pointer_cast<RowVector>(
+                         output->slice(start, output->size() - start)));
+  }
+  if (closeWriter) {
+    WRITER_NON_RECLAIMABLE_SECTION_GUARD(writerIndex.value());
+    writers_[writerIndex.value()]->close();
+  }
+  partitionSortBuffer_.reset();
 }
 
 DataSink::Stats HiveDataSink::stats() const {
@@ -526,6 +683,12 @@ DataSink::Stats HiveDataSink::stats() const {
       stats.spillStats += *spillStats;
     }
   }
+  if (partitionSortSpillStats_ != nullptr) {
+    const auto spillStats = partitionSortSpillStats_->rlock();
+    if (!spillStats->empty()) {
+      stats.spillStats += *spillStats;
+    }
+  }
   return stats;
 }
 
@@ -575,6 +738,9 @@ void HiveDataSink::checkStateTransition(State oldState, State newState) {
 
 std::vector<std::string> HiveDataSink::close() {
   checkRunning();
+  if (partitionSortBuffer_ != nullptr) {
+    writeSortedPartitions();
+  }
   state_ = State::kClosed;
   closeInternal();
 
@@ -622,15 +788,50 @@ void HiveDataSink::closeInternal() {
       "facebook::velox::connector::hive::HiveDataSink::closeInternal", this);
 
   if (state_ == State::kClosed) {
-    for (int i = 0; i < writers_.size(); ++i) {
-      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
-      writers_[i]->close();
-    }
+    closeWriters();
   } else {
     for (int i = 0; i < writers_.size(); ++i) {
+      if (writers_[i]->state() == dwio::common::Writer::State::kClosed) {
+        continue;
+      }
       WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
       writers_[i]->abort();
     }
+    partitionSortBuffer_.reset();
+  }
+}
+
+void HiveDataSink::closeWriters() {
+  std::vector<std::shared_ptr<AsyncSource<uint32_t>>> closes;
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    // The writers of sorted partitions are closed as they are written.
+    if (writers_[i]->state() == dwio::common::Writer::State::kClosed) {
+      continue;
+    }
+    closes.push_back(std::make_shared<AsyncSource<uint32_t>>([this, i]() {
+      WRITER_NON_RECLAIMABLE_SECTION_GUARD(i);
+      writers_[i]->close();
+      return std::make_unique<uint32_t>(i);
+    }));
+    // The caller closes the first writer and any writer the executor has not
+    // started.
+    if (closes.size() > 1 && closeExecutor_ != nullptr) {
+      closeExecutor_->add([source = closes.back()]() { source->prepare(); });
+    }
+  }
+  auto sync = folly::makeGuard([&]() {
+    for (auto& close : closes) {
+      // Waits for the pending closes that reference this data sink. This is a
+      // cleanup in the guard and must not throw. The first error is already
+      // captured before this runs.
+      try {
+        close->move();
+      } catch (const std::exception&) {
+      }
+    }
+  });
+  for (auto& close : closes) {
+    close->move();
   }
 }
 
@@ -642,22 +843,28 @@ uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   return appendWriter(id);
 }
 
-uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
-  // Check max open writers.
-  VELOX_USER_CHECK_LE(
-      writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+uint32_t HiveDataSink::appendWriter(
+    const HiveWriterId& id,
+    const std::optional<std::string>& partitionName) {
+  // Check max open writers. The writers of sorted partitions are opened one at
+  // a time.
+  if (partitionSortBuffer_ == nullptr) {
+    VELOX_USER_CHECK_LE(
+        writers_.size(), maxOpenWriters_, "Exceeded open writer limit");
+  }
   VELOX_CHECK_EQ(writers_.size(), writerInfo_.size());
   VELOX_CHECK_EQ(writerIndexMap_.size(), writerInfo_.size());
 
-  std::optional<std::string> partitionName;
-  if (isPartitioned()) {
-    partitionName =
+  std::optional<std::string> writerPartitionName = partitionName;
+  if (isPartitioned() && !writerPartitionName.has_value()) {
+    writerPartitionName =
         partitionIdGenerator_->partitionName(id.partitionId.value());
   }
 
   // Without explicitly setting flush policy, the default memory based flush
   // policy is used.
-  auto writerParameters = getWriterParameters(partitionName, id.bucketId);
+  auto writerParameters =
+      getWriterParameters(writerPartitionName, id.bucketId);
   const auto writePath = fs::path(writerParameters.writeDirectory()) /
       writerParameters.writeFileName();
   auto writerPool = createWriterPool(id);
@@ -732,8 +939,16 @@ HiveDataSink::maybeCreateBucketSortWriter(
   }
   auto* sortPool = writerInfo_.back()->sortPool.get();
   VELOX_CHECK_NOT_NULL(sortPool);
+  auto sortInputType = getNonPartitionTypes(dataChannels_, inputType_);
+  if (!zOrderColumns_.empty()) {
+    auto names = sortInputType->names();
+    auto types = sortInputType->children();
+    names.push_back("$zorder");
+    types.push_back(VARBINARY());
+    sortInputType = ROW(std::move(names), std::move(types));
+  }
   auto sortBuffer = std::make_unique<exec::SortBuffer>(
-      getNonPartitionTypes(dataChannels_, inputType_),
+      sortInputType,
       sortColumnIndices_,
       sortCompareFlags_,
       sortPool,
@@ -746,7 +961,8 @@ HiveDataSink::maybeCreateBucketSortWriter(
       hiveConfig_->sortWriterMaxOutputRows(
           connectorQueryCtx_->sessionProperties()),
       hiveConfig_->sortWriterMaxOutputBytes(
-          connectorQueryCtx_->sessionProperties()));
+          connectorQueryCtx_->sessionProperties()),
+      zOrderColumns_);
 }
 
 HiveWriterId HiveDataSink::getWriterId(size_t row) const {
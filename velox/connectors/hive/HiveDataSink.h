@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
 #include "velox/exec/MemoryReclaimer.h"
+#include "velox/exec/SortBuffer.h"
 
 namespace facebook::velox::dwrf {
 class Writer;
@@ -419,7 +420,8 @@ class HiveDataSink : public DataSink {
       std::shared_ptr<const HiveInsertTableHandle> insertTableHandle,
       const ConnectorQueryCtx* connectorQueryCtx,
       CommitStrategy commitStrategy,
-      const std::shared_ptr<const HiveConfig>& hiveConfig);
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      folly::Executor* executor = nullptr);
 
   static uint32_t maxBucketCount() {
     static const uint32_t kMaxBucketCount = 100'000;
@@ -508,8 +510,10 @@ class HiveDataSink : public DataSink {
       HiveWriterInfo* writerInfo,
       io::IoStatistics* ioStats);
 
-  // Compute the partition id and bucket id for each row in 'input'.
-  void computePartitionAndBucketIds(const RowVectorPtr& input);
+  // Compute the partition id and bucket id for each row in 'input'. Returns
+  // false if 'input' has more new partitions than fit in 'maxOpenWriters_'
+  // and 'sortFallback_' is set.
+  bool computePartitionAndBucketIds(const RowVectorPtr& input);
 
   // Get the HiveWriter corresponding to the row
   // from partitionIds and bucketIds.
@@ -526,8 +530,20 @@ class HiveDataSink : public DataSink {
   uint32_t ensureWriter(const HiveWriterId& id);
 
   // Appends a new writer for the given 'id'. The function returns the index of
-  // the newly created writer in 'writers_'.
-  uint32_t appendWriter(const HiveWriterId& id);
+  // the newly created writer in 'writers_'. 'partitionName' is derived from
+  // the partition id of 'id' if not set.
+  uint32_t appendWriter(
+      const HiveWriterId& id,
+      const std::optional<std::string>& partitionName = std::nullopt);
+
+  // Creates 'partitionSortBuffer_' when the partitions of the input exceed
+  // 'maxOpenWriters_' with 'sortFallback_' set.
+  void startPartitionSort();
+
+  // Writes the rows of 'partitionSortBuffer_' in partition key order. Each
+  // partition that has no writer yet gets a writer that is closed before the
+  // next partition starts.
+  void writeSortedPartitions();
 
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
@@ -558,6 +574,10 @@ class HiveDataSink : public DataSink {
 
   void closeInternal();
 
+  // Closes the writers that are not closed yet. Closes them in parallel on
+  // 'closeExecutor_' if set.
+  void closeWriters();
+
   const RowTypePtr inputType_;
   const std::shared_ptr<const HiveInsertTableHandle> insertTableHandle_;
   const ConnectorQueryCtx* const connectorQueryCtx_;
@@ -573,9 +593,18 @@ class HiveDataSink : public DataSink {
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
   const std::shared_ptr<dwio::common::WriterFactory> writerFactory_;
   const common::SpillConfig* const spillConfig_;
+  // True if an unbucketed partitioned table sorts its input on the partition
+  // keys instead of failing when the partitions exceed 'maxOpenWriters_'.
+  const bool sortFallback_;
+  // Executor to close the writers on in parallel. nullptr if the writers are
+  // closed one after another.
+  folly::Executor* const closeExecutor_;
 
   std::vector<column_index_t> sortColumnIndices_;
   std::vector<CompareFlags> sortCompareFlags_;
+  // The sort columns if the rows are sorted on their Z-order. The sort
+  // writers then sort on a Z-order value appended after the data columns.
+  std::vector<column_index_t> zOrderColumns_;
 
   State state_{State::kRunning};
 
@@ -602,6 +631,13 @@ class HiveDataSink : public DataSink {
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
+
+  // Input received after the partitions exceeded 'maxOpenWriters_', sorted on
+  // the partition keys. Set only if 'sortFallback_' is true.
+  std::shared_ptr<memory::MemoryPool> partitionSortPool_;
+  std::unique_ptr<folly::Synchronized<common::SpillStats>>
+      partitionSortSpillStats_;
+  std::unique_ptr<exec::SortBuffer> partitionSortBuffer_;
 };
 
 } // namespace facebook::velox::connector::hive
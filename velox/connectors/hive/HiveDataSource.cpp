@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/HiveDataSource.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 
@@ -278,11 +279,21 @@ std::optional<RowVectorPtr> HiveDataSource::next(
 void HiveDataSource::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
+  dynamicFilters_.emplace_back(outputChannel, filter);
+  applyDynamicFilter(outputChannel, filter);
+}
+
+void HiveDataSource::applyDynamicFilter(
+    column_index_t outputChannel,
+    const std::shared_ptr<common::Filter>& filter) {
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
   scanSpec_->resetCachedValues(true);
   if (splitReader_) {
     splitReader_->resetFilterCaches();
+    if (split_) {
+      splitReader_->checkIfSplitIsEmptyOnNewFilter(runtimeStats_);
+    }
   }
 }
 
@@ -342,6 +353,18 @@ void HiveDataSource::setFromDataSource(
   // balance to that.
   source->ioStats_->merge(*ioStats_);
   ioStats_ = std::move(source->ioStats_);
+
+  // Dynamic filters that arrived after the split was prepared can still
+  // prune the split or its row groups before they are read.
+  for (const auto& [channel, filter] : dynamicFilters_) {
+    const bool applied = std::any_of(
+        source->dynamicFilters_.begin(),
+        source->dynamicFilters_.end(),
+        [&](const auto& entry) { return entry.second == filter; });
+    if (!applied) {
+      applyDynamicFilter(channel, filter);
+    }
+  }
 }
 
 int64_t HiveDataSource::estimatedRowSize() {
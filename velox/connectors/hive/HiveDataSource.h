@@ -132,6 +132,12 @@ class HiveDataSource : public DataSource {
   // hold adaptation.
   void resetSplit();
 
+  // Adds 'filter' to 'scanSpec_' and skips the rest of the current split if
+  // its partition key values or file statistics do not pass the filters.
+  void applyDynamicFilter(
+      column_index_t outputChannel,
+      const std::shared_ptr<common::Filter>& filter);
+
   const RowVectorPtr& getEmptyOutput() {
     if (!emptyOutput_) {
       emptyOutput_ = RowVector::createEmpty(outputType_, pool_);
@@ -159,6 +165,12 @@ class HiveDataSource : public DataSource {
   exec::FilterEvalCtx filterEvalCtx_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 
+  // Dynamic filters added by addDynamicFilter(). A preloaded split may have
+  // been prepared before some of these arrived, so setFromDataSource() adds
+  // the ones missing from the preloaded ScanSpec.
+  std::vector<std::pair<column_index_t, std::shared_ptr<common::Filter>>>
+      dynamicFilters_;
+
   // Remembers the WaveDataSource. Successive calls to toWaveDataSource() will
   // return the same.
   std::shared_ptr<wave::WaveDataSource> waveDataSource_;
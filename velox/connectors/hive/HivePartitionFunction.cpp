@@ -502,12 +502,12 @@ std::optional<uint32_t> HivePartitionFunction::partition(
     // NOTE: if bucket to partition mapping is empty, then we do
     // identical mapping.
     for (auto i = 0; i < numRows; ++i) {
-      partitions[i] = (hashes[i] & kInt32Max) % numBuckets_;
+      partitions[i] = bucketModulo_.mod32(hashes[i] & kInt32Max);
     }
   } else {
     for (auto i = 0; i < numRows; ++i) {
       partitions[i] =
-          bucketToPartition_[((hashes[i] & kInt32Max) % numBuckets_)];
+          bucketToPartition_[bucketModulo_.mod32(hashes[i] & kInt32Max)];
     }
   }
 
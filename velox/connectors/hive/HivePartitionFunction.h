@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/FastModulo.h"
 #include "velox/core/PlanNode.h"
 #include "velox/vector/DecodedVector.h"
 
@@ -74,6 +75,8 @@ class HivePartitionFunction : public core::PartitionFunction {
   std::vector<uint32_t>& getHashes(size_t poolIndex = 0);
 
   const int numBuckets_;
+  // Takes the hashes modulo 'numBuckets_'.
+  const FastModulo bucketModulo_{static_cast<uint32_t>(numBuckets_)};
   const std::vector<int> bucketToPartition_;
   const std::vector<column_index_t> keyChannels_;
 
@@ -16,6 +16,8 @@
 
 #include "velox/connectors/hive/PartitionIdGenerator.h"
 
+#include <folly/container/F14Set.h>
+
 #include "velox/connectors/hive/HivePartitionUtil.h"
 #include "velox/dwio/catalog/fbhive/FileUtils.h"
 
@@ -63,6 +65,15 @@ PartitionIdGenerator::PartitionIdGenerator(
 void PartitionIdGenerator::run(
     const RowVectorPtr& input,
     raw_vector<uint64_t>& result) {
+  VELOX_USER_CHECK(
+      tryRun(input, result),
+      "Exceeded limit of {} distinct partitions.",
+      maxPartitions_);
+}
+
+bool PartitionIdGenerator::tryRun(
+    const RowVectorPtr& input,
+    raw_vector<uint64_t>& result) {
   const auto numRows = input->size();
   result.resize(numRows);
 
@@ -71,6 +82,17 @@ void PartitionIdGenerator::run(
   // Compute value IDs using VectorHashers and store these in 'result'.
   computeValueIds(input, result);
 
+  // Checks that the new partitions fit before assigning any of them.
+  folly::F14FastSet<uint64_t> newValueIds;
+  for (auto i = 0; i < numRows; ++i) {
+    if (partitionIds_.count(result[i]) == 0) {
+      newValueIds.insert(result[i]);
+      if (partitionIds_.size() + newValueIds.size() > maxPartitions_) {
+        return false;
+      }
+    }
+  }
+
   // Convert value IDs in 'result' into partition IDs using partitionIds
   // mapping. Update 'result' in place.
 
@@ -84,18 +106,13 @@ void PartitionIdGenerator::run(
       result[i] = it->second;
     } else {
       uint64_t nextPartitionId = partitionIds_.size();
-      VELOX_USER_CHECK_LT(
-          nextPartitionId,
-          maxPartitions_,
-          "Exceeded limit of {} distinct partitions.",
-          maxPartitions_);
-
       partitionIds_.emplace(valueId, nextPartitionId);
       savePartitionValues(nextPartitionId, input, i);
 
       result[i] = nextPartitionId;
     }
   }
+  return true;
 }
 
 std::string PartitionIdGenerator::partitionName(uint64_t partitionId) const {
@@ -43,6 +43,10 @@ class PartitionIdGenerator {
   /// @param result Generated integer IDs indexed by input row number.
   void run(const RowVectorPtr& input, raw_vector<uint64_t>& result);
 
+  /// Same as run() but returns false without assigning new partition ids if
+  /// 'input' has more new partitions than fit in the limit.
+  bool tryRun(const RowVectorPtr& input, raw_vector<uint64_t>& result);
+
   /// Return the total number of distinct partitions processed so far.
   uint64_t numPartitions() const {
     return partitionIds_.size();
@@ -23,6 +23,8 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergSplitReader.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
+#include "velox/dwio/common/ParallelUnitLoader.h"
+#include "velox/dwio/common/PrefetchUnitLoader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/type/TimestampConversion.h"
 
@@ -159,6 +161,7 @@ void SplitReader::prepareSplit(
 }
 
 uint64_t SplitReader::next(uint64_t size, VectorPtr& output) {
+  readStarted_ = true;
   if (!baseReaderOpts_.randomSkip()) {
     return baseRowReader_->next(size, output);
   }
@@ -173,6 +176,35 @@ void SplitReader::resetFilterCaches() {
   }
 }
 
+bool SplitReader::checkIfSplitIsEmptyOnNewFilter(
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (emptySplit_ || !hiveSplit_) {
+    return emptySplit_;
+  }
+  bool passed = testPartitionFilters(
+      scanSpec_.get(),
+      hiveSplit_->filePath,
+      hiveSplit_->partitionKeys,
+      *partitionKeys_);
+  if (passed && baseReader_) {
+    passed = testFilters(
+        scanSpec_.get(),
+        baseReader_.get(),
+        hiveSplit_->filePath,
+        hiveSplit_->partitionKeys,
+        *partitionKeys_);
+  }
+  if (!passed) {
+    // A split that was partially read is not counted as skipped.
+    if (!readStarted_) {
+      ++runtimeStats.skippedSplits;
+      runtimeStats.skippedSplitBytes += hiveSplit_->length;
+    }
+    emptySplit_ = true;
+  }
+  return emptySplit_;
+}
+
 bool SplitReader::emptySplit() const {
   return emptySplit_;
 }
@@ -227,6 +259,19 @@ void SplitReader::createReader() {
   VELOX_CHECK_NE(
       baseReaderOpts_.fileFormat(), dwio::common::FileFormat::UNKNOWN);
 
+  // Filters on partition keys are tested before opening the file, so a
+  // pruned split costs no IO.
+  if (scanSpec_->hasFilter() &&
+      !testPartitionFilters(
+          scanSpec_.get(),
+          hiveSplit_->filePath,
+          hiveSplit_->partitionKeys,
+          *partitionKeys_)) {
+    emptySplit_ = true;
+    skippedWithoutReader_ = true;
+    return;
+  }
+
   FileHandleCachedPtr fileHandleCachePtr;
   try {
     fileHandleCachePtr = fileHandleFactory_->generate(
@@ -251,6 +296,28 @@ void SplitReader::createReader() {
   if (auto* cacheTTLController = cache::CacheTTLController::getInstance()) {
     cacheTTLController->addOpenFileInfo(fileHandleCachePtr->uuid.id());
   }
+
+  const bool hasFilter = scanSpec_->hasFilter();
+  if (hasFilter) {
+    auto fileStats = fileHandleCachePtr->statistics.copy();
+    const auto& fileSchema = baseReaderOpts_.fileSchema();
+    const bool sameSchema = fileStats &&
+        (fileStats->fileSchema == fileSchema ||
+         (fileStats->fileSchema && fileSchema &&
+          *fileStats->fileSchema == *fileSchema));
+    if (sameSchema &&
+        !testFilters(
+            scanSpec_.get(),
+            *fileStats,
+            hiveSplit_->filePath,
+            hiveSplit_->partitionKeys,
+            *partitionKeys_)) {
+      emptySplit_ = true;
+      skippedWithoutReader_ = true;
+      return;
+    }
+  }
+
   auto baseFileInput = createBufferedInput(
       *fileHandleCachePtr,
       baseReaderOpts_,
@@ -260,13 +327,28 @@ void SplitReader::createReader() {
 
   baseReader_ = dwio::common::getReaderFactory(baseReaderOpts_.fileFormat())
                     ->createReader(std::move(baseFileInput), baseReaderOpts_);
+
+  if (hasFilter && !*fileHandleCachePtr->statistics.rlock()) {
+    auto fileStats =
+        makeFileStatistics(*baseReader_, baseReaderOpts_.fileSchema());
+    fileHandleCachePtr->statistics.withWLock([&](auto& statistics) {
+      if (!statistics) {
+        statistics = std::move(fileStats);
+      }
+    });
+  }
 }
 
 bool SplitReader::checkIfSplitIsEmpty(
     dwio::common::RuntimeStatistics& runtimeStats) {
-  // emptySplit_ may already be set if the data file is not found. In this case
-  // we don't need to test further.
+  // emptySplit_ may already be set if the data file is not found or the
+  // cached statistics of the file show the split is empty. In this case we
+  // don't need to test further.
   if (emptySplit_) {
+    if (skippedWithoutReader_) {
+      ++runtimeStats.skippedSplits;
+      runtimeStats.skippedSplitBytes += hiveSplit_->length;
+    }
     return true;
   }
 
@@ -308,6 +390,22 @@ void SplitReader::createRowReader(
       metadataFilter,
       ROW(std::move(columnNames), std::move(columnTypes)),
       hiveSplit_);
+  if (hiveConfig_->maxParallelUnitLoads() > 1 && executor_ != nullptr) {
+    baseRowReaderOpts_.setUnitLoaderFactory(
+        std::make_shared<dwio::common::ParallelUnitLoaderFactory>(
+            executor_,
+            hiveConfig_->maxParallelUnitLoads(),
+            baseRowReaderOpts_.getBlockedOnIoCallback()));
+  } else if (hiveConfig_->prefetchStripes() > 0 && executor_ != nullptr) {
+    baseRowReaderOpts_.setUnitLoaderFactory(
+        std::make_shared<dwio::common::PrefetchUnitLoaderFactory>(
+            executor_,
+            hiveConfig_->prefetchStripes(),
+            hiveConfig_->prefetchStripesMaxBytes(),
+            baseRowReaderOpts_.getBlockedOnIoCallback()));
+  }
+  baseRowReaderOpts_.setIntegerDictionaryOutput(
+      hiveConfig_->integerDictionaryOutput());
   // NOTE: we firstly reset the finished 'baseRowReader_' of previous split
   // before setting up for the next one to avoid doubling the peak memory usage.
   baseRowReader_.reset();
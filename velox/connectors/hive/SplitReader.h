@@ -98,6 +98,13 @@ class SplitReader {
 
   void resetFilterCaches();
 
+  /// Tests the filters again on the partition key values and the file
+  /// statistics of the split after a dynamic filter was added to the
+  /// ScanSpec. Marks the split empty if no row of it can pass. Returns true if
+  /// the split is empty.
+  bool checkIfSplitIsEmptyOnNewFilter(
+      dwio::common::RuntimeStatistics& runtimeStats);
+
   bool emptySplit() const;
 
   void resetSplit();
@@ -114,7 +121,9 @@ class SplitReader {
 
  protected:
   /// Create the dwio::common::Reader object baseReader_, which will be used to
-  /// read the data file's metadata and schema
+  /// read the data file's metadata and schema. The reader is not created if
+  /// statistics cached in the file handle by an earlier split show that the
+  /// split is empty.
   void createReader();
 
   /// Check if the hiveSplit_ is empty. The split is considered empty when
@@ -122,7 +131,7 @@ class SplitReader {
   ///   2) The file does not contain any rows
   ///   3) The data in the file does not pass the filters. The test is based on
   ///      the file metadata and partition key values
-  /// This function needs to be called after baseReader_ is created.
+  /// This function needs to be called after createReader().
   bool checkIfSplitIsEmpty(dwio::common::RuntimeStatistics& runtimeStats);
 
   /// Create the dwio::common::RowReader object baseRowReader_, which owns the
@@ -166,6 +175,11 @@ class SplitReader {
   dwio::common::ReaderOptions baseReaderOpts_;
   dwio::common::RowReaderOptions baseRowReaderOpts_;
   bool emptySplit_;
+  // True if the split was skipped without creating 'baseReader_', on the
+  // partition key values or on the statistics cached in the file handle.
+  bool skippedWithoutReader_{false};
+  // True after the first call to next().
+  bool readStarted_{false};
 };
 
 } // namespace facebook::velox::connector::hive
@@ -65,9 +65,17 @@ class HivePartitionFunctionBenchmark
     addRowVector(MAP(BIGINT(), BOOLEAN()));
     addRowVector(ROW({"a", "b"}, {INTEGER(), DOUBLE()}));
 
+    multiColumnVector_ = vm.rowVector({
+        fuzzer.fuzzFlat(BIGINT()),
+        fuzzer.fuzzFlat(VARCHAR()),
+        fuzzer.fuzzFlat(INTEGER()),
+    });
+
     // Prepare HivePartitionFunction
     fewBucketsFunction_ = createHivePartitionFunction(20);
     manyBucketsFunction_ = createHivePartitionFunction(100);
+    fewBucketsMultiColumnFunction_ = createHivePartitionFunction(20, 3);
+    manyBucketsMultiColumnFunction_ = createHivePartitionFunction(100, 3);
 
     partitions_.resize(vectorSize);
   }
@@ -82,13 +90,24 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  // Partitions on BIGINT, VARCHAR and INTEGER keys.
+  void runMultiColumnFew() {
+    fewBucketsMultiColumnFunction_->partition(*multiColumnVector_, partitions_);
+  }
+
+  void runMultiColumnMany() {
+    manyBucketsMultiColumnFunction_->partition(
+        *multiColumnVector_, partitions_);
+  }
+
  private:
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
-      size_t bucketCount) {
+      size_t bucketCount,
+      column_index_t numKeys = 1) {
     std::vector<int> bucketToPartition(bucketCount);
     std::iota(bucketToPartition.begin(), bucketToPartition.end(), 0);
-    std::vector<column_index_t> keyChannels;
-    keyChannels.emplace_back(0);
+    std::vector<column_index_t> keyChannels(numKeys);
+    std::iota(keyChannels.begin(), keyChannels.end(), 0);
     return std::make_unique<HivePartitionFunction>(
         bucketCount, bucketToPartition, keyChannels);
   }
@@ -103,8 +122,11 @@ class HivePartitionFunctionBenchmark
   }
 
   std::unordered_map<TypeKind, RowVectorPtr> rowVectors_;
+  RowVectorPtr multiColumnVector_;
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
+  std::unique_ptr<HivePartitionFunction> fewBucketsMultiColumnFunction_;
+  std::unique_ptr<HivePartitionFunction> manyBucketsMultiColumnFunction_;
   std::vector<uint32_t> partitions_;
 };
 
@@ -325,6 +347,24 @@ BENCHMARK_RELATIVE(rowManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::ROW>();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(multiColumnFewRowsFewBuckets) {
+  benchmarkFew->runMultiColumnFew();
+}
+
+BENCHMARK_RELATIVE(multiColumnFewRowsManyBuckets) {
+  benchmarkFew->runMultiColumnMany();
+}
+
+BENCHMARK(multiColumnManyRowsFewBuckets) {
+  benchmarkMany->runMultiColumnFew();
+}
+
+BENCHMARK_RELATIVE(multiColumnManyRowsManyBuckets) {
+  benchmarkMany->runMultiColumnMany();
+}
+
 BENCHMARK_DRAW_LINE();
 } // namespace
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/DeleteBitmap.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+void DeleteBitmap::add(int64_t position) {
+  VELOX_USER_CHECK_GE(position, 0, "Negative delete position");
+  VELOX_USER_CHECK_GE(
+      position, maxPosition_, "Delete positions must be in ascending order");
+  if (position == maxPosition_) {
+    return;
+  }
+  maxPosition_ = position;
+  ++size_;
+  const int64_t key = position >> kChunkBits;
+  const uint16_t offset = position & (kChunkSize - 1);
+  if (chunks_.empty() || chunks_.back().key != key) {
+    chunks_.push_back(Chunk{key, {}, {}});
+  }
+  auto& chunk = chunks_.back();
+  if (!chunk.bits.empty()) {
+    bits::setBit(chunk.bits.data(), offset);
+    return;
+  }
+  chunk.offsets.push_back(offset);
+  if (chunk.offsets.size() > kMaxArraySize) {
+    chunk.bits.resize(kChunkSize / 64);
+    for (auto chunkOffset : chunk.offsets) {
+      bits::setBit(chunk.bits.data(), chunkOffset);
+    }
+    chunk.offsets = {};
+  }
+}
+
+void DeleteBitmap::finish() {
+  chunks_.shrink_to_fit();
+  for (auto& chunk : chunks_) {
+    chunk.offsets.shrink_to_fit();
+  }
+}
+
+void DeleteBitmap::apply(int64_t begin, int64_t end, uint64_t* bits) const {
+  auto it = std::lower_bound(
+      chunks_.begin(),
+      chunks_.end(),
+      begin >> kChunkBits,
+      [](const Chunk& chunk, int64_t key) { return chunk.key < key; });
+  for (; it != chunks_.end(); ++it) {
+    const int64_t chunkBegin = it->key << kChunkBits;
+    if (chunkBegin >= end) {
+      break;
+    }
+    if (it->bits.empty()) {
+      auto offset = std::lower_bound(
+          it->offsets.begin(),
+          it->offsets.end(),
+          std::max<int64_t>(0, begin - chunkBegin));
+      for (; offset != it->offsets.end() && chunkBegin + *offset < end;
+           ++offset) {
+        bits::setBit(bits, chunkBegin + *offset - begin);
+      }
+    } else {
+      const auto firstRow = std::max<int64_t>(begin - chunkBegin, 0);
+      const auto endRow = std::min<int64_t>(end - chunkBegin, kChunkSize);
+      bits::forEachSetBit(it->bits.data(), firstRow, endRow, [&](auto row) {
+        bits::setBit(bits, chunkBegin + row - begin);
+      });
+    }
+  }
+}
+
+uint64_t DeleteBitmap::memoryBytes() const {
+  uint64_t bytes = sizeof(*this) + chunks_.capacity() * sizeof(Chunk);
+  for (const auto& chunk : chunks_) {
+    bytes += chunk.offsets.capacity() * sizeof(uint16_t) +
+        chunk.bits.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
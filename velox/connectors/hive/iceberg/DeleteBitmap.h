@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// Compressed set of the deleted row positions of a base file in the manner of
+/// a Roaring bitmap. Positions are split into chunks of 64K rows. A chunk with
+/// few positions keeps them as a sorted array of 16 bit offsets and a chunk
+/// with many keeps a bitmap of 64K bits, so that the size stays proportional
+/// to the number of positions for sparse deletes and bounded for dense ones.
+/// Built from positions in ascending order, which is the order of positions
+/// for a file path in an Iceberg positional delete file.
+class DeleteBitmap {
+ public:
+  /// Adds 'position'. Positions must be added in non-decreasing order.
+  void add(int64_t position);
+
+  /// Releases unused capacity after the last add().
+  void finish();
+
+  /// Sets bit 'position - begin' in 'bits' for each position in [begin, end).
+  void apply(int64_t begin, int64_t end, uint64_t* bits) const;
+
+  /// Returns the number of distinct positions.
+  int64_t size() const {
+    return size_;
+  }
+
+  /// Returns the largest position or -1 if empty.
+  int64_t maxPosition() const {
+    return maxPosition_;
+  }
+
+  /// Returns the memory used by 'this' in bytes.
+  uint64_t memoryBytes() const;
+
+ private:
+  static constexpr int32_t kChunkBits = 16;
+  static constexpr int64_t kChunkSize = 1L << kChunkBits;
+  // An array chunk with more offsets than this is larger than a bitmap chunk
+  // and is converted to one.
+  static constexpr int32_t kMaxArraySize = kChunkSize / 16;
+
+  struct Chunk {
+    // Position of the first row of the chunk divided by kChunkSize.
+    int64_t key;
+    // Sorted offsets from the first row of the chunk. Empty if 'bits' is set.
+    std::vector<uint16_t> offsets;
+    // Bitmap of kChunkSize bits if the chunk has more than kMaxArraySize
+    // positions.
+    std::vector<uint64_t> bits;
+  };
+
+  // Chunks in ascending order of key.
+  std::vector<Chunk> chunks_;
+  int64_t size_{0};
+  int64_t maxPosition_{-1};
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
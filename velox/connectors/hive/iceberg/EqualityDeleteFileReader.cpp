@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
+
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/HiveConnectorUtil.h"
+#include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+EqualityDeleteFileReader::EqualityDeleteFileReader(
+    const IcebergDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    const ConnectorQueryCtx* connectorQueryCtx,
+    folly::Executor* executor,
+    const std::shared_ptr<const HiveConfig>& hiveConfig,
+    const std::shared_ptr<io::IoStatistics>& ioStats,
+    const std::string& connectorId)
+    : pool_(connectorQueryCtx->memoryPool()),
+      hashes_(memory::StlAllocator<uint64_t>(*pool_)),
+      table_(memory::StlAllocator<vector_size_t>(*pool_)) {
+  VELOX_CHECK(deleteFile.content == FileContent::kEqualityDeletes);
+  auto deleteSplit = std::make_shared<HiveConnectorSplit>(
+      connectorId,
+      deleteFile.filePath,
+      deleteFile.fileFormat,
+      0,
+      deleteFile.fileSizeInBytes);
+
+  dwio::common::ReaderOptions deleteReaderOpts(pool_);
+  configureReaderOptions(
+      deleteReaderOpts,
+      hiveConfig,
+      connectorQueryCtx->sessionProperties(),
+      RowTypePtr{},
+      deleteSplit);
+  const FileProperties deleteFileProperties{
+      static_cast<int64_t>(deleteFile.fileSizeInBytes)};
+  auto deleteFileHandle = fileHandleFactory->generate(
+      deleteFile.filePath, &deleteFileProperties);
+  auto deleteFileInput = createBufferedInput(
+      *deleteFileHandle,
+      deleteReaderOpts,
+      connectorQueryCtx,
+      ioStats,
+      executor);
+  auto deleteReader =
+      dwio::common::getReaderFactory(deleteReaderOpts.fileFormat())
+          ->createReader(std::move(deleteFileInput), deleteReaderOpts);
+
+  keyType_ = deleteReader->rowType();
+  auto scanSpec = std::make_shared<common::ScanSpec>("<root>");
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    keys_.push_back(BaseVector::create(keyType_->childAt(i), 0, pool_));
+    scanSpec->addField(keyType_->nameOf(i), i);
+  }
+
+  dwio::common::RowReaderOptions deleteRowReaderOpts;
+  configureRowReaderOptions(
+      deleteRowReaderOpts, {}, scanSpec, nullptr, keyType_, deleteSplit);
+  auto deleteRowReader = deleteReader->createRowReader(deleteRowReaderOpts);
+
+  constexpr uint64_t kBatchSize = 10'000;
+  VectorPtr batch = BaseVector::create(keyType_, 0, pool_);
+  try {
+    while (deleteRowReader->next(kBatchSize, batch) > 0) {
+      if (batch->size() > 0) {
+        addKeys(*batch->as<RowVector>());
+      }
+    }
+    buildTable();
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kMemCapExceeded.c_str()) {
+      throw;
+    }
+    VELOX_MEM_POOL_CAP_EXCEEDED(fmt::format(
+        "Equality delete file {} with {} rows does not fit in query memory: {}",
+        deleteFile.filePath,
+        deleteFile.recordCount,
+        e.message()));
+  }
+}
+
+void EqualityDeleteFileReader::setBaseRowType(const RowTypePtr& baseRowType) {
+  baseChannels_.clear();
+  for (auto i = 0; i < keyType_->size(); ++i) {
+    const auto& name = keyType_->nameOf(i);
+    const auto channel = baseRowType->getChildIdxIfExists(name);
+    VELOX_CHECK(
+        channel.has_value(),
+        "Equality delete column {} is not read from the base file",
+        name);
+    VELOX_USER_CHECK(
+        baseRowType->childAt(*channel)->equivalent(*keyType_->childAt(i)),
+        "Equality delete column {} has type {} in the delete file and {} in "
+        "the base file",
+        name,
+        keyType_->childAt(i)->toString(),
+        baseRowType->childAt(*channel)->toString());
+    baseChannels_.push_back(*channel);
+  }
+}
+
+uint64_t EqualityDeleteFileReader::hashKey(
+    const std::vector<const BaseVector*>& columns,
+    vector_size_t row) const {
+  uint64_t hash = columns[0]->hashValueAt(row);
+  for (auto i = 1; i < columns.size(); ++i) {
+    hash = bits::hashMix(hash, columns[i]->hashValueAt(row));
+  }
+  return hash;
+}
+
+void EqualityDeleteFileReader::addKeys(const RowVector& batch) {
+  const auto numRows = batch.size();
+  for (auto i = 0; i < keys_.size(); ++i) {
+    keys_[i]->resize(numKeys_ + numRows);
+    keys_[i]->copy(batch.childAt(i)->loadedVector(), numKeys_, 0, numRows);
+  }
+  std::vector<const BaseVector*> columns;
+  for (const auto& key : keys_) {
+    columns.push_back(key.get());
+  }
+  hashes_.reserve(numKeys_ + numRows);
+  for (auto row = numKeys_; row < numKeys_ + numRows; ++row) {
+    hashes_.push_back(hashKey(columns, row));
+  }
+  numKeys_ += numRows;
+}
+
+void EqualityDeleteFileReader::buildTable() {
+  if (numKeys_ == 0) {
+    return;
+  }
+  // At most half full.
+  table_.resize(bits::nextPowerOfTwo(2 * numKeys_), kEmpty);
+  const auto mask = table_.size() - 1;
+  for (auto row = 0; row < numKeys_; ++row) {
+    auto slot = hashes_[row] & mask;
+    while (table_[slot] != kEmpty) {
+      slot = (slot + 1) & mask;
+    }
+    table_[slot] = row;
+  }
+}
+
+void EqualityDeleteFileReader::removeDeletedRows(
+    const RowVector& input,
+    SelectivityVector& rows) {
+  if (numKeys_ == 0) {
+    return;
+  }
+  VELOX_CHECK_EQ(baseChannels_.size(), keys_.size());
+  std::vector<const BaseVector*> columns;
+  for (auto channel : baseChannels_) {
+    columns.push_back(input.childAt(channel)->loadedVector());
+  }
+  const auto mask = table_.size() - 1;
+  rows.applyToSelected([&](auto row) {
+    const auto hash = hashKey(columns, row);
+    for (auto slot = hash & mask; table_[slot] != kEmpty;
+         slot = (slot + 1) & mask) {
+      const auto keyRow = table_[slot];
+      if (hashes_[keyRow] != hash) {
+        continue;
+      }
+      bool equal = true;
+      for (auto i = 0; i < columns.size() && equal; ++i) {
+        equal = columns[i]->equalValueAt(keys_[i].get(), row, keyRow);
+      }
+      if (equal) {
+        rows.setValid(row, false);
+        break;
+      }
+    }
+  });
+  rows.updateBounds();
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include "velox/common/memory/MemoryPool.h"
+#include "velox/connectors/Connector.h"
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConfig.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+struct IcebergDeleteFile;
+
+/// Applies an Iceberg equality delete file to the rows of a base file. A row
+/// is deleted if its values in the columns of the delete file are equal to
+/// those of a row of the delete file, with null equal to null. The delete
+/// file is read once on construction into key vectors and a hash table over
+/// them, both allocated from the query's memory pool. Delete columns are
+/// matched to the columns of the base file by name.
+class EqualityDeleteFileReader {
+ public:
+  /// Reads the delete file. Throws a memory cap exceeded error naming the
+  /// delete file if its keys do not fit in the query's memory.
+  EqualityDeleteFileReader(
+      const IcebergDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      const ConnectorQueryCtx* connectorQueryCtx,
+      folly::Executor* executor,
+      const std::shared_ptr<const HiveConfig>& hiveConfig,
+      const std::shared_ptr<io::IoStatistics>& ioStats,
+      const std::string& connectorId);
+
+  /// Returns the columns of the delete file.
+  const RowTypePtr& keyType() const {
+    return keyType_;
+  }
+
+  /// Sets the type of the batches passed to removeDeletedRows(). This must
+  /// contain all the columns of keyType().
+  void setBaseRowType(const RowTypePtr& baseRowType);
+
+  /// Deselects the rows of 'rows' in 'input' that match a delete key.
+  void removeDeletedRows(const RowVector& input, SelectivityVector& rows);
+
+  /// Returns the number of rows in the delete file.
+  vector_size_t numDeleteKeys() const {
+    return numKeys_;
+  }
+
+ private:
+  uint64_t hashKey(
+      const std::vector<const BaseVector*>& columns,
+      vector_size_t row) const;
+
+  // Adds the rows of 'batch' to 'keys_' and 'hashes_'.
+  void addKeys(const RowVector& batch);
+
+  // Fills 'table_' with the rows of 'keys_'.
+  void buildTable();
+
+  static constexpr vector_size_t kEmpty = -1;
+
+  memory::MemoryPool* const pool_;
+
+  RowTypePtr keyType_;
+
+  // Index of each delete column in the base batches.
+  std::vector<column_index_t> baseChannels_;
+
+  // Values of the delete file, one vector per delete column.
+  std::vector<VectorPtr> keys_;
+
+  vector_size_t numKeys_{0};
+
+  // Hash of each row of 'keys_'.
+  std::vector<uint64_t, memory::StlAllocator<uint64_t>> hashes_;
+
+  // Open addressing table of rows of 'keys_' with linear probing. The size is
+  // a power of two and empty slots are kEmpty.
+  std::vector<vector_size_t, memory::StlAllocator<vector_size_t>> table_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
@@ -50,26 +50,51 @@ IcebergSplitReader::IcebergSplitReader(
       baseReadOffset_(0),
       splitOffset_(0) {}
 
+IcebergSplitReader::~IcebergSplitReader() {
+  // The row reader refers to the children of 'scanSpec_' being restored.
+  baseRowReader_.reset();
+  restoreScanSpec();
+}
+
 void IcebergSplitReader::prepareSplit(
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats,
     const std::shared_ptr<HiveColumnHandle>& rowIndexColumn) {
   createReader();
 
+  positionalDeleteFileReaders_.clear();
+  equalityDeleteFileReaders_.clear();
   if (checkIfSplitIsEmpty(runtimeStats)) {
     VELOX_CHECK(emptySplit_);
     return;
   }
 
-  createRowReader(metadataFilter, rowIndexColumn);
-
   std::shared_ptr<const HiveIcebergSplit> icebergSplit =
       std::dynamic_pointer_cast<const HiveIcebergSplit>(hiveSplit_);
+  const auto& deleteFiles = icebergSplit->deleteFiles;
+  // The equality delete files are read first since their columns must be read
+  // from the base file.
+  for (const auto& deleteFile : deleteFiles) {
+    if (deleteFile.content == FileContent::kEqualityDeletes &&
+        deleteFile.recordCount > 0) {
+      equalityDeleteFileReaders_.push_back(
+          std::make_unique<EqualityDeleteFileReader>(
+              deleteFile,
+              fileHandleFactory_,
+              connectorQueryCtx_,
+              executor_,
+              hiveConfig_,
+              ioStats_,
+              hiveSplit_->connectorId));
+    }
+  }
+  addEqualityDeleteColumns();
+
+  createRowReader(metadataFilter, rowIndexColumn);
+
   baseReadOffset_ = 0;
   splitOffset_ = baseRowReader_->nextRowNumber();
-  positionalDeleteFileReaders_.clear();
 
-  const auto& deleteFiles = icebergSplit->deleteFiles;
   for (const auto& deleteFile : deleteFiles) {
     if (deleteFile.content == FileContent::kPositionalDeletes) {
       if (deleteFile.recordCount > 0) {
@@ -86,12 +111,60 @@ void IcebergSplitReader::prepareSplit(
                 splitOffset_,
                 hiveSplit_->connectorId));
       }
-    } else {
+    } else if (deleteFile.content != FileContent::kEqualityDeletes) {
       VELOX_NYI();
     }
   }
 }
 
+void IcebergSplitReader::addEqualityDeleteColumns() {
+  restoreScanSpec();
+  if (equalityDeleteFileReaders_.empty()) {
+    baseReadType_ = readerOutputType_;
+    return;
+  }
+  auto names = readerOutputType_->names();
+  auto types = readerOutputType_->children();
+  const auto& fileType = baseReader_->rowType();
+  for (auto& reader : equalityDeleteFileReaders_) {
+    const auto& keyType = reader->keyType();
+    for (auto i = 0; i < keyType->size(); ++i) {
+      const auto& name = keyType->nameOf(i);
+      if (std::find(names.begin(), names.end(), name) != names.end()) {
+        continue;
+      }
+      // A filter only column has a spec that is not projected out.
+      if (auto* spec = scanSpec_->childByName(name)) {
+        savedColumnSpecs_.push_back(
+            {name, spec->projectOut(), spec->channel()});
+      } else {
+        savedColumnSpecs_.push_back(
+            {name, false, common::ScanSpec::kNoChannel});
+      }
+      scanSpec_->addField(name, names.size());
+      names.push_back(name);
+      const auto fileIdx = fileType->getChildIdxIfExists(name);
+      types.push_back(
+          fileIdx.has_value() ? fileType->childAt(*fileIdx)
+                              : keyType->childAt(i));
+    }
+  }
+  baseReadType_ = ROW(std::move(names), std::move(types));
+  for (auto& reader : equalityDeleteFileReaders_) {
+    reader->setBaseRowType(baseReadType_);
+  }
+}
+
+void IcebergSplitReader::restoreScanSpec() {
+  for (const auto& saved : savedColumnSpecs_) {
+    auto* spec = scanSpec_->childByName(saved.name);
+    VELOX_CHECK_NOT_NULL(spec);
+    spec->setProjectOut(saved.projectOut);
+    spec->setChannel(saved.channel);
+  }
+  savedColumnSpecs_.clear();
+}
+
 uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
   Mutation mutation;
   mutation.randomSkip = baseReaderOpts_.randomSkip().get();
@@ -118,9 +191,52 @@ uint64_t IcebergSplitReader::next(uint64_t size, VectorPtr& output) {
     mutation.deletedRows = deleteBitmap_->as<uint64_t>();
   }
 
-  auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+  if (equalityDeleteFileReaders_.empty()) {
+    auto rowsScanned = baseRowReader_->next(size, output, &mutation);
+    baseReadOffset_ += rowsScanned;
+    return rowsScanned;
+  }
+
+  // 'output' has the type of 'readerOutputType_' and is replaced by a batch of
+  // the rows that are not deleted, so the base reader reads into a vector
+  // owned by 'this'.
+  auto* pool = connectorQueryCtx_->memoryPool();
+  if (!readerOutput_) {
+    readerOutput_ = BaseVector::create(baseReadType_, 0, pool);
+  }
+  auto rowsScanned = baseRowReader_->next(size, readerOutput_, &mutation);
   baseReadOffset_ += rowsScanned;
+  const auto& input = *readerOutput_->asUnchecked<RowVector>();
+  const auto numOutputColumns = readerOutputType_->size();
+  std::vector<VectorPtr> children(
+      input.children().begin(), input.children().begin() + numOutputColumns);
+  if (rowsScanned == 0 || input.size() == 0) {
+    output = std::make_shared<RowVector>(
+        pool, readerOutputType_, nullptr, input.size(), std::move(children));
+    return rowsScanned;
+  }
 
+  remainingRows_.resizeFill(input.size(), true);
+  for (auto& reader : equalityDeleteFileReaders_) {
+    reader->removeDeletedRows(input, remainingRows_);
+  }
+  const auto numRemaining = remainingRows_.countSelected();
+  if (numRemaining == input.size()) {
+    output = std::make_shared<RowVector>(
+        pool, readerOutputType_, nullptr, input.size(), std::move(children));
+    return rowsScanned;
+  }
+
+  auto indices = allocateIndices(numRemaining, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t numIndices = 0;
+  remainingRows_.applyToSelected(
+      [&](auto row) { rawIndices[numIndices++] = row; });
+  for (auto& child : children) {
+    child = BaseVector::wrapInDictionary(nullptr, indices, numRemaining, child);
+  }
+  output = std::make_shared<RowVector>(
+      pool, readerOutputType_, nullptr, numRemaining, std::move(children));
   return rowsScanned;
 }
 
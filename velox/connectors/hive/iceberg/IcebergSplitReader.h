@@ -18,6 +18,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/SplitReader.h"
+#include "velox/connectors/hive/iceberg/EqualityDeleteFileReader.h"
 #include "velox/connectors/hive/iceberg/PositionalDeleteFileReader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -39,7 +40,7 @@ class IcebergSplitReader : public SplitReader {
       folly::Executor* executor,
       const std::shared_ptr<common::ScanSpec>& scanSpec);
 
-  ~IcebergSplitReader() override = default;
+  ~IcebergSplitReader() override;
 
   void prepareSplit(
       std::shared_ptr<common::MetadataFilter> metadataFilter,
@@ -49,6 +50,22 @@ class IcebergSplitReader : public SplitReader {
   uint64_t next(uint64_t size, VectorPtr& output) override;
 
  private:
+  // State of a child of 'scanSpec_' before it was projected to read an
+  // equality delete column.
+  struct SavedColumnSpec {
+    std::string name;
+    bool projectOut;
+    column_index_t channel;
+  };
+
+  // Projects the equality delete columns that are not in 'readerOutputType_'
+  // into channels after it in 'scanSpec_' and sets 'baseReadType_'.
+  void addEqualityDeleteColumns();
+
+  // Undoes addEqualityDeleteColumns(). 'scanSpec_' is shared with the
+  // readers of later splits.
+  void restoreScanSpec();
+
   // The read offset to the beginning of the split in number of rows for the
   // current batch for the base data file
   uint64_t baseReadOffset_;
@@ -59,5 +76,21 @@ class IcebergSplitReader : public SplitReader {
   std::list<std::unique_ptr<PositionalDeleteFileReader>>
       positionalDeleteFileReaders_;
   BufferPtr deleteBitmap_;
+
+  std::list<std::unique_ptr<EqualityDeleteFileReader>>
+      equalityDeleteFileReaders_;
+
+  // 'readerOutputType_' followed by the equality delete columns that are not
+  // in it. These are dropped from the batches returned by next().
+  RowTypePtr baseReadType_;
+
+  std::vector<SavedColumnSpec> savedColumnSpecs_;
+
+  // Batch of 'baseReadType_' read from the base file when there are
+  // equality deletes.
+  VectorPtr readerOutput_;
+
+  // Rows of 'readerOutput_' that are not deleted by equality deletes.
+  SelectivityVector remainingRows_;
 };
 } // namespace facebook::velox::connector::hive::iceberg
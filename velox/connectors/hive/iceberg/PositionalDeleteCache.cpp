@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+std::unique_ptr<PositionalDeleteCache> PositionalDeleteCache::instance_ =
+    nullptr;
+
+// static
+std::string PositionalDeleteCache::makeKey(
+    const std::string& deleteFilePath,
+    uint64_t deleteFileSize,
+    const std::string& baseFilePath) {
+  return fmt::format("{}:{}:{}", deleteFilePath, deleteFileSize, baseFilePath);
+}
+
+std::shared_ptr<const DeleteBitmap> PositionalDeleteCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* value = cache_.get(key);
+  if (value == nullptr) {
+    return nullptr;
+  }
+  auto deletes = *value;
+  cache_.release(key);
+  return deletes;
+}
+
+bool PositionalDeleteCache::insert(
+    const std::string& key,
+    std::shared_ptr<const DeleteBitmap> deletes) {
+  VELOX_CHECK_NOT_NULL(deletes);
+  const auto bytes = key.size() + deletes->memoryBytes();
+  auto value = std::make_unique<std::shared_ptr<const DeleteBitmap>>(
+      std::move(deletes));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!cache_.add(key, value.get(), bytes)) {
+    return false;
+  }
+  value.release();
+  return true;
+}
+
+SimpleLRUCacheStats PositionalDeleteCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+void PositionalDeleteCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+}
+
+} // namespace facebook::velox::connector::hive::iceberg
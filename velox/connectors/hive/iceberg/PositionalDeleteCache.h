@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/connectors/hive/iceberg/DeleteBitmap.h"
+
+namespace facebook::velox::connector::hive::iceberg {
+
+/// A process-wide cache of the deleted positions of base files read from
+/// Iceberg positional delete files. Every split of a base file otherwise
+/// reads and parses the delete files of the base file again, and so does
+/// every query of the table. Entries are keyed by delete file path and size
+/// and base file path. Delete files are immutable, so entries do not go stale.
+/// Thread safe.
+class PositionalDeleteCache {
+ public:
+  /// Creates the singleton instance with a capacity of 'maxBytes' if it does
+  /// not exist and returns it.
+  static PositionalDeleteCache* create(uint64_t maxBytes) {
+    if (instance_ == nullptr) {
+      instance_ = std::unique_ptr<PositionalDeleteCache>(
+          new PositionalDeleteCache(maxBytes));
+    }
+    return instance_.get();
+  }
+
+  /// Returns the process-wide instance or nullptr if it has not been created.
+  static PositionalDeleteCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  static std::string makeKey(
+      const std::string& deleteFilePath,
+      uint64_t deleteFileSize,
+      const std::string& baseFilePath);
+
+  /// Returns the positions for 'key' or nullptr if not cached.
+  std::shared_ptr<const DeleteBitmap> find(const std::string& key);
+
+  /// Adds 'deletes' for 'key'. Returns false if 'key' is already cached or
+  /// 'deletes' does not fit.
+  bool insert(
+      const std::string& key,
+      std::shared_ptr<const DeleteBitmap> deletes);
+
+  SimpleLRUCacheStats stats() const;
+
+  void clear();
+
+ private:
+  static std::unique_ptr<PositionalDeleteCache> instance_;
+
+  explicit PositionalDeleteCache(uint64_t maxBytes) : cache_(maxBytes) {}
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const DeleteBitmap>> cache_;
+};
+
+} // namespace facebook::velox::connector::hive::iceberg
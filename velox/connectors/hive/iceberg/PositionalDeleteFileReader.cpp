@@ -20,6 +20,7 @@
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 #include "velox/dwio/common/ReaderFactory.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -56,6 +57,15 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     return;
   }
 
+  if (auto* cache = PositionalDeleteCache::getInstance()) {
+    cacheKey_ = PositionalDeleteCache::makeKey(
+        deleteFile_.filePath, deleteFile_.fileSizeInBytes, baseFilePath_);
+    cachedDeletes_ = cache->find(cacheKey_);
+    if (cachedDeletes_ != nullptr) {
+      return;
+    }
+  }
+
   // TODO: check if the lowerbounds and upperbounds in deleteFile overlap with
   //  this batch. If not, no need to proceed.
 
@@ -92,8 +102,11 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
       deleteFileSchema,
       deleteSplit_);
 
-  auto deleteFileHandleCachePtr =
-      fileHandleFactory_->generate(deleteFile_.filePath);
+  // The size from the manifest saves a metadata lookup on remote storage.
+  const FileProperties deleteFileProperties{
+      static_cast<int64_t>(deleteFile_.fileSizeInBytes)};
+  auto deleteFileHandleCachePtr = fileHandleFactory_->generate(
+      deleteFile_.filePath, &deleteFileProperties);
   auto deleteFileInput = createBufferedInput(
       *deleteFileHandleCachePtr,
       deleteReaderOpts,
@@ -118,6 +131,10 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
     ++runtimeStats.skippedSplits;
     runtimeStats.skippedSplitBytes += deleteSplit_->length;
     deleteSplit_.reset();
+    if (!cacheKey_.empty()) {
+      cachedDeletes_ = std::make_shared<DeleteBitmap>();
+      PositionalDeleteCache::getInstance()->insert(cacheKey_, cachedDeletes_);
+    }
     return;
   }
 
@@ -132,6 +149,37 @@ PositionalDeleteFileReader::PositionalDeleteFileReader(
 
   deleteRowReader_.reset();
   deleteRowReader_ = deleteReader->createRowReader(deleteRowReaderOpts);
+  if (!cacheKey_.empty()) {
+    loadCachedDeletes();
+  }
+}
+
+void PositionalDeleteFileReader::loadCachedDeletes() {
+  constexpr uint64_t kBatchSize = 10'000;
+  auto deletes = std::make_shared<DeleteBitmap>();
+  VectorPtr output =
+      BaseVector::create(ROW({posColumn_->name}, {posColumn_->type}), 0, pool_);
+  while (deleteRowReader_->next(kBatchSize, output) > 0) {
+    if (output->size() == 0) {
+      continue;
+    }
+    VELOX_CHECK(
+        !output->mayHaveNulls(),
+        "Iceberg delete file pos column cannot have nulls");
+    output->loadedVector();
+    const auto* positions = std::dynamic_pointer_cast<RowVector>(output)
+                                ->childAt(0)
+                                ->as<FlatVector<int64_t>>()
+                                ->rawValues();
+    for (auto i = 0; i < output->size(); ++i) {
+      deletes->add(positions[i]);
+    }
+  }
+  deletes->finish();
+  PositionalDeleteCache::getInstance()->insert(cacheKey_, deletes);
+  cachedDeletes_ = std::move(deletes);
+  deleteRowReader_.reset();
+  deleteSplit_.reset();
 }
 
 void PositionalDeleteFileReader::readDeletePositions(
@@ -143,6 +191,15 @@ void PositionalDeleteFileReader::readDeletePositions(
   // file
   int64_t rowNumberUpperBound = splitOffset_ + baseReadOffset + size;
 
+  if (cachedDeletes_ != nullptr) {
+    cachedDeletes_->apply(
+        splitOffset_ + baseReadOffset,
+        rowNumberUpperBound,
+        reinterpret_cast<uint64_t*>(deleteBitmap));
+    endOfFile_ = rowNumberUpperBound > cachedDeletes_->maxPosition();
+    return;
+  }
+
   // Finish unused delete positions from last batch
   if (deletePositionsOutput_ &&
       deletePositionsOffset_ < deletePositionsOutput_->size()) {
@@ -23,6 +23,7 @@
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/iceberg/DeleteBitmap.h"
 #include "velox/dwio/common/Reader.h"
 
 namespace facebook::velox::connector::hive::iceberg {
@@ -63,6 +64,10 @@ class PositionalDeleteFileReader {
 
   bool readFinishedForBatch(int64_t rowNumberUpperBound);
 
+  // Reads all positions for the base file into 'cachedDeletes_' and adds
+  // them to the PositionalDeleteCache.
+  void loadCachedDeletes();
+
   const IcebergDeleteFile& deleteFile_;
   const std::string& baseFilePath_;
   FileHandleFactory* const fileHandleFactory_;
@@ -80,6 +85,12 @@ class PositionalDeleteFileReader {
   VectorPtr deletePositionsOutput_;
   uint64_t deletePositionsOffset_;
   bool endOfFile_;
+
+  // Key in the PositionalDeleteCache. Empty if the cache is disabled.
+  std::string cacheKey_;
+
+  // All positions for the base file if the cache is enabled.
+  std::shared_ptr<const DeleteBitmap> cachedDeletes_;
 };
 
 } // namespace facebook::velox::connector::hive::iceberg
@@ -14,15 +14,18 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/iceberg/IcebergDeleteFile.h"
 #include "velox/connectors/hive/iceberg/IcebergMetadataColumns.h"
 #include "velox/connectors/hive/iceberg/IcebergSplit.h"
+#include "velox/connectors/hive/iceberg/PositionalDeleteCache.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
+#include <folly/ScopeGuard.h>
 #include <folly/Singleton.h>
 
 using namespace facebook::velox::exec::test;
@@ -94,7 +97,7 @@ class HiveIcebergTest : public HiveConnectorTestBase {
 
   const static int rowCount = 20000;
 
- private:
+ protected:
   void assertPositionalDeletesInternal(
       const std::vector<std::vector<int64_t>>& deleteRowsVec,
       std::string duckdbSql,
@@ -347,4 +350,144 @@ TEST_F(HiveIcebergTest, positionalDeletesMultipleSplits) {
       deletedRows, getQuery(deletedRows), splitCount, numPrefetchSplits);
 }
 
+TEST_F(HiveIcebergTest, deleteBitmap) {
+  DeleteBitmap deletes;
+  ASSERT_EQ(deletes.maxPosition(), -1);
+  // A sparse chunk, a dense chunk and a sparse chunk after a gap.
+  std::vector<int64_t> positions = {1, 1, 70, 65'535};
+  for (int64_t i = 65'536; i < 131'072; i += 3) {
+    positions.push_back(i);
+  }
+  positions.push_back(1'000'000);
+  for (auto position : positions) {
+    deletes.add(position);
+  }
+  deletes.finish();
+  ASSERT_EQ(deletes.size(), positions.size() - 1);
+  ASSERT_EQ(deletes.maxPosition(), 1'000'000);
+  ASSERT_LT(deletes.memoryBytes(), 16 << 10);
+  VELOX_ASSERT_THROW(deletes.add(5), "ascending order");
+
+  // Apply windows that start and end inside and across chunks.
+  const std::vector<std::pair<int64_t, int64_t>> windows = {
+      {0, 100}, {60'000, 70'000}, {65'537, 65'600}, {100'000, 1'000'001}};
+  for (auto [begin, end] : windows) {
+    std::vector<uint64_t> bits(bits::nwords(end - begin));
+    deletes.apply(begin, end, bits.data());
+    for (auto row = begin; row < end; ++row) {
+      const bool expected =
+          std::binary_search(positions.begin(), positions.end(), row);
+      ASSERT_EQ(bits::isBitSet(bits.data(), row - begin), expected) << row;
+    }
+  }
+}
+
+TEST_F(HiveIcebergTest, positionalDeleteCache) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto* cache = PositionalDeleteCache::create(1 << 20);
+  SCOPE_EXIT {
+    PositionalDeleteCache::testingClear();
+  };
+
+  // The cached positions give the same results.
+  assertPositionalDeletes({{0, 9999, 10000, 19999}});
+  assertPositionalDeletes({makeRandomDeleteRows(rowCount)}, true);
+  assertPositionalDeletes({{1}, {2}, {3}, {4}});
+
+  // Scans of the same base and delete files share the positions.
+  auto dataFilePaths = writeDataFile(1, rowCount);
+  const auto& dataFilePath = dataFilePaths[0]->getPath();
+  std::vector<int64_t> deleteRows = {5, 10, 15};
+  auto deleteFilePath =
+      writePositionDeleteFile(dataFilePath, deleteRows, 100, 100);
+  const auto& path = deleteFilePath->getPath();
+  IcebergDeleteFile deleteFile(
+      FileContent::kPositionalDeletes,
+      path,
+      fileFomat_,
+      deleteRows.size() + 200,
+      testing::internal::GetFileSize(std::fopen(path.c_str(), "r")));
+  const auto numHits = cache->stats().numHits;
+  for (auto i = 0; i < 2; ++i) {
+    HiveConnectorTestBase::assertQuery(
+        tableScanNode(),
+        {makeIcebergSplit(dataFilePath, {deleteFile})},
+        "SELECT * FROM tmp WHERE c0 NOT IN (5, 10, 15)");
+  }
+  ASSERT_EQ(cache->stats().numHits, numHits + 1);
+}
+
+TEST_F(HiveIcebergTest, equalityDeletes) {
+  folly::SingletonVault::singleton()->registrationComplete();
+  auto dataFilePaths = writeDataFile(1, rowCount);
+  const auto& dataFilePath = dataFilePaths[0]->getPath();
+
+  auto makeDeleteFile = [&](const std::vector<int64_t>& values,
+                            std::shared_ptr<TempFilePath>& filePath) {
+    filePath = TempFilePath::create();
+    writeToFile(
+        filePath->getPath(),
+        makeRowVector({"c0"}, {vectorMaker_.flatVector<int64_t>(values)}));
+    const auto& path = filePath->getPath();
+    return IcebergDeleteFile(
+        FileContent::kEqualityDeletes,
+        path,
+        fileFomat_,
+        values.size(),
+        testing::internal::GetFileSize(std::fopen(path.c_str(), "r")),
+        {1});
+  };
+
+  // Values that are not in the base file do not delete anything.
+  std::shared_ptr<TempFilePath> firstPath;
+  std::shared_ptr<TempFilePath> secondPath;
+  auto first = makeDeleteFile({0, 5, 9999, 10000, 19999, 50000}, firstPath);
+  auto second = makeDeleteFile({5, 6, 7}, secondPath);
+  HiveConnectorTestBase::assertQuery(
+      tableScanNode(),
+      {makeIcebergSplit(dataFilePath, {first, second})},
+      "SELECT * FROM tmp WHERE c0 NOT IN (0, 5, 6, 7, 9999, 10000, 19999)");
+
+  // Equality and positional deletes together.
+  auto positionalPath = writePositionDeleteFile(dataFilePath, {1, 2});
+  const auto& path = positionalPath->getPath();
+  IcebergDeleteFile positional(
+      FileContent::kPositionalDeletes,
+      path,
+      fileFomat_,
+      2,
+      testing::internal::GetFileSize(std::fopen(path.c_str(), "r")));
+  HiveConnectorTestBase::assertQuery(
+      tableScanNode(),
+      {makeIcebergSplit(dataFilePath, {positional, second})},
+      "SELECT * FROM tmp WHERE c0 NOT IN (1, 2, 5, 6, 7)");
+
+  // The delete column is read from the base file when it is not projected.
+  // The second split has no deletes and must not see the extra column.
+  auto countPlan = PlanBuilder(pool_.get())
+                       .tableScan(ROW({}, {}))
+                       .singleAggregation({}, {"count(1)"})
+                       .planNode();
+  HiveConnectorTestBase::assertQuery(
+      countPlan,
+      {makeIcebergSplit(dataFilePath, {second}),
+       makeIcebergSplit(dataFilePath)},
+      "SELECT (SELECT count(*) FROM tmp WHERE c0 NOT IN (5, 6, 7)) + "
+      "(SELECT count(*) FROM tmp)");
+
+  // The delete column is only used in a filter.
+  auto filterPlan = PlanBuilder(pool_.get())
+                        .startTableScan()
+                        .outputType(ROW({}, {}))
+                        .subfieldFilter("c0 < 100")
+                        .dataColumns(rowType_)
+                        .endTableScan()
+                        .singleAggregation({}, {"count(1)"})
+                        .planNode();
+  HiveConnectorTestBase::assertQuery(
+      filterPlan,
+      {makeIcebergSplit(dataFilePath, {first, second})},
+      "SELECT count(*) FROM tmp WHERE c0 < 100 AND c0 NOT IN (0, 5, 6, 7)");
+}
+
 } // namespace facebook::velox::connector::hive::iceberg
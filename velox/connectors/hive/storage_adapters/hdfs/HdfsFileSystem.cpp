@@ -69,7 +69,7 @@ std::string HdfsFileSystem::name() const {
 
 std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     std::string_view path,
-    const FileOptions& /*unused*/) {
+    const FileOptions& options) {
   if (path.find(kScheme) == 0) {
     path.remove_prefix(kScheme.length());
   }
@@ -77,7 +77,8 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(), path, options.fileSize);
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
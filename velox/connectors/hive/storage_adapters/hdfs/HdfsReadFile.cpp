@@ -20,8 +20,16 @@
 
 namespace facebook::velox {
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    std::optional<int64_t> fileSize)
     : hdfsClient_(hdfs), filePath_(path) {
+  if (fileSize.has_value()) {
+    VELOX_CHECK_GE(fileSize.value(), 0, "File size must be non-negative");
+    fileSize_ = fileSize.value();
+    return;
+  }
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   if (fileInfo_ == nullptr) {
     auto error = hdfsGetLastError();
@@ -34,11 +42,14 @@ HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
     }
     VELOX_FAIL(errMsg);
   }
+  fileSize_ = fileInfo_->mSize;
 }
 
 HdfsReadFile::~HdfsReadFile() {
   // should call hdfsFreeFileInfo to avoid memory leak
-  hdfsFreeFileInfo(fileInfo_, 1);
+  if (fileInfo_ != nullptr) {
+    hdfsFreeFileInfo(fileInfo_, 1);
+  }
 }
 
 void HdfsReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
@@ -70,11 +81,11 @@ std::string HdfsReadFile::pread(uint64_t offset, uint64_t length) const {
 }
 
 uint64_t HdfsReadFile::size() const {
-  return fileInfo_->mSize;
+  return fileSize_;
 }
 
 uint64_t HdfsReadFile::memoryUsage() const {
-  return fileInfo_->mBlockSize;
+  return fileInfo_ != nullptr ? fileInfo_->mBlockSize : 0;
 }
 
 bool HdfsReadFile::shouldCoalesce() const {
@@ -60,7 +60,12 @@ struct HdfsFile {
  */
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  /// If 'fileSize' is given, e.g. from the listing of the file, the file info
+  /// is not looked up from the namenode.
+  HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      std::optional<int64_t> fileSize = std::nullopt);
   ~HdfsReadFile() override;
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
@@ -87,7 +92,9 @@ class HdfsReadFile final : public ReadFile {
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
   hdfsFS hdfsClient_;
-  hdfsFileInfo* fileInfo_;
+  // Null if the file size was given on construction.
+  hdfsFileInfo* fileInfo_{nullptr};
+  uint64_t fileSize_;
   std::string filePath_;
   folly::ThreadLocal<HdfsFile> file_;
 };
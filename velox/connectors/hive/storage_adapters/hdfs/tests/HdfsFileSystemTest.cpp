@@ -185,6 +185,16 @@ TEST_F(HdfsFileSystemTest, viaFileSystem) {
   readData(readFile.get());
 }
 
+TEST_F(HdfsFileSystemTest, viaFileSystemWithFileSize) {
+  auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
+  auto hdfsFileSystem =
+      filesystems::getFileSystem(fullDestinationPath, memConfig);
+  filesystems::FileOptions options;
+  options.fileSize = 15 + kOneMB;
+  auto readFile = hdfsFileSystem->openFileForRead(fullDestinationPath, options);
+  readData(readFile.get());
+}
+
 TEST_F(HdfsFileSystemTest, initializeFsWithEndpointInfoInFilePath) {
   // Without host/port configured.
   auto memConfig = std::make_shared<const core::MemConfig>();
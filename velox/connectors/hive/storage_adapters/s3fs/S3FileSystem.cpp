@@ -24,7 +24,12 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 
@@ -73,8 +78,17 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  /// If 'executor' is set, reads of at least 2 * kMinParallelReadSize bytes
+  /// are split into up to 'maxConcurrentRequests' range requests that run in
+  /// parallel on 'executor' and the calling thread.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      folly::Executor* executor = nullptr,
+      uint32_t maxConcurrentRequests = 1)
+      : client_(client),
+        executor_(executor),
+        maxConcurrentRequests_(maxConcurrentRequests) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -105,14 +119,14 @@ class S3ReadFile final : public ReadFile {
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    readRange(offset, length, static_cast<char*>(buffer));
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
     char* position = result.data();
-    preadInternal(offset, length, position);
+    readRange(offset, length, position);
     return result;
   }
 
@@ -131,7 +145,7 @@ class S3ReadFile final : public ReadFile {
     }
     // TODO: allocate from a memory pool
     std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
+    readRange(offset, length, static_cast<char*>(result.data()));
     size_t resultOffset = 0;
     for (auto range : buffers) {
       if (range.data()) {
@@ -142,6 +156,42 @@ class S3ReadFile final : public ReadFile {
     return length;
   }
 
+  // Reads all parts of the span of 'buffers' on 'executor_' without blocking
+  // the calling thread.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (executor_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    size_t length = 0;
+    for (const auto range : buffers) {
+      length += range.size();
+    }
+    auto result = std::make_shared<std::string>(length, 0);
+    auto parts = readPartsAsync(offset, length, result->data(), 0);
+    return folly::collectAll(std::move(parts))
+        .via(&folly::InlineExecutor::instance())
+        .thenValue([result, buffers, length](auto&& tries) {
+          for (auto& partTry : tries) {
+            partTry.throwUnlessValue();
+          }
+          size_t resultOffset = 0;
+          for (auto range : buffers) {
+            if (range.data()) {
+              memcpy(range.data(), result->data() + resultOffset, range.size());
+            }
+            resultOffset += range.size();
+          }
+          return static_cast<uint64_t>(length);
+        })
+        .semi();
+  }
+
+  bool hasPreadvAsync() const override {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -165,6 +215,64 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
+  // Minimum size of a range request of a parallel read.
+  static constexpr uint64_t kMinParallelReadSize = 8 << 20;
+
+  // Reads 'length' bytes at 'offset' into 'position'. Large reads are split
+  // into equal parts. All parts but the first are read on 'executor_' while
+  // the calling thread reads the first.
+  void readRange(uint64_t offset, uint64_t length, char* position) const {
+    const auto size = partSize(length);
+    if (executor_ == nullptr || size >= length) {
+      preadInternal(offset, length, position);
+      return;
+    }
+    auto futures = readPartsAsync(offset, length, position, size);
+    // The parts write into 'position', so wait for all of them before
+    // reporting an error.
+    std::exception_ptr error;
+    try {
+      preadInternal(offset, size, position);
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+    auto results = folly::collectAll(std::move(futures)).get();
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+    for (auto& result : results) {
+      result.throwUnlessValue();
+    }
+  }
+
+  // Returns the size of the parts a read of 'length' bytes is split into.
+  uint64_t partSize(uint64_t length) const {
+    const uint64_t numParts = std::max<uint64_t>(
+        1,
+        std::min<uint64_t>(
+            maxConcurrentRequests_, length / kMinParallelReadSize));
+    return (length + numParts - 1) / numParts;
+  }
+
+  // Reads the parts of 'length' bytes at 'offset' into 'position' on
+  // 'executor_', starting with the part at 'begin'.
+  std::vector<folly::Future<folly::Unit>> readPartsAsync(
+      uint64_t offset,
+      uint64_t length,
+      char* position,
+      uint64_t begin) const {
+    const auto size = partSize(length);
+    std::vector<folly::Future<folly::Unit>> futures;
+    for (; begin < length; begin += size) {
+      const auto partLength = std::min(size, length - begin);
+      futures.push_back(
+          folly::via(executor_, [this, offset, begin, partLength, position]() {
+            preadInternal(offset + begin, partLength, position + begin);
+          }));
+    }
+    return futures;
+  }
+
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
@@ -184,6 +292,8 @@ class S3ReadFile final : public ReadFile {
   }
 
   Aws::S3::S3Client* client_;
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentRequests_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -221,8 +331,13 @@ class S3WriteFile::Impl {
   explicit Impl(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool)
-      : client_(client), pool_(pool) {
+      memory::MemoryPool* pool,
+      folly::Executor* executor,
+      uint32_t maxConcurrentUploads)
+      : client_(client),
+        pool_(pool),
+        executor_(executor),
+        maxConcurrentUploads_(std::max<uint32_t>(1, maxConcurrentUploads)) {
     VELOX_CHECK_NOT_NULL(client);
     VELOX_CHECK_NOT_NULL(pool);
     getBucketAndKeyFromS3Path(path, bucket_, key_);
@@ -272,6 +387,13 @@ class S3WriteFile::Impl {
     fileSize_ = 0;
   }
 
+  ~Impl() {
+    // The pending uploads reference 'this' and their buffers.
+    for (auto& upload : pendingUploads_) {
+      upload.completedPart.wait();
+    }
+  }
+
   // Appends data to the end of the file.
   void append(std::string_view data) {
     VELOX_CHECK(!closed(), "File is closed");
@@ -297,7 +419,9 @@ class S3WriteFile::Impl {
     if (closed()) {
       return;
     }
+    waitForUploads(0);
     uploadPart({currentPart_->data(), currentPart_->size()}, true);
+    freeBuffers_.clear();
     VELOX_CHECK_EQ(uploadState_.partNumber, uploadState_.completedParts.size());
     // Complete the multipart upload.
     {
@@ -334,6 +458,12 @@ class S3WriteFile::Impl {
     return (currentPart_->capacity() == 0);
   }
 
+  // A part being uploaded on 'executor_'.
+  struct PendingUpload {
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+    folly::Future<Aws::S3::Model::CompletedPart> completedPart;
+  };
+
   // Holds state for the multipart upload.
   struct UploadState {
     Aws::Vector<Aws::S3::Model::CompletedPart> completedParts;
@@ -351,11 +481,17 @@ class S3WriteFile::Impl {
     // Fill-up the remaining currentPart_.
     auto remainingBufferSize = currentPart_->capacity() - currentPart_->size();
     currentPart_->unsafeAppend(dataPtr, remainingBufferSize);
-    uploadPart({currentPart_->data(), currentPart_->size()});
+    uploadCurrentPart();
     dataPtr += remainingBufferSize;
     dataSize -= remainingBufferSize;
     while (dataSize > kPartUploadSize) {
-      uploadPart({dataPtr, kPartUploadSize});
+      if (executor_ == nullptr) {
+        uploadPart({dataPtr, kPartUploadSize});
+      } else {
+        // 'data' is not owned by 'this', so copy it for the background upload.
+        currentPart_->unsafeAppend(0, dataPtr, kPartUploadSize);
+        uploadCurrentPart();
+      }
       dataPtr += kPartUploadSize;
       dataSize -= kPartUploadSize;
     }
@@ -363,35 +499,84 @@ class S3WriteFile::Impl {
     currentPart_->unsafeAppend(0, dataPtr, dataSize);
   }
 
+  // Uploads the full 'currentPart_'. With an executor, the upload runs in the
+  // background and 'currentPart_' is replaced by a free buffer. Waits for the
+  // oldest upload if 'maxConcurrentUploads_' uploads are pending.
+  void uploadCurrentPart() {
+    if (executor_ == nullptr) {
+      uploadPart({currentPart_->data(), currentPart_->size()});
+      return;
+    }
+    VELOX_CHECK_EQ(currentPart_->size(), kPartUploadSize);
+    waitForUploads(maxConcurrentUploads_ - 1);
+    const auto partNumber = ++uploadState_.partNumber;
+    const std::string_view part{currentPart_->data(), currentPart_->size()};
+    pendingUploads_.push_back(
+        {std::move(currentPart_),
+         folly::via(executor_, [this, part, partNumber]() {
+           return uploadPartRequest(part, partNumber);
+         })});
+    if (freeBuffers_.empty()) {
+      currentPart_ = std::make_unique<dwio::common::DataBuffer<char>>(*pool_);
+      currentPart_->reserve(kPartUploadSize);
+    } else {
+      currentPart_ = std::move(freeBuffers_.back());
+      freeBuffers_.pop_back();
+    }
+  }
+
+  // Waits until at most 'maxPending' uploads are pending. The buffers of the
+  // completed uploads are kept for reuse.
+  void waitForUploads(size_t maxPending) {
+    while (pendingUploads_.size() > maxPending) {
+      auto upload = std::move(pendingUploads_.front());
+      pendingUploads_.pop_front();
+      uploadState_.completedParts.push_back(
+          std::move(upload.completedPart).get());
+      upload.buffer->resize(0);
+      freeBuffers_.push_back(std::move(upload.buffer));
+    }
+  }
+
   void uploadPart(const std::string_view part, bool isLast = false) {
     // Only the last part can be less than kPartUploadSize.
     VELOX_CHECK(isLast || (!isLast && (part.size() == kPartUploadSize)));
-    // Upload the part.
-    {
-      Aws::S3::Model::UploadPartRequest request;
-      request.SetBucket(bucket_);
-      request.SetKey(key_);
-      request.SetUploadId(uploadState_.id);
-      request.SetPartNumber(++uploadState_.partNumber);
-      request.SetContentLength(part.size());
-      request.SetBody(
-          std::make_shared<StringViewStream>(part.data(), part.size()));
-      auto outcome = client_->UploadPart(request);
-      VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
-      // Append ETag and part number for this uploaded part.
-      // This will be needed for upload completion in Close().
-      auto result = outcome.GetResult();
-      Aws::S3::Model::CompletedPart part;
-
-      part.SetPartNumber(uploadState_.partNumber);
-      part.SetETag(result.GetETag());
-      uploadState_.completedParts.push_back(std::move(part));
-    }
+    // Append ETag and part number for this uploaded part.
+    // This will be needed for upload completion in Close().
+    uploadState_.completedParts.push_back(
+        uploadPartRequest(part, ++uploadState_.partNumber));
+  }
+
+  Aws::S3::Model::CompletedPart uploadPartRequest(
+      const std::string_view part,
+      int64_t partNumber) const {
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(bucket_);
+    request.SetKey(key_);
+    request.SetUploadId(uploadState_.id);
+    request.SetPartNumber(partNumber);
+    request.SetContentLength(part.size());
+    request.SetBody(
+        std::make_shared<StringViewStream>(part.data(), part.size()));
+    auto outcome = client_->UploadPart(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to upload", bucket_, key_);
+    auto result = outcome.GetResult();
+    Aws::S3::Model::CompletedPart completedPart;
+    completedPart.SetPartNumber(partNumber);
+    completedPart.SetETag(result.GetETag());
+    return completedPart;
   }
 
   Aws::S3::S3Client* client_;
   memory::MemoryPool* pool_;
+  folly::Executor* const executor_;
+  const uint32_t maxConcurrentUploads_;
   std::unique_ptr<dwio::common::DataBuffer<char>> currentPart_;
+  // Uploads running on 'executor_' in part number order.
+  std::deque<PendingUpload> pendingUploads_;
+  // Buffers of completed uploads. At most 'maxConcurrentUploads_' buffers
+  // exist besides 'currentPart_'.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>> freeBuffers_;
   std::string bucket_;
   std::string key_;
   size_t fileSize_ = -1;
@@ -400,8 +585,11 @@ class S3WriteFile::Impl {
 S3WriteFile::S3WriteFile(
     const std::string& path,
     Aws::S3::S3Client* client,
-    memory::MemoryPool* pool) {
-  impl_ = std::make_shared<Impl>(path, client, pool);
+    memory::MemoryPool* pool,
+    folly::Executor* executor,
+    uint32_t maxConcurrentUploads) {
+  impl_ = std::make_shared<Impl>(
+      path, client, pool, executor, maxConcurrentUploads);
 }
 
 void S3WriteFile::append(std::string_view data) {
@@ -562,6 +750,12 @@ class S3FileSystem::Impl {
       clientConfig.maxConnections = hiveConfig_->s3MaxConnections().value();
     }
 
+    if (hiveConfig_->s3IoThreads() > 0) {
+      executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          hiveConfig_->s3IoThreads(),
+          std::make_shared<folly::NamedThreadFactory>("S3IO"));
+    }
+
     auto credentialsProvider = getCredentialsProvider();
 
     client_ = std::make_shared<Aws::S3::S3Client>(
@@ -573,6 +767,7 @@ class S3FileSystem::Impl {
   }
 
   ~Impl() {
+    executor_.reset();
     client_.reset();
     --fileSystemCount;
   }
@@ -651,9 +846,20 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Executor for parallel range reads and part uploads. nullptr if these run
+  // on the calling thread.
+  folly::Executor* ioExecutor() const {
+    return executor_.get();
+  }
+
+  uint32_t maxConcurrentRequestsPerFile() const {
+    return hiveConfig_->s3MaxConcurrentRequestsPerFile();
+  }
+
  private:
   std::shared_ptr<HiveConfig> hiveConfig_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -669,7 +875,11 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file,
+      impl_->s3Client(),
+      impl_->ioExecutor(),
+      impl_->maxConcurrentRequestsPerFile());
   s3file->initialize(options);
   return s3file;
 }
@@ -678,8 +888,12 @@ std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
     const FileOptions& options) {
   const auto file = s3Path(path);
-  auto s3file =
-      std::make_unique<S3WriteFile>(file, impl_->s3Client(), options.pool);
+  auto s3file = std::make_unique<S3WriteFile>(
+      file,
+      impl_->s3Client(),
+      options.pool,
+      impl_->ioExecutor(),
+      impl_->maxConcurrentRequestsPerFile());
   return s3file;
 }
 
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Executor.h>
+
 #include "velox/common/file/File.h"
 #include "velox/common/memory/MemoryPool.h"
 
@@ -42,15 +44,19 @@ namespace facebook::velox::filesystems {
 /// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
 /// https://github.com/apache/arrow/blob/main/cpp/src/arrow/filesystem/s3fs.cc
 /// S3WriteFile is not thread-safe.
-/// UploadPart is currently synchronous during append and flush.
-/// TODO: Evaluate and add option for asynchronous part uploads.
+/// UploadPart is synchronous during append and flush unless an executor is
+/// given. With an executor, full parts are copied into buffers from 'pool' and
+/// uploaded in the background, with at most 'maxConcurrentUploads' uploads
+/// pending. close() waits for all uploads.
 /// TODO: Implement retry on failure.
 class S3WriteFile : public WriteFile {
  public:
   S3WriteFile(
       const std::string& path,
       Aws::S3::S3Client* client,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      uint32_t maxConcurrentUploads = 1);
 
   /// Appends data to the end of the file.
   /// Uploads a part on reaching part size limit.
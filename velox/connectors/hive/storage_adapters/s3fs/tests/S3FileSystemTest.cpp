@@ -254,6 +254,62 @@ TEST_F(S3FileSystemTest, writeFileAndRead) {
   ASSERT_EQ(readFile->pread(contentSize * 250'000, contentSize), dataContent);
 }
 
+TEST_F(S3FileSystemTest, parallelWriteAndRead) {
+  const auto bucketName = "paralleldata";
+  const auto file = "test.txt";
+  const auto s3File = s3URI(bucketName, file);
+
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.io-threads", "4"},
+       {"hive.s3.max-concurrent-requests-per-file", "3"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  auto pool = memory::memoryManager()->addLeafPool("S3FileSystemTest");
+  auto writeFile =
+      s3fs.openFileForWrite(s3File, {{}, pool.get(), std::nullopt});
+  auto s3WriteFile = dynamic_cast<filesystems::S3WriteFile*>(writeFile.get());
+
+  // 45MiB of data where each MiB has a different value. The parts are
+  // uploaded in the background in 10MiB parts.
+  std::string data(45 * kOneMB, 0);
+  for (auto i = 0; i < 45; ++i) {
+    std::memset(data.data() + i * kOneMB, 'a' + i % 26, kOneMB);
+  }
+  writeFile->append({data.data(), kOneMB});
+  writeFile->append({data.data() + kOneMB, 30 * kOneMB});
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 3);
+  writeFile->append({data.data() + 31 * kOneMB, 14 * kOneMB});
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 4);
+  writeFile->close();
+  EXPECT_EQ(s3WriteFile->numPartsUploaded(), 5);
+  EXPECT_EQ(writeFile->size(), data.size());
+
+  // Reads of at least 16MiB are split into parallel range requests.
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(readFile->size(), data.size());
+  ASSERT_EQ(readFile->pread(0, data.size()), data);
+  ASSERT_EQ(
+      readFile->pread(kOneMB + 7, 20 * kOneMB),
+      data.substr(kOneMB + 7, 20 * kOneMB));
+
+  std::string head(10, 0);
+  std::string tail(10, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)(30 * kOneMB)),
+      folly::Range<char*>(tail.data(), tail.size())};
+  ASSERT_EQ(readFile->preadv(kOneMB - 5, buffers), 30 * kOneMB + 20);
+  ASSERT_EQ(head, data.substr(kOneMB - 5, 10));
+  ASSERT_EQ(tail, data.substr(31 * kOneMB + 5, 10));
+
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+  head.assign(10, 0);
+  tail.assign(10, 0);
+  ASSERT_EQ(
+      readFile->preadvAsync(2 * kOneMB - 5, buffers).get(), 30 * kOneMB + 20);
+  ASSERT_EQ(head, data.substr(2 * kOneMB - 5, 10));
+  ASSERT_EQ(tail, data.substr(32 * kOneMB + 5, 10));
+}
+
 TEST_F(S3FileSystemTest, invalidConnectionSettings) {
   auto hiveConfig =
       minioServer_->hiveConfig({{"hive.s3.connect-timeout", "400"}});
@@ -66,6 +66,7 @@ TEST(HiveConfigTest, defaultConfig) {
       hiveConfig->orcWriterLinearStripeSizeHeuristics(emptySession.get()),
       true);
   ASSERT_FALSE(hiveConfig->cacheNoRetention(emptySession.get()));
+  ASSERT_EQ(hiveConfig->cacheTag(emptySession.get()), 0);
 }
 
 TEST(HiveConfigTest, overrideConfig) {
@@ -97,7 +98,8 @@ TEST(HiveConfigTest, overrideConfig) {
       {HiveConfig::kSortWriterMaxOutputBytes, "100MB"},
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristics, "false"},
       {HiveConfig::kOrcWriterMinCompressionSize, "512"},
-      {HiveConfig::kCacheNoRetention, "true"}};
+      {HiveConfig::kCacheNoRetention, "true"},
+      {HiveConfig::kCacheTag, "7"}};
   HiveConfig* hiveConfig =
       new HiveConfig(std::make_shared<MemConfig>(configFromFile));
   auto emptySession = std::make_unique<MemConfig>();
@@ -140,6 +142,7 @@ TEST(HiveConfigTest, overrideConfig) {
       hiveConfig->orcWriterLinearStripeSizeHeuristics(emptySession.get()),
       false);
   ASSERT_TRUE(hiveConfig->cacheNoRetention(emptySession.get()));
+  ASSERT_EQ(hiveConfig->cacheTag(emptySession.get()), 7);
 }
 
 TEST(HiveConfigTest, overrideSession) {
@@ -156,7 +159,8 @@ TEST(HiveConfigTest, overrideSession) {
       {HiveConfig::kIgnoreMissingFilesSession, "true"},
       {HiveConfig::kOrcWriterMinCompressionSizeSession, "512"},
       {HiveConfig::kOrcWriterLinearStripeSizeHeuristicsSession, "false"},
-      {HiveConfig::kCacheNoRetentionSession, "true"}};
+      {HiveConfig::kCacheNoRetentionSession, "true"},
+      {HiveConfig::kCacheTagSession, "9"}};
   const auto session = std::make_unique<MemConfig>(sessionOverride);
   ASSERT_EQ(
       hiveConfig->insertExistingPartitionsBehavior(session.get()),
@@ -196,4 +200,5 @@ TEST(HiveConfigTest, overrideSession) {
       hiveConfig->orcWriterLinearStripeSizeHeuristics(session.get()), false);
   ASSERT_EQ(hiveConfig->orcWriterMinCompressionSize(session.get()), 512);
   ASSERT_TRUE(hiveConfig->cacheNoRetention(session.get()));
+  ASSERT_EQ(hiveConfig->cacheTag(session.get()), 9);
 }
@@ -22,6 +22,8 @@
 #include "velox/connectors/hive/HiveConnectorUtil.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/core/Config.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/type/Filter.h"
 
 namespace facebook::velox::connector {
 
@@ -212,4 +214,36 @@ TEST_F(HiveConnectorUtilTest, configureRowReaderOptions) {
   ASSERT_EQ(nodes[0].expression, "[1,3]");
 }
 
+TEST_F(HiveConnectorUtilTest, testFiltersOnFileStatistics) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  FileStatistics fileStats;
+  fileStats.numRows = 100;
+  fileStats.typeWithId = TypeWithId::create(rowType);
+  fileStats.columnStats.push_back(std::make_shared<IntegerColumnStatistics>(
+      100, false, 800, 800, 0, 99, 4950));
+  fileStats.columnStats.push_back(nullptr);
+  const std::unordered_map<std::string, std::optional<std::string>>
+      partitionKeys;
+  const std::unordered_map<std::string, std::shared_ptr<hive::HiveColumnHandle>>
+      partitionKeysHandle;
+
+  auto test = [&](const std::string& column,
+                  std::unique_ptr<common::Filter> filter) {
+    common::ScanSpec scanSpec("<root>");
+    scanSpec.addField(column, 0)->setFilter(std::move(filter));
+    return hive::testFilters(
+        &scanSpec, fileStats, "file", partitionKeys, partitionKeysHandle);
+  };
+  EXPECT_TRUE(test("c0", std::make_unique<common::BigintRange>(50, 60, false)));
+  EXPECT_FALSE(
+      test("c0", std::make_unique<common::BigintRange>(100, 200, false)));
+  // No statistics for c1.
+  EXPECT_TRUE(
+      test("c1", std::make_unique<common::BigintRange>(100, 200, false)));
+  // c2 is not in the file so it is all null.
+  EXPECT_FALSE(
+      test("c2", std::make_unique<common::BigintRange>(100, 200, false)));
+  EXPECT_TRUE(test("c2", std::make_unique<common::IsNull>()));
+}
+
 } // namespace facebook::velox::connector
@@ -18,6 +18,7 @@
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <re2/re2.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -150,7 +151,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
       const std::vector<std::string>& partitionedBy = {},
       const std::shared_ptr<connector::hive::HiveBucketProperty>&
-          bucketProperty = nullptr) {
+          bucketProperty = nullptr,
+      folly::Executor* executor = nullptr) {
     return std::make_shared<HiveDataSink>(
         rowType,
         createHiveInsertTableHandle(
@@ -161,7 +163,8 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
             bucketProperty),
         connectorQueryCtx_.get(),
         CommitStrategy::kNoCommit,
-        connectorConfig_);
+        connectorConfig_,
+        executor);
   }
 
   std::vector<std::string> listFiles(const std::string& dirPath) {
@@ -558,6 +561,140 @@ TEST_F(HiveDataSinkTest, basicBucket) {
   verifyWrittenData(outputDirectory->getPath(), numBuckets);
 }
 
+TEST_F(HiveDataSinkTest, zOrderSortWrite) {
+  connectorConfig_ =
+      std::make_shared<HiveConfig>(std::make_shared<core::MemConfig>(
+          std::unordered_map<std::string, std::string>{
+              {HiveConfig::kSortWriterZOrder, "true"}}));
+  const auto outputDirectory = TempDirectoryPath::create();
+  const int32_t numBuckets = 4;
+  auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      numBuckets,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{true, true}),
+          std::make_shared<HiveSortingColumn>(
+              "c5", core::SortOrder{true, true})});
+  auto dataSink = createDataSink(
+      rowType_,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {},
+      bucketProperty);
+  const auto vectors = createVectors(500, 10);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  ASSERT_EQ(dataSink->close().size(), numBuckets);
+
+  createDuckDbTable(vectors);
+  verifyWrittenData(outputDirectory->getPath(), numBuckets);
+
+  auto unsupported = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      numBuckets,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{true, true})});
+  auto arrayType = ROW({"c0", "c1"}, {BIGINT(), ARRAY(BIGINT())});
+  VELOX_ASSERT_THROW(
+      createDataSink(
+          arrayType,
+          outputDirectory->getPath(),
+          dwio::common::FileFormat::DWRF,
+          {},
+          unsupported),
+      "Unsupported Z-order sort column type: ARRAY<BIGINT>");
+}
+
+TEST_F(HiveDataSinkTest, parallelWriterClose) {
+  connectorConfig_ =
+      std::make_shared<HiveConfig>(std::make_shared<core::MemConfig>(
+          std::unordered_map<std::string, std::string>{
+              {HiveConfig::kParallelWriterClose, "true"}}));
+  const auto outputDirectory = TempDirectoryPath::create();
+  const int32_t numBuckets = 8;
+  auto bucketProperty = std::make_shared<HiveBucketProperty>(
+      HiveBucketProperty::Kind::kHiveCompatible,
+      numBuckets,
+      std::vector<std::string>{"c0"},
+      std::vector<TypePtr>{BIGINT()},
+      std::vector<std::shared_ptr<const HiveSortingColumn>>{
+          std::make_shared<HiveSortingColumn>(
+              "c1", core::SortOrder{false, false})});
+  auto dataSink = createDataSink(
+      rowType_,
+      outputDirectory->getPath(),
+      dwio::common::FileFormat::DWRF,
+      {},
+      bucketProperty,
+      spillExecutor_.get());
+  const auto vectors = createVectors(500, 10);
+  for (const auto& vector : vectors) {
+    dataSink->appendData(vector);
+  }
+  const auto partitions = dataSink->close();
+  ASSERT_EQ(partitions.size(), numBuckets);
+  ASSERT_GT(dataSink->stats().numWrittenBytes, 0);
+
+  createDuckDbTable(vectors);
+  verifyWrittenData(outputDirectory->getPath(), numBuckets);
+}
+
+TEST_F(HiveDataSinkTest, partitionedWriteSortFallback) {
+  const int32_t numPartitions = 20;
+  auto vectors = createVectors(500, 10);
+  for (auto i = 0; i < vectors.size(); ++i) {
+    // The first batch fits in the open writer limit.
+    const int32_t batchPartitions = i == 0 ? 3 : numPartitions;
+    vectors[i]->childAt(2) = makeFlatVector<int16_t>(
+        vectors[i]->size(),
+        [&](auto row) { return (row * 7) % batchPartitions; });
+  }
+
+  for (const bool sortFallback : {false, true}) {
+    SCOPED_TRACE(fmt::format("sortFallback {}", sortFallback));
+    connectorConfig_ =
+        std::make_shared<HiveConfig>(std::make_shared<core::MemConfig>(
+            std::unordered_map<std::string, std::string>{
+                {HiveConfig::kMaxPartitionsPerWriters, "5"},
+                {HiveConfig::kPartitionedWriteSortFallback,
+                 sortFallback ? "true" : "false"}}));
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(
+        rowType_,
+        outputDirectory->getPath(),
+        dwio::common::FileFormat::DWRF,
+        {"c2"});
+    if (!sortFallback) {
+      dataSink->appendData(vectors[0]);
+      VELOX_ASSERT_THROW(
+          dataSink->appendData(vectors[1]), "Exceeded limit of 5");
+      continue;
+    }
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    const auto partitions = dataSink->close();
+    ASSERT_EQ(partitions.size(), numPartitions);
+    std::unordered_set<std::string> names;
+    int64_t numRows = 0;
+    for (const auto& partition : partitions) {
+      const auto update = folly::parseJson(partition);
+      names.insert(update["name"].asString());
+      numRows += update["rowCount"].asInt();
+    }
+    ASSERT_EQ(names.size(), numPartitions);
+    ASSERT_EQ(numRows, 500 * vectors.size());
+    ASSERT_EQ(listFiles(outputDirectory->getPath()).size(), numPartitions);
+  }
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -651,16 +788,14 @@ TEST_F(HiveDataSinkTest, memoryReclaim) {
       {dwio::common::FileFormat::DWRF, false, true, 1, true, true},
       {dwio::common::FileFormat::DWRF, false, false, 1 << 30, false, false},
       {dwio::common::FileFormat::DWRF, false, false, 1, false, false},
-  // Add Parquet with https://github.com/facebookincubator/velox/issues/5560
-#if 0
-      {dwio::common::FileFormat::PARQUET, true, true, 1 << 30, false, false},
-      {dwio::common::FileFormat::PARQUET, true, true, 1, false, false},
+#ifdef VELOX_ENABLE_PARQUET
+      {dwio::common::FileFormat::PARQUET, true, true, 1, true, true},
       {dwio::common::FileFormat::PARQUET, true, false, 1 << 30, false, false},
       {dwio::common::FileFormat::PARQUET, true, false, 1, false, false},
-      {dwio::common::FileFormat::PARQUET, false, true, 1 << 30, false, false},
-      {dwio::common::FileFormat::PARQUET, false, true, 1, false, false},
+      {dwio::common::FileFormat::PARQUET, false, true, 1 << 30, true, false},
+      {dwio::common::FileFormat::PARQUET, false, true, 1, true, true},
       {dwio::common::FileFormat::PARQUET, false, false, 1 << 30, false, false},
-      {dwio::common::FileFormat::PARQUET, false, false, 1, false, false}
+      {dwio::common::FileFormat::PARQUET, false, false, 1, false, false},
 #endif
   };
   for (const auto& testData : testSettings) {
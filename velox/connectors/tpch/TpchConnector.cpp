@@ -63,8 +63,12 @@ TpchDataSource::TpchDataSource(
     const std::unordered_map<
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-    velox::memory::MemoryPool* pool)
-    : pool_(pool) {
+    velox::memory::MemoryPool* pool,
+    folly::Executor* executor,
+    int32_t maxParallelBatches)
+    : pool_(pool),
+      executor_(executor),
+      maxParallelBatches_(maxParallelBatches) {
   auto tpchTableHandle =
       std::dynamic_pointer_cast<TpchTableHandle>(tableHandle);
   VELOX_CHECK_NOT_NULL(
@@ -105,6 +109,12 @@ TpchDataSource::TpchDataSource(
   outputType_ = outputType;
 }
 
+TpchDataSource::~TpchDataSource() {
+  for (auto& batch : pendingBatches_) {
+    batch->close();
+  }
+}
+
 RowVectorPtr TpchDataSource::projectOutputColumns(RowVectorPtr inputVector) {
   std::vector<VectorPtr> children;
   children.reserve(outputColumnMappings_.size());
@@ -136,15 +146,55 @@ void TpchDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   splitEnd_ = splitOffset_ + partSize;
 }
 
+void TpchDataSource::scheduleBatches(uint64_t size) {
+  while (pendingBatches_.size() < static_cast<size_t>(maxParallelBatches_) &&
+         splitOffset_ < splitEnd_) {
+    const size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto batch = std::make_shared<AsyncSource<RowVectorPtr>>(
+        [table = tpchTable_,
+         maxRows,
+         offset = splitOffset_,
+         scaleFactor = scaleFactor_,
+         pool = pool_]() {
+          return std::make_unique<RowVectorPtr>(
+              getTpchData(table, maxRows, offset, scaleFactor, pool));
+        });
+    executor_->add([batch]() { batch->prepare(); });
+    pendingBatches_.push_back(std::move(batch));
+    splitOffset_ += maxRows;
+  }
+}
+
+RowVectorPtr TpchDataSource::nextBatch(uint64_t size) {
+  if (executor_ == nullptr || maxParallelBatches_ < 2) {
+    size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
+    auto outputVector =
+        getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+    // splitOffset needs to advance based on maxRows passed to getTpchData(),
+    // and not the actual number of returned rows in the output vector, as
+    // they are not the same for lineitem.
+    splitOffset_ += maxRows;
+    return outputVector;
+  }
+
+  scheduleBatches(size);
+  if (pendingBatches_.empty()) {
+    return nullptr;
+  }
+  // Makes the batch on this thread if no executor thread has started it yet.
+  auto outputVector = pendingBatches_.front()->move();
+  pendingBatches_.pop_front();
+  scheduleBatches(size);
+  return outputVector ? std::move(*outputVector) : nullptr;
+}
+
 std::optional<RowVectorPtr> TpchDataSource::next(
     uint64_t size,
     velox::ContinueFuture& /*future*/) {
   VELOX_CHECK_NOT_NULL(
       currentSplit_, "No split to process. Call addSplit() first.");
 
-  size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
-  auto outputVector =
-      getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
+  auto outputVector = nextBatch(size);
 
   // If the split is exhausted.
   if (!outputVector || outputVector->size() == 0) {
@@ -152,10 +202,6 @@ std::optional<RowVectorPtr> TpchDataSource::next(
     return nullptr;
   }
 
-  // splitOffset needs to advance based on maxRows passed to getTpchData(), and
-  // not the actual number of returned rows in the output vector, as they are
-  // not the same for lineitem.
-  splitOffset_ += maxRows;
   completedRows_ += outputVector->size();
   completedBytes_ += outputVector->retainedSize();
 
@@ -15,6 +15,9 @@
  */
 #pragma once
 
+#include <deque>
+
+#include "velox/common/base/AsyncSource.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/tpch/TpchConnectorSplit.h"
 #include "velox/tpch/gen/TpchGen.h"
@@ -75,7 +78,11 @@ class TpchDataSource : public DataSource {
       const std::unordered_map<
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      folly::Executor* executor = nullptr,
+      int32_t maxParallelBatches = 0);
+
+  ~TpchDataSource() override;
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -104,6 +111,14 @@ class TpchDataSource : public DataSource {
  private:
   RowVectorPtr projectOutputColumns(RowVectorPtr vector);
 
+  // Schedules the generation of the next batches of the split on 'executor_'
+  // until 'maxParallelBatches_' batches are pending.
+  void scheduleBatches(uint64_t size);
+
+  // Returns the next generated batch of the split or nullptr if the split is
+  // exhausted.
+  RowVectorPtr nextBatch(uint64_t size);
+
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
   size_t tpchTableRowCount_{0};
@@ -124,15 +139,38 @@ class TpchDataSource : public DataSource {
   size_t completedBytes_{0};
 
   memory::MemoryPool* pool_;
+
+  // Executor and maximum number of batches of a split generated in parallel.
+  // Batches are generated synchronously if 'executor_' is null or
+  // 'maxParallelBatches_' is less than 2.
+  folly::Executor* const executor_;
+  const int32_t maxParallelBatches_;
+
+  // Batches of the current split that are scheduled on 'executor_', in split
+  // order. Each batch is generated from its own offset, so the output is the
+  // same as with synchronous generation.
+  std::deque<std::shared_ptr<AsyncSource<RowVectorPtr>>> pendingBatches_;
 };
 
 class TpchConnector final : public Connector {
  public:
+  /// Maximum number of batches of a split that are generated in parallel on
+  /// the connector executor. Batches are generated on the driver thread if 0
+  /// or 1 or if the connector has no executor.
+  static constexpr const char* kMaxParallelBatches = "max-parallel-batches";
+
   TpchConnector(
       const std::string& id,
       std::shared_ptr<const Config> config,
-      folly::Executor* /*executor*/)
-      : Connector(id) {}
+      folly::Executor* executor)
+      : Connector(id),
+        executor_(executor),
+        maxParallelBatches_(
+            config->get<int32_t>(kMaxParallelBatches, 0)) {}
+
+  folly::Executor* executor() const override {
+    return executor_;
+  }
 
   std::unique_ptr<DataSource> createDataSource(
       const std::shared_ptr<const RowType>& outputType,
@@ -145,7 +183,9 @@ class TpchConnector final : public Connector {
         outputType,
         tableHandle,
         columnHandles,
-        connectorQueryCtx->memoryPool());
+        connectorQueryCtx->memoryPool(),
+        executor_,
+        maxParallelBatches_);
   }
 
   std::unique_ptr<DataSink> createDataSink(
@@ -156,6 +196,10 @@ class TpchConnector final : public Connector {
       CommitStrategy /*commitStrategy*/) override final {
     VELOX_NYI("TpchConnector does not support data sink.");
   }
+
+ private:
+  folly::Executor* const executor_;
+  const int32_t maxParallelBatches_;
 };
 
 class TpchConnectorFactory : public ConnectorFactory {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/connectors/tpch/TpchConnector.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -286,6 +287,39 @@ TEST_F(TpchConnectorTest, orderDateCount) {
   EXPECT_EQ(9, orderDate->size());
 }
 
+// Ensures that generating the batches of a split in parallel on the connector
+// executor returns the same data as generating them on the driver thread.
+TEST_F(TpchConnectorTest, parallelBatches) {
+  auto plan = PlanBuilder()
+                  .tpchTableScan(
+                      Table::TBL_LINEITEM,
+                      {"l_orderkey",
+                       "l_linenumber",
+                       "l_shipdate",
+                       "l_receiptdate",
+                       "l_shipinstruct",
+                       "l_comment"},
+                      0.01)
+                  .planNode();
+  auto expected = getResults(plan, {makeTpchSplit(2, 0), makeTpchSplit(2, 1)});
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  connector::unregisterConnector(kTpchConnectorId);
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(
+              kTpchConnectorId,
+              std::make_shared<core::MemConfig>(
+                  std::unordered_map<std::string, std::string>{
+                      {TpchConnector::kMaxParallelBatches, "4"}}),
+              executor.get()));
+
+  auto output = getResults(plan, {makeTpchSplit(2, 0), makeTpchSplit(2, 1)});
+  test::assertEqualVectors(expected, output);
+  connector::unregisterConnector(kTpchConnectorId);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -224,11 +224,13 @@ void addSortingKeys(
 } // namespace
 
 bool AggregationNode::canSpill(const QueryConfig& queryConfig) const {
-  // TODO: Add spilling for aggregations over distinct inputs.
-  // https://github.com/facebookincubator/velox/issues/7454
-  for (const auto& aggregate : aggregates_) {
-    if (aggregate.distinct) {
-      return false;
+  // Aggregations over distinct inputs spill only when the distinct inputs are
+  // kept in a hash table. See QueryConfig::kDistinctAggregationHashTable.
+  if (!queryConfig.distinctAggregationHashTable()) {
+    for (const auto& aggregate : aggregates_) {
+      if (aggregate.distinct) {
+        return false;
+      }
     }
   }
   // TODO: add spilling for pre-grouped aggregation later:
@@ -1057,11 +1059,17 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (useHashTableCache_) {
+    stream << ", shared hash table";
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  if (useHashTableCache_) {
+    obj["useHashTableCache"] = useHashTableCache_;
+  }
   return obj;
 }
 
@@ -1081,6 +1089,10 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  const bool useHashTableCache = obj.count("useHashTableCache")
+      ? obj["useHashTableCache"].asBool()
+      : false;
+
   return std::make_shared<HashJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -1090,7 +1102,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      useHashTableCache);
 }
 
 folly::dynamic MergeJoinNode::serialize() const {
@@ -1533,12 +1546,14 @@ PlanNodePtr WindowNode::create(const folly::dynamic& obj, void* context) {
 
 RowTypePtr getMarkDistinctOutputType(
     const RowTypePtr& inputType,
-    const std::string& markerName) {
+    const std::vector<std::string>& markerNames) {
   std::vector<std::string> names = inputType->names();
   std::vector<TypePtr> types = inputType->children();
 
-  names.emplace_back(markerName);
-  types.emplace_back(BOOLEAN());
+  for (const auto& markerName : markerNames) {
+    names.emplace_back(markerName);
+    types.emplace_back(BOOLEAN());
+  }
   return ROW(std::move(names), std::move(types));
 }
 
@@ -1547,31 +1562,70 @@ MarkDistinctNode::MarkDistinctNode(
     std::string markerName,
     std::vector<FieldAccessTypedExprPtr> distinctKeys,
     PlanNodePtr source)
+    : MarkDistinctNode(
+          std::move(id),
+          std::vector<std::string>{std::move(markerName)},
+          std::vector<std::vector<FieldAccessTypedExprPtr>>{
+              std::move(distinctKeys)},
+          std::move(source)) {}
+
+MarkDistinctNode::MarkDistinctNode(
+    PlanNodeId id,
+    std::vector<std::string> markerNames,
+    std::vector<std::vector<FieldAccessTypedExprPtr>> distinctKeys,
+    PlanNodePtr source)
     : PlanNode(std::move(id)),
-      markerName_(std::move(markerName)),
+      markerNames_(std::move(markerNames)),
       distinctKeys_(std::move(distinctKeys)),
       sources_{std::move(source)},
       outputType_(
-          getMarkDistinctOutputType(sources_[0]->outputType(), markerName_)) {
-  VELOX_USER_CHECK_GT(markerName_.size(), 0)
-  VELOX_USER_CHECK_GT(distinctKeys_.size(), 0);
+          getMarkDistinctOutputType(sources_[0]->outputType(), markerNames_)) {
+  VELOX_USER_CHECK_GT(markerNames_.size(), 0);
+  VELOX_USER_CHECK_EQ(markerNames_.size(), distinctKeys_.size());
+  for (auto i = 0; i < markerNames_.size(); ++i) {
+    VELOX_USER_CHECK_GT(markerNames_[i].size(), 0);
+    VELOX_USER_CHECK_GT(distinctKeys_[i].size(), 0);
+  }
 }
 
 folly::dynamic MarkDistinctNode::serialize() const {
   auto obj = PlanNode::serialize();
-  obj["distinctKeys"] = ISerializable::serialize(this->distinctKeys_);
-  obj["markerName"] = this->markerName_;
+  obj["distinctKeys"] = ISerializable::serialize(distinctKeys());
+  obj["markerName"] = markerName();
+  if (markerNames_.size() > 1) {
+    folly::dynamic markers = folly::dynamic::array;
+    for (auto i = 0; i < markerNames_.size(); ++i) {
+      folly::dynamic marker = folly::dynamic::object;
+      marker["markerName"] = markerNames_[i];
+      marker["distinctKeys"] = ISerializable::serialize(distinctKeys_[i]);
+      markers.push_back(std::move(marker));
+    }
+    obj["markers"] = std::move(markers);
+  }
   return obj;
 }
 
 // static
 PlanNodePtr MarkDistinctNode::create(const folly::dynamic& obj, void* context) {
   auto source = deserializeSingleSource(obj, context);
-  auto distinctKeys = deserializeFields(obj["distinctKeys"], context);
-  auto markerName = obj["markerName"].asString();
+  std::vector<std::string> markerNames;
+  std::vector<std::vector<FieldAccessTypedExprPtr>> distinctKeys;
+  if (obj.count("markers")) {
+    for (const auto& marker : obj["markers"]) {
+      markerNames.push_back(marker["markerName"].asString());
+      distinctKeys.push_back(
+          deserializeFields(marker["distinctKeys"], context));
+    }
+  } else {
+    markerNames.push_back(obj["markerName"].asString());
+    distinctKeys.push_back(deserializeFields(obj["distinctKeys"], context));
+  }
 
   return std::make_shared<MarkDistinctNode>(
-      deserializePlanNodeId(obj), markerName, distinctKeys, source);
+      deserializePlanNodeId(obj),
+      std::move(markerNames),
+      std::move(distinctKeys),
+      source);
 }
 
 namespace {
@@ -2159,7 +2213,17 @@ PlanNodePtr OrderByNode::create(const folly::dynamic& obj, void* context) {
 }
 
 void MarkDistinctNode::addDetails(std::stringstream& stream) const {
-  addFields(stream, distinctKeys_);
+  if (markerNames_.size() == 1) {
+    addFields(stream, distinctKeys_[0]);
+    return;
+  }
+  for (auto i = 0; i < markerNames_.size(); ++i) {
+    if (i > 0) {
+      stream << "; ";
+    }
+    stream << markerNames_[i] << ": ";
+    addFields(stream, distinctKeys_[i]);
+  }
 }
 
 void PlanNode::toString(
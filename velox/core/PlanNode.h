@@ -1575,7 +1575,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      bool useHashTableCache = false)
       : AbstractJoinNode(
             id,
             joinType,
@@ -1585,7 +1586,8 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        useHashTableCache_{useHashTableCache} {
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -1610,14 +1612,25 @@ class HashJoinNode : public AbstractJoinNode {
     // filter set. It requires to cross join the null-key probe rows with all
     // the build-side rows for filter evaluation which is not supported under
     // spilling.
+    // NOTE: a build side shared through the hash table cache is never
+    // spilled as other tasks may be probing it.
     return !(isAntiJoin() && nullAware_ && filter() != nullptr) &&
-        queryConfig.joinSpillEnabled();
+        !useHashTableCache_ && queryConfig.joinSpillEnabled();
   }
 
   bool isNullAware() const {
     return nullAware_;
   }
 
+  /// If true, the tasks of the same query running on this node share a single
+  /// copy of the build side hash table via exec::HashTableCache. The first
+  /// task to start building the table builds it and the others attach to it
+  /// read-only. Ignored for join types that update the table while probing
+  /// and for null-aware joins.
+  bool useHashTableCache() const {
+    return useHashTableCache_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1626,6 +1639,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const bool useHashTableCache_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -2257,6 +2271,12 @@ class RowNumberNode : public PlanNode {
 /// @param markerName Name of the output mask channel.
 /// @param distinctKeys Names of grouping keys.
 /// column.
+///
+/// A node may compute several markers, each over its own distinct keys, e.g.
+/// for several count(DISTINCT x) over different columns. The marker columns
+/// follow the input columns in the order of 'markerNames'. This replaces a
+/// chain of single marker nodes over the same input. Markers with the same
+/// distinct keys share one hash table.
 class MarkDistinctNode : public PlanNode {
  public:
   MarkDistinctNode(
@@ -2265,11 +2285,20 @@ class MarkDistinctNode : public PlanNode {
       std::vector<FieldAccessTypedExprPtr> distinctKeys,
       PlanNodePtr source);
 
+  /// @param markerNames Names of the output mask channels.
+  /// @param distinctKeys Grouping keys for each of 'markerNames'.
+  MarkDistinctNode(
+      PlanNodeId id,
+      std::vector<std::string> markerNames,
+      std::vector<std::vector<FieldAccessTypedExprPtr>> distinctKeys,
+      PlanNodePtr source);
+
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
   }
 
-  /// The outputType is the concatenation of the input columns and mask column.
+  /// The outputType is the concatenation of the input columns and mask
+  /// columns.
   const RowTypePtr& outputType() const override {
     return outputType_;
   }
@@ -2278,11 +2307,23 @@ class MarkDistinctNode : public PlanNode {
     return "MarkDistinct";
   }
 
+  /// Name of the first mask column.
   const std::string& markerName() const {
-    return markerName_;
+    return markerNames_[0];
   }
 
+  /// Grouping keys of the first mask column.
   const std::vector<FieldAccessTypedExprPtr>& distinctKeys() const {
+    return distinctKeys_[0];
+  }
+
+  const std::vector<std::string>& markerNames() const {
+    return markerNames_;
+  }
+
+  /// Grouping keys for each of 'markerNames()'.
+  const std::vector<std::vector<FieldAccessTypedExprPtr>>& distinctKeySets()
+      const {
     return distinctKeys_;
   }
 
@@ -2293,9 +2334,9 @@ class MarkDistinctNode : public PlanNode {
  private:
   void addDetails(std::stringstream& stream) const override;
 
-  const std::string markerName_;
+  const std::vector<std::string> markerNames_;
 
-  const std::vector<FieldAccessTypedExprPtr> distinctKeys_;
+  const std::vector<std::vector<FieldAccessTypedExprPtr>> distinctKeys_;
 
   const std::vector<PlanNodePtr> sources_;
 
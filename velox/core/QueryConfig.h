@@ -101,11 +101,43 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Whether to collect per-expression counters in addition to CPU time:
+  /// rows producing non-null results, bytes allocated, number of batches
+  /// evaluated on peeled inputs and rows served from the dictionary memo. The
+  /// counters are printed by ExprSet::toString(true) and reported by
+  /// FilterProject as runtime stats. Implies kExprTrackCpuUsage. False by
+  /// default.
+  static constexpr const char* kExprProfilingEnabled =
+      "expression.profiling_enabled";
+
+  /// Whether to evaluate trees of deterministic simple functions, AND and OR
+  /// over fixed-width columns in a single pass over blocks of rows instead of
+  /// materializing an intermediate vector per function call. False by
+  /// default.
+  static constexpr const char* kExprFusedEvalEnabled =
+      "expression.fused_eval_enabled";
+
+  /// Maximum number of distinct regular expressions used by one instance of
+  /// a regular expression function with a non-constant pattern, e.g.
+  /// regexp_like(c0, c1). The compiled expressions are shared by all queries
+  /// in the process, so a higher limit mostly costs memory. 20 by default.
+  static constexpr const char* kExprMaxCompiledRegexes =
+      "expression.max_compiled_regexes";
+
   /// Whether to track CPU usage for stages of individual operators. True by
   /// default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to read the hardware counters of the thread, i.e. cycles,
+  /// instructions, last level cache misses and branch misses, around the
+  /// getOutput(), addInput() and noMoreInput() calls of operators and add
+  /// them to the runtime stats of the operators. False by default. Costs a
+  /// system call per operator call and needs perf events, i.e. Linux with
+  /// perf_event_paranoid <= 2 and hardware counters. Does nothing otherwise.
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
   /// Flags used to configure the CAST operator:
 
   static constexpr const char* kLegacyCast = "legacy_cast";
@@ -120,28 +152,114 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// Minimum number of rows in a batch that LocalPartition adds to a local
+  /// exchange queue. Smaller partitions of the input batches are accumulated
+  /// and copied into one batch first, which reduces the number of queue
+  /// operations and the number of tiny batches when there are many
+  /// partitions. 0 disables the accumulation.
+  static constexpr const char* kLocalExchangeMinBatchRows =
+      "local_exchange_min_batch_rows";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// Maximum time in milliseconds the Exchange operator waits for more pages
+  /// when the pages it has are smaller than kPreferredOutputBatchBytes, so
+  /// that small pages from producers are coalesced into fewer, larger output
+  /// batches. 0 disables the waiting.
+  static constexpr const char* kExchangeCoalesceMaxWaitMs =
+      "exchange.coalesce_max_wait_ms";
+
+  /// If true, the Exchange operator deserializes fixed-width columns without
+  /// nulls as views over the memory of the received pages instead of copying
+  /// them. The pages then stay in memory for as long as the output vectors
+  /// refer to them.
+  static constexpr const char* kExchangeDeserializeInPlace =
+      "exchange.deserialize_in_place";
+
   /// Maximum size in bytes to accumulate among all sources of the merge
   /// exchange. Enforced approximately, not strictly.
   static constexpr const char* kMaxMergeExchangeBufferSize =
       "merge_exchange.max_buffer_size";
 
+  /// If true, the merge exchange divides its buffer among the sources in
+  /// proportion to how fast the merge consumes their data and keeps the total
+  /// within merge_exchange.max_buffer_size regardless of the number of
+  /// sources.
+  static constexpr const char* kMergeExchangeAdaptiveBufferEnabled =
+      "merge_exchange.adaptive_buffer_enabled";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
   static constexpr const char* kMaxExtendedPartialAggregationMemory =
       "max_extended_partial_aggregation_memory";
 
+  /// The priority of the query in memory arbitration. With the 'PRIORITY'
+  /// arbitrator candidate policy, the queries with lower priority are spilled
+  /// or aborted first to free memory for others.
+  static constexpr const char* kQueryArbitrationPriority =
+      "query_arbitration_priority";
+
   static constexpr const char* kAbandonPartialAggregationMinRows =
       "abandon_partial_aggregation_min_rows";
 
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If true, the drivers of a final aggregation each aggregate the input they
+  /// receive and, after all of them have received all the input, merge their
+  /// groups by partition of the grouping keys, one partition per driver. This
+  /// makes the final aggregation correct without a local partition of its
+  /// input by the grouping keys. Spilling is disabled for such aggregations.
+  static constexpr const char* kFinalAggregationPartitionMerge =
+      "final_aggregation_partition_merge";
+
+  /// If true, hash aggregations whose aggregates all have fixed width
+  /// accumulators keep the accumulators in one array per aggregate indexed by
+  /// a group number stored in the row instead of in the rows of the hash
+  /// table. This makes updating an aggregate touch a dense array instead of a
+  /// whole row per group, which helps wide aggregations. Does not apply to
+  /// aggregations that may spill.
+  static constexpr const char* kAggregationColumnarAccumulators =
+      "aggregation_columnar_accumulators";
+
+  /// If true, partial aggregations check whether their first input rows arrive
+  /// clustered on the grouping keys, e.g. when reading a table sorted on these
+  /// keys. If so, they output each group as soon as the keys change instead of
+  /// accumulating all groups in the hash table.
+  static constexpr const char* kPartialAggregationDetectClusteredInput =
+      "partial_aggregation_detect_clustered_input";
+
+  /// If true, aggregations over distinct inputs keep the distinct inputs of all
+  /// groups in a single hash table keyed on the group and the inputs instead
+  /// of a set of inputs per group. This uses much less memory when there are
+  /// many groups with few distinct inputs each. Only these aggregations over
+  /// distinct inputs support spilling.
+  static constexpr const char* kDistinctAggregationHashTable =
+      "distinct_aggregation_hash_table";
+
+  /// If true, an aggregation over a GroupId node first aggregates its input
+  /// once on all the grouping keys. The GroupId operator then duplicates the
+  /// partial groups instead of the input rows for each grouping set and the
+  /// aggregation merges them. Applies only to aggregates that are not
+  /// distinct, sorted or masked.
+  static constexpr const char* kGroupingSetsPreAggregation =
+      "grouping_sets_pre_aggregation";
+
+  /// If true, the drivers of a Window that sorts its input share the sorted
+  /// rows of all drivers and claim the partitions one at a time, so that the
+  /// input does not need to be partitioned on the partition keys.
+  static constexpr const char* kWindowParallelPartitions =
+      "window_parallel_partitions";
+
+  /// If true, a final OrderBy runs in multiple drivers. Each driver sorts its
+  /// input and the last driver to finish merges the sorted runs of all
+  /// drivers and produces the output.
+  static constexpr const char* kOrderByParallelSort = "order_by_parallel_sort";
+
   static constexpr const char* kAbandonPartialTopNRowNumberMinRows =
       "abandon_partial_topn_row_number_min_rows";
 
@@ -153,6 +271,14 @@ class QueryConfig {
 
   static constexpr const char* kMaxOutputBufferSize = "max_output_buffer_size";
 
+  /// If true, PartitionedOutput serializes the rows sent to a destination with
+  /// the dictionary and constant encodings of their columns, so a dictionary
+  /// encoded column ships only the dictionary entries used by the rows of each
+  /// page. A serialized page buffer may then hold multiple Presto pages. Only
+  /// set if the consumers of the exchange accept both.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -172,6 +298,21 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, operators without an estimate of their output row size use the
+  /// average size of the rows they have produced so far, as measured by
+  /// BaseVector::estimateFlatSize. The number of rows per output batch is
+  /// then computed from kPreferredOutputBatchBytes and capped at
+  /// kMaxOutputBatchRows. This avoids huge batches of wide rows and tiny
+  /// batches of narrow rows.
+  static constexpr const char* kAdaptiveOutputBatchSizeEnabled =
+      "adaptive_output_batch_size_enabled";
+
+  /// If true, the Unnest operator splits the output of an input row with more
+  /// elements than fit in an output batch across several batches. Otherwise,
+  /// each input row is unnested into a single batch, which may be arbitrarily
+  /// large for large arrays or maps.
+  static constexpr const char* kUnnestSplitOutput = "unnest_split_output";
+
   /// TableScan operator will exit getOutput() method after this many
   /// milliseconds even if it has no data to return yet. Zero means 'no time
   /// limit'.
@@ -195,9 +336,23 @@ class QueryConfig {
   static constexpr const char* kAggregationSpillEnabled =
       "aggregation_spill_enabled";
 
+  /// When a hash aggregation is asked to free memory and at least this
+  /// percentage of its out-of-line string memory is in free blocks, the live
+  /// strings are compacted into fresh memory instead of spilling. 0 disables
+  /// compaction.
+  static constexpr const char* kAggregationCompactionFragmentationPct =
+      "aggregation_compaction_fragmentation_pct";
+
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
+  /// If true, the rows of a spilled hash join table are written as serialized
+  /// RowContainer rows next to the join keys, so restoring a spilled partition
+  /// copies each row into the RowContainer instead of storing it column by
+  /// column. Does not apply to anti joins.
+  static constexpr const char* kJoinSpillSerializedRows =
+      "join_spill_serialized_rows";
+
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
@@ -238,12 +393,45 @@ class QueryConfig {
   /// io and cpu resources.
   static constexpr const char* kMaxSpillLevel = "max_spill_level";
 
+  /// If not zero, a spilled hash join build partition that can't be spilled
+  /// again because of 'kMaxSpillLevel' is restored in chunks of spill files of
+  /// about this many bytes. The spilled probe side partition is probed against
+  /// the table of each chunk in turn, so a partition with skewed keys can be
+  /// joined within memory. Applies to inner, right and right semi joins.
+  static constexpr const char* kHashJoinSpillRestoreChunkBytes =
+      "hash_join_spill_restore_chunk_bytes";
+
   /// The max allowed spill file size. If it is zero, then there is no limit.
   static constexpr const char* kMaxSpillFileSize = "max_spill_file_size";
 
   static constexpr const char* kSpillCompressionKind =
       "spill_compression_codec";
 
+  /// If true, the sorted spill runs of OrderBy, Window and aggregation are
+  /// written with the consecutive equal values of each column dictionary
+  /// encoded before the compression by 'spill_compression_codec'.
+  static constexpr const char* kSpillEncodeSortedRuns =
+      "spill_encode_sorted_runs";
+
+  /// If true, spill files are written asynchronously on the spill executor,
+  /// overlapping the write of a buffer with the serialization of the next,
+  /// and spill reads for merging read ahead the next buffer of each file.
+  /// Requires the query to have a spill executor.
+  static constexpr const char* kSpillAsyncIo = "spill_async_io";
+
+  /// The directory, usually on a remote FileSystem like S3 or GCS, to move
+  /// finished spill files to once the query has more than
+  /// 'spill_local_bytes_threshold' bytes in its local spill directories. Spill
+  /// files are written to the local spill directory first and moved when they
+  /// are finished. If empty, spill files stay local.
+  static constexpr const char* kSpillRemoteDirectory = "spill_remote_directory";
+
+  /// The local spill bytes of the query after which finished spill files are
+  /// moved to 'spill_remote_directory'. Moved bytes do not count towards
+  /// 'max_spill_bytes'.
+  static constexpr const char* kSpillLocalBytesThreshold =
+      "spill_local_bytes_threshold";
+
   /// Specifies spill write buffer size in bytes. The spiller tries to buffer
   /// serialized spill data up to the specified size before write to storage
   /// underneath for io efficiency. If it is set to zero, then spill write
@@ -316,6 +504,20 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The maximum size in bytes of a Bloom filter built over an integer join
+  /// key of the hash join build side. The filter is pushed down into the
+  /// probe side scan when the build side keys have too many distinct values
+  /// for an exact IN-list or range filter. 0 disables the Bloom filters.
+  static constexpr const char* kHashJoinBloomFilterMaxSize =
+      "hash_join_bloom_filter_max_size";
+
+  /// If true, the hash probe radix partitions each batch of probe rows by the
+  /// high bits of their hash table bucket index before probing a join table
+  /// that is larger than the cache. The probes of each partition then hit a
+  /// cache sized region of the table.
+  static constexpr const char* kHashProbeRadixPartitioningEnabled =
+      "hash_probe_radix_partitioning_enabled";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
@@ -344,16 +546,92 @@ class QueryConfig {
   static constexpr const char* kMaxSharedSubexprResultsCached =
       "max_shared_subexpr_results_cached";
 
+  /// Minimum cost in nanoseconds per row for the results of a shared
+  /// subexpression to be cached. A subexpression that appears in several
+  /// expressions of an ExprSet, e.g. in the filter and a projection of a
+  /// FilterProject, is evaluated once and its results are reused for the rows
+  /// they cover. The cost is measured over the first rows evaluated. Cheaper
+  /// subexpressions are recomputed for each reference instead of being kept.
+  /// 0 caches all shared subexpressions.
+  static constexpr const char* kMinSharedSubexprCostNanosPerRow =
+      "min_shared_subexpr_cost_nanos_per_row";
+
+  /// Maximum number of bytes retained by the results that an expression
+  /// caches for the dictionary base of its input across batches, see
+  /// Expr::evalWithMemo. Results beyond the limit are recomputed for each
+  /// batch. Set to 0 to not cache.
+  static constexpr const char* kMaxDictionaryMemoBytes =
+      "max_dictionary_memo_bytes";
+
   /// Maximum number of splits to preload. Set to 0 to disable preloading.
   static constexpr const char* kMaxSplitPreloadPerDriver =
       "max_split_preload_per_driver";
 
+  /// Maximum bytes of memory held by the data sources of preloaded splits of a
+  /// TableScan across all its drivers. No new splits are preloaded while the
+  /// preloads use more. Set to 0 for no limit.
+  static constexpr const char* kSplitPreloadMemoryBudget =
+      "split_preload_memory_budget";
+
+  /// If not zero, the bytes of memory that the split groups of a task in
+  /// grouped execution may use together. The task then runs as many split
+  /// groups concurrently as fit in the budget, up to the concurrentSplitGroups
+  /// passed to Task::start(). The memory of a split group is estimated from
+  /// the peak memory of the operators of the completed split groups. Until the
+  /// first split group completes, one split group runs at a time.
+  static constexpr const char* kSplitGroupMemoryBudget =
+      "split_group_memory_budget";
+
   /// If not zero, specifies the cpu time slice limit in ms that a driver thread
   /// can continuously run without yielding. If it is zero, then there is no
   /// limit.
   static constexpr const char* kDriverCpuTimeSliceLimitMs =
       "driver_cpu_time_slice_limit_ms";
 
+  /// If not zero and the executor of the query supports priorities, drivers
+  /// are added to the executor with a priority that decreases with the time
+  /// the drivers of the query have run on threads, like in a multi-level
+  /// feedback queue. A query is at the highest priority until its drivers
+  /// have run for this many ms and drops one priority each time the time
+  /// grows 4x. Combined with kDriverCpuTimeSliceLimitMs, short queries get
+  /// ahead of long running ones instead of sharing the threads per driver.
+  static constexpr const char* kDriverPriorityQuantumMs =
+      "driver_priority_quantum_ms";
+
+  /// If true, a driver that was blocked on an operator resumes at that
+  /// operator instead of going through the pipeline again starting at the
+  /// last operator. The operators after the blocked one have no output since
+  /// the driver got to the blocked one, so this saves the isBlocked(),
+  /// needsInput() and getOutput() calls on them, which add up for drivers that
+  /// block often, e.g. on IO in TableScan or on data in Exchange.
+  static constexpr const char* kDriverResumeAtBlockedOperator =
+      "driver_resume_at_blocked_operator";
+
+  /// If not zero, the maximum number of drivers of a task that are in the
+  /// executor, i.e. running or waiting for a thread, at the same time.
+  /// Further drivers wait in the task until one of these goes off thread.
+  /// Blocked drivers are off thread, so their slots go to drivers of other
+  /// pipelines that can run. A task can then be started with more drivers
+  /// than it gets threads and the number of threads can be changed at runtime
+  /// with Task::setMaxRunningDrivers().
+  static constexpr const char* kMaxRunningDriversPerTask =
+      "max_running_drivers_per_task";
+
+  /// If true, a batch that an operator adds to the next operator is passed on
+  /// through the following operators without the per-operator checks for
+  /// termination, yield and memory arbitration in between. These checks run
+  /// once per batch from the operator that produced it instead of before
+  /// each operator, which takes query and arbitrator wide locks for every
+  /// operator of a pipeline like TableScan, FilterProject and partial
+  /// aggregation.
+  static constexpr const char* kDriverFuseOperatorChains =
+      "driver_fuse_operator_chains";
+
+  /// If not zero, each task records the latest this many state changes of its
+  /// drivers in an exec::DriverTimeline, e.g. to export as a Chrome trace.
+  static constexpr const char* kDriverTimelineCapacity =
+      "driver_timeline_capacity";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
@@ -369,6 +647,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxExtendedPartialAggregationMemory, kDefault);
   }
 
+  int32_t queryArbitrationPriority() const {
+    return get<int32_t>(kQueryArbitrationPriority, 0);
+  }
+
   int32_t abandonPartialAggregationMinRows() const {
     return get<int32_t>(kAbandonPartialAggregationMinRows, 100'000);
   }
@@ -377,6 +659,34 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  bool finalAggregationPartitionMerge() const {
+    return get<bool>(kFinalAggregationPartitionMerge, false);
+  }
+
+  bool aggregationColumnarAccumulators() const {
+    return get<bool>(kAggregationColumnarAccumulators, false);
+  }
+
+  bool partialAggregationDetectClusteredInput() const {
+    return get<bool>(kPartialAggregationDetectClusteredInput, false);
+  }
+
+  bool distinctAggregationHashTable() const {
+    return get<bool>(kDistinctAggregationHashTable, false);
+  }
+
+  bool groupingSetsPreAggregation() const {
+    return get<bool>(kGroupingSetsPreAggregation, true);
+  }
+
+  bool windowParallelPartitions() const {
+    return get<bool>(kWindowParallelPartitions, false);
+  }
+
+  bool orderByParallelSort() const {
+    return get<bool>(kOrderByParallelSort, false);
+  }
+
   int32_t abandonPartialTopNRowNumberMinRows() const {
     return get<int32_t>(kAbandonPartialTopNRowNumberMinRows, 100'000);
   }
@@ -406,6 +716,10 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
   /// Returns the maximum size in bytes for the task's buffered output.
   ///
   /// The producer Drivers are blocked when the buffered size exceeds
@@ -421,16 +735,32 @@ class QueryConfig {
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  uint32_t localExchangeMinBatchRows() const {
+    return get<uint32_t>(kLocalExchangeMinBatchRows, 0);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  uint32_t exchangeCoalesceMaxWaitMs() const {
+    return get<uint32_t>(kExchangeCoalesceMaxWaitMs, 0);
+  }
+
+  bool exchangeDeserializeInPlace() const {
+    return get<bool>(kExchangeDeserializeInPlace, false);
+  }
+
   uint64_t maxMergeExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 128UL << 20;
     return get<uint64_t>(kMaxMergeExchangeBufferSize, kDefault);
   }
 
+  bool mergeExchangeAdaptiveBufferEnabled() const {
+    return get<bool>(kMergeExchangeAdaptiveBufferEnabled, false);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -444,6 +774,14 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool adaptiveOutputBatchSizeEnabled() const {
+    return get<bool>(kAdaptiveOutputBatchSizeEnabled, false);
+  }
+
+  bool unnestSplitOutput() const {
+    return get<bool>(kUnnestSplitOutput, false);
+  }
+
   uint32_t tableScanGetOutputTimeLimitMs() const {
     return get<uint64_t>(kTableScanGetOutputTimeLimitMs, 5'000);
   }
@@ -486,6 +824,14 @@ class QueryConfig {
     return get<bool>(kExprEvalSimplified, false);
   }
 
+  bool exprFusedEvalEnabled() const {
+    return get<bool>(kExprFusedEvalEnabled, false);
+  }
+
+  uint32_t exprMaxCompiledRegexes() const {
+    return get<uint32_t>(kExprMaxCompiledRegexes, 20);
+  }
+
   /// Returns true if spilling is enabled.
   bool spillEnabled() const {
     return get<bool>(kSpillEnabled, false);
@@ -497,12 +843,20 @@ class QueryConfig {
     return get<bool>(kAggregationSpillEnabled, true);
   }
 
+  int32_t aggregationCompactionFragmentationPct() const {
+    return get<int32_t>(kAggregationCompactionFragmentationPct, 0);
+  }
+
   /// Returns 'is join spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool joinSpillEnabled() const {
     return get<bool>(kJoinSpillEnabled, true);
   }
 
+  bool joinSpillSerializedRows() const {
+    return get<bool>(kJoinSpillSerializedRows, false);
+  }
+
   /// Returns 'is orderby spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool orderBySpillEnabled() const {
@@ -537,6 +891,10 @@ class QueryConfig {
     return get<int32_t>(kMaxSpillLevel, 1);
   }
 
+  uint64_t hashJoinSpillRestoreChunkBytes() const {
+    return get<uint64_t>(kHashJoinSpillRestoreChunkBytes, 0);
+  }
+
   /// Returns the start partition bit which is used with
   /// 'kJoinSpillPartitionBits' or 'kAggregationSpillPartitionBits' together to
   /// calculate the spilling partition number for join spill or aggregation
@@ -583,6 +941,22 @@ class QueryConfig {
     return get<std::string>(kSpillCompressionKind, "none");
   }
 
+  bool spillEncodeSortedRuns() const {
+    return get<bool>(kSpillEncodeSortedRuns, false);
+  }
+
+  bool spillAsyncIo() const {
+    return get<bool>(kSpillAsyncIo, false);
+  }
+
+  std::string spillRemoteDirectory() const {
+    return get<std::string>(kSpillRemoteDirectory, "");
+  }
+
+  uint64_t spillLocalBytesThreshold() const {
+    return get<uint64_t>(kSpillLocalBytesThreshold, 0);
+  }
+
   uint64_t spillWriteBufferSize() const {
     // The default write buffer size set to 1MB.
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
@@ -657,10 +1031,18 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  bool exprProfilingEnabled() const {
+    return get<bool>(kExprProfilingEnabled, false);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -674,6 +1056,14 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  uint64_t hashJoinBloomFilterMaxSize() const {
+    return get<uint64_t>(kHashJoinBloomFilterMaxSize, 0);
+  }
+
+  bool hashProbeRadixPartitioningEnabled() const {
+    return get<bool>(kHashProbeRadixPartitioningEnabled, false);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
@@ -702,14 +1092,50 @@ class QueryConfig {
     return get<uint32_t>(kMaxSharedSubexprResultsCached, 10);
   }
 
+  uint64_t minSharedSubexprCostNanosPerRow() const {
+    return get<uint64_t>(kMinSharedSubexprCostNanosPerRow, 0);
+  }
+
+  uint64_t maxDictionaryMemoBytes() const {
+    return get<uint64_t>(kMaxDictionaryMemoBytes, 16UL << 20);
+  }
+
   int32_t maxSplitPreloadPerDriver() const {
     return get<int32_t>(kMaxSplitPreloadPerDriver, 2);
   }
 
+  uint64_t splitPreloadMemoryBudget() const {
+    return get<uint64_t>(kSplitPreloadMemoryBudget, 0);
+  }
+
+  uint64_t splitGroupMemoryBudget() const {
+    return get<uint64_t>(kSplitGroupMemoryBudget, 0);
+  }
+
   uint32_t driverCpuTimeSliceLimitMs() const {
     return get<uint32_t>(kDriverCpuTimeSliceLimitMs, 0);
   }
 
+  uint64_t driverPriorityQuantumMs() const {
+    return get<uint64_t>(kDriverPriorityQuantumMs, 0);
+  }
+
+  bool driverResumeAtBlockedOperator() const {
+    return get<bool>(kDriverResumeAtBlockedOperator, false);
+  }
+
+  uint32_t maxRunningDriversPerTask() const {
+    return get<uint32_t>(kMaxRunningDriversPerTask, 0);
+  }
+
+  bool driverFuseOperatorChains() const {
+    return get<bool>(kDriverFuseOperatorChains, false);
+  }
+
+  int32_t driverTimelineCapacity() const {
+    return get<int32_t>(kDriverTimelineCapacity, 0);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -108,16 +108,28 @@ uint64_t QueryCtx::MemoryReclaimer::reclaim(
   return memory::MemoryReclaimer::reclaim(pool, targetBytes, maxWaitMs, stats);
 }
 
+int32_t QueryCtx::MemoryReclaimer::priority() const {
+  auto queryCtx = ensureQueryCtx();
+  if (queryCtx == nullptr) {
+    return 0;
+  }
+  return queryCtx->queryConfig().queryArbitrationPriority();
+}
+
 bool QueryCtx::checkUnderArbitration(ContinueFuture* future) {
   VELOX_CHECK_NOT_NULL(future);
-  std::lock_guard<std::mutex> l(mutex_);
-  if (!underArbitration_) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (underArbitration_) {
+      arbitrationPromises_.emplace_back("QueryCtx::waitArbitration");
+      *future = arbitrationPromises_.back().getSemiFuture();
+      return true;
+    }
     VELOX_CHECK(arbitrationPromises_.empty());
-    return false;
   }
-  arbitrationPromises_.emplace_back("QueryCtx::waitArbitration");
-  *future = arbitrationPromises_.back().getSemiFuture();
-  return true;
+  // If a memory request of this query is in arbitration, the next request
+  // from the caller would queue behind it and block the thread.
+  return pool_->checkArbitrationRunning(future);
 }
 
 void QueryCtx::startArbitration() {
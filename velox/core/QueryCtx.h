@@ -20,6 +20,7 @@
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/time/Timer.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
@@ -106,13 +107,39 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
 
   /// Checks if the associated query is under memory arbitration or not. The
   /// function returns true if it is and set future which is fulfilled when the
-  /// the memory arbiration finishes.
+  /// the memory arbiration finishes. This is either a reclaim from the query
+  /// or a running memory arbitration request of the query.
   bool checkUnderArbitration(ContinueFuture* future);
 
   /// Updates the aggregated spill bytes of this query, and and throws if
   /// exceeds the max spill bytes limit.
   void updateSpilledBytesAndCheckLimit(uint64_t bytes);
 
+  /// Removes 'bytes' moved out of the local spill directories from the
+  /// aggregated spill bytes of this query.
+  void releaseSpilledBytes(uint64_t bytes) {
+    numSpilledBytes_ -= bytes;
+  }
+
+  /// Returns the aggregated bytes this query spilled to local spill
+  /// directories.
+  uint64_t spilledBytes() const {
+    return numSpilledBytes_;
+  }
+
+  /// Adds 'timeMs' a driver of this query ran on a thread before going off
+  /// thread.
+  void addDriverExecTimeMs(uint64_t timeMs) {
+    driverExecTimeMs_ += timeMs;
+  }
+
+  /// Returns the aggregated time the drivers of this query ran on threads.
+  /// Used to schedule drivers of queries that ran for less time first, see
+  /// QueryConfig::kDriverPriorityQuantumMs.
+  uint64_t driverExecTimeMs() const {
+    return driverExecTimeMs_;
+  }
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -154,11 +181,17 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
         uint64_t maxWaitMs,
         memory::MemoryReclaimer::Stats& stats) override;
 
+    int32_t priority() const override;
+
+    uint64_t startTimeMs() const override {
+      return startTimeMs_;
+    }
+
    protected:
     MemoryReclaimer(
         const std::shared_ptr<QueryCtx>& queryCtx,
         memory::MemoryPool* pool)
-        : queryCtx_(queryCtx), pool_(pool) {
+        : queryCtx_(queryCtx), pool_(pool), startTimeMs_(getCurrentTimeMs()) {
       VELOX_CHECK_NOT_NULL(pool_);
     }
 
@@ -172,6 +205,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
 
     const std::weak_ptr<QueryCtx> queryCtx_;
     memory::MemoryPool* const pool_;
+    const uint64_t startTimeMs_;
   };
 
   static Config* getEmptyConfig() {
@@ -206,6 +240,7 @@ class QueryCtx : public std::enable_shared_from_this<QueryCtx> {
   std::shared_ptr<memory::MemoryPool> pool_;
   QueryConfig queryConfig_;
   std::atomic<uint64_t> numSpilledBytes_{0};
+  std::atomic<uint64_t> driverExecTimeMs_{0};
 
   mutable std::mutex mutex_;
   // Indicates if this query is under memory arbitration or not.
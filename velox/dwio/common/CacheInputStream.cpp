@@ -241,6 +241,7 @@ void CacheInputStream::loadSync(const Region& region) {
     // Missed memory cache. Trying to load from ssd cache, and if again
     // missed, fall back to remote fetching.
     entry->setGroupId(groupId_);
+    entry->setTag(bufferedInput_->cacheTag());
     entry->setTrackingId(trackingId_);
     if (loadFromSsd(region, *entry)) {
       return;
@@ -17,6 +17,7 @@
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -298,11 +299,13 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
+      uint64_t cacheTag,
       std::vector<CacheRequest*> requests)
       : CoalescedLoad(makeKeys(requests), makeSizes(requests)),
         cache_(cache),
         ioStats_(std::move(ioStats)),
-        groupId_(groupId) {
+        groupId_(groupId),
+        cacheTag_(cacheTag) {
     requests_.reserve(requests.size());
     for (const auto& request : requests) {
       size_ += request->size;
@@ -373,6 +376,7 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   std::vector<CacheRequest> requests_;
   std::shared_ptr<IoStatistics> ioStats_;
   const uint64_t groupId_;
+  const uint64_t cacheTag_;
   int64_t size_{0};
 };
 
@@ -384,11 +388,19 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<ReadFileInputStream> input,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
+      uint64_t cacheTag,
       std::vector<CacheRequest*> requests,
-      int32_t maxCoalesceDistance)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
+      int32_t maxCoalesceDistance,
+      std::shared_ptr<io::IoTuner> ioTuner)
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            cacheTag,
+            std::move(requests)),
         input_(std::move(input)),
-        maxCoalesceDistance_(maxCoalesceDistance) {}
+        maxCoalesceDistance_(maxCoalesceDistance),
+        ioTuner_(std::move(ioTuner)) {}
 
   std::vector<CachePin> loadData(bool prefetch) override {
     std::vector<CachePin> pins;
@@ -400,6 +412,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setTag(cacheTag_);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
@@ -415,7 +428,18 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t readUs{0};
+          {
+            MicrosecondTimer timer(&readUs);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (ioTuner_ != nullptr) {
+            uint64_t bytes{0};
+            for (const auto& buffer : buffers) {
+              bytes += buffer.size();
+            }
+            ioTuner_->recordRead(input_->getName(), bytes, readUs);
+          }
         });
     updateStats(stats, prefetch, false);
     return pins;
@@ -423,6 +447,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
 
   std::shared_ptr<ReadFileInputStream> input_;
   const int32_t maxCoalesceDistance_;
+  const std::shared_ptr<io::IoTuner> ioTuner_;
 };
 
 // Represents a CoalescedLoad from local SSD cache.
@@ -432,8 +457,14 @@ class SsdLoad : public DwioCoalescedLoadBase {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
+      uint64_t cacheTag,
       std::vector<CacheRequest*> requests)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)) {}
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            cacheTag,
+            std::move(requests)) {}
 
   std::vector<CachePin> loadData(bool prefetch) override {
     std::vector<SsdPin> ssdPins;
@@ -445,6 +476,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (prefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setTag(cacheTag_);
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -469,15 +501,18 @@ void CachedBufferedInput::readRegion(
 
   std::shared_ptr<cache::CoalescedLoad> load;
   if (!requests[0]->ssdPin.empty()) {
-    load = std::make_shared<SsdLoad>(*cache_, ioStats_, groupId_, requests);
+    load = std::make_shared<SsdLoad>(
+        *cache_, ioStats_, groupId_, options_.cacheTag(), requests);
   } else {
     load = std::make_shared<DwioCoalescedLoad>(
         *cache_,
         input_,
         ioStats_,
         groupId_,
+        options_.cacheTag(),
         requests,
-        options_.maxCoalesceDistance());
+        options_.maxCoalesceDistance(),
+        options_.ioTuner());
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
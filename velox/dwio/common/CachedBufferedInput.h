@@ -22,6 +22,7 @@
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/IoTuner.h"
 #include "velox/common/io/Options.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -77,7 +78,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(
+            io::IoTuner::tunedOptions(readerOptions, input_->getName())) {}
 
   CachedBufferedInput(
       std::shared_ptr<ReadFileInputStream> input,
@@ -96,7 +98,8 @@ class CachedBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(
+            io::IoTuner::tunedOptions(readerOptions, input_->getName())) {}
 
   ~CachedBufferedInput() override {
     for (auto& load : allCoalescedLoads_) {
@@ -148,6 +151,12 @@ class CachedBufferedInput : public BufferedInput {
     return cache_;
   }
 
+  /// Returns the tag of the cache entries loaded by 'this'. See
+  /// io::ReaderOptions::setCacheTag().
+  uint64_t cacheTag() const {
+    return options_.cacheTag();
+  }
+
   /// Returns the CoalescedLoad that contains the correlated loads for 'stream'
   /// or nullptr if none. Returns nullptr on all but first call for 'stream'
   /// since the load is to be triggered by the first access.
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/DecompressedStreamCache.h"
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+// Size of the header of an ORC compression block.
+constexpr int32_t kBlockHeaderSize = 3;
+} // namespace
+
+DecompressedStreamCache::DecompressedStreamCache(
+    uint64_t maxBytes,
+    uint64_t maxStreamBytes,
+    int32_t minLookups)
+    : maxStreamBytes_(maxStreamBytes),
+      minLookups_(minLookups),
+      cache_(maxBytes) {
+  VELOX_CHECK_GT(minLookups_, 0);
+}
+
+std::shared_ptr<const DecompressedStreamCache::Entry>
+DecompressedStreamCache::find(
+    const Key& key,
+    uint64_t compressedLength,
+    bool& admit) {
+  admit = false;
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* value = cache_.get(key);
+  if (value != nullptr) {
+    auto entry = *value;
+    cache_.release(key);
+    return entry;
+  }
+  if (compressedLength > maxStreamBytes_) {
+    return nullptr;
+  }
+  if (candidates_.size() >= kMaxCandidates) {
+    candidates_.clear();
+  }
+  admit = ++candidates_[key] >= minLookups_;
+  return nullptr;
+}
+
+bool DecompressedStreamCache::insert(
+    const Key& key,
+    std::shared_ptr<const Entry> entry) {
+  VELOX_CHECK_NOT_NULL(entry);
+  const auto bytes = entry->bytes();
+  std::lock_guard<std::mutex> l(mutex_);
+  candidates_.erase(key);
+  auto value =
+      std::make_unique<std::shared_ptr<const Entry>>(std::move(entry));
+  if (!cache_.add(key, value.get(), bytes)) {
+    return false;
+  }
+  value.release();
+  return true;
+}
+
+SimpleLRUCacheStats DecompressedStreamCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+void DecompressedStreamCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+  candidates_.clear();
+}
+
+// static
+std::shared_ptr<const DecompressedStreamCache::Entry>
+DecompressedStreamCache::decompress(
+    SeekableInputStream& compressed,
+    const MakeDecompressor& makeDecompressor) {
+  std::string compressedData;
+  const void* chunk;
+  int32_t size;
+  while (compressed.Next(&chunk, &size)) {
+    compressedData.append(static_cast<const char*>(chunk), size);
+  }
+
+  auto entry = std::make_shared<Entry>();
+  uint64_t offset = 0;
+  while (offset < compressedData.size()) {
+    VELOX_CHECK_LE(
+        offset + kBlockHeaderSize,
+        compressedData.size(),
+        "Truncated compression block header");
+    const auto* header =
+        reinterpret_cast<const uint8_t*>(compressedData.data() + offset);
+    const uint32_t blockLength =
+        (header[0] | (header[1] << 8) | (header[2] << 16)) >> 1;
+    const auto blockEnd = offset + kBlockHeaderSize + blockLength;
+    VELOX_CHECK_LE(
+        blockEnd, compressedData.size(), "Truncated compression block");
+    entry->compressedOffsets.push_back(offset);
+    entry->offsets.push_back(entry->data.size());
+    auto decompressor =
+        makeDecompressor(std::make_unique<SeekableArrayInputStream>(
+            compressedData.data() + offset, blockEnd - offset));
+    while (decompressor->Next(&chunk, &size)) {
+      entry->data.append(static_cast<const char*>(chunk), size);
+    }
+    offset = blockEnd;
+  }
+  entry->data.shrink_to_fit();
+  return entry;
+}
+
+DecompressedInputStream::DecompressedInputStream(
+    std::shared_ptr<const DecompressedStreamCache::Entry> entry,
+    std::string name)
+    : name_(std::move(name)), entry_(std::move(entry)) {
+  VELOX_CHECK_NOT_NULL(entry_);
+}
+
+void DecompressedInputStream::ensureLoaded() {
+  if (input_ != nullptr) {
+    return;
+  }
+  if (entry_ == nullptr) {
+    entry_ = load_();
+    load_ = nullptr;
+    VELOX_CHECK_NOT_NULL(entry_);
+  }
+  input_ = std::make_unique<SeekableArrayInputStream>(
+      entry_->data.data(), entry_->data.size());
+}
+
+bool DecompressedInputStream::Next(const void** data, int32_t* size) {
+  ensureLoaded();
+  return input_->Next(data, size);
+}
+
+void DecompressedInputStream::BackUp(int32_t count) {
+  ensureLoaded();
+  input_->BackUp(count);
+}
+
+bool DecompressedInputStream::SkipInt64(int64_t count) {
+  ensureLoaded();
+  return input_->SkipInt64(count);
+}
+
+google::protobuf::int64 DecompressedInputStream::ByteCount() const {
+  return input_ == nullptr ? 0 : input_->ByteCount();
+}
+
+void DecompressedInputStream::seekToPosition(PositionProvider& position) {
+  ensureLoaded();
+  const auto compressedOffset = position.next();
+  const auto uncompressedOffset = position.next();
+  const auto& blocks = entry_->compressedOffsets;
+  const auto it =
+      std::lower_bound(blocks.begin(), blocks.end(), compressedOffset);
+  uint64_t offset;
+  if (it == blocks.end()) {
+    // Seek to the end of the stream.
+    VELOX_CHECK_EQ(uncompressedOffset, 0);
+    offset = entry_->data.size();
+  } else {
+    VELOX_CHECK_EQ(
+        *it,
+        compressedOffset,
+        "Seek to {} is not at a compression block of {}",
+        compressedOffset,
+        name_);
+    offset = entry_->offsets[it - blocks.begin()] + uncompressedOffset;
+  }
+  VELOX_CHECK_LE(offset, entry_->data.size());
+  std::vector<uint64_t> positions{offset};
+  PositionProvider provider(positions);
+  input_->seekToPosition(provider);
+}
+
+std::string DecompressedInputStream::getName() const {
+  return fmt::format("DecompressedInputStream {}", name_);
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Process wide cache of the decompressed contents of compressed ORC/DWRF
+/// streams. The AsyncDataCache holds file bytes, so that every read of a
+/// cached stream still decompresses it. For small, frequently read tables,
+/// e.g. dimension tables that are joined by many queries, this keeps the
+/// decompressed streams instead. A stream is added only after it has been
+/// looked up 'minLookups' times, so that data that is read once does not
+/// displace the hot streams. Thread safe.
+class DecompressedStreamCache {
+ public:
+  /// Identifies a stream by file and by its offset in the file.
+  struct Key {
+    std::string fileName;
+    uint64_t offset;
+
+    bool operator==(const Key& other) const {
+      return offset == other.offset && fileName == other.fileName;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      return bits::hashMix(
+          folly::hasher<std::string>()(key.fileName), key.offset);
+    }
+  };
+
+  /// The decompressed contents of a stream.
+  struct Entry {
+    std::string data;
+
+    /// Offset of each compression block in the compressed stream, ascending.
+    std::vector<uint64_t> compressedOffsets;
+
+    /// Offset in 'data' of the decompressed contents of each block in
+    /// 'compressedOffsets'.
+    std::vector<uint64_t> offsets;
+
+    uint64_t bytes() const {
+      return data.size() + compressedOffsets.size() * 2 * sizeof(uint64_t);
+    }
+  };
+
+  /// Makes a decompressing stream over a compressed stream.
+  using MakeDecompressor = std::function<std::unique_ptr<SeekableInputStream>(
+      std::unique_ptr<SeekableInputStream>)>;
+
+  /// 'maxBytes' is the capacity of the cache. Streams larger than
+  /// 'maxStreamBytes' compressed are not cached.
+  DecompressedStreamCache(
+      uint64_t maxBytes,
+      uint64_t maxStreamBytes,
+      int32_t minLookups = 2);
+
+  /// Returns the contents of the stream at 'key' or nullptr if not cached.
+  /// Counts the lookup for admission. On a miss, sets 'admit' to true if the
+  /// stream of 'compressedLength' bytes should be added with insert() once
+  /// decompressed.
+  std::shared_ptr<const Entry>
+  find(const Key& key, uint64_t compressedLength, bool& admit);
+
+  /// Adds 'entry' for 'key'. Returns false if 'key' is already cached or
+  /// 'entry' does not fit.
+  bool insert(const Key& key, std::shared_ptr<const Entry> entry);
+
+  SimpleLRUCacheStats stats() const;
+
+  void clear();
+
+  /// Reads all of 'compressed', which consists of ORC compression blocks
+  /// with 3 byte headers, and decompresses it block by block with
+  /// 'makeDecompressor'.
+  static std::shared_ptr<const Entry> decompress(
+      SeekableInputStream& compressed,
+      const MakeDecompressor& makeDecompressor);
+
+ private:
+  // Upper limit on the keys that are counted for admission. The counts are
+  // cleared when this is exceeded.
+  static constexpr int32_t kMaxCandidates = 10'000;
+
+  const uint64_t maxStreamBytes_;
+  const int32_t minLookups_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<
+      Key,
+      std::shared_ptr<const Entry>,
+      std::equal_to<Key>,
+      KeyHasher>
+      cache_;
+  // Number of lookups of keys that are not in 'cache_'.
+  folly::F14FastMap<Key, int32_t, KeyHasher> candidates_;
+};
+
+/// Stream over the decompressed contents of a compressed stream. Accepts the
+/// same positions as the decompressing stream, i.e. the offset of a
+/// compression block followed by the offset in the decompressed block. The
+/// contents are got from 'load' on first access.
+class DecompressedInputStream : public SeekableInputStream {
+ public:
+  using Load =
+      std::function<std::shared_ptr<const DecompressedStreamCache::Entry>()>;
+
+  DecompressedInputStream(Load load, std::string name)
+      : load_(std::move(load)), name_(std::move(name)) {}
+
+  DecompressedInputStream(
+      std::shared_ptr<const DecompressedStreamCache::Entry> entry,
+      std::string name);
+
+  bool Next(const void** data, int32_t* size) override;
+  void BackUp(int32_t count) override;
+  bool SkipInt64(int64_t count) override;
+  google::protobuf::int64 ByteCount() const override;
+  void seekToPosition(PositionProvider& position) override;
+  std::string getName() const override;
+
+  size_t positionSize() override {
+    return 2;
+  }
+
+ private:
+  void ensureLoaded();
+
+  Load load_;
+  const std::string name_;
+  std::shared_ptr<const DecompressedStreamCache::Entry> entry_;
+  std::unique_ptr<SeekableArrayInputStream> input_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -15,8 +15,12 @@
  */
 
 #include "velox/dwio/common/DirectBufferedInput.h"
+
+#include <folly/executors/InlineExecutor.h>
+
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/DirectInputStream.h"
 
 DECLARE_int32(cache_prefetch_min_pct);
@@ -178,10 +182,19 @@ void DirectBufferedInput::makeLoads(
         ++numNewLoads;
         readRegion(ranges, prefetch);
       });
-  if (prefetch && executor_) {
+  // With a native asynchronous read the IO is started here without occupying
+  // an executor thread until it completes.
+  const bool readAsync = input_->hasReadAsync();
+  if (prefetch && (executor_ || readAsync)) {
     for (auto i = 0; i < coalescedLoads_.size(); ++i) {
       auto& load = coalescedLoads_[i];
-      if (load->state() == CoalescedLoad::State::kPlanned) {
+      if (load->state() != CoalescedLoad::State::kPlanned) {
+        continue;
+      }
+      if (readAsync) {
+        DirectCoalescedLoad::loadAsync(
+            std::static_pointer_cast<DirectCoalescedLoad>(load));
+      } else {
         executor_->add([pendingLoad = load]() {
           process::TraceContext trace("Read Ahead");
           pendingLoad->loadOrFuture(nullptr);
@@ -198,7 +211,13 @@ void DirectBufferedInput::readRegion(
     return;
   }
   auto load = std::make_shared<DirectCoalescedLoad>(
-      input_, ioStats_, groupId_, requests, *pool_, options_.loadQuantum());
+      input_,
+      ioStats_,
+      groupId_,
+      requests,
+      *pool_,
+      options_.loadQuantum(),
+      options_.ioTuner());
   coalescedLoads_.push_back(load);
   streamToCoalescedLoad_.withWLock([&](auto& loads) {
     for (auto& request : requests) {
@@ -237,7 +256,8 @@ void appendRanges(
 }
 } // namespace
 
-std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
+std::vector<folly::Range<char*>> DirectCoalescedLoad::makeBuffers(
+    ReadInfo& info) {
   std::vector<folly::Range<char*>> buffers;
   int64_t lastEnd = requests_[0].region.offset;
   int64_t size = 0;
@@ -275,15 +295,86 @@ std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
     size += std::min<int32_t>(loadQuantum_, region.length);
   }
 
-  input_->read(buffers, requests_[0].region.offset, LogType::FILE);
-  ioStats_->read().increment(size);
-  ioStats_->incRawOverreadBytes(overread);
+  info.end = lastEnd;
+  info.size = size;
+  info.overread = overread;
+  return buffers;
+}
+
+void DirectCoalescedLoad::recordRead(
+    const ReadInfo& info,
+    uint64_t readUs,
+    bool prefetch) {
+  if (ioTuner_ != nullptr) {
+    ioTuner_->recordRead(
+        input_->getName(), info.end - requests_[0].region.offset, readUs);
+  }
+  ioStats_->read().increment(info.size);
+  ioStats_->incRawOverreadBytes(info.overread);
   if (prefetch) {
-    ioStats_->prefetch().increment(size);
+    ioStats_->prefetch().increment(info.size);
   }
+}
+
+std::vector<cache::CachePin> DirectCoalescedLoad::loadData(bool prefetch) {
+  ReadInfo info;
+  auto buffers = makeBuffers(info);
+  uint64_t readUs{0};
+  {
+    MicrosecondTimer timer(&readUs);
+    input_->read(buffers, requests_[0].region.offset, LogType::FILE);
+  }
+  recordRead(info, readUs, prefetch);
   return {};
 }
 
+// static
+void DirectCoalescedLoad::loadAsync(std::shared_ptr<DirectCoalescedLoad> self) {
+  {
+    std::lock_guard<std::mutex> l(self->mutex_);
+    if (self->state_ != State::kPlanned) {
+      return;
+    }
+    self->state_ = State::kLoading;
+  }
+  ReadInfo info;
+  const auto startUs = getCurrentTimeMicro();
+  auto read = folly::SemiFuture<uint64_t>::makeEmpty();
+  try {
+    auto buffers = self->makeBuffers(info);
+    read = self->input_->readAsync(
+        buffers, self->requests_[0].region.offset, LogType::FILE);
+  } catch (const std::exception& e) {
+    VLOG(1) << "Failed to start read of " << self->input_->getName() << ": "
+            << e.what();
+    self->failLoad();
+    return;
+  }
+  std::move(read)
+      .via(&folly::InlineExecutor::instance())
+      .thenTry([self = std::move(self), info, startUs](
+                   folly::Try<uint64_t>&& result) {
+        if (result.hasException()) {
+          VLOG(1) << "Failed read of " << self->input_->getName() << ": "
+                  << result.exception().what();
+          self->failLoad();
+          return;
+        }
+        self->recordRead(info, getCurrentTimeMicro() - startUs, true);
+        self->setEndState(State::kLoaded);
+      });
+}
+
+void DirectCoalescedLoad::failLoad() {
+  // The streams read their regions by themselves.
+  for (auto& request : requests_) {
+    pool_.freeNonContiguous(request.data);
+    request.tinyData.clear();
+    request.loadSize = 0;
+  }
+  setEndState(State::kCancelled);
+}
+
 int32_t DirectCoalescedLoad::getData(
     int64_t offset,
     memory::Allocation& data,
@@ -22,6 +22,7 @@
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/io/IoStatistics.h"
+#include "velox/common/io/IoTuner.h"
 #include "velox/common/io/Options.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/CacheInputStream.h"
@@ -56,12 +57,14 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
       uint64_t groupId,
       const std::vector<LoadRequest*>& requests,
       memory::MemoryPool& pool,
-      int32_t loadQuantum)
+      int32_t loadQuantum,
+      std::shared_ptr<io::IoTuner> ioTuner = nullptr)
       : CoalescedLoad({}, {}),
         ioStats_(ioStats),
         groupId_(groupId),
         input_(std::move(input)),
         loadQuantum_(loadQuantum),
+        ioTuner_(std::move(ioTuner)),
         pool_(pool) {
     requests_.reserve(requests.size());
     for (auto i = 0; i < requests.size(); ++i) {
@@ -73,6 +76,13 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   /// data is retrieved with getData().
   std::vector<cache::CachePin> loadData(bool prefetch) override;
 
+  /// Starts loading 'self' with an asynchronous read if it is planned and
+  /// returns without waiting for the read. 'self' is kept alive until the
+  /// read completes. Streams that need the data meanwhile wait in
+  /// loadOrFuture(). If the read fails, getData() returns 0 and the streams
+  /// read their regions by themselves.
+  static void loadAsync(std::shared_ptr<DirectCoalescedLoad> self);
+
   /// Returns the buffer for 'region' in either 'data' or 'tinyData'. 'region'
   /// must match a region given to DirectBufferedInput::enqueue().
   int32_t
@@ -91,10 +101,30 @@ class DirectCoalescedLoad : public cache::CoalescedLoad {
   }
 
  private:
+  // Extent of a coalesced read for the IO stats.
+  struct ReadInfo {
+    // End offset of the read.
+    int64_t end{0};
+    // Bytes read for the requests.
+    int64_t size{0};
+    // Bytes read in gaps between the requests.
+    int64_t overread{0};
+  };
+
+  // Allocates the buffers of 'requests_' and returns the ranges to read into,
+  // including the gaps between requests.
+  std::vector<folly::Range<char*>> makeBuffers(ReadInfo& info);
+
+  void recordRead(const ReadInfo& info, uint64_t readUs, bool prefetch);
+
+  // Frees the buffers after a failed asynchronous read and cancels 'this'.
+  void failLoad();
+
   const std::shared_ptr<IoStatistics> ioStats_;
   const uint64_t groupId_;
   const std::shared_ptr<ReadFileInputStream> input_;
   const int32_t loadQuantum_;
+  const std::shared_ptr<io::IoTuner> ioTuner_;
   memory::MemoryPool& pool_;
   std::vector<LoadRequest> requests_;
 };
@@ -122,7 +152,8 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(
+            io::IoTuner::tunedOptions(readerOptions, input_->getName())) {}
 
   ~DirectBufferedInput() override {
     for (auto& load : coalescedLoads_) {
@@ -193,7 +224,8 @@ class DirectBufferedInput : public BufferedInput {
         ioStats_(std::move(ioStats)),
         executor_(executor),
         fileSize_(input_->getLength()),
-        options_(readerOptions) {}
+        options_(
+            io::IoTuner::tunedOptions(readerOptions, input_->getName())) {}
 
   // Sorts requests and makes CoalescedLoads for nearby requests. If 'prefetch'
   // is true, starts background loading.
@@ -208,6 +208,43 @@ inline void unpack4x1(int32_t bytes, int16_t*& output) {
   output += 4;
 }
 
+// Returns true if each of the 32 bytes at 'input' is a complete varint.
+inline bool isSingleByteVarints32(const char* input) {
+  return _mm256_movemask_epi8(_mm256_loadu_si256(
+             reinterpret_cast<const __m256i*>(input))) == 0;
+}
+
+// Stores each of the 32 bytes at 'input' as a T at output[0] ... output[31].
+// Unlike unpack4x1, does not write past output[31].
+template <typename T>
+inline void unpack32x1(const char* input, T*& output) {
+  auto* out = reinterpret_cast<__m256i*>(output);
+  if constexpr (sizeof(T) == 8) {
+    for (auto i = 0; i < 8; ++i) {
+      _mm256_storeu_si256(
+          out + i,
+          _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(
+              folly::loadUnaligned<int32_t>(input + 4 * i))));
+    }
+  } else if constexpr (sizeof(T) == 4) {
+    for (auto i = 0; i < 4; ++i) {
+      _mm256_storeu_si256(
+          out + i,
+          _mm256_cvtepu8_epi32(_mm_loadl_epi64(
+              reinterpret_cast<const __m128i*>(input + 8 * i))));
+    }
+  } else {
+    static_assert(sizeof(T) == 2);
+    for (auto i = 0; i < 2; ++i) {
+      _mm256_storeu_si256(
+          out + i,
+          _mm256_cvtepu8_epi16(_mm_loadu_si128(
+              reinterpret_cast<const __m128i*>(input + 16 * i))));
+    }
+  }
+  output += 32;
+}
+
 #else
 
 template <typename T>
@@ -940,6 +977,19 @@ void IntDecoder<isSigned>::bulkRead(uint64_t size, T* result) {
       pos += maskSize;
       const auto word = folly::loadUnaligned<uint64_t>(pos);
       const uint64_t controlBits = bits::extractBits<uint64_t>(word, mask);
+#if XSIMD_WITH_AVX2
+      // Small values are common enough to take 32 single byte varints at a
+      // time when the word is all single byte varints.
+      if (controlBits == 0 && end - output >= 32 && bufferEnd - pos >= 32 &&
+          isSingleByteVarints32(pos)) {
+        unpack32x1(pos, output);
+        applyCarryover(carryoverBits, carryover, output - 32);
+        carryover = 0ULL;
+        carryoverBits = 0;
+        pos += 32 - maskSize;
+        continue;
+      }
+#endif
       varintSwitch(word, controlBits, pos, output, carryover, carryoverBits);
     }
     if (pos) {
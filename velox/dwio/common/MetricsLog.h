@@ -103,6 +103,11 @@ class MetricsLog {
     float averageRowSize;
     uint64_t stripeSizeEstimate;
     uint64_t groupSize;
+    // Number of column encodings in the stripe that use a dictionary.
+    uint32_t dictionaryEncodings;
+    // Number of columns that switched from dictionary to direct encoding in
+    // the stripe.
+    uint32_t abandonedDictionaries;
     bool close;
   };
 
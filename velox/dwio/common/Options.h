@@ -37,6 +37,8 @@
 
 namespace facebook::velox::dwio::common {
 
+class DecompressedStreamCache;
+
 enum class FileFormat {
   UNKNOWN = 0,
   DWRF = 1, // DWRF
@@ -124,6 +126,7 @@ class RowReaderOptions {
   bool preloadStripe;
   bool projectSelectedType;
   bool returnFlatVector_ = false;
+  bool integerDictionaryOutput_ = false;
   ErrorTolerance errorTolerance_;
   std::shared_ptr<ColumnSelector> selector_;
   std::shared_ptr<velox::common::ScanSpec> scanSpec_ = nullptr;
@@ -157,6 +160,8 @@ class RowReaderOptions {
   bool eagerFirstStripeLoad = true;
   uint64_t skipRows_ = 0;
   std::shared_ptr<UnitLoaderFactory> unitLoaderFactory_;
+  // Optional cache of decompressed streams shared between readers.
+  std::shared_ptr<DecompressedStreamCache> decompressedStreamCache_;
 
   TimestampPrecision timestampPrecision_ = TimestampPrecision::kMilliseconds;
 
@@ -267,6 +272,16 @@ class RowReaderOptions {
     returnFlatVector_ = value;
   }
 
+  // For dictionary encoded integer columns, return dictionary vectors over
+  // the stripe dictionary instead of flat vectors when there is no filter.
+  bool integerDictionaryOutput() const {
+    return integerDictionaryOutput_;
+  }
+
+  void setIntegerDictionaryOutput(bool value) {
+    integerDictionaryOutput_ = value;
+  }
+
   /**
    * Request that the selected type be projected.
    */
@@ -412,6 +427,18 @@ class RowReaderOptions {
     return decodingExecutor_;
   }
 
+  /// Sets a cache of decompressed streams. Readers that support it look up
+  /// compressed streams in the cache before reading and decompressing them.
+  void setDecompressedStreamCache(
+      std::shared_ptr<DecompressedStreamCache> cache) {
+    decompressedStreamCache_ = std::move(cache);
+  }
+
+  const std::shared_ptr<DecompressedStreamCache>& decompressedStreamCache()
+      const {
+    return decompressedStreamCache_;
+  }
+
   size_t getDecodingParallelismFactor() const {
     return decodingParallelismFactor_;
   }
@@ -451,6 +478,7 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold_ = other.filePreloadThreshold_;
     fileColumnNamesReadAsLowerCase_ = other.fileColumnNamesReadAsLowerCase_;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    fileVersion_ = other.fileVersion_;
     return *this;
   }
 
@@ -464,8 +492,8 @@ class ReaderOptions : public io::ReaderOptions {
         footerEstimatedSize_(other.footerEstimatedSize_),
         filePreloadThreshold_(other.filePreloadThreshold_),
         fileColumnNamesReadAsLowerCase_(other.fileColumnNamesReadAsLowerCase_),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
-  }
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        fileVersion_(other.fileVersion_) {}
 
   /// Sets the format of the file, such as "rc" or "dwrf". The default is
   /// "dwrf".
@@ -526,6 +554,14 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets an identifier of the contents of the file, e.g. its modification
+  /// time or etag. Readers cache file metadata across readers of the same file
+  /// only if this is set.
+  ReaderOptions& setFileVersion(std::string version) {
+    fileVersion_ = std::move(version);
+    return *this;
+  }
+
   /// Gets the desired tail location.
   uint64_t tailLocation() const {
     return tailLocation_;
@@ -573,6 +609,10 @@ class ReaderOptions : public io::ReaderOptions {
     return useColumnNamesForColumnMapping_;
   }
 
+  const std::string& fileVersion() const {
+    return fileVersion_;
+  }
+
   const std::shared_ptr<random::RandomSkipTracker>& randomSkip() const {
     return randomSkip_;
   }
@@ -599,6 +639,7 @@ class ReaderOptions : public io::ReaderOptions {
   uint64_t filePreloadThreshold_{kDefaultFilePreloadThreshold};
   bool fileColumnNamesReadAsLowerCase_{false};
   bool useColumnNamesForColumnMapping_{false};
+  std::string fileVersion_;
   std::shared_ptr<folly::Executor> ioExecutor_;
   std::shared_ptr<random::RandomSkipTracker> randomSkip_;
 };
@@ -615,6 +656,10 @@ struct WriterOptions {
   std::optional<uint64_t> maxDictionaryMemory{std::nullopt};
   std::map<std::string, std::string> serdeParameters;
   std::optional<uint8_t> parquetWriteTimestampUnit;
+  /// Executor and maximum number of parallel tasks for writing the columns of
+  /// a batch. Used by the DWRF writer.
+  std::shared_ptr<folly::Executor> columnWriteExecutor;
+  size_t columnWriteParallelism{8};
 };
 
 } // namespace facebook::velox::dwio::common
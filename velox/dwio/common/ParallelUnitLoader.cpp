@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+
+#include <numeric>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+#include "velox/dwio/common/ParallelFor.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class ParallelUnitLoader : public UnitLoader {
+ public:
+  ParallelUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      folly::Executor* executor,
+      size_t maxLoadedUnits,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback)
+      : loadUnits_{std::move(loadUnits)},
+        executor_{executor},
+        maxLoadedUnits_{maxLoadedUnits},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        loaded_(loadUnits_.size(), false) {}
+
+  ~ParallelUnitLoader() override = default;
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK(unit < loadUnits_.size(), "Unit out of range");
+
+    if (loaded_[unit]) {
+      // The reader moved forward inside the loaded window. Free the units it
+      // has passed.
+      unloadIf([&](uint32_t i) { return i < unit; });
+      return *loadUnits_[unit];
+    }
+
+    unloadIf([](uint32_t /*i*/) { return true; });
+    const size_t end =
+        std::min<size_t>(unit + maxLoadedUnits_, loadUnits_.size());
+    {
+      auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+      ParallelFor(executor_, unit, end, end - unit).execute([&](size_t i) {
+        loadUnits_[i]->load();
+        loaded_[i] = true;
+      });
+    }
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+ private:
+  template <typename Predicate>
+  void unloadIf(Predicate predicate) {
+    for (uint32_t i = 0; i < loadUnits_.size(); ++i) {
+      if (loaded_[i] && predicate(i)) {
+        loadUnits_[i]->unload();
+        loaded_[i] = false;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  folly::Executor* const executor_;
+  const size_t maxLoadedUnits_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  // True for the units that are currently loaded. Not a vector<bool> since
+  // the flags of different units are set from different threads.
+  std::vector<uint8_t> loaded_;
+};
+
+} // namespace
+
+ParallelUnitLoaderFactory::ParallelUnitLoaderFactory(
+    folly::Executor* executor,
+    size_t maxLoadedUnits,
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback)
+    : executor_{executor},
+      maxLoadedUnits_{maxLoadedUnits},
+      blockedOnIoCallback_{std::move(blockedOnIoCallback)} {
+  VELOX_CHECK_GT(maxLoadedUnits_, 0, "Must load at least one unit at a time");
+}
+
+std::unique_ptr<UnitLoader> ParallelUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  return std::make_unique<ParallelUnitLoader>(
+      std::move(loadUnits), executor_, maxLoadedUnits_, blockedOnIoCallback_);
+}
+
+} // namespace facebook::velox::dwio::common
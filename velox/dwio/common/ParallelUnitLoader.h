@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include "folly/Executor.h"
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Creates unit loaders that load up to 'maxLoadedUnits' consecutive units
+/// (stripes or row groups) of a split concurrently on 'executor'. When the
+/// reader asks for a unit that is not loaded, all loaded units are unloaded and
+/// the window of units starting at the requested one is loaded in parallel.
+/// Units behind the reader are unloaded as it advances, so at most
+/// 'maxLoadedUnits' units are held in memory. Units are returned in the order
+/// the reader asks for them. Loads run inline if 'executor' is nullptr or
+/// 'maxLoadedUnits' is 1, which is equivalent to OnDemandUnitLoaderFactory.
+class ParallelUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  ParallelUnitLoaderFactory(
+      folly::Executor* executor,
+      size_t maxLoadedUnits,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback);
+
+  ~ParallelUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  folly::Executor* const executor_;
+  const size_t maxLoadedUnits_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+
+#include <numeric>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/MeasureTime.h"
+#include "velox/dwio/common/Statistics.h"
+
+using facebook::velox::dwio::common::measureTimeIfCallback;
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+class PrefetchUnitLoader : public UnitLoader {
+ public:
+  PrefetchUnitLoader(
+      std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+      folly::Executor* executor,
+      size_t maxPrefetchUnits,
+      uint64_t maxPrefetchBytes,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback)
+      : loadUnits_{std::move(loadUnits)},
+        executor_{executor},
+        maxPrefetchUnits_{maxPrefetchUnits},
+        maxPrefetchBytes_{maxPrefetchBytes},
+        blockedOnIoCallback_{std::move(blockedOnIoCallback)},
+        loads_(loadUnits_.size()),
+        loaded_(loadUnits_.size(), false) {}
+
+  ~PrefetchUnitLoader() override {
+    // Background loads reference 'loadUnits_'.
+    for (auto& load : loads_) {
+      if (load != nullptr) {
+        load->close();
+      }
+    }
+  }
+
+  LoadUnit& getLoadedUnit(uint32_t unit) override {
+    VELOX_CHECK(unit < loadUnits_.size(), "Unit out of range");
+
+    // Free the units the reader has passed or skipped over.
+    for (uint32_t i = 0; i < loadUnits_.size(); ++i) {
+      if (i < unit || i > unit + maxPrefetchUnits_) {
+        unload(i);
+      }
+    }
+
+    if (!loaded_[unit]) {
+      if (loads_[unit] != nullptr && loads_[unit]->hasValue()) {
+        ++numHits_;
+        // Rethrows errors from the background load.
+        loads_[unit]->move();
+      } else {
+        ++numMisses_;
+        auto measure = measureTimeIfCallback(blockedOnIoCallback_);
+        if (loads_[unit] != nullptr) {
+          // Waits for the background load, or loads on this thread if it has
+          // not started.
+          loads_[unit]->move();
+        } else {
+          loadUnits_[unit]->load();
+        }
+      }
+      loads_[unit] = nullptr;
+      loaded_[unit] = true;
+    }
+    prefetch(unit);
+    return *loadUnits_[unit];
+  }
+
+  void onRead(uint32_t unit, uint64_t rowOffsetInUnit, uint64_t /* rowCount */)
+      override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LT(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void onSeek(uint32_t unit, uint64_t rowOffsetInUnit) override {
+    VELOX_CHECK_LT(unit, loadUnits_.size(), "Unit out of range");
+    VELOX_CHECK_LE(
+        rowOffsetInUnit, loadUnits_[unit]->getNumRows(), "Row out of range");
+  }
+
+  void updateRuntimeStats(RuntimeStatistics& stats) const override {
+    stats.unitPrefetchHits += numHits_;
+    stats.unitPrefetchMisses += numMisses_;
+  }
+
+ private:
+  // Schedules background loads of the units after 'unit' within the limits.
+  void prefetch(uint32_t unit) {
+    if (executor_ == nullptr) {
+      return;
+    }
+    const size_t end =
+        std::min<size_t>(unit + 1 + maxPrefetchUnits_, loadUnits_.size());
+    uint64_t prefetchBytes = 0;
+    for (auto i = unit + 1; i < end; ++i) {
+      // Called on this thread so that units that set up their readers in
+      // getIoSize() do it in order and not concurrently with the reader.
+      const auto ioSize = loadUnits_[i]->getIoSize();
+      if (!loaded_[i] && loads_[i] == nullptr) {
+        if (prefetchBytes + ioSize > maxPrefetchBytes_) {
+          break;
+        }
+        auto* loadUnit = loadUnits_[i].get();
+        loads_[i] = std::make_shared<AsyncSource<bool>>([loadUnit]() {
+          loadUnit->load();
+          return std::make_unique<bool>(true);
+        });
+        executor_->add([load = loads_[i]]() { load->prepare(); });
+      }
+      prefetchBytes += ioSize;
+    }
+  }
+
+  void unload(uint32_t unit) {
+    if (loads_[unit] != nullptr) {
+      // Waits for a running load and cancels one that has not started.
+      loads_[unit]->close();
+      if (loads_[unit]->hasValue()) {
+        loadUnits_[unit]->unload();
+      }
+      loads_[unit] = nullptr;
+    } else if (loaded_[unit]) {
+      loadUnits_[unit]->unload();
+      loaded_[unit] = false;
+    }
+  }
+
+  std::vector<std::unique_ptr<LoadUnit>> loadUnits_;
+  folly::Executor* const executor_;
+  const size_t maxPrefetchUnits_;
+  const uint64_t maxPrefetchBytes_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+  // Background loads of units that the reader has not got yet.
+  std::vector<std::shared_ptr<AsyncSource<bool>>> loads_;
+  // True for the units that the reader has got and that are loaded.
+  std::vector<bool> loaded_;
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+};
+
+} // namespace
+
+PrefetchUnitLoaderFactory::PrefetchUnitLoaderFactory(
+    folly::Executor* executor,
+    size_t maxPrefetchUnits,
+    uint64_t maxPrefetchBytes,
+    std::function<void(std::chrono::high_resolution_clock::duration)>
+        blockedOnIoCallback)
+    : executor_{executor},
+      maxPrefetchUnits_{maxPrefetchUnits},
+      maxPrefetchBytes_{maxPrefetchBytes},
+      blockedOnIoCallback_{std::move(blockedOnIoCallback)} {}
+
+std::unique_ptr<UnitLoader> PrefetchUnitLoaderFactory::create(
+    std::vector<std::unique_ptr<LoadUnit>> loadUnits,
+    uint64_t rowsToSkip) {
+  const auto totalRows = std::accumulate(
+      loadUnits.cbegin(), loadUnits.cend(), 0UL, [](uint64_t sum, auto& unit) {
+        return sum + unit->getNumRows();
+      });
+  VELOX_CHECK_LE(
+      rowsToSkip,
+      totalRows,
+      "Can only skip up to the past-the-end row of the file.");
+  return std::make_unique<PrefetchUnitLoader>(
+      std::move(loadUnits),
+      executor_,
+      maxPrefetchUnits_,
+      maxPrefetchBytes_,
+      blockedOnIoCallback_);
+}
+
+} // namespace facebook::velox::dwio::common
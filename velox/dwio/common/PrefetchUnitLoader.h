@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include "folly/Executor.h"
+#include "velox/dwio/common/UnitLoader.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Creates unit loaders that load the units (stripes or row groups) after the
+/// one being read in the background on 'executor', so that the reader does not
+/// wait for IO at unit boundaries. Up to 'maxPrefetchUnits' units ahead of the
+/// reader are prefetched as long as the IO size of the prefetched units stays
+/// within 'maxPrefetchBytes'. getIoSize() of a unit is called on the reader
+/// thread before the unit is scheduled and load() on 'executor'. Units are not
+/// prefetched if 'executor' is nullptr. The loader counts the units that were
+/// loaded by the time the reader got to them as prefetch hits and the others
+/// as misses.
+class PrefetchUnitLoaderFactory
+    : public velox::dwio::common::UnitLoaderFactory {
+ public:
+  PrefetchUnitLoaderFactory(
+      folly::Executor* executor,
+      size_t maxPrefetchUnits,
+      uint64_t maxPrefetchBytes,
+      std::function<void(std::chrono::high_resolution_clock::duration)>
+          blockedOnIoCallback);
+
+  ~PrefetchUnitLoaderFactory() override = default;
+
+  std::unique_ptr<velox::dwio::common::UnitLoader> create(
+      std::vector<std::unique_ptr<velox::dwio::common::LoadUnit>> loadUnits,
+      uint64_t rowsToSkip) override;
+
+ private:
+  folly::Executor* const executor_;
+  const size_t maxPrefetchUnits_;
+  const uint64_t maxPrefetchBytes_;
+  std::function<void(std::chrono::high_resolution_clock::duration)>
+      blockedOnIoCallback_;
+};
+
+} // namespace facebook::velox::dwio::common
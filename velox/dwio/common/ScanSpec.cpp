@@ -33,6 +33,10 @@ ScanSpec* ScanSpec::getOrCreateChild(const Subfield& subfield) {
       container->children_.push_back(std::make_unique<ScanSpec>(*element));
       auto* child = container->children_.back().get();
       container->childByFieldName_[child->fieldName()] = child;
+      // Keep a stable order built for an earlier split complete.
+      if (!container->stableChildren_.empty()) {
+        container->stableChildren_.push_back(child);
+      }
       container = child;
     }
   }
@@ -379,7 +383,14 @@ std::string ScanSpec::toString() const {
 }
 
 void ScanSpec::addFilter(const Filter& filter) {
-  filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
+  if (!filter_) {
+    filter_ = filter.clone();
+  } else if (filter.kind() == FilterKind::kBigintValuesUsingBloomFilter) {
+    // Only the Bloom filter knows how to combine itself with other filters.
+    filter_ = filter.mergeWith(filter_.get());
+  } else {
+    filter_ = filter_->mergeWith(&filter);
+  }
 }
 
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
@@ -336,6 +336,17 @@ class ScanSpec {
     isFlatMapAsStruct_ = value;
   }
 
+  /// When true, a flat map column read as MAP produces its keys as a
+  /// dictionary over the distinct keys of the stripe instead of copying the
+  /// key into every map entry.
+  bool isFlatMapKeysAsDictionary() const {
+    return isFlatMapKeysAsDictionary_;
+  }
+
+  void setFlatMapKeysAsDictionary(bool value) {
+    isFlatMapKeysAsDictionary_ = value;
+  }
+
  private:
   void reorder();
 
@@ -419,6 +430,10 @@ class ScanSpec {
   // This node represents a flat map column that need to be read as struct,
   // i.e. in table schema it is a MAP, but in result vector it is ROW.
   bool isFlatMapAsStruct_ = false;
+
+  // This node represents a flat map column whose result keys are dictionary
+  // encoded over the keys present in the stripe.
+  bool isFlatMapKeysAsDictionary_ = false;
 };
 
 template <typename F>
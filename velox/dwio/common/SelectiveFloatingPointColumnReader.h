@@ -171,6 +171,10 @@ void SelectiveFloatingPointColumnReader<TData, TRequested>::processValueHook(
           rows,
           ExtractToHook<aggregate::MinMaxHook<TRequested, true>>(hook));
       break;
+    case aggregate::AggregationHook::kCount:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(), rows, ExtractToHook<aggregate::CountHook>(hook));
+      break;
     default:
       readHelper<Reader, velox::common::AlwaysTrue, isDense>(
           &alwaysTrue(), rows, ExtractToGenericHook(hook));
@@ -21,6 +21,25 @@
 
 namespace facebook::velox::dwio::common {
 
+namespace {
+
+// Sets 'field' to 'size' copies of the value of 'constant'. Reuses 'field' if
+// it already holds the value, so that partition keys and other constant
+// columns are not rewrapped for every batch.
+void setConstantField(
+    const VectorPtr& constant,
+    vector_size_t size,
+    VectorPtr& field) {
+  if (field && field->isConstantEncoding() && field.unique() &&
+      field->size() > 0 && field->equalValueAt(constant.get(), 0, 0)) {
+    field->resize(size);
+  } else {
+    field = BaseVector::wrapInConstant(size, 0, constant);
+  }
+}
+
+} // namespace
+
 void SelectiveStructColumnReaderBase::filterRowGroups(
     uint64_t rowGroupSize,
     const dwio::common::StatsContext& context,
@@ -112,8 +131,10 @@ void SelectiveStructColumnReaderBase::next(
       VELOX_CHECK(childSpec->isConstant());
       if (childSpec->projectOut()) {
         auto channel = childSpec->channel();
-        resultRowVector->childAt(channel) = BaseVector::wrapInConstant(
-            numValues, 0, childSpec->constantValue());
+        setConstantField(
+            childSpec->constantValue(),
+            numValues,
+            resultRowVector->childAt(channel));
       }
     }
     return;
@@ -307,18 +328,6 @@ VectorPtr tryReuseResult(const VectorPtr& result) {
   }
 }
 
-void setConstantField(
-    const VectorPtr& constant,
-    vector_size_t size,
-    VectorPtr& field) {
-  if (field && field->isConstantEncoding() && field.unique() &&
-      field->size() > 0 && field->equalValueAt(constant.get(), 0, 0)) {
-    field->resize(size);
-  } else {
-    field = BaseVector::wrapInConstant(size, 0, constant);
-  }
-}
-
 void setNullField(
     vector_size_t size,
     VectorPtr& field,
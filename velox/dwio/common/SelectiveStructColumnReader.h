@@ -213,6 +213,9 @@ class SelectiveFlatMapColumnReaderHelper {
     if (auto type = reader_.requestedType_->type()->childAt(1); type->isRow()) {
       childValues_ = BaseVector::create(type, 0, &reader_.memoryPool_);
     }
+    if (reader_.scanSpec_->isFlatMapKeysAsDictionary()) {
+      makeKeyDictionary();
+    }
   }
 
   void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls);
@@ -233,6 +236,19 @@ class SelectiveFlatMapColumnReaderHelper {
     return *result->asUnchecked<MapVector>();
   }
 
+  // Builds the distinct keys of the stripe once so that the result keys can
+  // be indices into them instead of a copy of the key per map entry.
+  void makeKeyDictionary() {
+    auto keys = BaseVector::create<FlatVector<T>>(
+        reader_.requestedType_->type()->childAt(0),
+        keyNodes_.size(),
+        &reader_.memoryPool_);
+    for (int k = 0; k < keyNodes_.size(); ++k) {
+      keys->set(k, keyNodes_[k].key.get());
+    }
+    keyDictionary_ = std::move(keys);
+  }
+
   static void readInMapDense(
       const uint64_t* inMap,
       vector_size_t size,
@@ -242,19 +258,28 @@ class SelectiveFlatMapColumnReaderHelper {
   vector_size_t
   calculateOffsets(RowSet rows, vector_size_t* offsets, vector_size_t* sizes);
 
-  template <bool kDirectCopy, bool kIdentityMapping, typename ValueType>
+  template <
+      bool kDirectCopy,
+      bool kIdentityMapping,
+      bool kKeyIndices,
+      typename ValueType>
   void copyValuesImpl(
       vector_size_t* rawOffsets,
       T* rawKeys,
+      vector_size_t* rawKeyIndices,
       detail::FlatMapDirectCopyHelper<ValueType>& directCopy,
       T key,
+      vector_size_t keyIndex,
       const uint64_t* columnBits,
       vector_size_t size);
 
+  // Either 'flatKeys' or 'rawKeyIndices' is set, depending on whether the keys
+  // are copied or dictionary encoded over 'keyDictionary_'.
   template <TypeKind kKind>
   void copyValues(
       RowSet rows,
       FlatVector<T>* flatKeys,
+      vector_size_t* rawKeyIndices,
       vector_size_t* rawOffsets,
       BaseVector& values);
 
@@ -265,6 +290,9 @@ class SelectiveFlatMapColumnReaderHelper {
   std::vector<uint64_t> columnRowBits_;
   int columnBitsWords_;
   std::vector<BaseVector::CopyRange> copyRanges_;
+  // Distinct keys of the stripe, set when the result keys are dictionary
+  // encoded.
+  FlatVectorPtr<T> keyDictionary_;
 };
 
 template <typename T, typename KeyNode, typename FormatData>
@@ -406,17 +434,27 @@ SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::calculateOffsets(
 // Otherwise store the copy ranges and they will be copied after calling this
 // function.
 template <typename T, typename KeyNode, typename FormatData>
-template <bool kDirectCopy, bool kIdentityMapping, typename ValueType>
+template <
+    bool kDirectCopy,
+    bool kIdentityMapping,
+    bool kKeyIndices,
+    typename ValueType>
 void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyValuesImpl(
     vector_size_t* rawOffsets,
     T* rawKeys,
+    vector_size_t* rawKeyIndices,
     detail::FlatMapDirectCopyHelper<ValueType>& directCopy,
     T key,
+    vector_size_t keyIndex,
     const uint64_t* columnBits,
     vector_size_t size) {
   bits::forEachSetBit(columnBits, 0, size, [&](vector_size_t i) {
     auto j = rawOffsets[i]++;
-    rawKeys[j] = key;
+    if constexpr (kKeyIndices) {
+      rawKeyIndices[j] = keyIndex;
+    } else {
+      rawKeys[j] = key;
+    }
     if constexpr (!kDirectCopy) {
       copyRanges_.push_back({
           .sourceIndex = i,
@@ -445,6 +483,7 @@ template <TypeKind kKind>
 void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyValues(
     RowSet rows,
     FlatVector<T>* flatKeys,
+    vector_size_t* rawKeyIndices,
     vector_size_t* rawOffsets,
     BaseVector& values) {
   // String values are not copied directly because currently we don't have
@@ -452,12 +491,12 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyValues(
   constexpr bool kDirectCopy =
       TypeKind::TINYINT <= kKind && kKind <= TypeKind::DOUBLE;
   using ValueType = typename TypeTraits<kKind>::NativeType;
-  T* rawKeys = flatKeys->mutableRawValues();
+  T* rawKeys = flatKeys ? flatKeys->mutableRawValues() : nullptr;
   [[maybe_unused]] size_t strKeySize;
   [[maybe_unused]] char* rawStrKeyBuffer;
   if constexpr (std::is_same_v<T, StringView>) {
     strKeySize = 0;
-    for (int k = 0; k < reader_.children_.size(); ++k) {
+    for (int k = 0; rawKeys && k < reader_.children_.size(); ++k) {
       if (!keyNodes_[k].key.get().isInline()) {
         strKeySize += keyNodes_[k].key.get().size();
       }
@@ -490,7 +529,7 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyValues(
     T key;
     if constexpr (std::is_same_v<T, StringView>) {
       key = keyNodes_[k].key.get();
-      if (!key.isInline()) {
+      if (rawKeys && !key.isInline()) {
         key = {&rawStrKeyBuffer[strKeySize], static_cast<int32_t>(key.size())};
         strKeySize += key.size();
       }
@@ -506,12 +545,49 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::copyValues(
       }
     }
     auto* columnBits = columnRowBits_.data() + k * columnBitsWords_;
-    if (decodedChildValues_.isIdentityMapping()) {
-      copyValuesImpl<kDirectCopy, true>(
-          rawOffsets, rawKeys, directCopy, key, columnBits, rows.size());
+    const bool identityMapping = decodedChildValues_.isIdentityMapping();
+    if (rawKeyIndices) {
+      if (identityMapping) {
+        copyValuesImpl<kDirectCopy, true, true>(
+            rawOffsets,
+            rawKeys,
+            rawKeyIndices,
+            directCopy,
+            key,
+            k,
+            columnBits,
+            rows.size());
+      } else {
+        copyValuesImpl<kDirectCopy, false, true>(
+            rawOffsets,
+            rawKeys,
+            rawKeyIndices,
+            directCopy,
+            key,
+            k,
+            columnBits,
+            rows.size());
+      }
+    } else if (identityMapping) {
+      copyValuesImpl<kDirectCopy, true, false>(
+          rawOffsets,
+          rawKeys,
+          rawKeyIndices,
+          directCopy,
+          key,
+          k,
+          columnBits,
+          rows.size());
     } else {
-      copyValuesImpl<kDirectCopy, false>(
-          rawOffsets, rawKeys, directCopy, key, columnBits, rows.size());
+      copyValuesImpl<kDirectCopy, false, false>(
+          rawOffsets,
+          rawKeys,
+          rawKeyIndices,
+          directCopy,
+          key,
+          k,
+          columnBits,
+          rows.size());
     }
     if constexpr (kDirectCopy) {
       if (directCopy.sourceNulls && decodedChildValues_.isIdentityMapping()) {
@@ -540,11 +616,26 @@ void SelectiveFlatMapColumnReaderHelper<T, KeyNode, FormatData>::getValues(
   auto numNestedRows = calculateOffsets(rows, rawOffsets, rawSizes);
   auto& keys = mapResult.mapKeys();
   auto& values = mapResult.mapValues();
-  BaseVector::prepareForReuse(keys, numNestedRows);
   BaseVector::prepareForReuse(values, numNestedRows);
-  auto* flatKeys = keys->template asFlatVector<T>();
+  FlatVector<T>* flatKeys = nullptr;
+  vector_size_t* rawKeyIndices = nullptr;
+  if (keyDictionary_) {
+    auto indices = allocateIndices(numNestedRows, &reader_.memoryPool_);
+    rawKeyIndices = indices->template asMutable<vector_size_t>();
+    keys = BaseVector::wrapInDictionary(
+        nullptr, std::move(indices), numNestedRows, keyDictionary_);
+  } else {
+    BaseVector::prepareForReuse(keys, numNestedRows);
+    flatKeys = keys->template asFlatVector<T>();
+  }
   VELOX_DYNAMIC_TYPE_DISPATCH(
-      copyValues, values->typeKind(), rows, flatKeys, rawOffsets, *values);
+      copyValues,
+      values->typeKind(),
+      rows,
+      flatKeys,
+      rawKeyIndices,
+      rawOffsets,
+      *values);
   VELOX_CHECK_EQ(rawOffsets[rows.size() - 1], numNestedRows);
   std::copy_backward(
       rawOffsets, rawOffsets + rows.size() - 1, rawOffsets + rows.size());
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/common/SortingWriter.h"
+#include "velox/dwio/common/ZOrder.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -22,10 +23,12 @@ SortingWriter::SortingWriter(
     std::unique_ptr<Writer> writer,
     std::unique_ptr<exec::SortBuffer> sortBuffer,
     uint32_t maxOutputRowsConfig,
-    uint64_t maxOutputBytesConfig)
+    uint64_t maxOutputBytesConfig,
+    std::vector<column_index_t> zOrderColumns)
     : outputWriter_(std::move(writer)),
       maxOutputRowsConfig_(maxOutputRowsConfig),
       maxOutputBytesConfig_(maxOutputBytesConfig),
+      zOrderColumns_(std::move(zOrderColumns)),
       sortPool_(sortBuffer->pool()),
       canReclaim_(sortBuffer->canSpill()),
       sortBuffer_(std::move(sortBuffer)) {
@@ -43,7 +46,11 @@ SortingWriter::~SortingWriter() {
 
 void SortingWriter::write(const VectorPtr& data) {
   checkRunning();
-  sortBuffer_->addInput(data);
+  if (zOrderColumns_.empty()) {
+    sortBuffer_->addInput(data);
+  } else {
+    sortBuffer_->addInput(addZOrderKeys(data));
+  }
 }
 
 void SortingWriter::flush() {
@@ -58,6 +65,9 @@ void SortingWriter::close() {
   const auto maxOutputBatchRows = outputBatchRows();
   RowVectorPtr output = sortBuffer_->getOutput(maxOutputBatchRows);
   while (output != nullptr) {
+    if (!zOrderColumns_.empty()) {
+      output = removeZOrderKeys(output);
+    }
     outputWriter_->write(output);
     output = sortBuffer_->getOutput(maxOutputBatchRows);
   }
@@ -111,6 +121,40 @@ uint64_t SortingWriter::reclaim(
       stats);
 }
 
+VectorPtr SortingWriter::addZOrderKeys(const VectorPtr& data) const {
+  const auto* input = data->asChecked<RowVector>();
+  const auto& type = input->type()->asRow();
+  auto names = type.names();
+  auto types = type.children();
+  auto children = input->children();
+  names.push_back("$zorder");
+  types.push_back(VARBINARY());
+  children.push_back(makeZOrderKeys(*input, zOrderColumns_, sortPool_));
+  return std::make_shared<RowVector>(
+      sortPool_,
+      ROW(std::move(names), std::move(types)),
+      nullptr,
+      input->size(),
+      std::move(children));
+}
+
+RowVectorPtr SortingWriter::removeZOrderKeys(
+    const RowVectorPtr& output) const {
+  const auto& type = output->type()->asRow();
+  auto names = type.names();
+  auto types = type.children();
+  auto children = output->children();
+  names.pop_back();
+  types.pop_back();
+  children.pop_back();
+  return std::make_shared<RowVector>(
+      output->pool(),
+      ROW(std::move(names), std::move(types)),
+      nullptr,
+      output->size(),
+      std::move(children));
+}
+
 uint32_t SortingWriter::outputBatchRows() {
   uint32_t estimatedMaxOutputRows = UINT_MAX;
   if (sortBuffer_->estimateOutputRowSize().has_value() &&
@@ -25,11 +25,16 @@ namespace facebook::velox::dwio::common {
 /// Sorting Writer object is used to write sorted data into a single file.
 class SortingWriter : public Writer {
  public:
+  /// If 'zOrderColumns' is not empty, the rows are sorted on the Z-order of
+  /// these columns. 'sortBuffer' then has an extra VARBINARY column after the
+  /// written columns for the Z-order value and sorts on it. The value is
+  /// computed by write() and not written to the file.
   SortingWriter(
       std::unique_ptr<Writer> writer,
       std::unique_ptr<exec::SortBuffer> sortBuffer,
       uint32_t maxOutputRowsConfig,
-      uint64_t maxOutputBytesConfig);
+      uint64_t maxOutputBytesConfig,
+      std::vector<column_index_t> zOrderColumns = {});
 
   ~SortingWriter() override;
 
@@ -75,9 +80,16 @@ class SortingWriter : public Writer {
 
   uint32_t outputBatchRows();
 
+  // Returns 'data' with the Z-order value of 'zOrderColumns_' appended.
+  VectorPtr addZOrderKeys(const VectorPtr& data) const;
+
+  // Returns 'output' without the Z-order value.
+  RowVectorPtr removeZOrderKeys(const RowVectorPtr& output) const;
+
   const std::unique_ptr<Writer> outputWriter_;
   const uint32_t maxOutputRowsConfig_;
   const uint64_t maxOutputBytesConfig_;
+  const std::vector<column_index_t> zOrderColumns_;
   memory::MemoryPool* const sortPool_;
   const bool canReclaim_;
 
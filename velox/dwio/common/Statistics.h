@@ -535,6 +535,15 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of rows skipped inside strides, e.g. in Parquet pages whose
+  // statistics in the page index show no value passes the filters.
+  int64_t skippedPageRows{0};
+
+  // Number of units (stripes or row groups) that were prefetched by the time
+  // the reader got to them and number of units the reader waited for.
+  int64_t unitPrefetchHits{0};
+  int64_t unitPrefetchMisses{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
@@ -543,6 +552,9 @@ struct RuntimeStatistics {
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedPageRows", RuntimeCounter(skippedPageRows)},
+        {"unitPrefetchHits", RuntimeCounter(unitPrefetchHits)},
+        {"unitPrefetchMisses", RuntimeCounter(unitPrefetchMisses)},
         {"flattenStringDictionaryValues",
          RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
   }
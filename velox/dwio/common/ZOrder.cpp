@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ZOrder.h"
+
+#include <cstring>
+
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+
+constexpr uint64_t kSignBit = 1ULL << 63;
+
+// Maps a signed integer to an unsigned one with the same order.
+uint64_t normalizeInteger(int64_t value) {
+  return static_cast<uint64_t>(value) ^ kSignBit;
+}
+
+// Maps a double to an unsigned integer with the same order. Negative values
+// have all bits flipped so that larger magnitudes sort lower.
+uint64_t normalizeDouble(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & kSignBit) ? ~bits : bits ^ kSignBit;
+}
+
+// Maps the first 8 bytes of a string to an unsigned integer in byte order.
+uint64_t normalizeString(StringView value) {
+  uint64_t result = 0;
+  const auto size = std::min<int32_t>(value.size(), sizeof(uint64_t));
+  for (auto i = 0; i < size; ++i) {
+    result |= static_cast<uint64_t>(static_cast<uint8_t>(value.data()[i]))
+        << (56 - 8 * i);
+  }
+  return result;
+}
+
+template <typename T, typename Normalize>
+void normalizeColumn(
+    const DecodedVector& decoded,
+    Normalize normalize,
+    uint64_t* keys) {
+  for (vector_size_t row = 0; row < decoded.size(); ++row) {
+    keys[row] =
+        decoded.isNullAt(row) ? 0 : normalize(decoded.valueAt<T>(row));
+  }
+}
+
+// Fills 'keys' with the normalized values of 'decoded'.
+void normalizeKeys(
+    const TypePtr& type,
+    const DecodedVector& decoded,
+    uint64_t* keys) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return normalizeColumn<bool>(
+          decoded, [](bool value) { return value ? kSignBit : 0; }, keys);
+    case TypeKind::TINYINT:
+      return normalizeColumn<int8_t>(decoded, normalizeInteger, keys);
+    case TypeKind::SMALLINT:
+      return normalizeColumn<int16_t>(decoded, normalizeInteger, keys);
+    case TypeKind::INTEGER:
+      return normalizeColumn<int32_t>(decoded, normalizeInteger, keys);
+    case TypeKind::BIGINT:
+      return normalizeColumn<int64_t>(decoded, normalizeInteger, keys);
+    case TypeKind::REAL:
+      return normalizeColumn<float>(decoded, normalizeDouble, keys);
+    case TypeKind::DOUBLE:
+      return normalizeColumn<double>(decoded, normalizeDouble, keys);
+    case TypeKind::TIMESTAMP:
+      return normalizeColumn<Timestamp>(
+          decoded,
+          [](Timestamp value) { return normalizeInteger(value.getSeconds()); },
+          keys);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return normalizeColumn<StringView>(decoded, normalizeString, keys);
+    default:
+      VELOX_UNSUPPORTED("Unsupported Z-order key type: {}", type->toString());
+  }
+}
+
+} // namespace
+
+bool isZOrderKeyType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      // Long decimals are HUGEINT and not supported. Short decimals are BIGINT
+      // and are ordered as their unscaled values.
+      return true;
+    default:
+      return false;
+  }
+}
+
+VectorPtr makeZOrderKeys(
+    const RowVector& input,
+    const std::vector<column_index_t>& columns,
+    memory::MemoryPool* pool) {
+  VELOX_CHECK(!columns.empty());
+  const auto numRows = input.size();
+  const auto numKeys = columns.size();
+
+  // Normalized keys, one column after another.
+  std::vector<uint64_t> keys(numKeys * numRows);
+  SelectivityVector allRows(numRows);
+  DecodedVector decoded;
+  for (auto i = 0; i < numKeys; ++i) {
+    const auto& child = input.childAt(columns[i]);
+    decoded.decode(*child, allRows);
+    normalizeKeys(child->type(), decoded, keys.data() + i * numRows);
+  }
+
+  // Interleaves the bits of the keys from the most significant, so that the
+  // byte order of the result is the Z-order.
+  const auto width = numKeys * sizeof(uint64_t);
+  auto buffer = AlignedBuffer::allocate<char>(numRows * width, pool);
+  auto* rawBuffer = buffer->asMutable<char>();
+  std::memset(rawBuffer, 0, numRows * width);
+  auto result = BaseVector::create<FlatVector<StringView>>(
+      VARBINARY(), numRows, pool);
+  result->addStringBuffer(buffer);
+  for (vector_size_t row = 0; row < numRows; ++row) {
+    auto* value = reinterpret_cast<uint8_t*>(rawBuffer + row * width);
+    for (auto bit = 0; bit < 64; ++bit) {
+      for (auto i = 0; i < numKeys; ++i) {
+        if (keys[i * numRows + row] & (kSignBit >> bit)) {
+          const auto position = bit * numKeys + i;
+          value[position / 8] |= 0x80 >> (position % 8);
+        }
+      }
+    }
+    result->setNoCopy(
+        row, StringView(reinterpret_cast<const char*>(value), width));
+  }
+  return result;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Returns true if a column of 'type' can be a Z-order key.
+bool isZOrderKeyType(const TypePtr& type);
+
+/// Returns a VARBINARY vector with the Z-order (Morton) value of 'columns' for
+/// each row of 'input'. Sorting rows on the bytes of the values orders them on
+/// the Z-order curve over 'columns'. Each key is mapped to 64 bits that
+/// preserve its order and the bits of the keys are interleaved from the most
+/// significant. Strings are mapped on their first 8 bytes. Nulls map to 0 and
+/// sort first.
+VectorPtr makeZOrderKeys(
+    const RowVector& input,
+    const std::vector<column_index_t>& columns,
+    memory::MemoryPool* pool);
+
+} // namespace facebook::velox::dwio::common
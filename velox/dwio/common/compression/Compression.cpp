@@ -35,6 +35,17 @@ using memory::MemoryPool;
 
 namespace {
 
+// Returns the `ZSTD_CCtx' of the calling thread. `ZSTD_compress' creates and
+// frees a context of about 1MB at the default level for every compression
+// block, so reusing one saves an allocation and the context initialization
+// per block.
+ZSTD_CCtx* threadZstdCompressionContext() {
+  thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> context{
+      ZSTD_createCCtx(), ZSTD_freeCCtx};
+  DWIO_ENSURE_NOT_NULL(context, "Failed to create ZSTD compression context");
+  return context.get();
+}
+
 class ZstdCompressor : public Compressor {
  public:
   explicit ZstdCompressor(int32_t level) : Compressor{level} {}
@@ -44,7 +55,8 @@ class ZstdCompressor : public Compressor {
 
 uint64_t
 ZstdCompressor::compress(const void* src, void* dest, uint64_t length) {
-  auto ret = ZSTD_compress(dest, length, src, length, level_);
+  auto ret = ZSTD_compressCCtx(
+      threadZstdCompressionContext(), dest, length, src, length, level_);
   if (ZSTD_isError(ret)) {
     // it's fine to hit dest size too small
     if (ZSTD_getErrorCode(ret) == ZSTD_ErrorCode::ZSTD_error_dstSize_tooSmall) {
@@ -391,9 +403,20 @@ uint64_t Lz4Decompressor::decompressInternal(
   return static_cast<uint64_t>(result);
 }
 
-// NOTE: We do not keep `ZSTD_DCtx' around on purpose, because if we keep it
-// around, in flat map column reader we have hundreds of thousands of
-// decompressors at same time and causing OOM.
+// Returns the `ZSTD_DCtx' of the calling thread. `ZSTD_decompress' creates and
+// frees a context of over 100KB for every chunk, so reusing one saves an
+// allocation and the context initialization per chunk.
+ZSTD_DCtx* threadZstdDecompressionContext() {
+  thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> context{
+      ZSTD_createDCtx(), ZSTD_freeDCtx};
+  DWIO_ENSURE_NOT_NULL(context, "Failed to create ZSTD decompression context");
+  return context.get();
+}
+
+// NOTE: We do not keep `ZSTD_DCtx' in the decompressor on purpose, because if
+// we keep it around, in flat map column reader we have hundreds of thousands of
+// decompressors at same time and causing OOM. The context is instead shared by
+// all decompressors of a thread, since a chunk is decompressed in one call.
 class ZstdDecompressor : public Decompressor {
  public:
   explicit ZstdDecompressor(
@@ -417,7 +440,8 @@ uint64_t ZstdDecompressor::decompress(
     uint64_t srcLength,
     char* dest,
     uint64_t destLength) {
-  auto ret = ZSTD_decompress(dest, destLength, src, srcLength);
+  auto ret = ZSTD_decompressDCtx(
+      threadZstdDecompressionContext(), dest, destLength, src, srcLength);
   DWIO_ENSURE(
       !ZSTD_isError(ret),
       "ZSTD returned an error: ",
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/DecompressedStreamCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+namespace {
+
+// Appends an uncompressed ORC compression block of 'size' times 'c'.
+void appendOriginalBlock(std::string& stream, int32_t size, char c) {
+  const uint32_t header = (size << 1) | 1;
+  stream.push_back(header & 0xff);
+  stream.push_back((header >> 8) & 0xff);
+  stream.push_back((header >> 16) & 0xff);
+  stream.append(size, c);
+}
+
+// Decompresses a single uncompressed block by skipping its header.
+std::unique_ptr<SeekableInputStream> makeDecompressor(
+    std::unique_ptr<SeekableInputStream> input) {
+  std::string block;
+  const void* data;
+  int32_t size;
+  while (input->Next(&data, &size)) {
+    block.append(static_cast<const char*>(data), size);
+  }
+  auto payload = std::make_unique<char[]>(block.size() - 3);
+  ::memcpy(payload.get(), block.data() + 3, block.size() - 3);
+  return std::make_unique<SeekableArrayInputStream>(
+      std::move(payload), block.size() - 3);
+}
+
+std::string nextChunk(SeekableInputStream& stream) {
+  const void* data;
+  int32_t size;
+  if (!stream.Next(&data, &size)) {
+    return "";
+  }
+  return std::string(static_cast<const char*>(data), size);
+}
+
+class DecompressedStreamCacheTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    appendOriginalBlock(compressed_, 100, 'a');
+    appendOriginalBlock(compressed_, 50, 'b');
+    appendOriginalBlock(compressed_, 70, 'c');
+  }
+
+  std::shared_ptr<const DecompressedStreamCache::Entry> decompress() {
+    SeekableArrayInputStream input(
+        compressed_.data(), compressed_.size(), /*block_size=*/64);
+    return DecompressedStreamCache::decompress(input, makeDecompressor);
+  }
+
+  std::string compressed_;
+};
+
+TEST_F(DecompressedStreamCacheTest, decompress) {
+  auto entry = decompress();
+  ASSERT_EQ(entry->data.size(), 220);
+  ASSERT_EQ(
+      entry->data,
+      std::string(100, 'a') + std::string(50, 'b') + std::string(70, 'c'));
+  ASSERT_EQ(entry->compressedOffsets, (std::vector<uint64_t>{0, 103, 156}));
+  ASSERT_EQ(entry->offsets, (std::vector<uint64_t>{0, 100, 150}));
+
+  // Truncated streams are detected.
+  compressed_.resize(compressed_.size() - 1);
+  ASSERT_THROW(decompress(), facebook::velox::VeloxRuntimeError);
+}
+
+TEST_F(DecompressedStreamCacheTest, seek) {
+  DecompressedInputStream stream(decompress(), "test");
+  ASSERT_EQ(stream.positionSize(), 2);
+  ASSERT_EQ(nextChunk(stream).size(), 220);
+  ASSERT_EQ(stream.ByteCount(), 220);
+
+  std::vector<uint64_t> positions{103, 10, 0, 5, compressed_.size(), 0};
+  PositionProvider provider(positions);
+  stream.seekToPosition(provider);
+  ASSERT_EQ(nextChunk(stream), std::string(40, 'b') + std::string(70, 'c'));
+  stream.seekToPosition(provider);
+  ASSERT_EQ(nextChunk(stream).substr(0, 96), std::string(95, 'a') + "b");
+  stream.seekToPosition(provider);
+  ASSERT_EQ(nextChunk(stream), "");
+
+  // A seek must be to the start of a block.
+  std::vector<uint64_t> badPositions{104, 0};
+  PositionProvider badProvider(badPositions);
+  ASSERT_THROW(
+      stream.seekToPosition(badProvider), facebook::velox::VeloxRuntimeError);
+}
+
+TEST_F(DecompressedStreamCacheTest, lazyLoad) {
+  int32_t numLoads = 0;
+  DecompressedInputStream stream(
+      [&]() {
+        ++numLoads;
+        return decompress();
+      },
+      "test");
+  ASSERT_EQ(stream.ByteCount(), 0);
+  ASSERT_EQ(numLoads, 0);
+  std::vector<uint64_t> positions{156, 60};
+  PositionProvider provider(positions);
+  stream.seekToPosition(provider);
+  ASSERT_EQ(numLoads, 1);
+  ASSERT_EQ(nextChunk(stream), std::string(10, 'c'));
+  ASSERT_EQ(nextChunk(stream), "");
+  ASSERT_EQ(numLoads, 1);
+}
+
+TEST_F(DecompressedStreamCacheTest, admission) {
+  DecompressedStreamCache cache(1 << 20, 1'000, 2);
+  const DecompressedStreamCache::Key key{"file", 100};
+  bool admit;
+  // The first lookup does not admit.
+  ASSERT_EQ(cache.find(key, compressed_.size(), admit), nullptr);
+  ASSERT_FALSE(admit);
+  ASSERT_EQ(cache.find(key, compressed_.size(), admit), nullptr);
+  ASSERT_TRUE(admit);
+  auto entry = decompress();
+  ASSERT_TRUE(cache.insert(key, entry));
+  ASSERT_FALSE(cache.insert(key, entry));
+
+  ASSERT_EQ(cache.find(key, compressed_.size(), admit), entry);
+  ASSERT_FALSE(admit);
+  // Same offset in another file.
+  ASSERT_EQ(
+      cache.find({"otherFile", 100}, compressed_.size(), admit), nullptr);
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numElements, 1);
+  ASSERT_EQ(stats.curSize, entry->bytes());
+  ASSERT_EQ(stats.numHits, 1);
+
+  // Streams over the size limit are never admitted.
+  const DecompressedStreamCache::Key largeKey{"file", 2'000};
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_EQ(cache.find(largeKey, 1'001, admit), nullptr);
+    ASSERT_FALSE(admit);
+  }
+
+  cache.clear();
+  ASSERT_EQ(cache.find(key, compressed_.size(), admit), nullptr);
+  ASSERT_FALSE(admit);
+  ASSERT_EQ(cache.stats().numElements, 0);
+}
+
+} // namespace
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/io/IoTuner.h"
+#include "velox/common/memory/Memory.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::io;
+
+namespace {
+
+// Records reads of 1 to 'numSizes' MB from a backend with the given latency
+// and throughput.
+void recordReads(
+    IoTuner& tuner,
+    std::string_view fileName,
+    double latencyUs,
+    double bytesPerUs,
+    int32_t numSizes) {
+  for (auto i = 1; i <= numSizes; ++i) {
+    const uint64_t bytes = i << 20;
+    tuner.recordRead(fileName, bytes, latencyUs + bytes / bytesPerUs);
+  }
+}
+
+TEST(IoTunerTest, backend) {
+  ASSERT_EQ(IoTuner::backend("/tmp/file"), "file");
+  ASSERT_EQ(IoTuner::backend("file:/tmp/file"), "file");
+  ASSERT_EQ(IoTuner::backend("s3://bucket/key"), "s3");
+  ASSERT_EQ(IoTuner::backend("hdfs://host:8020/path"), "hdfs");
+}
+
+TEST(IoTunerTest, estimate) {
+  IoTuner tuner;
+  ASSERT_FALSE(tuner.estimate("s3://bucket/key").has_value());
+
+  // Too few samples.
+  recordReads(tuner, "s3://bucket/a", 20'000, 100, 8);
+  ASSERT_FALSE(tuner.estimate("s3://bucket/key").has_value());
+
+  // 20ms latency and 100MB/s. Latency * throughput is 2MB.
+  recordReads(tuner, "s3://bucket/b", 20'000, 100, 16);
+  auto s3 = tuner.estimate("s3://bucket/key");
+  ASSERT_TRUE(s3.has_value());
+  ASSERT_NEAR(s3->latencyUs, 20'000, 1);
+  ASSERT_NEAR(s3->bytesPerUs, 100, 0.01);
+  ASSERT_NEAR(s3->coalesceDistance, 2'000'000, 1'000);
+  ASSERT_NEAR(s3->loadQuantum, 8'000'000, 4'000);
+
+  // 100us latency and 2GB/s on local disk.
+  ASSERT_FALSE(tuner.estimate("/data/file").has_value());
+  recordReads(tuner, "/data/file", 100, 2'000, 16);
+  auto local = tuner.estimate("/other/file");
+  ASSERT_TRUE(local.has_value());
+  ASSERT_NEAR(local->latencyUs, 100, 1);
+  ASSERT_NEAR(local->coalesceDistance, 200'000, 2'000);
+  // The quantum is at least the minimum.
+  ASSERT_EQ(local->loadQuantum, IoTuner::Config().minLoadQuantum);
+}
+
+TEST(IoTunerTest, sameSizeReads) {
+  IoTuner tuner;
+  // Latency and throughput cannot be told apart if all reads have one size.
+  for (auto i = 0; i < 100; ++i) {
+    tuner.recordRead("s3://bucket/key", 1 << 20, 30'000);
+  }
+  ASSERT_FALSE(tuner.estimate("s3://bucket/key").has_value());
+}
+
+TEST(IoTunerTest, tunedOptions) {
+  memory::MemoryManager::testingSetInstance({});
+  auto pool = memory::memoryManager()->addLeafPool();
+  ReaderOptions options(pool.get());
+  options.setMaxCoalesceDistance(1234).setLoadQuantum(5678);
+
+  // No tuner.
+  auto tuned = IoTuner::tunedOptions(options, "s3://bucket/key");
+  ASSERT_EQ(tuned.maxCoalesceDistance(), 1234);
+  ASSERT_EQ(tuned.loadQuantum(), 5678);
+
+  auto tuner = std::make_shared<IoTuner>();
+  options.setIoTuner(tuner);
+  // No estimate yet.
+  tuned = IoTuner::tunedOptions(options, "s3://bucket/key");
+  ASSERT_EQ(tuned.maxCoalesceDistance(), 1234);
+  ASSERT_EQ(tuned.ioTuner(), tuner);
+
+  recordReads(*tuner, "s3://bucket/key", 20'000, 100, 16);
+  tuned = IoTuner::tunedOptions(options, "s3://bucket/other");
+  const auto estimate = tuner->estimate("s3://bucket/key");
+  ASSERT_EQ(tuned.maxCoalesceDistance(), estimate->coalesceDistance);
+  ASSERT_EQ(tuned.loadQuantum(), estimate->loadQuantum);
+  // Other backends keep the configured values.
+  tuned = IoTuner::tunedOptions(options, "/local/file");
+  ASSERT_EQ(tuned.maxCoalesceDistance(), 1234);
+  ASSERT_EQ(tuned.loadQuantum(), 5678);
+}
+
+} // namespace
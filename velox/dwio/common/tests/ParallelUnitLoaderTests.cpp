@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/ParallelUnitLoader.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using namespace ::testing;
+using facebook::velox::dwio::common::LoadUnit;
+using facebook::velox::dwio::common::ParallelUnitLoaderFactory;
+using facebook::velox::dwio::common::test::getUnitsLoadedWithFalse;
+using facebook::velox::dwio::common::test::LoadUnitMock;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+TEST(ParallelUnitLoaderTests, LoadsWindowInParallel) {
+  folly::CPUThreadPoolExecutor executor(4);
+  size_t blockedOnIoCount = 0;
+  ParallelUnitLoaderFactory factory(
+      &executor, 2, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, false}));
+  EXPECT_EQ(blockedOnIoCount, 0);
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9, load(0, 1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1), load(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+}
+
+TEST(ParallelUnitLoaderTests, LoadsInlineWithoutExecutor) {
+  ParallelUnitLoaderFactory factory(nullptr, 3, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, load(0, 1, 2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, true}));
+
+  EXPECT_TRUE(readerMock.read(7)); // Unit: 0, rows: 3-9
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, true}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+}
+
+TEST(ParallelUnitLoaderTests, CanSeek) {
+  folly::CPUThreadPoolExecutor executor(4);
+  size_t blockedOnIoCount = 0;
+  ParallelUnitLoaderFactory factory(
+      &executor, 2, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30, 40}, {0, 0, 0, 0}, factory, 0};
+
+  EXPECT_NO_THROW(readerMock.seek(10););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 1, rows: 0-2, load(1, 2)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_NO_THROW(readerMock.seek(0););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, unload(1, 2),
+                                   // load(0, 1)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({true, true, false, false}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+
+  EXPECT_NO_THROW(readerMock.seek(60););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 3, rows: 0-2, unload(0, 1),
+                                   // load(3)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(),
+      std::vector<bool>({false, false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 3);
+}
+
+TEST(ParallelUnitLoaderTests, UnitOutOfRange) {
+  ParallelUnitLoaderFactory factory(nullptr, 2, nullptr);
+  std::vector<std::atomic_bool> unitsLoaded(getUnitsLoadedWithFalse(1));
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<LoadUnitMock>(10, 0, unitsLoaded, 0));
+
+  auto unitLoader = factory.create(std::move(units), 0);
+  unitLoader->getLoadedUnit(0);
+  unitLoader->getLoadedUnit(0);
+  EXPECT_THAT(
+      [&]() { unitLoader->getLoadedUnit(1); },
+      Throws<facebook::velox::VeloxRuntimeError>(Property(
+          &facebook::velox::VeloxRuntimeError::message,
+          HasSubstr("Unit out of range"))));
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/executors/InlineExecutor.h>
+#include <folly/executors/ManualExecutor.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/PrefetchUnitLoader.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/common/tests/utils/UnitLoaderTestTools.h"
+
+using namespace ::testing;
+using facebook::velox::dwio::common::LoadUnit;
+using facebook::velox::dwio::common::PrefetchUnitLoaderFactory;
+using facebook::velox::dwio::common::RuntimeStatistics;
+using facebook::velox::dwio::common::test::getUnitsLoadedWithFalse;
+using facebook::velox::dwio::common::test::LoadUnitMock;
+using facebook::velox::dwio::common::test::ReaderMock;
+
+TEST(PrefetchUnitLoaderTests, PrefetchesNextUnits) {
+  folly::InlineExecutor executor;
+  size_t blockedOnIoCount = 0;
+  PrefetchUnitLoaderFactory factory(
+      &executor, 1, 1000, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, false}));
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9, load(0), fetch(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0), fetch(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  EXPECT_FALSE(readerMock.read(30)); // No more data
+
+  RuntimeStatistics stats;
+  readerMock.updateRuntimeStats(stats);
+  EXPECT_EQ(stats.unitPrefetchHits, 2);
+  EXPECT_EQ(stats.unitPrefetchMisses, 1);
+}
+
+TEST(PrefetchUnitLoaderTests, WaitsForUnfinishedPrefetch) {
+  folly::ManualExecutor executor;
+  size_t blockedOnIoCount = 0;
+  PrefetchUnitLoaderFactory factory(
+      &executor, 1, 1000, [&](auto) { ++blockedOnIoCount; });
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9, load(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+  EXPECT_EQ(blockedOnIoCount, 1);
+
+  // The prefetch of unit 1 has not run, so it is loaded on the reader thread.
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0), load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+
+  executor.drain(); // fetch(2)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, true}));
+
+  EXPECT_TRUE(readerMock.read(30)); // Unit: 2, rows: 0-29, unload(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, false, true}));
+  EXPECT_EQ(blockedOnIoCount, 2);
+
+  RuntimeStatistics stats;
+  readerMock.updateRuntimeStats(stats);
+  EXPECT_EQ(stats.unitPrefetchHits, 1);
+  EXPECT_EQ(stats.unitPrefetchMisses, 2);
+}
+
+TEST(PrefetchUnitLoaderTests, StaysWithinByteBudget) {
+  folly::InlineExecutor executor;
+  PrefetchUnitLoaderFactory factory(&executor, 3, 25, nullptr);
+  ReaderMock readerMock{{10, 20, 30, 40}, {10, 10, 10, 10}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9, fetch(1, 2)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({true, true, true, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, fetch(3)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({false, true, true, true}));
+}
+
+TEST(PrefetchUnitLoaderTests, LoadsOnDemandWithoutExecutor) {
+  PrefetchUnitLoaderFactory factory(nullptr, 2, 1000, nullptr);
+  ReaderMock readerMock{{10, 20, 30}, {0, 0, 0}, factory, 0};
+
+  EXPECT_TRUE(readerMock.read(10)); // Unit: 0, rows: 0-9, load(0)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({true, false, false}));
+
+  EXPECT_TRUE(readerMock.read(20)); // Unit: 1, rows: 0-19, unload(0), load(1)
+  EXPECT_EQ(readerMock.unitsLoaded(), std::vector<bool>({false, true, false}));
+
+  RuntimeStatistics stats;
+  readerMock.updateRuntimeStats(stats);
+  EXPECT_EQ(stats.unitPrefetchHits, 0);
+  EXPECT_EQ(stats.unitPrefetchMisses, 2);
+}
+
+TEST(PrefetchUnitLoaderTests, CanSeek) {
+  folly::InlineExecutor executor;
+  PrefetchUnitLoaderFactory factory(&executor, 1, 1000, nullptr);
+  ReaderMock readerMock{{10, 20, 30, 40}, {0, 0, 0, 0}, factory, 0};
+
+  EXPECT_NO_THROW(readerMock.seek(30););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 2, rows: 0-2, load(2), fetch(3)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({false, false, true, true}));
+
+  EXPECT_NO_THROW(readerMock.seek(0););
+  EXPECT_TRUE(readerMock.read(3)); // Unit: 0, rows: 0-2, unload(2, 3),
+                                   // load(0), fetch(1)
+  EXPECT_EQ(
+      readerMock.unitsLoaded(), std::vector<bool>({true, true, false, false}));
+}
+
+TEST(PrefetchUnitLoaderTests, UnitOutOfRange) {
+  PrefetchUnitLoaderFactory factory(nullptr, 2, 1000, nullptr);
+  std::vector<std::atomic_bool> unitsLoaded(getUnitsLoadedWithFalse(1));
+  std::vector<std::unique_ptr<LoadUnit>> units;
+  units.push_back(std::make_unique<LoadUnitMock>(10, 0, unitsLoaded, 0));
+
+  auto unitLoader = factory.create(std::move(units), 0);
+  unitLoader->getLoadedUnit(0);
+  EXPECT_THAT(
+      [&]() { unitLoader->getLoadedUnit(1); },
+      Throws<facebook::velox::VeloxRuntimeError>(Property(
+          &facebook::velox::VeloxRuntimeError::message,
+          HasSubstr("Unit out of range"))));
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/ZOrder.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace facebook::velox::dwio::common {
+namespace {
+
+class ZOrderTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    memory::MemoryManager::testingSetInstance({});
+  }
+
+  // Returns the rows of 'input' in the order of their Z-order values.
+  std::vector<vector_size_t> zOrder(
+      const RowVectorPtr& input,
+      const std::vector<column_index_t>& columns) {
+    auto keys = makeZOrderKeys(*input, columns, pool());
+    auto* values = keys->asFlatVector<StringView>();
+    std::vector<vector_size_t> rows(input->size());
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(), [&](auto left, auto right) {
+      return values->valueAt(left) < values->valueAt(right);
+    });
+    return rows;
+  }
+};
+
+TEST_F(ZOrderTest, interleave) {
+  // A 4x4 grid with row = 4 * x + y.
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(16, [](auto row) { return row / 4; }),
+      makeFlatVector<int32_t>(16, [](auto row) { return row % 4; }),
+  });
+  std::vector<vector_size_t> expected = {
+      0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+  EXPECT_EQ(zOrder(input, {0, 1}), expected);
+}
+
+TEST_F(ZOrderTest, singleKeyOrder) {
+  auto doubles = makeRowVector({makeNullableFlatVector<double>(
+      {2.5, std::nullopt, -1.0, 0.0, -3.5, 1e10})});
+  EXPECT_EQ(
+      zOrder(doubles, {0}), (std::vector<vector_size_t>{1, 4, 2, 3, 0, 5}));
+
+  auto integers = makeRowVector({makeFlatVector<int16_t>(
+      {5, -7, 0, std::numeric_limits<int16_t>::min()})});
+  EXPECT_EQ(zOrder(integers, {0}), (std::vector<vector_size_t>{3, 1, 2, 0}));
+
+  auto strings = makeRowVector(
+      {makeFlatVector<std::string>({"b", "abc", "", "ab", "\xff"})});
+  EXPECT_EQ(zOrder(strings, {0}), (std::vector<vector_size_t>{2, 3, 1, 0, 4}));
+}
+
+TEST_F(ZOrderTest, keyTypes) {
+  EXPECT_TRUE(isZOrderKeyType(BIGINT()));
+  EXPECT_TRUE(isZOrderKeyType(DATE()));
+  EXPECT_TRUE(isZOrderKeyType(VARCHAR()));
+  EXPECT_TRUE(isZOrderKeyType(TIMESTAMP()));
+  EXPECT_FALSE(isZOrderKeyType(DECIMAL(20, 2)));
+  EXPECT_FALSE(isZOrderKeyType(ARRAY(BIGINT())));
+}
+
+} // namespace
+} // namespace facebook::velox::dwio::common
@@ -142,11 +142,14 @@ void DwrfData::filterRowGroups(
     uint64_t rowGroupSize,
     const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
-  if (!index_ && !indexStream_) {
+  auto filter = scanSpec.filter();
+  // The row index of a column without filters is only needed for seeking, so
+  // it is not decompressed and parsed unless a stride is skipped.
+  if ((!index_ && !indexStream_) ||
+      (!filter && scanSpec.numMetadataFilters() == 0)) {
     return;
   }
   ensureRowGroupIndex();
-  auto filter = scanSpec.filter();
   auto dwrfContext = reinterpret_cast<const StatsContext*>(&writerContext);
   result.totalCount = std::max(result.totalCount, index_->entry_size());
   auto nwords = bits::nwords(result.totalCount);
@@ -41,12 +41,14 @@ class DwrfUnit : public LoadUnit {
       const StripeReaderBase& stripeReaderBase,
       const StrideIndexProvider& strideIndexProvider,
       dwio::common::ColumnReaderStatistics& columnReaderStatistics,
+      std::mutex& buildMutex,
       uint32_t stripeIndex,
       std::shared_ptr<dwio::common::ColumnSelector> columnSelector,
       RowReaderOptions options)
       : stripeReaderBase_{stripeReaderBase},
         strideIndexProvider_{strideIndexProvider},
         columnReaderStatistics_{columnReaderStatistics},
+        buildMutex_{buildMutex},
         stripeIndex_{stripeIndex},
         columnSelector_{std::move(columnSelector)},
         options_{std::move(options)},
@@ -84,6 +86,9 @@ class DwrfUnit : public LoadUnit {
   const StripeReaderBase& stripeReaderBase_;
   const StrideIndexProvider& strideIndexProvider_;
   dwio::common::ColumnReaderStatistics& columnReaderStatistics_;
+  // Serializes building the column readers of units that are loaded in
+  // parallel. The readers of all units share the ScanSpec.
+  std::mutex& buildMutex_;
   const uint32_t stripeIndex_;
   const std::shared_ptr<dwio::common::ColumnSelector> columnSelector_;
   const RowReaderOptions options_;
@@ -155,6 +160,7 @@ void DwrfUnit::ensureDecoders() {
   memory::AllocationPool pool(&stripeReaderBase_.getReader().getMemoryPool());
   StreamLabels streamLabels(pool);
 
+  std::lock_guard<std::mutex> l(buildMutex_);
   if (scanSpec) {
     selectiveColumnReader_ = SelectiveDwrfReader::build(
         requestedType,
@@ -299,6 +305,7 @@ std::unique_ptr<dwio::common::UnitLoader> DwrfRowReader::getUnitLoader() {
         /* stripeReaderBase */ *this,
         /* strideIndexProvider */ *this,
         columnReaderStatistics_,
+        unitBuildMutex_,
         stripe,
         columnSelector_,
         options_));
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "folly/Executor.h"
 #include "folly/synchronization/Baton.h"
 #include "velox/dwio/common/ReaderFactory.h"
@@ -97,6 +99,9 @@ class DwrfRowReader : public StrideIndexProvider,
     stats.skippedStrides += skippedStrides_;
     stats.columnReaderStatistics.flattenStringDictionaryValues +=
         columnReaderStatistics_.flattenStringDictionaryValues;
+    if (unitLoader_) {
+      unitLoader_->updateRuntimeStats(stats);
+    }
   }
 
   void resetFilterCaches() override;
@@ -162,6 +167,8 @@ class DwrfRowReader : public StrideIndexProvider,
 
   std::optional<int64_t> nextRowNumber_;
 
+  // Shared by the units of 'unitLoader_', which may load them in parallel.
+  std::mutex unitBuildMutex_;
   std::unique_ptr<dwio::common::UnitLoader> unitLoader_;
   DwrfUnit* currentUnit_;
 
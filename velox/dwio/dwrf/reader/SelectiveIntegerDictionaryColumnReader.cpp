@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/reader/SelectiveIntegerDictionaryColumnReader.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/vector/DictionaryVector.h"
 
 namespace facebook::velox::dwrf {
 using namespace dwio::common;
@@ -31,7 +32,10 @@ SelectiveIntegerDictionaryColumnReader::SelectiveIntegerDictionaryColumnReader(
           requestedType->type(),
           params,
           scanSpec,
-          std::move(fileType)) {
+          std::move(fileType)),
+      dictionaryOutput_(params.stripeStreams()
+                            .getRowReaderOptions()
+                            .integerDictionaryOutput()) {
   EncodingKey encodingKey{fileType_->id(), params.flatMapContext().sequence};
   auto& stripe = params.stripeStreams();
   auto encoding = stripe.getEncoding(encodingKey);
@@ -105,9 +109,97 @@ void SelectiveIntegerDictionaryColumnReader::read(
 
   // lazy load dictionary only when it's needed
   ensureInitialized();
+  readIndices_ = canReadIndices();
   readCommon<SelectiveIntegerDictionaryColumnReader, true>(rows);
 
   readOffset_ += rows.back() + 1;
+  numRowsScanned_ = rows.back() + 1;
+}
+
+bool SelectiveIntegerDictionaryColumnReader::canReadIndices() const {
+  // Values not in the dictionary and values converted to a wider requested
+  // type cannot be indices into the stripe dictionary. Flat map values are
+  // copied out of 'values_' and gain nothing from a dictionary.
+  return dictionaryOutput_ && !inDictionaryReader_ && !isFlatMapValue_ &&
+      scanState_.dictionary.numValues > 0 &&
+      fileType_->type()->kind() == requestedType_->kind() &&
+      scanSpec_->keepValues() && !scanSpec_->valueHook() &&
+      !scanSpec_->filter() && !scanSpec_->makeFlat();
+}
+
+void SelectiveIntegerDictionaryColumnReader::getValues(
+    RowSet rows,
+    VectorPtr* result) {
+  if (!readIndices_) {
+    SelectiveIntegerColumnReader::getValues(rows, result);
+    return;
+  }
+  VELOX_WIDTH_DISPATCH(valueSize_, makeDictionaryResult, rows, result);
+}
+
+template <typename T>
+void SelectiveIntegerDictionaryColumnReader::makeDictionaryResult(
+    RowSet rows,
+    VectorPtr* result) {
+  compactScalarValues<T, T>(rows, false);
+  VELOX_CHECK_GT(numRowsScanned_, 0);
+  // The indices are below the dictionary size and fit in T.
+  const auto* indices = reinterpret_cast<const T*>(rawValues_);
+  auto nulls = resultNulls();
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  const double selectivity = 1.0 * rows.size() / numRowsScanned_;
+  const auto flatSize = std::max<double>(
+      selectivity * formatData_->as<DwrfData>().stripeRows(), rows.size());
+  if (!dictionaryValues_ && flatSize < scanState_.dictionary.numValues) {
+    const auto* dictionary = scanState_.dictionary.values->as<T>();
+    auto values = AlignedBuffer::allocate<T>(numValues_, &memoryPool_);
+    auto* rawValues = values->asMutable<T>();
+    for (vector_size_t i = 0; i < numValues_; ++i) {
+      rawValues[i] = rawNulls && bits::isBitNull(rawNulls, i)
+          ? T()
+          : dictionary[indices[i]];
+    }
+    *result = std::make_shared<FlatVector<T>>(
+        &memoryPool_,
+        requestedType_,
+        std::move(nulls),
+        numValues_,
+        std::move(values),
+        std::vector<BufferPtr>{});
+    return;
+  }
+  if (!dictionaryValues_) {
+    dictionaryValues_ = std::make_shared<FlatVector<T>>(
+        &memoryPool_,
+        requestedType_,
+        nullptr,
+        scanState_.dictionary.numValues,
+        scanState_.dictionary.values,
+        std::vector<BufferPtr>{});
+  }
+  BufferPtr dictionaryIndices;
+  if constexpr (sizeof(T) == sizeof(vector_size_t)) {
+    if (rawNulls) {
+      auto* rawIndices = reinterpret_cast<T*>(rawValues_);
+      bits::forEachUnsetBit(rawNulls, 0, numValues_, [&](auto row) {
+        rawIndices[row] = 0;
+      });
+    }
+    dictionaryIndices = values_;
+  } else {
+    dictionaryIndices = allocateIndices(numValues_, &memoryPool_);
+    auto* rawIndices = dictionaryIndices->asMutable<vector_size_t>();
+    for (vector_size_t i = 0; i < numValues_; ++i) {
+      rawIndices[i] =
+          rawNulls && bits::isBitNull(rawNulls, i) ? 0 : indices[i];
+    }
+  }
+  *result = std::make_shared<DictionaryVector<T>>(
+      &memoryPool_,
+      std::move(nulls),
+      numValues_,
+      dictionaryValues_,
+      std::move(dictionaryIndices));
 }
 
 void SelectiveIntegerDictionaryColumnReader::ensureInitialized() {
@@ -51,24 +51,61 @@ class SelectiveIntegerDictionaryColumnReader
   void read(vector_size_t offset, RowSet rows, const uint64_t* incomingNulls)
       override;
 
+  void getValues(RowSet rows, VectorPtr* result) override;
+
   template <typename ColumnVisitor>
   void readWithVisitor(RowSet rows, ColumnVisitor visitor);
 
  private:
   void ensureInitialized();
 
+  // Returns true if the values of the next read can be kept as dictionary
+  // indices and returned as a dictionary over the stripe dictionary.
+  bool canReadIndices() const;
+
+  // Makes 'result' from the dictionary indices in 'values_'. The result is
+  // flattened if it would be smaller than the dictionary.
+  template <typename T>
+  void makeDictionaryResult(RowSet rows, VectorPtr* result);
+
   std::unique_ptr<ByteRleDecoder> inDictionaryReader_;
   std::unique_ptr<dwio::common::IntDecoder</* isSigned = */ false>> dataReader_;
   std::unique_ptr<dwio::common::IntDecoder</* isSigned = */ true>> dictReader_;
   std::function<BufferPtr()> dictInit_;
   RleVersion rleVersion_;
   bool initialized_{false};
+  // From RowReaderOptions::integerDictionaryOutput().
+  const bool dictionaryOutput_;
+  // True if 'values_' holds dictionary indices from the last read.
+  bool readIndices_{false};
+  vector_size_t numRowsScanned_{0};
+  // Stripe dictionary as a vector of the requested type, made on first use.
+  VectorPtr dictionaryValues_;
 };
 
 template <typename ColumnVisitor>
 void SelectiveIntegerDictionaryColumnReader::readWithVisitor(
     RowSet rows,
     ColumnVisitor visitor) {
+  if constexpr (
+      std::is_same_v<
+          typename ColumnVisitor::FilterType,
+          velox::common::AlwaysTrue> &&
+      std::is_same_v<
+          typename ColumnVisitor::Extract,
+          dwio::common::ExtractToReader>) {
+    if (readIndices_) {
+      // Keep the indices in the data stream as values.
+      if (rleVersion_ == RleVersion_1) {
+        decodeWithVisitor<velox::dwrf::RleDecoderV1<false>>(
+            dataReader_.get(), visitor);
+      } else {
+        decodeWithVisitor<velox::dwrf::RleDecoderV2<false>>(
+            dataReader_.get(), visitor);
+      }
+      return;
+    }
+  }
   auto dictVisitor = visitor.toDictionaryColumnVisitor();
   if (rleVersion_ == RleVersion_1) {
     decodeWithVisitor<velox::dwrf::RleDecoderV1<false>>(
@@ -18,6 +18,7 @@
 #include <folly/container/F14Set.h>
 
 #include "velox/common/base/BitSet.h"
+#include "velox/dwio/common/DecompressedStreamCache.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/common/wrap/coded-stream-wrapper.h"
@@ -285,6 +286,11 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
   std::unique_ptr<dwio::common::SeekableInputStream> streamRead;
   if (isIndexStream(si.kind())) {
     streamRead = getIndexStreamFromCache(info);
+  } else if (opts_.decompressedStreamCache() != nullptr) {
+    streamRead = getStreamFromDecompressedCache(si, info, label);
+    if (streamRead) {
+      return streamRead;
+    }
   }
 
   if (!streamRead) {
@@ -304,6 +310,53 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
       getDecrypter(si.encodingKey().node()));
 }
 
+std::unique_ptr<dwio::common::SeekableInputStream>
+StripeStreamsImpl::getStreamFromDecompressedCache(
+    const DwrfStreamIdentifier& si,
+    const StreamInformation& info,
+    std::string_view label) const {
+  const auto& readerBase = readState_->readerBase;
+  if (readerBase->getCompressionKind() == common::CompressionKind_NONE ||
+      getDecrypter(si.encodingKey().node()) != nullptr) {
+    return nullptr;
+  }
+  const auto& cache = opts_.decompressedStreamCache();
+  dwio::common::DecompressedStreamCache::Key key{
+      readerBase->getBufferedInput().getName(),
+      info.getOffset() + stripeStart_};
+  auto streamDebugInfo =
+      fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
+  bool admit;
+  auto entry = cache->find(key, info.getLength(), admit);
+  if (entry != nullptr) {
+    return std::make_unique<dwio::common::DecompressedInputStream>(
+        std::move(entry), std::move(streamDebugInfo));
+  }
+  if (!admit) {
+    return nullptr;
+  }
+
+  std::shared_ptr<dwio::common::SeekableInputStream> compressed =
+      readState_->stripeMetadata->stripeInput->enqueue(
+          {info.getOffset() + stripeStart_, info.getLength(), label}, &si);
+  if (compressed == nullptr) {
+    return nullptr;
+  }
+  // The stream is decompressed as a whole on first access and added to the
+  // cache.
+  return std::make_unique<dwio::common::DecompressedInputStream>(
+      [compressed, readerBase, cache, key, streamDebugInfo]() {
+        auto entry = dwio::common::DecompressedStreamCache::decompress(
+            *compressed, [&](auto input) {
+              return readerBase->createDecompressedStream(
+                  std::move(input), streamDebugInfo);
+            });
+        cache->insert(key, entry);
+        return entry;
+      },
+      streamDebugInfo);
+}
+
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
     uint32_t node,
     std::function<void(const StreamInformation&)> visitor) const {
@@ -346,6 +346,15 @@ class StripeStreamsImpl : public StripeStreamsBase {
   std::unique_ptr<dwio::common::SeekableInputStream> getIndexStreamFromCache(
       const StreamInformation& info) const;
 
+  // Returns a stream over the cached decompressed contents of 'si' or, if
+  // 'si' should be added to the cache, a stream that reads, decompresses and
+  // caches it on first access. Returns nullptr if 'si' is not cached.
+  std::unique_ptr<dwio::common::SeekableInputStream>
+  getStreamFromDecompressedCache(
+      const DwrfStreamIdentifier& si,
+      const StreamInformation& info,
+      std::string_view label) const;
+
   const dwio::common::encryption::Decrypter* getDecrypter(
       uint32_t nodeId) const {
     auto& handler = *readState_->stripeMetadata->handler;
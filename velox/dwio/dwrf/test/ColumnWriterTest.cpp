@@ -3198,6 +3198,30 @@ void testIntegerDictionaryEncodableWriterConstructor() {
   }
 }
 
+TEST_F(ColumnWriterTest, recordAbandonedDictionaries) {
+  auto config = std::make_shared<Config>();
+  WriterContext context{config, memory::memoryManager()->addRootPool()};
+  context.initBuffer();
+  auto type = TypeWithId::create(BIGINT(), 1);
+  auto writer = BaseColumnWriter::create(context, *type);
+
+  // All distinct values make the dictionary not worth keeping.
+  auto vector = BaseVector::create<FlatVector<int64_t>>(
+      BIGINT(), 1'000, pool_.get());
+  for (auto i = 0; i < vector->size(); ++i) {
+    vector->set(i, i);
+  }
+  writer->write(vector, common::Ranges::of(0, vector->size()));
+  EXPECT_EQ(context.stripeAbandonedDictionaries(), 0);
+  ASSERT_TRUE(writer->tryAbandonDictionaries(false));
+  EXPECT_EQ(context.stripeAbandonedDictionaries(), 1);
+  ASSERT_FALSE(writer->tryAbandonDictionaries(false));
+  EXPECT_EQ(context.stripeAbandonedDictionaries(), 1);
+
+  context.nextStripe();
+  EXPECT_EQ(context.stripeAbandonedDictionaries(), 0);
+}
+
 TEST_F(ColumnWriterTest, IntegerDictionaryDictionaryEncodableWriterCtor) {
   testIntegerDictionaryEncodableWriterConstructor<int16_t>();
   testIntegerDictionaryEncodableWriterConstructor<int32_t>();
@@ -96,6 +96,13 @@ class E2EFilterTest : public E2EFilterTestBase {
     for (auto& field : flatMapAsStructFields_) {
       spec->childByName(field)->setFlatMapAsStruct(true);
     }
+    if (flatMapKeysAsDictionary_) {
+      for (auto& field : flatMapColumns_) {
+        if (auto* child = spec->childByName(field)) {
+          child->setFlatMapKeysAsDictionary(true);
+        }
+      }
+    }
   }
 
   std::unique_ptr<dwio::common::Reader> makeReader(
@@ -105,6 +112,7 @@ class E2EFilterTest : public E2EFilterTestBase {
   }
 
   std::unordered_set<std::string> flatMapColumns_;
+  bool flatMapKeysAsDictionary_ = false;
 
  private:
   dwrf::WriterOptions createWriterOptions(const TypePtr& type) {
@@ -412,6 +420,21 @@ TEST_F(E2EFilterTest, flatMapScalar) {
       true);
 }
 
+TEST_F(E2EFilterTest, flatMapKeysAsDictionary) {
+  constexpr auto kColumns =
+      "long_val:bigint,"
+      "long_vals:map<tinyint,bigint>,"
+      "string_vals:map<string,string>,"
+      "struct_vals:map<varchar,struct<v1:bigint, v2:float>>";
+  flatMapColumns_ = {"long_vals", "string_vals", "struct_vals"};
+  flatMapKeysAsDictionary_ = true;
+  auto customize = [this] {
+    dataSetBuilder_->makeUniformMapKeys(Subfield("string_vals"));
+    dataSetBuilder_->makeMapStringValues(Subfield("string_vals"));
+  };
+  testWithTypes(kColumns, customize, false, {"long_val", "long_vals"}, 1, true);
+}
+
 TEST_F(E2EFilterTest, flatMapComplex) {
   constexpr auto kColumns =
       "long_val:bigint,"
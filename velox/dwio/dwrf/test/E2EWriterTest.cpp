@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -1633,6 +1634,64 @@ TEST_F(E2EWriterTest, fuzzFlatmap) {
   }
 }
 
+TEST_F(E2EWriterTest, parallelColumnWrite) {
+  auto type = ROW({
+      {"bool_val", BOOLEAN()},
+      {"int_val", INTEGER()},
+      {"long_val", BIGINT()},
+      {"double_val", DOUBLE()},
+      {"string_val", VARCHAR()},
+      {"ts_val", TIMESTAMP()},
+      {"array", ARRAY(REAL())},
+      {"map", MAP(INTEGER(), VARCHAR())},
+      {"row", ROW({{"a", BIGINT()}, {"b", VARCHAR()}})},
+  });
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "seed: " << seed;
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = 1000,
+          .nullRatio = 0.05,
+          .stringLength = 20,
+          .stringVariableLength = true,
+          .containerLength = 3,
+      },
+      leafPool_.get(),
+      seed);
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(fuzzer.fuzzInputRow(type));
+  }
+
+  auto write = [&](std::shared_ptr<folly::Executor> executor) {
+    auto config = std::make_shared<dwrf::Config>();
+    config->set(dwrf::Config::COMPRESSION_BLOCK_SIZE, 1024UL);
+    config->set(dwrf::Config::ROW_INDEX_STRIDE, 2000U);
+
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.columnWriteExecutor = std::move(executor);
+    options.columnWriteParallelism = 4;
+    dwrf::Writer writer{std::move(sink), options};
+    for (auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto serial = write(nullptr);
+  const auto parallel =
+      write(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(serial, parallel);
+}
+
 TEST_F(E2EWriterTest, memoryConfigError) {
   const auto type = ROW(
       {{"int_val", INTEGER()},
@@ -2038,6 +2097,67 @@ DEBUG_ONLY_TEST_F(E2EWriterTest, memoryReclaimDuringInit) {
   }
 }
 
+TEST_F(E2EWriterTest, memoryReclaimWithoutFlush) {
+  const auto type = ROW(
+      {{"int_val", INTEGER()},
+       {"string_val", VARCHAR()},
+       {"binary_val", VARBINARY()}});
+
+  VectorFuzzer fuzzer(
+      {
+          .vectorSize = 1000,
+          .stringLength = 1'000,
+          .stringVariableLength = false,
+      },
+      leafPool_.get());
+  std::vector<VectorPtr> vectors;
+  for (int i = 0; i < 10; ++i) {
+    vectors.push_back(fuzzer.fuzzInputRow(type));
+  }
+
+  const common::SpillConfig spillConfig = getSpillConfig(10, 20, 0);
+  auto config = std::make_shared<dwrf::Config>();
+  config->set<uint64_t>(dwrf::Config::STRIPE_SIZE, 1L << 30);
+  config->set<uint64_t>(dwrf::Config::MAX_DICTIONARY_SIZE, 1L << 30);
+
+  dwrf::WriterOptions options;
+  options.schema = type;
+  options.config = std::move(config);
+  tsan_atomic<bool> nonReclaimableSection{false};
+  options.nonReclaimableSection = &nonReclaimableSection;
+  options.spillConfig = &spillConfig;
+
+  auto writerPool = memory::memoryManager()->addRootPool(
+      "memoryReclaimWithoutFlush", 1L << 30, exec::MemoryReclaimer::create());
+  auto dwrfPool = writerPool->addAggregateChild("writer");
+  auto sinkPool =
+      writerPool->addLeafChild("sink", true, exec::MemoryReclaimer::create());
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024, FileSink::Options{.pool = sinkPool.get()});
+  auto writer =
+      std::make_unique<dwrf::Writer>(std::move(sink), options, dwrfPool);
+  {
+    memory::NonReclaimableSectionGuard nonReclaimableGuard(
+        &nonReclaimableSection);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+      writer->write(vectors[i]);
+    }
+  }
+  ASSERT_EQ(writer->getContext().stripeIndex(), 0);
+
+  // A small target is met by giving back unused reservations and dictionary
+  // memory without flushing the stripe.
+  memory::MemoryReclaimer::Stats stats;
+  ASSERT_GT(writerPool->reclaim(1, 0, stats), 0);
+  ASSERT_GT(stats.reclaimedBytes, 0);
+  ASSERT_EQ(writer->getContext().stripeIndex(), 0);
+
+  // A large target still flushes the stripe.
+  ASSERT_GT(writerPool->reclaim(1L << 30, 0, stats), 0);
+  ASSERT_EQ(writer->getContext().stripeIndex(), 1);
+  writer->close();
+}
+
 TEST_F(E2EWriterTest, memoryReclaimThreshold) {
   const auto type = ROW(
       {{"int_val", INTEGER()},
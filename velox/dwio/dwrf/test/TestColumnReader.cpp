@@ -127,6 +127,7 @@ class ColumnReaderTestBase {
     ColumnSelector cs(rowType, nodes, true);
     auto options = RowReaderOptions();
     options.setReturnFlatVector(returnFlatVector());
+    options.setIntegerDictionaryOutput(integerDictionaryOutput_);
     options.setTimestampPrecision(TimestampPrecision::kNanoseconds);
 
     EXPECT_CALL(streams_, getColumnSelectorProxy())
@@ -227,6 +228,7 @@ class ColumnReaderTestBase {
   std::unique_ptr<ColumnReader> columnReader_;
   std::unique_ptr<SelectiveColumnReader> selectiveColumnReader_;
   std::unique_ptr<folly::Executor> executor_;
+  bool integerDictionaryOutput_{false};
 
  private:
   std::unique_ptr<common::ScanSpec> scanSpec_;
@@ -1063,6 +1065,55 @@ TEST_P(TestColumnReader, testIntDictSkipNoNullsAllInDict) {
   }
 }
 
+TEST_P(TestColumnReader, testIntDictOutput) {
+  if (!useSelectiveReader()) {
+    return;
+  }
+  proto::ColumnEncoding directEncoding;
+  directEncoding.set_kind(proto::ColumnEncoding_Kind_DIRECT);
+  proto::ColumnEncoding dictEncoding;
+  dictEncoding.set_kind(proto::ColumnEncoding_Kind_DICTIONARY);
+  dictEncoding.set_dictionarysize(10);
+  EXPECT_CALL(streams_, getEncodingProxy(_))
+      .WillRepeatedly(Return(&directEncoding));
+  EXPECT_CALL(streams_, getEncodingProxy(1))
+      .WillRepeatedly(Return(&dictEncoding));
+  EXPECT_CALL(streams_, getStreamProxy(_, proto::Stream_Kind_ROW_INDEX, false))
+      .WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(streams_, getStreamProxy(_, proto::Stream_Kind_PRESENT, false))
+      .WillRepeatedly(Return(nullptr));
+
+  // Row i points to dictionary entry i % 10.
+  char data[1024];
+  std::vector<uint64_t> v;
+  data[0] = 0x9C; // rle literal, -100
+  for (uint64_t i = 0; i < 100; ++i) {
+    v.push_back(i % 10);
+  }
+  size_t size = writeVuLongs(data + 1, v);
+  EXPECT_CALL(streams_, getStreamProxy(1, proto::Stream_Kind_DATA, true))
+      .WillRepeatedly(Return(new SeekableArrayInputStream(data, size + 1)));
+  EXPECT_CALL(
+      streams_, getStreamProxy(1, proto::Stream_Kind_IN_DICTIONARY, false))
+      .WillRepeatedly(Return(nullptr));
+  EXPECT_CALL(streams_, genMockDictDataSetter(1, 0))
+      .WillRepeatedly(Return([&](BufferPtr& buffer, MemoryPool* pool) {
+        buffer = sequence<int32_t>(pool, 100, 110);
+      }));
+
+  auto rowType = HiveTypeParser().parse("struct<myInt:int>");
+  integerDictionaryOutput_ = true;
+  buildReader(rowType);
+  VectorPtr batch = newBatch(rowType);
+  skipAndRead(batch, /* read */ 40, /* skip */ 10);
+  auto child = batch->as<RowVector>()->childAt(0);
+  ASSERT_EQ(child->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(child->valueVector()->size(), 10);
+  for (vector_size_t i = 0; i < 40; ++i) {
+    EXPECT_EQ(child->as<SimpleVector<int32_t>>()->valueAt(i), 100 + i % 10);
+  }
+}
+
 TEST_P(TestColumnReader, testIntDictSkipWithNulls) {
   // set getEncoding
   proto::ColumnEncoding directEncoding;
@@ -198,6 +198,24 @@ TEST_F(DirectTest, vIntUnsignedLong) {
   });
 }
 
+TEST_F(DirectTest, vIntSmallValues) {
+  folly::Random::DefaultGenerator rng;
+  rng.seed(3);
+  int32_t count = 0;
+  // Long runs of single byte varints interrupted by wider ones to test bulk
+  // decode of single byte runs.
+  auto generator = [&]() -> int64_t {
+    auto mod = ++count % 97;
+    auto numBytes = mod < 90 ? 1 : mod % 9 + 1;
+    return folly::Random::rand64(rng) & ((1UL << (7 * numBytes)) - 1);
+  };
+  testInts<int64_t, false, true>(generator);
+  testInts<int64_t, true, true>([&]() -> int64_t {
+    auto value = generator();
+    return folly::Random::rand32(rng) & 1 ? -value : value;
+  });
+}
+
 template <bool isSigned>
 void testCorruptedVarInts() {
   std::vector<uint8_t> invalidInt{
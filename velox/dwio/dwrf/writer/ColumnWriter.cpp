@@ -17,6 +17,7 @@
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
+#include "velox/dwio/common/ParallelFor.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
 #include "velox/dwio/dwrf/writer/EntropyEncodingSelector.h"
@@ -35,7 +36,11 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // Column writers that run in parallel do not share the selectivity vector.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.columnWriteExecutor() != nullptr
+      ? localSelected.emplace(slice->size())
+      : context_.getSharedSelectivityVector(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -346,6 +351,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
     if (useDictionaryEncoding_) {
       return false;
     }
+    context_.recordAbandonedDictionary();
 
     initStreamWriters(useDictionaryEncoding_);
     // Record direct encoding stream starting position.
@@ -944,6 +950,7 @@ class StringColumnWriter : public BaseColumnWriter {
     if (useDictionaryEncoding_) {
       return false;
     }
+    context_.recordAbandonedDictionary();
 
     initStreamWriters(useDictionaryEncoding_);
     // Record direct encoding stream starting position.
@@ -1623,16 +1630,59 @@ class StructColumnWriter : public BaseColumnWriter {
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  // Writes the children of the root on the column write executor of the
+  // context. Returns the total raw size.
+  uint64_t writeChildrenInParallel(
+      const RowVector* rowSlice,
+      const common::Ranges& ranges);
 };
 
+uint64_t StructColumnWriter::writeChildrenInParallel(
+    const RowVector* rowSlice,
+    const common::Ranges& ranges) {
+  std::vector<uint64_t> rawSizes(children_.size(), 0);
+  std::vector<size_t> parallelChildren;
+  parallelChildren.reserve(children_.size());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    if (children_[i]->addsStreamsOnWrite()) {
+      rawSizes[i] = children_[i]->write(rowSlice->childAt(i), ranges);
+    } else {
+      parallelChildren.push_back(i);
+    }
+  }
+  // Each child writes to its own streams, so the output does not depend on
+  // the order in which the children are written.
+  ParallelFor(
+      context_.columnWriteExecutor(),
+      0,
+      parallelChildren.size(),
+      context_.columnWriteParallelism())
+      .execute([&](size_t i) {
+        const auto child = parallelChildren[i];
+        rawSizes[child] =
+            children_[child]->write(rowSlice->childAt(child), ranges);
+      });
+  uint64_t rawSize = 0;
+  for (auto size : rawSizes) {
+    rawSize += size;
+  }
+  return rawSize;
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (isRoot() && context_.columnWriteExecutor() != nullptr &&
+        children_.size() > 1) {
+      rawSize += writeChildrenInParallel(rowSlice, ranges);
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
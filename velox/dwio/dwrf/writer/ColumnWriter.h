@@ -143,6 +143,18 @@ class BaseColumnWriter : public ColumnWriter {
     return result;
   }
 
+  /// Returns true if write() may add streams to the context, e.g. for the
+  /// value writers of new flat map keys. Such writers do not write in parallel
+  /// with other column writers.
+  virtual bool addsStreamsOnWrite() const {
+    for (auto& child : children_) {
+      if (child->addsStreamsOnWrite()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   const velox::dwio::common::TypeWithId& getType() const {
     return type_;
   }
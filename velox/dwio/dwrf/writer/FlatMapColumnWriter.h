@@ -276,6 +276,10 @@ class FlatMapColumnWriter : public BaseColumnWriter {
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
                               statsFactory) const override;
 
+  bool addsStreamsOnWrite() const override {
+    return true;
+  }
+
  private:
   using KeyType = typename TypeTraits<K>::NativeType;
 
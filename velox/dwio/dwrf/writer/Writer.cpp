@@ -76,6 +76,11 @@ Writer::Writer(
   writerBase_->initContext(options.config, pool, std::move(handler));
 
   auto& context = writerBase_->getContext();
+  if (options.columnWriteExecutor != nullptr &&
+      options.encryptionSpec == nullptr) {
+    context.setColumnWriteExecutor(
+        options.columnWriteExecutor, options.columnWriteParallelism);
+  }
   VELOX_CHECK_EQ(
       context.getTotalMemoryUsage(),
       0,
@@ -309,6 +314,31 @@ void Writer::releaseMemory() {
   getContext().releaseMemoryReservation();
 }
 
+bool Writer::reclaimWithoutFlush(
+    const memory::MemoryPool& pool,
+    uint64_t targetBytes) {
+  // A zero target asks for as much memory as possible, which only a flush
+  // gives back.
+  if (targetBytes == 0) {
+    return false;
+  }
+  const auto reservedBytes = pool.reservedBytes();
+  const auto reclaimed = [&]() -> uint64_t {
+    const auto currentBytes = pool.reservedBytes();
+    return reservedBytes > currentBytes ? reservedBytes - currentBytes : 0;
+  };
+  releaseMemory();
+  if (reclaimed() >= targetBytes) {
+    return true;
+  }
+  // Dictionaries can only be abandoned in the first stripe.
+  if (getContext().stripeIndex() == 0 &&
+      writer_->tryAbandonDictionaries(true)) {
+    releaseMemory();
+  }
+  return reclaimed() >= targetBytes;
+}
+
 uint64_t Writer::flushTimeMemoryUsageEstimate(
     const WriterContext& context,
     size_t nextWriteSize) const {
@@ -415,9 +445,20 @@ void Writer::flushStripe(bool close) {
   const auto& handler = context.getEncryptionHandler();
   EncodingManager encodingManager{handler};
 
+  std::vector<const proto::ColumnEncoding*> encodings;
   writer_->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
-    return encodingManager.addEncodingToFooter(nodeId);
+    auto& encoding = encodingManager.addEncodingToFooter(nodeId);
+    encodings.push_back(&encoding);
+    return encoding;
   });
+  metrics.dictionaryEncodings = 0;
+  for (const auto* encoding : encodings) {
+    if (encoding->kind() == proto::ColumnEncoding_Kind_DICTIONARY ||
+        encoding->kind() == proto::ColumnEncoding_Kind_DICTIONARY_V2) {
+      ++metrics.dictionaryEncodings;
+    }
+  }
+  metrics.abandonedDictionaries = context.stripeAbandonedDictionaries();
 
   // Collects the memory increment from flushing data to output streams.
   const auto postFlushStreamMemoryUsage =
@@ -560,6 +601,12 @@ void Writer::flushStripe(bool close) {
   addThreadLocalRuntimeStat(
       "stripeSize",
       RuntimeCounter(metrics.stripeSize, RuntimeCounter::Unit::kBytes));
+  addThreadLocalRuntimeStat(
+      "dictionaryEncodings", RuntimeCounter(metrics.dictionaryEncodings));
+  if (metrics.abandonedDictionaries > 0) {
+    addThreadLocalRuntimeStat(
+        "abandonedDictionaries", RuntimeCounter(metrics.abandonedDictionaries));
+  }
   // Add flush overhead and other ratio logging.
   context.metricLogger()->logStripeFlush(metrics);
 
@@ -764,7 +811,11 @@ uint64_t Writer::MemoryReclaimer::reclaim(
         int64_t reclaimedBytes{0};
         {
           memory::ScopedReclaimedBytesRecorder recorder(pool, &reclaimedBytes);
-          writer_->flushInternal(false);
+          // Flushing a stripe early makes small stripes, so it is the last
+          // resort.
+          if (!writer_->reclaimWithoutFlush(*pool, targetBytes)) {
+            writer_->flushInternal(false);
+          }
         }
         return reclaimedBytes;
       },
@@ -805,6 +856,8 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.memoryPool = options.memoryPool;
   dwrfOptions.spillConfig = options.spillConfig;
   dwrfOptions.nonReclaimableSection = options.nonReclaimableSection;
+  dwrfOptions.columnWriteExecutor = options.columnWriteExecutor;
+  dwrfOptions.columnWriteParallelism = options.columnWriteParallelism;
   return dwrfOptions;
 }
 
@@ -51,6 +51,11 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set, the top level columns of each batch are written in up to
+  /// 'columnWriteParallelism' parallel tasks on this executor. The output is
+  /// the same as when writing serially. Not used with encryption.
+  std::shared_ptr<folly::Executor> columnWriteExecutor;
+  size_t columnWriteParallelism{8};
 };
 
 class Writer : public dwio::common::Writer {
@@ -191,6 +196,14 @@ class Writer : public dwio::common::Writer {
   // Releases the unused memory reservations after we flush a stripe.
   void releaseMemory();
 
+  // Tries to give back at least 'targetBytes' of the reservation of 'pool'
+  // without flushing the current stripe. Releases the unused reservations,
+  // then switches the dictionary encoded columns to direct encoding if still
+  // in the first stripe. Returns true if enough memory was given back.
+  bool reclaimWithoutFlush(
+      const memory::MemoryPool& pool,
+      uint64_t targetBytes);
+
   // Create a new stripe. No-op if there is no data written.
   void flushInternal(bool close = false);
 
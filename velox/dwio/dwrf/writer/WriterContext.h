@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -160,6 +162,7 @@ class WriterContext : public CompressionBufferPool {
     indexRowCount_ = 0;
     fileRawSize_ += stripeRawSize_;
     stripeRawSize_ = 0;
+    stripeAbandonedDictionaries_ = 0;
     ++stripeIndex_;
 
     for (auto& pair : streams_) {
@@ -247,8 +250,20 @@ class WriterContext : public CompressionBufferPool {
 
   void initBuffer();
 
+  // Column writers that run in parallel each take a compression buffer, so
+  // buffers beyond the first are allocated on demand and kept for reuse.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
+    std::lock_guard<std::mutex> l(bufferMutex_);
+    if (compressionBuffer_ == nullptr && columnWriteExecutor_ != nullptr) {
+      if (spareCompressionBuffers_.empty()) {
+        return std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+      }
+      auto buffer = std::move(spareCompressionBuffers_.back());
+      spareCompressionBuffers_.pop_back();
+      return buffer;
+    }
     VELOX_CHECK_NOT_NULL(compressionBuffer_);
     VELOX_CHECK_GE(compressionBuffer_->size(), size);
     return std::move(compressionBuffer_);
@@ -257,7 +272,12 @@ class WriterContext : public CompressionBufferPool {
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     VELOX_CHECK_NOT_NULL(buffer);
-    VELOX_CHECK_NULL(compressionBuffer_);
+    std::lock_guard<std::mutex> l(bufferMutex_);
+    if (compressionBuffer_ != nullptr) {
+      VELOX_CHECK_NOT_NULL(columnWriteExecutor_);
+      spareCompressionBuffers_.push_back(std::move(buffer));
+      return;
+    }
     compressionBuffer_ = std::move(buffer);
   }
 
@@ -358,6 +378,34 @@ class WriterContext : public CompressionBufferPool {
     return lowMemoryMode_;
   }
 
+  /// Records that a column writer switched from dictionary to direct encoding
+  /// in the current stripe.
+  void recordAbandonedDictionary() {
+    ++stripeAbandonedDictionaries_;
+  }
+
+  uint32_t stripeAbandonedDictionaries() const {
+    return stripeAbandonedDictionaries_;
+  }
+
+  /// Sets the executor on which the writers of the top level columns write
+  /// each batch in up to 'parallelism' parallel tasks. The columns are written
+  /// on the calling thread if this is not set.
+  void setColumnWriteExecutor(
+      std::shared_ptr<folly::Executor> executor,
+      size_t parallelism) {
+    columnWriteExecutor_ = std::move(executor);
+    columnWriteParallelism_ = parallelism;
+  }
+
+  folly::Executor* columnWriteExecutor() const {
+    return columnWriteExecutor_.get();
+  }
+
+  size_t columnWriteParallelism() const {
+    return columnWriteParallelism_;
+  }
+
   PhysicalSizeAggregator& getPhysicalSizeAggregator(uint32_t node) {
     return *physicalSizeAggregators_.at(node);
   }
@@ -590,6 +638,7 @@ class WriterContext : public CompressionBufferPool {
   void validateConfigs() const;
 
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(bufferMutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -599,6 +648,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(bufferMutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -638,6 +688,15 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
   std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Compression buffers in addition to 'compressionBuffer_' used by column
+  // writers running in parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      spareCompressionBuffers_;
+  std::shared_ptr<folly::Executor> columnWriteExecutor_;
+  size_t columnWriteParallelism_{0};
+  // Serializes access to the compression buffers and 'decodedVectorPool_'
+  // from column writers running in parallel.
+  std::mutex bufferMutex_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -655,6 +714,7 @@ class WriterContext : public CompressionBufferPool {
 
   /// stats
   uint32_t stripeIndex_{0};
+  uint32_t stripeAbandonedDictionaries_{0};
   uint64_t fileRowCount_{0};
   uint64_t stripeRowCount_{0};
   uint32_t indexRowCount_{0};
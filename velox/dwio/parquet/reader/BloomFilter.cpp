@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Multipliers that select the bit to set in each word of a block.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Upper bound of the size of a serialized thrift::BloomFilterHeader.
+constexpr uint64_t kMaxHeaderSize = 64;
+
+std::string readBytes(
+    dwio::common::BufferedInput& input,
+    uint64_t offset,
+    uint64_t length) {
+  auto stream =
+      input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  std::string bytes(length, '\0');
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), bytes.data(), bufferStart, bufferEnd);
+  return bytes;
+}
+
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(std::string bitset)
+    : bitset_(std::move(bitset)), numBlocks_(bitset_.size() / kBytesPerBlock) {
+  VELOX_CHECK_GT(numBlocks_, 0);
+  VELOX_CHECK_EQ(bitset_.size() % kBytesPerBlock, 0);
+}
+
+// static
+std::unique_ptr<SplitBlockBloomFilter> SplitBlockBloomFilter::read(
+    dwio::common::BufferedInput& input,
+    uint64_t offset) {
+  const auto fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize);
+  auto headerBytes =
+      readBytes(input, offset, std::min(kMaxHeaderSize, fileSize - offset));
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      headerBytes.data(), headerBytes.size());
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+      protocol(transport);
+  thrift::BloomFilterHeader header;
+  const auto headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % kBytesPerBlock != 0) {
+    return nullptr;
+  }
+  VELOX_CHECK_LE(offset + headerSize + header.numBytes, fileSize);
+  return std::make_unique<SplitBlockBloomFilter>(
+      readBytes(input, offset + headerSize, header.numBytes));
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+const uint32_t* SplitBlockBloomFilter::blockFor(uint64_t hash) const {
+  const auto index = ((hash >> 32) * numBlocks_) >> 32;
+  return reinterpret_cast<const uint32_t*>(bitset_.data()) + index * 8;
+}
+
+bool SplitBlockBloomFilter::mayContain(uint64_t hash) const {
+  const auto* block = blockFor(hash);
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < 8; ++i) {
+    if ((block[i] & (1U << ((key * kSalt[i]) >> 27))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SplitBlockBloomFilter::insert(uint64_t hash) {
+  auto* block = const_cast<uint32_t*>(blockFor(hash));
+  const auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < 8; ++i) {
+    block[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+
+#include <string>
+#include <string_view>
+
+namespace facebook::velox::parquet {
+
+/// A split block Bloom filter as specified by the Parquet format. The bit set
+/// is an array of 256 bit blocks. A value is added by setting one bit in each
+/// of the eight 32 bit words of the block selected by the 64 bit xxHash of
+/// the plain encoded value.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Makes a filter over 'bitset', a multiple of kBytesPerBlock bytes.
+  explicit SplitBlockBloomFilter(std::string bitset);
+
+  /// Reads the filter at 'offset' in the file of 'input'. 'offset' is the
+  /// bloom_filter_offset of a column chunk. Returns nullptr if the algorithm,
+  /// hash or compression of the filter is not supported.
+  static std::unique_ptr<SplitBlockBloomFilter> read(
+      dwio::common::BufferedInput& input,
+      uint64_t offset);
+
+  /// Hashes of values of the INT32, INT64 and BYTE_ARRAY physical types.
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+  /// Returns false if no value with 'hash' has been added.
+  bool mayContain(uint64_t hash) const;
+
+  /// Adds a value with 'hash'.
+  void insert(uint64_t hash);
+
+  const std::string& bitset() const {
+    return bitset_;
+  }
+
+ private:
+  const uint32_t* blockFor(uint64_t hash) const;
+
+  std::string bitset_;
+  const uint64_t numBlocks_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
+
+#include "velox/common/base/SimdUtil.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+using Batch = xsimd::batch<int8_t>;
+
+// Interleaves the elements of type T of each pair of adjacent streams in
+// 'input'. Each stream is 'batchesPerStream' batches. The result has half as
+// many streams of twice as many batches, each element twice as wide.
+template <typename T>
+void zipStreams(
+    const Batch* input,
+    int32_t numStreams,
+    int32_t batchesPerStream,
+    Batch* output) {
+  for (int32_t stream = 0; stream < numStreams; stream += 2) {
+    const Batch* first = input + stream * batchesPerStream;
+    const Batch* second = first + batchesPerStream;
+    Batch* result = output + stream * batchesPerStream;
+    for (int32_t i = 0; i < batchesPerStream; ++i) {
+      auto x = xsimd::bitwise_cast<T>(first[i]);
+      auto y = xsimd::bitwise_cast<T>(second[i]);
+      result[2 * i] = xsimd::bitwise_cast<int8_t>(xsimd::zip_lo(x, y));
+      result[2 * i + 1] = xsimd::bitwise_cast<int8_t>(xsimd::zip_hi(x, y));
+    }
+  }
+}
+
+// Transposes full batches of values of kWidth bytes. Returns the number of
+// values decoded.
+template <int32_t kWidth>
+int64_t decodeBatches(const char* input, int64_t numValues, char* output) {
+  static_assert(kWidth == 4 || kWidth == 8);
+  constexpr int32_t kBatchSize = Batch::size;
+  const int64_t numDecoded = numValues / kBatchSize * kBatchSize;
+  Batch streams[kWidth];
+  Batch zipped[kWidth];
+  for (int64_t row = 0; row < numDecoded; row += kBatchSize) {
+    for (int32_t k = 0; k < kWidth; ++k) {
+      streams[k] = Batch::load_unaligned(
+          reinterpret_cast<const int8_t*>(input + k * numValues + row));
+    }
+    zipStreams<int8_t>(streams, kWidth, 1, zipped);
+    zipStreams<int16_t>(zipped, kWidth / 2, 2, streams);
+    const Batch* values = streams;
+    if constexpr (kWidth == 8) {
+      zipStreams<int32_t>(streams, 2, 4, zipped);
+      values = zipped;
+    }
+    auto* rowOutput = reinterpret_cast<int8_t*>(output + row * kWidth);
+    for (int32_t k = 0; k < kWidth; ++k) {
+      values[k].store_unaligned(rowOutput + k * kBatchSize);
+    }
+  }
+  return numDecoded;
+}
+
+} // namespace
+
+void decodeByteStreamSplit(
+    const char* input,
+    int64_t numValues,
+    int32_t width,
+    char* output) {
+  int64_t row = 0;
+  if (width == 4) {
+    row = decodeBatches<4>(input, numValues, output);
+  } else if (width == 8) {
+    row = decodeBatches<8>(input, numValues, output);
+  }
+  for (; row < numValues; ++row) {
+    for (int32_t k = 0; k < width; ++k) {
+      output[row * width + k] = input[k * numValues + row];
+    }
+  }
+}
+
+} // namespace facebook::velox::parquet
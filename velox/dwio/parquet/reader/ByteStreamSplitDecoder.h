@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace facebook::velox::parquet {
+
+/// Decodes 'numValues' values of 'width' bytes in the BYTE_STREAM_SPLIT
+/// encoding at 'input' into their PLAIN encoding at 'output'. The encoding
+/// stores byte k of all values in the k-th of 'width' streams of 'numValues'
+/// bytes. Widths of 4 and 8 bytes are transposed with SIMD.
+void decodeByteStreamSplit(
+    const char* input,
+    int64_t numValues,
+    int32_t width,
+    char* output);
+
+} // namespace facebook::velox::parquet
@@ -43,6 +43,29 @@ class DeltaBpDecoder {
     }
   }
 
+  /// Number of values in the encoded data.
+  uint64_t totalValueCount() const {
+    return totalValueCount_;
+  }
+
+  /// Reads the next 'numValues' values into 'values'.
+  template <typename T>
+  void readValues(int32_t numValues, T* values) {
+    for (int32_t i = 0; i < numValues; ++i) {
+      values[i] = readLong();
+    }
+  }
+
+  /// Returns the first byte after the encoded data. All values must have been
+  /// read.
+  const char* validDataEnd() const {
+    // The values of the last miniblock are padded to a full miniblock.
+    if (valuesRemainingCurrentMiniBlock_ > 0) {
+      return bufferStart_ + bits::nbytes(deltaBitWidth_ * valuesPerMiniBlock_);
+    }
+    return bufferStart_;
+  }
+
   template <bool hasNulls, typename Visitor>
   void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
     int32_t current = visitor.start();
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+/// Decodes the DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY encodings of
+/// BYTE_ARRAY values. DELTA_LENGTH_BYTE_ARRAY is the DELTA_BINARY_PACKED
+/// lengths of the values followed by the concatenated values.
+/// DELTA_BYTE_ARRAY is the DELTA_BINARY_PACKED lengths of the prefixes shared
+/// with the previous value followed by the suffixes in
+/// DELTA_LENGTH_BYTE_ARRAY. The lengths are decoded for the whole page on
+/// construction. DELTA_LENGTH_BYTE_ARRAY values are returned from the page,
+/// DELTA_BYTE_ARRAY values are materialized in a buffer owned by 'this'.
+class DeltaByteArrayDecoder {
+ public:
+  /// Decodes the page from 'start' to 'end'. 'withPrefix' is true for
+  /// DELTA_BYTE_ARRAY and false for DELTA_LENGTH_BYTE_ARRAY.
+  DeltaByteArrayDecoder(const char* start, const char* end, bool withPrefix) {
+    if (withPrefix) {
+      decodeWithPrefix(start, end);
+    } else {
+      data_ = decodeLengths(start, end);
+    }
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(int32_t numValues, int32_t current, const uint64_t* nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(index_ + numValues, numValues_);
+    index_ += numValues;
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  // Decodes the lengths at 'start' into 'offsets_' and returns the first byte
+  // of the concatenated values.
+  const char* decodeLengths(const char* start, const char* end) {
+    DeltaBpDecoder lengthDecoder(start);
+    numValues_ = lengthDecoder.totalValueCount();
+    offsets_.resize(numValues_ + 1);
+    offsets_[0] = 0;
+    lengthDecoder.readValues(numValues_, offsets_.data() + 1);
+    for (int32_t i = 0; i < numValues_; ++i) {
+      VELOX_CHECK_GE(offsets_[i + 1], 0, "Negative value length");
+      offsets_[i + 1] += offsets_[i];
+    }
+    const char* data = lengthDecoder.validDataEnd();
+    VELOX_CHECK_LE(data + offsets_[numValues_], end, "Truncated values");
+    return data;
+  }
+
+  void decodeWithPrefix(const char* start, const char* end) {
+    DeltaBpDecoder prefixDecoder(start);
+    const int32_t numValues = prefixDecoder.totalValueCount();
+    raw_vector<int32_t> prefixLengths;
+    prefixLengths.resize(numValues);
+    prefixDecoder.readValues(numValues, prefixLengths.data());
+    const char* suffixes = decodeLengths(prefixDecoder.validDataEnd(), end);
+    VELOX_CHECK_EQ(numValues, numValues_, "Prefix and suffix counts differ");
+
+    // The suffix offsets become the offsets of the full values.
+    int64_t totalLength = offsets_[numValues_];
+    for (int32_t i = 0; i < numValues; ++i) {
+      totalLength += prefixLengths[i];
+    }
+    values_.resize(totalLength);
+    char* values = values_.data();
+    int32_t previous = 0;
+    int32_t offset = 0;
+    int32_t suffixOffset = 0;
+    for (int32_t i = 0; i < numValues_; ++i) {
+      const auto prefixLength = prefixLengths[i];
+      VELOX_CHECK(
+          prefixLength >= 0 &&
+              prefixLength <= (i == 0 ? 0 : offset - previous),
+          "Invalid prefix length");
+      const auto suffixLength = offsets_[i + 1] - suffixOffset;
+      std::memcpy(values + offset, values + previous, prefixLength);
+      std::memcpy(
+          values + offset + prefixLength,
+          suffixes + suffixOffset,
+          suffixLength);
+      suffixOffset = offsets_[i + 1];
+      previous = offset;
+      offset += prefixLength + suffixLength;
+      offsets_[i + 1] = offset;
+    }
+    data_ = values;
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(index_, numValues_);
+    const auto begin = offsets_[index_];
+    const auto end = offsets_[++index_];
+    return folly::StringPiece(data_ + begin, end - begin);
+  }
+
+  // Start of the values.
+  const char* data_{nullptr};
+
+  // Offset of each value from 'data_' and the end of the last value.
+  raw_vector<int32_t> offsets_;
+
+  // Materialized values for DELTA_BYTE_ARRAY.
+  std::string values_;
+
+  int32_t numValues_{0};
+
+  // Index of the next value to read.
+  int32_t index_{0};
+};
+
+} // namespace facebook::velox::parquet
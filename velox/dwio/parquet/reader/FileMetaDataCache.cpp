@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/FileMetaDataCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+
+namespace facebook::velox::parquet {
+
+std::unique_ptr<FileMetaDataCache> FileMetaDataCache::instance_ = nullptr;
+
+// static
+std::string FileMetaDataCache::makeKey(
+    const std::string& fileName,
+    uint64_t fileSize,
+    std::string_view version) {
+  return fmt::format("{}:{}:{}", fileName, fileSize, version);
+}
+
+std::shared_ptr<const thrift::FileMetaData> FileMetaDataCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* value = cache_.get(key);
+  if (value == nullptr) {
+    return nullptr;
+  }
+  auto metadata = *value;
+  cache_.release(key);
+  return metadata;
+}
+
+bool FileMetaDataCache::insert(
+    const std::string& key,
+    std::shared_ptr<const thrift::FileMetaData> metadata,
+    uint64_t bytes) {
+  VELOX_CHECK_NOT_NULL(metadata);
+  auto value = std::make_unique<std::shared_ptr<const thrift::FileMetaData>>(
+      std::move(metadata));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!cache_.add(key, value.get(), bytes)) {
+    return false;
+  }
+  value.release();
+  return true;
+}
+
+SimpleLRUCacheStats FileMetaDataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.stats();
+}
+
+void FileMetaDataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.free(cache_.maxSize());
+}
+
+} // namespace facebook::velox::parquet
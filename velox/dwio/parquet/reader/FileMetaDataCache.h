@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+
+namespace facebook::velox::parquet {
+
+namespace thrift {
+class FileMetaData;
+}
+
+/// A process-wide cache of parsed Parquet footers. Splits of the same file
+/// each open a reader, which otherwise reads and parses the same Thrift footer
+/// again. Wide schemas make parsing costly. Entries are keyed by file name,
+/// size and version, e.g. modification time, so that a rewritten file is not
+/// served a stale footer. Thread safe.
+class FileMetaDataCache {
+ public:
+  /// Creates the singleton instance with a capacity of 'maxBytes' if it does
+  /// not exist and returns it.
+  static FileMetaDataCache* create(uint64_t maxBytes) {
+    if (instance_ == nullptr) {
+      instance_ =
+          std::unique_ptr<FileMetaDataCache>(new FileMetaDataCache(maxBytes));
+    }
+    return instance_.get();
+  }
+
+  /// Returns the process-wide instance or nullptr if it has not been created.
+  static FileMetaDataCache* getInstance() {
+    return instance_.get();
+  }
+
+  static void testingClear() {
+    instance_ = nullptr;
+  }
+
+  /// Makes the key for a file. 'version' identifies the contents of the file,
+  /// e.g. its modification time or etag.
+  static std::string makeKey(
+      const std::string& fileName,
+      uint64_t fileSize,
+      std::string_view version);
+
+  /// Returns the footer for 'key' or nullptr if not cached.
+  std::shared_ptr<const thrift::FileMetaData> find(const std::string& key);
+
+  /// Adds 'metadata' for 'key'. 'bytes' is the memory it takes. Returns false
+  /// if 'key' is already cached or 'metadata' does not fit.
+  bool insert(
+      const std::string& key,
+      std::shared_ptr<const thrift::FileMetaData> metadata,
+      uint64_t bytes);
+
+  SimpleLRUCacheStats stats() const;
+
+  void clear();
+
+ private:
+  static std::unique_ptr<FileMetaDataCache> instance_;
+
+  explicit FileMetaDataCache(uint64_t maxBytes) : cache_(maxBytes) {}
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const thrift::FileMetaData>>
+      cache_;
+};
+
+} // namespace facebook::velox::parquet
@@ -21,6 +21,17 @@
 
 namespace facebook::velox::parquet {
 
+namespace thrift {
+class Statistics;
+}
+
+/// Builds the statistics of 'numRows' values of 'type' from the thrift
+/// statistics of a column chunk or of a page.
+std::unique_ptr<dwio::common::ColumnStatistics> buildColumnStatisticsFromThrift(
+    const thrift::Statistics& columnChunkStats,
+    const velox::Type& type,
+    uint64_t numRowsInRowGroup);
+
 /// ColumnChunkMetaDataPtr is a proxy around pointer to thrift::ColumnChunk.
 class ColumnChunkMetaDataPtr {
  public:
@@ -37,6 +48,31 @@ class ColumnChunkMetaDataPtr {
   /// Check the presence of the dictionary page offset in ColumnChunk metadata.
   bool hasDictionaryPageOffset() const;
 
+  /// Check the presence of a Bloom filter in ColumnChunk metadata.
+  bool hasBloomFilter() const;
+
+  /// True if all data pages of the ColumnChunk are known to be dictionary
+  /// encoded, so that the dictionary page holds all the values of the chunk.
+  bool isOnlyDictionaryEncoded() const;
+
+  /// File offset of the Bloom filter header.
+  /// Must check for its presence using hasBloomFilter().
+  int64_t bloomFilterOffset() const;
+
+  /// Check the presence of the ColumnIndex and the OffsetIndex of the
+  /// ColumnChunk. Both are needed to skip pages by their statistics.
+  bool hasPageIndex() const;
+
+  /// File offset and length of the serialized ColumnIndex.
+  /// Must check for its presence using hasPageIndex().
+  int64_t columnIndexOffset() const;
+  int32_t columnIndexLength() const;
+
+  /// File offset and length of the serialized OffsetIndex.
+  /// Must check for its presence using hasPageIndex().
+  int64_t offsetIndexOffset() const;
+  int32_t offsetIndexLength() const;
+
   /// Return the ColumnChunk statistics.
   std::unique_ptr<dwio::common::ColumnStatistics> getColumnStatistics(
       const TypePtr type,
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/Metadata.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+template <typename T>
+std::unique_ptr<T> deserialize(std::string_view data) {
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      data.data(), data.size());
+  auto protocol = std::make_unique<
+      apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
+      transport);
+  auto result = std::make_unique<T>();
+  result->read(protocol.get());
+  return result;
+}
+
+} // namespace
+
+PageIndex::PageIndex(
+    std::string_view columnIndex,
+    std::string_view offsetIndex,
+    TypePtr type,
+    int64_t numRows)
+    : type_(std::move(type)),
+      numRows_(numRows),
+      columnIndex_(deserialize<thrift::ColumnIndex>(columnIndex)),
+      offsetIndex_(deserialize<thrift::OffsetIndex>(offsetIndex)) {
+  const auto numPages = offsetIndex_->page_locations.size();
+  VELOX_CHECK_EQ(columnIndex_->null_pages.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_->min_values.size(), numPages);
+  VELOX_CHECK_EQ(columnIndex_->max_values.size(), numPages);
+  VELOX_CHECK(
+      !columnIndex_->__isset.null_counts ||
+      columnIndex_->null_counts.size() == numPages);
+}
+
+PageIndex::~PageIndex() = default;
+
+int32_t PageIndex::numPages() const {
+  return offsetIndex_->page_locations.size();
+}
+
+RowRange PageIndex::pageRows(int32_t page) const {
+  const auto& locations = offsetIndex_->page_locations;
+  auto end =
+      page + 1 < locations.size() ? locations[page + 1].first_row_index
+                                  : numRows_;
+  return {locations[page].first_row_index, end};
+}
+
+bool PageIndex::pageMatches(int32_t page, common::Filter& filter) const {
+  const auto rows = pageRows(page);
+  const uint64_t numRows = rows.end - rows.begin;
+  thrift::Statistics stats;
+  if (!columnIndex_->null_pages[page]) {
+    stats.__set_min_value(columnIndex_->min_values[page]);
+    stats.__set_max_value(columnIndex_->max_values[page]);
+  }
+  if (columnIndex_->__isset.null_counts) {
+    stats.__set_null_count(columnIndex_->null_counts[page]);
+  } else if (columnIndex_->null_pages[page]) {
+    stats.__set_null_count(numRows);
+  }
+  auto pageStats = buildColumnStatisticsFromThrift(stats, *type_, numRows);
+  return testFilter(&filter, pageStats.get(), numRows, type_);
+}
+
+void PageIndex::addSkippedRows(
+    common::Filter& filter,
+    std::vector<RowRange>& ranges) const {
+  for (auto page = 0; page < numPages(); ++page) {
+    if (!pageMatches(page, filter)) {
+      ranges.push_back(pageRows(page));
+    }
+  }
+}
+
+// static
+void PageIndex::mergeRanges(std::vector<RowRange>& ranges) {
+  if (ranges.empty()) {
+    return;
+  }
+  std::sort(ranges.begin(), ranges.end(), [](auto& left, auto& right) {
+    return left.begin < right.begin;
+  });
+  int32_t numMerged = 0;
+  for (auto i = 1; i < ranges.size(); ++i) {
+    if (ranges[i].begin <= ranges[numMerged].end) {
+      ranges[numMerged].end = std::max(ranges[numMerged].end, ranges[i].end);
+    } else {
+      ranges[++numMerged] = ranges[i];
+    }
+  }
+  ranges.resize(numMerged + 1);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/type/Filter.h"
+#include "velox/type/Type.h"
+
+#include <string_view>
+
+namespace facebook::velox::parquet {
+
+namespace thrift {
+class ColumnIndex;
+class OffsetIndex;
+} // namespace thrift
+
+/// A range of rows [begin, end) within a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// The ColumnIndex and OffsetIndex of a column chunk. These give the min,
+/// max and null count of each page of the chunk and the rows the page
+/// covers, so that pages with no value passing a filter are skipped
+/// without being decompressed or decoded.
+class PageIndex {
+ public:
+  /// 'columnIndex' and 'offsetIndex' are the serialized thrift structures of
+  /// a column chunk of 'type' in a row group of 'numRows' rows.
+  PageIndex(
+      std::string_view columnIndex,
+      std::string_view offsetIndex,
+      TypePtr type,
+      int64_t numRows);
+
+  ~PageIndex();
+
+  int32_t numPages() const;
+
+  /// Returns the rows of the row group covered by page 'page'.
+  RowRange pageRows(int32_t page) const;
+
+  /// Returns true if some value in page 'page' may pass 'filter'.
+  bool pageMatches(int32_t page, common::Filter& filter) const;
+
+  /// Adds to 'ranges' the rows of the pages where no value passes 'filter'.
+  void addSkippedRows(common::Filter& filter, std::vector<RowRange>& ranges)
+      const;
+
+  /// Sorts 'ranges' and merges the ones that overlap or touch.
+  static void mergeRanges(std::vector<RowRange>& ranges);
+
+ private:
+  const TypePtr type_;
+  const int64_t numRows_;
+  std::unique_ptr<thrift::ColumnIndex> columnIndex_;
+  std::unique_ptr<thrift::OffsetIndex> offsetIndex_;
+};
+
+} // namespace facebook::velox::parquet
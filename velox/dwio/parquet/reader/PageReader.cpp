@@ -166,7 +166,7 @@ void PageReader::setPageRowInfo(bool forRepDef) {
 void PageReader::readPageDefLevels() {
   VELOX_CHECK(kRowsUnknown == numRowsInPage_ || maxDefine_ > 1);
   definitionLevels_.resize(numRepDefsInPage_);
-  wideDefineDecoder_->GetBatch(definitionLevels_.data(), numRepDefsInPage_);
+  wideDefineDecoder_->readLevels(numRepDefsInPage_, definitionLevels_.data());
   leafNulls_.resize(bits::nwords(numRepDefsInPage_));
   leafNullsSize_ = getLengthsAndNulls(
       LevelMode::kNulls,
@@ -213,9 +213,9 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   auto pageEnd = pageData_ + pageHeader.uncompressed_page_size;
   if (maxRepeat_ > 0) {
     uint32_t repeatLength = readField<int32_t>(pageData_);
-    repeatDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        repeatLength,
+    repeatDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + repeatLength,
         ::arrow::bit_util::NumRequiredBits(maxRepeat_));
 
     pageData_ += repeatLength;
@@ -229,9 +229,9 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
           pageData_ + defineLength,
           ::arrow::bit_util::NumRequiredBits(maxDefine_));
     }
-    wideDefineDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        defineLength,
+    wideDefineDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + defineLength,
         ::arrow::bit_util::NumRequiredBits(maxDefine_));
     pageData_ += defineLength;
   }
@@ -267,12 +267,26 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
       pageHeader.data_page_header_v2.repetition_levels_byte_length;
 
   auto bytes = pageHeader.compressed_page_size;
-  pageData_ = readBytes(bytes, pageBuffer_);
+  auto levelsSize = repeatLength + defineLength;
+  if (row == kRepDefOnly) {
+    // The levels are stored uncompressed ahead of the values. Copy them out
+    // and skip the values without reading or decompressing them.
+    auto levels = readBytes(levelsSize, pageBuffer_);
+    if (!pageBuffer_ || levels != pageBuffer_->as<char>()) {
+      dwio::common::ensureCapacity<char>(pageBuffer_, levelsSize, &pool_);
+      memcpy(pageBuffer_->asMutable<char>(), levels, levelsSize);
+    }
+    pageData_ = pageBuffer_->as<char>();
+    skipBytes(
+        bytes - levelsSize, inputStream_.get(), bufferStart_, bufferEnd_);
+  } else {
+    pageData_ = readBytes(bytes, pageBuffer_);
+  }
 
   if (repeatLength) {
-    repeatDecoder_ = std::make_unique<::arrow::util::RleDecoder>(
-        reinterpret_cast<const uint8_t*>(pageData_),
-        repeatLength,
+    repeatDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_,
+        pageData_ + repeatLength,
         ::arrow::bit_util::NumRequiredBits(maxRepeat_));
   }
 
@@ -281,29 +295,28 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
         pageData_ + repeatLength,
         pageData_ + repeatLength + defineLength,
         ::arrow::bit_util::NumRequiredBits(maxDefine_));
+    wideDefineDecoder_ = std::make_unique<RleBpDecoder>(
+        pageData_ + repeatLength,
+        pageData_ + repeatLength + defineLength,
+        ::arrow::bit_util::NumRequiredBits(maxDefine_));
+  }
+  if (row == kRepDefOnly) {
+    return;
   }
-  auto levelsSize = repeatLength + defineLength;
   pageData_ += levelsSize;
-  if (pageHeader.data_page_header_v2.__isset.is_compressed ||
-      pageHeader.data_page_header_v2.is_compressed) {
+  if (pageHeader.data_page_header_v2.is_compressed) {
     pageData_ = decompressData(
         pageData_,
         pageHeader.compressed_page_size - levelsSize,
         pageHeader.uncompressed_page_size - levelsSize);
   }
-  if (row == kRepDefOnly) {
-    skipBytes(bytes, inputStream_.get(), bufferStart_, bufferEnd_);
-    return;
-  }
 
   encodedDataSize_ = pageHeader.uncompressed_page_size - levelsSize;
   encoding_ = pageHeader.data_page_header_v2.encoding;
-  if (numRowsInPage_ == kRowsUnknown) {
+  if (!hasChunkRepDefs_ && (numRowsInPage_ == kRowsUnknown || maxDefine_ > 1)) {
     readPageDefLevels();
   }
-  if (row != kRepDefOnly) {
-    makeDecoder();
-  }
+  makeDecoder();
 }
 
 void PageReader::prepareDictionary(const PageHeader& pageHeader) {
@@ -495,13 +508,13 @@ void PageReader::preloadRepDefs() {
     auto begin = definitionLevels_.size();
     auto numLevels = definitionLevels_.size() + numRepDefsInPage_;
     definitionLevels_.resize(numLevels);
-    wideDefineDecoder_->GetBatch(
-        definitionLevels_.data() + begin, numRepDefsInPage_);
+    wideDefineDecoder_->readLevels(
+        numRepDefsInPage_, definitionLevels_.data() + begin);
     if (repeatDecoder_) {
       repetitionLevels_.resize(numLevels);
 
-      repeatDecoder_->GetBatch(
-          repetitionLevels_.data() + begin, numRepDefsInPage_);
+      repeatDecoder_->readLevels(
+          numRepDefsInPage_, repetitionLevels_.data() + begin);
     }
     leafNulls_.resize(bits::nwords(leafNullsSize_ + numRepDefsInPage_));
     auto numLeaves = getLengthsAndNulls(
@@ -601,6 +614,13 @@ int32_t PageReader::getLengthsAndNulls(
 
 void PageReader::makeDecoder() {
   auto parquetType = type_->parquetType_.value();
+  // The encoding may change from page to page. skip() tests which decoder is
+  // set.
+  directDecoder_.reset();
+  stringDecoder_.reset();
+  booleanDecoder_.reset();
+  deltaBpDecoder_.reset();
+  deltaByteArrayDecoder_.reset();
   switch (encoding_) {
     case Encoding::RLE_DICTIONARY:
     case Encoding::PLAIN_DICTIONARY:
@@ -608,37 +628,7 @@ void PageReader::makeDecoder() {
           pageData_ + 1, pageData_ + encodedDataSize_, pageData_[0]);
       break;
     case Encoding::PLAIN:
-      switch (parquetType) {
-        case thrift::Type::BOOLEAN:
-          booleanDecoder_ = std::make_unique<BooleanDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::BYTE_ARRAY:
-          stringDecoder_ = std::make_unique<StringDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
-          if (type_->type()->isVarbinary()) {
-            stringDecoder_ = std::make_unique<StringDecoder>(
-                pageData_, pageData_ + encodedDataSize_, type_->typeLength_);
-          } else {
-            directDecoder_ =
-                std::make_unique<dwio::common::DirectDecoder<true>>(
-                    std::make_unique<dwio::common::SeekableArrayInputStream>(
-                        pageData_, encodedDataSize_),
-                    false,
-                    type_->typeLength_,
-                    true);
-          }
-          break;
-        default: {
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              parquetTypeBytes(type_->parquetType_.value()));
-        }
-      }
+      makePlainDecoder(pageData_, encodedDataSize_);
       break;
     case Encoding::DELTA_BINARY_PACKED:
       switch (parquetType) {
@@ -651,11 +641,91 @@ void PageReader::makeDecoder() {
               "DELTA_BINARY_PACKED decoder only supports INT32 and INT64");
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK(
+          parquetType == thrift::Type::BYTE_ARRAY,
+          "DELTA_LENGTH_BYTE_ARRAY decoder only supports BYTE_ARRAY");
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_, false);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      VELOX_CHECK(
+          parquetType == thrift::Type::BYTE_ARRAY ||
+              (parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY &&
+               type_->type()->isVarbinary()),
+          "DELTA_BYTE_ARRAY decoder only supports binary types");
+      deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+          pageData_, pageData_ + encodedDataSize_, true);
+      break;
+    case Encoding::BYTE_STREAM_SPLIT: {
+      int32_t width;
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+          width = parquetTypeBytes(parquetType);
+          break;
+        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+          width = type_->typeLength_;
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT decoder does not support {}", parquetType);
+      }
+      VELOX_CHECK_GT(width, 0);
+      VELOX_CHECK_EQ(
+          encodedDataSize_ % width,
+          0,
+          "BYTE_STREAM_SPLIT data is not a multiple of the value width");
+      // The values are transposed into their PLAIN encoding for the PLAIN
+      // decoders, which keep the fast paths for filters.
+      dwio::common::ensureCapacity<char>(
+          byteStreamSplitData_, encodedDataSize_ + simd::kPadding, &pool_);
+      decodeByteStreamSplit(
+          pageData_,
+          encodedDataSize_ / width,
+          width,
+          byteStreamSplitData_->asMutable<char>());
+      makePlainDecoder(byteStreamSplitData_->as<char>(), encodedDataSize_);
+      break;
+    }
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makePlainDecoder(const char* data, int32_t size) {
+  auto parquetType = type_->parquetType_.value();
+  switch (parquetType) {
+    case thrift::Type::BOOLEAN:
+      booleanDecoder_ = std::make_unique<BooleanDecoder>(data, data + size);
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      stringDecoder_ = std::make_unique<StringDecoder>(data, data + size);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      if (type_->type()->isVarbinary()) {
+        stringDecoder_ = std::make_unique<StringDecoder>(
+            data, data + size, type_->typeLength_);
+      } else {
+        directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                data, size),
+            false,
+            type_->typeLength_,
+            true);
+      }
+      break;
+    default: {
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(data, size),
+          false,
+          parquetTypeBytes(parquetType));
+    }
+  }
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -685,6 +755,8 @@ void PageReader::skip(int64_t numRows) {
     booleanDecoder_->skip(toSkip);
   } else if (deltaBpDecoder_) {
     deltaBpDecoder_->skip(toSkip);
+  } else if (deltaByteArrayDecoder_) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else {
     VELOX_FAIL("No decoder to skip");
   }
@@ -695,17 +767,23 @@ int32_t PageReader::skipNulls(int32_t numValues) {
     return numValues;
   }
   VELOX_CHECK(1 == maxDefine_ || !leafNulls_.empty());
+  if (!isTopLevel_) {
+    // The leaf nulls are already decoded with the repdefs. Count the
+    // non-nulls in place instead of copying the skipped range out.
+    auto numNonNulls = bits::countBits(
+        leafNulls_.data(),
+        numLeafNullsConsumed_,
+        numLeafNullsConsumed_ + numValues);
+    numLeafNullsConsumed_ += numValues;
+    return numNonNulls;
+  }
   dwio::common::ensureCapacity<bool>(tempNulls_, numValues, &pool_);
   tempNulls_->setSize(0);
-  if (isTopLevel_) {
-    bool allOnes;
-    defineDecoder_->readBits(
-        numValues, tempNulls_->asMutable<uint64_t>(), &allOnes);
-    if (allOnes) {
-      return numValues;
-    }
-  } else {
-    readNulls(numValues, tempNulls_);
+  bool allOnes;
+  defineDecoder_->readBits(
+      numValues, tempNulls_->asMutable<uint64_t>(), &allOnes);
+  if (allOnes) {
+    return numValues;
   }
   auto words = tempNulls_->as<uint64_t>();
   return bits::countBits(words, 0, numValues);
@@ -883,6 +961,17 @@ bool PageReader::rowsForPage(
   return true;
 }
 
+const VectorPtr& PageReader::readDictionaryPage(const TypePtr& type) {
+  VELOX_CHECK_EQ(pageStart_, 0, "The dictionary page must be read first");
+  auto pageHeader = readPageHeader();
+  pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
+  VELOX_CHECK(
+      pageHeader.type == thrift::PageType::DICTIONARY_PAGE,
+      "Column chunk does not start with a dictionary page");
+  prepareDictionary(pageHeader);
+  return dictionaryValues(type);
+}
+
 const VectorPtr& PageReader::dictionaryValues(const TypePtr& type) {
   if (!dictionaryValues_) {
     dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
@@ -22,7 +22,9 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/ByteStreamSplitDecoder.h"
 #include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -112,6 +114,11 @@ class PageReader {
   // Returns the current string dictionary as a FlatVector<StringView>.
   const VectorPtr& dictionaryValues(const TypePtr& type);
 
+  /// Reads the dictionary page at the start of the column chunk and returns
+  /// its values as in dictionaryValues(). Data pages are not read. Used for
+  /// testing filters against the dictionary before reading a row group.
+  const VectorPtr& readDictionaryPage(const TypePtr& type);
+
   // True if the current page holds dictionary indices.
   bool isDictionary() const {
     return encoding_ == thrift::Encoding::PLAIN_DICTIONARY ||
@@ -127,6 +134,11 @@ class PageReader {
     return encoding_ == thrift::Encoding::DELTA_BINARY_PACKED;
   }
 
+  bool isDeltaByteArray() const {
+    return encoding_ == thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY ||
+        encoding_ == thrift::Encoding::DELTA_BYTE_ARRAY;
+  }
+
   /// Returns the range of repdefs for the top level rows covered by the last
   /// decoderepDefs().
   std::pair<int32_t, int32_t> repDefRange() const {
@@ -193,6 +205,9 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Makes a decoder for PLAIN encoded values from 'data' to 'data' + 'size'.
+  void makePlainDecoder(const char* data, int32_t size);
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -297,6 +312,9 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (isDeltaByteArray()) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -305,6 +323,8 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (isDeltaByteArray()) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -355,11 +375,12 @@ class PageReader {
   BufferPtr tempNulls_;
   BufferPtr nullsInReadRange_;
   BufferPtr multiPageNulls_;
-  // Decoder for single bit definition levels. the arrow decoders are used for
-  // multibit levels pending fixing RleBpDecoder for the case.
+  // Decoder for single bit definition levels. Multibit levels are decoded
+  // into 'repetitionLevels_' and 'definitionLevels_' by 'repeatDecoder_' and
+  // 'wideDefineDecoder_'.
   std::unique_ptr<RleBpDecoder> defineDecoder_;
-  std::unique_ptr<::arrow::util::RleDecoder> repeatDecoder_;
-  std::unique_ptr<::arrow::util::RleDecoder> wideDefineDecoder_;
+  std::unique_ptr<RleBpDecoder> repeatDecoder_;
+  std::unique_ptr<RleBpDecoder> wideDefineDecoder_;
 
   // True for a leaf column for which repdefs are loaded for the whole column
   // chunk. This is typically the leaftmost leaf of a list. Other leaves under
@@ -418,6 +439,9 @@ class PageReader {
   // contiguous run of bytes.
   const char* pageData_{nullptr};
 
+  // PLAIN encoding of the values of a BYTE_STREAM_SPLIT page.
+  BufferPtr byteStreamSplitData_;
+
   // Dictionary contents.
   dwio::common::DictionaryValues dictionary_;
   thrift::Encoding::type dictionaryEncoding_;
@@ -479,6 +503,7 @@ class PageReader {
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
   std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -17,6 +17,7 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 
 namespace facebook::velox::parquet {
 
@@ -29,8 +30,10 @@ std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t /*rowsPerRowGroup*/,
-    const dwio::common::StatsContext& /*writerContext*/,
+    const dwio::common::StatsContext& writerContext,
     FilterRowGroupsResult& result) {
+  auto* input =
+      static_cast<const ParquetStatsContext&>(writerContext).input;
   result.totalCount =
       std::max<int>(result.totalCount, fileMetaDataPtr_.numRowGroups());
   auto nwords = bits::nwords(result.totalCount);
@@ -44,13 +47,13 @@ void ParquetData::filterRowGroups(
   }
   if (scanSpec.filter() || scanSpec.numMetadataFilters() > 0) {
     for (auto i = 0; i < fileMetaDataPtr_.numRowGroups(); ++i) {
-      if (scanSpec.filter() && !rowGroupMatches(i, scanSpec.filter())) {
+      if (scanSpec.filter() && !rowGroupMatches(i, scanSpec.filter(), input)) {
         bits::setBit(result.filterResult.data(), i);
         continue;
       }
       for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
         auto* metadataFilter = scanSpec.metadataFilterAt(j);
-        if (!rowGroupMatches(i, metadataFilter)) {
+        if (!rowGroupMatches(i, metadataFilter, input)) {
           bits::setBit(
               result.metadataFilterResults[metadataFiltersStartIndex + j]
                   .second.data(),
@@ -61,7 +64,10 @@ void ParquetData::filterRowGroups(
   }
 }
 
-bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
+bool ParquetData::rowGroupMatches(
+    uint32_t rowGroupId,
+    common::Filter* filter,
+    dwio::common::BufferedInput* input) {
   auto column = type_->column();
   auto type = type_->type();
   auto rowGroup = fileMetaDataPtr_.rowGroup(rowGroupId);
@@ -75,11 +81,153 @@ bool ParquetData::rowGroupMatches(uint32_t rowGroupId, common::Filter* filter) {
   if (columnChunk.hasStatistics()) {
     auto columnStats =
         columnChunk.getColumnStatistics(type, rowGroup.numRows());
-    return testFilter(filter, columnStats.get(), rowGroup.numRows(), type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.numRows(), type)) {
+      return false;
+    }
+  }
+  if (input && columnChunk.hasBloomFilter() &&
+      !bloomFilterMatches(rowGroupId, *filter, *input)) {
+    return false;
+  }
+  if (input && columnChunk.isOnlyDictionaryEncoded()) {
+    return dictionaryMatches(rowGroupId, *filter, *input);
   }
   return true;
 }
 
+namespace {
+
+// Returns the values that pass 'filter' if 'filter' passes only a few
+// distinct integers.
+std::optional<std::vector<int64_t>> bigintValues(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      if (range.isSingleValue()) {
+        return std::vector<int64_t>{range.lower()};
+      }
+      return std::nullopt;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return static_cast<const common::BigintValuesUsingHashTable&>(filter)
+          .values();
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return static_cast<const common::BigintValuesUsingBitmask&>(filter)
+          .values();
+    default:
+      return std::nullopt;
+  }
+}
+
+// Returns the hashes of the values that pass 'filter' in a column chunk of
+// 'parquetType' if 'filter' passes only a few distinct values.
+std::optional<std::vector<uint64_t>> bloomFilterHashes(
+    const common::Filter& filter,
+    thrift::Type::type parquetType) {
+  std::vector<uint64_t> hashes;
+  switch (parquetType) {
+    case thrift::Type::INT32:
+    case thrift::Type::INT64: {
+      auto values = bigintValues(filter);
+      if (!values.has_value()) {
+        return std::nullopt;
+      }
+      for (auto value : values.value()) {
+        hashes.push_back(
+            parquetType == thrift::Type::INT32
+                ? SplitBlockBloomFilter::hash(static_cast<int32_t>(value))
+                : SplitBlockBloomFilter::hash(value));
+      }
+      return hashes;
+    }
+    case thrift::Type::BYTE_ARRAY:
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      if (filter.kind() == common::FilterKind::kBytesRange) {
+        auto& range = static_cast<const common::BytesRange&>(filter);
+        if (range.isSingleValue()) {
+          return std::vector<uint64_t>{
+              SplitBlockBloomFilter::hash(range.lower())};
+        }
+      } else if (filter.kind() == common::FilterKind::kBytesValues) {
+        for (auto& value :
+             static_cast<const common::BytesValues&>(filter).values()) {
+          hashes.push_back(SplitBlockBloomFilter::hash(value));
+        }
+        return hashes;
+      }
+      return std::nullopt;
+    default:
+      return std::nullopt;
+  }
+}
+
+} // namespace
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter,
+    dwio::common::BufferedInput& input) {
+  if (filter.testNull() || !type_->parquetType_.has_value()) {
+    return true;
+  }
+  // Compute the hashes first so that the filter is read only if it can be
+  // used.
+  auto hashes = bloomFilterHashes(filter, type_->parquetType_.value());
+  if (!hashes.has_value()) {
+    return true;
+  }
+  auto columnChunk =
+      fileMetaDataPtr_.rowGroup(rowGroupId).columnChunk(type_->column());
+  auto bloomFilter =
+      SplitBlockBloomFilter::read(input, columnChunk.bloomFilterOffset());
+  if (!bloomFilter) {
+    return true;
+  }
+  for (auto hash : hashes.value()) {
+    if (bloomFilter->mayContain(hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ParquetData::dictionaryMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter,
+    dwio::common::BufferedInput& input) {
+  if (filter.testNull() || !type_->parquetType_.has_value() ||
+      type_->parquetType_.value() != thrift::Type::BYTE_ARRAY ||
+      (type_->type()->kind() != TypeKind::VARCHAR &&
+       type_->type()->kind() != TypeKind::VARBINARY)) {
+    return true;
+  }
+  auto columnChunk =
+      fileMetaDataPtr_.rowGroup(rowGroupId).columnChunk(type_->column());
+  const auto dictionaryOffset = columnChunk.dictionaryPageOffset();
+  const auto dictionaryLength = columnChunk.dataPageOffset() - dictionaryOffset;
+  if (dictionaryOffset < 4 || dictionaryLength <= 0) {
+    return true;
+  }
+  PageReader reader(
+      input.read(
+          dictionaryOffset,
+          dictionaryLength,
+          dwio::common::LogType::STRIPE_INDEX),
+      pool_,
+      type_,
+      columnChunk.compression(),
+      dictionaryLength);
+  const auto* values =
+      reader.readDictionaryPage(type_->type())->asFlatVector<StringView>();
+  for (auto i = 0; i < values->size(); ++i) {
+    const auto& value = values->valueAt(i);
+    if (filter.testBytes(value.data(), value.size())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
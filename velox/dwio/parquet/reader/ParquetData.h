@@ -30,6 +30,18 @@ class BufferedInput;
 
 namespace facebook::velox::parquet {
 
+/// Context for filtering the row groups of a Parquet file.
+struct ParquetStatsContext : dwio::common::StatsContext {
+  ParquetStatsContext() = default;
+
+  explicit ParquetStatsContext(dwio::common::BufferedInput* input)
+      : input(input) {}
+
+  /// Input for reading the Bloom filters of column chunks. Bloom filters are
+  /// not used if this is nullptr.
+  dwio::common::BufferedInput* input{nullptr};
+};
+
 class ParquetParams : public dwio::common::FormatParams {
  public:
   ParquetParams(
@@ -188,8 +200,27 @@ class ParquetData : public dwio::common::FormatData {
 
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
-  /// stats in 'rowGroup'.
-  bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
+  /// stats, the Bloom filter and the dictionary in 'rowGroup'. The Bloom
+  /// filter and the dictionary are read from 'input' if not nullptr.
+  bool rowGroupMatches(
+      uint32_t rowGroupId,
+      common::Filter* filter,
+      dwio::common::BufferedInput* input);
+
+  /// True if 'filter' may have hits according to the Bloom filter of the
+  /// column chunk in 'rowGroupId'. Only equality and IN filters are tested.
+  bool bloomFilterMatches(
+      uint32_t rowGroupId,
+      const common::Filter& filter,
+      dwio::common::BufferedInput& input);
+
+  /// True if 'filter' may have hits according to the dictionary of the column
+  /// chunk in 'rowGroupId'. Only tested for string columns whose data pages
+  /// are all dictionary encoded, where the dictionary has all the values.
+  bool dictionaryMatches(
+      uint32_t rowGroupId,
+      const common::Filter& filter,
+      dwio::common::BufferedInput& input);
 
  protected:
   memory::MemoryPool& pool_;
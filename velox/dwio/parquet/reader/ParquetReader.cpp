@@ -19,6 +19,8 @@
 #include <boost/algorithm/string.hpp>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 
+#include "velox/dwio/parquet/reader/FileMetaDataCache.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetColumnReader.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -76,15 +78,22 @@ class ReaderBase {
       StructColumnReader& reader);
 
   /// Returns the uncompressed size for columns in 'type' and its children in
-  /// row group.
+  /// row group. If 'scanSpec' is not nullptr, struct fields that it does not
+  /// read, i.e. fields that are missing from it or constant, are not counted.
   int64_t rowGroupUncompressedSize(
       int32_t rowGroupIndex,
-      const dwio::common::TypeWithId& type) const;
+      const dwio::common::TypeWithId& type,
+      const common::ScanSpec* scanSpec = nullptr) const;
 
   /// Checks whether the specific row group has been loaded and
   /// the data still exists in the buffered inputs.
   bool isRowGroupBuffered(int32_t rowGroupIndex) const;
 
+  /// Drops the buffered input of a row group that will not be read.
+  void unloadRowGroup(int32_t rowGroupIndex) {
+    inputs_.erase(rowGroupIndex);
+  }
+
  private:
   // Reads and parses file footer.
   void loadFileMetaData();
@@ -113,7 +122,7 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -145,6 +154,21 @@ void ReaderBase::loadFileMetaData() {
       fileLength_ <= std::max(filePreloadThreshold_, footerEstimatedSize_);
   uint64_t readSize = preloadFile ? fileLength_ : footerEstimatedSize_;
 
+  auto* cache = FileMetaDataCache::getInstance();
+  std::string cacheKey;
+  if (cache != nullptr && !options_.fileVersion().empty()) {
+    cacheKey = FileMetaDataCache::makeKey(
+        input_->getReadFile()->getName(), fileLength_, options_.fileVersion());
+    fileMetaData_ = cache->find(cacheKey);
+    if (fileMetaData_ != nullptr) {
+      if (preloadFile) {
+        // Keep the data of a small file in one read as on a miss.
+        input_->loadCompleteFile();
+      }
+      return;
+    }
+  }
+
   std::unique_ptr<dwio::common::SeekableInputStream> stream;
   if (preloadFile) {
     stream = input_->loadCompleteFile();
@@ -187,8 +211,13 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = std::move(fileMetaData);
+  if (!cacheKey.empty()) {
+    // The parsed footer takes several times the bytes of the serialized one.
+    cache->insert(cacheKey, fileMetaData_, 4 * footerLength);
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -705,7 +734,8 @@ void ReaderBase::scheduleRowGroups(
 
 int64_t ReaderBase::rowGroupUncompressedSize(
     int32_t rowGroupIndex,
-    const dwio::common::TypeWithId& type) const {
+    const dwio::common::TypeWithId& type,
+    const common::ScanSpec* scanSpec) const {
   if (type.column() != ParquetTypeWithId::kNonLeaf) {
     VELOX_CHECK_LT(rowGroupIndex, fileMetaData_->row_groups.size());
     VELOX_CHECK_LT(
@@ -715,8 +745,17 @@ int64_t ReaderBase::rowGroupUncompressedSize(
         .meta_data.total_uncompressed_size;
   }
   int64_t sum = 0;
-  for (auto child : type.getChildren()) {
-    sum += rowGroupUncompressedSize(rowGroupIndex, *child);
+  const bool isStruct = scanSpec && type.type()->kind() == TypeKind::ROW;
+  for (auto i = 0; i < type.size(); ++i) {
+    const common::ScanSpec* childSpec = nullptr;
+    if (isStruct) {
+      // Pruned subfields have no column readers and their chunks are not read.
+      childSpec = scanSpec->childByName(type.type()->asRow().nameOf(i));
+      if (!childSpec || childSpec->isConstant()) {
+        continue;
+      }
+    }
+    sum += rowGroupUncompressedSize(rowGroupIndex, *type.childAt(i), childSpec);
   }
   return sum;
 }
@@ -725,10 +764,6 @@ bool ReaderBase::isRowGroupBuffered(int32_t rowGroupIndex) const {
   return inputs_.count(rowGroupIndex) != 0;
 }
 
-namespace {
-struct ParquetStatsContext : dwio::common::StatsContext {};
-} // namespace
-
 class ParquetRowReader::Impl {
  public:
   Impl(
@@ -785,7 +820,8 @@ class ParquetRowReader::Impl {
     firstRowOfRowGroup_.reserve(rowGroups_.size());
 
     ParquetData::FilterRowGroupsResult res;
-    columnReader_->filterRowGroups(0, ParquetStatsContext(), res);
+    columnReader_->filterRowGroups(
+        0, ParquetStatsContext(&readerBase_->bufferedInput()), res);
     if (auto& metadataFilter = options_.getMetadataFilter()) {
       metadataFilter->eval(res.metadataFilterResults, res.filterResult);
     }
@@ -817,10 +853,45 @@ class ParquetRowReader::Impl {
     }
   }
 
+  // Removes the row groups that are not started and no longer pass the
+  // filters. The filters may have been tightened by dynamic filters after
+  // filterRowGroups().
+  void filterRemainingRowGroups() {
+    if (nextRowGroupIdsIdx_ == rowGroupIds_.size()) {
+      return;
+    }
+    ParquetData::FilterRowGroupsResult res;
+    columnReader_->filterRowGroups(
+        0, ParquetStatsContext(&readerBase_->bufferedInput()), res);
+    if (auto& metadataFilter = options_.getMetadataFilter()) {
+      metadataFilter->eval(res.metadataFilterResults, res.filterResult);
+    }
+    auto numKept = nextRowGroupIdsIdx_;
+    for (auto i = nextRowGroupIdsIdx_; i < rowGroupIds_.size(); ++i) {
+      const auto rowGroup = rowGroupIds_[i];
+      if (rowGroup < res.totalCount &&
+          bits::isBitSet(res.filterResult.data(), rowGroup)) {
+        readerBase_->unloadRowGroup(rowGroup);
+        continue;
+      }
+      rowGroupIds_[numKept] = rowGroup;
+      firstRowOfRowGroup_[numKept] = firstRowOfRowGroup_[i];
+      ++numKept;
+    }
+    rowGroupIds_.resize(numKept);
+    firstRowOfRowGroup_.resize(numKept);
+  }
+
   int64_t nextRowNumber() {
-    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-        !advanceToNextRowGroup()) {
-      return kAtEnd;
+    for (;;) {
+      if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+          !advanceToNextRowGroup()) {
+        return kAtEnd;
+      }
+      skipRowsOfPages();
+      if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+        break;
+      }
     }
     return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
   }
@@ -830,7 +901,13 @@ class ParquetRowReader::Impl {
     if (nextRowNumber() == kAtEnd) {
       return kAtEnd;
     }
-    return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+    uint64_t endOfRead = rowsInCurrentRowGroup_;
+    if (nextSkippedRange_ < skippedRows_.size()) {
+      // Stop before the next rows to skip so that they are not decoded.
+      endOfRead = std::min<uint64_t>(
+          endOfRead, skippedRows_[nextSkippedRange_].begin);
+    }
+    return std::min(size, endOfRead - currentRowInGroup_);
   }
 
   uint64_t next(
@@ -861,17 +938,22 @@ class ParquetRowReader::Impl {
   std::optional<size_t> estimatedRowSize() const {
     auto index =
         nextRowGroupIdsIdx_ < 1 ? 0 : rowGroupIds_[nextRowGroupIdsIdx_ - 1];
+    // Only the columns and subfields that are read count.
     return readerBase_->rowGroupUncompressedSize(
-               index, *readerBase_->schemaWithId()) /
+               index,
+               *readerBase_->schemaWithId(),
+               options_.getScanSpec().get()) /
         rowGroups_[index].num_rows;
   }
 
   void updateRuntimeStats(dwio::common::RuntimeStatistics& stats) const {
     stats.skippedStrides += rowGroups_.size() - rowGroupIds_.size();
+    stats.skippedPageRows += numSkippedPageRows_;
   }
 
   void resetFilterCaches() {
     columnReader_->resetFilterCaches();
+    filterRemainingRowGroups();
   }
 
   bool isRowGroupBuffered(int32_t rowGroupIndex) const {
@@ -894,9 +976,71 @@ class ParquetRowReader::Impl {
     currentRowInGroup_ = 0;
     nextRowGroupIdsIdx_++;
     columnReader_->seekToRowGroup(nextRowGroupIndex);
+    findSkippedRows(nextRowGroupIndex);
     return true;
   }
 
+  // Fills 'skippedRows_' with the rows of row group 'rowGroupIndex' that are
+  // in a page where no value passes the filter of a top level column. The
+  // pages are found from the ColumnIndex and OffsetIndex of the filtered
+  // columns, if the file has them.
+  void findSkippedRows(uint32_t rowGroupIndex) {
+    skippedRows_.clear();
+    nextSkippedRange_ = 0;
+    const auto& fileType = readerBase_->schemaWithId();
+    const auto& rowType = fileType->type()->asRow();
+    auto rowGroup = readerBase_->fileMetaData().rowGroup(rowGroupIndex);
+    auto* file = readerBase_->bufferedInput().getReadFile().get();
+    for (auto& childSpec : options_.getScanSpec()->children()) {
+      if (!childSpec->filter() || childSpec->isConstant()) {
+        continue;
+      }
+      auto index = rowType.getChildIdxIfExists(childSpec->fieldName());
+      if (!index.has_value()) {
+        continue;
+      }
+      const auto& child = fileType->childAt(index.value());
+      if (!child->type()->isPrimitiveType()) {
+        continue;
+      }
+      auto chunk = rowGroup.columnChunk(child->column());
+      if (!chunk.hasPageIndex()) {
+        continue;
+      }
+      PageIndex pageIndex(
+          file->pread(chunk.columnIndexOffset(), chunk.columnIndexLength()),
+          file->pread(chunk.offsetIndexOffset(), chunk.offsetIndexLength()),
+          child->type(),
+          rowGroup.numRows());
+      pageIndex.addSkippedRows(*childSpec->filter(), skippedRows_);
+    }
+    PageIndex::mergeRanges(skippedRows_);
+  }
+
+  // Skips the ranges of 'skippedRows_' that start at or before the current
+  // row. The column readers skip whole pages by their headers without
+  // decompressing them.
+  void skipRowsOfPages() {
+    while (nextSkippedRange_ < skippedRows_.size()) {
+      const auto& range = skippedRows_[nextSkippedRange_];
+      if (range.begin > currentRowInGroup_) {
+        return;
+      }
+      ++nextSkippedRange_;
+      const uint64_t end =
+          std::min<uint64_t>(range.end, rowsInCurrentRowGroup_);
+      if (end <= currentRowInGroup_) {
+        continue;
+      }
+      const auto numRows = end - currentRowInGroup_;
+      numSkippedPageRows_ += numRows;
+      currentRowInGroup_ = end;
+      if (end < rowsInCurrentRowGroup_) {
+        columnReader_->seekTo(columnReader_->readOffset() + numRows, false);
+      }
+    }
+  }
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -911,6 +1055,13 @@ class ParquetRowReader::Impl {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Row ranges of the current row group where no row passes the filters,
+  // ordered and non-overlapping.
+  std::vector<RowRange> skippedRows_;
+  // Index of the first range in 'skippedRows_' at or after the current row.
+  size_t nextSkippedRange_{0};
+  uint64_t numSkippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   std::shared_ptr<const dwio::common::TypeWithId> requestedType_;
@@ -82,6 +82,65 @@ void RleBpDecoder::readBits(
   }
 }
 
+void RleBpDecoder::readLevels(int32_t numValues, int16_t* levels) {
+  VELOX_DCHECK_LE(bitWidth_, 16);
+  VELOX_DCHECK_EQ(bitOffset_, 0);
+  auto* output = reinterpret_cast<uint16_t*>(levels);
+  while (numValues > 0) {
+    if (numRemainingUnpackedValues_ > 0) {
+      const auto count =
+          std::min<int32_t>(numValues, numRemainingUnpackedValues_);
+      copyRemainingUnpackedValues(output, count);
+      numValues -= count;
+      continue;
+    }
+    if (remainingValues_ == 0) {
+      readHeader();
+    }
+    const auto count = std::min<int32_t>(numValues, remainingValues_);
+    if (repeating_) {
+      std::fill(output, output + count, value_);
+      output += count;
+      remainingValues_ -= count;
+    } else {
+      // Bit packed runs are a multiple of 8 values. A partial group is
+      // unpacked into 'remainingUnpackedValues_' for the next call.
+      const auto numFullGroups = count & ~7;
+      unpackLevels(numFullGroups, output);
+      output += numFullGroups;
+      remainingValues_ -= numFullGroups;
+      if (count & 7) {
+        unpackLevels(8, reinterpret_cast<uint16_t*>(remainingUnpackedValues_));
+        remainingValues_ -= 8;
+        numRemainingUnpackedValues_ = 8;
+        remainingUnpackedValuesOffset_ = 0;
+        copyRemainingUnpackedValues(output, count & 7);
+      }
+    }
+    numValues -= count;
+  }
+}
+
+void RleBpDecoder::unpackLevels(int32_t numValues, uint16_t* output) {
+  if (numValues == 0) {
+    return;
+  }
+  const auto numBytes = numValues / 8 * bitWidth_;
+  VELOX_CHECK_LE(bufferStart_ + numBytes, bufferEnd_);
+  auto* input = reinterpret_cast<const uint8_t*>(bufferStart_);
+  // The SIMD kernels may load a word past the last byte they decode. The
+  // kernels do not reliably advance 'input' and 'output', so 'bufferStart_'
+  // is advanced here.
+  if (bufferStart_ + numBytes + sizeof(uint64_t) <= bufferEnd_) {
+    dwio::common::unpack<uint16_t>(
+        input, numBytes, numValues, bitWidth_, output);
+  } else {
+    dwio::common::unpackNaive<uint16_t>(
+        input, numBytes, numValues, bitWidth_, output);
+  }
+  bufferStart_ += numBytes;
+}
+
 void RleBpDecoder::readHeader() {
   bitOffset_ = 0;
   auto maxVarIntLen = std::min<uint64_t>(
@@ -98,9 +98,18 @@ class RleBpDecoder {
   void
   readBits(int32_t numValues, uint64_t* outputBuffer, bool* allOnes = nullptr);
 
+  /// Decodes 'numValues' repetition or definition levels into 'levels'. Bit
+  /// packed runs are unpacked with the SIMD kernels of BitPackDecoder.h. The
+  /// decoder must not have been advanced with skip() or readBits().
+  void readLevels(int32_t numValues, int16_t* levels);
+
  protected:
   void readHeader();
 
+  // Unpacks 'numValues' values, a multiple of 8, from the bit packed run at
+  // 'bufferStart_' into 'output' and advances 'bufferStart_'.
+  void unpackLevels(int32_t numValues, uint16_t* output);
+
   template <typename T>
   inline void copyRemainingUnpackedValues(
       T* FOLLY_NONNULL& outputBuffer,
@@ -111,7 +120,7 @@ class RleBpDecoder {
         outputBuffer,
         reinterpret_cast<T*>(remainingUnpackedValues_) +
             remainingUnpackedValuesOffset_,
-        numValues);
+        numValues * sizeof(T));
 
     outputBuffer += numValues;
     numRemainingUnpackedValues_ -= numValues;
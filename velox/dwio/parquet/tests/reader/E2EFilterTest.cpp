@@ -277,6 +277,28 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::BYTE_STREAM_SPLIT;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -449,6 +471,44 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringUnique("string_val_2");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, stringDeltaByteArray) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string,"
+      "string_null:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_val_2", 170, false, true);
+        makeAllNulls("string_null");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -514,6 +574,28 @@ TEST_F(E2EFilterTest, list) {
       10);
 }
 
+TEST_F(E2EFilterTest, listDataPageV2) {
+  // V2 pages let the nested readers preload the repdefs without
+  // decompressing the values.
+  options_.dataPageSize = 4 * 1024;
+  options_.dataPageVersion =
+      facebook::velox::parquet::arrow::ParquetDataPageVersion::V2;
+  if (facebook::velox::parquet::Writer::isCodecAvailable(
+          common::CompressionKind_SNAPPY)) {
+    options_.compression = common::CompressionKind_SNAPPY;
+  }
+
+  batchCount_ = 2;
+  batchSize_ = 12000;
+  testWithTypes(
+      "long_val:bigint, array_val:array<int>,"
+      "struct_val: struct<a: bigint, b: array<struct<k:int, v:string>>>",
+      nullptr,
+      false,
+      {"long_val", "array_val", "struct_val.a"},
+      10);
+}
+
 TEST_F(E2EFilterTest, metadataFilter) {
   // Follow the batch size in `E2EFiltersTestBase`,
   // so that each batch can produce a row group.
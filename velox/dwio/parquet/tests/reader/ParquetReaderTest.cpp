@@ -14,7 +14,13 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/dwio/parquet/reader/FileMetaDataCache.h"
 #include "velox/dwio/parquet/tests/ParquetTestBase.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
@@ -1181,3 +1187,347 @@ TEST_F(ParquetReaderTest, testV2PageWithZeroMaxDefRep) {
   assertReadWithReaderAndExpected(
       outputRowType, *rowReader, expected, *leafPool_);
 }
+
+TEST_F(ParquetReaderTest, pageIndexFilter) {
+  // A sorted column in pages of about 1000 rows with a ColumnIndex and an
+  // OffsetIndex. A selective filter skips the pages with no match.
+  constexpr int32_t kRows = 100'000;
+  auto rowType = ROW({"a", "b"}, {BIGINT(), BIGINT()});
+  auto data = makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(kRows, [](auto row) { return row * 2; })});
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.enableDictionary = false;
+  writerOptions.dataPageSize = 8 * 1024;
+  writerOptions.enablePageIndex = true;
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, rowType);
+  writer->write(data);
+  writer->close();
+
+  ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = std::make_unique<ParquetReader>(
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(
+              std::string_view(sinkPtr->data(), sinkPtr->size())),
+          readerOptions.memoryPool()),
+      readerOptions);
+  ASSERT_TRUE(
+      reader->fileMetaData().rowGroup(0).columnChunk(0).hasPageIndex());
+
+  auto scanSpec = makeScanSpec(rowType);
+  scanSpec->childByName("a")->setFilter(
+      std::make_unique<BigintRange>(50'000, 50'999, false));
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  auto expected = makeRowVector(
+      rowType->names(),
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return 50'000 + row; }),
+       makeFlatVector<int64_t>(
+           1'000, [](auto row) { return (50'000 + row) * 2; })});
+  VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+  vector_size_t numMatches = 0;
+  while (rowReader->next(1'000, result) > 0) {
+    assertEqualVectorPart(expected, result, numMatches);
+    numMatches += result->size();
+  }
+  ASSERT_EQ(numMatches, expected->size());
+
+  RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_GT(stats.skippedPageRows, kRows * 9 / 10);
+}
+
+TEST_F(ParquetReaderTest, dictionaryFilterRowGroups) {
+  // Dictionary encoded strings in 4 row groups. The even row groups have the
+  // even keys and the odd row groups the odd keys, so that the min/max stats
+  // of all row groups cover every key. An odd key is only found by reading the
+  // dictionaries of the odd row groups.
+  constexpr int32_t kRowsPerGroup = 1'000;
+  constexpr int32_t kGroups = 4;
+  auto rowType = ROW({"s", "a"}, {VARCHAR(), BIGINT()});
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(kRowsPerGroup, 1LL << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, rowType);
+  for (auto group = 0; group < kGroups; ++group) {
+    writer->write(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<std::string>(
+             kRowsPerGroup,
+             [&](auto row) {
+               return fmt::format("key_{:02}", 2 * (row % 10) + group % 2);
+             }),
+         makeFlatVector<int64_t>(kRowsPerGroup, [&](auto row) {
+           return group * kRowsPerGroup + row;
+         })}));
+  }
+  writer->close();
+
+  ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = std::make_unique<ParquetReader>(
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(
+              std::string_view(sinkPtr->data(), sinkPtr->size())),
+          readerOptions.memoryPool()),
+      readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), kGroups);
+  ASSERT_TRUE(reader->fileMetaData()
+                  .rowGroup(0)
+                  .columnChunk(0)
+                  .isOnlyDictionaryEncoded());
+
+  auto scanSpec = makeScanSpec(rowType);
+  scanSpec->childByName("s")->setFilter(
+      std::make_unique<BytesValues>(std::vector<std::string>{"key_07"}, false));
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+  vector_size_t numMatches = 0;
+  while (rowReader->next(1'000, result) > 0) {
+    // Dictionary encoded strings may be returned as a DictionaryVector.
+    auto* values =
+        result->as<RowVector>()->childAt(0)->as<SimpleVector<StringView>>();
+    for (auto i = 0; i < result->size(); ++i) {
+      ASSERT_EQ(values->valueAt(i), StringView("key_07"));
+    }
+    numMatches += result->size();
+  }
+  ASSERT_EQ(numMatches, kGroups / 2 * kRowsPerGroup / 10);
+
+  RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_EQ(stats.skippedStrides, kGroups / 2);
+}
+
+TEST_F(ParquetReaderTest, filterAddedAfterStartPrunesRowGroups) {
+  // A filter added while reading, like a dynamic filter from a join, prunes
+  // the row groups that are not started on their statistics.
+  constexpr int32_t kRowsPerGroup = 1'000;
+  constexpr int32_t kGroups = 4;
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  writerOptions.flushPolicyFactory = []() {
+    return std::make_unique<DefaultFlushPolicy>(kRowsPerGroup, 1LL << 30);
+  };
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, rowType);
+  for (auto group = 0; group < kGroups; ++group) {
+    writer->write(makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int64_t>(kRowsPerGroup, [&](auto row) {
+          return group * kRowsPerGroup + row;
+        })}));
+  }
+  writer->close();
+
+  ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = std::make_unique<ParquetReader>(
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(
+              std::string_view(sinkPtr->data(), sinkPtr->size())),
+          readerOptions.memoryPool()),
+      readerOptions);
+  ASSERT_EQ(reader->fileMetaData().numRowGroups(), kGroups);
+
+  auto scanSpec = makeScanSpec(rowType);
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+
+  VectorPtr result = BaseVector::create(rowType, 0, leafPool_.get());
+  ASSERT_EQ(rowReader->next(kRowsPerGroup, result), kRowsPerGroup);
+
+  scanSpec->childByName("a")->addFilter(
+      BigintRange(0, 2 * kRowsPerGroup - 1, false));
+  scanSpec->resetCachedValues(true);
+  rowReader->resetFilterCaches();
+
+  vector_size_t numRows = result->size();
+  while (rowReader->next(kRowsPerGroup, result) > 0) {
+    numRows += result->size();
+  }
+  ASSERT_EQ(numRows, 2 * kRowsPerGroup);
+
+  RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  ASSERT_EQ(stats.skippedStrides, 2);
+}
+
+TEST_F(ParquetReaderTest, fileMetaDataCache) {
+  // Readers of the same file and version share the parsed footer. A reader
+  // without a version does not use the cache.
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  auto* cache = FileMetaDataCache::create(1 << 20);
+  SCOPE_EXIT {
+    FileMetaDataCache::testingClear();
+  };
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return row + 1; }),
+      makeFlatVector<double>(20, [](auto row) { return row + 1; }),
+  });
+  auto read = [&](const std::string& version) {
+    ReaderOptions readerOptions{leafPool_.get()};
+    readerOptions.setFileVersion(version);
+    auto reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader->numberOfRows(), 20ULL);
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    assertReadWithReaderAndExpected(
+        sampleSchema(), *rowReader, expected, *leafPool_);
+  };
+
+  read("");
+  ASSERT_EQ(cache->stats().numElements, 0);
+  read("1");
+  ASSERT_EQ(cache->stats().numElements, 1);
+  ASSERT_EQ(cache->stats().numHits, 0);
+  read("1");
+  ASSERT_EQ(cache->stats().numElements, 1);
+  ASSERT_EQ(cache->stats().numHits, 1);
+  read("2");
+  ASSERT_EQ(cache->stats().numElements, 2);
+  ASSERT_EQ(cache->stats().numHits, 1);
+}
+
+TEST_F(ParquetReaderTest, prunedStructSubfields) {
+  // A wide struct of which one field is read. The pruned fields are constant
+  // null in the ScanSpec and are neither read nor counted in the estimated
+  // row size.
+  constexpr int32_t kRows = 1'000;
+  constexpr int32_t kFields = 20;
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::vector<VectorPtr> fields;
+  std::vector<VectorPtr> expectedFields;
+  for (auto i = 0; i < kFields; ++i) {
+    names.push_back(fmt::format("f{}", i));
+    types.push_back(BIGINT());
+    fields.push_back(makeFlatVector<int64_t>(
+        kRows, [&](auto row) { return row * kFields + i; }));
+    expectedFields.push_back(
+        i == 0 ? fields.back() : makeAllNullFlatVector<int64_t>(kRows));
+  }
+  auto structType = ROW(std::move(names), std::move(types));
+  auto rowType = ROW({"id", "s"}, {BIGINT(), structType});
+  auto ids = makeFlatVector<int64_t>(kRows, [](auto row) { return row; });
+  auto data = makeRowVector(
+      rowType->names(),
+      {ids, makeRowVector(structType->names(), fields)});
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto* sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, rootPool_, rowType);
+  writer->write(data);
+  writer->close();
+
+  // Row readers of the same reader share the loaded row groups, so each read
+  // uses its own reader.
+  ReaderOptions readerOptions{leafPool_.get()};
+  auto makeReader = [&]() {
+    return std::make_unique<ParquetReader>(
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(
+                std::string_view(sinkPtr->data(), sinkPtr->size())),
+            readerOptions.memoryPool()),
+        readerOptions);
+  };
+
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+  const auto fullRowSize =
+      makeReader()->createRowReader(rowReaderOpts)->estimatedRowSize();
+
+  auto scanSpec = makeScanSpec(rowType);
+  auto* structSpec = scanSpec->childByName("s");
+  for (auto i = 1; i < kFields; ++i) {
+    structSpec->childByName(structType->nameOf(i))
+        ->setConstantValue(
+            BaseVector::createNullConstant(BIGINT(), 1, leafPool_.get()));
+  }
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto reader = makeReader();
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  ASSERT_TRUE(fullRowSize.has_value());
+  ASSERT_TRUE(rowReader->estimatedRowSize().has_value());
+  ASSERT_LT(rowReader->estimatedRowSize().value() * 5, fullRowSize.value());
+
+  auto expected = makeRowVector(
+      rowType->names(),
+      {ids, makeRowVector(structType->names(), expectedFields)});
+  assertReadWithReaderAndExpected(rowType, *rowReader, expected, *leafPool_);
+}
+
+TEST_F(ParquetReaderTest, splitBlockBloomFilter) {
+  // A filter of 4 blocks serialized after its header as in a Parquet file.
+  SplitBlockBloomFilter filter(
+      std::string(4 * SplitBlockBloomFilter::kBytesPerBlock, '\0'));
+  for (int64_t i = 0; i < 20; ++i) {
+    filter.insert(SplitBlockBloomFilter::hash(i * 7));
+  }
+  filter.insert(SplitBlockBloomFilter::hash(std::string_view("user_42")));
+
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(filter.bitset().size());
+  thrift::BloomFilterAlgorithm algorithm;
+  algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+  header.__set_algorithm(algorithm);
+  thrift::BloomFilterHash hash;
+  hash.__set_XXHASH(thrift::XxHash());
+  header.__set_hash(hash);
+  thrift::BloomFilterCompression compression;
+  compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+  header.__set_compression(compression);
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocol protocol(buffer);
+  header.write(&protocol);
+  // The filter starts after some leading bytes like in a file.
+  auto data = std::string(100, 'x') + buffer->getBufferAsString() +
+      filter.bitset() + std::string(100, 'x');
+
+  BufferedInput input(
+      std::make_shared<InMemoryReadFile>(data), *leafPool_);
+  auto readFilter = SplitBlockBloomFilter::read(input, 100);
+  ASSERT_NE(readFilter, nullptr);
+  ASSERT_EQ(readFilter->bitset(), filter.bitset());
+  for (int64_t i = 0; i < 20; ++i) {
+    ASSERT_TRUE(readFilter->mayContain(SplitBlockBloomFilter::hash(i * 7)));
+  }
+  ASSERT_TRUE(readFilter->mayContain(
+      SplitBlockBloomFilter::hash(std::string_view("user_42"))));
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 1'000; i < 2'000; ++i) {
+    numFalsePositives +=
+        readFilter->mayContain(SplitBlockBloomFilter::hash(i * 7 + 1));
+  }
+  ASSERT_LT(numFalsePositives, 100);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
+
+#include <arrow/util/rle_encoding.h> // @manual
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <random>
+
+using namespace facebook::velox;
+
+// Compares decoding repetition and definition levels with the arrow
+// RleDecoder and with RleBpDecoder::readLevels().
+
+namespace {
+
+constexpr int32_t kNumValues = 1'000'000;
+constexpr int32_t kBatchSize = 1'000;
+
+// Encodes kNumValues random levels of 'bitWidth' bits. One in
+// 'repeatEvery' values starts a run of repeats.
+std::vector<uint8_t> encodeLevels(uint8_t bitWidth, int32_t repeatEvery) {
+  std::mt19937 rng(1);
+  const auto maxLevel = (1 << bitWidth) - 1;
+  std::vector<uint8_t> encoded(
+      arrow::util::RleEncoder::MaxBufferSize(bitWidth, kNumValues));
+  arrow::util::RleEncoder encoder(encoded.data(), encoded.size(), bitWidth);
+  int32_t numValues = 0;
+  while (numValues < kNumValues) {
+    const int16_t level = rng() % (maxLevel + 1);
+    const int32_t count = rng() % repeatEvery == 0
+        ? std::min<int32_t>(20, kNumValues - numValues)
+        : 1;
+    for (auto i = 0; i < count; ++i) {
+      encoder.Put(level);
+    }
+    numValues += count;
+  }
+  encoded.resize(encoder.Flush());
+  return encoded;
+}
+
+void arrowDecode(uint32_t iterations, uint8_t bitWidth, int32_t repeatEvery) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodeLevels(bitWidth, repeatEvery);
+  std::vector<int16_t> levels(kBatchSize);
+  suspender.dismiss();
+  for (auto i = 0; i < iterations; ++i) {
+    arrow::util::RleDecoder decoder(encoded.data(), encoded.size(), bitWidth);
+    for (auto row = 0; row < kNumValues; row += kBatchSize) {
+      decoder.GetBatch(levels.data(), kBatchSize);
+    }
+    folly::doNotOptimizeAway(levels);
+  }
+}
+
+void veloxDecode(uint32_t iterations, uint8_t bitWidth, int32_t repeatEvery) {
+  folly::BenchmarkSuspender suspender;
+  auto encoded = encodeLevels(bitWidth, repeatEvery);
+  const auto* data = reinterpret_cast<const char*>(encoded.data());
+  std::vector<int16_t> levels(kBatchSize);
+  suspender.dismiss();
+  for (auto i = 0; i < iterations; ++i) {
+    parquet::RleBpDecoder decoder(data, data + encoded.size(), bitWidth);
+    for (auto row = 0; row < kNumValues; row += kBatchSize) {
+      decoder.readLevels(kBatchSize, levels.data());
+    }
+    folly::doNotOptimizeAway(levels);
+  }
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(arrowDecode, width1_packed, 1, 1'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(veloxDecode, width1_packed, 1, 1'000'000);
+BENCHMARK_NAMED_PARAM(arrowDecode, width2_packed, 2, 1'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(veloxDecode, width2_packed, 2, 1'000'000);
+BENCHMARK_NAMED_PARAM(arrowDecode, width3_packed, 3, 1'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(veloxDecode, width3_packed, 3, 1'000'000);
+BENCHMARK_NAMED_PARAM(arrowDecode, width4_packed, 4, 1'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(veloxDecode, width4_packed, 4, 1'000'000);
+BENCHMARK_NAMED_PARAM(arrowDecode, width2_mixed, 2, 4);
+BENCHMARK_RELATIVE_NAMED_PARAM(veloxDecode, width2_mixed, 2, 4);
+BENCHMARK_NAMED_PARAM(arrowDecode, width3_mixed, 3, 4);
+BENCHMARK_RELATIVE_NAMED_PARAM(veloxDecode, width3_mixed, 3, 4);
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+  folly::runBenchmarks();
+  return 0;
+}
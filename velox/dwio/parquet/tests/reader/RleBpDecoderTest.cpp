@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/common/BitPackDecoder.h"
+#include "velox/dwio/parquet/reader/RleBpDecoder.h"
 
 #include <arrow/util/rle_encoding.h> // @manual
 #include <gtest/gtest.h>
@@ -140,3 +141,43 @@ TEST(RleBpDecoderTest, DISABLED_allOnes) {
   RleBpDecoderTest<uint8_t> test;
   test.testDecodeSuppliedData(allOnesVector, 1);
 }
+
+TEST(RleBpDecoderTest, readLevels) {
+  // Levels with runs of repeats between random values so that the encoding
+  // has both RLE and bit packed runs. The levels are read in uneven batches
+  // to cover reads that end inside a group of 8 bit packed values.
+  constexpr int32_t kNumValues = 10'000;
+  std::mt19937 rng(1);
+  for (uint8_t bitWidth = 1; bitWidth <= 16; ++bitWidth) {
+    const int16_t maxLevel = (1 << std::min<int32_t>(bitWidth, 15)) - 1;
+    std::vector<int16_t> levels;
+    while (levels.size() < kNumValues) {
+      if (rng() % 3 == 0) {
+        levels.insert(levels.end(), 1 + rng() % 50, rng() % (maxLevel + 1));
+      } else {
+        levels.push_back(rng() % (maxLevel + 1));
+      }
+    }
+    levels.resize(kNumValues);
+
+    std::vector<uint8_t> encoded(
+        arrow::util::RleEncoder::MaxBufferSize(bitWidth, kNumValues));
+    arrow::util::RleEncoder encoder(encoded.data(), encoded.size(), bitWidth);
+    for (auto level : levels) {
+      ASSERT_TRUE(encoder.Put(level));
+    }
+    encoded.resize(encoder.Flush());
+
+    const auto* data = reinterpret_cast<const char*>(encoded.data());
+    parquet::RleBpDecoder decoder(data, data + encoded.size(), bitWidth);
+    std::vector<int16_t> decoded(kNumValues);
+    int32_t numDecoded = 0;
+    while (numDecoded < kNumValues) {
+      const auto batch =
+          std::min<int32_t>(1 + rng() % 100, kNumValues - numDecoded);
+      decoder.readLevels(batch, decoded.data() + numDecoded);
+      numDecoded += batch;
+    }
+    ASSERT_EQ(levels, decoded) << "bitWidth " << static_cast<int>(bitWidth);
+  }
+}
@@ -135,6 +135,50 @@ TEST_F(ParquetWriterTest, compression) {
   assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
 };
 
+TEST_F(ParquetWriterTest, arrowMemoryInWriterPool) {
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  const int64_t kRows = 100'000;
+  const auto data = makeRowVector({
+      makeFlatVector<int64_t>(kRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kRows, [](auto row) { return fmt::format("value {}", row % 1000); }),
+  });
+
+  auto sink = std::make_unique<MemorySink>(
+      200 * 1024 * 1024,
+      dwio::common::FileSink::Options{.pool = leafPool_.get()});
+  auto sinkPtr = sink.get();
+  facebook::velox::parquet::WriterOptions writerOptions;
+  writerOptions.memoryPool = leafPool_.get();
+  // Streams the encoded output to the sink in small pieces.
+  writerOptions.outputFlushSize = 1'024;
+  auto writerPool = rootPool_->addAggregateChild("arrowMemoryInWriterPool");
+  auto writer = std::make_unique<facebook::velox::parquet::Writer>(
+      std::move(sink), writerOptions, writerPool, schema);
+  writer->write(data);
+  writer->flush();
+
+  // The allocations of the Arrow writer are made from a child of the writer
+  // pool.
+  int64_t arrowPeakBytes = 0;
+  writerPool->visitChildren([&](memory::MemoryPool* child) {
+    if (child->name() == ".arrow") {
+      arrowPeakBytes = child->peakBytes();
+    }
+    return true;
+  });
+  ASSERT_GT(arrowPeakBytes, 0);
+  writer->close();
+  writer.reset();
+  ASSERT_EQ(writerPool->usedBytes(), 0);
+
+  dwio::common::ReaderOptions readerOptions{leafPool_.get()};
+  auto reader = createReaderInMemory(*sinkPtr, readerOptions);
+  ASSERT_EQ(reader->numberOfRows(), kRows);
+  auto rowReader = createRowReaderWithSchema(std::move(reader), schema);
+  assertReadWithReaderAndExpected(schema, *rowReader, data, *leafPool_);
+}
+
 DEBUG_ONLY_TEST_F(ParquetWriterTest, unitFromWriterOptions) {
   SCOPED_TESTVALUE_SET(
       "facebook::velox::parquet::Writer::write",
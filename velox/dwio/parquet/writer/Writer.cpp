@@ -17,7 +17,12 @@
 #include "velox/dwio/parquet/writer/Writer.h"
 #include <arrow/c/bridge.h>
 #include <arrow/io/interfaces.h>
+#include <arrow/memory_pool.h>
 #include <arrow/table.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
@@ -35,11 +40,16 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
  public:
   /// @param growRatio Growth factor used when invoking the reserve() method of
   /// DataSink, thereby helping to minimize frequent memcpy operations.
+  /// @param flushSize Bytes buffered before they are written to 'sink'.
   ArrowDataBufferSink(
       std::unique_ptr<dwio::common::FileSink> sink,
       memory::MemoryPool& pool,
-      double growRatio)
-      : sink_(std::move(sink)), growRatio_(growRatio), buffer_(pool) {}
+      double growRatio,
+      int64_t flushSize)
+      : sink_(std::move(sink)),
+        growRatio_(growRatio),
+        flushSize_(flushSize),
+        buffer_(pool) {}
 
   ::arrow::Status Write(const std::shared_ptr<::arrow::Buffer>& data) override {
     auto requestCapacity = buffer_.size() + data->size();
@@ -50,7 +60,7 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
         buffer_.size(),
         reinterpret_cast<const char*>(data->data()),
         data->size());
-    return ::arrow::Status::OK();
+    return maybeFlush();
   }
 
   ::arrow::Status Write(const void* data, int64_t nbytes) override {
@@ -59,7 +69,7 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
       buffer_.reserve(growRatio_ * (requestCapacity));
     }
     buffer_.append(buffer_.size(), reinterpret_cast<const char*>(data), nbytes);
-    return ::arrow::Status::OK();
+    return maybeFlush();
   }
 
   ::arrow::Status Flush() override {
@@ -88,12 +98,112 @@ class ArrowDataBufferSink : public ::arrow::io::OutputStream {
   }
 
  private:
+  // Writes the buffered bytes to 'sink_' once there are 'flushSize_' of them,
+  // so that the output of a row group is not held in memory as a whole.
+  ::arrow::Status maybeFlush() {
+    if (buffer_.size() >= flushSize_) {
+      return Flush();
+    }
+    return ::arrow::Status::OK();
+  }
+
   std::unique_ptr<dwio::common::FileSink> sink_;
   const double growRatio_;
+  const int64_t flushSize_;
   dwio::common::DataBuffer<char> buffer_;
   int64_t bytesFlushed_ = 0;
 };
 
+// Serves the allocations of the Arrow Parquet writer from a Velox memory pool
+// so that they count against the memory of the writer.
+class ArrowMemoryPool : public ::arrow::MemoryPool {
+ public:
+  explicit ArrowMemoryPool(memory::MemoryPool& pool) : pool_(pool) {}
+
+  ::arrow::Status Allocate(int64_t size, int64_t alignment, uint8_t** out)
+      override {
+    if (alignment > pool_.alignment()) {
+      return ::arrow::Status::Invalid(
+          "Unsupported alignment ", alignment, " in ", pool_.name());
+    }
+    if (size == 0) {
+      *out = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    try {
+      *out = reinterpret_cast<uint8_t*>(pool_.allocate(size));
+    } catch (const VeloxException& e) {
+      return ::arrow::Status::OutOfMemory(e.what());
+    }
+    bytesAllocated_ += size;
+    totalBytesAllocated_ += size;
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  ::arrow::Status Reallocate(
+      int64_t oldSize,
+      int64_t newSize,
+      int64_t alignment,
+      uint8_t** ptr) override {
+    if (*ptr == zeroSizeArea()) {
+      return Allocate(newSize, alignment, ptr);
+    }
+    if (newSize == 0) {
+      Free(*ptr, oldSize, alignment);
+      *ptr = zeroSizeArea();
+      return ::arrow::Status::OK();
+    }
+    try {
+      *ptr = reinterpret_cast<uint8_t*>(
+          pool_.reallocate(*ptr, oldSize, newSize));
+    } catch (const VeloxException& e) {
+      return ::arrow::Status::OutOfMemory(e.what());
+    }
+    bytesAllocated_ += newSize - oldSize;
+    if (newSize > oldSize) {
+      totalBytesAllocated_ += newSize - oldSize;
+    }
+    ++numAllocations_;
+    return ::arrow::Status::OK();
+  }
+
+  void Free(uint8_t* buffer, int64_t size, int64_t /*alignment*/) override {
+    if (buffer == zeroSizeArea()) {
+      return;
+    }
+    pool_.free(buffer, size);
+    bytesAllocated_ -= size;
+  }
+
+  int64_t bytes_allocated() const override {
+    return bytesAllocated_;
+  }
+
+  int64_t total_bytes_allocated() const override {
+    return totalBytesAllocated_;
+  }
+
+  int64_t num_allocations() const override {
+    return numAllocations_;
+  }
+
+  std::string backend_name() const override {
+    return "velox";
+  }
+
+ private:
+  static uint8_t* zeroSizeArea() {
+    alignas(memory::MemoryAllocator::kMaxAlignment) static uint8_t area[1];
+    return area;
+  }
+
+  memory::MemoryPool& pool_;
+  std::atomic<int64_t> bytesAllocated_{0};
+  std::atomic<int64_t> totalBytesAllocated_{0};
+  std::atomic<int64_t> numAllocations_{0};
+};
+
 struct ArrowContext {
   std::unique_ptr<FileWriter> writer;
   std::shared_ptr<::arrow::Schema> schema;
@@ -140,6 +250,10 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  properties = properties->data_page_version(options.dataPageVersion);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
@@ -222,12 +336,20 @@ Writer::Writer(
     RowTypePtr schema)
     : pool_(std::move(pool)),
       generalPool_{pool_->addLeafChild(".general")},
+      arrowPool_{pool_->addLeafChild(".arrow")},
+      arrowMemoryPool_{std::make_shared<ArrowMemoryPool>(*arrowPool_)},
       stream_(std::make_shared<ArrowDataBufferSink>(
           std::move(sink),
           *generalPool_,
-          options.bufferGrowRatio)),
+          options.bufferGrowRatio,
+          options.outputFlushSize)),
       arrowContext_(std::make_shared<ArrowContext>()),
-      schema_(std::move(schema)) {
+      schema_(std::move(schema)),
+      spillConfig_{options.spillConfig},
+      nonReclaimableSection_{options.nonReclaimableSection} {
+  VELOX_CHECK(
+      spillConfig_ == nullptr || nonReclaimableSection_ != nullptr,
+      "nonReclaimableSection_ must be set if writer memory reclaim is enabled");
   validateSchemaRecursive(schema_);
 
   if (options.flushPolicyFactory) {
@@ -262,7 +384,7 @@ void Writer::flush() {
           arrowContext_->writer,
           FileWriter::Open(
               *arrowContext_->schema.get(),
-              ::arrow::default_memory_pool(),
+              arrowMemoryPool_.get(),
               stream_,
               arrowContext_->properties,
               arrowProperties));
@@ -290,6 +412,7 @@ void Writer::flush() {
     }
     arrowContext_->stagingRows = 0;
     arrowContext_->stagingBytes = 0;
+    releaseMemory();
   }
 }
 
@@ -313,6 +436,9 @@ void Writer::write(const VectorPtr& data) {
       data->type()->equivalent(*schema_),
       "The file schema type should be equal with the input rowvector type.");
 
+  auto bytes = data->estimateFlatSize();
+  ensureWriteFits(bytes);
+
   ArrowArray array;
   ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get(), options_);
@@ -342,7 +468,6 @@ void Writer::write(const VectorPtr& data) {
     }
   }
 
-  auto bytes = data->estimateFlatSize();
   auto numRows = data->size();
   if (flushPolicy_->shouldFlush(getStripeProgress(
           arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
@@ -394,6 +519,8 @@ parquet::WriterOptions getParquetOptions(
     parquetOptions.parquetWriteTimestampUnit =
         options.parquetWriteTimestampUnit.value();
   }
+  parquetOptions.spillConfig = options.spillConfig;
+  parquetOptions.nonReclaimableSection = options.nonReclaimableSection;
   return parquetOptions;
 }
 
@@ -409,9 +536,106 @@ void Writer::setMemoryReclaimers() {
     return;
   }
 
-  // TODO https://github.com/facebookincubator/velox/issues/8190
-  pool_->setReclaimer(exec::MemoryReclaimer::create());
+  pool_->setReclaimer(MemoryReclaimer::create(this));
   generalPool_->setReclaimer(exec::MemoryReclaimer::create());
+  arrowPool_->setReclaimer(exec::MemoryReclaimer::create());
+}
+
+bool Writer::canReclaim() const {
+  return spillConfig_ != nullptr;
+}
+
+void Writer::ensureWriteFits(int64_t appendBytes) {
+  if (!canReclaim() || arrowContext_->stagingRows == 0) {
+    return;
+  }
+  // Allows the memory arbitrator to flush the staged rows if the reservation
+  // below triggers memory arbitration.
+  memory::ReclaimableSectionGuard reclaimGuard(nonReclaimableSection_);
+  if (generalPool_->availableReservation() >= appendBytes) {
+    return;
+  }
+  const int64_t bytesToReserve = std::max<int64_t>(
+      appendBytes,
+      generalPool_->usedBytes() * spillConfig_->spillableReservationGrowthPct /
+          100);
+  generalPool_->maybeReserve(bytesToReserve);
+}
+
+void Writer::releaseMemory() {
+  if (!canReclaim()) {
+    return;
+  }
+  generalPool_->release();
+  arrowPool_->release();
+}
+
+std::unique_ptr<memory::MemoryReclaimer> Writer::MemoryReclaimer::create(
+    Writer* writer) {
+  return std::unique_ptr<memory::MemoryReclaimer>(
+      new Writer::MemoryReclaimer(writer));
+}
+
+bool Writer::MemoryReclaimer::reclaimableBytes(
+    const memory::MemoryPool& /*unused*/,
+    uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!writer_->canReclaim() || writer_->arrowContext_ == nullptr ||
+      writer_->arrowContext_->stagingRows == 0) {
+    return false;
+  }
+  const uint64_t memoryUsage = writer_->pool_->usedBytes();
+  if (memoryUsage < writer_->spillConfig_->writerFlushThresholdSize) {
+    return false;
+  }
+  reclaimableBytes = memoryUsage;
+  return true;
+}
+
+uint64_t Writer::MemoryReclaimer::reclaim(
+    memory::MemoryPool* pool,
+    uint64_t /*targetBytes*/,
+    uint64_t /*unused*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  if (!writer_->canReclaim()) {
+    return 0;
+  }
+
+  if (*writer_->nonReclaimableSection_) {
+    RECORD_METRIC_VALUE(kMetricMemoryNonReclaimableCount);
+    LOG(WARNING)
+        << "Can't reclaim from parquet writer which is under non-reclaimable section: "
+        << pool->name();
+    ++stats.numNonReclaimableAttempts;
+    return 0;
+  }
+  if (writer_->arrowContext_ == nullptr ||
+      writer_->arrowContext_->stagingRows == 0) {
+    ++stats.numNonReclaimableAttempts;
+    return 0;
+  }
+  const uint64_t memoryUsage = writer_->pool_->usedBytes();
+  if (memoryUsage < writer_->spillConfig_->writerFlushThresholdSize) {
+    RECORD_METRIC_VALUE(kMetricMemoryNonReclaimableCount);
+    LOG(WARNING)
+        << "Can't reclaim memory from parquet writer pool " << pool->name()
+        << " which doesn't have sufficient memory to flush, writer memory usage: "
+        << succinctBytes(memoryUsage) << ", writer flush memory threshold: "
+        << succinctBytes(writer_->spillConfig_->writerFlushThresholdSize);
+    ++stats.numNonReclaimableAttempts;
+    return 0;
+  }
+
+  return memory::MemoryReclaimer::run(
+      [&]() {
+        int64_t reclaimedBytes{0};
+        {
+          memory::ScopedReclaimedBytesRecorder recorder(pool, &reclaimedBytes);
+          writer_->flush();
+        }
+        return reclaimedBytes;
+      },
+      stats);
 }
 
 std::unique_ptr<dwio::common::Writer> ParquetWriterFactory::createWriter(
@@ -23,8 +23,10 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
+#include "velox/exec/MemoryReclaimer.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/arrow/Bridge.h"
 
@@ -34,6 +36,8 @@ using facebook::velox::parquet::arrow::util::CodecOptions;
 
 class ArrowDataBufferSink;
 
+class ArrowMemoryPool;
+
 struct ArrowContext;
 
 class DefaultFlushPolicy : public dwio::common::FlushPolicy {
@@ -90,10 +94,22 @@ struct WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
+  // Writes the ColumnIndex and OffsetIndex of each column chunk. Readers use
+  // these to skip pages whose values cannot pass a filter.
+  bool enablePageIndex = false;
+  // V2 data pages store the repetition and definition levels uncompressed
+  // ahead of the values, so readers can decode the levels of nested columns
+  // without decompressing the values.
+  arrow::ParquetDataPageVersion dataPageVersion =
+      arrow::ParquetDataPageVersion::V1;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
   // heuristic borrowed from
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
   double bufferGrowRatio = 1.5;
+  // Bytes of encoded output buffered before they are written to the sink. The
+  // output of a row group is streamed to the sink in pieces of this size
+  // instead of being held in memory as a whole.
+  int64_t outputFlushSize = 8 * 1'024 * 1'024;
   common::CompressionKind compression = common::CompressionKind_NONE;
   arrow::Encoding::type encoding = arrow::Encoding::PLAIN;
   velox::memory::MemoryPool* memoryPool;
@@ -105,6 +121,12 @@ struct WriterOptions {
       columnCompressionsMap;
   uint8_t parquetWriteTimestampUnit =
       static_cast<uint8_t>(TimestampUnit::kNano);
+  // Enables flushing the staged rows when the memory arbitrator reclaims
+  // memory from the writer if not nullptr.
+  const common::SpillConfig* spillConfig{nullptr};
+  // Must be set if 'spillConfig' is set. The writer is reclaimable only while
+  // this is false.
+  tsan_atomic<bool>* nonReclaimableSection{nullptr};
 };
 
 // Writes Velox vectors into  a DataSink using Arrow Parquet writer.
@@ -145,14 +167,53 @@ class Writer : public dwio::common::Writer {
 
   void abort() override;
 
+  /// True if memory can be reclaimed from this writer by flushing the staged
+  /// rows.
+  bool canReclaim() const;
+
  private:
+  class MemoryReclaimer : public exec::MemoryReclaimer {
+   public:
+    static std::unique_ptr<memory::MemoryReclaimer> create(Writer* writer);
+
+    bool reclaimableBytes(
+        const memory::MemoryPool& pool,
+        uint64_t& reclaimableBytes) const override;
+
+    uint64_t reclaim(
+        memory::MemoryPool* pool,
+        uint64_t targetBytes,
+        uint64_t maxWaitMs,
+        memory::MemoryReclaimer::Stats& stats) override;
+
+   private:
+    explicit MemoryReclaimer(Writer* writer) : writer_(writer) {
+      VELOX_CHECK_NOT_NULL(writer_);
+    }
+
+    Writer* const writer_;
+  };
+
   // Sets the memory reclaimers for all the memory pools used by this writer.
   void setMemoryReclaimers();
 
+  // Reserves memory for staging 'appendBytes' more bytes if the writer is
+  // reclaimable. The reservation may flush the staged rows by memory
+  // arbitration.
+  void ensureWriteFits(int64_t appendBytes);
+
+  // Releases the unused memory reservations after a flush.
+  void releaseMemory();
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
 
+  // Pool for the allocations of the Arrow Parquet writer, wrapped by
+  // 'arrowMemoryPool_'. Both outlive 'arrowContext_'.
+  std::shared_ptr<memory::MemoryPool> arrowPool_;
+  std::shared_ptr<ArrowMemoryPool> arrowMemoryPool_;
+
   // Temporary Arrow stream for capturing the output.
   std::shared_ptr<ArrowDataBufferSink> stream_;
 
@@ -162,6 +223,10 @@ class Writer : public dwio::common::Writer {
 
   const RowTypePtr schema_;
 
+  const common::SpillConfig* const spillConfig_;
+
+  tsan_atomic<bool>* const nonReclaimableSection_;
+
   ArrowOptions options_{.flattenDictionary = true, .flattenConstant = true};
 };
 
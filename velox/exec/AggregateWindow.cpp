@@ -101,6 +101,16 @@ class AggregateWindowFunction : public exec::WindowFunction {
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
 
     computeDefaultAggregateValue(resultType);
+
+    // The nodes of the segment tree are merged through their intermediate
+    // results. Limited to fixed width accumulators so that the nodes need no
+    // cleanup.
+    if (aggregate_->isFixedSize() &&
+        !aggregate_->accumulatorUsesExternalMemory()) {
+      intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
+      nodeRowSize_ = bits::roundUp(
+          singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -165,14 +175,25 @@ class AggregateWindowFunction : public exec::WindowFunction {
           result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
-      simpleAggregation(
-          validRows,
-          frameMetadata.firstRow,
-          frameMetadata.lastRow,
-          rawFrameStarts,
-          rawFrameEnds,
-          resultOffset,
-          result);
+      if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+        segmentTreeAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      } else {
+        simpleAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      }
     }
     previousFrameMetadata_ = frameMetadata;
   }
@@ -345,6 +366,189 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
   }
 
+  // Returns true if the frames of 'validRows' are large enough on average for
+  // building a segment tree to be cheaper than aggregating each frame.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (intermediateType_ == nullptr) {
+      return false;
+    }
+    int64_t totalFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      totalFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return totalFrameRows >=
+        kMinSegmentTreeFrameRows * validRows.countSelected();
+  }
+
+  // Builds a segment tree over the argument rows of this block. Level 0 has a
+  // node for every kSegmentTreeLeafRows rows, level 'k + 1' has a node for
+  // every kSegmentTreeFanout nodes of level 'k'. The accumulators of the
+  // nodes of level 'k' are kept as intermediate results in
+  // 'segmentTreeLevels_[k]'.
+  void buildSegmentTree(vector_size_t numRows) {
+    segmentTreeLevels_.clear();
+    const auto numLeaves =
+        bits::roundUp(numRows, kSegmentTreeLeafRows) / kSegmentTreeLeafRows;
+    const auto bufferSize = static_cast<size_t>(numLeaves) * nodeRowSize_;
+    if (nodeRowsBuffer_ == nullptr ||
+        nodeRowsBuffer_->capacity() < bufferSize) {
+      nodeRowsBuffer_ = AlignedBuffer::allocate<char>(bufferSize, pool_);
+    }
+    auto* rawNodeRows = nodeRowsBuffer_->asMutable<char>();
+    std::vector<char*> nodes(numLeaves);
+    std::vector<vector_size_t> nodeIndices(numLeaves);
+    for (auto i = 0; i < numLeaves; ++i) {
+      nodes[i] = rawNodeRows + static_cast<int64_t>(i) * nodeRowSize_;
+      nodeIndices[i] = i;
+    }
+
+    std::vector<char*> groups(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      groups[i] = nodes[i / kSegmentTreeLeafRows];
+    }
+    SelectivityVector rows(numRows);
+    aggregate_->clear();
+    aggregate_->initializeNewGroups(nodes.data(), nodeIndices);
+    aggregate_->addRawInput(groups.data(), rows, argVectors_, false);
+
+    auto numNodes = numLeaves;
+    for (;;) {
+      auto level = BaseVector::create(intermediateType_, numNodes, pool_);
+      aggregate_->extractAccumulators(nodes.data(), numNodes, &level);
+      segmentTreeLevels_.push_back(level);
+      if (numNodes <= kSegmentTreeFanout) {
+        break;
+      }
+
+      // The nodes of the next level reuse the rows of the previous one.
+      const auto numChildren = numNodes;
+      numNodes =
+          bits::roundUp(numChildren, kSegmentTreeFanout) / kSegmentTreeFanout;
+      groups.resize(numChildren);
+      for (auto i = 0; i < numChildren; ++i) {
+        groups[i] = nodes[i / kSegmentTreeFanout];
+      }
+      rows.resizeFill(numChildren, true);
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(
+          nodes.data(),
+          folly::Range<const vector_size_t*>(nodeIndices.data(), numNodes));
+      aggregate_->addIntermediateResults(groups.data(), rows, {level}, false);
+    }
+  }
+
+  // Adds rows ['begin', 'end') of 'input' of 'size' rows to the single group.
+  void addSingleGroupRange(
+      const std::vector<VectorPtr>& input,
+      vector_size_t size,
+      vector_size_t begin,
+      vector_size_t end,
+      bool intermediate) {
+    if (begin >= end) {
+      return;
+    }
+    auto& rows = intermediate ? nodeRows_ : frameRows_;
+    rows.resizeFill(size, false);
+    rows.setValidRange(begin, end, true);
+    rows.updateBounds();
+    if (intermediate) {
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_, rows, input, false);
+    } else {
+      aggregate_->addSingleGroupRawInput(
+          rawSingleGroupRow_, rows, input, false);
+    }
+  }
+
+  // Computes the aggregate for each frame from the nodes of a segment tree
+  // that cover the frame, plus the rows at the frame bounds that do not fill a
+  // leaf. The inputs are added in row order.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const auto numRows = maxFrame + 1 - minFrame;
+    buildSegmentTree(numRows);
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    const int32_t numLevels = segmentTreeLevels_.size();
+    // Ranges of nodes right of the middle of the frame by level.
+    std::vector<std::pair<vector_size_t, vector_size_t>> rightRanges(
+        numLevels);
+
+    validRows.applyToSelected([&](auto i) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      const auto frameStart = frameStartsVector[i] - minFrame;
+      const auto frameEnd = frameEndsVector[i] - minFrame + 1;
+      const auto leafStart = bits::roundUp(frameStart, kSegmentTreeLeafRows) /
+          kSegmentTreeLeafRows;
+      const auto leafEnd = frameEnd / kSegmentTreeLeafRows;
+      if (leafStart >= leafEnd) {
+        addSingleGroupRange(argVectors_, numRows, frameStart, frameEnd, false);
+      } else {
+        addSingleGroupRange(
+            argVectors_,
+            numRows,
+            frameStart,
+            leafStart * kSegmentTreeLeafRows,
+            false);
+        // Adds the nodes left of the middle of the frame bottom up, then the
+        // nodes right of the middle top down.
+        vector_size_t begin = leafStart;
+        vector_size_t end = leafEnd;
+        int32_t level = 0;
+        for (; begin < end; ++level) {
+          const std::vector<VectorPtr> nodes{segmentTreeLevels_[level]};
+          const auto numNodes = nodes[0]->size();
+          if (level == numLevels - 1) {
+            addSingleGroupRange(nodes, numNodes, begin, end, true);
+            break;
+          }
+          const auto leftEnd = std::min<vector_size_t>(
+              bits::roundUp(begin, kSegmentTreeFanout), end);
+          addSingleGroupRange(nodes, numNodes, begin, leftEnd, true);
+          const auto rightBegin = std::max<vector_size_t>(
+              end / kSegmentTreeFanout * kSegmentTreeFanout, leftEnd);
+          rightRanges[level] = {rightBegin, end};
+          begin =
+              bits::roundUp(leftEnd, kSegmentTreeFanout) / kSegmentTreeFanout;
+          end = rightBegin / kSegmentTreeFanout;
+        }
+        for (auto right = level - 1; right >= 0; --right) {
+          addSingleGroupRange(
+              {segmentTreeLevels_[right]},
+              segmentTreeLevels_[right]->size(),
+              rightRanges[right].first,
+              rightRanges[right].second,
+              true);
+        }
+        addSingleGroupRange(
+            argVectors_,
+            numRows,
+            leafEnd * kSegmentTreeLeafRows,
+            frameEnd,
+            false);
+      }
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setEmptyFramesResult(validRows, resultOffset, emptyResult_, result);
+  }
+
   // Precompute and save the aggregate output for empty input in emptyResult_.
   // This value is returned for rows with empty frames.
   void computeDefaultAggregateValue(const TypePtr& resultType) {
@@ -389,6 +593,32 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
 
+  // Rows per leaf and children per inner node of the segment tree.
+  static constexpr vector_size_t kSegmentTreeLeafRows = 16;
+  static constexpr vector_size_t kSegmentTreeFanout = 16;
+
+  // Min average frame size for using a segment tree.
+  static constexpr int64_t kMinSegmentTreeFrameRows = 64;
+
+  // Intermediate type of the aggregate if it can be computed with a segment
+  // tree, nullptr otherwise.
+  TypePtr intermediateType_;
+
+  // Size of an accumulator row of a segment tree node.
+  int32_t nodeRowSize_{0};
+
+  // Accumulator rows for building the segment tree.
+  BufferPtr nodeRowsBuffer_;
+
+  // Intermediate results of the nodes of the segment tree by level, leaves
+  // first.
+  std::vector<VectorPtr> segmentTreeLevels_;
+
+  // Reusable selectivity vectors for adding argument rows and segment tree
+  // nodes to the single group.
+  SelectivityVector frameRows_;
+  SelectivityVector nodeRows_;
+
   // Stores default result value for empty frame aggregation. Window functions
   // return the default value of an aggregate (aggregation with no rows) for
   // empty frames. e.g. count for empty frames should return 0 and not null.
@@ -38,6 +38,7 @@ class AggregationHook : public ValueHook {
   static constexpr Kind kDoubleMax = 9;
   static constexpr Kind kDoubleMin = 10;
   static constexpr Kind kSumBigintToBigintOverflow = 11;
+  static constexpr Kind kCount = 12;
 
   // Make null behavior known at compile time. This is useful when
   // templating a column decoding loop with a hook.
@@ -240,4 +241,36 @@ class MinMaxHook final : public AggregationHook {
   }
 };
 
+// Counts the non-null values of a column. The count of a group is never null,
+// so the null flags of the groups are left as is. The value type does not
+// matter, hence the same instantiation serves all column readers.
+class CountHook final : public AggregationHook {
+ public:
+  CountHook(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      char** groups,
+      uint64_t* numNulls)
+      : AggregationHook(offset, nullByte, nullMask, groups, numNulls) {}
+
+  Kind kind() const override {
+    return kCount;
+  }
+
+  void addValue(vector_size_t row, const void* /*value*/) override {
+    ++*reinterpret_cast<int64_t*>(findGroup(row) + offset_);
+  }
+
+  void addValues(
+      const vector_size_t* rows,
+      const void* /*values*/,
+      vector_size_t size,
+      uint8_t /*valueWidth*/) override {
+    for (auto i = 0; i < size; ++i) {
+      ++*reinterpret_cast<int64_t*>(findGroup(rows[i]) + offset_);
+    }
+  }
+};
+
 } // namespace facebook::velox::aggregate
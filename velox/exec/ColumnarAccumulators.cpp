@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ColumnarAccumulators.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Flags of the aggregate in the first byte of each array element.
+constexpr int32_t kNullMask = 1;
+constexpr int32_t kInitializedMask = 2;
+
+// Initial number of groups to allocate the arrays for.
+constexpr int32_t kMinCapacity = 1024;
+} // namespace
+
+// static
+bool ColumnarAccumulators::supports(
+    const std::vector<AggregateInfo>& aggregates) {
+  if (aggregates.empty()) {
+    return false;
+  }
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    const auto& function = aggregate.function;
+    if (!function->isFixedSize() || function->accumulatorUsesExternalMemory()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+Accumulator ColumnarAccumulators::groupNumberAccumulator() {
+  return Accumulator{
+      true,
+      sizeof(int32_t),
+      false,
+      alignof(int32_t),
+      INTEGER(),
+      [](folly::Range<char**> /*groups*/, VectorPtr& /*result*/) {
+        VELOX_UNREACHABLE("Columnar accumulators do not support spilling");
+      },
+      [](folly::Range<char**> /*groups*/) {}};
+}
+
+ColumnarAccumulators::ColumnarAccumulators(
+    const std::vector<AggregateInfo>& aggregates,
+    memory::MemoryPool* pool)
+    : aggregates_(aggregates), pool_(pool) {
+  VELOX_CHECK(supports(aggregates_));
+  elementSizes_.reserve(aggregates_.size());
+  arrays_.resize(aggregates_.size());
+  for (const auto& aggregate : aggregates_) {
+    auto& function = aggregate.function;
+    // The flags byte is at 0, the accumulator at the first aligned offset
+    // after it.
+    const int32_t alignment =
+        std::max<int32_t>(function->accumulatorAlignmentSize(), 1);
+    const int32_t offset = alignment;
+    elementSizes_.push_back(bits::roundUp(
+        offset + function->accumulatorFixedWidthSize(), alignment));
+    bytesPerGroup_ += elementSizes_.back();
+    // The accumulators have no variable width part, so the row size offset is
+    // not used.
+    function->setOffsets(offset, 0, kNullMask, 0, kInitializedMask, 0);
+  }
+}
+
+void ColumnarAccumulators::ensureCapacity(int32_t numGroups) {
+  if (numGroups <= capacity_) {
+    return;
+  }
+  const int32_t newCapacity =
+      std::max<int32_t>(kMinCapacity, bits::nextPowerOfTwo(numGroups));
+  for (auto i = 0; i < arrays_.size(); ++i) {
+    const auto bytes = static_cast<size_t>(newCapacity) * elementSizes_[i];
+    if (arrays_[i] == nullptr) {
+      arrays_[i] = AlignedBuffer::allocate<char>(bytes, pool_);
+    } else {
+      AlignedBuffer::reallocate<char>(&arrays_[i], bytes);
+    }
+  }
+  capacity_ = newCapacity;
+}
+
+void ColumnarAccumulators::addNewGroups(
+    char** groups,
+    folly::Range<const vector_size_t*> indices) {
+  VELOX_CHECK_GE(groupNumberOffset_, 0);
+  if (indices.empty()) {
+    return;
+  }
+  VELOX_CHECK_LE(
+      static_cast<int64_t>(numGroups_) + indices.size(),
+      std::numeric_limits<int32_t>::max());
+  const int32_t firstGroup = numGroups_;
+  ensureCapacity(numGroups_ + indices.size());
+  for (auto index : indices) {
+    *reinterpret_cast<int32_t*>(groups[index] + groupNumberOffset_) =
+        numGroups_++;
+  }
+  // New group numbers are consecutive, so their elements are one range.
+  for (auto i = 0; i < arrays_.size(); ++i) {
+    memset(
+        arrays_[i]->asMutable<char>() +
+            static_cast<int64_t>(firstGroup) * elementSizes_[i],
+        0,
+        static_cast<int64_t>(numGroups_ - firstGroup) * elementSizes_[i]);
+  }
+}
+
+void ColumnarAccumulators::loadGroupNumbers(
+    char* const* groups,
+    folly::Range<const vector_size_t*> rows,
+    vector_size_t size) {
+  groupNumbers_.resize(size);
+  std::fill(groupNumbers_.begin(), groupNumbers_.end(), 0);
+  for (auto row : rows) {
+    groupNumbers_[row] =
+        *reinterpret_cast<const int32_t*>(groups[row] + groupNumberOffset_);
+  }
+}
+
+void ColumnarAccumulators::loadGroupNumbers(
+    folly::Range<char* const*> groups) {
+  groupNumbers_.resize(groups.size());
+  for (auto i = 0; i < groups.size(); ++i) {
+    groupNumbers_[i] =
+        *reinterpret_cast<const int32_t*>(groups[i] + groupNumberOffset_);
+  }
+}
+
+char** ColumnarAccumulators::groups(int32_t aggregateIndex) {
+  VELOX_CHECK_GT(capacity_, 0);
+  auto* base = arrays_[aggregateIndex]->asMutable<char>();
+  const int64_t elementSize = elementSizes_[aggregateIndex];
+  const auto numGroups = groupNumbers_.size();
+  groups_.resize(numGroups);
+  for (auto i = 0; i < numGroups; ++i) {
+    groups_[i] = base + groupNumbers_[i] * elementSize;
+  }
+  return groups_.data();
+}
+
+uint64_t ColumnarAccumulators::allocatedBytes() const {
+  uint64_t total = 0;
+  for (const auto& array : arrays_) {
+    if (array != nullptr) {
+      total += array->capacity();
+    }
+  }
+  return total;
+}
+
+} // namespace facebook::velox::exec
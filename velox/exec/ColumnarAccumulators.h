@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/common/base/RawVector.h"
+#include "velox/exec/AggregateInfo.h"
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Keeps the fixed width accumulators of a grouping set in one array per
+/// aggregate instead of in the rows of the RowContainer. Each row stores a
+/// group number in a 4 byte accumulator column. The accumulator of aggregate
+/// 'i' for a group is at element <group number> of array 'i'. The element
+/// starts with a flags byte holding the null and initialized flags of the
+/// aggregate, followed by the accumulator at the aggregate's alignment.
+///
+/// Updating one aggregate then touches a dense array instead of one row per
+/// group, which matters when there are many aggregates and the rows are wider
+/// than a cache line.
+class ColumnarAccumulators {
+ public:
+  /// Returns true if all 'aggregates' have fixed width accumulators that do
+  /// not use memory outside of the accumulator.
+  static bool supports(const std::vector<AggregateInfo>& aggregates);
+
+  /// Returns the accumulator to use in the RowContainer in place of the
+  /// accumulators of the aggregates. Holds the group number.
+  static Accumulator groupNumberAccumulator();
+
+  /// Sets the offsets of 'aggregates' to point into the elements of their
+  /// arrays. 'aggregates' must outlive 'this'.
+  ColumnarAccumulators(
+      const std::vector<AggregateInfo>& aggregates,
+      memory::MemoryPool* pool);
+
+  /// Sets the offset of the group number in the rows. Called after the
+  /// RowContainer is created.
+  void setGroupNumberOffset(int32_t offset) {
+    groupNumberOffset_ = offset;
+  }
+
+  /// Assigns group numbers to 'groups[i]' for each 'i' in 'indices' and clears
+  /// the accumulators of these groups.
+  void addNewGroups(char** groups, folly::Range<const vector_size_t*> indices);
+
+  /// Loads the group numbers of 'groups[i]' for each 'i' in 'rows'. Positions
+  /// not in 'rows', up to 'size', are set to group 0. Must be called after
+  /// addNewGroups() for the same batch.
+  void loadGroupNumbers(
+      char* const* groups,
+      folly::Range<const vector_size_t*> rows,
+      vector_size_t size);
+
+  /// Loads the group numbers of all 'groups'.
+  void loadGroupNumbers(folly::Range<char* const*> groups);
+
+  /// Returns the accumulators of 'aggregateIndex' for the groups loaded by the
+  /// last loadGroupNumbers(), in the same positions. The result is valid until
+  /// the next call.
+  char** groups(int32_t aggregateIndex);
+
+  /// Drops all groups. Keeps the allocated arrays for reuse.
+  void clear() {
+    numGroups_ = 0;
+  }
+
+  /// Returns the bytes of accumulators per group.
+  int32_t bytesPerGroup() const {
+    return bytesPerGroup_;
+  }
+
+  uint64_t allocatedBytes() const;
+
+ private:
+  void ensureCapacity(int32_t numGroups);
+
+  const std::vector<AggregateInfo>& aggregates_;
+  memory::MemoryPool* const pool_;
+
+  // Size of the array element of each aggregate.
+  std::vector<int32_t> elementSizes_;
+  int32_t bytesPerGroup_{0};
+
+  // Accumulator array for each aggregate.
+  std::vector<BufferPtr> arrays_;
+  int32_t capacity_{0};
+  int32_t numGroups_{0};
+
+  int32_t groupNumberOffset_{-1};
+
+  // Group numbers loaded by the last loadGroupNumbers().
+  raw_vector<int32_t> groupNumbers_;
+
+  // Reused result of groups().
+  raw_vector<char*> groups_;
+};
+
+} // namespace facebook::velox::exec
@@ -91,6 +91,76 @@ void serializeOne<TypeKind::ROW>(
   }
 }
 
+// Returns true if values of 'kind' are serialized as the bytes of their native
+// type. Arrays and maps of these are serialized, deserialized, compared and
+// hashed with one type dispatch per array instead of one per element.
+constexpr bool isFixedWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Serializes the null flags and values of 'size' elements of a flat vector of
+// fixed-width values starting at 'offset'. Produces the same bytes as
+// serializing element by element but takes the null flags a word at a time
+// from the null buffer and copies runs of non-null values with one append.
+template <TypeKind Kind>
+void serializeFixedWidthArray(
+    const BaseVector& elements,
+    vector_size_t offset,
+    vector_size_t size,
+    ByteOutputStream& out) {
+  if constexpr (isFixedWidth(Kind)) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    const auto* values =
+        elements.asUnchecked<FlatVector<T>>()->rawValues() + offset;
+    const auto* rawNulls = elements.rawNulls();
+    const auto numWords = bits::nwords(size);
+    if (rawNulls == nullptr) {
+      for (auto i = 0; i < numWords; ++i) {
+        out.appendOne<uint64_t>(0);
+      }
+      out.append<T>(folly::Range(values, size));
+      return;
+    }
+
+    // The null buffer has a set bit for non-null rows, the serialization has a
+    // set bit for null elements.
+    std::vector<uint64_t> notNulls(numWords);
+    bits::copyBits(rawNulls, offset, notNulls.data(), 0, size);
+    std::vector<uint64_t> nulls(numWords);
+    for (auto i = 0; i < numWords; ++i) {
+      nulls[i] = ~notNulls[i];
+    }
+    if (size % 64 != 0) {
+      nulls.back() &= bits::lowMask(size % 64);
+    }
+    out.append<uint64_t>(nulls);
+
+    vector_size_t begin = 0;
+    while ((begin = bits::findFirstBit(notNulls.data(), begin, size)) >= 0) {
+      auto end = bits::findFirstBit(nulls.data(), begin, size);
+      if (end < 0) {
+        end = size;
+      }
+      out.append<T>(folly::Range(values + begin, end - begin));
+      begin = end;
+    }
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 void writeNulls(
     const BaseVector& values,
     vector_size_t offset,
@@ -132,6 +202,17 @@ void serializeArray(
     ByteOutputStream& out,
     const ContainerRowSerdeOptions& options) {
   out.appendOne<int32_t>(size);
+  if (elements.encoding() == VectorEncoding::Simple::FLAT &&
+      isFixedWidth(elements.typeKind())) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        serializeFixedWidthArray,
+        elements.typeKind(),
+        elements,
+        offset,
+        size,
+        out);
+    return;
+  }
   writeNulls(elements, offset, size, out);
   for (auto i = 0; i < size; ++i) {
     if (!elements.isNullAt(i + offset)) {
@@ -284,6 +365,44 @@ void deserializeOne<TypeKind::ROW>(
   result.setNull(index, false);
 }
 
+// Reads 'size' fixed-width values with null flags 'nulls' from 'in' into a
+// flat vector starting at 'offset'. Copies runs of non-null values with one
+// read.
+template <TypeKind Kind>
+void deserializeFixedWidthArray(
+    ByteInputStream& in,
+    const std::vector<uint64_t>& nulls,
+    BaseVector& elements,
+    vector_size_t offset,
+    vector_size_t size) {
+  if constexpr (isFixedWidth(Kind)) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    auto* flat = elements.asUnchecked<FlatVector<T>>();
+    auto* values = flat->mutableRawValues() + offset;
+    if (flat->rawNulls() != nullptr) {
+      bits::fillBits(
+          flat->mutableRawNulls(), offset, offset + size, bits::kNotNull);
+    }
+    vector_size_t begin = 0;
+    while (begin < size) {
+      auto end = bits::findFirstBit(nulls.data(), begin, size);
+      if (end < 0) {
+        end = size;
+      }
+      if (end > begin) {
+        in.readBytes(values + begin, (end - begin) * sizeof(T));
+      }
+      if (end == size) {
+        break;
+      }
+      flat->setNull(offset + end, true);
+      begin = end + 1;
+    }
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 // Reads the size, null flags and deserializes from 'in', appending to
 // the end of 'elements'. Returns the number of added elements and
 // sets 'offset' to the index of the first added element.
@@ -295,6 +414,18 @@ vector_size_t deserializeArray(
   auto nulls = readNulls(in, size);
   offset = elements.size();
   elements.resize(offset + size);
+  if (elements.encoding() == VectorEncoding::Simple::FLAT &&
+      isFixedWidth(elements.typeKind())) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        deserializeFixedWidthArray,
+        elements.typeKind(),
+        in,
+        nulls,
+        elements,
+        offset,
+        size);
+    return size;
+  }
   for (auto i = 0; i < size; ++i) {
     if (bits::isBitSet(nulls.data(), i)) {
       elements.setNull(i + offset, true);
@@ -450,6 +581,46 @@ std::optional<int32_t> compare<TypeKind::ROW>(
   return 0;
 }
 
+// Compares the first 'size' elements of a serialized array of fixed-width
+// values with null flags 'leftNulls' to the elements of a flat vector starting
+// at 'offset'. Returns 0 if these are equal.
+template <TypeKind Kind>
+std::optional<int32_t> compareFixedWidthArrays(
+    ByteInputStream& left,
+    const std::vector<uint64_t>& leftNulls,
+    const BaseVector& elements,
+    vector_size_t offset,
+    vector_size_t size,
+    CompareFlags flags) {
+  if constexpr (isFixedWidth(Kind)) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    const auto* values =
+        elements.asUnchecked<FlatVector<T>>()->rawValues() + offset;
+    const auto* rawNulls = elements.rawNulls();
+    for (auto i = 0; i < size; ++i) {
+      const bool leftNull = bits::isBitSet(leftNulls.data(), i);
+      const bool rightNull =
+          rawNulls != nullptr && bits::isBitNull(rawNulls, offset + i);
+      if (leftNull || rightNull) {
+        auto result = BaseVector::compareNulls(leftNull, rightNull, flags);
+        if (result.has_value() && result.value() == 0) {
+          continue;
+        }
+        return result;
+      }
+
+      const auto result =
+          SimpleVector<T>::comparePrimitiveAsc(left.read<T>(), values[i]);
+      if (result != 0) {
+        return flags.ascending ? result : result * -1;
+      }
+    }
+    return 0;
+  } else {
+    VELOX_UNREACHABLE();
+  }
+}
+
 std::optional<int32_t> compareArrays(
     ByteInputStream& left,
     const BaseVector& elements,
@@ -462,6 +633,22 @@ std::optional<int32_t> compareArrays(
   }
   auto compareSize = std::min(leftSize, rightSize);
   auto leftNulls = readNulls(left, leftSize);
+  if (elements.encoding() == VectorEncoding::Simple::FLAT &&
+      isFixedWidth(elements.typeKind())) {
+    auto result = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        compareFixedWidthArrays,
+        elements.typeKind(),
+        left,
+        leftNulls,
+        elements,
+        offset,
+        compareSize,
+        flags);
+    if (!result.has_value() || result.value() != 0) {
+      return result;
+    }
+    return flags.ascending ? (leftSize - rightSize) : (rightSize - leftSize);
+  }
   auto wrappedElements = elements.wrappedVector();
   for (auto i = 0; i < compareSize; ++i) {
     bool leftNull = bits::isBitSet(leftNulls.data(), i);
@@ -629,20 +816,19 @@ std::optional<int32_t> compare<TypeKind::VARBINARY>(
                          : rightValue.compare(leftValue);
 }
 
-std::optional<int32_t> compareArrays(
+// Compares the first 'size' elements of two serialized arrays with null flags
+// 'leftNulls' and 'rightNulls'. Returns 0 if these are equal. Dispatches on
+// 'Kind' once for all elements if it is fixed-width.
+template <TypeKind Kind>
+std::optional<int32_t> compareArrayElements(
     ByteInputStream& left,
     ByteInputStream& right,
+    const std::vector<uint64_t>& leftNulls,
+    const std::vector<uint64_t>& rightNulls,
+    vector_size_t size,
     const Type* elementType,
     CompareFlags flags) {
-  auto leftSize = left.read<int32_t>();
-  auto rightSize = right.read<int32_t>();
-  if (flags.equalsOnly && leftSize != rightSize) {
-    return flags.ascending ? 1 : -1;
-  }
-  auto compareSize = std::min(leftSize, rightSize);
-  auto leftNulls = readNulls(left, leftSize);
-  auto rightNulls = readNulls(right, rightSize);
-  for (auto i = 0; i < compareSize; ++i) {
+  for (auto i = 0; i < size; ++i) {
     bool leftNull = bits::isBitSet(leftNulls.data(), i);
     bool rightNull = bits::isBitSet(rightNulls.data(), i);
     if (leftNull || rightNull) {
@@ -653,12 +839,52 @@ std::optional<int32_t> compareArrays(
       return result;
     }
 
-    auto result = compareSwitch(left, right, elementType, flags);
+    std::optional<int32_t> result;
+    if constexpr (isFixedWidth(Kind)) {
+      result = compare<Kind>(left, right, elementType, flags);
+    } else {
+      result = compareSwitch(left, right, elementType, flags);
+    }
     if (result.has_value() && result.value() == 0) {
       continue;
     }
     return result;
   }
+  return 0;
+}
+
+std::optional<int32_t> compareArrays(
+    ByteInputStream& left,
+    ByteInputStream& right,
+    const Type* elementType,
+    CompareFlags flags) {
+  auto leftSize = left.read<int32_t>();
+  auto rightSize = right.read<int32_t>();
+  if (flags.equalsOnly && leftSize != rightSize) {
+    return flags.ascending ? 1 : -1;
+  }
+  auto compareSize = std::min(leftSize, rightSize);
+  auto leftNulls = readNulls(left, leftSize);
+  auto rightNulls = readNulls(right, rightSize);
+  std::optional<int32_t> result;
+  if (isFixedWidth(elementType->kind())) {
+    result = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        compareArrayElements,
+        elementType->kind(),
+        left,
+        right,
+        leftNulls,
+        rightNulls,
+        compareSize,
+        elementType,
+        flags);
+  } else {
+    result = compareArrayElements<TypeKind::INVALID>(
+        left, right, leftNulls, rightNulls, compareSize, elementType, flags);
+  }
+  if (!result.has_value() || result.value() != 0) {
+    return result;
+  }
   return flags.ascending ? (leftSize - rightSize) : (rightSize - leftSize);
 }
 
@@ -752,14 +978,21 @@ uint64_t hashOne<TypeKind::VARBINARY>(
   return folly::hasher<StringView>()(readStringView(stream, storage));
 }
 
-uint64_t
-hashArray(ByteInputStream& in, uint64_t hash, const Type* elementType) {
-  auto size = in.read<int32_t>();
-  auto nulls = readNulls(in, size);
+// Mixes the hashes of 'size' serialized elements with null flags 'nulls' into
+// 'hash'. Dispatches on 'Kind' once for all elements if it is fixed-width.
+template <TypeKind Kind>
+uint64_t hashArrayElements(
+    ByteInputStream& in,
+    const std::vector<uint64_t>& nulls,
+    vector_size_t size,
+    uint64_t hash,
+    const Type* elementType) {
   for (auto i = 0; i < size; ++i) {
     uint64_t value;
     if (bits::isBitSet(nulls.data(), i)) {
       value = BaseVector::kNullHash;
+    } else if constexpr (isFixedWidth(Kind)) {
+      value = hashOne<Kind>(in, elementType);
     } else {
       value = hashSwitch(in, elementType);
     }
@@ -768,6 +1001,24 @@ hashArray(ByteInputStream& in, uint64_t hash, const Type* elementType) {
   return hash;
 }
 
+uint64_t
+hashArray(ByteInputStream& in, uint64_t hash, const Type* elementType) {
+  auto size = in.read<int32_t>();
+  auto nulls = readNulls(in, size);
+  if (isFixedWidth(elementType->kind())) {
+    return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        hashArrayElements,
+        elementType->kind(),
+        in,
+        nulls,
+        size,
+        hash,
+        elementType);
+  }
+  return hashArrayElements<TypeKind::INVALID>(
+      in, nulls, size, hash, elementType);
+}
+
 template <>
 uint64_t hashOne<TypeKind::ROW>(ByteInputStream& in, const Type* type) {
   auto size = type->size();
@@ -869,4 +1120,9 @@ uint64_t ContainerRowSerde::hash(ByteInputStream& in, const Type* type) {
   return hashSwitch(in, type);
 }
 
+// static
+bool ContainerRowSerde::isFixedWidth(TypeKind kind) {
+  return exec::isFixedWidth(kind);
+}
+
 } // namespace facebook::velox::exec
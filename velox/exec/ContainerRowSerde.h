@@ -87,6 +87,11 @@ class ContainerRowSerde {
       CompareFlags flags);
 
   static uint64_t hash(ByteInputStream& data, const Type* type);
+
+  /// Returns true if non-null values of 'kind' are serialized as the bytes of
+  /// their native type. Runs of such values from a flat vector can be copied
+  /// to and from the serialization with memcpy.
+  static bool isFixedWidth(TypeKind kind);
 };
 
 } // namespace facebook::velox::exec
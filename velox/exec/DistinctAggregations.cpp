@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/DistinctAggregations.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/SetAccumulator.h"
 
 namespace facebook::velox::exec {
@@ -205,16 +206,318 @@ class TypedDistinctAggregations : public DistinctAggregations {
   VectorPtr inputForAccumulator_;
 };
 
+// Keeps the distinct inputs of all groups in one hash table keyed on the
+// address of the group and the inputs instead of a SetAccumulator per group.
+// Only the first occurrence of the inputs of a group is added to the
+// aggregates, which then accumulate in their own accumulators. This needs no
+// memory per group beyond the accumulators, which matters with many small
+// groups.
+//
+// When the groups are spilled, the accumulator of a group is spilled as the
+// array of its distinct inputs. The aggregates' accumulators are not merged
+// since the same input may be in several spill runs. Instead, the arrays are
+// added back through the hash table for the merged group.
+class HashTableDistinctAggregations : public DistinctAggregations {
+ public:
+  HashTableDistinctAggregations(
+      std::vector<AggregateInfo*> aggregates,
+      const RowTypePtr& inputType,
+      memory::MemoryPool* pool)
+      : pool_{pool},
+        aggregates_{std::move(aggregates)},
+        inputs_{aggregates_[0]->inputs},
+        keyType_{makeKeyType(inputType, inputs_)},
+        spillRows_{memory::StlAllocator<char*>(*pool)} {}
+
+  Accumulator accumulator() const override {
+    // Nothing is stored in the group besides the accumulators of the
+    // aggregates.
+    return {
+        true, // isFixedSize
+        1,
+        false, // usesExternalMemory
+        1, // alignment
+        ARRAY(makeSpillElementType()),
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
+        },
+        [](folly::Range<char**> /*groups*/) {}};
+  }
+
+  void addInput(
+      char** groups,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    auto groupColumn =
+        BaseVector::create<FlatVector<int64_t>>(BIGINT(), input->size(), pool_);
+    auto* rawGroups = groupColumn->mutableRawValues();
+    rows.applyToSelected([&](vector_size_t row) {
+      rawGroups[row] = reinterpret_cast<int64_t>(groups[row]);
+    });
+    const auto args = makeInputForAggregation(input);
+    if (!findDistinctRows(groupColumn, args, rows)) {
+      return;
+    }
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->addRawInput(groups, distinctRows_, args, false);
+    }
+  }
+
+  void addSingleGroupInput(
+      char* group,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows) override {
+    addSingleGroupInput(group, makeInputForAggregation(input), rows);
+  }
+
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    const auto* arrayVector = input->as<ArrayVector>();
+    const auto size = arrayVector->sizeAt(index);
+    if (size == 0) {
+      return;
+    }
+    const auto elements =
+        arrayVector->elements()->slice(arrayVector->offsetAt(index), size);
+    std::vector<VectorPtr> args;
+    if (inputs_.size() == 1) {
+      args.push_back(elements);
+    } else {
+      args = elements->as<RowVector>()->children();
+    }
+    spillInputRows_.resizeFill(size, true);
+    addSingleGroupInput(group, args, spillInputRows_);
+  }
+
+  void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
+      override {
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->extractValues(
+          groups.data(), groups.size(), &result->childAt(aggregate->output));
+    }
+  }
+
+  void clear() override {
+    if (table_ != nullptr) {
+      table_->clear(true);
+    }
+    spillRows_.clear();
+    spillRowsSorted_ = false;
+  }
+
+ protected:
+  void initializeNewGroupsInternal(
+      char** groups,
+      folly::Range<const vector_size_t*> indices) override {
+    for (auto i : indices) {
+      groups[i][nullByte_] |= nullMask_;
+    }
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->initializeNewGroups(groups, indices);
+    }
+  }
+
+ private:
+  static RowTypePtr makeKeyType(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& inputs) {
+    std::vector<std::string> names{"group"};
+    std::vector<TypePtr> types{BIGINT()};
+    for (auto input : inputs) {
+      names.push_back(inputType->nameOf(input));
+      types.push_back(inputType->childAt(input));
+    }
+    return ROW(std::move(names), std::move(types));
+  }
+
+  // Returns the type of the inputs of a group in the spilled array. This is
+  // the input type for a single input and a ROW of the inputs otherwise.
+  TypePtr makeSpillElementType() const {
+    if (inputs_.size() == 1) {
+      return keyType_->childAt(1);
+    }
+    std::vector<std::string> names(
+        keyType_->names().begin() + 1, keyType_->names().end());
+    std::vector<TypePtr> types(
+        keyType_->children().begin() + 1, keyType_->children().end());
+    return ROW(std::move(names), std::move(types));
+  }
+
+  void addSingleGroupInput(
+      char* group,
+      const std::vector<VectorPtr>& args,
+      const SelectivityVector& rows) {
+    auto groupColumn = BaseVector::createConstant(
+        BIGINT(), reinterpret_cast<int64_t>(group), rows.end(), pool_);
+    if (!findDistinctRows(groupColumn, args, rows)) {
+      return;
+    }
+    for (auto* aggregate : aggregates_) {
+      aggregate->function->addSingleGroupRawInput(
+          group, distinctRows_, args, false);
+    }
+  }
+
+  // Sets 'distinctRows_' to the rows of 'args' that have not been seen before
+  // for their group. Returns false if there are no such rows.
+  bool findDistinctRows(
+      const VectorPtr& groupColumn,
+      const std::vector<VectorPtr>& args,
+      const SelectivityVector& rows) {
+    if (table_ == nullptr) {
+      std::vector<std::unique_ptr<VectorHasher>> hashers;
+      for (auto i = 0; i < keyType_->size(); ++i) {
+        hashers.push_back(VectorHasher::create(keyType_->childAt(i), i));
+      }
+      table_ = HashTable<false>::createForAggregation(
+          std::move(hashers), {}, pool_);
+      lookup_ = std::make_unique<HashLookup>(table_->hashers());
+    }
+
+    std::vector<VectorPtr> keys{groupColumn};
+    keys.insert(keys.end(), args.begin(), args.end());
+    const auto size = groupColumn->size();
+    auto keyVector = std::make_shared<RowVector>(
+        pool_, keyType_, nullptr, size, std::move(keys));
+
+    activeRows_ = rows;
+    table_->prepareForGroupProbe(
+        *lookup_,
+        keyVector,
+        activeRows_,
+        false,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    if (lookup_->rows.empty()) {
+      return false;
+    }
+    table_->groupProbe(*lookup_);
+    if (lookup_->newGroups.empty()) {
+      return false;
+    }
+
+    distinctRows_.resizeFill(size, false);
+    for (auto row : lookup_->newGroups) {
+      distinctRows_.setValid(row, true);
+    }
+    distinctRows_.updateBounds();
+    return true;
+  }
+
+  std::vector<VectorPtr> makeInputForAggregation(
+      const RowVectorPtr& input) const {
+    std::vector<VectorPtr> args;
+    args.reserve(inputs_.size());
+    for (auto channel : inputs_) {
+      args.push_back(BaseVector::loadedVectorShared(input->childAt(channel)));
+    }
+    return args;
+  }
+
+  int64_t groupOf(const char* row) const {
+    return RowContainer::valueAt<int64_t>(
+        row, table_->rows()->columnAt(0).offset());
+  }
+
+  // Sorts the rows of 'table_' by group on first use after clear().
+  void ensureSpillRowsSorted() const {
+    if (spillRowsSorted_) {
+      return;
+    }
+    spillRowsSorted_ = true;
+    spillRows_.clear();
+    if (table_ == nullptr) {
+      return;
+    }
+    auto* rows = table_->rows();
+    spillRows_.resize(rows->numRows());
+    RowContainerIterator iter;
+    rows->listRows(
+        &iter, spillRows_.size(), RowContainer::kUnlimited, spillRows_.data());
+    std::sort(
+        spillRows_.begin(), spillRows_.end(), [&](auto* left, auto* right) {
+          return groupOf(left) < groupOf(right);
+        });
+  }
+
+  // Sets 'result' to an array per group of the distinct inputs of the group.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    ensureSpillRowsSorted();
+    auto* arrayVector = result->as<ArrayVector>();
+    arrayVector->resize(groups.size());
+    auto* rawOffsets =
+        arrayVector->mutableOffsets(groups.size())->asMutable<vector_size_t>();
+    auto* rawSizes =
+        arrayVector->mutableSizes(groups.size())->asMutable<vector_size_t>();
+
+    std::vector<char*> groupRows;
+    for (auto i = 0; i < groups.size(); ++i) {
+      const auto group = reinterpret_cast<int64_t>(groups[i]);
+      auto begin = std::lower_bound(
+          spillRows_.begin(), spillRows_.end(), group, [&](auto* row, auto g) {
+            return groupOf(row) < g;
+          });
+      auto end = begin;
+      while (end != spillRows_.end() && groupOf(*end) == group) {
+        ++end;
+      }
+      rawOffsets[i] = groupRows.size();
+      rawSizes[i] = end - begin;
+      groupRows.insert(groupRows.end(), begin, end);
+    }
+
+    auto& elements = arrayVector->elements();
+    elements->resize(groupRows.size());
+    if (groupRows.empty()) {
+      return;
+    }
+    auto* rows = table_->rows();
+    if (inputs_.size() == 1) {
+      rows->extractColumn(groupRows.data(), groupRows.size(), 1, elements);
+      return;
+    }
+    auto* rowElements = elements->as<RowVector>();
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      rows->extractColumn(
+          groupRows.data(), groupRows.size(), i + 1, rowElements->childAt(i));
+    }
+  }
+
+  memory::MemoryPool* const pool_;
+  const std::vector<AggregateInfo*> aggregates_;
+  const std::vector<column_index_t> inputs_;
+
+  // The address of the group followed by the inputs.
+  const RowTypePtr keyType_;
+
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+  SelectivityVector activeRows_;
+  SelectivityVector distinctRows_;
+  SelectivityVector spillInputRows_;
+
+  // Rows of 'table_' sorted by group for extractForSpill().
+  mutable std::vector<char*, memory::StlAllocator<char*>> spillRows_;
+  mutable bool spillRowsSorted_{false};
+};
+
 } // namespace
 
 // static
 std::unique_ptr<DistinctAggregations> DistinctAggregations::create(
     std::vector<AggregateInfo*> aggregates,
     const RowTypePtr& inputType,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    bool useHashTable) {
   VELOX_CHECK_EQ(aggregates.size(), 1);
   VELOX_CHECK(!aggregates[0]->inputs.empty());
 
+  if (useHashTable) {
+    return std::make_unique<HashTableDistinctAggregations>(
+        aggregates, inputType, pool);
+  }
+
   const bool isSingleInput = aggregates[0]->inputs.size() == 1;
   if (!isSingleInput) {
     return std::make_unique<TypedDistinctAggregations<ComplexType>>(
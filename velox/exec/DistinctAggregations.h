@@ -32,10 +32,14 @@ class DistinctAggregations {
   /// aggregates should have the same inputs.
   /// @param inputType Input row type for the aggregation operator.
   /// @param pool Memory pool.
+  /// @param useHashTable If true, the distinct inputs of all groups are kept
+  /// in a single hash table keyed on the group and the inputs instead of a
+  /// set per group. See QueryConfig::kDistinctAggregationHashTable.
   static std::unique_ptr<DistinctAggregations> create(
       std::vector<AggregateInfo*> aggregates,
       const RowTypePtr& inputType,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      bool useHashTable = false);
 
   virtual ~DistinctAggregations() = default;
 
@@ -86,11 +90,25 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the distinct inputs at 'index' of 'input' to 'group'. 'input' is an
+  /// array vector made by the spill extract function of accumulator(). Only
+  /// supported if the accumulator has a spill type.
+  virtual void addSingleGroupSpillInput(
+      char* /*group*/,
+      const VectorPtr& /*input*/,
+      vector_size_t /*index*/) {
+    VELOX_UNSUPPORTED("Spilling is not supported for distinct aggregations");
+  }
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
       const RowVectorPtr& result) = 0;
 
+  /// Frees the state that is not stored in the groups. Called when the groups
+  /// are cleared.
+  virtual void clear() {}
+
  protected:
   // Initializes null flags and accumulators for newly encountered groups.  This
   // function should be called only once for each group.
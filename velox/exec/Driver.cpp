@@ -123,6 +123,52 @@ std::string addContextOnException(
   return fmt::format("Operator: {}", op->toString());
 }
 
+// Records 'state' of 'driver' in the timeline of its task if enabled.
+void recordTimeline(
+    const Driver& driver,
+    DriverTimeline::State state,
+    BlockingReason blockingReason = BlockingReason::kNotBlocked,
+    int32_t operatorId = -1) {
+  auto* timeline = driver.task()->driverTimeline();
+  if (FOLLY_LIKELY(timeline == nullptr)) {
+    return;
+  }
+  const auto* ctx = driver.driverCtx();
+  timeline->record(
+      {getCurrentTimeMicro(),
+       ctx->pipelineId,
+       ctx->driverId,
+       state,
+       blockingReason,
+       operatorId});
+}
+
+// Records the state of 'driver' after it went off thread for 'reason'.
+void recordOffThread(const Driver& driver, StopReason reason) {
+  switch (reason) {
+    case StopReason::kBlock:
+      recordTimeline(
+          driver,
+          DriverTimeline::State::kBlocked,
+          driver.blockingReason(),
+          driver.blockedOperatorId());
+      break;
+    case StopReason::kYield:
+      recordTimeline(driver, DriverTimeline::State::kYielded);
+      break;
+    case StopReason::kPause:
+      recordTimeline(driver, DriverTimeline::State::kPaused);
+      break;
+    case StopReason::kTerminate:
+    case StopReason::kAlreadyTerminated:
+    case StopReason::kAtEnd:
+      recordTimeline(driver, DriverTimeline::State::kFinished);
+      break;
+    default:
+      break;
+  }
+}
+
 } // namespace
 
 DriverCtx::DriverCtx(
@@ -168,6 +214,12 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       [this](uint64_t bytes) {
         task->queryCtx()->updateSpilledBytesAndCheckLimit(bytes);
       };
+  common::SpillFileOffloadCB offloadCb;
+  if (!queryConfig.spillRemoteDirectory().empty()) {
+    offloadCb = [this](uint64_t fileSize) {
+      return task->spillOffloadDirectory(fileSize);
+    };
+  }
   return common::SpillConfig(
       std::move(getSpillDirPathCb),
       std::move(updateAndCheckSpillLimitCb),
@@ -183,7 +235,11 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.maxSpillRunRows(),
       queryConfig.writerFlushThresholdBytes(),
       queryConfig.spillCompressionKind(),
-      queryConfig.spillFileCreateConfig());
+      queryConfig.spillFileCreateConfig(),
+      queryConfig.spillEncodeSortedRuns(),
+      queryConfig.spillAsyncIo(),
+      std::move(offloadCb),
+      queryConfig.joinSpillSerializedRows());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -279,8 +335,47 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  recordTimeline(*driver, DriverTimeline::State::kQueued);
+  if (!driver->task()->acquireDriverSlot(driver)) {
+    return;
+  }
+  addToExecutor(std::move(driver));
+}
+
+// static
+void Driver::addToExecutor(std::shared_ptr<Driver> driver) {
+  const auto& queryCtx = driver->task()->queryCtx();
+  auto* executor = queryCtx->executor();
+  const auto quantumMs = queryCtx->queryConfig().driverPriorityQuantumMs();
+  const auto numPriorities = executor->getNumPriorities();
+  if (quantumMs == 0 || numPriorities <= 1) {
+    executor->add([driver]() { Driver::run(driver); });
+    return;
+  }
+  executor->addWithPriority(
+      [driver]() { Driver::run(driver); },
+      schedulingPriority(
+          queryCtx->driverExecTimeMs(), quantumMs, numPriorities));
+}
+
+// static
+int8_t Driver::schedulingPriority(
+    uint64_t execTimeMs,
+    uint64_t quantumMs,
+    int numPriorities) {
+  VELOX_CHECK_GT(numPriorities, 0);
+  // folly maps priority 'p' to queue 'numPriorities / 2 + p', the last queue
+  // being run first.
+  const int highest = numPriorities - 1 - numPriorities / 2;
+  int level = 0;
+  uint64_t threshold = quantumMs;
+  while (level < numPriorities - 1 && execTimeMs >= threshold) {
+    ++level;
+    threshold = threshold > std::numeric_limits<uint64_t>::max() / 4
+        ? std::numeric_limits<uint64_t>::max()
+        : threshold * 4;
+  }
+  return highest - level;
 }
 
 void Driver::init(
@@ -293,6 +388,9 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  fuseOperatorChains_ = ctx_->queryConfig().driverFuseOperatorChains();
 }
 
 void Driver::initializeOperators() {
@@ -520,6 +618,7 @@ StopReason Driver::runInternal(
     RECORD_HISTOGRAM_METRIC_VALUE(
         kMetricDriverQueueTimeMs, queuedTimeUs / 1'000);
   }
+  recordTimeline(*this, DriverTimeline::State::kRunning);
 
   CancelGuard guard(task().get(), &state_, [&](StopReason reason) {
     // This is run on error or cancel exit.
@@ -546,18 +645,36 @@ StopReason Driver::runInternal(
     const int32_t numOperators = operators_.size();
     ContinueFuture future = ContinueFuture::makeEmpty();
 
+    // The first pass over the operators starts at the blocked operator when
+    // resuming after a block, the following ones at the last operator.
+    int32_t startOperatorId = numOperators - 1;
+    if (resumeOperatorId_ >= 0) {
+      startOperatorId = std::min(resumeOperatorId_, numOperators - 1);
+      resumeOperatorId_ = -1;
+    }
+
+    // True if operators_[i] got a batch from the operator before it in the
+    // previous iteration and the checks before the operator are skipped.
+    bool chained = false;
+
     for (;;) {
-      for (int32_t i = numOperators - 1; i >= 0; --i) {
-        stop = task()->shouldStop();
-        if (stop != StopReason::kNone) {
-          guard.notThrown();
-          return stop;
-        }
+      const auto firstOperatorId = startOperatorId;
+      startOperatorId = numOperators - 1;
+      for (int32_t i = firstOperatorId; i >= 0; --i) {
+        const bool skipChecks = chained;
+        chained = false;
+        if (!skipChecks) {
+          stop = task()->shouldStop();
+          if (stop != StopReason::kNone) {
+            guard.notThrown();
+            return stop;
+          }
 
-        if (FOLLY_UNLIKELY(shouldYield())) {
-          recordYieldCount();
-          guard.notThrown();
-          return StopReason::kYield;
+          if (FOLLY_UNLIKELY(shouldYield())) {
+            recordYieldCount();
+            guard.notThrown();
+            return StopReason::kYield;
+          }
         }
 
         auto* op = operators_[i].get();
@@ -566,7 +683,7 @@ StopReason Driver::runInternal(
         // queuedTime we should update.
         curOperatorId_ = i;
 
-        if (FOLLY_UNLIKELY(checkUnderArbitration(&future))) {
+        if (FOLLY_UNLIKELY(!skipChecks && checkUnderArbitration(&future))) {
           // Blocks the driver if the associated query is under memory
           // arbitration as it is very likely the driver run will trigger memory
           // arbitration when it needs to allocate memory, and the memory
@@ -630,6 +747,7 @@ StopReason Driver::runInternal(
                     processLazyTiming(*op, deltaTiming);
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
+              auto counters = createDeltaPerfCounters(*op);
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
@@ -661,6 +779,7 @@ StopReason Driver::runInternal(
                     auto selfDelta = processLazyTiming(*nextOp, timing);
                     nextOp->stats().wlock()->addInputTiming.add(selfDelta);
                   });
+              auto counters = createDeltaPerfCounters(*nextOp);
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(
@@ -679,6 +798,7 @@ StopReason Driver::runInternal(
               // The next iteration will see if operators_[i + 1] has
               // output now that it got input.
               i += 2;
+              chained = fuseOperatorChains_;
               continue;
             } else {
               stop = task()->shouldStop();
@@ -717,6 +837,7 @@ StopReason Driver::runInternal(
                       processLazyTiming(*op, timing);
                       op->stats().wlock()->finishTiming.add(timing);
                     });
+                auto counters = createDeltaPerfCounters(*nextOp);
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
                     nextOp);
@@ -740,6 +861,7 @@ StopReason Driver::runInternal(
                   auto selfDelta = processLazyTiming(*op, timing);
                   op->stats().wlock()->getOutputTiming.add(selfDelta);
                 });
+            auto counters = createDeltaPerfCounters(*op);
             CALL_OPERATOR(
                 result = op->getOutput(),
                 op,
@@ -795,6 +917,20 @@ StopReason Driver::runInternal(
 
 #undef CALL_OPERATOR
 
+// static
+void Driver::addPerfCounters(
+    Operator& op,
+    const process::PerfCounterValues& delta) {
+  auto lockedStats = op.stats().wlock();
+  lockedStats->addRuntimeStat("hwCycles", RuntimeCounter(delta.cycles));
+  lockedStats->addRuntimeStat(
+      "hwInstructions", RuntimeCounter(delta.instructions));
+  lockedStats->addRuntimeStat(
+      "hwCacheMisses", RuntimeCounter(delta.cacheMisses));
+  lockedStats->addRuntimeStat(
+      "hwBranchMisses", RuntimeCounter(delta.branchMisses));
+}
+
 // static
 std::atomic_uint64_t& Driver::yieldCount() {
   static std::atomic_uint64_t count{0};
@@ -813,9 +949,17 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  // Frees the slot of 'self' in the executor after 'self' is re-enqueued on
+  // yield, so that drivers waiting for a slot go first.
+  auto slotGuard = folly::makeGuard([task = self->task()]() {
+    if (auto next = task->releaseDriverSlot()) {
+      addToExecutor(std::move(next));
+    }
+  });
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
   auto reason = self->runInternal(self, blockingState, nullResult);
+  recordOffThread(*self, reason);
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -835,6 +979,9 @@ void Driver::run(std::shared_ptr<Driver> self) {
 
   switch (reason) {
     case StopReason::kBlock:
+      if (self->ctx_->queryConfig().driverResumeAtBlockedOperator()) {
+        self->resumeOperatorId_ = self->blockedOperatorId_;
+      }
       // Set the resume action outside the Task so that, if the
       // future is already realized we do not have a second thread
       // entering the same Driver.
@@ -877,11 +1024,16 @@ void Driver::closeOperators() {
   }
 
   // Add operator stats to the task.
+  uint64_t peakMemoryBytes = 0;
   for (auto& op : operators_) {
     auto stats = op->stats(true);
     stats.numDrivers = 1;
+    peakMemoryBytes += stats.memoryStats.peakTotalMemoryReservation;
     task()->addOperatorStats(stats);
   }
+  if (ctx_->splitGroupId != kUngroupedGroupId) {
+    task()->addSplitGroupPeakMemory(ctx_->splitGroupId, peakMemoryBytes);
+  }
 }
 
 void Driver::updateStats() {
@@ -934,6 +1086,19 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+bool Driver::mayPushdownRowFilters(const Operator* filterSource) const {
+  for (auto i = 1; i < operators_.size(); ++i) {
+    auto op = operators_[i].get();
+    if (filterSource == op) {
+      return true;
+    }
+    if (!op->isRowIndependent()) {
+      return false;
+    }
+  }
+  VELOX_FAIL("Operator not found in its Driver: {}", filterSource->toString());
+}
+
 std::unordered_set<column_index_t> Driver::canPushdownFilters(
     const Operator* filterSource,
     const std::vector<column_index_t>& channels) const {
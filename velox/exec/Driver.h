@@ -18,10 +18,12 @@
 #include <folly/futures/Future.h>
 #include <folly/portability/SysSyscall.h>
 #include <memory>
+#include <optional>
 
 #include "velox/common/base/Counters.h"
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
@@ -351,6 +353,21 @@ class Driver : public std::enable_shared_from_this<Driver> {
  public:
   static void enqueue(std::shared_ptr<Driver> instance);
 
+  /// Adds 'driver' to the executor of its query. Called by enqueue() once the
+  /// task has a slot for 'driver', see Task::acquireDriverSlot().
+  static void addToExecutor(std::shared_ptr<Driver> driver);
+
+  /// Returns the priority to add a driver of a query whose drivers have run
+  /// for 'execTimeMs' to an executor with 'numPriorities' priorities. The
+  /// query has the highest priority until 'execTimeMs' reaches 'quantumMs'
+  /// and drops one priority each time 'execTimeMs' grows 4x, down to the
+  /// lowest priority. The priorities are centered around 0 as in
+  /// folly::Executor::addWithPriority().
+  static int8_t schedulingPriority(
+      uint64_t execTimeMs,
+      uint64_t quantumMs,
+      int numPriorities);
+
   /// Run the pipeline until it produces a batch of data or gets blocked.
   /// Return the data produced or nullptr if pipeline finished processing and
   /// will not produce more data. Return nullptr and set 'blockingState' if
@@ -405,6 +422,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
   /// order-preserving and do not increase cardinality.
   bool mayPushdownAggregation(Operator* aggregation) const;
 
+  /// Returns true if all operators between the source and 'filterSource' are
+  /// row independent, so that the source may drop the rows that
+  /// 'filterSource' would drop without changing its other input rows.
+  bool mayPushdownRowFilters(const Operator* filterSource) const;
+
   /// Returns a subset of channels for which there are operators upstream from
   /// filterSource that accept dynamically generated filters.
   std::unordered_set<column_index_t> canPushdownFilters(
@@ -450,6 +472,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return blockingReason_;
   }
 
+  /// Returns the id of the operator the driver was last blocked on.
+  int32_t blockedOperatorId() const {
+    return blockedOperatorId_;
+  }
+
   /// Returns the process-wide number of driver cpu yields.
   static std::atomic_uint64_t& yieldCount();
 
@@ -495,12 +522,31 @@ class Driver : public std::enable_shared_from_this<Driver> {
   // The delta CpuWallTiming object would be passes to 'func' upon
   // destruction of the timer.
   template <typename F>
-  std::unique_ptr<DeltaCpuWallTimer<F>> createDeltaCpuWallTimer(F&& func) {
-    return trackOperatorCpuUsage_
-        ? std::make_unique<DeltaCpuWallTimer<F>>(std::move(func))
-        : nullptr;
+  std::optional<DeltaCpuWallTimer<F>> createDeltaCpuWallTimer(F&& func) {
+    if (!trackOperatorCpuUsage_) {
+      return std::nullopt;
+    }
+    return std::optional<DeltaCpuWallTimer<F>>(std::in_place, std::move(func));
+  }
+
+  // Returns a tracker of the hardware counters of an operator call that adds
+  // them to the runtime stats of 'op'. Returns std::nullopt if not enabled by
+  // QueryConfig::kOperatorTrackHardwareCounters.
+  auto createDeltaPerfCounters(Operator& op) {
+    auto func = [&op](const process::PerfCounterValues& delta) {
+      addPerfCounters(op, delta);
+    };
+    using Counters = process::DeltaPerfCounters<decltype(func)>;
+    if (!trackHardwareCounters_) {
+      return std::optional<Counters>();
+    }
+    return std::optional<Counters>(std::in_place, std::move(func));
   }
 
+  static void addPerfCounters(
+      Operator& op,
+      const process::PerfCounterValues& delta);
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -535,8 +581,19 @@ class Driver : public std::enable_shared_from_this<Driver> {
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   size_t blockedOperatorId_{0};
 
+  // Id of the operator to start at when the driver gets back on thread after
+  // being blocked or -1 to start at the last operator. Set if
+  // QueryConfig::kDriverResumeAtBlockedOperator is true.
+  int32_t resumeOperatorId_{-1};
+
   bool trackOperatorCpuUsage_;
 
+  bool trackHardwareCounters_{false};
+
+  // True if a batch added to an operator is passed on without the checks that
+  // run before each operator, see QueryConfig::kDriverFuseOperatorChains.
+  bool fuseOperatorChains_{false};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverTimeline.h"
+
+#include <folly/json.h>
+
+#include <map>
+
+namespace facebook::velox::exec {
+
+// static
+std::string DriverTimeline::stateName(State state) {
+  switch (state) {
+    case State::kQueued:
+      return "queued";
+    case State::kRunning:
+      return "running";
+    case State::kBlocked:
+      return "blocked";
+    case State::kYielded:
+      return "yielded";
+    case State::kPaused:
+      return "paused";
+    case State::kFinished:
+      return "finished";
+  }
+  VELOX_UNREACHABLE();
+}
+
+DriverTimeline::DriverTimeline(int32_t capacity) : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+}
+
+void DriverTimeline::record(const Event& event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() < capacity_) {
+    events_.push_back(event);
+    return;
+  }
+  events_[next_] = event;
+  next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<DriverTimeline::Event> DriverTimeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<Event> result;
+  result.reserve(events_.size());
+  result.insert(result.end(), events_.begin() + next_, events_.end());
+  result.insert(result.end(), events_.begin(), events_.begin() + next_);
+  return result;
+}
+
+std::string DriverTimeline::toChromeTrace() const {
+  const auto allEvents = events();
+
+  // Events of each driver in time order, keyed on pipeline and driver id.
+  std::map<std::pair<int32_t, int32_t>, std::vector<const Event*>> drivers;
+  for (const auto& event : allEvents) {
+    drivers[{event.pipelineId, event.driverId}].push_back(&event);
+  }
+
+  folly::dynamic traceEvents = folly::dynamic::array;
+  int32_t lastPipelineId = -1;
+  for (const auto& [id, events] : drivers) {
+    const auto [pipelineId, driverId] = id;
+    if (pipelineId != lastPipelineId) {
+      traceEvents.push_back(folly::dynamic::object("name", "process_name")(
+          "ph", "M")("pid", pipelineId)(
+          "args",
+          folly::dynamic::object(
+              "name", fmt::format("Pipeline {}", pipelineId))));
+      lastPipelineId = pipelineId;
+    }
+    traceEvents.push_back(folly::dynamic::object("name", "thread_name")(
+        "ph", "M")("pid", pipelineId)("tid", driverId)(
+        "args",
+        folly::dynamic::object("name", fmt::format("Driver {}", driverId))));
+
+    for (auto i = 0; i < events.size(); ++i) {
+      const auto& event = *events[i];
+      auto name = stateName(event.state);
+      folly::dynamic args = folly::dynamic::object;
+      if (event.state == State::kBlocked) {
+        name = fmt::format(
+            "{} {}", name, blockingReasonToString(event.blockingReason));
+        args["operatorId"] = event.operatorId;
+      }
+      auto traceEvent = folly::dynamic::object("name", name)("cat", "driver")(
+          "ts", static_cast<int64_t>(event.timeUs))("pid", pipelineId)(
+          "tid", driverId)(
+          "args", std::move(args));
+      if (i + 1 < events.size()) {
+        traceEvent["ph"] = "X";
+        const auto endUs = events[i + 1]->timeUs;
+        traceEvent["dur"] = static_cast<int64_t>(
+            endUs > event.timeUs ? endUs - event.timeUs : 0);
+      } else {
+        traceEvent["ph"] = "i";
+        traceEvent["s"] = "t";
+      }
+      traceEvents.push_back(std::move(traceEvent));
+    }
+  }
+  return folly::toJson(folly::dynamic::object("traceEvents", traceEvents)(
+      "displayTimeUnit", "ms"));
+}
+
+} // namespace facebook::velox::exec
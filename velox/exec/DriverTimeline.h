@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+/// Records the state changes of the drivers of a task with timestamps in a
+/// ring buffer that keeps the latest 'capacity' changes. A driver records a
+/// change when it is queued, gets on thread and goes off thread, not per
+/// batch, so that the timeline can stay enabled in production. The timeline
+/// can be exported in the Chrome trace event format, which chrome://tracing
+/// and Perfetto display with a row per driver, to see where drivers wait for
+/// a thread or are blocked.
+///
+/// Enabled by QueryConfig::kDriverTimelineCapacity.
+class DriverTimeline {
+ public:
+  enum class State {
+    /// Waiting for a thread in the executor.
+    kQueued,
+    kRunning,
+    /// Off thread, waiting for 'blockingReason' of 'operatorId'.
+    kBlocked,
+    /// Off thread after using up its time slice or being asked to yield.
+    kYielded,
+    kPaused,
+    /// Finished or terminated.
+    kFinished,
+  };
+
+  static std::string stateName(State state);
+
+  struct Event {
+    /// Microseconds since epoch.
+    uint64_t timeUs;
+    int32_t pipelineId;
+    int32_t driverId;
+    State state;
+    BlockingReason blockingReason{BlockingReason::kNotBlocked};
+    /// Operator the driver is blocked on or -1.
+    int32_t operatorId{-1};
+  };
+
+  explicit DriverTimeline(int32_t capacity);
+
+  void record(const Event& event);
+
+  /// Returns the recorded events, oldest first.
+  std::vector<Event> events() const;
+
+  /// Returns the events as a JSON object in the Chrome trace event format.
+  /// Each state of a driver becomes a complete event lasting until the next
+  /// state of the driver. The last state of a driver becomes an instant
+  /// event. Pipelines are processes and drivers are threads.
+  std::string toChromeTrace() const;
+
+ private:
+  const int32_t capacity_;
+
+  mutable std::mutex mutex_;
+
+  // Ring buffer of at most 'capacity_' events.
+  std::vector<Event> events_;
+
+  // Index in 'events_' of the next event to overwrite once 'events_' is full.
+  int32_t next_{0};
+};
+
+} // namespace facebook::velox::exec
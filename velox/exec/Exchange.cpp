@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/Exchange.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -63,7 +64,7 @@ bool Exchange::getSplits(ContinueFuture* future) {
 }
 
 BlockingReason Exchange::isBlocked(ContinueFuture* future) {
-  if (!currentPages_.empty() || atEnd_) {
+  if (atEnd_ || (!currentPages_.empty() && !shouldCoalesce())) {
     return BlockingReason::kNotBlocked;
   }
 
@@ -74,13 +75,29 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     getSplits(&splitFuture_);
   }
 
-  const auto maxBytes = getSerde()->supportsAppendInDeserialize()
-      ? preferredOutputBatchBytes_
-      : 1;
-
+  const bool supportsAppend = getSerde()->supportsAppendInDeserialize();
   ContinueFuture dataFuture;
-  currentPages_ = exchangeClient_->next(maxBytes, &atEnd_, &dataFuture);
-  if (!currentPages_.empty() || atEnd_) {
+  for (;;) {
+    const auto maxBytes = supportsAppend
+        ? std::max<uint64_t>(1, preferredOutputBatchBytes_ - currentPagesBytes_)
+        : 1;
+    auto pages = exchangeClient_->next(maxBytes, &atEnd_, &dataFuture);
+    if (pages.empty()) {
+      break;
+    }
+    if (currentPages_.empty() && coalesceMaxWaitUs_ > 0) {
+      coalesceDeadlineUs_ = getCurrentTimeMicro() + coalesceMaxWaitUs_;
+    }
+    for (auto& page : pages) {
+      currentPagesBytes_ += page->size();
+      currentPages_.push_back(std::move(page));
+    }
+    if (atEnd_ || !shouldCoalesce()) {
+      break;
+    }
+  }
+
+  if (atEnd_ || (!currentPages_.empty() && !shouldCoalesce())) {
     if (atEnd_ && noMoreSplits_) {
       const auto numSplits = stats_.rlock()->numSplits;
       operatorCtx_->task()->multipleSplitsFinished(false, numSplits, 0);
@@ -89,6 +106,19 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
     return BlockingReason::kNotBlocked;
   }
 
+  if (!currentPages_.empty()) {
+    // Wait for more pages to coalesce with the ones at hand, but no longer
+    // than the coalescing deadline. A timeout is not an error.
+    const auto nowUs = getCurrentTimeMicro();
+    const auto waitUs =
+        coalesceDeadlineUs_ > nowUs ? coalesceDeadlineUs_ - nowUs : 1;
+    *future = std::move(dataFuture)
+                  .within(std::chrono::microseconds(waitUs))
+                  .defer([](folly::Try<folly::Unit>&&) {});
+    ++numCoalesceWaits_;
+    return BlockingReason::kWaitForProducer;
+  }
+
   // We have a dataFuture and we may also have a splitFuture_.
 
   if (splitFuture_.valid()) {
@@ -105,6 +135,13 @@ BlockingReason Exchange::isBlocked(ContinueFuture* future) {
   return BlockingReason::kWaitForProducer;
 }
 
+bool Exchange::shouldCoalesce() {
+  return coalesceMaxWaitUs_ > 0 &&
+      currentPagesBytes_ < preferredOutputBatchBytes_ &&
+      getCurrentTimeMicro() < coalesceDeadlineUs_ &&
+      getSerde()->supportsAppendInDeserialize();
+}
+
 bool Exchange::isFinished() {
   return atEnd_ && currentPages_.empty();
 }
@@ -116,10 +153,14 @@ RowVectorPtr Exchange::getOutput() {
 
   uint64_t rawInputBytes{0};
   vector_size_t resultOffset = 0;
-  for (const auto& page : currentPages_) {
+  for (auto& page : currentPages_) {
     rawInputBytes += page->size();
 
     auto inputStream = page->prepareStreamForDeserialize();
+    if (deserializeInPlace_) {
+      // Vectors that refer to the page memory keep the page alive.
+      options_.inputOwner = std::shared_ptr<SerializedPage>(std::move(page));
+    }
 
     while (!inputStream.atEnd()) {
       getSerde()->deserialize(
@@ -127,8 +168,10 @@ RowVectorPtr Exchange::getOutput() {
       resultOffset = result_->size();
     }
   }
+  options_.inputOwner.reset();
 
   currentPages_.clear();
+  currentPagesBytes_ = 0;
 
   {
     auto lockedStats = stats_.wlock();
@@ -141,8 +184,14 @@ RowVectorPtr Exchange::getOutput() {
 }
 
 void Exchange::close() {
+  if (numCoalesceWaits_ > 0) {
+    stats_.wlock()->addRuntimeStat(
+        kNumCoalesceWaits, RuntimeCounter(numCoalesceWaits_));
+    numCoalesceWaits_ = 0;
+  }
   SourceOperator::close();
   currentPages_.clear();
+  currentPagesBytes_ = 0;
   result_ = nullptr;
   if (exchangeClient_) {
     recordExchangeClientStats();
@@ -37,6 +37,10 @@ struct RemoteConnectorSplit : public connector::ConnectorSplit {
 
 class Exchange : public SourceOperator {
  public:
+  /// Number of times the operator waited for more pages to coalesce with the
+  /// pages at hand. See QueryConfig::kExchangeCoalesceMaxWaitMs.
+  static inline const std::string kNumCoalesceWaits = "numCoalesceWaits";
+
   Exchange(
       int32_t operatorId,
       DriverCtx* driverCtx,
@@ -51,6 +55,10 @@ class Exchange : public SourceOperator {
             operatorType),
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
+        coalesceMaxWaitUs_{
+            driverCtx->queryConfig().exchangeCoalesceMaxWaitMs() * 1'000UL},
+        deserializeInPlace_{
+            driverCtx->queryConfig().exchangeDeserializeInPlace()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
         exchangeClient_{std::move(exchangeClient)} {
     options_.compressionKind =
@@ -92,7 +100,14 @@ class Exchange : public SourceOperator {
   /// operator's stats.
   void recordExchangeClientStats();
 
+  // Returns true if the pages at hand are smaller than
+  // 'preferredOutputBatchBytes_' and the coalescing deadline has not passed.
+  bool shouldCoalesce();
+
   const uint64_t preferredOutputBatchBytes_;
+  const uint64_t coalesceMaxWaitUs_;
+  // See QueryConfig::kExchangeDeserializeInPlace.
+  const bool deserializeInPlace_;
 
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
@@ -108,6 +123,12 @@ class Exchange : public SourceOperator {
 
   std::shared_ptr<ExchangeClient> exchangeClient_;
   std::vector<std::unique_ptr<SerializedPage>> currentPages_;
+  // Total size of 'currentPages_'.
+  uint64_t currentPagesBytes_{0};
+  // Time until which to wait for more pages to coalesce with
+  // 'currentPages_'. Set when the first of 'currentPages_' arrives.
+  uint64_t coalesceDeadlineUs_{0};
+  int64_t numCoalesceWaits_{0};
   bool atEnd_{false};
   std::default_random_engine rng_{std::random_device{}()};
   serializer::presto::PrestoVectorSerde::PrestoOptions options_;
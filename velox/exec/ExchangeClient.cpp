@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -107,6 +108,7 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  stats["numCreditLimitedRequests"] = RuntimeMetric(numCreditLimitedRequests_);
 
   return stats;
 }
@@ -140,6 +142,25 @@ ExchangeClient::next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future) {
   return pages;
 }
 
+void ExchangeClient::setMaxQueuedBytes(int64_t maxQueuedBytes) {
+  std::vector<RequestSpec> requestSpecs;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    if (closed_ || maxQueuedBytes == maxQueuedBytes_) {
+      return;
+    }
+    const bool grow = maxQueuedBytes > maxQueuedBytes_;
+    maxQueuedBytes_ = maxQueuedBytes;
+    if (!grow) {
+      return;
+    }
+    requestSpecs = pickSourcesToRequestLocked();
+  }
+
+  // Outside of lock
+  request(std::move(requestSpecs));
+}
+
 void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
   auto self = shared_from_this();
   for (auto& spec : requestSpecs) {
@@ -150,15 +171,22 @@ void ExchangeClient::request(std::vector<RequestSpec>&& requestSpecs) {
       future = spec.source->request(spec.maxBytes, kRequestDataMaxWait);
     }
     VELOX_CHECK(future.valid());
+    const auto startUs = getCurrentTimeMicro();
     std::move(future)
         .via(executor_)
-        .thenValue([self, spec = std::move(spec)](auto&& response) {
+        .thenValue([self, spec = std::move(spec), startUs](auto&& response) {
           std::vector<RequestSpec> requestSpecs;
           {
             std::lock_guard<std::mutex> l(self->queue_->mutex());
             if (self->closed_) {
               return;
             }
+            if (spec.maxBytes > 0 && response.bytes > 0) {
+              self->updateThroughputLocked(
+                  spec.source.get(),
+                  response.bytes,
+                  getCurrentTimeMicro() - startUs);
+            }
             if (!response.atEnd) {
               if (!response.remainingBytes.empty()) {
                 for (auto bytes : response.remainingBytes) {
@@ -199,22 +227,37 @@ ExchangeClient::pickSourcesToRequestLocked() {
       maxQueuedBytes_ - queue_->totalBytes() - totalPendingBytes_;
   while (availableSpace > 0 && !producingSources_.empty()) {
     auto& source = producingSources_.front().source;
+    const auto credit = sourceCreditLocked(source.get());
     int64_t requestBytes = 0;
+    bool full = false;
+    bool creditLimited = false;
     for (auto bytes : producingSources_.front().remainingBytes) {
-      availableSpace -= bytes;
-      if (availableSpace < 0) {
+      if (bytes > availableSpace) {
+        full = true;
+        break;
+      }
+      // Always fetch the first page that fits, the credit limits the rest.
+      if (requestBytes > 0 && requestBytes + bytes > credit) {
+        creditLimited = true;
         break;
       }
+      availableSpace -= bytes;
       requestBytes += bytes;
     }
     if (requestBytes == 0) {
-      VELOX_CHECK_LT(availableSpace, 0);
+      VELOX_CHECK(full);
       break;
     }
     VELOX_CHECK(source->shouldRequestLocked());
     requestSpecs.push_back({std::move(source), requestBytes});
     producingSources_.pop();
     totalPendingBytes_ += requestBytes;
+    if (creditLimited) {
+      ++numCreditLimitedRequests_;
+    }
+    if (full) {
+      break;
+    }
   }
   if (queue_->totalBytes() == 0 && totalPendingBytes_ == 0 &&
       !producingSources_.empty()) {
@@ -232,6 +275,38 @@ ExchangeClient::pickSourcesToRequestLocked() {
   return requestSpecs;
 }
 
+void ExchangeClient::updateThroughputLocked(
+    const ExchangeSource* source,
+    int64_t bytes,
+    uint64_t elapsedUs) {
+  // Weight of the latest request in the smoothed throughput.
+  constexpr double kNewSampleWeight = 0.3;
+  const double sample = bytes * 1'000'000.0 / std::max<uint64_t>(1, elapsedUs);
+  auto it = sourceThroughput_.find(source);
+  if (it == sourceThroughput_.end()) {
+    sourceThroughput_.emplace(source, sample);
+    totalThroughput_ += sample;
+    return;
+  }
+  const double throughput =
+      it->second * (1 - kNewSampleWeight) + sample * kNewSampleWeight;
+  totalThroughput_ += throughput - it->second;
+  it->second = throughput;
+}
+
+int64_t ExchangeClient::sourceCreditLocked(const ExchangeSource* source) const {
+  if (sources_.size() <= 1 || totalThroughput_ <= 0) {
+    return maxQueuedBytes_;
+  }
+  const int64_t evenShare = maxQueuedBytes_ / sources_.size();
+  auto it = sourceThroughput_.find(source);
+  if (it == sourceThroughput_.end()) {
+    return evenShare;
+  }
+  return std::max<int64_t>(
+      evenShare, maxQueuedBytes_ * (it->second / totalThroughput_));
+}
+
 ExchangeClient::~ExchangeClient() {
   close();
 }
@@ -93,6 +93,10 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::vector<std::unique_ptr<SerializedPage>>
   next(uint32_t maxBytes, bool* atEnd, ContinueFuture* future);
 
+  /// Changes the most bytes to queue or have in flight. Starts fetching more
+  /// data if the limit grows.
+  void setMaxQueuedBytes(int64_t maxQueuedBytes);
+
   std::string toString() const;
 
   folly::dynamic toJson() const;
@@ -113,12 +117,26 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
 
   std::vector<RequestSpec> pickSourcesToRequestLocked();
 
+  // Updates the throughput estimate of 'source' after a data request for
+  // 'bytes' that took 'elapsedUs'.
+  void updateThroughputLocked(
+      const ExchangeSource* source,
+      int64_t bytes,
+      uint64_t elapsedUs);
+
+  // Returns the credit of 'source', i.e. the most bytes a single request to
+  // 'source' asks for beyond its first page. Sources get a share of
+  // 'maxQueuedBytes_' proportional to their recent throughput, but no less
+  // than an even share, so that slow sources do not hold most of the queue
+  // while fast ones wait.
+  int64_t sourceCreditLocked(const ExchangeSource* source) const;
+
   void request(std::vector<RequestSpec>&& requestSpecs);
 
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
-  const int64_t maxQueuedBytes_;
+  int64_t maxQueuedBytes_;
   memory::MemoryPool* const pool_;
   folly::Executor* const executor_;
   const std::shared_ptr<ExchangeQueue> queue_;
@@ -135,6 +153,15 @@ class ExchangeClient : public std::enable_shared_from_this<ExchangeClient> {
   std::queue<ProducingSource> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  // Smoothed throughput in bytes per second of the data requests to each
+  // source and the sum over all sources.
+  folly::F14FastMap<const ExchangeSource*, double> sourceThroughput_;
+  double totalThroughput_{0};
+
+  // Number of data requests that asked for less than the available pages of
+  // a source because of its credit.
+  int64_t numCreditLimitedRequests_{0};
 };
 
 } // namespace facebook::velox::exec
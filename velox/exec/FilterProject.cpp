@@ -117,6 +117,38 @@ bool FilterProject::allInputProcessed() {
   return false;
 }
 
+void FilterProject::close() {
+  if (exprs_ != nullptr) {
+    addExprRuntimeStats();
+  }
+  Operator::close();
+  if (exprs_ != nullptr) {
+    exprs_->clear();
+  } else {
+    VELOX_CHECK(!initialized_);
+  }
+}
+
+void FilterProject::addExprRuntimeStats() {
+  if (!operatorCtx_->driverCtx()->queryConfig().exprProfilingEnabled()) {
+    return;
+  }
+  for (const auto& [name, stats] : exprs_->stats()) {
+    const auto prefix = fmt::format("expr.{}.", name);
+    addRuntimeStat(
+        prefix + "cpuNanos",
+        RuntimeCounter(stats.timing.cpuNanos, RuntimeCounter::Unit::kNanos));
+    addRuntimeStat(prefix + "rows", RuntimeCounter(stats.numProcessedRows));
+    addRuntimeStat(prefix + "outputRows", RuntimeCounter(stats.numOutputRows));
+    addRuntimeStat(
+        prefix + "allocatedBytes",
+        RuntimeCounter(stats.allocatedBytes, RuntimeCounter::Unit::kBytes));
+    addRuntimeStat(
+        prefix + "peeledBatches", RuntimeCounter(stats.numPeeledVectors));
+    addRuntimeStat(prefix + "memoHits", RuntimeCounter(stats.numMemoHits));
+  }
+}
+
 bool FilterProject::isFinished() {
   return noMoreInput_ && allInputProcessed();
 }
@@ -134,10 +166,13 @@ RowVectorPtr FilterProject::getOutput() {
   EvalCtx evalCtx(operatorCtx_->execCtx(), exprs_.get(), input_.get());
 
   // Pre-load lazy vectors which are referenced by both expressions and identity
-  // projections.
+  // projections. The remaining lazy vectors are accessed only by the
+  // expressions and can be loaded for the rows each expression is evaluated
+  // on.
   for (auto fieldIdx : multiplyReferencedFieldIndices_) {
     evalCtx.ensureFieldLoaded(fieldIdx, *rows);
   }
+  evalCtx.setLoadLazyForEvaluatedRowsOnly(true);
 
   if (!hasFilter_) {
     numProcessedInputRows_ = size;
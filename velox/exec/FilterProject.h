@@ -37,6 +37,10 @@ class FilterProject : public Operator {
     return true;
   }
 
+  bool isRowIndependent() const override {
+    return true;
+  }
+
   bool needsInput() const override {
     return !input_;
   }
@@ -51,14 +55,7 @@ class FilterProject : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    Operator::close();
-    if (exprs_ != nullptr) {
-      exprs_->clear();
-    } else {
-      VELOX_CHECK(!initialized_);
-    }
-  }
+  void close() override;
 
   /// Data for accelerator conversion.
   struct Export {
@@ -102,6 +99,10 @@ class FilterProject : public Operator {
   bool initialized_{false};
 
   std::unique_ptr<ExprSet> exprs_;
+
+  // Adds the per-expression counters of 'exprs_' to the runtime stats if
+  // enabled by QueryConfig::kExprProfilingEnabled.
+  void addExprRuntimeStats();
   int32_t numExprs_;
 
   FilterEvalCtx filterEvalCtx_;
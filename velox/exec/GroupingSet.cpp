@@ -102,8 +102,11 @@ GroupingSet::GroupingSet(
       VELOX_USER_CHECK(
           !isPartial_,
           "Partial aggregations over distinct inputs are not supported");
-      distinctAggregations_.emplace_back(
-          DistinctAggregations::create({&aggregate}, inputType, &pool_));
+      distinctAggregations_.emplace_back(DistinctAggregations::create(
+          {&aggregate},
+          inputType,
+          &pool_,
+          queryConfig_.distinctAggregationHashTable()));
     } else {
       distinctAggregations_.push_back(nullptr);
     }
@@ -187,6 +190,20 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   addInputForActiveRows(input, mayPushdown);
 }
 
+vector_size_t GroupingSet::countGroupingKeyRuns(
+    const RowVectorPtr& input) const {
+  if (input->size() == 0) {
+    return 0;
+  }
+  vector_size_t numRuns = 1;
+  for (auto i = 1; i < input->size(); ++i) {
+    if (!equalKeys(keyChannels_, input, i - 1, i)) {
+      ++numRuns;
+    }
+  }
+  return numRuns;
+}
+
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
 
@@ -241,6 +258,11 @@ void GroupingSet::addInputForActiveRows(
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
+  if (columnarAccumulators_ != nullptr) {
+    columnarAccumulators_->addNewGroups(groups, newGroups);
+    columnarAccumulators_->loadGroupNumbers(
+        groups, lookup_->rows, lookup_->hits.size());
+  }
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -261,8 +283,11 @@ void GroupingSet::addInputForActiveRows(
     }
 
     auto& function = aggregates_[i].function;
+    auto* aggregateGroups = columnarAccumulators_ != nullptr
+        ? columnarAccumulators_->groups(i)
+        : groups;
     if (!newGroups.empty()) {
-      function->initializeNewGroups(groups, newGroups);
+      function->initializeNewGroups(aggregateGroups, newGroups);
     }
 
     // Check is mask is false for all rows.
@@ -277,9 +302,10 @@ void GroupingSet::addInputForActiveRows(
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
     if (isRawInput_) {
-      function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      function->addRawInput(aggregateGroups, rows, tempVectors_, canPushdown);
     } else {
-      function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
+      function->addIntermediateResults(
+          aggregateGroups, rows, tempVectors_, canPushdown);
     }
   }
   tempVectors_.clear();
@@ -354,16 +380,38 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
 }
 
 void GroupingSet::createHashTable() {
+  // Spilling reads the accumulators from the rows, so columnar accumulators
+  // are only used if the aggregation cannot spill.
+  if (queryConfig_.aggregationColumnarAccumulators() &&
+      spillConfig_ == nullptr && ColumnarAccumulators::supports(aggregates_)) {
+    columnarAccumulators_ =
+        std::make_unique<ColumnarAccumulators>(aggregates_, &pool_);
+  } else {
+    columnarAccumulators_.reset();
+  }
+  auto rowAccumulators = columnarAccumulators_ != nullptr
+      ? std::vector<Accumulator>{ColumnarAccumulators::groupNumberAccumulator()}
+      : accumulators(false);
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), std::move(rowAccumulators), &pool_);
   } else {
     table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_), std::move(rowAccumulators), &pool_);
   }
 
   RowContainer& rows = *table_->rows();
-  initializeAggregates(aggregates_, rows, false);
+  if (columnarAccumulators_ != nullptr) {
+    // The aggregates' offsets are set by 'columnarAccumulators_'. There are no
+    // sorted or distinct aggregations.
+    for (auto& aggregate : aggregates_) {
+      aggregate.function->setAllocator(&rows.stringAllocator());
+    }
+    columnarAccumulators_->setGroupNumberOffset(
+        rows.columnAt(rows.keyTypes().size()).offset());
+  } else {
+    initializeAggregates(aggregates_, rows, false);
+  }
 
   auto numColumns = rows.keyTypes().size() + aggregates_.size();
 
@@ -742,9 +790,7 @@ bool GroupingSet::getOutput(
             &iterator, maxOutputRows, maxOutputBytes, groups)
       : 0;
   if (numGroups == 0) {
-    if (table_ != nullptr) {
-      table_->clear();
-    }
+    resetTable();
     return false;
   }
   extractGroups(folly::Range<char**>(groups, numGroups), result);
@@ -764,6 +810,9 @@ void GroupingSet::extractGroups(
     auto keyVector = result->childAt(i);
     rows.extractColumn(groups.data(), groups.size(), i, keyVector);
   }
+  if (columnarAccumulators_ != nullptr) {
+    columnarAccumulators_->loadGroupNumbers(groups);
+  }
   for (int32_t i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
@@ -771,11 +820,14 @@ void GroupingSet::extractGroups(
 
     auto& function = aggregates_[i].function;
     auto& aggregateVector = result->childAt(i + totalKeys);
+    auto* aggregateGroups = columnarAccumulators_ != nullptr
+        ? columnarAccumulators_->groups(i)
+        : groups.data();
     if (isPartial_) {
       function->extractAccumulators(
-          groups.data(), groups.size(), &aggregateVector);
+          aggregateGroups, groups.size(), &aggregateVector);
     } else {
-      function->extractValues(groups.data(), groups.size(), &aggregateVector);
+      function->extractValues(aggregateGroups, groups.size(), &aggregateVector);
     }
   }
 
@@ -794,6 +846,94 @@ void GroupingSet::resetTable() {
   if (table_ != nullptr) {
     table_->clear();
   }
+  if (columnarAccumulators_ != nullptr) {
+    columnarAccumulators_->clear();
+  }
+  clearDistinctAggregations();
+}
+
+std::vector<std::vector<RowVectorPtr>>
+GroupingSet::extractIntermediatePartitions(
+    const RowTypePtr& inputType,
+    uint32_t numPartitions,
+    vector_size_t maxBatchRows) {
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(!isRawInput_);
+  VELOX_CHECK(!hasSpilled());
+  VELOX_CHECK_GT(numPartitions, 0);
+  VELOX_CHECK_GT(maxBatchRows, 0);
+
+  std::vector<std::vector<RowVectorPtr>> partitions(numPartitions);
+  if (table_ == nullptr || table_->numDistinct() == 0) {
+    return partitions;
+  }
+
+  RowContainer& rows = *table_->rows();
+  const auto numKeys = rows.keyTypes().size();
+  std::vector<std::vector<char*>> partitionGroups(numPartitions);
+  const auto flush = [&](uint32_t partition) {
+    auto& groups = partitionGroups[partition];
+    if (groups.empty()) {
+      return;
+    }
+    const vector_size_t numGroups = groups.size();
+    std::vector<VectorPtr> children(inputType->size());
+    for (auto i = 0; i < numKeys; ++i) {
+      auto& child = children[keyChannels_[i]];
+      VELOX_CHECK_NULL(child);
+      child = BaseVector::create(
+          inputType->childAt(keyChannels_[i]), numGroups, &pool_);
+      rows.extractColumn(groups.data(), numGroups, i, child);
+    }
+    if (columnarAccumulators_ != nullptr) {
+      columnarAccumulators_->loadGroupNumbers(groups);
+    }
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      auto& aggregate = aggregates_[i];
+      VELOX_CHECK_EQ(aggregate.inputs.size(), 1);
+      auto& child = children[aggregate.inputs[0]];
+      VELOX_CHECK_NULL(child);
+      child = BaseVector::create(
+          inputType->childAt(aggregate.inputs[0]), numGroups, &pool_);
+      auto* aggregateGroups = columnarAccumulators_ != nullptr
+          ? columnarAccumulators_->groups(i)
+          : groups.data();
+      aggregate.function->extractAccumulators(
+          aggregateGroups, numGroups, &child);
+    }
+    // Columns not referenced by the aggregation.
+    for (auto i = 0; i < children.size(); ++i) {
+      if (children[i] == nullptr) {
+        children[i] = BaseVector::createNullConstant(
+            inputType->childAt(i), numGroups, &pool_);
+      }
+    }
+    partitions[partition].push_back(std::make_shared<RowVector>(
+        &pool_, inputType, nullptr, numGroups, std::move(children)));
+    groups.clear();
+  };
+
+  RowContainerIterator iter;
+  std::vector<char*> groups(maxBatchRows);
+  raw_vector<uint64_t> hashes(maxBatchRows);
+  int32_t numGroups;
+  while ((numGroups = rows.listRows(&iter, maxBatchRows, groups.data())) > 0) {
+    folly::Range<char**> groupRange(groups.data(), numGroups);
+    for (auto i = 0; i < numKeys; ++i) {
+      rows.hash(i, groupRange, i > 0, hashes.data());
+    }
+    for (auto i = 0; i < numGroups; ++i) {
+      const auto partition = hashes[i] % numPartitions;
+      partitionGroups[partition].push_back(groups[i]);
+      if (partitionGroups[partition].size() >= maxBatchRows) {
+        flush(partition);
+      }
+    }
+  }
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    flush(partition);
+  }
+  return partitions;
 }
 
 bool GroupingSet::isPartialFull(int64_t maxBytes) {
@@ -819,7 +959,10 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
 
 uint64_t GroupingSet::allocatedBytes() const {
   if (table_) {
-    return table_->allocatedBytes();
+    return table_->allocatedBytes() +
+        (columnarAccumulators_ != nullptr
+             ? columnarAccumulators_->allocatedBytes()
+             : 0);
   }
 
   return stringAllocator_.retainedSize() + rows_.allocatedBytes();
@@ -954,6 +1097,23 @@ RowTypePtr GroupingSet::makeSpillType() const {
   return ROW(std::move(names), std::move(types));
 }
 
+uint64_t GroupingSet::compactRows(
+    int32_t minFragmentationPct,
+    uint64_t targetBytes) {
+  if (table_ == nullptr || table_->numDistinct() == 0) {
+    return 0;
+  }
+  auto* rows = table_->rows();
+  const auto& allocator = rows->stringAllocator();
+  if (!rows->canCompactVariableWidthData() ||
+      allocator.fragmentation() * 100 < minFragmentationPct ||
+      allocator.freeSpace() < targetBytes) {
+    return 0;
+  }
+  return std::max<int64_t>(
+      0, rows->compactVariableWidthData(memory::spillMemoryPool()));
+}
+
 void GroupingSet::spill() {
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
@@ -996,6 +1156,7 @@ void GroupingSet::spill() {
   if (sortedAggregations_) {
     sortedAggregations_->clear();
   }
+  clearDistinctAggregations();
   table_->clear();
 }
 
@@ -1016,6 +1177,7 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
       spillStats_);
 
   spiller_->spill(rowIterator);
+  clearDistinctAggregations();
   table_->clear();
 }
 
@@ -1073,7 +1235,8 @@ bool GroupingSet::prepareNextSpillPartitionOutput() {
   auto it = spillPartitionSet_.begin();
   VELOX_CHECK_NE(outputSpillPartition_, it->first.partitionNumber());
   outputSpillPartition_ = it->first.partitionNumber();
-  merge_ = it->second->createOrderedReader(&pool_, spillStats_);
+  merge_ = it->second->createOrderedReader(
+      &pool_, spillStats_, spillConfig_->ioExecutor());
   spillPartitionSet_.erase(it);
   return true;
 }
@@ -1192,11 +1355,16 @@ void GroupingSet::initializeRow(SpillMergeStream& stream, char* row) {
     mergeRows_->store(stream.decoded(i), stream.currentIndex(), mergeState_, i);
   }
   vector_size_t zero = 0;
-  for (auto& aggregate : aggregates_) {
-    if (!aggregate.sortingKeys.empty()) {
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (!aggregates_[i].sortingKeys.empty()) {
       continue;
     }
-    aggregate.function->initializeNewGroups(
+    if (aggregates_[i].distinct) {
+      distinctAggregations_[i]->initializeNewGroups(
+          &row, folly::Range<const vector_size_t*>(&zero, 1));
+      continue;
+    }
+    aggregates_[i].function->initializeNewGroups(
         &row, folly::Range<const vector_size_t*>(&zero, 1));
   }
 
@@ -1214,6 +1382,7 @@ void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
         &iter, rows.size(), RowContainer::kUnlimited, rows.data());
   }
   extractGroups(folly::Range<char**>(rows.data(), rows.size()), result);
+  clearDistinctAggregations();
   mergeRows_->clear();
 }
 
@@ -1225,7 +1394,7 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
-    if (!aggregates_[i].sortingKeys.empty()) {
+    if (!aggregates_[i].sortingKeys.empty() || aggregates_[i].distinct) {
       continue;
     }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
@@ -1240,6 +1409,25 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
     sortedAggregations_->addSingleGroupSpillInput(
         row, vector, input.currentIndex());
   }
+
+  // The distinct aggregations are spilled after the aggregates and the
+  // sorted aggregations.
+  auto channel = keyChannels_.size() + aggregates_.size() +
+      (sortedAggregations_ != nullptr ? 1 : 0);
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->addSingleGroupSpillInput(
+          row, input.current().childAt(channel++), input.currentIndex());
+    }
+  }
+}
+
+void GroupingSet::clearDistinctAggregations() {
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->clear();
+    }
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
@@ -1265,6 +1453,7 @@ void GroupingSet::abandonPartialAggregation() {
       table_->rows()->stringAllocatorShared());
   initializeAggregates(aggregates_, *intermediateRows_, true);
   table_.reset();
+  columnarAccumulators_.reset();
 }
 
 namespace {
@@ -1374,6 +1563,10 @@ std::optional<int64_t> GroupingSet::estimateOutputRowSize() const {
   if (table_ == nullptr) {
     return std::nullopt;
   }
-  return table_->rows()->estimateRowSize();
+  auto rowSize = table_->rows()->estimateRowSize();
+  if (rowSize.has_value() && columnarAccumulators_ != nullptr) {
+    *rowSize += columnarAccumulators_->bytesPerGroup();
+  }
+  return rowSize;
 }
 } // namespace facebook::velox::exec
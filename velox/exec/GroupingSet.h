@@ -17,6 +17,7 @@
 
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
+#include "velox/exec/ColumnarAccumulators.h"
 #include "velox/exec/DistinctAggregations.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/SortedAggregations.h"
@@ -81,6 +82,30 @@ class GroupingSet {
   /// all the inputs.
   void resetTable();
 
+  /// Extracts the groups of a final aggregation as intermediate input to
+  /// another final aggregation with the same 'inputType'. The groups are
+  /// partitioned by the hash of the grouping keys into 'numPartitions' and
+  /// returned as vectors of at most 'maxBatchRows' rows for each partition.
+  /// The hash table is left as is. Must not be called after spilling.
+  std::vector<std::vector<RowVectorPtr>> extractIntermediatePartitions(
+      const RowTypePtr& inputType,
+      uint32_t numPartitions,
+      vector_size_t maxBatchRows);
+
+  /// Returns the number of runs of consecutive rows with equal grouping keys in
+  /// 'input'.
+  vector_size_t countGroupingKeyRuns(const RowVectorPtr& input) const;
+
+  /// Processes the following input as clustered on all the grouping keys, as
+  /// if they all were pre-grouped keys. Only valid for partial aggregations,
+  /// for which a group whose keys come back after a change of keys can be
+  /// output twice.
+  void setInputClusteredOnKeys() {
+    VELOX_CHECK(isPartial_);
+    VELOX_CHECK(!isGlobal_);
+    preGroupedKeyChannels_ = keyChannels_;
+  }
+
   /// Returns true if 'this' should start producing partial
   /// aggregation results. Checks the memory consumption against
   /// 'maxBytes'. If exceeding 'maxBytes', sees if changing hash mode
@@ -111,6 +136,12 @@ class GroupingSet {
   /// 'rowIterator'.
   void spill(const RowContainerIterator& rowIterator);
 
+  /// Moves the out-of-line keys of the rows in memory into fresh memory if at
+  /// least 'minFragmentationPct' percent of the string memory is in free blocks
+  /// and the free blocks add up to at least 'targetBytes'. Returns the number
+  /// of bytes freed, 0 if the rows were not compacted.
+  uint64_t compactRows(int32_t minFragmentationPct, uint64_t targetBytes);
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   std::optional<common::SpillStats> spilledStats() const {
     if (spiller_ == nullptr) {
@@ -263,6 +294,10 @@ class GroupingSet {
   // groups.
   void extractSpillResult(const RowVectorPtr& result);
 
+  // Frees the distinct inputs kept by 'distinctAggregations_'. Called when the
+  // groups they refer to are cleared.
+  void clearDistinctAggregations();
+
   // Return a list of accumulators for 'aggregates_', plus one more accumulator
   // for 'sortedAggregations_', and one for each 'distinctAggregations_'.  When
   // 'excludeToIntermediate' is true, skip the functions that support
@@ -272,7 +307,7 @@ class GroupingSet {
   std::vector<column_index_t> keyChannels_;
 
   /// A subset of grouping keys on which the input is clustered.
-  const std::vector<column_index_t> preGroupedKeyChannels_;
+  std::vector<column_index_t> preGroupedKeyChannels_;
 
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   const bool isGlobal_;
@@ -310,6 +345,10 @@ class GroupingSet {
   std::vector<VectorPtr> tempVectors_;
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
+
+  // Accumulators of the aggregates if they are kept outside of the rows of
+  // 'table_'. See QueryConfig::kAggregationColumnarAccumulators.
+  std::unique_ptr<ColumnarAccumulators> columnarAccumulators_;
   SelectivityVector activeRows_;
 
   // Used to allocate memory for a single row accumulating results of global
@@ -19,6 +19,30 @@
 #include "velox/expression/Expr.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns true if the drivers of 'node' can merge their groups by partition
+// after receiving all the input. Requires intermediate results as input, i.e.
+// a single input column for each aggregate.
+bool canMergeByPartition(
+    const core::AggregationNode& node,
+    const core::QueryConfig& config) {
+  if (!config.finalAggregationPartitionMerge() ||
+      node.step() != core::AggregationNode::Step::kFinal ||
+      node.groupingKeys().empty() || node.aggregates().empty() ||
+      !node.preGroupedKeys().empty() || !node.globalGroupingSets().empty() ||
+      node.groupId().has_value()) {
+    return false;
+  }
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty() ||
+        aggregate.call->inputs().size() != 1) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
 
 HashAggregation::HashAggregation(
     int32_t operatorId,
@@ -32,7 +56,9 @@ HashAggregation::HashAggregation(
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
               : "Aggregation",
-          aggregationNode->canSpill(driverCtx->queryConfig())
+          aggregationNode->canSpill(driverCtx->queryConfig()) &&
+                  !canMergeByPartition(
+                      *aggregationNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       aggregationNode_(aggregationNode),
@@ -46,7 +72,11 @@ HashAggregation::HashAggregation(
       abandonPartialAggregationMinPct_(
           driverCtx->queryConfig().abandonPartialAggregationMinPct()),
       maxPartialAggregationMemoryUsage_(
-          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()) {}
+          driverCtx->queryConfig().maxPartialAggregationMemoryUsage()),
+      compactionFragmentationPct_(driverCtx->queryConfig()
+                                      .aggregationCompactionFragmentationPct()),
+      partitionMerge_(
+          canMergeByPartition(*aggregationNode, driverCtx->queryConfig())) {}
 
 void HashAggregation::initialize() {
   Operator::initialize();
@@ -94,6 +124,20 @@ void HashAggregation::initialize() {
     VELOX_CHECK(groupIdChannel.has_value());
   }
 
+  if (partitionMerge_) {
+    // The groups are extracted into vectors of the input type. This needs a
+    // separate input column for each grouping key and aggregate.
+    std::unordered_set<column_index_t> channels;
+    for (const auto& hasher : hashers) {
+      partitionMerge_ &= channels.insert(hasher->channel()).second;
+    }
+    for (const auto& aggregateInfo : aggregateInfos) {
+      partitionMerge_ &= aggregateInfo.inputs.size() == 1 &&
+          channels.insert(aggregateInfo.inputs[0]).second;
+    }
+    inputType_ = inputType;
+  }
+
   groupingSet_ = std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
@@ -109,6 +153,13 @@ void HashAggregation::initialize() {
       operatorCtx_.get(),
       &spillStats_);
 
+  detectClusteredInput_ = isPartialOutput_ && !isGlobal_ && !isDistinct_ &&
+      aggregationNode_->preGroupedKeys().empty() &&
+      aggregationNode_->globalGroupingSets().empty() &&
+      operatorCtx_->driverCtx()
+          ->queryConfig()
+          .partialAggregationDetectClusteredInput();
+
   aggregationNode_.reset();
 }
 
@@ -130,6 +181,7 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
+  maybeDetectClusteredInput(input);
 
   updateRuntimeStats();
 
@@ -160,6 +212,34 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::maybeDetectClusteredInput(const RowVectorPtr& input) {
+  if (!detectClusteredInput_) {
+    return;
+  }
+  // Each run of equal keys starts a new group if the input is clustered,
+  // except for a run that continues the last run of the previous batch.
+  const auto numRuns = groupingSet_->countGroupingKeyRuns(input);
+  const auto numNewGroups = groupingSet_->hashLookup().newGroups.size();
+  if (static_cast<size_t>(numRuns) > numNewGroups + 1) {
+    detectClusteredInput_ = false;
+    return;
+  }
+  clusteredCheckRows_ += input->size();
+  clusteredCheckRuns_ += numRuns;
+  ++clusteredCheckBatches_;
+  if (clusteredCheckRows_ < kClusteredInputCheckRows) {
+    return;
+  }
+  detectClusteredInput_ = false;
+  // Not worthwhile if the batches have about one group each, the hash table
+  // stays small then.
+  if (clusteredCheckRuns_ <= clusteredCheckBatches_) {
+    return;
+  }
+  groupingSet_->setInputClusteredOnKeys();
+  stats_.wlock()->addRuntimeStat("clusteredInput", RuntimeCounter(1));
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -293,6 +373,10 @@ RowVectorPtr HashAggregation::getOutput() {
     return nullptr;
   }
 
+  if (partitionMerge_ && !mergeFinished_) {
+    finishPartitionMerge();
+  }
+
   if (isDistinct_) {
     return getDistinctOutput();
   }
@@ -381,12 +465,95 @@ RowVectorPtr HashAggregation::getDistinctOutput() {
 
 void HashAggregation::noMoreInput() {
   updateEstimatedOutputRowSize();
-  groupingSet_->noMoreInput();
+  if (!maybeStartPartitionMerge()) {
+    groupingSet_->noMoreInput();
+  }
   Operator::noMoreInput();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
 }
 
+bool HashAggregation::maybeStartPartitionMerge() {
+  if (!partitionMerge_) {
+    return false;
+  }
+  auto* driver = operatorCtx_->driver();
+  const auto numDrivers = operatorCtx_->task()->numDrivers(driver);
+  if (numDrivers == 1) {
+    partitionMerge_ = false;
+    return false;
+  }
+
+  mergePartitions_ = groupingSet_->extractIntermediatePartitions(
+      inputType_, numDrivers, outputBatchRows(estimatedOutputRowSize_));
+  groupingSet_->resetTable();
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), driver, &future_, promises, peers)) {
+    VELOX_CHECK(future_.valid());
+    return true;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not
+    // the last to finish) can continue from the barrier and merge their
+    // partitions.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  std::vector<HashAggregation*> aggregations{this};
+  aggregations.reserve(numDrivers);
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    aggregations.push_back(aggregation);
+  }
+  VELOX_CHECK_EQ(aggregations.size(), numDrivers);
+  for (auto* source : aggregations) {
+    VELOX_CHECK_EQ(source->mergePartitions_.size(), numDrivers);
+    for (auto partition = 0; partition < numDrivers; ++partition) {
+      auto& inputs = aggregations[partition]->mergeInputs_;
+      auto& vectors = source->mergePartitions_[partition];
+      inputs.insert(
+          inputs.end(),
+          std::make_move_iterator(vectors.begin()),
+          std::make_move_iterator(vectors.end()));
+    }
+    source->mergePartitions_.clear();
+  }
+  return true;
+}
+
+void HashAggregation::finishPartitionMerge() {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(!future_.valid());
+  uint64_t numMergedRows{0};
+  for (auto& input : mergeInputs_) {
+    numMergedRows += input->size();
+    groupingSet_->addInput(input, false);
+    input = nullptr;
+  }
+  mergeInputs_.clear();
+  groupingSet_->noMoreInput();
+  updateEstimatedOutputRowSize();
+  mergeFinished_ = true;
+  addRuntimeStat("partitionMergeRows", RuntimeCounter(numMergedRows));
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
 bool HashAggregation::isFinished() {
   return finished_;
 }
@@ -424,8 +591,18 @@ void HashAggregation::reclaim(
     // 'resultIterator_'.
     groupingSet_->spill(resultIterator_);
   } else {
-    // TODO: support fine-grain disk spilling based on 'targetBytes' after
-    // having row container memory compaction support later.
+    if (compactionFragmentationPct_ > 0) {
+      const auto compactedBytes = groupingSet_->compactRows(
+          compactionFragmentationPct_, targetBytes);
+      if (compactedBytes > 0) {
+        addRuntimeStat(
+            "compactedBytes",
+            RuntimeCounter(compactedBytes, RuntimeCounter::Unit::kBytes));
+        pool()->release();
+        return;
+      }
+    }
+    // TODO: support fine-grain disk spilling based on 'targetBytes'.
     groupingSet_->spill();
   }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
@@ -39,9 +39,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -72,8 +70,24 @@ class HashAggregation : public Operator {
 
   RowVectorPtr getDistinctOutput();
 
+  // Checks while 'detectClusteredInput_' is set whether the input is clustered
+  // on the grouping keys. Switches 'groupingSet_' to treat all the grouping
+  // keys as pre-grouped after 'kClusteredInputCheckRows' clustered rows.
+  void maybeDetectClusteredInput(const RowVectorPtr& input);
+
   void updateEstimatedOutputRowSize();
 
+  // Invoked on no more input to start the partition merge if
+  // 'partitionMerge_' is set. Extracts the groups of this driver by partition
+  // and waits for the peer drivers to do the same. The last driver to finish
+  // hands partition 'i' of all the drivers over to the i-th driver. Returns
+  // false if there is no merge to do.
+  bool maybeStartPartitionMerge();
+
+  // Adds the groups in 'mergeInputs_' from the peer drivers to
+  // 'groupingSet_'.
+  void finishPartitionMerge();
+
   std::shared_ptr<const core::AggregationNode> aggregationNode_;
 
   const bool isPartialOutput_;
@@ -88,6 +102,8 @@ class HashAggregation : public Operator {
   const int32_t abandonPartialAggregationMinPct_;
 
   int64_t maxPartialAggregationMemoryUsage_;
+  // See QueryConfig::kAggregationCompactionFragmentationPct.
+  const int32_t compactionFragmentationPct_;
   std::unique_ptr<GroupingSet> groupingSet_;
 
   // Size of a single output row estimated using
@@ -101,6 +117,18 @@ class HashAggregation : public Operator {
   // True if partial aggregation has been found to be non-reducing.
   bool abandonedPartialAggregation_{false};
 
+  // Number of input rows to check before deciding that the input is clustered
+  // on the grouping keys.
+  static constexpr int64_t kClusteredInputCheckRows = 10'000;
+
+  // True while checking whether the input of a partial aggregation is
+  // clustered on the grouping keys. See
+  // QueryConfig::kPartialAggregationDetectClusteredInput.
+  bool detectClusteredInput_{false};
+  int64_t clusteredCheckRows_{0};
+  int64_t clusteredCheckRuns_{0};
+  int64_t clusteredCheckBatches_{0};
+
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
   bool mayPushdown_ = false;
@@ -114,6 +142,22 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // True if the drivers of this final aggregation merge their groups by
+  // partition after receiving all the input. See
+  // QueryConfig::kFinalAggregationPartitionMerge.
+  bool partitionMerge_{false};
+  RowTypePtr inputType_;
+
+  // The groups of this driver by partition, extracted as intermediate input.
+  std::vector<std::vector<RowVectorPtr>> mergePartitions_;
+
+  // The groups of the partition to output, collected from all the drivers.
+  std::vector<RowVectorPtr> mergeInputs_;
+  bool mergeFinished_{false};
+
+  // Future for waiting for the peer drivers to extract their groups.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 };
 
 } // namespace facebook::velox::exec
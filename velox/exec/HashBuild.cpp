@@ -72,6 +72,7 @@ HashBuild::HashBuild(
   VELOX_CHECK_NOT_NULL(joinBridge_);
 
   joinBridge_->addBuilder();
+  maybeSetSpillRestoreChunking();
 
   auto inputType = joinNode_->sources()[1]->outputType();
 
@@ -112,6 +113,13 @@ HashBuild::HashBuild(
   }
 
   tableType_ = ROW(std::move(names), std::move(types));
+  if (canUseHashTableCache()) {
+    hashTableCacheEntry_ = HashTableCache::instance()->acquire(
+        operatorCtx_->task()->queryCtx().get(),
+        planNodeId(),
+        operatorCtx_->driverCtx()->splitGroupId,
+        taskId());
+  }
   setupTable();
   setupSpiller();
   stateCleared_ = false;
@@ -125,9 +133,19 @@ void HashBuild::initialize() {
   }
 }
 
+bool HashBuild::canUseHashTableCache() const {
+  return joinNode_->useHashTableCache() && !needRightSideJoin(joinType_) &&
+      !nullAware_ && !spillEnabled();
+}
+
 void HashBuild::setupTable() {
   VELOX_CHECK_NULL(table_);
 
+  // The builder of a shared table allocates it from the query level pool of
+  // the cache entry so that it outlives this task.
+  auto* tablePool = isHashTableCacheBuilder() ? hashTableCacheEntry_->pool()
+                                              : pool();
+
   const auto numKeys = keyChannels_.size();
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
   keyHashers.reserve(numKeys);
@@ -153,7 +171,7 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -173,7 +191,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -184,7 +202,10 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool);
+    }
+    if (dropDuplicates) {
+      table_->setMatchOnlyJoin();
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
@@ -197,10 +218,17 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   if (!spillEnabled()) {
     return;
   }
+  const auto* config = spillConfig();
   if (spillType_ == nullptr) {
-    spillType_ = hashJoinTableSpillType(tableType_, joinType_);
+    spillType_ = hashJoinTableSpillType(
+        tableType_, joinType_, config->joinSerializedRows);
+    if (isHashJoinTableSerializedSpillType(spillType_)) {
+      spillSerializedRowChannel_ = spillType_->size() - 1;
+      spillSerializedRowVector_ =
+          BaseVector::createNullConstant(VARBINARY(), 0, pool());
+    }
     if (needProbedFlagSpill_) {
-      spillProbedFlagChannel_ = spillType_->size() - 1;
+      spillProbedFlagChannel_ = tableType_->size();
       VELOX_CHECK_NULL(spillProbedFlagVector_);
       // Creates a constant probed flag vector with all values false for build
       // side table spilling.
@@ -209,7 +237,6 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
     }
   }
 
-  const auto* config = spillConfig();
   uint8_t startPartitionBit = config->startPartitionBit;
   if (spillPartition != nullptr) {
     spillInputReader_ =
@@ -247,6 +274,13 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   spillChildVectors_.resize(spillType_->size());
 }
 
+std::optional<int32_t> HashBuild::spillLevel() const {
+  if (spiller_ == nullptr) {
+    return std::nullopt;
+  }
+  return spillConfig()->spillLevel(spiller_->hashBits().begin());
+}
+
 bool HashBuild::isInputFromSpill() const {
   return spillInputReader_ != nullptr;
 }
@@ -317,6 +351,11 @@ void HashBuild::addInput(RowVectorPtr input) {
 
   TestValue::adjust("facebook::velox::exec::HashBuild::addInput", this);
 
+  if (hashTableCacheEntry_ != nullptr && !isHashTableCacheBuilder()) {
+    // The table is built by another task of the query.
+    return;
+  }
+
   activeRows_.resize(input->size());
   activeRows_.setAll();
 
@@ -404,9 +443,28 @@ void HashBuild::addInput(RowVectorPtr input) {
     spillProbedFlagVector =
         input->childAt(spillProbedFlagChannel_)->asFlatVector<bool>();
   }
+  // The rows spilled from a hash table are restored from their serialized
+  // form which also carries the probed flag. The rows spilled from the input
+  // have a null serialized row and are stored column by column.
+  const FlatVector<StringView>* spillSerializedRows{nullptr};
+  if (isInputFromSpill() && spillSerializedRowChannel_.has_value()) {
+    spillSerializedRowDecoder_.decode(
+        *input->childAt(spillSerializedRowChannel_.value()), activeRows_);
+    // NOTE: the column is a null constant if the whole batch is from input.
+    spillSerializedRows =
+        spillSerializedRowDecoder_.base()->asFlatVector<StringView>();
+  }
 
   activeRows_.applyToSelected([&](auto rowIndex) {
     char* newRow = rows->newRow();
+    if (spillSerializedRows != nullptr &&
+        !spillSerializedRowDecoder_.isNullAt(rowIndex)) {
+      rows->storeSerializedRow(
+          *spillSerializedRows,
+          spillSerializedRowDecoder_.index(rowIndex),
+          newRow);
+      return;
+    }
     // Store the columns for each row in sequence. At probe time
     // strings of the row will probably be in consecutive places, so
     // reading one will prime the cache for the next.
@@ -564,7 +622,12 @@ void HashBuild::maybeSetupSpillChildVectors(const RowVectorPtr& input) {
   if (needProbedFlagSpill_) {
     VELOX_CHECK_NOT_NULL(spillProbedFlagVector_);
     spillProbedFlagVector_->resize(input->size());
-    spillChildVectors_[spillChannel] = spillProbedFlagVector_;
+    spillChildVectors_[spillChannel++] = spillProbedFlagVector_;
+  }
+  if (spillSerializedRowChannel_.has_value()) {
+    VELOX_CHECK_NOT_NULL(spillSerializedRowVector_);
+    spillSerializedRowVector_->resize(input->size());
+    spillChildVectors_[spillChannel] = spillSerializedRowVector_;
   }
 }
 
@@ -670,6 +733,11 @@ bool HashBuild::finishHashBuild() {
     }
   });
 
+  if (hashTableCacheEntry_ != nullptr && !isHashTableCacheBuilder()) {
+    waitForCachedHashTable_ = true;
+    return attachCachedHashTable();
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -751,9 +819,39 @@ bool HashBuild::finishHashBuild() {
       BaseHashTable::kBuildWallNanos,
       RuntimeCounter(timing.wallNanos, RuntimeCounter::Unit::kNanos));
 
+  // Runtime Bloom filters are only pushed down if the probe side reads all
+  // the build side keys from a single table.
+  const auto bloomFilterMaxSize = operatorCtx_->driverCtx()
+                                      ->queryConfig()
+                                      .hashJoinBloomFilterMaxSize();
+  if (bloomFilterMaxSize > 0 && spillPartitions.empty() &&
+      !isInputFromSpill()) {
+    CpuWallTiming bloomFilterTiming;
+    {
+      CpuWallTimer cpuWallTimer{bloomFilterTiming};
+      table_->buildJoinKeyBloomFilters(bloomFilterMaxSize);
+    }
+    stats_.wlock()->addRuntimeStat(
+        BaseHashTable::kBloomFilterBuildWallNanos,
+        RuntimeCounter(
+            bloomFilterTiming.wallNanos, RuntimeCounter::Unit::kNanos));
+  }
+
+  table_->setRadixPartitionedProbe(operatorCtx_->driverCtx()
+                                       ->queryConfig()
+                                       .hashProbeRadixPartitioningEnabled());
+
   addRuntimeStats();
-  joinBridge_->setHashTable(
-      std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+  if (hashTableCacheEntry_ != nullptr) {
+    VELOX_CHECK(spillPartitions.empty());
+    joinBridge_->setHashTable(
+        hashTableCacheEntry_->setTable(std::move(table_), joinHasNullKeys_),
+        {},
+        joinHasNullKeys_);
+  } else {
+    joinBridge_->setHashTable(
+        std::move(table_), std::move(spillPartitions), joinHasNullKeys_);
+  }
   if (spillEnabled()) {
     stateCleared_ = true;
   }
@@ -769,6 +867,19 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+bool HashBuild::attachCachedHashTable() {
+  auto table = hashTableCacheEntry_->tableOrFuture(&future_);
+  if (table == nullptr) {
+    VELOX_CHECK(future_.valid());
+    setState(State::kWaitForBuild);
+    return false;
+  }
+  waitForCachedHashTable_ = false;
+  joinBridge_->setHashTable(
+      std::move(table), {}, hashTableCacheEntry_->hasNullKeys());
+  return true;
+}
+
 void HashBuild::ensureTableFits(uint64_t numRows) {
   // NOTE: we don't need memory reservation if all the partitions have been
   // spilled as nothing need to be built.
@@ -863,6 +974,9 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
     return;
   }
 
+  // Records the spill stats of the previous spill level before switching to
+  // the spill level of 'spillInput'.
+  recordSpillStats();
   table_.reset();
   spiller_.reset();
   spillInputReader_.reset();
@@ -967,6 +1081,9 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kWaitForProbe:
       if (!future_.valid()) {
         setRunning();
+        if (waitForCachedHashTable_ && !attachCachedHashTable()) {
+          break;
+        }
         postHashBuildProcess();
       }
       break;
@@ -1046,6 +1163,33 @@ std::string HashBuild::stateName(State state) {
   }
 }
 
+void HashBuild::maybeSetSpillRestoreChunking() {
+  if (!spillEnabled() || nullAware_) {
+    return;
+  }
+  // Only joins which produce the results of each build row independently of
+  // the other build rows can probe against a spill partition in chunks.
+  if (!isInnerJoin(joinType_) && !isRightJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return;
+  }
+  const auto chunkBytes = operatorCtx_->driverCtx()
+                              ->queryConfig()
+                              .hashJoinSpillRestoreChunkBytes();
+  if (chunkBytes == 0) {
+    return;
+  }
+  // Find the partition bit offset of the spill partitions for which
+  // setupSpiller() disables spilling on restore.
+  const auto* config = spillConfig();
+  uint8_t minChunkedBitOffset = config->startPartitionBit;
+  while (!config->exceedSpillLevelLimit(
+      minChunkedBitOffset + config->numPartitionBits)) {
+    minChunkedBitOffset += config->numPartitionBits;
+  }
+  joinBridge_->setSpillRestoreChunking(chunkBytes, minChunkedBitOffset);
+}
+
 bool HashBuild::canReclaim() const {
   return canSpill() && !operatorCtx_->task()->hasMixedExecutionGroup();
 }
@@ -1170,6 +1314,11 @@ bool HashBuild::nonReclaimableState() const {
 void HashBuild::close() {
   Operator::close();
 
+  if (isHashTableCacheBuilder()) {
+    // Wakes up the tasks waiting for a shared table this task never built.
+    hashTableCacheEntry_->abandon();
+  }
+
   {
     // Free up major memory usage. Gate access to them as they can be accessed
     // by the last build thread that finishes building the hash table.
@@ -1179,5 +1328,8 @@ void HashBuild::close() {
     spiller_.reset();
     table_.reset();
   }
+  // NOTE: the entry is released after 'table_' as the latter might be
+  // allocated from the entry's memory pool.
+  hashTableCacheEntry_.reset();
 }
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/Spiller.h"
@@ -88,6 +89,9 @@ class HashBuild final : public Operator {
 
   void close() override;
 
+ protected:
+  std::optional<int32_t> spillLevel() const override;
+
  private:
   void setState(State state);
   void checkStateTransition(State state);
@@ -105,6 +109,24 @@ class HashBuild final : public Operator {
   // merged from all the other drivers.
   bool finishHashBuild();
 
+  // Returns true if the build side table is shared with the other tasks of
+  // the query through the hash table cache. Join types which update the table
+  // while probing can't share it.
+  bool canUseHashTableCache() const;
+
+  // Returns true if this operator's task builds the shared hash table, false
+  // if it attaches to the one built by another task.
+  bool isHashTableCacheBuilder() const {
+    return hashTableCacheEntry_ != nullptr &&
+        hashTableCacheEntry_->builderTaskId() == taskId();
+  }
+
+  // Invoked by the last driver of a task which attaches to the hash table
+  // built by another task. Hands the shared table over to the probe side if it
+  // has been published, otherwise sets 'future_' to wait for it and returns
+  // false.
+  bool attachCachedHashTable();
+
   // Invoked after the hash table has been built. It waits for any spill data to
   // process after the probe side has finished processing the previously built
   // hash table. If disk spilling is not enabled or there is no more spill data,
@@ -132,6 +154,11 @@ class HashBuild final : public Operator {
   // in memory, then we will recursively spill part(s) of its data on disk.
   void setupSpiller(SpillPartition* spillPartition = nullptr);
 
+  // Invoked in ctor to have the join bridge restore the spill partitions which
+  // can't be spilled again in chunks if configured by
+  // QueryConfig::kHashJoinSpillRestoreChunkBytes.
+  void maybeSetSpillRestoreChunking();
+
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
   void noMoreInputInternal();
@@ -246,6 +273,14 @@ class HashBuild final : public Operator {
   // Container for the rows being accumulated.
   std::unique_ptr<BaseHashTable> table_;
 
+  // Set if the table is shared with the other tasks of the query. The builder
+  // task allocates 'table_' from the entry's pool so the table outlives it.
+  std::shared_ptr<HashTableCache::Entry> hashTableCacheEntry_;
+
+  // True while the last driver of a task attaching to the shared table waits
+  // for the builder task to publish it.
+  bool waitForCachedHashTable_{false};
+
   // Key channels in 'input_'
   std::vector<column_index_t> keyChannels_;
 
@@ -281,6 +316,14 @@ class HashBuild final : public Operator {
   column_index_t spillProbedFlagChannel_;
   // Used to set the probed flag vector at the build side which is always false.
   std::shared_ptr<ConstantVector<bool>> spillProbedFlagVector_;
+  // Specifies the column index in 'spillType_' which stores the serialized
+  // rows if the hash table is spilled as serialized rows.
+  std::optional<column_index_t> spillSerializedRowChannel_;
+  // Used to set the serialized row column for the spilled input rows which is
+  // always null as the input rows are spilled column by column.
+  VectorPtr spillSerializedRowVector_;
+  // Decodes the serialized row column of the input read from spill.
+  DecodedVector spillSerializedRowDecoder_;
 
   // This can be nullptr if either spilling is not allowed or it has been
   // transferred to the last hash build operator while in kWaitForBuild state or
@@ -19,6 +19,7 @@
 namespace facebook::velox::exec {
 namespace {
 static const char* kSpillProbedFlagColumnName = "__probedFlag";
+static const char* kSpillSerializedRowColumnName = "__serializedRow";
 }
 
 void HashJoinBridge::start() {
@@ -33,8 +34,18 @@ void HashJoinBridge::addBuilder() {
   ++numBuilders_;
 }
 
+void HashJoinBridge::setSpillRestoreChunking(
+    uint64_t chunkBytes,
+    uint8_t minChunkedBitOffset) {
+  VELOX_CHECK_GT(chunkBytes, 0);
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  spillRestoreChunkBytes_ = chunkBytes;
+  minChunkedBitOffset_ = minChunkedBitOffset;
+}
+
 void HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
@@ -65,7 +76,8 @@ void HashJoinBridge::setHashTable(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        pendingRestoreChunks_ != nullptr);
     restoringSpillPartitionId_.reset();
     promises = std::move(promises_);
   }
@@ -140,13 +152,29 @@ bool HashJoinBridge::probeFinished() {
     // table from the next spill partition now.
     buildResult_.reset();
 
-    if (!spillPartitionSets_.empty()) {
+    std::unique_ptr<SpillPartition> partition;
+    if (pendingRestoreChunks_ != nullptr) {
+      partition = std::move(pendingRestoreChunks_);
+    } else if (!spillPartitionSets_.empty()) {
+      partition = std::move(spillPartitionSets_.begin()->second);
+      spillPartitionSets_.erase(spillPartitionSets_.begin());
+    }
+    if (partition != nullptr) {
       hasSpillInput = true;
-      restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
-      restoringSpillShards_ =
-          spillPartitionSets_.begin()->second->split(numBuilders_);
+      restoringSpillPartitionId_ = partition->id();
+      if (spillRestoreChunkBytes_ > 0 &&
+          partition->id().partitionBitOffset() >= minChunkedBitOffset_ &&
+          partition->size() > spillRestoreChunkBytes_) {
+        // The partition can't be spilled again if it doesn't fit in memory.
+        // Restore it in chunks and probe the probe side partition against each.
+        auto chunk = partition->takeFiles(spillRestoreChunkBytes_);
+        if (partition->numFiles() > 0) {
+          pendingRestoreChunks_ = std::move(partition);
+        }
+        partition = std::move(chunk);
+      }
+      restoringSpillShards_ = partition->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
-      spillPartitionSets_.erase(spillPartitionSets_.begin());
     }
     promises = std::move(promises_);
   }
@@ -240,14 +268,24 @@ bool needRightSideJoin(core::JoinType joinType) {
 
 RowTypePtr hashJoinTableSpillType(
     const RowTypePtr& tableType,
-    core::JoinType joinType) {
-  if (!needRightSideJoin(joinType)) {
+    core::JoinType joinType,
+    bool serializedRows) {
+  // NOTE: the anti join build side filters its input rows on the dependent
+  // columns which are not set for the serialized rows.
+  serializedRows = serializedRows && !isAntiJoin(joinType);
+  if (!needRightSideJoin(joinType) && !serializedRows) {
     return tableType;
   }
   auto names = tableType->names();
-  names.push_back(kSpillProbedFlagColumnName);
   auto types = tableType->children();
-  types.push_back(BOOLEAN());
+  if (needRightSideJoin(joinType)) {
+    names.push_back(kSpillProbedFlagColumnName);
+    types.push_back(BOOLEAN());
+  }
+  if (serializedRows) {
+    names.push_back(kSpillSerializedRowColumnName);
+    types.push_back(VARBINARY());
+  }
   return ROW(std::move(names), std::move(types));
 }
 
@@ -257,10 +295,18 @@ bool isHashJoinTableSpillType(
   if (!needRightSideJoin(joinType)) {
     return true;
   }
-  const column_index_t probedColumnChannel = spillType->size() - 1;
+  const column_index_t probedColumnChannel = spillType->size() -
+      (isHashJoinTableSerializedSpillType(spillType) ? 2 : 1);
   if (!spillType->childAt(probedColumnChannel)->isBoolean()) {
     return false;
   }
   return spillType->nameOf(probedColumnChannel) == kSpillProbedFlagColumnName;
 }
+
+bool isHashJoinTableSerializedSpillType(const RowTypePtr& spillType) {
+  const column_index_t serializedRowChannel = spillType->size() - 1;
+  return spillType->childAt(serializedRowChannel)->kind() ==
+      TypeKind::VARBINARY &&
+      spillType->nameOf(serializedRowChannel) == kSpillSerializedRowColumnName;
+}
 } // namespace facebook::velox::exec
@@ -39,11 +39,19 @@ class HashJoinBridge : public JoinBridge {
   /// HashBuild operators to parallelize the restoring operation.
   void addBuilder();
 
+  /// Invoked by HashBuild operator ctor to restore a spilled partition in
+  /// chunks of spill files of about 'chunkBytes' if the partition has a
+  /// partition bit offset of at least 'minChunkedBitOffset', i.e. it can't be
+  /// spilled again. See QueryConfig::kHashJoinSpillRestoreChunkBytes.
+  void setSpillRestoreChunking(
+      uint64_t chunkBytes,
+      uint8_t minChunkedBitOffset);
+
   /// Invoked by the build operator to set the built hash table.
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table' which only applies if the disk spilling is enabled.
   void setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys);
 
@@ -66,11 +74,13 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        bool _hasMoreRestoreChunks = false)
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          hasMoreRestoreChunks(_hasMoreRestoreChunks) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -78,6 +88,10 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    /// True if 'table' is built from a chunk of the restored partition and
+    /// more chunks follow. The probe side then keeps its spilled partition to
+    /// read it again for the next chunk.
+    bool hasMoreRestoreChunks{false};
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -137,6 +151,18 @@ class HashJoinBridge : public JoinBridge {
   // memory and engages in recursive spilling.
   SpillPartitionSet spillPartitionSets_;
 
+  // Spill file bytes of a chunk when restoring a partition that can't be
+  // spilled again. 0 if such partitions are restored in full.
+  uint64_t spillRestoreChunkBytes_{0};
+
+  // The min partition bit offset of a spill partition that can't be spilled
+  // again.
+  uint8_t minChunkedBitOffset_{0};
+
+  // The remaining files of the partition being restored in chunks. Restored
+  // before any other partition in 'spillPartitionSets_'.
+  std::unique_ptr<SpillPartition> pendingRestoreChunks_;
+
   friend test::HashJoinBridgeTestHelper;
 };
 
@@ -176,13 +202,23 @@ bool needRightSideJoin(core::JoinType joinType);
 /// might attach a boolean column at the end of 'tableType' if 'joinType' needs
 /// right side join processing. It is used by the hash join table spilling
 /// triggered at the probe side to record if each row has been probed or not.
+/// If 'serializedRows' is true and 'joinType' is not an anti join, it also
+/// attaches a varbinary column at the end to store the rows spilled from the
+/// hash table as serialized RowContainer rows. The other columns are null for
+/// the serialized rows, except for the join keys which are needed to
+/// repartition the rows when spilling again.
 RowTypePtr hashJoinTableSpillType(
     const RowTypePtr& tableType,
-    core::JoinType joinType);
+    core::JoinType joinType,
+    bool serializedRows = false);
 
 /// Checks if a given type is a hash table spill type or not based on
 /// 'joinType'.
 bool isHashJoinTableSpillType(
     const RowTypePtr& spillType,
     core::JoinType joinType);
+
+/// Returns true if 'spillType' has the serialized row column attached by
+/// hashJoinTableSpillType().
+bool isHashJoinTableSerializedSpillType(const RowTypePtr& spillType);
 } // namespace facebook::velox::exec
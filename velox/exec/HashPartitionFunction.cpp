@@ -21,9 +21,16 @@ HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
     const RowTypePtr& inputType,
     const std::vector<column_index_t>& keyChannels,
-    const std::vector<VectorPtr>& constValues)
-    : numPartitions_{numPartitions} {
+    const std::vector<VectorPtr>& constValues,
+    bool spreadHotKeys)
+    : numPartitions_{numPartitions},
+      spreadHotKeys_{spreadHotKeys && numPartitions > 1} {
   init(inputType, keyChannels, constValues);
+  if (spreadHotKeys_) {
+    // Space-saving keeps all values more frequent than 1 / capacity, so a
+    // capacity above 'numPartitions' retains every hot key.
+    hotKeySummary_.setCapacity(std::max(64, 2 * numPartitions_));
+  }
 }
 
 HashPartitionFunction::HashPartitionFunction(
@@ -85,17 +92,58 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     }
   } else {
     for (auto i = 0; i < size; ++i) {
-      partitions[i] = hashes_[i] % numPartitions_;
+      partitions[i] = partitionModulo_.mod64(hashes_[i]);
     }
   }
 
+  if (spreadHotKeys_) {
+    spreadHotKeys(size, partitions);
+  }
+
   return std::nullopt;
 }
 
+void HashPartitionFunction::spreadHotKeys(
+    vector_size_t size,
+    std::vector<uint32_t>& partitions) {
+  for (auto i = 0; i < size; i += kHotKeySampleStride) {
+    hotKeySummary_.insert(hashes_[i]);
+    ++numSampledRows_;
+  }
+  if (numSampledRows_ >= nextHotKeysUpdate_) {
+    updateHotKeys();
+    nextHotKeysUpdate_ = numSampledRows_ + kMinHotKeySampledRows;
+  }
+  if (hotKeyHashes_.empty()) {
+    return;
+  }
+  for (auto i = 0; i < size; ++i) {
+    if (hotKeyHashes_.contains(hashes_[i])) {
+      partitions[i] = nextHotKeyPartition_;
+      if (++nextHotKeyPartition_ == numPartitions_) {
+        nextHotKeyPartition_ = 0;
+      }
+      ++numHotKeyRows_;
+    }
+  }
+}
+
+void HashPartitionFunction::updateHotKeys() {
+  hotKeyHashes_.clear();
+  const auto* values = hotKeySummary_.values();
+  const auto* counts = hotKeySummary_.counts();
+  for (auto i = 0; i < hotKeySummary_.size(); ++i) {
+    // A key is hot if it alone gets more rows than an average partition.
+    if (counts[i] * numPartitions_ > numSampledRows_) {
+      hotKeyHashes_.insert(values[i]);
+    }
+  }
+}
+
 std::unique_ptr<core::PartitionFunction> HashPartitionFunctionSpec::create(
     int numPartitions) const {
   return std::make_unique<exec::HashPartitionFunction>(
-      numPartitions, inputType_, keyChannels_, constValues_);
+      numPartitions, inputType_, keyChannels_, constValues_, spreadHotKeys_);
 }
 
 std::string HashPartitionFunctionSpec::toString() const {
@@ -113,7 +161,8 @@ std::string HashPartitionFunctionSpec::toString() const {
     }
   }
 
-  return fmt::format("HASH({})", keys.str());
+  return fmt::format(
+      "HASH({}){}", keys.str(), spreadHotKeys_ ? " SPREAD_HOT_KEYS" : "");
 }
 
 folly::dynamic HashPartitionFunctionSpec::serialize() const {
@@ -128,6 +177,9 @@ folly::dynamic HashPartitionFunctionSpec::serialize() const {
     constValues.emplace_back(value);
   }
   obj["constants"] = ISerializable::serialize(constValues);
+  if (spreadHotKeys_) {
+    obj["spreadHotKeys"] = spreadHotKeys_;
+  }
   return obj;
 }
 
@@ -147,7 +199,12 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
   for (const auto& value : constTypeExprs) {
     constValues.emplace_back(value->toConstantVector(pool));
   }
+  const bool spreadHotKeys =
+      obj.count("spreadHotKeys") ? obj["spreadHotKeys"].asBool() : false;
   return std::make_shared<HashPartitionFunctionSpec>(
-      ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      constValues,
+      spreadHotKeys);
 }
 } // namespace facebook::velox::exec
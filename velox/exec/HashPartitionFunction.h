@@ -17,7 +17,9 @@
 
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
+#include "velox/common/base/FastModulo.h"
 #include "velox/core/PlanNode.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -27,13 +29,21 @@ namespace facebook::velox::exec {
 /// numPartitions allows the keyChannels argument to be empty. If keyChannels is
 /// empty, then the resulting partition number of partition() will always be
 /// zero.
+///
+/// If 'spreadHotKeys' is true, the function samples the key hashes to find
+/// the keys which alone account for more than an average partition's share of
+/// the rows and assigns the rows with these keys round-robin instead of by
+/// hash. This is only correct if the consumers don't need all the rows of a
+/// key in one partition, e.g. the probe side of a hash join whose drivers all
+/// probe the same table, or whose build side is broadcast.
 class HashPartitionFunction : public core::PartitionFunction {
  public:
   HashPartitionFunction(
       int numPartitions,
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
-      const std::vector<VectorPtr>& constValues = {});
+      const std::vector<VectorPtr>& constValues = {},
+      bool spreadHotKeys = false);
 
   HashPartitionFunction(
       const HashBitRange& hashBitRange,
@@ -51,16 +61,44 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
+  /// Returns the number of rows assigned round-robin because of a hot key.
+  uint64_t numHotKeyRows() const {
+    return numHotKeyRows_;
+  }
+
+  /// One in this many rows is sampled for hot key detection.
+  static constexpr int32_t kHotKeySampleStride = 16;
+  /// The minimum number of sampled rows before any key is considered hot.
+  static constexpr int64_t kMinHotKeySampledRows = 1'024;
+
  private:
   void init(
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
       const std::vector<VectorPtr>& constValues);
 
+  // Samples 'hashes_' and reassigns the rows with hot keys in 'partitions'.
+  void spreadHotKeys(vector_size_t size, std::vector<uint32_t>& partitions);
+
+  // Recomputes 'hotKeyHashes_' from 'hotKeySummary_'.
+  void updateHotKeys();
+
   const int numPartitions_;
+  // Takes the hashes modulo 'numPartitions_'.
+  const FastModulo partitionModulo_{static_cast<uint32_t>(numPartitions_)};
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
+  const bool spreadHotKeys_{false};
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
+  // Approximate frequencies of the sampled key hashes.
+  functions::ApproxMostFrequentStreamSummary<uint64_t> hotKeySummary_;
+  int64_t numSampledRows_{0};
+  // Value of 'numSampledRows_' at which to recompute 'hotKeyHashes_'.
+  int64_t nextHotKeysUpdate_{kMinHotKeySampledRows};
+  folly::F14FastSet<uint64_t> hotKeyHashes_;
+  uint32_t nextHotKeyPartition_{0};
+  uint64_t numHotKeyRows_{0};
+
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
@@ -76,10 +114,12 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   HashPartitionFunctionSpec(
       RowTypePtr inputType,
       std::vector<column_index_t> keyChannels,
-      std::vector<VectorPtr> constValues = {})
+      std::vector<VectorPtr> constValues = {},
+      bool spreadHotKeys = false)
       : inputType_{std::move(inputType)},
         keyChannels_{std::move(keyChannels)},
-        constValues_{std::move(constValues)} {}
+        constValues_{std::move(constValues)},
+        spreadHotKeys_{spreadHotKeys} {}
 
   std::unique_ptr<core::PartitionFunction> create(
       int numPartitions) const override;
@@ -96,5 +136,6 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
+  const bool spreadHotKeys_;
 };
 } // namespace facebook::velox::exec
@@ -124,6 +124,7 @@ HashProbe::HashProbe(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
+      outputBatchBytes_{driverCtx->queryConfig().preferredOutputBatchBytes()},
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
@@ -266,7 +267,8 @@ void HashProbe::maybeSetupInputSpiller(
 }
 
 void HashProbe::maybeSetupSpillInputReader(
-    const std::optional<SpillPartitionId>& restoredPartitionId) {
+    const std::optional<SpillPartitionId>& restoredPartitionId,
+    bool hasMoreRestoreChunks) {
   VELOX_CHECK_NULL(spillInputReader_);
   if (!restoredPartitionId.has_value()) {
     return;
@@ -276,8 +278,16 @@ void HashProbe::maybeSetupSpillInputReader(
   // the corresponding spilled probe partition on disk.
   auto iter = spillPartitionSet_.find(restoredPartitionId.value());
   VELOX_CHECK(iter != spillPartitionSet_.end());
+  VELOX_CHECK_EQ(iter->second->id(), restoredPartitionId.value());
+  if (hasMoreRestoreChunks) {
+    // 'table_' is built from a chunk of the spilled build partition. Keep the
+    // probe partition to probe against the following chunks.
+    auto partition = std::make_unique<SpillPartition>(*iter->second);
+    spillInputReader_ = partition->createUnorderedReader(pool(), &spillStats_);
+    addRuntimeStat("spillRestoreChunks", RuntimeCounter(1));
+    return;
+  }
   auto partition = std::move(iter->second);
-  VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
   spillInputReader_ = partition->createUnorderedReader(pool(), &spillStats_);
   spillPartitionSet_.erase(iter);
 }
@@ -309,8 +319,11 @@ void HashProbe::asyncWaitForHashTable() {
 
   table_ = std::move(hashBuildResult->table);
   VELOX_CHECK_NOT_NULL(table_);
+  initializeResultIter();
 
-  maybeSetupSpillInputReader(hashBuildResult->restoredPartitionId);
+  maybeSetupSpillInputReader(
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->hasMoreRestoreChunks);
   maybeSetupInputSpiller(hashBuildResult->spillPartitionIds);
   prepareTableSpill(hashBuildResult->restoredPartitionId);
 
@@ -330,16 +343,19 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept dynamic
     // filters on all or a subset of the join keys. Create dynamic filters to
-    // push down.
+    // push down. The filters are exact if the keys are in array or normalized
+    // key hash mode and have few distinct values. Otherwise, use the Bloom
+    // filters built by HashBuild, if any.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
+    const bool exactFilters =
+        table_->hashMode() != BaseHashTable::HashMode::kHash;
     const auto& buildHashers = table_->hashers();
     const auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
@@ -349,11 +365,21 @@ void HashProbe::asyncWaitForHashTable() {
     const auto nullAllowed = isRightSemiProjectJoin(joinType_) && nullAware_;
 
     for (auto i = 0; i < keyChannels_.size(); ++i) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      if (exactFilters) {
         if (auto filter = buildHashers[i]->getFilter(nullAllowed)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+          continue;
         }
       }
+      if (auto filter = table_->joinKeyBloomFilter(i)) {
+        dynamicFilters_.emplace(
+            keyChannels_[i],
+            nullAllowed ? std::shared_ptr<common::Filter>(filter->clone(true))
+                        : std::move(filter));
+      }
     }
     hasGeneratedDynamicFilters_ = !dynamicFilters_.empty();
   }
@@ -535,15 +561,32 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down filter when the
   // following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBigintValuesUsingBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
   Operator::clearDynamicFilters();
 }
 
+void HashProbe::initializeResultIter() {
+  const auto& columnTypes = table_->rows()->columnTypes();
+  results_.varSizeListColumns.clear();
+  results_.fixedSizeListColumns = 0;
+  for (const auto& projection : tableOutputProjections_) {
+    const auto& type = columnTypes[projection.inputChannel];
+    if (type->isFixedWidth()) {
+      results_.fixedSizeListColumns += type->cppSizeInBytes();
+    } else {
+      results_.varSizeListColumns.push_back(projection.inputChannel);
+    }
+  }
+}
+
 void HashProbe::decodeAndDetectNonNullKeys() {
   nonNullInputRows_.resize(input_->size());
   nonNullInputRows_.setAll();
@@ -819,8 +862,14 @@ void HashProbe::clearIdentityProjectedOutput() {
   if (!output_ || !output_.unique()) {
     return;
   }
+  auto* vectorPool = operatorCtx_->execCtx()->vectorPool();
   for (auto& projection : identityProjections_) {
-    output_->childAt(projection.outputChannel) = nullptr;
+    auto& child = output_->childAt(projection.outputChannel);
+    if (vectorPool != nullptr) {
+      // Keeps the buffers of the dictionary wrappers for future batches.
+      vectorPool->releaseBuffers(child);
+    }
+    child = nullptr;
   }
 }
 
@@ -902,6 +951,7 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
   }
 
   clearIdentityProjectedOutput();
+  outputBatchSize_ = outputBatchRows();
 
   if (!input_) {
     if (!hasMoreInput()) {
@@ -958,8 +1008,11 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
   auto outputBatchSize = (isLeftSemiOrAntiJoinNoFilter || emptyBuildSide)
       ? inputSize
       : outputBatchSize_;
-  auto mapping =
-      initializeRowNumberMapping(outputRowMapping_, outputBatchSize, pool());
+  auto mapping = initializeRowNumberMapping(
+      outputRowMapping_,
+      outputBatchSize,
+      pool(),
+      operatorCtx_->execCtx()->vectorPool());
   outputTableRows_.resize(outputBatchSize);
 
   for (;;) {
@@ -997,7 +1050,8 @@ RowVectorPtr HashProbe::getOutputInternal(bool toSpillOutput) {
           results_,
           joinIncludesMissesFromLeft(joinType_),
           mapping,
-          folly::Range(outputTableRows_.data(), outputTableRows_.size()));
+          folly::Range(outputTableRows_.data(), outputTableRows_.size()),
+          outputBatchBytes_);
     }
 
     // We are done processing the input batch if there are no more joined rows
@@ -1883,7 +1937,9 @@ void HashProbe::prepareTableSpill(
     }
   }
   tableSpillType_ = hashJoinTableSpillType(
-      ROW(std::move(names), std::move(types)), joinType_);
+      ROW(std::move(names), std::move(types)),
+      joinType_,
+      config->joinSerializedRows);
 }
 
 void HashProbe::close() {
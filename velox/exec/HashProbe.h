@@ -51,6 +51,13 @@ class HashProbe : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  /// Inner and left joins produce the output for each probe row from that row
+  /// and the build side only. The other join types emit build rows depending
+  /// on the matches of all probe rows, or mark probe rows based on them.
+  bool isRowIndependent() const override {
+    return isInnerJoin(joinType_) || isLeftJoin(joinType_);
+  }
+
   void noMoreInput() override;
 
   RowVectorPtr getOutput() override;
@@ -93,6 +100,10 @@ class HashProbe : public Operator {
   // the hash table.
   void asyncWaitForHashTable();
 
+  // Sets up the columns 'results_' uses to estimate the output bytes of the
+  // hits in 'table_'.
+  void initializeResultIter();
+
   // Sets up 'filter_' and related members.p
   void initializeFilter(
       const core::TypedExprPtr& filter,
@@ -190,9 +201,12 @@ class HashProbe : public Operator {
   void maybeSetupInputSpiller(const SpillPartitionIdSet& spillPartitionIds);
 
   // If 'restoredSpillPartitionId' is set, then setup 'spillInputReader_' to
-  // read probe inputs from spilled data on disk.
+  // read probe inputs from spilled data on disk. If 'hasMoreRestoreChunks' is
+  // true, the spilled probe partition is kept to probe the next chunk of the
+  // restored build partition.
   void maybeSetupSpillInputReader(
-      const std::optional<SpillPartitionId>& restoredSpillPartitionId);
+      const std::optional<SpillPartitionId>& restoredSpillPartitionId,
+      bool hasMoreRestoreChunks);
 
   // Prepares the table spill by checking the spill level limit, setting spill
   // partition bits and table spill type.
@@ -302,8 +316,13 @@ class HashProbe : public Operator {
 
   //  std::vector<Operator*> findPeerOperators();
 
-  // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Maximum number of rows in the output batch. Updated before each batch if
+  // QueryConfig::kAdaptiveOutputBatchSizeEnabled is set.
+  uint32_t outputBatchSize_;
+
+  // Limit on the estimated bytes of the build side columns in one output
+  // batch. Caps the output of a probe row with many matches.
+  const uint64_t outputBatchBytes_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -22,6 +22,7 @@
 #include "velox/common/process/ProcessBase.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/VectorTypeUtils.h"
 
@@ -222,11 +223,18 @@ class ProbeState {
         "Have looped through all the buckets in table: {}", table.toString());
   }
 
+  // 'highKeys' is null unless the table has two word normalized keys.
   template <typename Table>
   FOLLY_ALWAYS_INLINE char* joinNormalizedKeyFullProbe(
       const Table& table,
-      const uint64_t* keys) {
-    if (group_ && RowContainer::normalizedKey(group_) == keys[row_]) {
+      const uint64_t* keys,
+      const uint64_t* highKeys) {
+    auto matches = [&](char* group) INLINE_LAMBDA {
+      return RowContainer::normalizedKey(group) == keys[row_] &&
+          (highKeys == nullptr ||
+           RowContainer::normalizedKeyHigh(group) == highKeys[row_]);
+    };
+    if (group_ && matches(group_)) {
       table.incrementHits();
       return group_;
     }
@@ -241,7 +249,7 @@ class ProbeState {
       } else {
         loadNextHit<Operation::kProbe>(
             table, -static_cast<int32_t>(sizeof(normalized_key_t)));
-        if (RowContainer::normalizedKey(group_) == keys[row_]) {
+        if (matches(group_)) {
           table.incrementHits();
           return group_;
         }
@@ -340,6 +348,10 @@ char* HashTable<ignoreNullKeys>::insertEntry(
     // the word below the row. Space was reserved in the allocation
     // unless we have given up on normalized keys.
     RowContainer::normalizedKey(group) = lookup.normalizedKeys[row]; // NOLINT
+    if (hasTwoWordNormalizedKeys()) {
+      RowContainer::normalizedKeyHigh(group) =
+          lookup.normalizedKeysHigh[row]; // NOLINT
+    }
   }
   ++numDistinct_;
   lookup.newGroups.push_back(row);
@@ -394,7 +406,10 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
         -static_cast<int32_t>(sizeof(normalized_key_t)),
         [&](char* group, int32_t row) INLINE_LAMBDA {
           return RowContainer::normalizedKey(group) ==
-              lookup.normalizedKeys[row];
+              lookup.normalizedKeys[row] &&
+              (!hasTwoWordNormalizedKeys() ||
+               RowContainer::normalizedKeyHigh(group) ==
+                   lookup.normalizedKeysHigh[row]);
         },
         [&](int32_t row, uint64_t index) {
           return isJoin ? nullptr : insertEntry(lookup, index, row);
@@ -419,6 +434,22 @@ namespace {
 // Group prefetch size for join build & probe.
 constexpr int32_t kPrefetchSize = 64;
 
+// Minimum size in bytes of the bucket array of a kHash mode join table for
+// probing with group prefetch. Smaller tables are expected to be in cache.
+constexpr int64_t kPrefetchProbeMinTableBytes = 4 << 20;
+
+// Target size in bytes of the region of the bucket array hit by the probes of
+// one radix partition. Corresponds to a typical L2 cache.
+constexpr int32_t kRadixPartitionRegionBits = 20;
+
+// Upper bound on the radix partition bits for a join probe. Limits the size
+// of the partition counters.
+constexpr int32_t kMaxRadixPartitionBits = 10;
+
+// Minimum expected number of probe rows per radix partition. There is no
+// locality gain from partitioning with fewer.
+constexpr int32_t kMinRowsPerRadixPartition = 16;
+
 // Normalized keys have non0-random bits. Bits need to be propagated
 // up to make a tag byte and down so that non-lowest bits of
 // normalized key affect the hash table index.
@@ -426,25 +457,49 @@ inline uint64_t mixNormalizedKey(uint64_t k, uint8_t bits) {
   return folly::hasher<uint64_t>()(k);
 }
 
-void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
+// Mixes both words of a two word normalized key.
+inline uint64_t mixNormalizedKey(uint64_t low, uint64_t high) {
+  return folly::hash::hash_128_to_64(low, high);
+}
+
+template <bool twoWords>
+void populateNormalizedKeysImpl(HashLookup& lookup, int8_t sizeBits) {
   lookup.normalizedKeys.resize(lookup.rows.back() + 1);
   uint64_t* __restrict hashes = lookup.hashes.data();
   uint64_t* __restrict keys = lookup.normalizedKeys.data();
+  const uint64_t* __restrict highKeys =
+      twoWords ? lookup.normalizedKeysHigh.data() : nullptr;
+  auto populate = [&](auto row) INLINE_LAMBDA {
+    auto hash = hashes[row];
+    keys[row] = hash; // NOLINT
+    if constexpr (twoWords) {
+      hashes[row] = mixNormalizedKey(hash, highKeys[row]);
+    } else {
+      hashes[row] = mixNormalizedKey(hash, sizeBits);
+    }
+  };
   int32_t end = lookup.rows.back() + 1;
   if (end / 4 < lookup.rows.size()) {
     // For more than 1/4 of the positions in use, run the loop on all
     // elements, since the loop will do 4 at a time.
     for (auto row = 0; row < end; ++row) {
-      auto hash = hashes[row];
-      keys[row] = hash; // NOLINT
-      hashes[row] = mixNormalizedKey(hash, sizeBits);
+      populate(row);
     }
     return;
   }
   for (auto row : lookup.rows) {
-    auto hash = hashes[row];
-    keys[row] = hash; // NOLINT
-    hashes[row] = mixNormalizedKey(hash, sizeBits);
+    populate(row);
+  }
+}
+
+void populateNormalizedKeys(
+    HashLookup& lookup,
+    int8_t sizeBits,
+    bool twoWords) {
+  if (twoWords) {
+    populateNormalizedKeysImpl<true>(lookup, sizeBits);
+  } else {
+    populateNormalizedKeysImpl<false>(lookup, sizeBits);
   }
 }
 } // namespace
@@ -461,7 +516,7 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   // because the size of the table affects the mixing.
   checkSize(lookup.rows.size(), false);
   if (hashMode_ == HashMode::kNormalizedKey) {
-    populateNormalizedKeys(lookup, sizeBits_);
+    populateNormalizedKeys(lookup, sizeBits_, hasTwoWordNormalizedKeys());
     groupNormalizedKeyProbe(lookup);
     return;
   }
@@ -591,12 +646,20 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
   if (hashMode_ == HashMode::kArray) {
-    arrayJoinProbe(lookup);
+    if (arrayMatchBits_) {
+      arrayMatchJoinProbe(lookup);
+    } else {
+      arrayJoinProbe(lookup);
+    }
     return;
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
-    populateNormalizedKeys(lookup, sizeBits_);
-    joinNormalizedKeyProbe(lookup);
+    populateNormalizedKeys(lookup, sizeBits_, hasTwoWordNormalizedKeys());
+    joinNormalizedKeyProbe(lookup, joinProbeRows(lookup));
+    return;
+  }
+  if (capacity_ * tableSlotSize() >= kPrefetchProbeMinTableBytes) {
+    joinPrefetchProbe(lookup, joinProbeRows(lookup));
     return;
   }
   int32_t probeIndex = 0;
@@ -632,6 +695,65 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+const raw_vector<vector_size_t>& HashTable<ignoreNullKeys>::joinProbeRows(
+    HashLookup& lookup) const {
+  if (!radixPartitionedProbe_) {
+    return lookup.rows;
+  }
+  const int32_t numRows = lookup.rows.size();
+  // The partition bits are the high bits of the byte offset of the bucket so
+  // that each partition maps to a contiguous region of the table.
+  const int32_t numBits = std::min<int32_t>(
+      {sizeBits_ - kRadixPartitionRegionBits,
+       kMaxRadixPartitionBits,
+       63 -
+           bits::countLeadingZeros<uint64_t>(
+               std::max(1, numRows / kMinRowsPerRadixPartition))});
+  if (numBits <= 0) {
+    return lookup.rows;
+  }
+  const HashBitRange bitRange(sizeBits_ - numBits, sizeBits_);
+  const uint64_t* hashes = lookup.hashes.data();
+  std::array<int32_t, (1 << kMaxRadixPartitionBits) + 1> offsets{};
+  for (auto row : lookup.rows) {
+    ++offsets[bitRange.partition(hashes[row]) + 1];
+  }
+  for (auto i = 1; i <= bitRange.numPartitions(); ++i) {
+    offsets[i] += offsets[i - 1];
+  }
+  lookup.partitionedRows.resize(numRows);
+  for (auto row : lookup.rows) {
+    lookup.partitionedRows[offsets[bitRange.partition(hashes[row])]++] = row;
+  }
+  return lookup.partitionedRows;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinPrefetchProbe(
+    HashLookup& lookup,
+    const raw_vector<vector_size_t>& probeRows) {
+  const int32_t numProbes = probeRows.size();
+  const vector_size_t* rows = probeRows.data();
+  ProbeState states[kPrefetchSize];
+  for (int32_t probeIndex = 0; probeIndex < numProbes;
+       probeIndex += kPrefetchSize) {
+    const int32_t numStates =
+        std::min<int32_t>(kPrefetchSize, numProbes - probeIndex);
+    for (int32_t i = 0; i < numStates; ++i) {
+      const int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, lookup.hashes[row], row);
+    }
+    for (int32_t i = 0; i < numStates; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    for (int32_t i = 0; i < numStates; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
+  }
+  numPrefetchProbes_.fetch_add(numProbes, std::memory_order_relaxed);
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   // Rows are nearly always consecutive.
@@ -675,12 +797,28 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 }
 
 template <bool ignoreNullKeys>
-void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
+void HashTable<ignoreNullKeys>::arrayMatchJoinProbe(HashLookup& lookup) {
+  const auto* hashes = lookup.hashes.data();
+  auto* hits = lookup.hits.data();
+  for (const auto row : lookup.rows) {
+    const auto index = hashes[row];
+    VELOX_DCHECK_LT(index, capacity_);
+    hits[row] = bits::isBitSet(arrayMatchBits_, index) ? arrayMatchHit_
+                                                       : nullptr; // NOLINT
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(
+    HashLookup& lookup,
+    const raw_vector<vector_size_t>& probeRows) {
   int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  int32_t numProbes = probeRows.size();
+  const vector_size_t* rows = probeRows.data();
   ProbeState states[kPrefetchSize];
   const uint64_t* keys = lookup.normalizedKeys.data();
+  const uint64_t* highKeys =
+      hasTwoWordNormalizedKeys() ? lookup.normalizedKeysHigh.data() : nullptr;
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
   constexpr int32_t kKeyOffset =
@@ -694,14 +832,15 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
       states[i].firstProbe(*this, kKeyOffset);
     }
     for (int32_t i = 0; i < kPrefetchSize; ++i) {
-      hits[states[i].row()] = states[i].joinNormalizedKeyFullProbe(*this, keys);
+      hits[states[i].row()] =
+          states[i].joinNormalizedKeyFullProbe(*this, keys, highKeys);
     }
   }
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     states[0].preProbe(*this, lookup.hashes[row], row);
     states[0].firstProbe(*this, 0);
-    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
+    hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys, highKeys);
   }
 }
 
@@ -738,6 +877,7 @@ void HashTable<ignoreNullKeys>::clear(bool freeTable) {
   for (auto* rowContainer : allRows()) {
     rowContainer->clear();
   }
+  clearArrayJoinLayout();
   if (table_) {
     if (!freeTable) {
       // All modes have 8 bytes per slot.
@@ -797,12 +937,19 @@ bool HashTable<ignoreNullKeys>::hashRows(
   }
   if (!initNormalizedKeys && hashMode_ == HashMode::kNormalizedKey) {
     for (auto i = 0; i < rows.size(); ++i) {
-      hashes[i] =
-          mixNormalizedKey(RowContainer::normalizedKey(rows[i]), sizeBits_);
+      hashes[i] = normalizedKeyHash(rows[i]);
     }
     return true;
   }
 
+  // Receives the value ids of the key parts of the high word of two word
+  // normalized keys.
+  raw_vector<uint64_t> highValueIds;
+  const bool twoWords = hashMode_ == HashMode::kNormalizedKey &&
+      hasTwoWordNormalizedKeys();
+  if (twoWords) {
+    highValueIds.resize(rows.size());
+  }
   for (int32_t i = 0; i < hashers_.size(); ++i) {
     auto& hasher = hashers_[i];
     if (hashMode_ == HashMode::kHash) {
@@ -816,7 +963,8 @@ bool HashTable<ignoreNullKeys>::hashRows(
               column.offset(),
               column.nullByte(),
               ignoreNullKeys ? 0 : column.nullMask(),
-              hashes)) {
+              twoWords && i >= normalizedKeyHighStart_ ? highValueIds
+                                                       : hashes)) {
         // Must reconsider 'hashMode_' and start over.
         return false;
       }
@@ -825,12 +973,26 @@ bool HashTable<ignoreNullKeys>::hashRows(
   if (hashMode_ == HashMode::kNormalizedKey && initNormalizedKeys) {
     for (auto i = 0; i < rows.size(); ++i) {
       RowContainer::normalizedKey(rows[i]) = hashes[i];
-      hashes[i] = mixNormalizedKey(hashes[i], sizeBits_);
+      if (twoWords) {
+        RowContainer::normalizedKeyHigh(rows[i]) = highValueIds[i];
+        hashes[i] = mixNormalizedKey(hashes[i], highValueIds[i]);
+      } else {
+        hashes[i] = mixNormalizedKey(hashes[i], sizeBits_);
+      }
     }
   }
   return true;
 }
 
+template <bool ignoreNullKeys>
+uint64_t HashTable<ignoreNullKeys>::normalizedKeyHash(char* row) const {
+  if (hasTwoWordNormalizedKeys()) {
+    return mixNormalizedKey(
+        RowContainer::normalizedKey(row), RowContainer::normalizedKeyHigh(row));
+  }
+  return mixNormalizedKey(RowContainer::normalizedKey(row), sizeBits_);
+}
+
 namespace {
 template <typename Source>
 void syncWorkItems(
@@ -1178,7 +1340,10 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::buildFullProbe(
         kKeyOffset,
         [&](char* group, int32_t /*row*/) {
           if (RowContainer::normalizedKey(group) ==
-              RowContainer::normalizedKey(inserted)) {
+                  RowContainer::normalizedKey(inserted) &&
+              (!hasTwoWordNormalizedKeys() ||
+               RowContainer::normalizedKeyHigh(group) ==
+                   RowContainer::normalizedKeyHigh(inserted))) {
             if (nextOffset_) {
               pushNext(rows, group, inserted);
             }
@@ -1309,6 +1474,9 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   VELOX_CHECK_NE(hashMode_, HashMode::kHash);
   TestValue::adjust("facebook::velox::exec::HashTable::setHashMode", &mode);
+  if (mode != HashMode::kNormalizedKey) {
+    normalizedKeyHighStart_ = 0;
+  }
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
@@ -1436,10 +1604,15 @@ uint64_t HashTable<ignoreNullKeys>::setHasherMode(
     const std::vector<std::unique_ptr<VectorHasher>>& hashers,
     const std::vector<bool>& useRange,
     const std::vector<uint64_t>& rangeSizes,
-    const std::vector<uint64_t>& distinctSizes) {
+    const std::vector<uint64_t>& distinctSizes,
+    int32_t highStart) {
   uint64_t multiplier = 1;
   // A group by leaves 50% space for values not yet seen.
   for (int i = 0; i < hashers.size(); ++i) {
+    if (i == highStart && i > 0) {
+      // The high word of a two word normalized key starts over.
+      multiplier = 1;
+    }
     multiplier = useRange.size() > i && useRange[i]
         ? hashers[i]->enableValueRange(multiplier, reservePct())
         : hashers[i]->enableValueIds(multiplier, reservePct());
@@ -1448,6 +1621,46 @@ uint64_t HashTable<ignoreNullKeys>::setHasherMode(
   return multiplier;
 }
 
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::twoWordNormalizedKeyHighStart(
+    const std::vector<uint64_t>& rangeSizes,
+    const std::vector<uint64_t>& distinctSizes,
+    std::vector<bool>& useRange) {
+  if (rows_->numNormalizedKeyWords() < 2) {
+    return 0;
+  }
+  std::vector<uint64_t> sizes(hashers_.size());
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    if (!useRange[i] && distinctSizes[i] == VectorHasher::kRangeTooLarge) {
+      useRange[i] = true;
+    }
+    sizes[i] = useRange[i] ? rangeSizes[i] : distinctSizes[i];
+  }
+  // The low word gets as many leading parts as fit in 64 bits and the high
+  // word the rest.
+  uint64_t lowSize = 1;
+  int32_t highStart = 0;
+  for (auto i = 0; i < sizes.size(); ++i) {
+    const auto size = safeMul(lowSize, sizes[i]);
+    if (size == VectorHasher::kRangeTooLarge) {
+      highStart = i;
+      break;
+    }
+    lowSize = size;
+  }
+  if (highStart == 0) {
+    return 0;
+  }
+  uint64_t highSize = 1;
+  for (auto i = highStart; i < sizes.size(); ++i) {
+    highSize = safeMul(highSize, sizes[i]);
+    if (highSize == VectorHasher::kRangeTooLarge) {
+      return 0;
+    }
+  }
+  return highStart;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::clearUseRange(std::vector<bool>& useRange) {
   for (auto i = 0; i < hashers_.size(); ++i) {
@@ -1472,6 +1685,7 @@ void HashTable<ignoreNullKeys>::decideHashMode(
     return;
   }
   disableRangeArrayHash_ |= disableRangeArrayHash;
+  normalizedKeyHighStart_ = 0;
   if (numDistinct_ && !isJoinBuild_) {
     if (!analyze()) {
       setHashMode(HashMode::kHash, numNew);
@@ -1530,6 +1744,16 @@ void HashTable<ignoreNullKeys>::decideHashMode(
   }
   if (distinctsWithReserve == VectorHasher::kRangeTooLarge &&
       rangesWithReserve == VectorHasher::kRangeTooLarge) {
+    // The key concatenation does not fit in 64 bits. See if it fits in two
+    // words before falling back to hashing.
+    const auto highStart =
+        twoWordNormalizedKeyHighStart(rangeSizes, distinctSizes, useRange);
+    if (highStart > 0) {
+      setHasherMode(hashers_, useRange, rangeSizes, distinctSizes, highStart);
+      normalizedKeyHighStart_ = highStart;
+      setHashMode(HashMode::kNormalizedKey, numNew);
+      return;
+    }
     setHashMode(HashMode::kHash, numNew);
     return;
   }
@@ -1558,7 +1782,9 @@ template <bool ignoreNullKeys>
 std::string HashTable<ignoreNullKeys>::toString() {
   std::stringstream out;
   out << "[HashTable keys: " << hashers_.size()
-      << " hash mode: " << modeString(hashMode_) << " capacity: " << capacity_
+      << " hash mode: " << modeString(hashMode_)
+      << (hasTwoWordNormalizedKeys() ? " (two words)" : "")
+      << " capacity: " << capacity_
       << " distinct count: " << numDistinct_
       << " tombstones count: " << numTombstones_ << "]";
   if (table_ == nullptr) {
@@ -1726,6 +1952,98 @@ void HashTable<ignoreNullKeys>::prepareJoinTable(
     decideHashMode(0);
   }
   checkHashBitsOverlap(spillInputStartPartitionBit);
+  prepareArrayJoinLayout();
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::prepareArrayJoinLayout() {
+  clearArrayJoinLayout();
+  if (hashMode_ != HashMode::kArray || numDistinct_ == 0) {
+    return;
+  }
+  auto* pool = rows_->pool();
+  if (matchOnlyJoin_) {
+    // A semi or anti join on dense keys only needs one bit per slot, which
+    // keeps the probed structure cache resident for much larger tables.
+    const auto bytes = bits::nwords(capacity_) * sizeof(uint64_t);
+    pool->allocateContiguous(
+        memory::AllocationTraits::numPages(bytes), arrayMatchBitsAllocation_);
+    arrayMatchBits_ = arrayMatchBitsAllocation_.data<uint64_t>();
+    ::memset(arrayMatchBits_, 0, bytes);
+    for (int64_t i = 0; i < capacity_; ++i) {
+      if (table_[i] != nullptr) {
+        bits::setBit(arrayMatchBits_, i);
+        if (arrayMatchHit_ == nullptr) {
+          arrayMatchHit_ = table_[i];
+        }
+      }
+    }
+    return;
+  }
+  if (!hasDuplicates_) {
+    return;
+  }
+  uint64_t numRows = 0;
+  for (int64_t i = 0; i < capacity_; ++i) {
+    if (auto* row = table_[i]) {
+      auto* nextRows = rows_->getNextRowVector(row);
+      numRows += nextRows ? nextRows->size() : 1;
+    }
+  }
+  if (numRows > std::numeric_limits<uint32_t>::max()) {
+    return;
+  }
+  const auto offsetsBytes =
+      bits::roundUp((capacity_ + 1) * sizeof(uint32_t), sizeof(char*));
+  const auto bytes = offsetsBytes + numRows * sizeof(char*);
+  pool->allocateContiguous(
+      memory::AllocationTraits::numPages(bytes), arrayDuplicatesAllocation_);
+  arrayDuplicateOffsets_ = arrayDuplicatesAllocation_.data<uint32_t>();
+  arrayDuplicateRows_ = reinterpret_cast<char**>(
+      arrayDuplicatesAllocation_.data<char>() + offsetsBytes);
+  uint32_t offset = 0;
+  for (int64_t i = 0; i < capacity_; ++i) {
+    arrayDuplicateOffsets_[i] = offset;
+    auto* row = table_[i];
+    if (row == nullptr) {
+      continue;
+    }
+    if (auto* nextRows = rows_->getNextRowVector(row)) {
+      std::memcpy(
+          arrayDuplicateRows_ + offset,
+          nextRows->data(),
+          nextRows->size() * sizeof(char*));
+      offset += nextRows->size();
+    } else {
+      arrayDuplicateRows_[offset++] = row;
+    }
+  }
+  arrayDuplicateOffsets_[capacity_] = offset;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::clearArrayJoinLayout() {
+  if (!arrayMatchBitsAllocation_.empty()) {
+    rows_->pool()->freeContiguous(arrayMatchBitsAllocation_);
+  }
+  arrayMatchBits_ = nullptr;
+  arrayMatchHit_ = nullptr;
+  if (!arrayDuplicatesAllocation_.empty()) {
+    rows_->pool()->freeContiguous(arrayDuplicatesAllocation_);
+  }
+  arrayDuplicateOffsets_ = nullptr;
+  arrayDuplicateRows_ = nullptr;
+}
+
+template <bool ignoreNullKeys>
+uint64_t HashTable<ignoreNullKeys>::joinResultBytes(
+    const JoinResultIterator& iter,
+    const char* row) const {
+  uint64_t bytes = iter.fixedSizeListColumns;
+  for (const auto column : iter.varSizeListColumns) {
+    bytes += rows_->variableSizeAt(row, column);
+  }
+  return bytes;
 }
 
 template <bool ignoreNullKeys>
@@ -1733,13 +2051,29 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
     JoinResultIterator& iter,
     bool includeMisses,
     folly::Range<vector_size_t*> inputRows,
-    folly::Range<char**> hits) {
+    folly::Range<char**> hits,
+    uint64_t maxBytes) {
   VELOX_CHECK_LE(inputRows.size(), hits.size());
+  VELOX_CHECK_GT(maxBytes, 0);
+  if (iter.varSizeListColumns.empty() && iter.fixedSizeListColumns > 0 &&
+      maxBytes != RowContainer::kUnlimited) {
+    // All hits have the same size, so the byte limit is a row limit.
+    const auto maxRows =
+        std::max<uint64_t>(1, maxBytes / iter.fixedSizeListColumns);
+    if (maxRows < inputRows.size()) {
+      inputRows = folly::Range(inputRows.data(), maxRows);
+    }
+    maxBytes = RowContainer::kUnlimited;
+  } else if (iter.varSizeListColumns.empty()) {
+    maxBytes = RowContainer::kUnlimited;
+  }
   if (!hasDuplicates_) {
-    return listJoinResultsNoDuplicates(iter, includeMisses, inputRows, hits);
+    return listJoinResultsNoDuplicates(
+        iter, includeMisses, inputRows, hits, maxBytes);
   }
   size_t numOut = 0;
-  auto maxOut = inputRows.size();
+  uint64_t totalBytes = 0;
+  const auto maxOut = inputRows.size();
   while (iter.lastRowIndex < iter.rows->size()) {
     auto row = (*iter.rows)[iter.lastRowIndex];
     auto hit = (*iter.hits)[row]; // NOLINT
@@ -1756,29 +2090,48 @@ int32_t HashTable<ignoreNullKeys>::listJoinResults(
       continue;
     }
 
-    auto rows = rows_->getNextRowVector(hit);
-    if (!rows) {
-      inputRows[numOut] = row; // NOLINT
-      hits[numOut] = hit;
-      numOut++;
-      iter.lastRowIndex++;
+    // The rows with the key of 'hit' are contiguous in the CSR layout of a
+    // kArray table or in the next row vector of 'hit'.
+    char* const* keyRows;
+    size_t numKeyRows;
+    if (arrayDuplicateOffsets_) {
+      VELOX_DCHECK_NOT_NULL(iter.hashes);
+      const auto index = (*iter.hashes)[row]; // NOLINT
+      VELOX_DCHECK_LT(index, capacity_);
+      const auto begin = arrayDuplicateOffsets_[index];
+      keyRows = arrayDuplicateRows_ + begin;
+      numKeyRows = arrayDuplicateOffsets_[index + 1] - begin;
+    } else if (auto* nextRows = rows_->getNextRowVector(hit)) {
+      keyRows = nextRows->data();
+      numKeyRows = nextRows->size();
     } else {
-      auto numRows = rows->size();
-      auto num =
-          std::min(numRows - iter.lastDuplicateRowIndex, maxOut - numOut);
-      std::fill_n(inputRows.begin() + numOut, num, row);
-      std::memcpy(
-          hits.data() + numOut,
-          rows->data() + iter.lastDuplicateRowIndex,
-          num * sizeof(char*));
-      iter.lastDuplicateRowIndex += num;
-      numOut += num;
-      if (iter.lastDuplicateRowIndex >= numRows) {
-        iter.lastDuplicateRowIndex = 0;
-        iter.lastRowIndex++;
+      keyRows = &hit;
+      numKeyRows = 1;
+    }
+    auto num = std::min<size_t>(
+        numKeyRows - iter.lastDuplicateRowIndex, maxOut - numOut);
+    if (maxBytes != RowContainer::kUnlimited) {
+      for (size_t i = 0; i < num; ++i) {
+        totalBytes +=
+            joinResultBytes(iter, keyRows[iter.lastDuplicateRowIndex + i]);
+        if (totalBytes >= maxBytes) {
+          num = i + 1;
+          break;
+        }
       }
     }
-    if (numOut >= maxOut) {
+    std::fill_n(inputRows.begin() + numOut, num, row);
+    std::memcpy(
+        hits.data() + numOut,
+        keyRows + iter.lastDuplicateRowIndex,
+        num * sizeof(char*));
+    iter.lastDuplicateRowIndex += num;
+    numOut += num;
+    if (iter.lastDuplicateRowIndex >= numKeyRows) {
+      iter.lastDuplicateRowIndex = 0;
+      ++iter.lastRowIndex;
+    }
+    if (numOut >= maxOut || totalBytes >= maxBytes) {
       return numOut;
     }
   }
@@ -1790,8 +2143,10 @@ int32_t HashTable<ignoreNullKeys>::listJoinResultsNoDuplicates(
     JoinResultIterator& iter,
     bool includeMisses,
     folly::Range<vector_size_t*> inputRows,
-    folly::Range<char**> hits) {
+    folly::Range<char**> hits,
+    uint64_t maxBytes) {
   int32_t numOut = 0;
+  uint64_t totalBytes = 0;
   auto maxOut = inputRows.size();
   int32_t i = iter.lastRowIndex;
   auto numRows = iter.rows->size();
@@ -1802,7 +2157,9 @@ int32_t HashTable<ignoreNullKeys>::listJoinResultsNoDuplicates(
   // We pass the pointers as int64_t's in 'hitWords'.
   auto resultHits = reinterpret_cast<int64_t*>(hits.data());
   auto resultRows = inputRows.data();
-  int32_t outLimit = maxOut - kWidth;
+  // The SIMD loop does not track bytes.
+  int32_t outLimit =
+      maxBytes == RowContainer::kUnlimited ? maxOut - kWidth : 0;
   for (; i + kWidth <= numRows && numOut < outLimit; i += kWidth) {
     auto indices = simd::loadGatherIndices<int64_t, int32_t>(sourceRows + i);
     auto hitWords = simd::gather(sourceHits, indices);
@@ -1829,7 +2186,11 @@ int32_t HashTable<ignoreNullKeys>::listJoinResultsNoDuplicates(
       resultHits[numOut] = sourceHits[row];
       resultRows[numOut] = row;
       ++numOut;
-      if (numOut >= maxOut) {
+      if (maxBytes != RowContainer::kUnlimited && sourceHits[row]) {
+        totalBytes += joinResultBytes(
+            iter, reinterpret_cast<const char*>(sourceHits[row]));
+      }
+      if (numOut >= maxOut || totalBytes >= maxBytes) {
         ++i;
         break;
       }
@@ -1984,6 +2345,8 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
     uint64_t* hashes) {
   auto numRows = rows.size();
   if (hashMode_ == HashMode::kArray) {
+    // The layout made at join build time does not track erased rows.
+    clearArrayJoinLayout();
     for (auto i = 0; i < numRows; ++i) {
       DCHECK(hashes[i] < capacity_);
       table_[hashes[i]] = nullptr;
@@ -1991,7 +2354,11 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
   } else {
     if (hashMode_ == HashMode::kNormalizedKey) {
       for (auto i = 0; i < numRows; ++i) {
-        hashes[i] = mixNormalizedKey(hashes[i], sizeBits_);
+        // Two word keys are read back from the rows since 'hashes' only has
+        // one word per row.
+        hashes[i] = hasTwoWordNormalizedKeys()
+            ? normalizedKeyHash(rows[i])
+            : mixNormalizedKey(hashes[i], sizeBits_);
       }
     }
 
@@ -2073,6 +2440,84 @@ void populateLookupRows(
 }
 } // namespace
 
+namespace {
+template <typename T>
+std::shared_ptr<common::Filter> makeJoinKeyBloomFilter(
+    const std::vector<RowContainer*>& containers,
+    int32_t column,
+    int32_t capacity) {
+  constexpr int32_t kBatchSize = 1'024;
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(capacity);
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  std::vector<char*> rows(kBatchSize);
+  for (auto* container : containers) {
+    const auto rowColumn = container->columnAt(column);
+    RowContainerIterator iter;
+    while (auto numRows =
+               container->listRows(&iter, kBatchSize, rows.data())) {
+      for (auto i = 0; i < numRows; ++i) {
+        if (RowContainer::isNullAt(rows[i], rowColumn)) {
+          continue;
+        }
+        const int64_t value =
+            RowContainer::valueAt<T>(rows[i], rowColumn.offset());
+        bloomFilter->insert(
+            common::BigintValuesUsingBloomFilter::hashValue(value));
+        min = std::min(min, value);
+        max = std::max(max, value);
+      }
+    }
+  }
+  if (min > max) {
+    return nullptr;
+  }
+  return std::make_shared<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), false);
+}
+} // namespace
+
+void BaseHashTable::buildJoinKeyBloomFilters(uint64_t maxBytes) {
+  joinKeyBloomFilters_.clear();
+  const auto numKeys = numDistinct();
+  // BloomFilter uses 2 bytes per entry rounded up to a power of 2.
+  if (numKeys == 0 || 2 * bits::nextPowerOfTwo(numKeys) > maxBytes ||
+      numKeys > std::numeric_limits<int32_t>::max()) {
+    return;
+  }
+  const auto containers = allRows();
+  // The distinct values of the keys are only tracked if not in kHash mode.
+  // Keys with few distinct values get exact filters from their hashers.
+  const bool trackedDistincts = hashMode() != HashMode::kHash;
+  joinKeyBloomFilters_.resize(hashers_.size());
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    if (trackedDistincts && !hashers_[i]->distinctOverflow()) {
+      continue;
+    }
+    switch (hashers_[i]->typeKind()) {
+      case TypeKind::TINYINT:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int8_t>(containers, i, numKeys);
+        break;
+      case TypeKind::SMALLINT:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int16_t>(containers, i, numKeys);
+        break;
+      case TypeKind::INTEGER:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int32_t>(containers, i, numKeys);
+        break;
+      case TypeKind::BIGINT:
+        joinKeyBloomFilters_[i] =
+            makeJoinKeyBloomFilter<int64_t>(containers, i, numKeys);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
 std::string BaseHashTable::RowsIterator::toString() const {
   return fmt::format(
       "[hashTableIndex:{} rowContainerIter:{}",
@@ -2103,10 +2548,13 @@ void BaseHashTable::prepareForGroupProbe(
 
   bool rehash = false;
   const auto mode = hashMode();
+  if (hasTwoWordNormalizedKeys()) {
+    lookup.normalizedKeysHigh.resize(rows.end());
+  }
   for (auto i = 0; i < hashers.size(); ++i) {
     auto& hasher = hashers[i];
     if (mode != BaseHashTable::HashMode::kHash) {
-      if (!hasher->computeValueIds(rows, lookup.hashes)) {
+      if (!hasher->computeValueIds(rows, valueIds(lookup, i))) {
         rehash = true;
       }
     } else {
@@ -2148,12 +2596,15 @@ void BaseHashTable::prepareForJoinProbe(
   lookup.reset(rows.end());
 
   const auto mode = hashMode();
+  if (hasTwoWordNormalizedKeys()) {
+    lookup.normalizedKeysHigh.resize(rows.end());
+  }
   for (auto i = 0; i < hashers.size(); ++i) {
     auto& hasher = hashers[i];
     if (mode != BaseHashTable::HashMode::kHash) {
       auto& key = input->childAt(hasher->channel());
       hashers_[i]->lookupValueIds(
-          *key, rows, lookup.scratchMemory, lookup.hashes);
+          *key, rows, lookup.scratchMemory, valueIds(lookup, i));
     } else {
       hasher->hash(rows, i > 0, lookup.hashes);
     }
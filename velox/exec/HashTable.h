@@ -95,6 +95,15 @@ struct HashLookup {
   /// If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   /// Populated by groupProbe and joinProbe.
   raw_vector<uint64_t> normalizedKeys;
+
+  /// High words of two word normalized keys. 1:1 with 'hashes'. Populated by
+  /// prepareForGroupProbe and prepareForJoinProbe if the table uses two word
+  /// normalized keys.
+  raw_vector<uint64_t> normalizedKeysHigh;
+
+  /// Scratch memory for joinProbe with radix partitioned probe enabled. The
+  /// rows in 'rows' ordered by the region of the table they hit.
+  raw_vector<vector_size_t> partitionedRows;
 };
 
 struct HashTableStats {
@@ -103,6 +112,9 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Counts the number of join probe rows looked up in groups with software
+  /// prefetching of table buckets and rows.
+  int64_t numPrefetchProbes{0};
 };
 
 class BaseHashTable {
@@ -132,6 +144,8 @@ class BaseHashTable {
 
   /// The same as above but only reported by the HashBuild operator.
   static inline const std::string kBuildWallNanos{"hashtable.buildWallNanos"};
+  static inline const std::string kBloomFilterBuildWallNanos{
+      "hashtable.bloomFilterBuildWallNanos"};
 
   /// Returns the string of the given 'mode'.
   static std::string modeString(HashMode mode);
@@ -144,6 +158,7 @@ class BaseHashTable {
     void reset(const HashLookup& lookup) {
       rows = &lookup.rows;
       hits = &lookup.hits;
+      hashes = &lookup.hashes;
       lastRowIndex = 0;
       lastDuplicateRowIndex = 0;
     }
@@ -154,8 +169,20 @@ class BaseHashTable {
 
     const raw_vector<vector_size_t>* rows{nullptr};
     const raw_vector<char*>* hits{nullptr};
+    // The array indices of the probe rows in a kArray mode table.
+    const raw_vector<uint64_t>* hashes{nullptr};
     vector_size_t lastRowIndex{0};
     vector_size_t lastDuplicateRowIndex{0};
+
+    /// The variable width columns of the table that are extracted into the
+    /// join output. Used with 'fixedSizeListColumns' to estimate the output
+    /// bytes of each hit for the 'maxBytes' limit of listJoinResults(). Not
+    /// changed by reset().
+    std::vector<column_index_t> varSizeListColumns;
+
+    /// Total byte width of the fixed width columns of the table that are
+    /// extracted into the join output.
+    uint64_t fixedSizeListColumns{0};
   };
 
   struct RowsIterator {
@@ -224,8 +251,10 @@ class BaseHashTable {
 
   /// Fills 'hits' with consecutive hash join results. The corresponding element
   /// of 'inputRows' is set to the corresponding row number in probe keys.
-  /// Returns the number of hits produced. If this is less than hits.size() then
-  /// all the hits have been produced.
+  /// Returns the number of hits produced. Stops when 'hits' is full or when the
+  /// estimated size of the build side columns of the hits reaches 'maxBytes',
+  /// see JoinResultIterator::varSizeListColumns. All the hits have been
+  /// produced when iter.atEnd() is true.
   /// Adds input rows without a match to 'inputRows' with corresponding hit
   /// set to nullptr if 'includeMisses' is true. Otherwise, skips input rows
   /// without a match. 'includeMisses' is set to true when listing results for
@@ -234,7 +263,8 @@ class BaseHashTable {
       JoinResultIterator& iter,
       bool includeMisses,
       folly::Range<vector_size_t*> inputRows,
-      folly::Range<char**> hits) = 0;
+      folly::Range<char**> hits,
+      uint64_t maxBytes) = 0;
 
   /// Returns rows with 'probed' flag unset. Used by the right/full join.
   virtual int32_t listNotProbedRows(
@@ -303,6 +333,23 @@ class BaseHashTable {
   /// VectorHashers of 'this'.
   virtual HashMode hashMode() const = 0;
 
+  /// True if the table is in kNormalizedKey mode with keys of two words. The
+  /// value ids of the key parts starting at 'normalizedKeyHighStart_' make up
+  /// the high word.
+  bool hasTwoWordNormalizedKeys() const {
+    return normalizedKeyHighStart_ > 0;
+  }
+
+  /// Marks a join table whose probe only needs to know whether a key has a
+  /// match, as for left semi and anti joins without a filter. Must be called
+  /// before prepareJoinTable(). If the table ends up in kArray mode, the join
+  /// probe tests a bitmap of the occupied slots instead of reading the row
+  /// pointer array and the hits point to an arbitrary row of the table instead
+  /// of the matching row.
+  void setMatchOnlyJoin() {
+    matchOnlyJoin_ = true;
+  }
+
   /// Disables use of array or normalized key hash modes.
   void forceGenericHashMode() {
     setHashMode(HashMode::kHash, 0);
@@ -344,6 +391,31 @@ class BaseHashTable {
   /// join use.
   virtual std::vector<RowContainer*> allRows() const = 0;
 
+  /// Builds a Bloom filter over the values of each integer join key from the
+  /// rows of all the row containers of 'this'. Invoked by the last HashBuild
+  /// operator after prepareJoinTable(). The filters are pushed down by
+  /// HashProbe into the probe side scan when the keys have too many distinct
+  /// values for an exact filter. No filter is built if the filter for a key
+  /// would take more than 'maxBytes'.
+  void buildJoinKeyBloomFilters(uint64_t maxBytes);
+
+  /// If 'enabled', joinProbe() on a table larger than the cache radix
+  /// partitions the probe rows of each batch by the high bits of the bucket
+  /// index before probing. The probes for each partition then hit a region
+  /// of the table small enough to stay in cache. The order of the rows in
+  /// the lookup and of the join results is unchanged.
+  void setRadixPartitionedProbe(bool enabled) {
+    radixPartitionedProbe_ = enabled;
+  }
+
+  /// Returns the Bloom filter built by buildJoinKeyBloomFilters() for the
+  /// join key at 'keyIndex' or nullptr if there is none.
+  std::shared_ptr<common::Filter> joinKeyBloomFilter(int32_t keyIndex) const {
+    return keyIndex < joinKeyBloomFilters_.size()
+        ? joinKeyBloomFilters_[keyIndex]
+        : nullptr;
+  }
+
   /// Static functions for processing internals. Public because used in
   /// structs that define probe and insert algorithms.
 
@@ -405,11 +477,33 @@ class BaseHashTable {
     }
   }
 
+  // Returns the vector receiving the value ids of key part 'i' in 'lookup'.
+  raw_vector<uint64_t>& valueIds(HashLookup& lookup, int32_t i) const {
+    return hasTwoWordNormalizedKeys() && i >= normalizedKeyHighStart_
+        ? lookup.normalizedKeysHigh
+        : lookup.hashes;
+  }
+
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   std::unique_ptr<RowContainer> rows_;
 
+  // Index of the first key part of the high word of two word normalized keys.
+  // 0 if normalized keys are one word.
+  int32_t normalizedKeyHighStart_{0};
+
+  // True if join probes only need to know whether there is a match. See
+  // setMatchOnlyJoin().
+  bool matchOnlyJoin_{false};
+
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+  // Bloom filters over the join keys, indexed by key. Null for keys without a
+  // filter.
+  std::vector<std::shared_ptr<common::Filter>> joinKeyBloomFilters_;
+
+  // See setRadixPartitionedProbe().
+  bool radixPartitionedProbe_{false};
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -499,7 +593,8 @@ class HashTable : public BaseHashTable {
       JoinResultIterator& iter,
       bool includeMisses,
       folly::Range<vector_size_t*> inputRows,
-      folly::Range<char**> hits) override;
+      folly::Range<char**> hits,
+      uint64_t maxBytes) override;
 
   int32_t listNotProbedRows(
       RowsIterator* iter,
@@ -546,7 +641,11 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_,
+        numRehashes_,
+        numDistinct_,
+        numTombstones_,
+        numPrefetchProbes_.load(std::memory_order_relaxed)};
   }
 
   bool hasDuplicateKeys() const override {
@@ -625,6 +724,18 @@ class HashTable : public BaseHashTable {
     return otherTables_;
   }
 
+  /// True if join probes test a bitmap of the occupied slots of a kArray
+  /// table. See setMatchOnlyJoin().
+  bool hasArrayMatchBits() const {
+    return arrayMatchBits_ != nullptr;
+  }
+
+  /// True if the rows of a kArray join table with duplicate keys are also
+  /// laid out contiguously by slot for listJoinResults().
+  bool hasArrayDuplicateOffsets() const {
+    return arrayDuplicateOffsets_ != nullptr;
+  }
+
  private:
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
@@ -713,7 +824,20 @@ class HashTable : public BaseHashTable {
       JoinResultIterator& iter,
       bool includeMisses,
       folly::Range<vector_size_t*> inputRows,
-      folly::Range<char**> hits);
+      folly::Range<char**> hits,
+      uint64_t maxBytes);
+
+  // Returns the estimated size of the columns listed by 'iter' for 'row'.
+  uint64_t joinResultBytes(const JoinResultIterator& iter, const char* row)
+      const;
+
+  // Builds the bitmap of occupied slots or the contiguous layout of duplicate
+  // rows for a kArray join table after the table is filled in
+  // prepareJoinTable().
+  void prepareArrayJoinLayout();
+
+  // Frees the structures made by prepareArrayJoinLayout().
+  void clearArrayJoinLayout();
 
   // Tries to use as many range hashers as can in a normalized key situation.
   void enableRangeWhereCan(
@@ -722,12 +846,25 @@ class HashTable : public BaseHashTable {
       std::vector<bool>& useRange);
 
   // Sets value ranges or distinct value ids mode for VectorHashers in a kArray
-  // or kNormalizedKeys mode table.
+  // or kNormalizedKeys mode table. If 'highStart' is not 0, the value ids of
+  // the hashers from 'highStart' on are concatenated into a separate word.
   uint64_t setHasherMode(
       const std::vector<std::unique_ptr<VectorHasher>>& hashers,
       const std::vector<bool>& useRange,
       const std::vector<uint64_t>& rangeSizes,
-      const std::vector<uint64_t>& distinctSizes);
+      const std::vector<uint64_t>& distinctSizes,
+      int32_t highStart = 0);
+
+  // Returns the first key part of the high word if the value ids of the keys
+  // fit in two words and the rows have space for two word normalized keys.
+  // Returns 0 otherwise. Sets 'useRange' for the chosen layout.
+  int32_t twoWordNormalizedKeyHighStart(
+      const std::vector<uint64_t>& rangeSizes,
+      const std::vector<uint64_t>& distinctSizes,
+      std::vector<bool>& useRange);
+
+  // Returns the hash number of the normalized key stored below 'row'.
+  uint64_t normalizedKeyHash(char* row) const;
 
   // Clears all elements of 'useRange' except ones that correspond to boolean
   // VectorHashers.
@@ -838,8 +975,29 @@ class HashTable : public BaseHashTable {
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
-  // Shortcut for probe with normalized keys.
-  void joinNormalizedKeyProbe(HashLookup& lookup);
+  // Join probe of a kArray table with 'arrayMatchBits_'.
+  void arrayMatchJoinProbe(HashLookup& lookup);
+
+  // Shortcut for probe with normalized keys. Probes 'rows' which are either
+  // 'lookup.rows' or their radix partitioned permutation.
+  void joinNormalizedKeyProbe(
+      HashLookup& lookup,
+      const raw_vector<vector_size_t>& rows);
+
+  // Join probe in kHash mode for tables larger than the cache. Probes groups
+  // of rows in three passes over the group: prefetch the buckets, compare the
+  // tags and prefetch the first candidate rows, then compare the keys. This
+  // keeps many cache misses in flight instead of one per row.
+  void joinPrefetchProbe(
+      HashLookup& lookup,
+      const raw_vector<vector_size_t>& rows);
+
+  // Returns the rows of 'lookup' to probe in order. If radix partitioned
+  // probe is enabled and worthwhile for the size of 'this' and 'lookup',
+  // these are 'lookup.rows' ordered by the high bits of their bucket index
+  // in 'lookup.partitionedRows'. Otherwise, this is 'lookup.rows'. Must be
+  // called after the final hashes are in 'lookup'.
+  const raw_vector<vector_size_t>& joinProbeRows(HashLookup& lookup) const;
 
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
@@ -960,6 +1118,22 @@ class HashTable : public BaseHashTable {
   char** table_ = nullptr;
   memory::ContiguousAllocation tableAllocation_;
 
+  // Bitmap of the occupied slots of a kArray table for a match only join. The
+  // bitmap is 1/64 of the size of 'table_' and is what the join probe reads.
+  memory::ContiguousAllocation arrayMatchBitsAllocation_;
+  uint64_t* arrayMatchBits_{nullptr};
+
+  // The hit returned for all matches found in 'arrayMatchBits_'.
+  char* arrayMatchHit_{nullptr};
+
+  // Rows of a kArray join table with duplicates in CSR layout. The rows with
+  // the key of slot i are arrayDuplicateRows_[arrayDuplicateOffsets_[i]] up to
+  // arrayDuplicateRows_[arrayDuplicateOffsets_[i + 1]]. This saves reading the
+  // next row link from the first row of each hit.
+  memory::ContiguousAllocation arrayDuplicatesAllocation_;
+  uint32_t* arrayDuplicateOffsets_{nullptr};
+  char** arrayDuplicateRows_{nullptr};
+
   // Number of slots across all buckets.
   int64_t capacity_{0};
 
@@ -994,6 +1168,10 @@ class HashTable : public BaseHashTable {
   // Number of times a match is found.
   mutable tsan_atomic<int64_t> numHits_{0};
 
+  // Number of rows probed by joinPrefetchProbe(). Incremented concurrently by
+  // the probe drivers sharing 'this'.
+  std::atomic<int64_t> numPrefetchProbes_{0};
+
   // Bounds of independently buildable index ranges in the table. The
   // range of partition i starts at [i] and ends at [i +1]. Bounds are multiple
   // of cache line  size.
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+
+namespace facebook::velox::exec {
+
+std::shared_ptr<BaseHashTable> HashTableCache::Entry::setTable(
+    std::unique_ptr<BaseHashTable> table,
+    bool hasNullKeys) {
+  VELOX_CHECK_NOT_NULL(table);
+  std::vector<ContinuePromise> promises;
+  std::shared_ptr<BaseHashTable> sharedTable;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_NULL(table_, "Shared hash table has already been set");
+    VELOX_CHECK(!abandoned_);
+    table_ = std::move(table);
+    hasNullKeys_ = hasNullKeys;
+    promises = std::move(promises_);
+    sharedTable = sharedTableLocked();
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  return sharedTable;
+}
+
+void HashTableCache::Entry::abandon() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (table_ != nullptr || abandoned_) {
+      return;
+    }
+    abandoned_ = true;
+    promises = std::move(promises_);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
+std::shared_ptr<BaseHashTable> HashTableCache::Entry::tableOrFuture(
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(
+      !abandoned_,
+      "Task {} failed to build the shared hash table",
+      builderTaskId_);
+  if (table_ != nullptr) {
+    return sharedTableLocked();
+  }
+  promises_.emplace_back("HashTableCache::Entry::tableOrFuture");
+  *future = promises_.back().getSemiFuture();
+  return nullptr;
+}
+
+std::shared_ptr<BaseHashTable> HashTableCache::Entry::sharedTableLocked() {
+  // Aliasing constructor: the returned pointer shares ownership of the entry.
+  return std::shared_ptr<BaseHashTable>(shared_from_this(), table_.get());
+}
+
+// static
+HashTableCache* HashTableCache::instance() {
+  static HashTableCache cache;
+  return &cache;
+}
+
+std::shared_ptr<HashTableCache::Entry> HashTableCache::acquire(
+    core::QueryCtx* queryCtx,
+    const core::PlanNodeId& planNodeId,
+    uint32_t splitGroupId,
+    const std::string& taskId) {
+  const auto key =
+      fmt::format("{}:{}:{}", queryCtx->queryId(), planNodeId, splitGroupId);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    if (auto entry = it->second.lock()) {
+      return entry;
+    }
+  }
+
+  // Drop the entries of the joins that have finished.
+  for (auto entryIt = entries_.begin(); entryIt != entries_.end();) {
+    if (entryIt->second.expired()) {
+      entryIt = entries_.erase(entryIt);
+    } else {
+      ++entryIt;
+    }
+  }
+
+  auto entry = std::make_shared<Entry>(
+      taskId,
+      queryCtx->pool()->addLeafChild(
+          fmt::format("hashTableCache.{}.{}", key, nextPoolId_++)));
+  entries_[key] = entry;
+  return entry;
+}
+
+size_t HashTableCache::numEntries() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t numEntries{0};
+  for (const auto& [key, entry] : entries_) {
+    if (!entry.expired()) {
+      ++numEntries;
+    }
+  }
+  return numEntries;
+}
+} // namespace facebook::velox::exec
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/core/QueryCtx.h"
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// Process-wide registry of join hash tables shared by the tasks of the same
+/// query running on this node, e.g. the tasks of a broadcast join. Entries are
+/// keyed by query id, join plan node id and split group id. The first task to
+/// acquire an entry builds the table and the other tasks attach to it
+/// read-only once it is published.
+///
+/// Entries are reference counted: the registry only holds weak references so
+/// an entry and its table are freed as soon as the last HashBuild or HashProbe
+/// operator using it goes away.
+class HashTableCache {
+ public:
+  class Entry : public std::enable_shared_from_this<Entry> {
+   public:
+    Entry(std::string builderTaskId, std::shared_ptr<memory::MemoryPool> pool)
+        : builderTaskId_(std::move(builderTaskId)), pool_(std::move(pool)) {}
+
+    /// Id of the task whose HashBuild operators build the shared table.
+    const std::string& builderTaskId() const {
+      return builderTaskId_;
+    }
+
+    /// The query level memory pool the shared table is allocated from. It
+    /// outlives the builder task so the table stays valid for the others.
+    memory::MemoryPool* pool() const {
+      return pool_.get();
+    }
+
+    /// Invoked by the builder task once 'table' is fully built. Wakes up the
+    /// tasks waiting for it and returns the shared reference for the builder
+    /// task's own probe side.
+    std::shared_ptr<BaseHashTable> setTable(
+        std::unique_ptr<BaseHashTable> table,
+        bool hasNullKeys);
+
+    /// Invoked when the builder task goes away before publishing the table.
+    /// Waiting tasks are woken up and fail. No-op if the table is published.
+    void abandon();
+
+    /// Returns the shared table if it has been published. Otherwise returns
+    /// null and sets 'future' to wait for it. Throws if the builder task
+    /// abandoned the build.
+    std::shared_ptr<BaseHashTable> tableOrFuture(ContinueFuture* future);
+
+    bool hasNullKeys() const {
+      std::lock_guard<std::mutex> l(mutex_);
+      return hasNullKeys_;
+    }
+
+   private:
+    // Returns a reference to 'table_' that keeps this entry, and so 'pool_',
+    // alive.
+    std::shared_ptr<BaseHashTable> sharedTableLocked();
+
+    const std::string builderTaskId_;
+    // NOTE: 'pool_' is declared before 'table_' so that it is destroyed after
+    // the table memory has been freed.
+    const std::shared_ptr<memory::MemoryPool> pool_;
+
+    mutable std::mutex mutex_;
+    std::unique_ptr<BaseHashTable> table_;
+    bool hasNullKeys_{false};
+    bool abandoned_{false};
+    std::vector<ContinuePromise> promises_;
+  };
+
+  static HashTableCache* instance();
+
+  /// Returns the entry for join 'planNodeId' of the query in 'queryCtx'. A new
+  /// entry built by 'taskId' is created if there is none.
+  std::shared_ptr<Entry> acquire(
+      core::QueryCtx* queryCtx,
+      const core::PlanNodeId& planNodeId,
+      uint32_t splitGroupId,
+      const std::string& taskId);
+
+  /// Returns the number of live entries.
+  size_t numEntries() const;
+
+ private:
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, std::weak_ptr<Entry>> entries_;
+  // Used to give unique names to the entry memory pools.
+  uint64_t nextPoolId_{0};
+};
+} // namespace facebook::velox::exec
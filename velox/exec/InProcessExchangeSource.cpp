@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+#include "velox/exec/ExchangeClient.h"
+#include "velox/exec/OutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+// static
+std::shared_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  if (taskId.compare(0, kScheme.size(), kScheme) != 0) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_ || closed_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    std::chrono::microseconds /*maxWait*/) {
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  int64_t requestedSequence;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    VELOX_CHECK(requestPending_);
+    promise_ = std::move(promise);
+    requestedSequence = sequence_;
+  }
+
+  auto buffers = OutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "OutputBufferManager was already destructed");
+  // The callback may outlive 'this' if the consumer goes away while the
+  // request is pending.
+  auto self =
+      std::static_pointer_cast<InProcessExchangeSource>(shared_from_this());
+  const bool found = buffers->getData(
+      taskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      [self, requestedSequence](
+          std::vector<std::unique_ptr<folly::IOBuf>> data,
+          int64_t sequence,
+          std::vector<int64_t> remainingBytes) {
+        self->processData(
+            std::move(data),
+            requestedSequence,
+            sequence,
+            std::move(remainingBytes));
+      });
+  VELOX_CHECK(
+      found,
+      "Output buffer of in-process producer task not found: {}",
+      taskId_);
+  return future;
+}
+
+void InProcessExchangeSource::processData(
+    std::vector<std::unique_ptr<folly::IOBuf>> data,
+    int64_t requestedSequence,
+    int64_t sequence,
+    std::vector<int64_t> remainingBytes) {
+  if (requestedSequence > sequence && !data.empty()) {
+    // Pages before 'requestedSequence' were already received.
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, data.size());
+    data.erase(data.begin(), data.begin() + numExtra);
+    sequence = requestedSequence;
+  }
+
+  // The pages keep the IOBufs of the producer. The IOBufs may be shared with
+  // other destinations of a broadcast, which is fine as deserialization only
+  // reads them.
+  std::vector<std::unique_ptr<SerializedPage>> pages;
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  for (auto& inputPage : data) {
+    if (inputPage == nullptr) {
+      atEnd = true;
+      // Keep looping, there could be extra end markers.
+      continue;
+    }
+    totalBytes += inputPage->computeChainDataLength();
+    pages.push_back(std::make_unique<SerializedPage>(std::move(inputPage)));
+  }
+  numPages_ += pages.size();
+  totalBytes_ += totalBytes;
+
+  int64_t ackSequence{0};
+  bool closed;
+  VeloxPromise<Response> requestPromise;
+  {
+    std::vector<ContinuePromise> queuePromises;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+      requestPromise = std::move(promise_);
+      closed = closed_;
+      if (!closed) {
+        for (auto& page : pages) {
+          queue_->enqueueLocked(std::move(page), queuePromises);
+        }
+        if (atEnd) {
+          queue_->enqueueLocked(nullptr, queuePromises);
+          atEnd_ = true;
+        }
+        if (!pages.empty()) {
+          ackSequence = sequence_ = sequence + pages.size();
+        }
+      }
+    }
+    for (auto& promise : queuePromises) {
+      promise.setValue();
+    }
+  }
+
+  // Outside of queue mutex.
+  if (!closed) {
+    auto buffers = OutputBufferManager::getInstance().lock();
+    if (buffers != nullptr) {
+      if (atEnd) {
+        buffers->deleteResults(taskId_, destination_);
+      } else if (ackSequence > 0) {
+        buffers->acknowledge(taskId_, destination_, ackSequence);
+      }
+    }
+  }
+
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(
+        Response{totalBytes, atEnd, std::move(remainingBytes)});
+  }
+}
+
+void InProcessExchangeSource::close() {
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    closed_ = true;
+  }
+  checkSetRequestPromise();
+
+  if (auto buffers = OutputBufferManager::getInstance().lock()) {
+    buffers->deleteResults(taskId_, destination_);
+  }
+}
+
+bool InProcessExchangeSource::checkSetRequestPromise() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false, {}});
+    return true;
+  }
+  return false;
+}
+
+folly::F14FastMap<std::string, RuntimeMetric>
+InProcessExchangeSource::metrics() const {
+  return {
+      {"inProcessExchangeSource.numPages", RuntimeMetric(numPages_)},
+      {"inProcessExchangeSource.totalBytes",
+       RuntimeMetric(totalBytes_, RuntimeCounter::Unit::kBytes)},
+      {ExchangeClient::kBackgroundCpuTimeMs,
+       RuntimeMetric(0, RuntimeCounter::Unit::kNanos)},
+  };
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource for a producer task that runs in the same process as the
+/// consumer. Fetches the serialized pages directly from the
+/// OutputBufferManager of the process and hands the IOBufs of the producer to
+/// the ExchangeQueue without copying them, so there is no network transfer
+/// and no copy between the serialization in PartitionedOutput and the
+/// deserialization in Exchange.
+///
+/// Handles the task ids that start with 'kScheme'. The whole task id,
+/// including the scheme, is the id of the producer task. Register with:
+///
+///   ExchangeSource::registerFactory(InProcessExchangeSource::create);
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  static inline const std::string kScheme = "inprocess://";
+
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(taskId, destination, std::move(queue), pool) {}
+
+  /// Returns an InProcessExchangeSource if 'taskId' starts with 'kScheme',
+  /// nullptr otherwise.
+  static std::shared_ptr<ExchangeSource> create(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  bool supportsMetrics() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  /// Completes when the producer has data or has finished. 'maxWait' is not
+  /// enforced: there is no remote end that can go away, so the request stays
+  /// pending until the producer responds or close() is called.
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds maxWait) override;
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds maxWait) override {
+    return request(0, maxWait);
+  }
+
+  void close() override;
+
+  folly::F14FastMap<std::string, RuntimeMetric> metrics() const override;
+
+ private:
+  // Called by the OutputBufferManager with the pages starting at 'sequence'
+  // for the request for 'requestedSequence'.
+  void processData(
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t requestedSequence,
+      int64_t sequence,
+      std::vector<int64_t> remainingBytes);
+
+  // Completes a pending request with an empty response. Returns false if there
+  // was no pending request.
+  bool checkSetRequestPromise();
+
+  // Set by close(). Guarded by the mutex of 'queue_'.
+  bool closed_{false};
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -29,29 +29,33 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if (bufferedBytes_.fetch_add(added) + added < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  // Set before checking the size again. A consumer that brings the size below
+  // the limit after the check sees the flag and fulfills the promise.
+  hasWaiters_ = true;
+  if (bufferedBytes_ < maxBufferSize_) {
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
   std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
-
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  if (bufferedBytes_.fetch_sub(removed) - removed >= maxBufferSize_ ||
+      !hasWaiters_) {
+    return promises;
   }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  hasWaiters_ = false;
+  promises = std::move(promises_);
   return promises;
 }
 
@@ -81,18 +85,12 @@ BlockingReason LocalExchangeQueue::enqueue(
   auto inputBytes = input->estimateFlatSize();
 
   std::vector<ContinuePromise> consumerPromises;
-  bool blockedOnConsumer = false;
   bool isClosed = queue_.withWLock([&](auto& queue) {
     if (closed_) {
       return true;
     }
     queue.push(std::move(input));
     consumerPromises = std::move(consumerPromises_);
-
-    if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
-      blockedOnConsumer = true;
-    }
-
     return false;
   });
 
@@ -102,7 +100,10 @@ BlockingReason LocalExchangeQueue::enqueue(
 
   notify(consumerPromises);
 
-  if (blockedOnConsumer) {
+  // Memory is accounted outside of the queue lock so that queues of different
+  // partitions do not serialize on the memory manager. A consumer may account
+  // the removal first and make the total briefly lower than the actual.
+  if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
     return BlockingReason::kWaitForConsumer;
   }
 
@@ -125,7 +126,6 @@ BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
-  std::vector<ContinuePromise> memoryPromises;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -142,12 +142,13 @@ BlockingReason LocalExchangeQueue::next(
     *data = queue.front();
     queue.pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
-
     return BlockingReason::kNotBlocked;
   });
-  notify(memoryPromises);
+  if (*data != nullptr) {
+    auto memoryPromises =
+        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    notify(memoryPromises);
+  }
   return blockingReason;
 }
 
@@ -251,7 +252,14 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      minBatchRows_{
+          numPartitions_ == 1
+              ? 0
+              : static_cast<vector_size_t>(
+                    ctx->queryConfig().localExchangeMinBatchRows())},
+      pendingBatches_(numPartitions_),
+      pendingRows_(numPartitions_, 0) {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -307,25 +315,14 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 
   if (numPartitions_ == 1) {
-    ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(0, std::move(input));
     return;
   }
 
   const auto singlePartition =
       partitionFunction_->partition(*input, partitions_);
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    addPartitionData(singlePartition.value(), std::move(input));
     return;
   }
 
@@ -350,16 +347,53 @@ void LocalPartition::addInput(RowVectorPtr input) {
       // Do not enqueue empty partitions.
       continue;
     }
-    auto partitionData =
-        wrapChildren(input, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
+    addPartitionData(
+        i, wrapChildren(input, partitionSize, std::move(indexBuffers[i])));
+  }
+}
+
+void LocalPartition::enqueue(int partition, RowVectorPtr data) {
+  ContinueFuture future;
+  auto reason = queues_[partition]->enqueue(std::move(data), &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(reason);
+    futures_.push_back(std::move(future));
+  }
+}
+
+void LocalPartition::addPartitionData(int partition, RowVectorPtr data) {
+  if (minBatchRows_ == 0 ||
+      (pendingBatches_[partition].empty() && data->size() >= minBatchRows_)) {
+    enqueue(partition, std::move(data));
+    return;
+  }
+  pendingRows_[partition] += data->size();
+  pendingBatches_[partition].push_back(std::move(data));
+  if (pendingRows_[partition] >= minBatchRows_) {
+    flushPartition(partition);
+  }
+}
+
+void LocalPartition::flushPartition(int partition) {
+  auto& batches = pendingBatches_[partition];
+  if (batches.empty()) {
+    return;
+  }
+  RowVectorPtr data;
+  if (batches.size() == 1) {
+    data = std::move(batches[0]);
+  } else {
+    data = BaseVector::create<RowVector>(
+        batches[0]->type(), pendingRows_[partition], pool());
+    vector_size_t offset = 0;
+    for (const auto& batch : batches) {
+      data->copy(batch.get(), offset, 0, batch->size());
+      offset += batch->size();
     }
   }
+  batches.clear();
+  pendingRows_[partition] = 0;
+  enqueue(partition, std::move(data));
 }
 
 BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
@@ -376,6 +410,9 @@ BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
 
 void LocalPartition::noMoreInput() {
   Operator::noMoreInput();
+  for (auto i = 0; i < numPartitions_; ++i) {
+    flushPartition(i);
+  }
   for (const auto& queue : queues_) {
     queue->noMoreData();
   }
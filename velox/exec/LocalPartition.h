@@ -21,7 +21,9 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The size is an atomic counter. The mutex is taken only
+/// to block producers when the limit is reached and to wake them up, so that
+/// producers and consumers of different queues do not contend below the limit.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -38,8 +40,11 @@ class LocalExchangeMemoryManager {
 
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if a producer may be waiting in 'promises_'. Lets consumers skip the
+  // mutex when there is no one to wake up.
+  std::atomic<bool> hasWaiters_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
@@ -172,9 +177,29 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  // Adds 'data' to the queue of 'partition' and records the future if the
+  // queue is full.
+  void enqueue(int partition, RowVectorPtr data);
+
+  // Adds 'data' for 'partition' to 'pendingBatches_' if it is smaller than
+  // 'minBatchRows_'. Enqueues the accumulated batches once they have at least
+  // 'minBatchRows_' rows.
+  void addPartitionData(int partition, RowVectorPtr data);
+
+  // Copies the batches accumulated for 'partition' into one and enqueues it.
+  void flushPartition(int partition);
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // See QueryConfig::kLocalExchangeMinBatchRows. 0 if batches are enqueued as
+  // they are.
+  const vector_size_t minBatchRows_;
+
+  // Small partitions of the input accumulated for each queue and their total
+  // number of rows.
+  std::vector<std::vector<RowVectorPtr>> pendingBatches_;
+  std::vector<vector_size_t> pendingRows_;
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/LocalPlanner.h"
 #include "velox/core/PlanFragment.h"
+#include "velox/exec/Aggregate.h"
 #include "velox/exec/ArrowStream.h"
 #include "velox/exec/AssignUniqueId.h"
 #include "velox/exec/CallbackSink.h"
@@ -203,8 +204,9 @@ uint32_t maxDrivers(
     } else if (
         auto orderBy =
             std::dynamic_pointer_cast<const core::OrderByNode>(node)) {
-      // final orderby must run single-threaded
-      if (!orderBy->isPartial()) {
+      // final orderby must run single-threaded unless the drivers merge
+      // their sorted runs
+      if (!orderBy->isPartial() && !queryConfig.orderByParallelSort()) {
         return 1;
       }
     } else if (
@@ -403,6 +405,127 @@ bool eagerFlush(const core::PlanNode& node) {
   return eagerFlush(*node.sources()[0]);
 }
 
+// Returns the partial aggregation, GroupId and final aggregation that compute
+// 'aggregation' over 'groupId' by aggregating the input of 'groupId' once on
+// all the grouping keys and merging the partial groups of each grouping set.
+// The partial and final aggregations get the ID of 'aggregation'. Returns an
+// empty list if 'aggregation' is not a single aggregation over the raw inputs
+// of 'groupId' or has aggregates that cannot be split.
+std::vector<core::PlanNodePtr> preAggregateGroupingSets(
+    const std::shared_ptr<const core::GroupIdNode>& groupId,
+    const std::shared_ptr<const core::AggregationNode>& aggregation) {
+  using Step = core::AggregationNode::Step;
+  if (aggregation->step() != Step::kSingle || aggregation->isPreGrouped() ||
+      aggregation->aggregates().empty()) {
+    return {};
+  }
+
+  const auto& groupIdType = groupId->outputType();
+  const auto& groupIdName = groupIdType->nameOf(groupIdType->size() - 1);
+  std::unordered_set<std::string> groupIdKeys{groupIdName};
+  for (const auto& info : groupId->groupingKeyInfos()) {
+    groupIdKeys.insert(info.output);
+  }
+  if (aggregation->groupingKeys().size() != groupIdKeys.size()) {
+    return {};
+  }
+  for (const auto& key : aggregation->groupingKeys()) {
+    if (groupIdKeys.count(key->name()) == 0) {
+      return {};
+    }
+  }
+
+  // The partial aggregation groups on the distinct input columns of the
+  // grouping keys, which keep their names.
+  std::vector<core::FieldAccessTypedExprPtr> partialKeys;
+  std::unordered_set<std::string> partialKeyNames;
+  for (const auto& info : groupId->groupingKeyInfos()) {
+    if (partialKeyNames.insert(info.input->name()).second) {
+      partialKeys.push_back(info.input);
+    }
+  }
+
+  std::unordered_set<std::string> aggregationInputs;
+  for (const auto& input : groupId->aggregationInputs()) {
+    aggregationInputs.insert(input->name());
+  }
+  const auto& names = aggregation->aggregateNames();
+  for (auto i = 0; i < names.size(); ++i) {
+    const auto& aggregate = aggregation->aggregates()[i];
+    if (aggregate.distinct || !aggregate.sortingKeys.empty() ||
+        aggregate.mask != nullptr || groupIdKeys.count(names[i]) > 0 ||
+        partialKeyNames.count(names[i]) > 0) {
+      return {};
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (core::TypedExprs::isConstant(input)) {
+        continue;
+      }
+      auto field = core::TypedExprs::asFieldAccess(input);
+      if (field == nullptr || aggregationInputs.count(field->name()) == 0) {
+        return {};
+      }
+    }
+  }
+
+  std::vector<core::AggregationNode::Aggregate> partialAggregates;
+  std::vector<core::FieldAccessTypedExprPtr> intermediateInputs;
+  std::vector<core::AggregationNode::Aggregate> finalAggregates;
+  for (auto i = 0; i < names.size(); ++i) {
+    const auto& aggregate = aggregation->aggregates()[i];
+    const auto& name = aggregate.call->name();
+    auto intermediateType =
+        Aggregate::intermediateType(name, aggregate.rawInputTypes);
+
+    auto partialAggregate = aggregate;
+    partialAggregate.call = std::make_shared<core::CallTypedExpr>(
+        intermediateType, aggregate.call->inputs(), name);
+    partialAggregates.push_back(std::move(partialAggregate));
+
+    auto intermediate = std::make_shared<core::FieldAccessTypedExpr>(
+        intermediateType, names[i]);
+    intermediateInputs.push_back(intermediate);
+
+    core::AggregationNode::Aggregate finalAggregate;
+    finalAggregate.call = std::make_shared<core::CallTypedExpr>(
+        aggregate.call->type(),
+        std::vector<core::TypedExprPtr>{intermediate},
+        name);
+    finalAggregate.rawInputTypes = aggregate.rawInputTypes;
+    finalAggregates.push_back(std::move(finalAggregate));
+  }
+
+  auto partial = std::make_shared<core::AggregationNode>(
+      aggregation->id(),
+      Step::kPartial,
+      partialKeys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      names,
+      partialAggregates,
+      false,
+      groupId->sources()[0]);
+  auto newGroupId = std::make_shared<core::GroupIdNode>(
+      groupId->id(),
+      groupId->groupingSets(),
+      groupId->groupingKeyInfos(),
+      std::move(intermediateInputs),
+      groupIdName,
+      partial);
+  auto finalAggregation = std::make_shared<core::AggregationNode>(
+      aggregation->id(),
+      Step::kFinal,
+      aggregation->groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      names,
+      finalAggregates,
+      aggregation->globalGroupingSets(),
+      aggregation->groupId(),
+      aggregation->ignoreNullKeys(),
+      newGroupId);
+  return {
+      std::move(partial), std::move(newGroupId), std::move(finalAggregation)};
+}
+
 } // namespace
 
 std::shared_ptr<Driver> DriverFactory::createDriver(
@@ -509,6 +632,30 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto groupIdNode =
             std::dynamic_pointer_cast<const core::GroupIdNode>(planNode)) {
+      if (i < planNodes.size() - 1 &&
+          ctx->queryConfig().groupingSetsPreAggregation()) {
+        auto next = std::dynamic_pointer_cast<const core::AggregationNode>(
+            planNodes[i + 1]);
+        auto nodes = next != nullptr
+            ? preAggregateGroupingSets(groupIdNode, next)
+            : std::vector<core::PlanNodePtr>{};
+        if (!nodes.empty()) {
+          operators.push_back(std::make_unique<HashAggregation>(
+              id,
+              ctx.get(),
+              std::static_pointer_cast<const core::AggregationNode>(nodes[0])));
+          operators.push_back(std::make_unique<GroupId>(
+              id + 1,
+              ctx.get(),
+              std::static_pointer_cast<const core::GroupIdNode>(nodes[1])));
+          operators.push_back(std::make_unique<HashAggregation>(
+              id + 2,
+              ctx.get(),
+              std::static_pointer_cast<const core::AggregationNode>(nodes[2])));
+          i++;
+          continue;
+        }
+      }
       operators.push_back(
           std::make_unique<GroupId>(id, ctx.get(), groupIdNode));
     } else if (
@@ -40,20 +40,38 @@ MarkDistinct::MarkDistinct(
     identityProjections_.emplace_back(i, i);
   }
 
-  // We will use result[0] for distinct mask output.
-  resultProjections_.emplace_back(0, inputType->size());
-
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+  // We will use result[i] for the i-th distinct mask output.
+  const auto& markerNames = planNode->markerNames();
+  const auto& distinctKeySets = planNode->distinctKeySets();
+  std::vector<std::vector<std::string>> keyNames;
+  for (auto i = 0; i < markerNames.size(); ++i) {
+    resultProjections_.emplace_back(i, inputType->size() + i);
+
+    std::vector<std::string> names;
+    for (const auto& key : distinctKeySets[i]) {
+      names.push_back(key->name());
+    }
+    auto it = std::find(keyNames.begin(), keyNames.end(), names);
+    if (it != keyNames.end()) {
+      markerGroupingSets_.push_back(it - keyNames.begin());
+      continue;
+    }
+    markerGroupingSets_.push_back(groupingSets_.size());
+    keyNames.push_back(std::move(names));
+    groupingSets_.push_back(GroupingSet::createForMarkDistinct(
+        inputType,
+        createVectorHashers(inputType, distinctKeySets[i]),
+        operatorCtx_.get(),
+        &nonReclaimableSection_));
+  }
 
-  results_.resize(1);
+  results_.resize(markerNames.size());
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  for (auto& groupingSet : groupingSets_) {
+    groupingSet->addInput(input, false /*mayPushdown*/);
+  }
 
   input_ = std::move(input);
 }
@@ -64,23 +82,26 @@ RowVectorPtr MarkDistinct::getOutput() {
   }
 
   auto outputSize = input_->size();
-  // Re-use memory for the ID vector if possible.
-  VectorPtr& result = results_[0];
-  if (result && result.unique()) {
-    BaseVector::prepareForReuse(result, outputSize);
-  } else {
-    result = BaseVector::create(BOOLEAN(), outputSize, operatorCtx_->pool());
-  }
-
-  // newGroups contains the indices of distinct rows.
-  // For each index in newGroups, we mark the index'th bit true in the result
-  // vector.
-  auto resultBits =
-      results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
-
-  bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
-    bits::setBit(resultBits, i, true);
+  for (auto i = 0; i < results_.size(); ++i) {
+    // Re-use memory for the ID vector if possible.
+    VectorPtr& result = results_[i];
+    if (result && result.unique()) {
+      BaseVector::prepareForReuse(result, outputSize);
+    } else {
+      result = BaseVector::create(BOOLEAN(), outputSize, operatorCtx_->pool());
+    }
+
+    // newGroups contains the indices of distinct rows.
+    // For each index in newGroups, we mark the index'th bit true in the result
+    // vector.
+    auto resultBits =
+        result->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
+
+    bits::fillBits(resultBits, 0, outputSize, false);
+    const auto& groupingSet = groupingSets_[markerGroupingSets_[i]];
+    for (const auto row : groupingSet->hashLookup().newGroups) {
+      bits::setBit(resultBits, row, true);
+    }
   }
   auto output = fillOutput(outputSize, nullptr);
 
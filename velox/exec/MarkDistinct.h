@@ -48,6 +48,11 @@ class MarkDistinct : public Operator {
 
  private:
   // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  // One hash table per distinct set of keys. Markers over the same keys share
+  // a hash table.
+  std::vector<std::unique_ptr<GroupingSet>> groupingSets_;
+
+  // Index into 'groupingSets_' for each marker.
+  std::vector<int32_t> markerGroupingSets_;
 };
 } // namespace facebook::velox::exec
@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/Merge.h"
+
+#include <algorithm>
+
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
 
@@ -304,7 +307,46 @@ MergeExchange::MergeExchange(
           mergeExchangeNode->sortingKeys(),
           mergeExchangeNode->sortingOrders(),
           mergeExchangeNode->id(),
-          "MergeExchange") {}
+          "MergeExchange"),
+      maxBufferSize_(operatorCtx_->driverCtx()
+                         ->queryConfig()
+                         .maxMergeExchangeBufferSize()),
+      adaptiveBuffer_(operatorCtx_->driverCtx()
+                          ->queryConfig()
+                          .mergeExchangeAdaptiveBufferEnabled()) {}
+
+RowVectorPtr MergeExchange::getOutput() {
+  auto output = Merge::getOutput();
+  if (output != nullptr && adaptiveBuffer_ && sources_.size() > 1 &&
+      ++numOutputBatches_ == kRebalanceInterval) {
+    numOutputBatches_ = 0;
+    rebalanceSourceBuffers();
+  }
+  return output;
+}
+
+void MergeExchange::rebalanceSourceBuffers() {
+  std::vector<int64_t> consumedBytes(sources_.size());
+  int64_t totalConsumedBytes = 0;
+  for (auto i = 0; i < sources_.size(); ++i) {
+    consumedBytes[i] = sources_[i]->takeConsumedBytes();
+    totalConsumedBytes += consumedBytes[i];
+  }
+  if (totalConsumedBytes == 0) {
+    return;
+  }
+
+  const int64_t evenShare = maxBufferSize_ / 2 / sources_.size();
+  for (auto i = 0; i < sources_.size(); ++i) {
+    const int64_t share = evenShare +
+        maxBufferSize_ / 2.0 * consumedBytes[i] / totalConsumedBytes;
+    sources_[i]->setMaxQueuedBytes(std::clamp<int64_t>(
+        share,
+        MergeSource::kMaxQueuedBytesAdaptiveLowerLimit,
+        MergeSource::kMaxQueuedBytesUpperLimit));
+  }
+  stats_.wlock()->addRuntimeStat(kNumBufferRebalances, RuntimeCounter(1));
+}
 
 BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   if (operatorCtx_->driverCtx()->driverId != 0) {
@@ -328,14 +370,12 @@ BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
       } else {
         noMoreSplits_ = true;
         if (!remoteSourceTaskIds_.empty()) {
-          const auto maxMergeExchangeBufferSize =
-              operatorCtx_->driverCtx()
-                  ->queryConfig()
-                  .maxMergeExchangeBufferSize();
           const auto maxQueuedBytesPerSource = std::min<int64_t>(
               std::max<int64_t>(
-                  maxMergeExchangeBufferSize / remoteSourceTaskIds_.size(),
-                  MergeSource::kMaxQueuedBytesLowerLimit),
+                  maxBufferSize_ / remoteSourceTaskIds_.size(),
+                  adaptiveBuffer_
+                      ? MergeSource::kMaxQueuedBytesAdaptiveLowerLimit
+                      : MergeSource::kMaxQueuedBytesLowerLimit),
               MergeSource::kMaxQueuedBytesUpperLimit);
           for (uint32_t remoteSourceIndex = 0;
                remoteSourceIndex < remoteSourceTaskIds_.size();
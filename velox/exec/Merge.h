@@ -186,15 +186,33 @@ class LocalMerge : public Merge {
 // and may be generated by a different task.
 class MergeExchange : public Merge {
  public:
+  /// Number of output batches between resizing the source buffers when
+  /// QueryConfig::kMergeExchangeAdaptiveBufferEnabled is set.
+  static constexpr int32_t kRebalanceInterval = 8;
+
+  static inline const std::string kNumBufferRebalances{"numBufferRebalances"};
+
   MergeExchange(
       int32_t operatorId,
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  RowVectorPtr getOutput() override;
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
  private:
+  // Divides 'maxBufferSize_' among the sources, half evenly and half in
+  // proportion to the bytes consumed from each since the previous call.
+  void rebalanceSourceBuffers();
+
+  const int64_t maxBufferSize_;
+  const bool adaptiveBuffer_;
+
+  // Number of output batches since the last rebalanceSourceBuffers().
+  int32_t numOutputBatches_{0};
+
   bool noMoreSplits_ = false;
   // Task Ids from all the splits we took to process so far.
   std::vector<std::string> remoteSourceTaskIds_;
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/exec/MergeJoin.h"
+
+#include <algorithm>
+#include <numeric>
+
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -209,6 +213,58 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+// static
+MergeJoin::KeyValues MergeJoin::keyValues(
+    const RowVectorPtr& batch,
+    const std::vector<column_index_t>& keys) {
+  if (keys.size() != 1) {
+    return {};
+  }
+  const auto* key = batch->childAt(keys[0])->loadedVector();
+  if (!key->isFlatEncoding() || key->mayHaveNulls()) {
+    return {};
+  }
+  switch (key->typeKind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return {key->typeKind(), key->valuesAsVoid()};
+    default:
+      return {};
+  }
+}
+
+namespace {
+// Returns the first row in [begin, end) for which 'predicate' is false,
+// assuming that 'predicate' is true for a prefix of the range. Probes rows at
+// exponentially growing distances from 'begin' and then binary searches the
+// last interval. A short run costs a few comparisons and a run of n rows
+// costs O(log(n)) comparisons.
+template <typename Predicate>
+vector_size_t
+gallop(vector_size_t begin, vector_size_t end, Predicate predicate) {
+  // 'predicate' is true for all rows in [begin, low).
+  vector_size_t low = begin;
+  vector_size_t high = begin;
+  vector_size_t step = 1;
+  while (high < end && predicate(high)) {
+    low = high + 1;
+    high = std::min(end, high + step);
+    step *= 2;
+  }
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    if (predicate(middle)) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+} // namespace
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -223,9 +279,17 @@ bool MergeJoin::findEndOfMatch(
   auto numInput = input->size();
 
   vector_size_t endIndex = 0;
-  while (endIndex < numInput &&
-         compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
-    ++endIndex;
+  const auto values = keyValues(input, keys);
+  const auto prevValues = keyValues(prevInput, keys);
+  if (values.valid() && prevValues.valid()) {
+    const auto key = prevValues.at(prevIndex);
+    endIndex = gallop(
+        0, numInput, [&](auto row) { return values.at(row) == key; });
+  } else {
+    while (endIndex < numInput &&
+           compare(keys, input, endIndex, keys, prevInput, prevIndex) == 0) {
+      ++endIndex;
+    }
   }
 
   if (endIndex == numInput) {
@@ -324,6 +388,20 @@ void MergeJoin::addOutputRow(
   ++outputSize_;
 }
 
+void MergeJoin::addOutputRows(
+    vector_size_t leftIndex,
+    vector_size_t rightIndex,
+    vector_size_t numRows) {
+  VELOX_DCHECK(filter_ == nullptr);
+  VELOX_DCHECK(!isRightFlattened_);
+  std::fill_n(rawLeftIndices_ + outputSize_, numRows, leftIndex);
+  std::iota(
+      rawRightIndices_ + outputSize_,
+      rawRightIndices_ + outputSize_ + numRows,
+      rightIndex);
+  outputSize_ += numRows;
+}
+
 bool MergeJoin::prepareOutput(
     const RowVectorPtr& newLeft,
     const RowVectorPtr& right) {
@@ -491,7 +569,7 @@ bool MergeJoin::addToOutput() {
           rightEnd = rightStart + 1;
         }
 
-        for (auto j = rightStart; j < rightEnd; ++j) {
+        for (auto j = rightStart; j < rightEnd;) {
           if (outputSize_ == outputBatchSize_) {
             // If we run out of space in the current output_, we will need to
             // produce a buffer and continue processing left later. In this
@@ -502,7 +580,16 @@ bool MergeJoin::addToOutput() {
             rightMatch_->setCursor(r, j);
             return true;
           }
-          addOutputRow(left, i, right, j);
+          if (filter_ == nullptr && !isRightFlattened_) {
+            // Adds as many of the matching right rows as fit in one go.
+            const auto numRows =
+                std::min(rightEnd - j, outputBatchSize_ - outputSize_);
+            addOutputRows(i, j, numRows);
+            j += numRows;
+          } else {
+            addOutputRow(left, i, right, j);
+            ++j;
+          }
         }
       }
     }
@@ -713,6 +800,12 @@ RowVectorPtr MergeJoin::doGetOutput() {
   // row on the right.
   auto compareResult = compare();
 
+  // Raw key values if both sides have a single integer key without nulls.
+  // input_ and rightInput_ do not change in the loop below unless it returns.
+  const auto leftValues = keyValues(input_, leftKeys_);
+  const auto rightValues = keyValues(rightInput_, rightKeys_);
+  const bool rawKeys = leftValues.valid() && rightValues.valid();
+
   for (;;) {
     // Catch up input_ with rightInput_.
     while (compareResult < 0) {
@@ -730,7 +823,15 @@ RowVectorPtr MergeJoin::doGetOutput() {
         addOutputRowForLeftJoin(input_, index_);
       }
 
-      ++index_;
+      if (rawKeys && !isLeftJoin(joinType_)) {
+        // Skips all left rows with keys below the right key.
+        const auto rightKey = rightValues.at(rightIndex_);
+        index_ = gallop(index_ + 1, input_->size(), [&](auto row) {
+          return leftValues.at(row) < rightKey;
+        });
+      } else {
+        ++index_;
+      }
       if (index_ == input_->size()) {
         // Ran out of rows on the left side.
         input_ = nullptr;
@@ -741,7 +842,16 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      if (rawKeys) {
+        // Skips all right rows with keys below the left key.
+        const auto leftKey = leftValues.at(index_);
+        rightIndex_ =
+            gallop(rightIndex_ + 1, rightInput_->size(), [&](auto row) {
+              return rightValues.at(row) < leftKey;
+            });
+      } else {
+        rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      }
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -754,8 +864,15 @@ RowVectorPtr MergeJoin::doGetOutput() {
       // Found a match. Identify all rows on the left and right that have the
       // matching keys.
       vector_size_t endIndex = index_ + 1;
-      while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
-        ++endIndex;
+      if (rawKeys) {
+        const auto key = leftValues.at(index_);
+        endIndex = gallop(endIndex, input_->size(), [&](auto row) {
+          return leftValues.at(row) == key;
+        });
+      } else {
+        while (endIndex < input_->size() && compareLeft(endIndex) == 0) {
+          ++endIndex;
+        }
       }
 
       if (endIndex == input_->size()) {
@@ -766,9 +883,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
           {input_}, index_, endIndex, endIndex < input_->size(), std::nullopt};
 
       vector_size_t endRightIndex = rightIndex_ + 1;
-      while (endRightIndex < rightInput_->size() &&
-             compareRight(endRightIndex) == 0) {
-        ++endRightIndex;
+      if (rawKeys) {
+        const auto key = rightValues.at(rightIndex_);
+        endRightIndex =
+            gallop(endRightIndex, rightInput_->size(), [&](auto row) {
+              return rightValues.at(row) == key;
+            });
+      } else {
+        while (endRightIndex < rightInput_->size() &&
+               compareRight(endRightIndex) == 0) {
+          ++endRightIndex;
+        }
       }
 
       rightMatch_ = Match{
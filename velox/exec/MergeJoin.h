@@ -121,6 +121,39 @@ class MergeJoin : public Operator {
         rightKeys_, batch, index, rightKeys_, otherBatch, otherIndex);
   }
 
+  // Raw values of a single integer join key of a batch. Valid only if the key
+  // is flat and has no nulls. Lets the search for the end of a run of equal
+  // keys and the catch-up of one side with the other skip many rows with a
+  // galloping search instead of comparing rows one at a time.
+  struct KeyValues {
+    TypeKind kind{TypeKind::UNKNOWN};
+    const void* values{nullptr};
+
+    bool valid() const {
+      return values != nullptr;
+    }
+
+    int64_t at(vector_size_t row) const {
+      switch (kind) {
+        case TypeKind::TINYINT:
+          return static_cast<const int8_t*>(values)[row];
+        case TypeKind::SMALLINT:
+          return static_cast<const int16_t*>(values)[row];
+        case TypeKind::INTEGER:
+          return static_cast<const int32_t*>(values)[row];
+        default:
+          return static_cast<const int64_t*>(values)[row];
+      }
+    }
+  };
+
+  // Returns the values of the join key of 'batch' if 'keys' is a single
+  // TINYINT, SMALLINT, INTEGER or BIGINT column that is flat and has no nulls.
+  // Returns invalid KeyValues otherwise.
+  static KeyValues keyValues(
+      const RowVectorPtr& batch,
+      const std::vector<column_index_t>& keys);
+
   /// Describes a contiguous set of rows on the left or right side of the join
   /// with all join keys being the same. The set of rows may span multiple
   /// batches of input.
@@ -200,6 +233,17 @@ class MergeJoin : public Operator {
       const RowVectorPtr& right,
       vector_size_t rightIndex);
 
+  // Adds 'numRows' rows of output pairing 'leftIndex' with the consecutive
+  // right rows starting at 'rightIndex'. Used instead of addOutputRow() when
+  // there is no filter and the right side projections are not flattened, so
+  // that only the dictionary indices need to be written.
+  //
+  // Advances outputSize_. Assumes that dictionary indices in output_ have room.
+  void addOutputRows(
+      vector_size_t leftIndex,
+      vector_size_t rightIndex,
+      vector_size_t numRows);
+
   // If the right side projected columns in the current output vector happen to
   // span more than one vector from the right side, they cannot be simply
   // wrapped in a dictionary and must be flattened.
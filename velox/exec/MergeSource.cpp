@@ -154,6 +154,7 @@ class MergeExchangeSource : public MergeSource {
       }
     }
     if (!inputStream_.has_value()) {
+      consumedBytes_ += currentPage_->size();
       mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
       inputStream_.emplace(currentPage_->prepareStreamForDeserialize());
     }
@@ -188,12 +189,24 @@ class MergeExchangeSource : public MergeSource {
     }
   }
 
+  int64_t takeConsumedBytes() override {
+    return std::exchange(consumedBytes_, 0);
+  }
+
+  void setMaxQueuedBytes(int64_t maxQueuedBytes) override {
+    if (client_) {
+      client_->setMaxQueuedBytes(maxQueuedBytes);
+    }
+  }
+
  private:
   MergeExchange* const mergeExchange_;
   std::shared_ptr<ExchangeClient> client_;
   std::optional<ByteInputStream> inputStream_;
   std::unique_ptr<SerializedPage> currentPage_;
   bool atEnd_ = false;
+  // Bytes of the pages started since the last takeConsumedBytes().
+  int64_t consumedBytes_{0};
 
   BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future) override {
     VELOX_FAIL();
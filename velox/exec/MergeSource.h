@@ -25,6 +25,9 @@ class MergeSource {
  public:
   static constexpr int32_t kMaxQueuedBytesUpperLimit = 32 << 20; // 32 MB.
   static constexpr int32_t kMaxQueuedBytesLowerLimit = 1 << 20; // 1 MB.
+  /// Lower limit per source when the buffer sizes adapt to the consumption
+  /// rate. Sources always fetch at least one page.
+  static constexpr int32_t kMaxQueuedBytesAdaptiveLowerLimit = 64 << 10;
 
   virtual ~MergeSource() {}
 
@@ -36,6 +39,16 @@ class MergeSource {
 
   virtual void close() = 0;
 
+  /// Returns the bytes returned by next() since the previous call. Used to
+  /// size the buffers of the sources by their consumption rate.
+  virtual int64_t takeConsumedBytes() {
+    return 0;
+  }
+
+  /// Changes the most bytes buffered ahead of next(). No-op for sources with
+  /// a fixed size buffer.
+  virtual void setMaxQueuedBytes(int64_t /*maxQueuedBytes*/) {}
+
   // Factory methods to create MergeSources.
   static std::shared_ptr<MergeSource> createLocalMergeSource();
 
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinProbe.h"
+
+#include <algorithm>
+
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -42,6 +45,70 @@ std::vector<IdentityProjection> extractProjections(
   }
   return projections;
 }
+
+// Returns the name of the input column 'expr' refers to or nullptr if 'expr'
+// is not an input column.
+const std::string* inputColumnName(const core::TypedExprPtr& expr) {
+  auto field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  return field != nullptr && field->isInputColumn() ? &field->name() : nullptr;
+}
+
+bool isBandKeyType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Calls 'addBound(smaller, larger)' for each conjunct of 'expr' that implies
+// 'smaller <= larger'.
+void collectBounds(
+    const core::TypedExprPtr& expr,
+    const std::function<void(
+        const core::TypedExprPtr& smaller,
+        const core::TypedExprPtr& larger)>& addBound) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  const auto& name = call->name();
+  const auto& inputs = call->inputs();
+  if (name == "and") {
+    for (const auto& input : inputs) {
+      collectBounds(input, addBound);
+    }
+  } else if ((name == "lt" || name == "lte") && inputs.size() == 2) {
+    addBound(inputs[0], inputs[1]);
+  } else if ((name == "gt" || name == "gte") && inputs.size() == 2) {
+    addBound(inputs[1], inputs[0]);
+  } else if (name == "eq" && inputs.size() == 2) {
+    addBound(inputs[0], inputs[1]);
+    addBound(inputs[1], inputs[0]);
+  } else if (name == "between" && inputs.size() == 3) {
+    addBound(inputs[1], inputs[0]);
+    addBound(inputs[0], inputs[2]);
+  }
+}
+
+int64_t integerAt(const DecodedVector& decoded, vector_size_t row) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
 } // namespace
 
 NestedLoopJoinProbe::NestedLoopJoinProbe(
@@ -72,6 +139,10 @@ void NestedLoopJoinProbe::initialize() {
         joinNode_->joinCondition(),
         joinNode_->sources()[0]->outputType(),
         joinNode_->sources()[1]->outputType());
+    initializeBandJoin(
+        joinNode_->joinCondition(),
+        joinNode_->sources()[0]->outputType(),
+        joinNode_->sources()[1]->outputType());
   }
 
   joinNode_.reset();
@@ -104,6 +175,10 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
         }
       }
 
+      if (isBandJoin()) {
+        initializeBandIndices();
+      }
+
       setState(ProbeOperatorState::kRunning);
       return BlockingReason::kNotBlocked;
     }
@@ -135,6 +210,15 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  if (isBandJoin()) {
+    const SelectivityVector rows(input_->size());
+    if (upperBound_.has_value()) {
+      probeUpper_.decode(*input_->childAt(upperBound_->probeChannel), rows);
+    }
+    if (lowerBound_.has_value()) {
+      probeLower_.decode(*input_->childAt(lowerBound_->probeChannel), rows);
+    }
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -142,6 +226,7 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       state_ == ProbeOperatorState::kWaitForPeers) {
     return nullptr;
   }
+  outputBatchSize_ = outputBatchRows();
   RowVectorPtr output{nullptr};
   while (output == nullptr) {
     if (lastProbe_) {
@@ -181,7 +266,8 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
+    const vector_size_t probeCnt =
+        isBandJoin() ? getNumBandProbeRows() : getNumProbeRows();
     output = doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
       if (!needsProbeMismatch(joinType_)) {
@@ -235,6 +321,99 @@ void NestedLoopJoinProbe::initializeFilter(
   filterInputType_ = ROW(std::move(names), std::move(types));
 }
 
+void NestedLoopJoinProbe::initializeBandJoin(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  // Filter fields are looked up on the probe side first, see
+  // initializeFilter().
+  auto probeChannel = [&](const std::string& name) {
+    return probeType->getChildIdxIfExists(name);
+  };
+  auto buildChannel = [&](const std::string& name) {
+    return probeChannel(name).has_value()
+        ? std::nullopt
+        : buildType->getChildIdxIfExists(name);
+  };
+  collectBounds(filter, [&](const auto& smaller, const auto& larger) {
+    const auto* smallerName = inputColumnName(smaller);
+    const auto* largerName = inputColumnName(larger);
+    if (smallerName == nullptr || largerName == nullptr ||
+        !isBandKeyType(smaller->type()) ||
+        !smaller->type()->equivalent(*larger->type())) {
+      return;
+    }
+    const auto smallerBuild = buildChannel(*smallerName);
+    const auto largerProbe = probeChannel(*largerName);
+    if (smallerBuild.has_value() && largerProbe.has_value()) {
+      if (!upperBound_.has_value()) {
+        upperBound_ = BandBound{smallerBuild.value(), largerProbe.value()};
+      }
+      return;
+    }
+    const auto largerBuild = buildChannel(*largerName);
+    const auto smallerProbe = probeChannel(*smallerName);
+    if (largerBuild.has_value() && smallerProbe.has_value() &&
+        !lowerBound_.has_value()) {
+      lowerBound_ = BandBound{largerBuild.value(), smallerProbe.value()};
+    }
+  });
+}
+
+void NestedLoopJoinProbe::initializeBandIndices() {
+  const auto& buildVectors = buildVectors_.value();
+  bandIndices_.resize(buildVectors.size());
+  DecodedVector upper;
+  DecodedVector lower;
+  std::vector<std::pair<int64_t, vector_size_t>> keys;
+  for (auto i = 0; i < buildVectors.size(); ++i) {
+    const auto& data = buildVectors[i];
+    const SelectivityVector rows(data->size());
+    if (upperBound_.has_value()) {
+      upper.decode(*data->childAt(upperBound_->buildChannel), rows);
+    }
+    if (lowerBound_.has_value()) {
+      lower.decode(*data->childAt(lowerBound_->buildChannel), rows);
+    }
+
+    // Rows with a null in a bounded column never match.
+    keys.clear();
+    for (auto row = 0; row < data->size(); ++row) {
+      if (upperBound_.has_value() && upper.isNullAt(row)) {
+        continue;
+      }
+      if (lowerBound_.has_value() && lower.isNullAt(row)) {
+        continue;
+      }
+      keys.emplace_back(
+          upperBound_.has_value() ? integerAt(upper, row)
+                                  : integerAt(lower, row),
+          row);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    auto& index = bandIndices_[i];
+    index.rows.resize(keys.size());
+    for (auto j = 0; j < keys.size(); ++j) {
+      index.rows[j] = keys[j].second;
+    }
+    if (upperBound_.has_value()) {
+      index.upper.resize(keys.size());
+      for (auto j = 0; j < keys.size(); ++j) {
+        index.upper[j] = keys[j].first;
+      }
+    }
+    if (lowerBound_.has_value()) {
+      index.maxLower.resize(keys.size());
+      int64_t maxLower = std::numeric_limits<int64_t>::min();
+      for (auto j = 0; j < keys.size(); ++j) {
+        maxLower = std::max(maxLower, integerAt(lower, keys[j].second));
+        index.maxLower[j] = maxLower;
+      }
+    }
+  }
+}
+
 RowVectorPtr NestedLoopJoinProbe::getMismatchedOutput(
     const RowVectorPtr& data,
     const SelectivityVector& matched,
@@ -366,6 +545,98 @@ vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   return numProbeRows;
 }
 
+vector_size_t NestedLoopJoinProbe::getNumBandProbeRows() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  // The candidates of a probe row are the build rows with upper <= probe
+  // value and with maxLower >= probe value. Both are ranges of the sorted
+  // rows since 'upper' is sorted and 'maxLower' is a running maximum.
+  const auto& index = bandIndices_[buildIndex_];
+  const vector_size_t numRows = index.rows.size();
+  bandRanges_.clear();
+  vector_size_t numCandidates = 0;
+  auto row = probeRow_;
+  for (; row < input_->size(); ++row) {
+    vector_size_t begin = 0;
+    vector_size_t end = numRows;
+    if ((upperBound_.has_value() && probeUpper_.isNullAt(row)) ||
+        (lowerBound_.has_value() && probeLower_.isNullAt(row))) {
+      end = 0;
+    } else {
+      if (upperBound_.has_value()) {
+        end = std::upper_bound(
+                  index.upper.begin(),
+                  index.upper.end(),
+                  integerAt(probeUpper_, row)) -
+            index.upper.begin();
+      }
+      if (lowerBound_.has_value()) {
+        begin = std::lower_bound(
+                    index.maxLower.begin(),
+                    index.maxLower.end(),
+                    integerAt(probeLower_, row)) -
+            index.maxLower.begin();
+      }
+      end = std::max(begin, end);
+    }
+    if (row > probeRow_ && numCandidates + end - begin > outputBatchSize_) {
+      break;
+    }
+    bandRanges_.emplace_back(begin, end);
+    numCandidates += end - begin;
+  }
+  return row - probeRow_;
+}
+
+RowVectorPtr NestedLoopJoinProbe::getBandProduct() {
+  vector_size_t numOutputRows = 0;
+  for (const auto& [begin, end] : bandRanges_) {
+    numOutputRows += end - begin;
+  }
+  if (numOutputRows == 0) {
+    return nullptr;
+  }
+
+  const auto& rows = bandIndices_[buildIndex_].rows;
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, numOutputRows, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, numOutputRows, pool());
+  vector_size_t numRows = 0;
+  for (auto i = 0; i < bandRanges_.size(); ++i) {
+    const auto [begin, end] = bandRanges_[i];
+    for (auto j = begin; j < end; ++j) {
+      rawProbeIndices[numRows] = probeRow_ + i;
+      rawBuildIndices[numRows] = rows[j];
+      ++numRows;
+    }
+  }
+  // The build indices no longer hold a cross product.
+  numPrevProbedRows_ = 0;
+
+  std::vector<VectorPtr> projectedChildren(filterInputType_->size());
+  projectChildren(
+      projectedChildren,
+      input_,
+      filterProbeProjections_,
+      numOutputRows,
+      probeIndices_);
+  projectChildren(
+      projectedChildren,
+      buildVectors_.value()[buildIndex_],
+      filterBuildProjections_,
+      numOutputRows,
+      buildIndices_);
+
+  return std::make_shared<RowVector>(
+      pool(),
+      filterInputType_,
+      nullptr,
+      numOutputRows,
+      std::move(projectedChildren));
+}
+
 RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
     vector_size_t probeCnt,
     const RowTypePtr& outputType,
@@ -440,11 +711,15 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
         probeCnt, outputType_, identityProjections_, buildProjections_);
   }
 
-  auto filterInput = getCrossProduct(
-      probeCnt,
-      filterInputType_,
-      filterProbeProjections_,
-      filterBuildProjections_);
+  auto filterInput = isBandJoin() ? getBandProduct()
+                                  : getCrossProduct(
+                                        probeCnt,
+                                        filterInputType_,
+                                        filterProbeProjections_,
+                                        filterBuildProjections_);
+  if (filterInput == nullptr) {
+    return nullptr;
+  }
 
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
@@ -56,12 +56,35 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
+  // Sets 'upperBound_' and 'lowerBound_' from the conjuncts of 'filter' that
+  // compare an integer build side column with a probe side column, e.g.
+  // 'p.x BETWEEN b.lo AND b.hi' or 'b.ts < p.ts'.
+  void initializeBandJoin(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // True if the join condition bounds a build side column by a probe side
+  // column. The build rows that can match a probe row are then found with a
+  // binary search over sorted build rows instead of matching all build rows.
+  bool isBandJoin() const {
+    return upperBound_.has_value() || lowerBound_.has_value();
+  }
+
+  // Sorts the rows of each build vector for the band join.
+  void initializeBandIndices();
+
   bool getBuildData(ContinueFuture* future);
 
   // Calculates the number of probe rows to match with the build side vectors
   // given the output batch size limit.
   vector_size_t getNumProbeRows() const;
 
+  // Band join counterpart of getNumProbeRows(). Sets 'bandRanges_' to the
+  // candidate build rows of the next probe rows until the candidates fill an
+  // output batch. Returns the number of probe rows.
+  vector_size_t getNumBandProbeRows();
+
   // Generates cross product of next 'probeCnt' rows of input_, and all rows of
   // build side vector at 'buildIndex_' in 'buildData_'.
   // 'outputType' specifies the type of output.
@@ -77,6 +100,11 @@ class NestedLoopJoinProbe : public Operator {
       const std::vector<IdentityProjection>& probeProjections,
       const std::vector<IdentityProjection>& buildProjections);
 
+  // Generates the pairs of the next probe rows and their candidate build rows
+  // in 'bandRanges_' projected to 'filterInputType_'. Returns nullptr if there
+  // are no candidates.
+  RowVectorPtr getBandProduct();
+
   // Evaluates joinCondition against the output of getCrossProduct(probeCnt),
   // returns the result that passed joinCondition, updates probeMatched_,
   // buildMatched_ accordingly.
@@ -115,14 +143,35 @@ class NestedLoopJoinProbe : public Operator {
         noMoreInput_;
   }
 
+  // A build side column bounded by a probe side column in the join condition.
+  struct BandBound {
+    column_index_t buildChannel;
+    column_index_t probeChannel;
+  };
+
+  // Rows of a build vector sorted for the band join.
+  struct BandIndex {
+    // Rows without nulls in the bounded columns, sorted on the column of
+    // 'upperBound_' or on the column of 'lowerBound_' if there is no upper
+    // bound.
+    std::vector<vector_size_t> rows;
+    // Values of the column of 'upperBound_' for 'rows'. Empty if there is no
+    // upper bound.
+    std::vector<int64_t> upper;
+    // Running maximum of the column of 'lowerBound_' over 'rows'. Empty if
+    // there is no lower bound.
+    std::vector<int64_t> maxLower;
+  };
+
   // TODO: Add state transition check.
   void setState(ProbeOperatorState state) {
     state_ = state;
   }
 
  private:
-  // Maximum number of rows in the output batch.
-  const uint32_t outputBatchSize_;
+  // Maximum number of rows in the output batch. Updated before each batch if
+  // QueryConfig::kAdaptiveOutputBatchSizeEnabled is set.
+  uint32_t outputBatchSize_;
   std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
   const core::JoinType joinType_;
 
@@ -134,6 +183,21 @@ class NestedLoopJoinProbe : public Operator {
   RowTypePtr filterInputType_;
   SelectivityVector filterInputRows_;
 
+  // Band join state. A build side column that is less than or equal to a
+  // probe side column for all matches.
+  std::optional<BandBound> upperBound_;
+  // A build side column that is greater than or equal to a probe side column
+  // for all matches.
+  std::optional<BandBound> lowerBound_;
+  // One per build vector.
+  std::vector<BandIndex> bandIndices_;
+  // Probe side columns of 'upperBound_' and 'lowerBound_' for input_.
+  DecodedVector probeUpper_;
+  DecodedVector probeLower_;
+  // Ranges of BandIndex::rows of the current build vector that are the
+  // candidate matches of the probe rows starting at 'probeRow_'.
+  std::vector<std::pair<vector_size_t, vector_size_t>> bandRanges_;
+
   // Probe side state
   // Input row to process on next call to getOutput().
   vector_size_t probeRow_{0};
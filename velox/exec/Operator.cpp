@@ -52,9 +52,10 @@ OperatorCtx::createConnectorQueryCtx(
     const std::string& connectorId,
     const std::string& planNodeId,
     memory::MemoryPool* connectorPool,
-    const common::SpillConfig* spillConfig) const {
+    const common::SpillConfig* spillConfig,
+    memory::MemoryPool* leafPool) const {
   return std::make_shared<connector::ConnectorQueryCtx>(
-      pool_,
+      leafPool != nullptr ? leafPool : pool_,
       connectorPool,
       driverCtx_->task->queryCtx()->connectorSessionProperties(connectorId),
       spillConfig,
@@ -257,6 +258,10 @@ uint32_t Operator::outputBatchRows(
     std::optional<uint64_t> averageRowSize) const {
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
 
+  if (!averageRowSize.has_value() &&
+      queryConfig.adaptiveOutputBatchSizeEnabled()) {
+    averageRowSize = averageOutputRowSize();
+  }
   if (!averageRowSize.has_value()) {
     return queryConfig.preferredOutputBatchRows();
   }
@@ -271,6 +276,17 @@ uint32_t Operator::outputBatchRows(
       queryConfig.preferredOutputBatchBytes() / rowSize, 1);
 }
 
+std::optional<uint64_t> Operator::averageOutputRowSize() const {
+  // Fewer rows may not be representative.
+  static constexpr uint64_t kMinRows = 100;
+  const auto lockedStats = stats_.rlock();
+  if (lockedStats->outputPositions < kMinRows ||
+      lockedStats->outputBytes == 0) {
+    return std::nullopt;
+  }
+  return lockedStats->outputBytes / lockedStats->outputPositions;
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -296,6 +312,24 @@ void Operator::recordSpillStats() {
   lockedStats->spilledRows += lockedSpillStats->spilledRows;
   lockedStats->spilledPartitions += lockedSpillStats->spilledPartitions;
   lockedStats->spilledFiles += lockedSpillStats->spilledFiles;
+  const auto level = spillLevel();
+  if (level.has_value() && lockedSpillStats->spilledRows != 0) {
+    const auto levelSuffix = std::to_string(level.value());
+    lockedStats->addRuntimeStat(
+        kSpilledRowsAtLevel + levelSuffix,
+        RuntimeCounter{static_cast<int64_t>(lockedSpillStats->spilledRows)});
+    lockedStats->addRuntimeStat(
+        kSpilledBytesAtLevel + levelSuffix,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledBytes),
+            RuntimeCounter::Unit::kBytes});
+    lockedStats->addRuntimeStat(
+        kSpilledPartitionsAtLevel + levelSuffix,
+        RuntimeCounter{
+            static_cast<int64_t>(lockedSpillStats->spilledPartitions)});
+    common::updateGlobalSpillLevelStats(
+        level.value(), lockedSpillStats->spilledRows);
+  }
   if (lockedSpillStats->spillFillTimeUs != 0) {
     lockedStats->addRuntimeStat(
         kSpillFillTime,
@@ -262,12 +262,14 @@ class OperatorCtx {
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
-  /// for connector use.
+  /// for connector use. 'leafPool' is the pool for the allocations of the
+  /// connector and defaults to the pool of the operator.
   std::shared_ptr<connector::ConnectorQueryCtx> createConnectorQueryCtx(
       const std::string& connectorId,
       const std::string& planNodeId,
       memory::MemoryPool* connectorPool,
-      const common::SpillConfig* spillConfig = nullptr) const;
+      const common::SpillConfig* spillConfig = nullptr,
+      memory::MemoryPool* leafPool = nullptr) const;
 
  private:
   DriverCtx* const driverCtx_;
@@ -341,6 +343,13 @@ class Operator : public BaseRuntimeStatWriter {
   static inline const std::string kSpillRuns{"spillRuns"};
   static inline const std::string kExceededMaxSpillLevel{
       "exceededMaxSpillLevel"};
+  /// The spill write stats broken down by spill level for the operators that
+  /// spill recursively. The level is appended to the name, e.g.
+  /// 'spilledRowsLevel1' is the number of rows spilled at level 1.
+  static inline const std::string kSpilledRowsAtLevel{"spilledRowsLevel"};
+  static inline const std::string kSpilledBytesAtLevel{"spilledBytesLevel"};
+  static inline const std::string kSpilledPartitionsAtLevel{
+      "spilledPartitionsLevel"};
   /// The spill read stats.
   static inline const std::string kSpillReadBytes{"spillReadBytes"};
   static inline const std::string kSpillReads{"spillReads"};
@@ -478,6 +487,14 @@ class Operator : public BaseRuntimeStatWriter {
     return false;
   }
 
+  /// Returns true if dropping an input row only drops the output rows produced
+  /// from it and leaves the other output rows unchanged. A filter that a
+  /// downstream operator would apply to its own input, e.g. the TopN
+  /// threshold, can be pushed down only through such operators.
+  virtual bool isRowIndependent() const {
+    return false;
+  }
+
   /// Returns copy of operator stats. If 'clear' is true, the function also
   /// clears the operator stats after retrieval.
   virtual OperatorStats stats(bool clear);
@@ -738,13 +755,29 @@ class Operator : public BaseRuntimeStatWriter {
   /// number of rows at 10K and returns at least one row. The averageRowSize
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
-  /// preferredOutputBatchRows.
+  /// preferredOutputBatchRows, unless kAdaptiveOutputBatchSizeEnabled is set
+  /// and rows have been produced, in which case the average size of the rows
+  /// produced so far is used.
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
-  /// Invoked to record spill stats in operator stats.
+  /// Returns the average estimated flat size of the rows produced so far or
+  /// std::nullopt if there are not enough rows for an estimate.
+  std::optional<uint64_t> averageOutputRowSize() const;
+
+  /// Invoked to record spill stats in operator stats. The write stats are
+  /// also recorded under the spill level returned by spillLevel() if any.
+  /// Operators that spill at multiple levels call this before switching to
+  /// the next level.
   virtual void recordSpillStats();
 
+  /// Returns the spill level of the spill stats collected since the last
+  /// recordSpillStats(), or std::nullopt if the operator doesn't spill
+  /// recursively.
+  virtual std::optional<int32_t> spillLevel() const {
+    return std::nullopt;
+  }
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/OperatorUtils.h"
+
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/vector/ConstantVector.h"
@@ -255,6 +258,57 @@ vector_size_t processFilterResults(
   }
 }
 
+namespace {
+// Combined indices of a dictionary child and a mapping, keyed on the indices
+// buffer of the child. Children of the same input often share their indices.
+using CombinedIndices = folly::F14FastMap<const Buffer*, BufferPtr>;
+
+// Returns true if 'child' is a dictionary whose indices can be combined with
+// a mapping. Dictionaries that add nulls are left as is. So are dictionaries
+// over a LazyVector that is not loaded, which must not be wrapped into two
+// different dictionaries.
+bool canCombineIndices(const BaseVector& child) {
+  return child.encoding() == VectorEncoding::Simple::DICTIONARY &&
+      child.rawNulls() == nullptr && !isLazyNotLoaded(*child.valueVector());
+}
+
+// Wraps 'child' into a dictionary using 'mapping'. A dictionary child is
+// replaced by a single dictionary over its base with the combined indices, so
+// that the depth of dictionaries does not grow with every filter and join in
+// a pipeline and consumers decode one level.
+VectorPtr wrapChildCombined(
+    vector_size_t size,
+    const BufferPtr& mapping,
+    const VectorPtr& child,
+    CombinedIndices* combinedIndices) {
+  if (!canCombineIndices(*child)) {
+    return BaseVector::wrapInDictionary(nullptr, mapping, size, child);
+  }
+  const auto* childIndices = child->wrapInfo().get();
+  BufferPtr indices;
+  if (combinedIndices != nullptr) {
+    auto it = combinedIndices->find(childIndices);
+    if (it != combinedIndices->end()) {
+      indices = it->second;
+    }
+  }
+  if (indices == nullptr) {
+    indices = allocateIndices(size, child->pool());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    const auto* rawMapping = mapping->as<vector_size_t>();
+    const auto* rawChildIndices = childIndices->as<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      rawIndices[i] = rawChildIndices[rawMapping[i]];
+    }
+    if (combinedIndices != nullptr) {
+      combinedIndices->emplace(childIndices, indices);
+    }
+  }
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), size, child->valueVector());
+}
+} // namespace
+
 VectorPtr wrapChild(
     vector_size_t size,
     BufferPtr mapping,
@@ -263,6 +317,9 @@ VectorPtr wrapChild(
   if (!mapping) {
     return child;
   }
+  if (nulls == nullptr) {
+    return wrapChildCombined(size, mapping, child, nullptr);
+  }
 
   return BaseVector::wrapInDictionary(nulls, mapping, size, child);
 }
@@ -292,8 +349,10 @@ RowVectorPtr wrap(
   }
   std::vector<VectorPtr> wrappedChildren;
   wrappedChildren.reserve(childVectors.size());
+  CombinedIndices combinedIndices;
   for (auto& child : childVectors) {
-    wrappedChildren.emplace_back(wrapChild(size, mapping, child));
+    wrappedChildren.emplace_back(
+        wrapChildCombined(size, mapping, child, &combinedIndices));
   }
   return std::make_shared<RowVector>(
       pool, rowType, nullptr, size, wrappedChildren);
@@ -389,10 +448,17 @@ void aggregateOperatorRuntimeStats(
 folly::Range<vector_size_t*> initializeRowNumberMapping(
     BufferPtr& mapping,
     vector_size_t size,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    VectorPool* vectorPool) {
   if (!mapping || !mapping->unique() ||
       mapping->size() < sizeof(vector_size_t) * size) {
-    mapping = allocateIndices(size, pool);
+    if (vectorPool == nullptr) {
+      mapping = allocateIndices(size, pool);
+    } else {
+      const auto bytes = sizeof(vector_size_t) * size;
+      mapping = vectorPool->getBuffer(bytes);
+      memset(mapping->asMutable<char>(), 0, bytes);
+    }
   }
   return folly::Range(mapping->asMutable<vector_size_t>(), size);
 }
@@ -413,12 +479,15 @@ void projectChildren(
     const std::vector<IdentityProjection>& projections,
     int32_t size,
     const BufferPtr& mapping) {
+  CombinedIndices combinedIndices;
   for (auto [inputChannel, outputChannel] : projections) {
     if (outputChannel >= projectedChildren.size()) {
       projectedChildren.resize(outputChannel + 1);
     }
-    projectedChildren[outputChannel] =
-        wrapChild(size, mapping, src[inputChannel]);
+    projectedChildren[outputChannel] = mapping
+        ? wrapChildCombined(
+              size, mapping, src[inputChannel], &combinedIndices)
+        : src[inputChannel];
   }
 }
 } // namespace facebook::velox::exec
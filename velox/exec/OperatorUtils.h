@@ -63,7 +63,9 @@ vector_size_t processFilterResults(
 
 // Wraps the specified vector into a dictionary using the specified mapping.
 // Returns vector as-is if mapping is null. An optional nulls buffer can be
-// provided to introduce additional nulls.
+// provided to introduce additional nulls. Without nulls, a dictionary vector
+// without nulls over a loaded base is replaced by a single dictionary over
+// the same base, with the mapping applied to its indices.
 VectorPtr wrapChild(
     vector_size_t size,
     BufferPtr mapping,
@@ -128,11 +130,13 @@ void aggregateOperatorRuntimeStats(
 /// Allocates 'mapping' to fit at least 'size' indices and initializes them to
 /// zero if 'mapping' is either: nullptr, not unique or cannot fit 'size'.
 /// Returns 'mapping' as folly::Range<vector_size_t*>. Can be used by operator
-/// to initialize / resize reusable state across batches of processing.
+/// to initialize / resize reusable state across batches of processing. A new
+/// 'mapping' comes from 'vectorPool' if it is not null.
 folly::Range<vector_size_t*> initializeRowNumberMapping(
     BufferPtr& mapping,
     vector_size_t size,
-    memory::MemoryPool* pool);
+    memory::MemoryPool* pool,
+    VectorPool* vectorPool = nullptr);
 
 /// Projects children of 'src' row vector according to 'projections'. Optionally
 /// takes a 'mapping' and 'size' that represent the indices and size,
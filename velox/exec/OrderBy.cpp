@@ -28,6 +28,12 @@ CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
       false,
       CompareFlags::NullHandlingMode::kNullAsValue};
 }
+
+bool useParallelSort(
+    const core::OrderByNode& orderByNode,
+    const core::QueryConfig& queryConfig) {
+  return queryConfig.orderByParallelSort() && !orderByNode.isPartial();
+}
 } // namespace
 
 OrderBy::OrderBy(
@@ -40,9 +46,11 @@ OrderBy::OrderBy(
           operatorId,
           orderByNode->id(),
           "OrderBy",
-          orderByNode->canSpill(driverCtx->queryConfig())
+          orderByNode->canSpill(driverCtx->queryConfig()) &&
+                  !useParallelSort(*orderByNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
-              : std::nullopt) {
+              : std::nullopt),
+      parallelSort_(useParallelSort(*orderByNode, driverCtx->queryConfig())) {
   maxOutputRows_ = outputBatchRows(std::nullopt);
   VELOX_CHECK(pool()->trackUsage());
   std::vector<column_index_t> sortColumnIndices;
@@ -91,10 +99,55 @@ void OrderBy::noMoreInput() {
   Operator::noMoreInput();
   sortBuffer_->noMoreInput();
   maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+  maybeMergePeers();
+}
+
+void OrderBy::maybeMergePeers() {
+  if (!parallelSort_) {
+    return;
+  }
+  auto* driver = operatorCtx_->driver();
+  const auto numDrivers = operatorCtx_->task()->numDrivers(driver);
+  if (numDrivers == 1) {
+    parallelSort_ = false;
+    return;
+  }
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), driver, &future_, promises, peers)) {
+    VELOX_CHECK(future_.valid());
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not
+    // the last to finish) can continue from the barrier and finish.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    sortBuffer_->addSortedRows(*orderBy->sortBuffer_);
+  }
+  maxOutputRows_ = outputBatchRows(sortBuffer_->estimateOutputRowSize());
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
 }
 
 RowVectorPtr OrderBy::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || !noMoreInput_ || future_.valid()) {
     return nullptr;
   }
 
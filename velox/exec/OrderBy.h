@@ -49,9 +49,7 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -63,8 +61,20 @@ class OrderBy : public Operator {
   void close() override;
 
  private:
+  // Waits for the peer drivers to sort their input if running a parallel
+  // sort. The last driver to finish takes the sorted rows of all drivers and
+  // produces the merged output.
+  void maybeMergePeers();
+
   std::unique_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
   uint32_t maxOutputRows_;
+
+  // True if the drivers of a final OrderBy sort in parallel. Reset if there
+  // are no peers.
+  bool parallelSort_;
+
+  // Set while waiting for the peers to sort their input.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 };
 } // namespace facebook::velox::exec
@@ -649,7 +649,8 @@ void OutputBuffer::updateAfterAcknowledgeLocked(
   uint64_t freedBytes{0};
   int freedPages{0};
   for (const auto& free : freed) {
-    if (free.unique()) {
+    // A broadcast page is freed when the last destination releases it.
+    if (free.use_count() == 1) {
       ++freedPages;
       freedBytes += free->size();
     }
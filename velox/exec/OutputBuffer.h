@@ -187,7 +187,10 @@ class DestinationBuffer {
  private:
   void clearNotify();
 
-  std::vector<std::shared_ptr<SerializedPage>> data_;
+  // The pages are shared with the other destinations of a broadcast buffer,
+  // so a page is buffered once no matter the number of destinations. A deque
+  // because acknowledgements remove pages from the front.
+  std::deque<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
   DataAvailableCallback notify_{nullptr};
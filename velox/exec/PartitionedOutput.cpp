@@ -20,6 +20,70 @@
 
 namespace facebook::velox::exec {
 namespace detail {
+namespace {
+// Returns the rows of 'child' at 'indices' with the encoding of 'child'. The
+// indices of a dictionary without nulls are combined with 'indices' so that
+// the result is a dictionary over the same base.
+VectorPtr wrapPreservingEncoding(
+    vector_size_t size,
+    const BufferPtr& indices,
+    const VectorPtr& child,
+    memory::MemoryPool* pool) {
+  auto loaded = BaseVector::loadedVectorShared(child);
+  if (loaded->encoding() == VectorEncoding::Simple::DICTIONARY &&
+      loaded->rawNulls() == nullptr) {
+    auto baseIndices = allocateIndices(size, pool);
+    auto* rawBaseIndices = baseIndices->asMutable<vector_size_t>();
+    const auto* rawIndices = indices->as<vector_size_t>();
+    const auto* rawWrapIndices = loaded->wrapInfo()->as<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      rawBaseIndices[i] = rawWrapIndices[rawIndices[i]];
+    }
+    return BaseVector::wrapInDictionary(
+        nullptr, std::move(baseIndices), size, loaded->valueVector());
+  }
+  return BaseVector::wrapInDictionary(nullptr, indices, size, loaded);
+}
+} // namespace
+
+void Destination::serializeEncoded(
+    const RowVectorPtr& output,
+    vector_size_t firstRow,
+    OutputBufferManager& bufferManager,
+    Scratch& scratch) {
+  const vector_size_t numRows = rowIdx_ - firstRow;
+  auto indices = allocateIndices(numRows, pool_);
+  ::memcpy(
+      indices->asMutable<vector_size_t>(),
+      &rows_[firstRow],
+      numRows * sizeof(vector_size_t));
+  std::vector<VectorPtr> children;
+  children.reserve(output->childrenSize());
+  for (const auto& child : output->children()) {
+    children.push_back(wrapPreservingEncoding(numRows, indices, child, pool_));
+  }
+  auto page = std::make_shared<RowVector>(
+      pool_, output->type(), nullptr, numRows, std::move(children));
+
+  if (batchSerializer_ == nullptr) {
+    serializer::presto::PrestoVectorSerde::PrestoOptions options;
+    options.compressionKind =
+        OutputBufferManager::getInstance().lock()->compressionKind();
+    options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+    batchSerializer_ = getVectorSerde()->createBatchSerializer(pool_, &options);
+  }
+  if (encodedStream_ == nullptr) {
+    encodedListener_ = bufferManager.newListener();
+    encodedStream_ = std::make_unique<IOBufOutputStream>(
+        *pool_,
+        encodedListener_.get(),
+        std::clamp<uint64_t>(bytesInCurrent_, 128, 1 << 20));
+  }
+  const IndexRange range{0, numRows};
+  batchSerializer_->serialize(
+      page, folly::Range(&range, 1), scratch, encodedStream_.get());
+}
+
 BlockingReason Destination::advance(
     uint64_t maxBytes,
     const std::vector<vector_size_t>& sizes,
@@ -51,17 +115,21 @@ BlockingReason Destination::advance(
   }
 
   // Serialize
-  if (!current_) {
-    current_ = std::make_unique<VectorStreamGroup>(pool_);
-    auto rowType = asRowType(output->type());
-    serializer::presto::PrestoVectorSerde::PrestoOptions options;
-    options.compressionKind =
-        OutputBufferManager::getInstance().lock()->compressionKind();
-    options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
-    current_->createStreamTree(rowType, rowsInCurrent_, &options);
+  if (preserveEncodings_) {
+    serializeEncoded(output, firstRow, bufferManager, scratch);
+  } else {
+    if (!current_) {
+      current_ = std::make_unique<VectorStreamGroup>(pool_);
+      auto rowType = asRowType(output->type());
+      serializer::presto::PrestoVectorSerde::PrestoOptions options;
+      options.compressionKind =
+          OutputBufferManager::getInstance().lock()->compressionKind();
+      options.minCompressionRatio = PartitionedOutput::minCompressionRatio();
+      current_->createStreamTree(rowType, rowsInCurrent_, &options);
+    }
+    current_->append(
+        output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
   }
-  current_->append(
-      output, folly::Range(&rows_[firstRow], rowIdx_ - firstRow), scratch);
   // Update output state variable.
   if (rowIdx_ == rows_.size()) {
     *atEnd = true;
@@ -76,6 +144,15 @@ BlockingReason Destination::flush(
     OutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     ContinueFuture* future) {
+  if (preserveEncodings_) {
+    if (encodedStream_ == nullptr || rowsInCurrent_ == 0) {
+      return BlockingReason::kNotBlocked;
+    }
+    // The pages are already serialized to 'encodedStream_'.
+    auto stream = std::move(encodedStream_);
+    auto listener = std::move(encodedListener_);
+    return enqueue(*stream, bufferManager, bufferReleaseFn, future);
+  }
   if (!current_ || rowsInCurrent_ == 0) {
     return BlockingReason::kNotBlocked;
   }
@@ -87,11 +164,19 @@ BlockingReason Destination::flush(
       *current_->pool(),
       listener.get(),
       std::max<int64_t>(kMinMessageSize, current_->size()));
-  const int64_t flushedRows = rowsInCurrent_;
 
   current_->flush(&stream);
   current_->clear();
 
+  return enqueue(stream, bufferManager, bufferReleaseFn, future);
+}
+
+BlockingReason Destination::enqueue(
+    IOBufOutputStream& stream,
+    OutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  const int64_t flushedRows = rowsInCurrent_;
   const int64_t flushedBytes = stream.tellp();
 
   bytesInCurrent_ = 0;
@@ -113,8 +198,13 @@ BlockingReason Destination::flush(
 
 void Destination::updateStats(Operator* op) {
   VELOX_CHECK(finished_);
+  std::unordered_map<std::string, RuntimeCounter> serializerStats;
   if (current_) {
-    const auto serializerStats = current_->runtimeStats();
+    serializerStats = current_->runtimeStats();
+  } else if (batchSerializer_) {
+    serializerStats = batchSerializer_->runtimeStats();
+  }
+  if (!serializerStats.empty()) {
     auto lockedStats = op->stats().wlock();
     for (auto& pair : serializerStats) {
       lockedStats->addRuntimeStat(pair.first, pair.second);
@@ -155,7 +245,10 @@ PartitionedOutput::PartitionedOutput(
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
                             .maxPartitionedOutputBufferSize()),
-      eagerFlush_(eagerFlush) {
+      eagerFlush_(eagerFlush),
+      preserveEncodings_(ctx->task->queryCtx()
+                             ->queryConfig()
+                             .partitionedOutputPreserveEncodings()) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -197,10 +290,15 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(std::make_unique<detail::Destination>(
-          taskId, i, pool(), eagerFlush_, [&](uint64_t bytes, uint64_t rows) {
+          taskId,
+          i,
+          pool(),
+          eagerFlush_,
+          [&](uint64_t bytes, uint64_t rows) {
             auto lockedStats = stats_.wlock();
             lockedStats->addOutputVector(bytes, rows);
-          }));
+          },
+          preserveEncodings_));
     }
   }
 }
@@ -279,12 +377,44 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
       } else {
-        for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
-        }
+        scatterRows(numInput);
       }
     }
   }
+
+  activeDestinations_.clear();
+  for (auto i = 0; i < numDestinations_; ++i) {
+    if (destinations_[i]->hasRows()) {
+      activeDestinations_.push_back(i);
+    }
+  }
+}
+
+void PartitionedOutput::scatterRows(vector_size_t numInput) {
+  // Count the rows of each destination, then turn the counts into the start
+  // offsets of the destination ranges.
+  destinationOffsets_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++destinationOffsets_[partitions_[i] + 1];
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    destinationOffsets_[i + 1] += destinationOffsets_[i];
+  }
+  // Scattering advances the offset of each destination to the start of the
+  // next one, so that destination 'i' ends up in [offsets[i - 1], offsets[i]).
+  partitionedRows_.resize(numInput);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    partitionedRows_[destinationOffsets_[partitions_[i]]++] = i;
+  }
+  vector_size_t begin = 0;
+  for (auto i = 0; i < numDestinations_; ++i) {
+    const auto end = destinationOffsets_[i];
+    if (end > begin) {
+      destinations_[i]->addRows(folly::Range<const vector_size_t*>(
+          partitionedRows_.data() + begin, end - begin));
+    }
+    begin = end;
+  }
 }
 
 void PartitionedOutput::collectNullRows() {
@@ -333,7 +463,9 @@ RowVectorPtr PartitionedOutput::getOutput() {
   bool workLeft;
   do {
     workLeft = false;
-    for (auto& destination : destinations_) {
+    // Destinations without rows in 'output_' have nothing to advance.
+    for (auto index : activeDestinations_) {
+      auto& destination = destinations_[index];
       bool atEnd = false;
       blockingReason_ = destination->advance(
           maxPageSize,
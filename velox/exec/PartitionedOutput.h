@@ -27,16 +27,22 @@ class Destination {
  public:
   /// @param recordEnqueued Should be called to record each call to
   /// OutputBufferManager::enqueue. Takes number of bytes and rows.
+  /// @param preserveEncodings If true, the rows collected by each advance()
+  /// call are serialized as a separate Presto page keeping the dictionary and
+  /// constant encodings of the columns, instead of being appended flattened to
+  /// a single page.
   Destination(
       const std::string& taskId,
       int destination,
       memory::MemoryPool* pool,
       bool eagerFlush,
-      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued)
+      std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued,
+      bool preserveEncodings = false)
       : taskId_(taskId),
         destination_(destination),
         pool_(pool),
         eagerFlush_(eagerFlush),
+        preserveEncodings_(preserveEncodings),
         recordEnqueued_(std::move(recordEnqueued)) {
     setTargetSizePct();
   }
@@ -57,6 +63,17 @@ class Destination {
     }
   }
 
+  void addRows(folly::Range<const vector_size_t*> rows) {
+    const auto numRows = rows_.size();
+    rows_.resize(numRows + rows.size());
+    std::copy(rows.begin(), rows.end(), rows_.begin() + numRows);
+  }
+
+  // Returns true if rows were added since the last beginBatch().
+  bool hasRows() const {
+    return !rows_.empty();
+  }
+
   // Serializes row from 'output' till either 'maxBytes' have been serialized or
   BlockingReason advance(
       uint64_t maxBytes,
@@ -89,6 +106,22 @@ class Destination {
   void updateStats(Operator* op);
 
  private:
+  // Serializes the rows of 'output' in 'rows_' from 'firstRow' to 'rowIdx_'
+  // as a new page in 'encodedStream_', keeping the column encodings.
+  void serializeEncoded(
+      const RowVectorPtr& output,
+      vector_size_t firstRow,
+      OutputBufferManager& bufferManager,
+      Scratch& scratch);
+
+  // Enqueues the serialized rows in 'stream' to 'bufferManager' and resets the
+  // counters of the rows serialized since the last flush.
+  BlockingReason enqueue(
+      IOBufOutputStream& stream,
+      OutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   // Sets the next target size for flushing. This is called at the
   // start of each batch of output for the destination. The effect is
   // to make different destinations ready at slightly different times
@@ -106,6 +139,7 @@ class Destination {
   const int destination_;
   memory::MemoryPool* const pool_;
   const bool eagerFlush_;
+  const bool preserveEncodings_;
   const std::function<void(uint64_t bytes, uint64_t rows)> recordEnqueued_;
 
   // Bytes serialized in 'current_'
@@ -122,6 +156,12 @@ class Destination {
   std::unique_ptr<VectorStreamGroup> current_;
   bool finished_{false};
 
+  // Used instead of 'current_' if 'preserveEncodings_' is true. The pages
+  // serialized since the last flush() call are written to 'encodedStream_'.
+  std::unique_ptr<BatchVectorSerializer> batchSerializer_;
+  std::unique_ptr<OutputStreamListener> encodedListener_;
+  std::unique_ptr<IOBufOutputStream> encodedStream_;
+
   // Flush accumulated data to buffer manager after reaching this
   // percentage of target bytes or rows. This will make data for
   // different destinations ready at different times to flatten a
@@ -205,6 +245,11 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Adds the rows of the input to their destinations in 'partitions_' with a
+  // counting sort: the row numbers are scattered into one range per
+  // destination and each destination copies its range in bulk.
+  void scatterRows(vector_size_t numInput);
+
   // If compression in serde is enabled, this is the minimum compression that
   // must be achieved before starting to skip compression. Used for testing.
   inline static float minCompressionRatio_ = 0.8;
@@ -219,6 +264,9 @@ class PartitionedOutput : public Operator {
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
   const bool eagerFlush_;
+  // If true, the destinations keep the dictionary and constant encodings of
+  // the output columns.
+  const bool preserveEncodings_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -226,6 +274,9 @@ class PartitionedOutput : public Operator {
   std::vector<vector_size_t*> sizePointers_;
   std::vector<vector_size_t> rowSize_;
   std::vector<std::unique_ptr<detail::Destination>> destinations_;
+  // Indices of the destinations that received rows of the current input.
+  // getOutput() only advances these.
+  std::vector<int32_t> activeDestinations_;
   bool replicatedAny_{false};
   RowVectorPtr output_;
 
@@ -233,6 +284,10 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // Offsets of the ranges of each destination in 'partitionedRows_'.
+  std::vector<vector_size_t> destinationOffsets_;
+  // Row numbers of the input grouped by destination.
+  raw_vector<vector_size_t> partitionedRows_;
   std::vector<DecodedVector> decodedVectors_;
   Scratch scratch_;
 };
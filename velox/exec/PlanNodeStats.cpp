@@ -84,6 +84,18 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
   spilledFiles += stats.spilledFiles;
 }
 
+double PlanNodeStats::spillAmplification() const {
+  if (spilledRows == 0) {
+    return 0;
+  }
+  const auto it =
+      customStats.find(Operator::kSpilledRowsAtLevel + std::to_string(0));
+  if (it == customStats.end() || it->second.sum == 0) {
+    return 1;
+  }
+  return static_cast<double>(spilledRows) / it->second.sum;
+}
+
 std::string PlanNodeStats::toString(bool includeInputStats) const {
   std::stringstream out;
   if (includeInputStats) {
@@ -112,6 +124,10 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
   if (spilledRows > 0) {
     out << ", Spilled: " << spilledRows << " rows ("
         << succinctBytes(spilledBytes) << ", " << spilledFiles << " files)";
+    const auto amplification = spillAmplification();
+    if (amplification > 1) {
+      out << ", Spill amplification: " << fmt::format("{:.2f}", amplification);
+    }
   }
 
   if (!dynamicFilterStats.empty()) {
@@ -160,6 +176,8 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["outputVectors"] = operatorStat.second->outputVectors;
       stat["outputBytes"] = operatorStat.second->outputBytes;
       stat["cpuWallTiming"] = operatorStat.second->cpuWallTiming.toString();
+      stat["cpuNanos"] = operatorStat.second->cpuWallTiming.cpuNanos;
+      stat["wallNanos"] = operatorStat.second->cpuWallTiming.wallNanos;
       stat["blockedWallNanos"] = operatorStat.second->blockedWallNanos;
       stat["peakMemoryBytes"] = operatorStat.second->peakMemoryBytes;
       stat["numMemoryAllocations"] = operatorStat.second->numMemoryAllocations;
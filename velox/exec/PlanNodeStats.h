@@ -124,6 +124,12 @@ struct PlanNodeStats {
   /// Total spilled files.
   uint32_t spilledFiles{0};
 
+  /// Returns the spill amplification of an operator that spills recursively,
+  /// which is the total number of spilled rows over the number of rows spilled
+  /// at level 0. Returns 1 if the operator doesn't report spill stats per
+  /// level and 0 if it didn't spill.
+  double spillAmplification() const;
+
   /// Add stats for a single operator instance.
   void add(const OperatorStats& stats);
 
@@ -43,6 +43,28 @@ FOLLY_ALWAYS_INLINE void encodeRowColumn(
       value, prefix + prefixSortLayout.prefixOffsets[index]);
 }
 
+// Returns 'value' if its first 'maxLength' bytes are contiguous. A long
+// string in a RowContainer may be stored in several HashStringAllocator blocks
+// linked by continuation pointers. For such a string, copies the first
+// 'maxLength' bytes to 'prefixCopy' and returns a view of the original size
+// over it. Only the first 'maxLength' bytes of the returned view may be read.
+StringView contiguousPrefix(
+    StringView value,
+    uint32_t maxLength,
+    char* prefixCopy) {
+  if (value.isInline()) {
+    return value;
+  }
+  const auto* header = HashStringAllocator::headerOf(value.data());
+  if (value.size() <= header->size()) {
+    return value;
+  }
+  const auto copySize = std::min<uint32_t>(value.size(), maxLength);
+  auto stream = HashStringAllocator::prepareRead(header, copySize);
+  stream.readBytes(prefixCopy, copySize);
+  return StringView(prefixCopy, value.size());
+}
+
 FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
     TypeKind typeKind,
     const PrefixSortLayout& prefixSortLayout,
@@ -72,6 +94,25 @@ FOLLY_ALWAYS_INLINE void extractRowColumnToPrefix(
           prefixSortLayout, index, rowColumn, row, prefix);
       return;
     }
+    case TypeKind::VARCHAR:
+      [[fallthrough]];
+    case TypeKind::VARBINARY: {
+      std::optional<StringView> value;
+      // Holds the prefix of a string that is not contiguous in the row
+      // container.
+      char prefixCopy[256];
+      if (!RowContainer::isNullAt(
+              row, rowColumn.nullByte(), rowColumn.nullMask())) {
+        value = *(reinterpret_cast<StringView*>(row + rowColumn.offset()));
+        value = contiguousPrefix(
+            value.value(), prefixSortLayout.maxStringPrefixLength, prefixCopy);
+      }
+      prefixSortLayout.encoders[index].encode(
+          value,
+          prefix + prefixSortLayout.prefixOffsets[index],
+          prefixSortLayout.maxStringPrefixLength);
+      return;
+    }
     default:
       VELOX_UNSUPPORTED(
           "prefix-sort does not support type kind: {}",
@@ -115,9 +156,11 @@ compareByWord(uint64_t* left, uint64_t* right, int32_t bytes) {
 PrefixSortLayout PrefixSortLayout::makeSortLayout(
     const std::vector<TypePtr>& types,
     const std::vector<CompareFlags>& compareFlags,
-    uint32_t maxNormalizedKeySize) {
+    uint32_t maxNormalizedKeySize,
+    uint32_t maxStringPrefixLength) {
   uint32_t normalizedKeySize = 0;
   uint32_t numNormalizedKeys = 0;
+  bool lastKeyIsString = false;
   const uint32_t numKeys = types.size();
   std::vector<uint32_t> prefixOffsets;
   std::vector<PrefixSortEncoder> encoders;
@@ -128,14 +171,21 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
     if (normalizedKeySize > maxNormalizedKeySize) {
       break;
     }
-    std::optional<uint32_t> encodedSize =
-        PrefixSortEncoder::encodedSize(types[i]->kind());
+    std::optional<uint32_t> encodedSize = PrefixSortEncoder::encodedSize(
+        types[i]->kind(), maxStringPrefixLength);
     if (encodedSize.has_value()) {
       prefixOffsets.push_back(normalizedKeySize);
       encoders.push_back(
           {compareFlags[i].ascending, compareFlags[i].nullsFirst});
       normalizedKeySize += encodedSize.value();
       numNormalizedKeys++;
+      if (types[i]->kind() == TypeKind::VARCHAR ||
+          types[i]->kind() == TypeKind::VARBINARY) {
+        // Truncated strings with equal prefixes are ordered by the row
+        // comparison, so the keys after a string cannot be in the prefix.
+        lastKeyIsString = true;
+        break;
+      }
     } else {
       break;
     }
@@ -149,7 +199,9 @@ PrefixSortLayout PrefixSortLayout::makeSortLayout(
       numKeys,
       compareFlags,
       numNormalizedKeys == 0,
-      numNormalizedKeys < numKeys,
+      numNormalizedKeys < numKeys || lastKeyIsString,
+      maxStringPrefixLength,
+      lastKeyIsString,
       std::move(prefixOffsets),
       std::move(encoders),
       padding};
@@ -167,10 +219,16 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   if (result != 0) {
     return result;
   }
-  // If prefixes are equal, compare the left sort keys with rowContainer.
+  // If prefixes are equal, compare the left sort keys with rowContainer. The
+  // prefixes of a string key are equal and either both complete or both
+  // truncated. Only truncated strings need comparing.
+  auto firstKey = sortLayout_.numNormalizedKeys;
+  if (sortLayout_.lastKeyIsString && !isStringPrefixComplete(left)) {
+    --firstKey;
+  }
   char* leftAddress = getAddressFromPrefix(left);
   char* rightAddress = getAddressFromPrefix(right);
-  for (auto i = sortLayout_.numNormalizedKeys; i < sortLayout_.numKeys; ++i) {
+  for (auto i = firstKey; i < sortLayout_.numKeys; ++i) {
     result = rowContainer_->compare(
         leftAddress, rightAddress, i, sortLayout_.compareFlags[i]);
     if (result != 0) {
@@ -180,13 +238,28 @@ int PrefixSort::comparePartNormalizedKeys(char* left, char* right) {
   return result;
 }
 
+bool PrefixSort::isStringPrefixComplete(char* prefix) const {
+  // The length byte is the last byte of the string encoding. The prefix is
+  // byte swapped in words of 'kAlignment' bytes.
+  const auto offset = sortLayout_.prefixOffsets.back() +
+      sortLayout_.maxStringPrefixLength + 1;
+  const auto swappedOffset =
+      offset - offset % kAlignment + kAlignment - 1 - offset % kAlignment;
+  return sortLayout_.encoders.back().isStringComplete(
+      static_cast<uint8_t>(prefix[swappedOffset]),
+      sortLayout_.maxStringPrefixLength);
+}
+
 PrefixSort::PrefixSort(
     memory::MemoryPool* pool,
     RowContainer* rowContainer,
     const std::vector<CompareFlags>& keyCompareFlags,
     const PrefixSortConfig& config,
     const PrefixSortLayout& sortLayout)
-    : pool_(pool), sortLayout_(sortLayout), rowContainer_(rowContainer) {}
+    : pool_(pool),
+      sortLayout_(sortLayout),
+      rowContainer_(rowContainer),
+      radixSort_(config.radixSort) {}
 
 void PrefixSort::extractRowToPrefix(char* row, char* prefix) {
   for (auto i = 0; i < sortLayout_.numNormalizedKeys; i++) {
@@ -236,14 +309,18 @@ void PrefixSort::sortInternal(std::vector<char*>& rows) {
     PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
     const auto start = prefixes;
     const auto end = prefixes + numRows * entrySize;
+    auto sort = [&](auto compare) {
+      if (radixSort_) {
+        sortRunner.radixSort(
+            start, end, sortLayout_.normalizedBufferSize, compare);
+      } else {
+        sortRunner.quickSort(start, end, compare);
+      }
+    };
     if (sortLayout_.hasNonNormalizedKey) {
-      sortRunner.quickSort(start, end, [&](char* a, char* b) {
-        return comparePartNormalizedKeys(a, b);
-      });
+      sort([&](char* a, char* b) { return comparePartNormalizedKeys(a, b); });
     } else {
-      sortRunner.quickSort(start, end, [&](char* a, char* b) {
-        return compareAllNormalizedKeys(a, b);
-      });
+      sort([&](char* a, char* b) { return compareAllNormalizedKeys(a, b); });
     }
   }
   // 4. Output sorted row addresses.
@@ -42,8 +42,17 @@ FOLLY_ALWAYS_INLINE void stdSort(
 }; // namespace detail
 
 struct PrefixSortConfig {
-  PrefixSortConfig(uint32_t maxNormalizedKeySize, uint32_t threshold = 130)
-      : maxNormalizedKeySize(maxNormalizedKeySize), threshold(threshold) {}
+  PrefixSortConfig(
+      uint32_t maxNormalizedKeySize,
+      uint32_t threshold = 130,
+      uint32_t maxStringPrefixLength = 16,
+      bool radixSort = false)
+      : maxNormalizedKeySize(maxNormalizedKeySize),
+        threshold(threshold),
+        maxStringPrefixLength(maxStringPrefixLength),
+        radixSort(radixSort) {
+    VELOX_CHECK_LT(maxStringPrefixLength, 255);
+  }
 
   /// Max number of bytes can store normalized keys in prefix-sort buffer per
   /// entry.
@@ -53,17 +62,28 @@ struct PrefixSortConfig {
   /// The threshold is set to 100 according to the benchmark test results by
   /// default.
   const int64_t threshold;
+
+  /// Max number of bytes of a VARCHAR or VARBINARY key to store in the
+  /// prefix. Rows whose string prefixes are equal and truncated are compared
+  /// with the RowContainer. 0 disables prefixes for string keys.
+  const uint32_t maxStringPrefixLength;
+
+  /// If true, sorts the prefixes with an MSD radix sort on the normalized key
+  /// bytes instead of quick-sort. Small buckets and entries with equal
+  /// normalized keys are still sorted with quick-sort.
+  const bool radixSort;
 };
 
 /// The layout of prefix-sort buffer, a prefix entry includes:
 /// 1. normalized keys
-/// 2. non-normalized data ptr for semi-normalized types such as
-/// string_view`s ptr, it will be filled when support Varchar.
-/// 3. the row address ptr point to RowContainer`s rows is added at the end of
+/// 2. the row address ptr point to RowContainer`s rows is added at the end of
 /// prefix.
+/// A string key is stored as a prefix of its bytes. The prefix does not decide
+/// the order of strings longer than the prefix, so a string key is the last
+/// normalized key.
 struct PrefixSortLayout {
   /// Number of bytes to store a prefix, it equals to:
-  /// normalizedKeySize_ + 8 (non-normalized-ptr) + 8(row address).
+  /// normalizedKeySize_ + 8(row address).
   const uint64_t entrySize;
 
   /// If a sort key supports normalization and can be added to the prefix
@@ -82,9 +102,16 @@ struct PrefixSortLayout {
   /// It equals to 'numNormalizedKeys == 0', a little faster.
   const bool noNormalizedKeys;
 
-  /// Whether the sort keys contains non-normalized key.
+  /// Whether the sort keys contains non-normalized key or the prefix of a
+  /// string key, which need comparing rows when the prefixes are equal.
   const bool hasNonNormalizedKey;
 
+  /// Max number of bytes of a string key in the prefix. The last normalized
+  /// key is a string key if 'lastKeyIsString' is true.
+  const uint32_t maxStringPrefixLength;
+
+  const bool lastKeyIsString;
+
   /// Offsets of normalized keys, used to find write locations when
   /// extracting columns
   const std::vector<uint32_t> prefixOffsets;
@@ -99,7 +126,8 @@ struct PrefixSortLayout {
   static PrefixSortLayout makeSortLayout(
       const std::vector<TypePtr>& types,
       const std::vector<CompareFlags>& compareFlags,
-      uint32_t maxNormalizedKeySize);
+      uint32_t maxNormalizedKeySize,
+      uint32_t maxStringPrefixLength = 0);
 };
 
 class PrefixSort {
@@ -146,7 +174,10 @@ class PrefixSort {
     }
     VELOX_DCHECK_EQ(rowContainer->keyTypes().size(), compareFlags.size());
     const auto sortLayout = PrefixSortLayout::makeSortLayout(
-        rowContainer->keyTypes(), compareFlags, config.maxNormalizedKeySize);
+        rowContainer->keyTypes(),
+        compareFlags,
+        config.maxNormalizedKeySize,
+        config.maxStringPrefixLength);
     // All keys can not normalize, skip the binary string compare opt.
     // Putting this outside sort-internal helps with inline std-sort.
     if (sortLayout.noNormalizedKeys) {
@@ -165,6 +196,10 @@ class PrefixSort {
 
   int comparePartNormalizedKeys(char* left, char* right);
 
+  // Returns true if the string key at the end of the normalized keys of
+  // 'prefix' is not truncated.
+  bool isStringPrefixComplete(char* prefix) const;
+
   void extractRowToPrefix(char* row, char* prefix);
 
   // Return the reference of row address ptr for read/write.
@@ -175,5 +210,6 @@ class PrefixSort {
   memory::MemoryPool* const pool_;
   const PrefixSortLayout sortLayout_;
   RowContainer* const rowContainer_;
+  const bool radixSort_;
 };
 } // namespace facebook::velox::exec
@@ -146,6 +146,10 @@ RowContainer::RowContainer(
       isJoinBuild_(isJoinBuild),
       accumulators_(accumulators),
       hasNormalizedKeys_(hasNormalizedKeys),
+      numNormalizedKeyWords_(
+          hasNormalizedKeys
+              ? (keyTypes.size() >= kMinKeysForTwoWordNormalizedKey ? 2 : 1)
+              : 0),
       rows_(pool),
       stringAllocator_(
           stringAllocator ? stringAllocator
@@ -264,7 +268,8 @@ RowContainer::RowContainer(
     initialNulls_.resize(flagBytes_, 0x0);
   }
   originalNormalizedKeySize_ = hasNormalizedKeys_
-      ? bits::roundUp(sizeof(normalized_key_t), alignment_)
+      ? bits::roundUp(
+            sizeof(normalized_key_t) * numNormalizedKeyWords_, alignment_)
       : 0;
   normalizedKeySize_ = originalNormalizedKeySize_;
   size_t nullOffsetsPos = 0;
@@ -783,9 +788,28 @@ int32_t RowContainer::compareStringAsc(
     StringView left,
     const DecodedVector& decoded,
     vector_size_t index) {
+  const auto right = decoded.valueAt<StringView>(index);
+  if (const auto result = left.comparePrefix(right)) {
+    return result.value();
+  }
   std::string storage;
-  return HashStringAllocator::contiguousString(left, storage)
-      .compare(decoded.valueAt<StringView>(index));
+  return HashStringAllocator::contiguousString(left, storage).compare(right);
+}
+
+// static
+bool RowContainer::equalsString(
+    StringView left,
+    const DecodedVector& decoded,
+    vector_size_t index) {
+  const auto right = decoded.valueAt<StringView>(index);
+  if (!left.sizeAndPrefixEquals(right)) {
+    return false;
+  }
+  if (left.isInline()) {
+    return left == right;
+  }
+  std::string storage;
+  return HashStringAllocator::contiguousString(left, storage) == right;
 }
 
 // static
@@ -802,6 +826,9 @@ int RowContainer::compareComplexType(
 }
 
 int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
+  if (const auto result = left.comparePrefix(right)) {
+    return result.value();
+  }
   std::string leftStorage;
   std::string rightStorage;
   return HashStringAllocator::contiguousString(left, leftStorage)
@@ -932,6 +959,87 @@ void RowContainer::clearNextRowVectors() {
   }
 }
 
+int64_t RowContainer::compactVariableWidthData(
+    memory::MemoryPool* stagingPool) {
+  VELOX_CHECK(
+      canCompactVariableWidthData(),
+      "The string allocator has data that cannot be relocated");
+  VELOX_CHECK_NOT_NULL(stagingPool);
+  if (rowSizeOffset_ == 0 || numRows_ == 0) {
+    return 0;
+  }
+  const auto retainedBytes = stringAllocator_->retainedSize();
+
+  constexpr int32_t kBatch = 1000;
+  std::vector<char*> rows(kBatch);
+  HashStringAllocator staging(stagingPool);
+  RowContainerIterator iter;
+  while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+    for (auto i = 0; i < numRows; ++i) {
+      copyVariableWidthFields(rows[i], staging);
+    }
+  }
+
+  // All the live values are now in 'staging'. Start over with empty slabs and
+  // copy the values back, recomputing the row sizes.
+  stringAllocator_->clear();
+  iter.reset();
+  while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+    for (auto i = 0; i < numRows; ++i) {
+      auto* row = rows[i];
+      auto& rowSize = *reinterpret_cast<uint32_t*>(row + rowSizeOffset_);
+      rowSize = 0;
+      RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
+      copyVariableWidthFields(row, *stringAllocator_);
+    }
+  }
+  return retainedBytes - stringAllocator_->retainedSize();
+}
+
+void RowContainer::copyVariableWidthFields(
+    char* row,
+    HashStringAllocator& target) {
+  std::string storage;
+  for (auto i = 0; i < types_.size(); ++i) {
+    const auto column = rowColumns_[i];
+    if (isNullAt(row, column)) {
+      continue;
+    }
+    switch (typeKinds_[i]) {
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        const auto view = valueAt<StringView>(row, column.offset());
+        if (!view.isInline()) {
+          target.copyMultipart(
+              HashStringAllocator::contiguousString(view, storage),
+              row,
+              column.offset());
+        }
+        break;
+      }
+      case TypeKind::ROW:
+      case TypeKind::ARRAY:
+      case TypeKind::MAP: {
+        auto& view = valueAt<std::string_view>(row, column.offset());
+        if (view.empty()) {
+          break;
+        }
+        const auto size = view.size();
+        storage.resize(size);
+        prepareRead(row, column.offset()).readBytes(storage.data(), size);
+        ByteOutputStream stream(&target, false, false);
+        const auto position = target.newWrite(stream);
+        stream.appendStringView(std::string_view(storage));
+        target.finishWrite(stream, 0);
+        view =
+            std::string_view(reinterpret_cast<char*>(position.position), size);
+        break;
+      }
+      default:;
+    }
+  }
+}
+
 void RowContainer::setProbedFlag(char** rows, int32_t numRows) {
   for (auto i = 0; i < numRows; i++) {
     // Row may be null in case of a FULL join.
@@ -224,9 +224,10 @@ class RowContainer {
   /// for a probed state of a full or right outer
   /// join. 'hasNormalizedKey' specifies that an extra word is left
   /// below each row for a normalized key that collapses all parts
-  /// into one word for faster comparison. The bulk allocation is done
-  /// from 'allocator'. ContainerRowSerde is used for serializing complex
-  /// type values into the container.
+  /// into one word for faster comparison. Keys of
+  /// kMinKeysForTwoWordNormalizedKey or more parts get two words. The bulk
+  /// allocation is done from 'allocator'. ContainerRowSerde is used for
+  /// serializing complex type values into the container.
   /// 'stringAllocator' allows sharing the variable length data arena with
   /// another RowContainer. This is needed for spilling where the same
   /// aggregates are used for reading one container and merging into another.
@@ -612,6 +613,24 @@ class RowContainer {
     return reinterpret_cast<normalized_key_t*>(group)[-1];
   }
 
+  /// Allows get/set of the high word of a two word normalized key. It is
+  /// stored in the word below the one of normalizedKey(). Only valid if
+  /// numNormalizedKeyWords() is 2.
+  static inline normalized_key_t& normalizedKeyHigh(char* group) {
+    return reinterpret_cast<normalized_key_t*>(group)[-2];
+  }
+
+  /// Minimum number of key parts for reserving a second normalized key word.
+  /// Two word keys are only needed when the value ids of the parts don't fit
+  /// in 64 bits, which takes at least three parts in practice.
+  static constexpr int32_t kMinKeysForTwoWordNormalizedKey = 3;
+
+  /// Number of normalized key words reserved below each row. 0 if the
+  /// container was created without normalized keys.
+  int32_t numNormalizedKeyWords() const {
+    return numNormalizedKeyWords_;
+  }
+
   void disableNormalizedKeys() {
     normalizedKeySize_ = 0;
   }
@@ -683,6 +702,24 @@ class RowContainer {
   /// Frees memory for next row vectors.
   void clearNextRowVectors();
 
+  /// Returns true if compactVariableWidthData() can relocate all the data in
+  /// the string allocator. This requires that no other container shares the
+  /// string allocator, no accumulator keeps state in it and there are no next
+  /// row vectors.
+  bool canCompactVariableWidthData() const {
+    return stringAllocator_.unique() && !usesExternalMemory_ &&
+        !hasDuplicateRows_;
+  }
+
+  /// Moves the out-of-line strings and complex type values of all rows into
+  /// fresh slabs of the string allocator. This returns the memory of the blocks
+  /// freed by eraseRows() to the pool when the remaining values are spread thin
+  /// over the slabs. The values are staged in a HashStringAllocator on
+  /// 'stagingPool' while the string allocator is cleared. The rows do not
+  /// move, so the row pointers in a HashTable stay valid. Returns the decrease
+  /// of the retained size of the string allocator.
+  int64_t compactVariableWidthData(memory::MemoryPool* stagingPool);
+
   int32_t compareRows(
       const char* left,
       const char* right,
@@ -1023,8 +1060,7 @@ class RowContainer {
       return compareComplexType(row, offset, decoded, index) == 0;
     }
     if constexpr (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
-      return compareStringAsc(
-                 valueAt<StringView>(row, offset), decoded, index) == 0;
+      return equalsString(valueAt<StringView>(row, offset), decoded, index);
     }
 
     using T = typename KindToFlatVector<Kind>::HashRowType;
@@ -1167,6 +1203,13 @@ class RowContainer {
 
   static int32_t compareStringAsc(StringView left, StringView right);
 
+  // Returns true if 'left' from a row equals the string at 'index' in
+  // 'decoded'. Compares the sizes and prefixes before reading 'left'.
+  static bool equalsString(
+      StringView left,
+      const DecodedVector& decoded,
+      vector_size_t index);
+
   int32_t compareComplexType(
       const char* row,
       int32_t offset,
@@ -1229,6 +1272,10 @@ class RowContainer {
   // complex-typed field in 'rows'.
   void freeVariableWidthFields(folly::Range<char**> rows);
 
+  // Copies the out-of-line variable-width fields of 'row' to 'target' and
+  // points 'row' to the copies. Does not free the old values.
+  void copyVariableWidthFields(char* row, HashStringAllocator& target);
+
   // Free any aggregates associated with the 'rows'.
   void freeAggregates(folly::Range<char**> rows);
 
@@ -1278,6 +1325,8 @@ class RowContainer {
   int32_t flagBytes_;
   // True if normalized keys are enabled in initial state.
   const bool hasNormalizedKeys_;
+  // See numNormalizedKeyWords().
+  const int32_t numNormalizedKeyWords_;
   // The count of entries that have an extra normalized_key_t before the
   // start.
   int64_t numRowsWithNormalizedKey_ = 0;
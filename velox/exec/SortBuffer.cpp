@@ -19,6 +19,19 @@
 
 namespace facebook::velox::exec {
 
+int32_t SortedRowsStream::compare(const MergeStream& other) const {
+  const auto* otherRow = static_cast<const SortedRowsStream&>(other).current();
+  const auto* row = current();
+  // The rows of all streams have the same layout, so 'data_' can compare
+  // them.
+  for (auto i = 0; i < compareFlags_.size(); ++i) {
+    if (auto result = data_->compare(row, otherRow, i, compareFlags_[i])) {
+      return result;
+    }
+  }
+  return 0;
+}
+
 SortBuffer::SortBuffer(
     const RowTypePtr& input,
     const std::vector<column_index_t>& sortColumnIndices,
@@ -149,6 +162,8 @@ RowVectorPtr SortBuffer::getOutput(uint32_t maxOutputRows) {
   prepareOutput(maxOutputRows);
   if (spiller_ != nullptr) {
     getOutputWithSpill();
+  } else if (!mergeRuns_.empty()) {
+    getOutputWithMerge();
   } else {
     getOutputWithoutSpill();
   }
@@ -334,6 +349,63 @@ void SortBuffer::getOutputWithoutSpill() {
   numOutputRows_ += output_->size();
 }
 
+void SortBuffer::addSortedRows(SortBuffer& other) {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(other.noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_NULL(other.spiller_);
+  VELOX_CHECK_NULL(sortedRowsMerger_);
+  VELOX_CHECK_EQ(other.numOutputRows_, 0);
+  if (other.numInputRows_ == 0) {
+    return;
+  }
+  mergeRuns_.push_back(std::move(other.sortedRows_));
+  mergeContainers_.push_back(std::move(other.data_));
+  numInputRows_ += other.numInputRows_;
+  other.sortedRows_.clear();
+  other.numInputRows_ = 0;
+  if (other.estimatedOutputRowSize_.has_value() &&
+      other.estimatedOutputRowSize_.value() >
+          estimatedOutputRowSize_.value_or(0)) {
+    estimatedOutputRowSize_ = other.estimatedOutputRowSize_;
+  }
+}
+
+void SortBuffer::getOutputWithMerge() {
+  if (sortedRowsMerger_ == nullptr) {
+    std::vector<std::unique_ptr<SortedRowsStream>> streams;
+    streams.reserve(mergeRuns_.size() + 1);
+    if (!sortedRows_.empty()) {
+      streams.push_back(std::make_unique<SortedRowsStream>(
+          data_.get(), std::move(sortedRows_), sortCompareFlags_));
+      sortedRows_.clear();
+    }
+    for (auto& run : mergeRuns_) {
+      streams.push_back(std::make_unique<SortedRowsStream>(
+          data_.get(), std::move(run), sortCompareFlags_));
+    }
+    sortedRowsMerger_ =
+        std::make_unique<TreeOfLosers<SortedRowsStream>>(std::move(streams));
+  }
+
+  const auto numRows = output_->size();
+  mergedRows_.resize(numRows);
+  for (auto i = 0; i < numRows; ++i) {
+    auto* stream = sortedRowsMerger_->next();
+    VELOX_CHECK_NOT_NULL(stream);
+    mergedRows_[i] = stream->current();
+    stream->pop();
+  }
+  for (const auto& columnProjection : columnMap_) {
+    data_->extractColumn(
+        mergedRows_.data(),
+        numRows,
+        columnProjection.inputChannel,
+        output_->childAt(columnProjection.outputChannel));
+  }
+  numOutputRows_ += numRows;
+}
+
 void SortBuffer::getOutputWithSpill() {
   VELOX_CHECK_NOT_NULL(spillMerger_);
   VELOX_DCHECK_EQ(sortedRows_.size(), 0);
@@ -385,7 +457,7 @@ void SortBuffer::finishSpill() {
   spiller_->finishSpill(spillPartitionSet);
   VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
   spillMerger_ = spillPartitionSet.begin()->second->createOrderedReader(
-      pool(), spillStats_);
+      pool(), spillStats_, spillConfig_->ioExecutor());
 }
 
 } // namespace facebook::velox::exec
@@ -25,6 +25,41 @@
 
 namespace facebook::velox::exec {
 
+/// A run of sorted rows in a RowContainer. Used by SortBuffer to merge its
+/// sorted rows with the sorted rows of other sort buffers of the same type.
+class SortedRowsStream : public MergeStream {
+ public:
+  SortedRowsStream(
+      RowContainer* data,
+      std::vector<char*> rows,
+      const std::vector<CompareFlags>& compareFlags)
+      : data_(data), rows_(std::move(rows)), compareFlags_(compareFlags) {}
+
+  bool hasData() const override {
+    return index_ < rows_.size();
+  }
+
+  bool operator<(const MergeStream& other) const override {
+    return compare(other) < 0;
+  }
+
+  int32_t compare(const MergeStream& other) const override;
+
+  char* current() const {
+    return rows_[index_];
+  }
+
+  void pop() {
+    ++index_;
+  }
+
+ private:
+  RowContainer* const data_;
+  const std::vector<char*> rows_;
+  const std::vector<CompareFlags>& compareFlags_;
+  size_t index_{0};
+};
+
 /// A utility class to accumulate data inside and output the sorted result.
 /// Spilling would be triggered if spilling is enabled and memory usage exceeds
 /// limit.
@@ -50,6 +85,13 @@ class SortBuffer {
   /// Returns the sorted output rows in batch.
   RowVectorPtr getOutput(uint32_t maxOutputRows);
 
+  /// Takes the sorted rows of 'other' and the RowContainer holding them.
+  /// getOutput() then merges these with the rows of 'this' and of the other
+  /// buffers added before. Both 'this' and 'other' must be after
+  /// noMoreInput() and must not have spilled. 'other' has no rows left to
+  /// output after this.
+  void addSortedRows(SortBuffer& other);
+
   /// Indicates if this sort buffer can spill or not.
   bool canSpill() const {
     return spillConfig_ != nullptr;
@@ -72,6 +114,7 @@ class SortBuffer {
   void prepareOutput(uint32_t maxOutputRows);
   void getOutputWithoutSpill();
   void getOutputWithSpill();
+  void getOutputWithMerge();
   // Spill during input stage.
   void spillInput();
   // Spill during output stage.
@@ -113,6 +156,15 @@ class SortBuffer {
   std::vector<const RowVector*> spillSources_;
   std::vector<vector_size_t> spillSourceRows_;
 
+  // The RowContainers taken from other sort buffers by addSortedRows().
+  std::vector<std::unique_ptr<RowContainer>> mergeContainers_;
+  // The sorted rows taken by addSortedRows(), one run per sort buffer.
+  std::vector<std::vector<char*>> mergeRuns_;
+  // Merges 'sortedRows_' and 'mergeRuns_'. Created on the first getOutput().
+  std::unique_ptr<TreeOfLosers<SortedRowsStream>> sortedRowsMerger_;
+  // The next rows to copy to 'output_' from 'sortedRowsMerger_'.
+  std::vector<char*> mergedRows_;
+
   // Reusable output vector.
   RowVectorPtr output_;
   // Estimated size of a single output row by using the max
@@ -242,7 +242,7 @@ void SortWindowBuild::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        pool_, spillStats_);
+        pool_, spillStats_, spillConfig_->ioExecutor());
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
@@ -294,7 +294,84 @@ void SortWindowBuild::loadNextPartitionFromSpill() {
   }
 }
 
+// static
+void SortWindowBuild::shareSortedPartitions(
+    const std::vector<SortWindowBuild*>& builds) {
+  VELOX_CHECK(!builds.empty());
+  auto* leader = builds[0];
+
+  // Each build has sorted its own rows. Concatenate and merge the sorted runs
+  // pairwise. The rows of all builds have the same layout, so the leader's
+  // container can compare them.
+  std::vector<char*> rows;
+  std::vector<size_t> runBounds{0};
+  for (auto* build : builds) {
+    VELOX_CHECK_NULL(build->spiller_);
+    VELOX_CHECK_NULL(build->sharedPartitions_);
+    rows.insert(
+        rows.end(), build->sortedRows_.begin(), build->sortedRows_.end());
+    runBounds.push_back(rows.size());
+    build->sortedRows_.clear();
+    build->partitionStartRows_.clear();
+  }
+  auto less = [&](const char* leftRow, const char* rightRow) {
+    return leader->compareRowsWithKeys(leftRow, rightRow, leader->allKeyInfo_);
+  };
+  while (runBounds.size() > 2) {
+    std::vector<size_t> mergedBounds{0};
+    for (auto i = 0; i + 2 < runBounds.size(); i += 2) {
+      std::inplace_merge(
+          rows.begin() + runBounds[i],
+          rows.begin() + runBounds[i + 1],
+          rows.begin() + runBounds[i + 2],
+          less);
+      mergedBounds.push_back(runBounds[i + 2]);
+    }
+    if (runBounds.size() % 2 == 0) {
+      // Odd number of runs. The last one is carried over as is.
+      mergedBounds.push_back(runBounds.back());
+    }
+    runBounds = std::move(mergedBounds);
+  }
+
+  leader->numRows_ = rows.size();
+  leader->sortedRows_ = std::move(rows);
+  if (!leader->sortedRows_.empty()) {
+    leader->computePartitionStartRows();
+  }
+
+  auto shared = std::make_shared<SharedPartitions>();
+  shared->sortedRows = std::move(leader->sortedRows_);
+  shared->partitionStartRows = std::move(leader->partitionStartRows_);
+  leader->sortedRows_.clear();
+  leader->partitionStartRows_.clear();
+  // The containers move to the shared state so that the rows outlive the
+  // build that stored them.
+  for (auto* build : builds) {
+    shared->containers.push_back(std::move(build->data_));
+    build->sharedPartitions_ = shared;
+  }
+}
+
 std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
+  if (sharedPartitions_ != nullptr) {
+    const auto& startRows = sharedPartitions_->partitionStartRows;
+    VELOX_CHECK(
+        sharedPartition_ >= 0 &&
+            sharedPartition_ < static_cast<int32_t>(startRows.size()) - 1,
+        "No window partitions available");
+    const auto partitionStart = startRows[sharedPartition_];
+    auto partition = folly::Range(
+        sharedPartitions_->sortedRows.data() + partitionStart,
+        startRows[sharedPartition_ + 1] - partitionStart);
+    sharedPartition_ = -1;
+    return std::make_unique<WindowPartition>(
+        sharedPartitions_->containers[0].get(),
+        partition,
+        inversedInputChannels_,
+        sortKeyInfo_);
+  }
+
   if (merge_ != nullptr) {
     VELOX_CHECK(!sortedRows_.empty(), "No window partitions available")
     auto partition = folly::Range(sortedRows_.data(), sortedRows_.size());
@@ -321,6 +398,15 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
 }
 
 bool SortWindowBuild::hasNextPartition() {
+  if (sharedPartitions_ != nullptr) {
+    const int32_t numPartitions =
+        static_cast<int32_t>(sharedPartitions_->partitionStartRows.size()) - 1;
+    if (sharedPartition_ < 0) {
+      sharedPartition_ = sharedPartitions_->nextPartition++;
+    }
+    return sharedPartition_ < numPartitions;
+  }
+
   if (merge_ != nullptr) {
     loadNextPartitionFromSpill();
     return !sortedRows_.empty();
@@ -55,7 +55,26 @@ class SortWindowBuild : public WindowBuild {
 
   std::unique_ptr<WindowPartition> nextPartition() override;
 
+  /// Merges the sorted rows of 'builds' after noMoreInput() of all of them
+  /// and makes them share the partitions of the merged rows. Each partition
+  /// is then returned by nextPartition() of exactly one of 'builds'. Must be
+  /// called by one thread while the others wait. Spilling must be disabled.
+  static void shareSortedPartitions(
+      const std::vector<SortWindowBuild*>& builds);
+
  private:
+  // Sorted rows and partitions shared by the builds of all the drivers after
+  // shareSortedPartitions().
+  struct SharedPartitions {
+    // The containers of all the builds. The rows of all the partitions are in
+    // these.
+    std::vector<std::unique_ptr<RowContainer>> containers;
+    std::vector<char*> sortedRows;
+    std::vector<vector_size_t> partitionStartRows;
+    // The next partition to hand out.
+    std::atomic<int32_t> nextPartition{0};
+  };
+
   void ensureInputFits(const RowVectorPtr& input);
 
   void setupSpiller();
@@ -109,6 +128,13 @@ class SortWindowBuild : public WindowBuild {
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
 
+  // Set after shareSortedPartitions().
+  std::shared_ptr<SharedPartitions> sharedPartitions_;
+
+  // The partition claimed from 'sharedPartitions_' by hasNextPartition() and
+  // returned by the next nextPartition(). -1 if none is claimed.
+  int32_t sharedPartition_{-1};
+
   // Spiller for contents of the 'data_'.
   std::unique_ptr<Spiller> spiller_;
 
@@ -76,7 +76,10 @@ SpillState::SpillState(
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
     folly::Synchronized<common::SpillStats>* stats,
-    const std::string& fileCreateConfig)
+    const std::string& fileCreateConfig,
+    bool encodeSortedRuns,
+    folly::Executor* ioExecutor,
+    const common::SpillFileOffloadCB& offloadCb)
     : getSpillDirPathCb_(getSpillDirPathCb),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       fileNamePrefix_(fileNamePrefix),
@@ -86,6 +89,9 @@ SpillState::SpillState(
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
+      encodeSortedRuns_(encodeSortedRuns),
+      ioExecutor_(ioExecutor),
+      offloadCb_(offloadCb),
       fileCreateConfig_(fileCreateConfig),
       pool_(pool),
       stats_(stats),
@@ -132,7 +138,10 @@ uint64_t SpillState::appendToPartition(
         fileCreateConfig_,
         updateAndCheckSpillLimitCb_,
         pool_,
-        stats_);
+        stats_,
+        encodeSortedRuns_,
+        ioExecutor_,
+        offloadCb_);
   }
 
   updateSpilledInputBytes(rows->estimateFlatSize());
@@ -230,6 +239,25 @@ std::vector<std::unique_ptr<SpillPartition>> SpillPartition::split(
   return shards;
 }
 
+std::unique_ptr<SpillPartition> SpillPartition::takeFiles(uint64_t maxBytes) {
+  VELOX_CHECK(!files_.empty());
+  SpillFiles files;
+  uint64_t bytes{0};
+  size_t numFiles{0};
+  while (numFiles < files_.size() &&
+         (numFiles == 0 || bytes + files_[numFiles].size <= maxBytes)) {
+    bytes += files_[numFiles].size;
+    ++numFiles;
+  }
+  files.reserve(numFiles);
+  for (auto i = 0; i < numFiles; ++i) {
+    files.push_back(std::move(files_[i]));
+  }
+  files_.erase(files_.begin(), files_.begin() + numFiles);
+  size_ -= bytes;
+  return std::make_unique<SpillPartition>(id_, std::move(files));
+}
+
 std::string SpillPartition::toString() const {
   return fmt::format(
       "SPILLED PARTITION[ID:{} FILES:{} SIZE:{}]",
@@ -257,12 +285,13 @@ SpillPartition::createUnorderedReader(
 std::unique_ptr<TreeOfLosers<SpillMergeStream>>
 SpillPartition::createOrderedReader(
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* spillStats) {
+    folly::Synchronized<common::SpillStats>* spillStats,
+    folly::Executor* readAheadExecutor) {
   std::vector<std::unique_ptr<SpillMergeStream>> streams;
   streams.reserve(files_.size());
   for (auto& fileInfo : files_) {
-    streams.push_back(FileSpillMergeStream::create(
-        SpillReadFile::create(fileInfo, pool, spillStats)));
+    streams.push_back(FileSpillMergeStream::create(SpillReadFile::create(
+        fileInfo, pool, spillStats, readAheadExecutor)));
   }
   files_.clear();
   // Check if the partition is empty or not.
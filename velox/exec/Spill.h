@@ -288,6 +288,11 @@ class SpillPartition {
   /// NOTE: the split spill partition shards will have the same id as this.
   std::vector<std::unique_ptr<SpillPartition>> split(int numShards);
 
+  /// Removes the leading files of this spill partition with a total size of up
+  /// to 'maxBytes' and returns them as a partition with the same id. Takes at
+  /// least one file. Used to restore a partition in chunks.
+  std::unique_ptr<SpillPartition> takeFiles(uint64_t maxBytes);
+
   /// Invoked to create an unordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   /// 'spillStats' is provided to collect the spill stats when reading data from
@@ -300,9 +305,12 @@ class SpillPartition {
   /// The created reader will take the ownership of the spill files.
   /// 'spillStats' is provided to collect the spill stats when reading data from
   /// spilled files.
+  /// If 'readAheadExecutor' is set, the next buffer of each spill file is
+  /// read ahead on it.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> createOrderedReader(
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* spillStats);
+      folly::Synchronized<common::SpillStats>* spillStats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   std::string toString() const;
 
@@ -326,7 +334,10 @@ class SpillState {
   /// 'numSortKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. 'encodeSortedRuns' dictionary encodes the runs of equal values
+  /// in sorted spill files, see SpillWriter. If 'ioExecutor' is set, spill
+  /// files are written asynchronously on it. 'offloadCb' decides where to
+  /// move finished spill files, see common::SpillConfig::offloadCb.
   SpillState(
       const common::GetSpillDirectoryPathCB& getSpillDirectoryPath,
       const common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
@@ -339,7 +350,10 @@ class SpillState {
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
       folly::Synchronized<common::SpillStats>* stats,
-      const std::string& fileCreateConfig = {});
+      const std::string& fileCreateConfig = {},
+      bool encodeSortedRuns = false,
+      folly::Executor* ioExecutor = nullptr,
+      const common::SpillFileOffloadCB& offloadCb = nullptr);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(uint32_t partition) const {
@@ -433,6 +447,9 @@ class SpillState {
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const common::CompressionKind compressionKind_;
+  const bool encodeSortedRuns_;
+  folly::Executor* const ioExecutor_;
+  const common::SpillFileOffloadCB offloadCb_;
   const std::string fileCreateConfig_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
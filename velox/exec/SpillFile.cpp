@@ -28,17 +28,53 @@ namespace {
 static const bool kDefaultUseLosslessTimestamp = true;
 } // namespace
 
+SpillInputStream::~SpillInputStream() {
+  if (readAhead_ != nullptr) {
+    readAhead_->close();
+  }
+}
+
 void SpillInputStream::next(bool /*throwIfPastEnd*/) {
-  const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
-  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
-  setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  uint64_t readTimeUs{0};
-  {
-    MicrosecondTimer timer{&readTimeUs};
-    file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+  int32_t readBytes;
+  if (readAhead_ != nullptr) {
+    auto readAhead = std::move(readAhead_);
+    readBytes = *readAhead->move();
+    std::swap(buffer_, readAheadBuffer_);
+  } else {
+    readBytes = std::min(size_ - offset_, buffer_->capacity());
+    VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+    uint64_t readTimeUs{0};
+    {
+      MicrosecondTimer timer{&readTimeUs};
+      file_->pread(offset_, readBytes, buffer_->asMutable<char>());
+    }
+    updateSpillStats(readBytes, readTimeUs);
   }
-  updateSpillStats(readBytes, readTimeUs);
+  setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
   offset_ += readBytes;
+  if (readAheadExecutor_ != nullptr && offset_ < size_) {
+    startReadAhead();
+  }
+}
+
+void SpillInputStream::startReadAhead() {
+  VELOX_CHECK_NULL(readAhead_);
+  if (readAheadBuffer_ == nullptr) {
+    readAheadBuffer_ =
+        AlignedBuffer::allocate<char>(buffer_->capacity(), buffer_->pool());
+  }
+  const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
+  readAhead_ = std::make_shared<AsyncSource<int32_t>>(
+      [this, offset = offset_, readBytes, buffer = readAheadBuffer_]() {
+        uint64_t readTimeUs{0};
+        {
+          MicrosecondTimer timer{&readTimeUs};
+          file_->pread(offset, readBytes, buffer->asMutable<char>());
+        }
+        updateSpillStats(readBytes, readTimeUs);
+        return std::make_unique<int32_t>(readBytes);
+      });
+  readAheadExecutor_->add([source = readAhead_]() { source->prepare(); });
 }
 
 void SpillInputStream::updateSpillStats(uint64_t readBytes, uint64_t readTimeUs)
@@ -104,7 +140,10 @@ SpillWriter::SpillWriter(
     const std::string& fileCreateConfig,
     common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    bool encodeSortedRuns,
+    folly::Executor* ioExecutor,
+    const common::SpillFileOffloadCB& offloadCb)
     : type_(type),
       numSortKeys_(numSortKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -115,13 +154,22 @@ SpillWriter::SpillWriter(
       fileCreateConfig_(fileCreateConfig),
       updateAndCheckSpillLimitCb_(updateAndCheckSpillLimitCb),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      encodeSortedRuns_(encodeSortedRuns && numSortKeys_ > 0),
+      ioExecutor_(ioExecutor),
+      offloadCb_(offloadCb) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortKeys_);
 }
 
+SpillWriter::~SpillWriter() {
+  if (pendingWrite_ != nullptr) {
+    pendingWrite_->close();
+  }
+}
+
 SpillWriteFile* SpillWriter::ensureFile() {
   if ((currentFile_ != nullptr) && (currentFile_->size() > targetFileSize_)) {
     closeFile();
@@ -136,6 +184,7 @@ SpillWriteFile* SpillWriter::ensureFile() {
 }
 
 void SpillWriter::closeFile() {
+  waitForPendingWrite();
   if (currentFile_ == nullptr) {
     return;
   }
@@ -144,7 +193,7 @@ void SpillWriter::closeFile() {
   finishedFiles_.push_back(SpillFileInfo{
       .id = currentFile_->id(),
       .type = type_,
-      .path = currentFile_->path(),
+      .path = maybeOffloadFile(currentFile_->path(), currentFile_->size()),
       .size = currentFile_->size(),
       .numSortKeys = numSortKeys_,
       .sortFlags = sortCompareFlags_,
@@ -152,30 +201,122 @@ void SpillWriter::closeFile() {
   currentFile_.reset();
 }
 
+std::string SpillWriter::maybeOffloadFile(
+    const std::string& path,
+    uint64_t size) {
+  if (offloadCb_ == nullptr) {
+    return path;
+  }
+  const auto directory = offloadCb_(size);
+  if (directory.empty()) {
+    return path;
+  }
+
+  const auto targetPath = fmt::format(
+      "{}/{}", directory, path.substr(path.find_last_of('/') + 1));
+  uint64_t offloadTimeUs{0};
+  {
+    MicrosecondTimer timer(&offloadTimeUs);
+    auto sourceFs = filesystems::getFileSystem(path, nullptr);
+    auto source = sourceFs->openFileForRead(path);
+    auto targetFs = filesystems::getFileSystem(targetPath, nullptr);
+    auto target = targetFs->openFileForWrite(
+        targetPath,
+        filesystems::FileOptions{
+            {{filesystems::FileOptions::kFileCreateConfig.toString(),
+              fileCreateConfig_}},
+            nullptr,
+            std::nullopt});
+    constexpr uint64_t kCopyBufferSize = 8 << 20;
+    auto buffer = AlignedBuffer::allocate<char>(
+        std::min<uint64_t>(size, kCopyBufferSize), pool_);
+    for (uint64_t offset = 0; offset < size;) {
+      const auto bytes = std::min<uint64_t>(size - offset, buffer->capacity());
+      target->append(source->pread(offset, bytes, buffer->asMutable<char>()));
+      offset += bytes;
+    }
+    target->close();
+    sourceFs->remove(path);
+  }
+  addThreadLocalRuntimeStat(
+      "spillOffloadedBytes",
+      RuntimeCounter(size, RuntimeCounter::Unit::kBytes));
+  addThreadLocalRuntimeStat(
+      "spillOffloadWallNanos",
+      RuntimeCounter(offloadTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+  return targetPath;
+}
+
 size_t SpillWriter::numFinishedFiles() const {
   return finishedFiles_.size();
 }
 
+uint64_t SpillWriter::bufferedBytes() const {
+  if (encodedBatch_ != nullptr) {
+    return static_cast<uint64_t>(encodedBatch_->tellp());
+  }
+  return batch_ == nullptr ? 0 : batch_->size();
+}
+
+void SpillWriter::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto pendingWrite = std::move(pendingWrite_);
+  pendingWrite->move();
+}
+
 uint64_t SpillWriter::flush() {
-  if (batch_ == nullptr) {
+  if (batch_ == nullptr && encodedBatch_ == nullptr) {
     return 0;
   }
 
+  // The file must not be appended to or closed while a write is in flight.
+  waitForPendingWrite();
   auto* file = ensureFile();
   VELOX_CHECK_NOT_NULL(file);
 
-  IOBufOutputStream out(
-      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
   uint64_t flushTimeUs{0};
-  {
+  std::unique_ptr<folly::IOBuf> iobuf;
+  if (encodedBatch_ != nullptr) {
     MicrosecondTimer timer(&flushTimeUs);
-    batch_->flush(&out);
+    iobuf = encodedBatch_->getIOBuf();
+    encodedBatch_.reset();
+  } else {
+    IOBufOutputStream out(
+        *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+    {
+      MicrosecondTimer timer(&flushTimeUs);
+      batch_->flush(&out);
+    }
+    batch_.reset();
+    iobuf = out.getIOBuf();
+  }
+
+  if (ioExecutor_ != nullptr) {
+    const auto writtenBytes = iobuf->computeChainDataLength();
+    pendingWrite_ = std::make_shared<AsyncSource<uint64_t>>(
+        [this,
+         file,
+         flushTimeUs,
+         iobuf = std::make_shared<std::unique_ptr<folly::IOBuf>>(
+             std::move(iobuf))]() {
+          uint64_t writeTimeUs{0};
+          uint64_t writtenBytes{0};
+          {
+            MicrosecondTimer timer(&writeTimeUs);
+            writtenBytes = file->write(std::move(*iobuf));
+          }
+          updateWriteStats(writtenBytes, flushTimeUs, writeTimeUs);
+          return std::make_unique<uint64_t>(writtenBytes);
+        });
+    ioExecutor_->add([source = pendingWrite_]() { source->prepare(); });
+    updateAndCheckSpillLimitCb_(writtenBytes);
+    return writtenBytes;
   }
-  batch_.reset();
 
   uint64_t writeTimeUs{0};
   uint64_t writtenBytes{0};
-  auto iobuf = out.getIOBuf();
   {
     MicrosecondTimer timer(&writeTimeUs);
     writtenBytes = file->write(std::move(iobuf));
@@ -193,24 +334,88 @@ uint64_t SpillWriter::write(
   uint64_t timeUs{0};
   {
     MicrosecondTimer timer(&timeUs);
-    if (batch_ == nullptr) {
-      serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-          kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
-      batch_ = std::make_unique<VectorStreamGroup>(pool_);
-      batch_->createStreamTree(
-          std::static_pointer_cast<const RowType>(rows->type()),
-          1'000,
-          &options);
+    if (encodeSortedRuns_) {
+      writeEncoded(rows, indices);
+    } else {
+      if (batch_ == nullptr) {
+        serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+            kDefaultUseLosslessTimestamp,
+            compressionKind_,
+            true /*nullsFirst*/};
+        batch_ = std::make_unique<VectorStreamGroup>(pool_);
+        batch_->createStreamTree(
+            std::static_pointer_cast<const RowType>(rows->type()),
+            1'000,
+            &options);
+      }
+      batch_->append(rows, indices);
     }
-    batch_->append(rows, indices);
   }
   updateAppendStats(rows->size(), timeUs);
-  if (batch_->size() < writeBufferSize_) {
+  if (bufferedBytes() < writeBufferSize_) {
     return 0;
   }
   return flush();
 }
 
+void SpillWriter::writeEncoded(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  vector_size_t numRows = 0;
+  for (const auto& range : indices) {
+    numRows += range.size;
+  }
+  if (numRows == 0) {
+    return;
+  }
+
+  // Rows are sorted, so equal sort keys, and often the values of columns that
+  // depend on them, are adjacent. Each position of a column refers to the first
+  // row of its run. The serializer writes the used values of a dictionary once
+  // and flattens the columns where the dictionary does not pay off.
+  std::vector<VectorPtr> children;
+  children.reserve(rows->childrenSize());
+  for (const auto& child : rows->children()) {
+    auto runIndices = allocateIndices(numRows, pool_);
+    auto* rawRunIndices = runIndices->asMutable<vector_size_t>();
+    vector_size_t numRuns = 0;
+    vector_size_t runStart = -1;
+    vector_size_t position = 0;
+    for (const auto& range : indices) {
+      for (auto row = range.begin; row < range.begin + range.size; ++row) {
+        if (runStart < 0 || !child->equalValueAt(child.get(), row, runStart)) {
+          runStart = row;
+          ++numRuns;
+        }
+        rawRunIndices[position++] = runStart;
+      }
+    }
+    if (numRuns == numRows && indices.size() == 1 && indices[0].begin == 0 &&
+        numRows == rows->size()) {
+      children.push_back(child);
+      continue;
+    }
+    children.push_back(
+        BaseVector::wrapInDictionary(nullptr, runIndices, numRows, child));
+  }
+  auto encoded = std::make_shared<RowVector>(
+      pool_, rows->type(), nullptr, numRows, std::move(children));
+
+  if (encodedSerializer_ == nullptr) {
+    serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+        kDefaultUseLosslessTimestamp, compressionKind_, true /*nullsFirst*/};
+    encodedSerializer_ =
+        getVectorSerde()->createBatchSerializer(pool_, &options);
+  }
+  if (encodedBatch_ == nullptr) {
+    encodedBatch_ = std::make_unique<IOBufOutputStream>(
+        *pool_, nullptr, std::max<int64_t>(64 * 1024, writeBufferSize_));
+  }
+  const IndexRange range{0, numRows};
+  encodedSerializer_->serialize(
+      encoded, folly::Range<const IndexRange*>(&range, 1), encodedBatch_.get());
+}
+
 void SpillWriter::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeUs) {
@@ -284,7 +489,8 @@ std::vector<uint32_t> SpillWriter::testingSpilledFileIds() const {
 std::unique_ptr<SpillReadFile> SpillReadFile::create(
     const SpillFileInfo& fileInfo,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats) {
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor) {
   return std::unique_ptr<SpillReadFile>(new SpillReadFile(
       fileInfo.id,
       fileInfo.path,
@@ -294,7 +500,8 @@ std::unique_ptr<SpillReadFile> SpillReadFile::create(
       fileInfo.sortFlags,
       fileInfo.compressionKind,
       pool,
-      stats));
+      stats,
+      readAheadExecutor));
 }
 
 SpillReadFile::SpillReadFile(
@@ -306,7 +513,8 @@ SpillReadFile::SpillReadFile(
     const std::vector<CompareFlags>& sortCompareFlags,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<common::SpillStats>* stats)
+    folly::Synchronized<common::SpillStats>* stats,
+    folly::Executor* readAheadExecutor)
     : id_(id),
       path_(path),
       size_(size),
@@ -327,7 +535,7 @@ SpillReadFile::SpillReadFile(
   auto buffer = AlignedBuffer::allocate<char>(
       std::min<uint64_t>(size_, kMaxReadBufferSize), pool_);
   input_ = std::make_unique<SpillInputStream>(
-      std::move(file), std::move(buffer), stats_);
+      std::move(file), std::move(buffer), stats_, readAheadExecutor);
 }
 
 bool SpillReadFile::nextBatch(RowVectorPtr& rowVector) {
@@ -18,6 +18,7 @@
 
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SpillConfig.h"
 #include "velox/common/base/SpillStats.h"
 #include "velox/common/compression/Compression.h"
@@ -109,6 +110,18 @@ class SpillWriter {
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
+  ///
+  /// If 'encodeSortedRuns' is true and 'numSortKeys' is not zero, each write
+  /// is serialized as a separate batch in which every column is dictionary
+  /// encoded over its runs of equal consecutive values, so that repeated sort
+  /// keys are written once per run.
+  ///
+  /// If 'ioExecutor' is set, the buffered data is written to the file on
+  /// 'ioExecutor' while the next buffer is serialized. At most one write is in
+  /// flight.
+  ///
+  /// If 'offloadCb' is set, it is called with the size of each finished file
+  /// and the file is moved to the directory it returns, if any.
   SpillWriter(
       const RowTypePtr& type,
       const uint32_t numSortKeys,
@@ -120,7 +133,12 @@ class SpillWriter {
       const std::string& fileCreateConfig,
       common::UpdateAndCheckSpillLimitCB& updateAndCheckSpillLimitCb,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      bool encodeSortedRuns = false,
+      folly::Executor* ioExecutor = nullptr,
+      const common::SpillFileOffloadCB& offloadCb = nullptr);
+
+  ~SpillWriter();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -161,10 +179,27 @@ class SpillWriter {
   // Closes the current open spill file pointed by 'currentFile_'.
   void closeFile();
 
-  // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // Moves the finished file at 'path' to the directory returned by
+  // 'offloadCb_', if any. Returns the path of the file after the move.
+  std::string maybeOffloadFile(const std::string& path, uint64_t size);
+
+  // Writes data from 'batch_' or 'encodedBatch_' to the current output file.
+  // Returns the actual written size.
   uint64_t flush();
 
+  // Serializes the rows of 'rows' in 'indices' into 'encodedBatch_' with the
+  // columns dictionary encoded over their runs of equal values.
+  void writeEncoded(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
+  // Returns the serialized size of the buffered rows.
+  uint64_t bufferedBytes() const;
+
+  // Waits for the write in flight on 'ioExecutor_', if any, and throws its
+  // error.
+  void waitForPendingWrite();
+
   // Invoked to increment the number of spilled files and the file size.
   void updateSpilledFileStats(uint64_t fileSize);
 
@@ -191,10 +226,18 @@ class SpillWriter {
   common::UpdateAndCheckSpillLimitCB updateAndCheckSpillLimitCb_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  const bool encodeSortedRuns_;
+  folly::Executor* const ioExecutor_;
+  const common::SpillFileOffloadCB offloadCb_;
 
   bool finished_{false};
   uint32_t nextFileId_{0};
   std::unique_ptr<VectorStreamGroup> batch_;
+  // Serialized batches buffered when 'encodeSortedRuns_' is set.
+  std::unique_ptr<BatchVectorSerializer> encodedSerializer_;
+  std::unique_ptr<IOBufOutputStream> encodedBatch_;
+  // The write in flight on 'ioExecutor_'.
+  std::shared_ptr<AsyncSource<uint64_t>> pendingWrite_;
   std::unique_ptr<SpillWriteFile> currentFile_;
   SpillFiles finishedFiles_;
 };
@@ -206,18 +249,24 @@ class SpillWriter {
 /// remainingSize() APIs do not work properly.
 class SpillInputStream : public ByteInputStream {
  public:
-  /// Reads from 'input' using 'buffer' for buffering reads.
+  /// Reads from 'input' using 'buffer' for buffering reads. If
+  /// 'readAheadExecutor' is set, reads the next buffer on it into a second
+  /// buffer of the same size while 'buffer' is consumed.
   SpillInputStream(
       std::unique_ptr<ReadFile>&& file,
       BufferPtr buffer,
-      folly::Synchronized<common::SpillStats>* stats)
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr)
       : file_(std::move(file)),
         size_(file_->size()),
         buffer_(std::move(buffer)),
-        stats_(stats) {
+        stats_(stats),
+        readAheadExecutor_(readAheadExecutor) {
     next(true);
   }
 
+  ~SpillInputStream() override;
+
   /// True if all of the file has been read into vectors.
   bool atEnd() const override {
     return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
@@ -227,13 +276,23 @@ class SpillInputStream : public ByteInputStream {
   void updateSpillStats(uint64_t readBytes, uint64_t readTimeUs) const;
   void next(bool throwIfPastEnd) override;
 
+  // Starts reading the bytes after 'offset_' into 'readAheadBuffer_' on
+  // 'readAheadExecutor_'.
+  void startReadAhead();
+
   const std::unique_ptr<ReadFile> file_;
   const uint64_t size_;
-  const BufferPtr buffer_;
+  BufferPtr buffer_;
   folly::Synchronized<common::SpillStats>* const stats_;
+  folly::Executor* const readAheadExecutor_;
 
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+
+  // The buffer being read ahead and the read in flight, which returns the
+  // number of bytes read.
+  BufferPtr readAheadBuffer_;
+  std::shared_ptr<AsyncSource<int32_t>> readAhead_;
 };
 
 /// Represents a spill file for read which turns the serialized spilled data on
@@ -248,7 +307,8 @@ class SpillReadFile {
   static std::unique_ptr<SpillReadFile> create(
       const SpillFileInfo& fileInfo,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor = nullptr);
 
   uint32_t id() const {
     return id_;
@@ -283,7 +343,8 @@ class SpillReadFile {
       const std::vector<CompareFlags>& sortCompareFlags,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<common::SpillStats>* stats);
+      folly::Synchronized<common::SpillStats>* stats,
+      folly::Executor* readAheadExecutor);
 
   // The spill file id which is monotonically increasing and unique for each
   // associated spill partition.
@@ -58,6 +58,9 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->encodeSortedRuns,
+          spillConfig->ioExecutor(),
+          spillConfig->offloadCb,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -93,6 +96,9 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->encodeSortedRuns,
+          spillConfig->ioExecutor(),
+          spillConfig->offloadCb,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kOrderByInput || type_ == Type::kAggregateInput,
@@ -124,6 +130,9 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->encodeSortedRuns,
+          spillConfig->ioExecutor(),
+          spillConfig->offloadCb,
           spillStats) {
   VELOX_CHECK(
       type_ == Type::kAggregateOutput || type_ == Type::kOrderByOutput,
@@ -156,6 +165,9 @@ Spiller::Spiller(
           spillConfig->executor,
           0,
           spillConfig->fileCreateConfig,
+          spillConfig->encodeSortedRuns,
+          spillConfig->ioExecutor(),
+          spillConfig->offloadCb,
           spillStats) {
   VELOX_CHECK_EQ(
       type_,
@@ -189,9 +201,13 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->encodeSortedRuns,
+          spillConfig->ioExecutor(),
+          spillConfig->offloadCb,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
   VELOX_CHECK(isHashJoinTableSpillType(rowType_, joinType));
+  spillSerializedRows_ = isHashJoinTableSerializedSpillType(rowType_);
 }
 
 Spiller::Spiller(
@@ -218,6 +234,9 @@ Spiller::Spiller(
           spillConfig->executor,
           spillConfig->maxSpillRunRows,
           spillConfig->fileCreateConfig,
+          spillConfig->encodeSortedRuns,
+          spillConfig->ioExecutor(),
+          spillConfig->offloadCb,
           spillStats) {
   VELOX_CHECK_EQ(type_, Type::kRowNumber);
 }
@@ -239,6 +258,9 @@ Spiller::Spiller(
     folly::Executor* executor,
     uint64_t maxSpillRunRows,
     const std::string& fileCreateConfig,
+    bool encodeSortedRuns,
+    folly::Executor* ioExecutor,
+    const common::SpillFileOffloadCB& offloadCb,
     folly::Synchronized<common::SpillStats>* spillStats)
     : type_(type),
       container_(container),
@@ -260,7 +282,10 @@ Spiller::Spiller(
           compressionKind,
           memory::spillMemoryPool(),
           spillStats,
-          fileCreateConfig) {
+          fileCreateConfig,
+          encodeSortedRuns,
+          ioExecutor,
+          offloadCb) {
   TestValue::adjust("facebook::velox::exec::Spiller", this);
 
   VELOX_CHECK(!spillProbedFlag_ || type_ == Type::kHashJoinBuild);
@@ -281,6 +306,10 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
   }
 
   auto* result = resultPtr.get();
+  if (spillSerializedRows_) {
+    extractSerializedSpill(rows, result);
+    return;
+  }
   const auto& types = container_->columnTypes();
   for (auto i = 0; i < types.size(); ++i) {
     container_->extractColumn(rows.data(), rows.size(), i, result->childAt(i));
@@ -298,6 +327,28 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
   }
 }
 
+void Spiller::extractSerializedSpill(
+    folly::Range<char**> rows,
+    RowVector* result) {
+  VELOX_CHECK_EQ(type_, Type::kHashJoinBuild);
+  VELOX_CHECK(container_->accumulators().empty());
+  const auto& types = container_->columnTypes();
+  const auto numKeys = container_->keyTypes().size();
+  for (auto i = 0; i < numKeys; ++i) {
+    container_->extractColumn(rows.data(), rows.size(), i, result->childAt(i));
+  }
+  for (auto i = numKeys; i < types.size(); ++i) {
+    result->childAt(i) = BaseVector::createNullConstant(
+        types[i], rows.size(), memory::spillMemoryPool());
+  }
+  if (spillProbedFlag_) {
+    container_->extractProbedFlags(
+        rows.data(), rows.size(), false, false, result->childAt(types.size()));
+  }
+  container_->extractSerializedRows(
+      rows, result->childAt(rowType_->size() - 1));
+}
+
 int64_t Spiller::extractSpillVector(
     SpillRows& rows,
     int32_t maxRows,
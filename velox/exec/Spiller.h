@@ -218,6 +218,9 @@ class Spiller {
       folly::Executor* executor,
       uint64_t maxSpillRunRows,
       const std::string& fileCreateConfig,
+      bool encodeSortedRuns,
+      folly::Executor* ioExecutor,
+      const common::SpillFileOffloadCB& offloadCb,
       folly::Synchronized<common::SpillStats>* spillStats);
 
   // Invoked to spill. If 'startRowIter' is not null, then we only spill rows
@@ -229,6 +232,11 @@ class Spiller {
   // RowContainerSpillMergeStream.
   void extractSpill(folly::Range<char**> rows, RowVectorPtr& result);
 
+  // Extracts the keys and probed flags of 'rows' into their columns of
+  // '*result' and the whole rows into the serialized row column. The dependent
+  // columns are set to null.
+  void extractSerializedSpill(folly::Range<char**> rows, RowVector* result);
+
   // Returns a mergeable stream that goes over unspilled in-memory
   // rows for the spill partition  'partition'. finishSpill()
   // first and 'partition' must specify a partition that has started spilling.
@@ -328,6 +336,9 @@ class Spiller {
   const HashBitRange bits_;
   const RowTypePtr rowType_;
   const bool spillProbedFlag_;
+  // True if the hash join table rows are spilled as serialized rows. Set if
+  // 'rowType_' is a serialized hash join table spill type.
+  bool spillSerializedRows_{false};
   const uint64_t maxSpillRunRows_;
 
   folly::Synchronized<common::SpillStats>* const spillStats_;
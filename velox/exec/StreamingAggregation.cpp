@@ -294,6 +294,7 @@ RowVectorPtr StreamingAggregation::getOutput() {
   evaluateAggregates();
 
   RowVectorPtr output;
+  outputBatchSize_ = outputBatchRows();
   if (numGroups_ > outputBatchSize_) {
     output = createOutput(outputBatchSize_);
 
@@ -22,8 +22,25 @@ StreamingWindowBuild::StreamingWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
-    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection) {}
+    tsan_atomic<bool>* nonReclaimableSection,
+    bool streamRows)
+    : WindowBuild(windowNode, pool, spillConfig, nonReclaimableSection),
+      streamRows_(streamRows) {}
+
+void StreamingWindowBuild::addRowsToPartialPartition(bool complete) {
+  if (partialPartition_ == nullptr) {
+    auto partition = std::make_unique<WindowPartition>(
+        data_.get(), inversedInputChannels_, sortKeyInfo_);
+    partialPartition_ = partition.get();
+    pendingPartitions_.push_back(std::move(partition));
+  }
+  partialPartition_->addRows(inputRows_);
+  inputRows_.clear();
+  if (complete) {
+    partialPartition_->setComplete();
+    partialPartition_ = nullptr;
+  }
+}
 
 void StreamingWindowBuild::buildNextPartition() {
   partitionStartRows_.push_back(sortedRows_.size());
@@ -45,15 +62,31 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
 
     if (previousRow_ != nullptr &&
         compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
-      buildNextPartition();
+      if (streamRows_) {
+        addRowsToPartialPartition(true);
+      } else {
+        buildNextPartition();
+      }
     }
 
     inputRows_.push_back(newRow);
     previousRow_ = newRow;
   }
+
+  if (streamRows_ && !inputRows_.empty()) {
+    addRowsToPartialPartition(false);
+  }
 }
 
 void StreamingWindowBuild::noMoreInput() {
+  if (streamRows_) {
+    if (partialPartition_ != nullptr) {
+      partialPartition_->setComplete();
+      partialPartition_ = nullptr;
+    }
+    return;
+  }
+
   buildNextPartition();
 
   // Help for last partition related calculations.
@@ -61,6 +94,13 @@ void StreamingWindowBuild::noMoreInput() {
 }
 
 std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
+  if (streamRows_) {
+    VELOX_CHECK(!pendingPartitions_.empty(), "No window partitions available");
+    auto partition = std::move(pendingPartitions_.front());
+    pendingPartitions_.pop_front();
+    return partition;
+  }
+
   VELOX_CHECK_GT(
       partitionStartRows_.size(), 0, "No window partitions available")
 
@@ -94,6 +134,10 @@ std::unique_ptr<WindowPartition> StreamingWindowBuild::nextPartition() {
 }
 
 bool StreamingWindowBuild::hasNextPartition() {
+  if (streamRows_) {
+    return !pendingPartitions_.empty();
+  }
+
   return partitionStartRows_.size() > 0 &&
       currentPartition_ < int(partitionStartRows_.size() - 2);
 }
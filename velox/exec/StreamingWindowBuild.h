@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -24,13 +26,20 @@ namespace facebook::velox::exec {
 /// {partition keys + order by keys}. The logic identifies partition changes
 /// when receiving input rows and splits out WindowPartitions for the Window
 /// operator to process.
+///
+/// If 'streamRows' is true, the partitions are returned as partial
+/// WindowPartitions as soon as their first rows arrive, and later rows are
+/// added to them while the Window processes the earlier rows. The Window
+/// erases the processed rows, so only the rows not yet output are held in
+/// memory. This requires all window functions to support streaming.
 class StreamingWindowBuild : public WindowBuild {
  public:
   StreamingWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      bool streamRows = false);
 
   void addInput(RowVectorPtr input) override;
 
@@ -49,6 +58,10 @@ class StreamingWindowBuild : public WindowBuild {
   std::unique_ptr<WindowPartition> nextPartition() override;
 
   bool needsInput() override {
+    if (streamRows_) {
+      // The Window has all the partitions started so far.
+      return pendingPartitions_.empty();
+    }
     // No partitions are available or the currentPartition is the last available
     // one, so can consume input rows.
     return partitionStartRows_.size() == 0 ||
@@ -58,6 +71,19 @@ class StreamingWindowBuild : public WindowBuild {
  private:
   void buildNextPartition();
 
+  // Adds 'inputRows_' to the partial partition receiving rows, creating it
+  // if needed. If 'complete' is true, the partition has all its rows.
+  void addRowsToPartialPartition(bool complete);
+
+  const bool streamRows_;
+
+  // Partial partitions not yet returned by nextPartition().
+  std::deque<std::unique_ptr<WindowPartition>> pendingPartitions_;
+
+  // The partial partition receiving rows. Owned by 'pendingPartitions_' or by
+  // the Window, which does not release it before it is complete.
+  WindowPartition* partialPartition_{nullptr};
+
   // Vector of pointers to each input row in the data_ RowContainer.
   // Rows are erased from data_ when they are output from the
   // Window operator.
@@ -42,8 +42,13 @@ TableScan::TableScan(
           driverCtx_->driverId,
           operatorType(),
           tableHandle_->connectorId())),
+      splitPreloadPool_(driverCtx_->task->getOrAddSplitPreloadPoolLocked(
+          planNodeId(),
+          tableHandle_->connectorId())),
       maxSplitPreloadPerDriver_(
           driverCtx_->queryConfig().maxSplitPreloadPerDriver()),
+      splitPreloadMemoryBudget_(
+          driverCtx_->queryConfig().splitPreloadMemoryBudget()),
       readBatchSize_(driverCtx_->queryConfig().preferredOutputBatchRows()),
       maxReadBatchSize_(driverCtx_->queryConfig().maxOutputBatchRows()),
       getOutputTimeLimitMs_(
@@ -102,13 +107,18 @@ RowVectorPtr TableScan::getOutput() {
       TestValue::adjust("facebook::velox::exec::TableScan::getOutput", this);
 
       exec::Split split;
+      int32_t maxPreloadSplits = maxPreloadedSplits_;
+      if (maxPreloadSplits > 0 && splitPreloadOverBudget()) {
+        maxPreloadSplits = 0;
+        ++numSplitPreloadsOverBudget_;
+      }
       curStatus_ = "getOutput: task->getSplitOrFuture";
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
           driverCtx_->splitGroupId,
           planNodeId(),
           split,
           blockingFuture_,
-          maxPreloadedSplits_,
+          maxPreloadSplits,
           splitPreloader_);
       if (blockingReason_ != BlockingReason::kNotBlocked) {
         return nullptr;
@@ -279,6 +289,12 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numSplitPreloadsOverBudget_ > 0) {
+        lockedStats->addRuntimeStat(
+            "splitPreloadsOverBudget",
+            RuntimeCounter(numSplitPreloadsOverBudget_));
+        numSplitPreloadsOverBudget_ = 0;
+      }
     }
 
     curStatus_ = "getOutput: task->splitFinished";
@@ -299,7 +315,11 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
        columns = columnHandles_,
        connector = connector_,
        ctx = operatorCtx_->createConnectorQueryCtx(
-           split->connectorId, planNodeId(), connectorPool_),
+           split->connectorId,
+           planNodeId(),
+           connectorPool_,
+           /*spillConfig=*/nullptr,
+           splitPreloadPool_),
        task = operatorCtx_->task(),
        dynamicFilters = dynamicFilters_,
        split]() -> std::unique_ptr<connector::DataSource> {
@@ -327,6 +347,11 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
       });
 }
 
+bool TableScan::splitPreloadOverBudget() const {
+  return splitPreloadMemoryBudget_ > 0 &&
+      splitPreloadPool_->usedBytes() >= splitPreloadMemoryBudget_;
+}
+
 void TableScan::checkPreload() {
   auto* executor = connector_->executor();
   if (maxSplitPreloadPerDriver_ == 0 || !executor ||
@@ -362,7 +387,17 @@ void TableScan::addDynamicFilter(
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   }
-  dynamicFilters_.emplace(outputChannel, filter);
+  // Producers like TopN add tighter filters on the same channel over time.
+  auto it = dynamicFilters_.find(outputChannel);
+  if (it == dynamicFilters_.end()) {
+    dynamicFilters_.emplace(outputChannel, filter);
+  } else if (
+      filter->kind() == common::FilterKind::kBigintValuesUsingBloomFilter) {
+    // Only the Bloom filter knows how to combine itself with other filters.
+    it->second = filter->mergeWith(it->second.get());
+  } else {
+    it->second = it->second->mergeWith(filter.get());
+  }
   stats_.wlock()->dynamicFilterStats.producerNodeIds.emplace(producer);
 }
 
@@ -64,6 +64,10 @@ class TableScan : public SourceOperator {
   // of the Task's split queue for 'this' when getting splits.
   void checkPreload();
 
+  // Returns true if the data sources of preloaded splits of the scan hold at
+  // least 'splitPreloadMemoryBudget_' bytes.
+  bool splitPreloadOverBudget() const;
+
   // Sets 'split->dataSource' to be an AsyncSource that makes a DataSource to
   // read 'split'. This source will be prepared in the background on the
   // executor of the connector. If the DataSource is needed before prepare is
@@ -76,6 +80,9 @@ class TableScan : public SourceOperator {
           columnHandles_;
   DriverCtx* const driverCtx_;
   memory::MemoryPool* const connectorPool_;
+  // Pool of the data sources of preloaded splits, shared by all drivers of
+  // the scan in the Task.
+  memory::MemoryPool* const splitPreloadPool_;
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
   BlockingReason blockingReason_;
   int64_t currentSplitWeight_{0};
@@ -84,7 +91,8 @@ class TableScan : public SourceOperator {
   std::shared_ptr<connector::ConnectorQueryCtx> connectorQueryCtx_;
   std::unique_ptr<connector::DataSource> dataSource_;
   bool noMoreSplits_ = false;
-  // Dynamic filters to add to the data source when it gets created.
+  // Dynamic filters to add to the data source when it gets created. Filters
+  // added on the same channel are merged.
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       dynamicFilters_;
 
@@ -92,6 +100,10 @@ class TableScan : public SourceOperator {
 
   const int32_t maxSplitPreloadPerDriver_{0};
 
+  // Max bytes in 'splitPreloadPool_' for starting new preloads. 0 means no
+  // limit.
+  const uint64_t splitPreloadMemoryBudget_{0};
+
   // Callback passed to getSplitOrFuture() for triggering async preload. The
   // callback's lifetime is the lifetime of 'this'. This callback can schedule
   // preloads on an executor. These preloads may outlive the Task and therefore
@@ -105,6 +117,10 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Count of splits gotten without starting preloads because the preloads
+  // were over the memory budget.
+  int32_t numSplitPreloadsOverBudget_{0};
+
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
 
@@ -304,6 +304,11 @@ Task::Task(
     VELOX_CHECK_NULL(
         dynamic_cast<const folly::InlineLikeExecutor*>(queryCtx_->executor()));
   }
+  maxRunningDrivers_ = queryCtx_->queryConfig().maxRunningDriversPerTask();
+  if (const auto capacity = queryCtx_->queryConfig().driverTimelineCapacity();
+      capacity > 0) {
+    driverTimeline_ = std::make_unique<DriverTimeline>(capacity);
+  }
 }
 
 Task::~Task() {
@@ -399,16 +404,55 @@ const std::string& Task::getOrCreateSpillDirectory() {
   return spillDirectory_;
 }
 
+std::string Task::spillOffloadDirectory(uint64_t fileSize) {
+  const auto& queryConfig = queryCtx_->queryConfig();
+  const auto remoteDirectory = queryConfig.spillRemoteDirectory();
+  if (remoteDirectory.empty() ||
+      queryCtx_->spilledBytes() <= queryConfig.spillLocalBytesThreshold()) {
+    return "";
+  }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (remoteSpillDirectory_.empty()) {
+    const auto path = fmt::format("{}/{}", remoteDirectory, taskId());
+    try {
+      auto fileSystem = filesystems::getFileSystem(path, nullptr);
+      fileSystem->mkdir(path);
+    } catch (const std::exception& e) {
+      VELOX_FAIL(
+          "Failed to create remote spill directory '{}' for Task {}: {}",
+          path,
+          taskId(),
+          e.what());
+    }
+    remoteSpillDirectory_ = path;
+  }
+  queryCtx_->releaseSpilledBytes(fileSize);
+  return remoteSpillDirectory_;
+}
+
 void Task::removeSpillDirectoryIfExists() {
-  if (spillDirectory_.empty() || !spillDirectoryCreated_) {
+  if (!spillDirectory_.empty() && spillDirectoryCreated_) {
+    try {
+      auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
+      fs->rmdir(spillDirectory_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
+                 << "' for Task " << taskId() << ": " << e.what();
+    }
+  }
+
+  std::lock_guard<std::mutex> l(spillDirCreateMutex_);
+  if (remoteSpillDirectory_.empty()) {
     return;
   }
   try {
-    auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-    fs->rmdir(spillDirectory_);
+    auto fs = filesystems::getFileSystem(remoteSpillDirectory_, nullptr);
+    fs->rmdir(remoteSpillDirectory_);
   } catch (const std::exception& e) {
-    LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
-               << "' for Task " << taskId() << ": " << e.what();
+    LOG(ERROR) << "Failed to remove remote spill directory '"
+               << remoteSpillDirectory_ << "' for Task " << taskId() << ": "
+               << e.what();
   }
 }
 
@@ -516,6 +560,21 @@ velox::memory::MemoryPool* Task::addConnectorPoolLocked(
   return childPools_.back().get();
 }
 
+velox::memory::MemoryPool* Task::getOrAddSplitPreloadPoolLocked(
+    const core::PlanNodeId& planNodeId,
+    const std::string& connectorId) {
+  auto it = splitPreloadPools_.find(planNodeId);
+  if (it != splitPreloadPools_.end()) {
+    return it->second;
+  }
+  auto* nodePool = getOrAddNodePool(planNodeId);
+  childPools_.push_back(nodePool->addLeafChild(
+      fmt::format("splitPreload.{}.{}", planNodeId, connectorId)));
+  auto* preloadPool = childPools_.back().get();
+  splitPreloadPools_[planNodeId] = preloadPool;
+  return preloadPool;
+}
+
 velox::memory::MemoryPool* Task::addMergeSourcePool(
     const core::PlanNodeId& planNodeId,
     uint32_t pipelineId,
@@ -1085,6 +1144,48 @@ std::vector<std::shared_ptr<Driver>> Task::createDriversLocked(
   return drivers;
 }
 
+void Task::setMaxRunningDrivers(uint32_t maxRunningDrivers) {
+  std::vector<std::shared_ptr<Driver>> toAdd;
+  {
+    std::lock_guard<std::mutex> l(driverSlotMutex_);
+    maxRunningDrivers_ = maxRunningDrivers;
+    while (!waitingDrivers_.empty() &&
+           (maxRunningDrivers_ == 0 ||
+            numDriversInExecutor_ < maxRunningDrivers_)) {
+      toAdd.push_back(std::move(waitingDrivers_.front()));
+      waitingDrivers_.pop_front();
+      ++numDriversInExecutor_;
+    }
+  }
+  for (auto& driver : toAdd) {
+    Driver::addToExecutor(std::move(driver));
+  }
+}
+
+bool Task::acquireDriverSlot(const std::shared_ptr<Driver>& driver) {
+  std::lock_guard<std::mutex> l(driverSlotMutex_);
+  if (maxRunningDrivers_ == 0 || numDriversInExecutor_ < maxRunningDrivers_) {
+    ++numDriversInExecutor_;
+    return true;
+  }
+  waitingDrivers_.push_back(driver);
+  return false;
+}
+
+std::shared_ptr<Driver> Task::releaseDriverSlot() {
+  std::lock_guard<std::mutex> l(driverSlotMutex_);
+  VELOX_CHECK_GT(numDriversInExecutor_, 0);
+  if (waitingDrivers_.empty() ||
+      (maxRunningDrivers_ != 0 && numDriversInExecutor_ > maxRunningDrivers_)) {
+    --numDriversInExecutor_;
+    return nullptr;
+  }
+  // The returning driver hands its slot to the first waiting one.
+  auto driver = std::move(waitingDrivers_.front());
+  waitingDrivers_.pop_front();
+  return driver;
+}
+
 // static
 void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   bool foundDriver = false;
@@ -1119,6 +1220,9 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
       if (splitGroupState.numRunningDrivers == 0) {
         if (splitGroupId != kUngroupedGroupId) {
           --self->numRunningSplitGroups_;
+          self->maxSplitGroupMemoryBytes_ = std::max(
+              self->maxSplitGroupMemoryBytes_, splitGroupState.peakMemoryBytes);
+          splitGroupState.peakMemoryBytes = 0;
           self->taskStats_.completedSplitGroups.emplace(splitGroupId);
           stateChangeNotifier.activate(std::move(self->stateChangePromises_));
           splitGroupState.clear();
@@ -1155,7 +1259,8 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
     return;
   }
 
-  while (numRunningSplitGroups_ < concurrentSplitGroups_ and
+  const auto maxConcurrentSplitGroups = maxConcurrentSplitGroupsLocked();
+  while (numRunningSplitGroups_ < maxConcurrentSplitGroups and
          not queuedSplitGroups_.empty()) {
     const uint32_t splitGroupId = queuedSplitGroups_.front();
     queuedSplitGroups_.pop();
@@ -1182,6 +1287,22 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked() {
   }
 }
 
+uint32_t Task::maxConcurrentSplitGroupsLocked() const {
+  const auto budget = queryCtx_->queryConfig().splitGroupMemoryBudget();
+  if (budget == 0) {
+    return concurrentSplitGroups_;
+  }
+  if (taskStats_.completedSplitGroups.empty()) {
+    // No estimate of the memory of a split group yet.
+    return 1;
+  }
+  if (maxSplitGroupMemoryBytes_ == 0) {
+    return concurrentSplitGroups_;
+  }
+  return std::clamp<uint64_t>(
+      budget / maxSplitGroupMemoryBytes_, 1, concurrentSplitGroups_);
+}
+
 void Task::setMaxSplitSequenceId(
     const core::PlanNodeId& planNodeId,
     long maxSequenceId) {
@@ -2029,6 +2150,14 @@ ContinueFuture Task::makeFinishFutureLocked(const char* comment) {
   return std::move(future);
 }
 
+void Task::addSplitGroupPeakMemory(uint32_t splitGroupId, uint64_t bytes) {
+  std::lock_guard<std::timed_mutex> l(mutex_);
+  auto it = splitGroupStates_.find(splitGroupId);
+  if (it != splitGroupStates_.end()) {
+    it->second.peakMemoryBytes += bytes;
+  }
+}
+
 void Task::addOperatorStats(OperatorStats& stats) {
   std::lock_guard<std::timed_mutex> l(mutex_);
   VELOX_CHECK(
@@ -2547,6 +2676,10 @@ void Task::leave(
       promise.setValue();
     }
   });
+  auto clearThread = [&]() {
+    queryCtx_->addDriverExecTimeMs(state.execTimeMs());
+    state.clearThread();
+  };
   StopReason reason;
   {
     std::lock_guard<std::timed_mutex> l(mutex_);
@@ -2562,7 +2695,7 @@ void Task::leave(
       if (--numThreads_ == 0) {
         threadFinishPromises = allThreadsFinishedLocked();
       }
-      state.clearThread();
+      clearThread();
       return;
     }
   }
@@ -2577,7 +2710,7 @@ void Task::leave(
   if (--numThreads_ == 0) {
     threadFinishPromises = allThreadsFinishedLocked();
   }
-  state.clearThread();
+  clearThread();
 }
 
 StopReason Task::enterSuspended(ThreadState& state) {
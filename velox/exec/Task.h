@@ -17,6 +17,7 @@
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/DriverTimeline.h"
 #include "velox/exec/LocalPartition.h"
 #include "velox/exec/MemoryReclaimer.h"
 #include "velox/exec/MergeSource.h"
@@ -376,6 +377,14 @@ class Task : public std::enable_shared_from_this<Task> {
       const std::string& operatorType,
       const std::string& connectorId);
 
+  /// Returns the leaf MemoryPool for the data sources that preload splits of
+  /// the TableScan with 'planNodeId'. The pool is shared by all drivers of the
+  /// scan so that its usage is the memory held by preloads of the whole scan.
+  /// Not thread safe, e.g. must be called from the Operator's constructor.
+  velox::memory::MemoryPool* getOrAddSplitPreloadPoolLocked(
+      const core::PlanNodeId& planNodeId,
+      const std::string& connectorId);
+
   /// Creates new instance of MemoryPool for a merge source in a
   /// MergeExchangeNode, stores it in the task to ensure lifetime and returns a
   /// raw pointer.
@@ -534,6 +543,10 @@ class Task : public std::enable_shared_from_this<Task> {
   /// Adds per driver statistics.  Called from Drivers upon their closure.
   void addDriverStats(int pipelineId, DriverStats stats);
 
+  /// Adds the peak memory of the operators of a closed driver of
+  /// 'splitGroupId'. Called from Drivers upon their closure.
+  void addSplitGroupPeakMemory(uint32_t splitGroupId, uint64_t bytes);
+
   /// Returns kNone if no pause or terminate is requested. The thread count is
   /// incremented if kNone is returned. If something else is returned the
   /// calling thread should unwind and return itself to its pool. If 'this' goes
@@ -625,6 +638,32 @@ class Task : public std::enable_shared_from_this<Task> {
     return mutex_;
   }
 
+  /// Sets the maximum number of drivers of 'this' that are in the executor at
+  /// the same time. 0 means no limit. Drivers that wait for a slot are added
+  /// to the executor right away if the limit is raised. See
+  /// QueryConfig::kMaxRunningDriversPerTask.
+  void setMaxRunningDrivers(uint32_t maxRunningDrivers);
+
+  uint32_t maxRunningDrivers() const {
+    std::lock_guard<std::mutex> l(driverSlotMutex_);
+    return maxRunningDrivers_;
+  }
+
+  /// Returns true if 'driver' may be added to the executor. Otherwise keeps
+  /// 'driver' to be returned by releaseDriverSlot() once a slot is free.
+  bool acquireDriverSlot(const std::shared_ptr<Driver>& driver);
+
+  /// Called when a driver added to the executor returns from Driver::run().
+  /// Returns a driver that waits for a slot and is to be added to the executor
+  /// in place of the returning one or nullptr.
+  std::shared_ptr<Driver> releaseDriverSlot();
+
+  /// Returns the timeline of the drivers of 'this' or nullptr if not enabled
+  /// by QueryConfig::kDriverTimelineCapacity.
+  DriverTimeline* driverTimeline() const {
+    return driverTimeline_.get();
+  }
+
   /// Returns the number of concurrent drivers in the pipeline of 'driver'.
   int32_t numDrivers(Driver* driver) {
     return driverFactories_[driver->driverCtx()->pipelineId]->numDrivers;
@@ -650,6 +689,14 @@ class Task : public std::enable_shared_from_this<Task> {
   /// folder could not be created.
   const std::string& getOrCreateSpillDirectory();
 
+  /// Returns the directory to move a finished spill file of 'fileSize' bytes
+  /// to, or an empty string if the file stays in the local spill directory.
+  /// Files are moved if 'spill_remote_directory' is set and the query has
+  /// more than 'spill_local_bytes_threshold' local spill bytes. Creates the
+  /// remote directory of 'this' on first use and releases 'fileSize' from the
+  /// query local spill bytes if it returns a directory. Is thread safe.
+  std::string spillOffloadDirectory(uint64_t fileSize);
+
   /// True if produces output via OutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -863,6 +910,11 @@ class Task : public std::enable_shared_from_this<Task> {
   // processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked();
 
+  // Returns the number of split groups to run concurrently. This is
+  // 'concurrentSplitGroups_' unless limited by
+  // QueryConfig::kSplitGroupMemoryBudget.
+  uint32_t maxConcurrentSplitGroupsLocked() const;
+
   void driverClosedLocked();
 
   // Returns true if Task is in kRunning state, but all output drivers finished
@@ -1004,6 +1056,10 @@ class Task : public std::enable_shared_from_this<Task> {
   // NOTE: 'childPools_' holds the ownerships of node memory pools.
   std::unordered_map<std::string, memory::MemoryPool*> nodePools_;
 
+  // The map from plan node id to the pool of the split preloads of the
+  // corresponding TableScan. 'childPools_' holds the ownerships.
+  std::unordered_map<std::string, memory::MemoryPool*> splitPreloadPools_;
+
   // Set to true by OutputBufferManager when all output is
   // acknowledged. If this happens before Drivers are at end, the last
   // Driver to finish will set state_ to kFinished. If Drivers have
@@ -1074,6 +1130,9 @@ class Task : public std::enable_shared_from_this<Task> {
   bool groupedPartitionedOutput_{false};
   /// The number of splits groups we run concurrently.
   uint32_t concurrentSplitGroups_{1};
+  /// The largest peak memory of a completed split group. See
+  /// SplitGroupState::peakMemoryBytes.
+  uint64_t maxSplitGroupMemoryBytes_{0};
 
   /// Have we already initialized stats of operators in the drivers for Grouped
   /// Execution?
@@ -1145,6 +1204,21 @@ class Task : public std::enable_shared_from_this<Task> {
   // Base spill directory for this task.
   std::string spillDirectory_;
 
+  // Set if QueryConfig::kDriverTimelineCapacity is not zero.
+  std::unique_ptr<DriverTimeline> driverTimeline_;
+
+  // Guards 'maxRunningDrivers_', 'numDriversInExecutor_' and
+  // 'waitingDrivers_'. Not 'mutex_' since drivers are enqueued both with and
+  // without 'mutex_' held.
+  mutable std::mutex driverSlotMutex_;
+  // Maximum number of drivers in the executor, 0 for no limit.
+  uint32_t maxRunningDrivers_{0};
+  // Number of drivers added to the executor that have not returned from
+  // Driver::run().
+  uint32_t numDriversInExecutor_{0};
+  // Enqueued drivers waiting for a slot in the executor in FIFO order.
+  std::deque<std::shared_ptr<Driver>> waitingDrivers_;
+
   // Mutex to ensure only the first caller thread of 'getOrCreateSpillDirectory'
   // creates the directory.
   mutable std::mutex spillDirCreateMutex_;
@@ -1152,6 +1226,10 @@ class Task : public std::enable_shared_from_this<Task> {
   // Indicates whether the spill directory has been created.
   std::atomic<bool> spillDirectoryCreated_{false};
 
+  // Directory under 'spill_remote_directory' to move the finished spill files
+  // of this task to. Set when created. Guarded by 'spillDirCreateMutex_'.
+  std::string remoteSpillDirectory_;
+
   // Stores unconsumed preloading splits to ensure they are closed promptly.
   folly::F14FastSet<std::shared_ptr<connector::ConnectorSplit>>
       preloadingSplits_;
@@ -116,6 +116,11 @@ struct SplitGroupState {
   /// e.g. Limit.
   uint32_t numFinishedOutputDrivers{0};
 
+  /// Sum of the peak memory of the operators of the closed drivers. Used to
+  /// estimate the memory of a split group, see
+  /// QueryConfig::kSplitGroupMemoryBudget.
+  uint64_t peakMemoryBytes{0};
+
   // True if the state contains structures used for connecting ungrouped
   // execution pipeline with grouped excution pipeline. In that case we don't
   // want to clean up some of these structures.
@@ -20,6 +20,89 @@
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+
+namespace {
+bool supportsThresholdFilter(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+std::unique_ptr<common::Filter>
+makeBigintThresholdFilter(const BaseVector& threshold, bool ascending) {
+  const int64_t value = threshold.as<SimpleVector<T>>()->valueAt(0);
+  return std::make_unique<common::BigintRange>(
+      ascending ? std::numeric_limits<int64_t>::min() : value,
+      ascending ? value : std::numeric_limits<int64_t>::max(),
+      false);
+}
+
+// Returns a filter that passes the values that sort before or equal to the
+// single value in 'threshold' in 'sortOrder'. Returns nullptr if all values
+// pass.
+std::unique_ptr<common::Filter> makeThresholdFilter(
+    const BaseVector& threshold,
+    const core::SortOrder& sortOrder) {
+  const bool ascending = sortOrder.isAscending();
+  const bool nullsFirst = sortOrder.isNullsFirst();
+  if (threshold.isNullAt(0)) {
+    // Only nulls sort before or equal to a null in first place.
+    if (nullsFirst) {
+      return std::make_unique<common::IsNull>();
+    }
+    return nullptr;
+  }
+
+  std::unique_ptr<common::Filter> filter;
+  switch (threshold.typeKind()) {
+    case TypeKind::TINYINT:
+      filter = makeBigintThresholdFilter<int8_t>(threshold, ascending);
+      break;
+    case TypeKind::SMALLINT:
+      filter = makeBigintThresholdFilter<int16_t>(threshold, ascending);
+      break;
+    case TypeKind::INTEGER:
+      filter = makeBigintThresholdFilter<int32_t>(threshold, ascending);
+      break;
+    case TypeKind::BIGINT:
+      filter = makeBigintThresholdFilter<int64_t>(threshold, ascending);
+      break;
+    case TypeKind::TIMESTAMP: {
+      const auto value = threshold.as<SimpleVector<Timestamp>>()->valueAt(0);
+      filter = std::make_unique<common::TimestampRange>(
+          ascending ? Timestamp::min() : value,
+          ascending ? value : Timestamp::max(),
+          false);
+      break;
+    }
+    case TypeKind::VARCHAR: {
+      const std::string value =
+          threshold.as<SimpleVector<StringView>>()->valueAt(0);
+      filter = std::make_unique<common::BytesRange>(
+          value, ascending, false, value, !ascending, false, false);
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported type for TopN threshold filter: {}",
+          threshold.type()->toString());
+  }
+  if (nullsFirst) {
+    return filter->clone(true);
+  }
+  return filter;
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -31,6 +114,7 @@ TopN::TopN(
           topNNode->id(),
           "TopN"),
       count_(topNNode->count()),
+      firstKeyOrder_(topNNode->sortingOrders()[0]),
       data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
       comparator_(
           outputType_,
@@ -104,6 +188,36 @@ void TopN::addInput(RowVectorPtr input) {
       }
     }
   }
+
+  maybeAddThresholdFilter();
+}
+
+void TopN::maybeAddThresholdFilter() {
+  const auto channel = sortingKeyColumns_[0];
+  if (!canAddThresholdFilter_.has_value()) {
+    // Dropping rows below an operator like Limit, RowNumber or a right join
+    // probe would change the rows that reach this operator.
+    const auto* driver = operatorCtx_->driverCtx()->driver;
+    canAddThresholdFilter_ =
+        supportsThresholdFilter(*outputType_->childAt(channel)) &&
+        driver->mayPushdownRowFilters(this) &&
+        !driver->canPushdownFilters(this, {channel}).empty();
+  }
+  if (!canAddThresholdFilter_.value() || topRows_.size() < count_) {
+    return;
+  }
+
+  char* topRow = topRows_.top();
+  auto threshold = BaseVector::create(outputType_->childAt(channel), 1, pool());
+  data_->extractColumn(&topRow, 1, channel, threshold);
+  if (threshold_ != nullptr &&
+      threshold_->equalValueAt(threshold.get(), 0, 0)) {
+    return;
+  }
+  threshold_ = std::move(threshold);
+  if (auto filter = makeThresholdFilter(*threshold_, firstKeyOrder_)) {
+    dynamicFilters_.insert_or_assign(channel, std::move(filter));
+  }
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -44,7 +44,13 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Adds a dynamic filter on the first sorting key that passes only the rows
+  // that can still enter 'topRows_'. Produced when 'topRows_' is full and its
+  // top row changed the value of the first key since the last filter.
+  void maybeAddThresholdFilter();
+
   const int32_t count_;
+  const core::SortOrder firstKeyOrder_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
@@ -68,5 +74,14 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Set on the first call to maybeAddThresholdFilter(). True if the type of
+  // the first sorting key has a range filter, an upstream operator accepts
+  // filters on it and all operators in between are row independent.
+  std::optional<bool> canAddThresholdFilter_;
+
+  // Value of the first sorting key in the top row of 'topRows_' when the last
+  // threshold filter was added.
+  VectorPtr threshold_;
 };
 } // namespace facebook::velox::exec
@@ -147,9 +147,9 @@ TopNRowNumber::TopNRowNumber(
   if (numKeys > 0) {
     Accumulator accumulator{
         true,
-        sizeof(TopRows),
+        partitionSize(),
         false,
-        1,
+        alignof(TopRows),
         nullptr,
         [](auto, auto) { VELOX_UNREACHABLE(); },
         [](auto) {}};
@@ -167,7 +167,7 @@ TopNRowNumber::TopNRowNumber(
     lookup_ = std::make_unique<HashLookup>(table_->hashers());
   } else {
     allocator_ = std::make_unique<HashStringAllocator>(pool());
-    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+    singlePartition_ = std::make_unique<TopRows>();
   }
 
   if (generateRowNumber_) {
@@ -241,19 +241,54 @@ bool TopNRowNumber::abandonPartialEarly() const {
 
 void TopNRowNumber::initializeNewPartitions() {
   for (auto index : lookup_->newGroups) {
-    new (lookup_->hits[index] + partitionOffset_)
-        TopRows(table_->stringAllocator(), comparator_);
+    initializePartition(
+        lookup_->hits[index] + partitionOffset_, limit_ <= kMaxInlineLimit);
   }
 }
 
-void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
-  auto& topRows = partition.rows;
+void TopNRowNumber::initializePartition(char* memory, bool inlineRows) {
+  auto* partition = new (memory) TopRows();
+  if (inlineRows) {
+    partition->rows = reinterpret_cast<char**>(memory + sizeof(TopRows));
+    partition->capacity = limit_;
+  }
+}
+
+void TopNRowNumber::pushRow(TopRows& partition, char* row) {
+  if (partition.size == partition.capacity) {
+    // Only heaps that are not inline grow.
+    const auto capacity =
+        std::min(limit_, std::max(kMaxInlineLimit, partition.capacity * 2));
+    auto* header = heapAllocator()->allocate(capacity * sizeof(char*));
+    auto* rows = reinterpret_cast<char**>(header->begin());
+    if (partition.rows != nullptr) {
+      std::copy(partition.rows, partition.rows + partition.size, rows);
+      heapAllocator()->free(HashStringAllocator::headerOf(partition.rows));
+    }
+    partition.rows = rows;
+    partition.capacity = capacity;
+  }
+  partition.rows[partition.size++] = row;
+  std::push_heap(
+      partition.rows,
+      partition.rows + partition.size,
+      [&](const char* lhs, const char* rhs) { return comparator_(lhs, rhs); });
+}
+
+char* TopNRowNumber::popRow(TopRows& partition) {
+  std::pop_heap(
+      partition.rows,
+      partition.rows + partition.size,
+      [&](const char* lhs, const char* rhs) { return comparator_(lhs, rhs); });
+  return partition.rows[--partition.size];
+}
 
+void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
   char* newRow = nullptr;
-  if (topRows.size() < limit_) {
+  if (partition.size < limit_) {
     newRow = data_->newRow();
   } else {
-    char* topRow = topRows.top();
+    char* topRow = partition.rows[0];
 
     if (!comparator_(decodedVectors_, index, topRow)) {
       // Drop this input row.
@@ -261,7 +296,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     }
 
     // Replace existing row.
-    topRows.pop();
+    popRow(partition);
 
     // Reuse the topRow's memory.
     newRow = data_->initializeRow(topRow, true /* reuse */);
@@ -271,7 +306,7 @@ void TopNRowNumber::processInputRow(vector_size_t index, TopRows& partition) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
 
-  topRows.push(newRow);
+  pushRow(partition, newRow);
 }
 
 void TopNRowNumber::noMoreInput() {
@@ -290,7 +325,7 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finishSpill(spillPartitionSet);
     VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
     merge_ = spillPartitionSet.begin()->second->createOrderedReader(
-        pool(), &spillStats_);
+        pool(), &spillStats_, spillConfig_->ioExecutor());
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -364,14 +399,13 @@ void TopNRowNumber::appendPartitionRows(
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
   // Append 'size' partition rows in reverse order starting from 'start' row.
-  auto rowNumber = partition.rows.size() - start;
+  auto rowNumber = partition.size - start;
   for (auto i = 0; i < size; ++i) {
     const auto index = outputOffset + size - i - 1;
     if (rowNumbers) {
       rowNumbers->set(index, rowNumber--);
     }
-    outputRows_[index] = partition.rows.top();
-    partition.rows.pop();
+    outputRows_[index] = popRow(partition);
   }
 }
 
@@ -431,7 +465,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   vector_size_t offset = 0;
   if (remainingRowsInPartition_ > 0) {
     auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
+    auto start = partition.size - remainingRowsInPartition_;
     auto numRows =
         std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
     appendPartitionRows(partition, start, numRows, offset, rowNumbers);
@@ -445,7 +479,7 @@ RowVectorPtr TopNRowNumber::getOutputFromMemory() {
       break;
     }
 
-    auto numRows = partition->rows.size();
+    auto numRows = partition->size;
     if (offset + numRows > outputBatchSize_) {
       remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
 
@@ -619,21 +653,6 @@ bool TopNRowNumber::isFinished() {
 
 void TopNRowNumber::close() {
   Operator::close();
-
-  if (table_) {
-    partitionIt_.reset();
-    partitions_.resize(1000);
-    while (auto numPartitions = table_->listAllRows(
-               &partitionIt_,
-               partitions_.size(),
-               RowContainer::kUnlimited,
-               partitions_.data())) {
-      for (auto i = 0; i < numPartitions; ++i) {
-        std::destroy_at(
-            reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
-      }
-    }
-  }
 }
 
 void TopNRowNumber::reclaim(
@@ -69,22 +69,42 @@ class TopNRowNumber : public Operator {
       override;
 
  private:
-  // A priority queue to keep track of top 'limit' rows for a given partition.
+  // Maximum limit for which the top rows of a partition are stored inline in
+  // the partition row of 'table_'.
+  static constexpr int32_t kMaxInlineLimit = 16;
+
+  // A binary heap to keep track of top 'limit' rows for a given partition. The
+  // row that sorts last according to 'comparator_' is on top. For limits up to
+  // kMaxInlineLimit and with partition keys, the heap is stored right after
+  // this struct in the partition row of 'table_', so that adding a partition
+  // does not allocate. Otherwise, the heap is allocated from a
+  // HashStringAllocator and grows as needed.
   struct TopRows {
-    struct Compare {
-      RowComparator& comparator;
+    char** rows{nullptr};
+    int32_t size{0};
+    int32_t capacity{0};
+  };
 
-      bool operator()(const char* lhs, const char* rhs) {
-        return comparator(lhs, rhs);
-      }
-    };
+  // Returns the number of bytes for a partition in 'table_'.
+  int32_t partitionSize() const {
+    return sizeof(TopRows) +
+        (limit_ <= kMaxInlineLimit ? limit_ * sizeof(char*) : 0);
+  }
 
-    std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
-        rows;
+  // Initializes a TopRows at 'memory'. Uses the memory after it for the heap
+  // if 'inlineRows' is true.
+  void initializePartition(char* memory, bool inlineRows);
 
-    TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
-  };
+  // Adds 'row' to the heap of 'partition'.
+  void pushRow(TopRows& partition, char* row);
+
+  // Removes the top row from the heap of 'partition' and returns it.
+  char* popRow(TopRows& partition);
+
+  // Returns the allocator for heaps that are not stored inline.
+  HashStringAllocator* heapAllocator() const {
+    return table_ != nullptr ? table_->stringAllocator() : allocator_.get();
+  }
 
   void initializeNewPartitions();
 
@@ -29,7 +29,8 @@ Unnest::Unnest(
           operatorId,
           unnestNode->id(),
           "Unnest"),
-      withOrdinality_(unnestNode->withOrdinality()) {
+      withOrdinality_(unnestNode->withOrdinality()),
+      splitOutput_(driverCtx->queryConfig().unnestSplitOutput()) {
   const auto& inputType = unnestNode->sources()[0]->outputType();
   const auto& unnestVariables = unnestNode->unnestVariables();
   for (const auto& variable : unnestVariables) {
@@ -114,12 +115,20 @@ RowVectorPtr Unnest::getOutput() {
   const auto maxOutputSize = outputBatchRows();
 
   // Limit the number of input rows to keep output batch size within
-  // 'maxOutputSize' if possible. Process each input row fully. Do not break
-  // single row's output into multiple batches.
+  // 'maxOutputSize' if possible. Unless 'splitOutput_' is set, process each
+  // input row fully and do not break single row's output into multiple
+  // batches.
   vector_size_t numInput = 0;
   vector_size_t numElements = 0;
+  vector_size_t lastRowEnd = 0;
   for (auto row = nextInputRow_; row < size; ++row) {
-    numElements += rawMaxSizes_[row];
+    const auto rowStart = row == nextInputRow_ ? nextElement_ : 0;
+    auto rowEnd = rawMaxSizes_[row];
+    if (splitOutput_ && numElements + rowEnd - rowStart > maxOutputSize) {
+      rowEnd = rowStart + maxOutputSize - numElements;
+    }
+    numElements += rowEnd - rowStart;
+    lastRowEnd = rowEnd;
     ++numInput;
 
     if (numElements >= maxOutputSize) {
@@ -131,12 +140,22 @@ RowVectorPtr Unnest::getOutput() {
     // All arrays/maps are null or empty.
     input_ = nullptr;
     nextInputRow_ = 0;
+    nextElement_ = 0;
     return nullptr;
   }
 
-  auto output = generateOutput(nextInputRow_, numInput, numElements);
-
-  nextInputRow_ += numInput;
+  auto output = generateOutput(
+      {nextInputRow_, numInput, nextElement_, lastRowEnd}, numElements);
+
+  const auto lastRow = nextInputRow_ + numInput - 1;
+  if (lastRowEnd < rawMaxSizes_[lastRow]) {
+    // Continue the output of the last row in the next batch.
+    nextInputRow_ = lastRow;
+    nextElement_ = lastRowEnd;
+  } else {
+    nextInputRow_ = lastRow + 1;
+    nextElement_ = 0;
+  }
 
   if (nextInputRow_ >= size) {
     input_ = nullptr;
@@ -147,8 +166,7 @@ RowVectorPtr Unnest::getOutput() {
 }
 
 void Unnest::generateRepeatedColumns(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements,
     std::vector<VectorPtr>& outputs) {
   // Create "indices" buffer to repeat rows as many times as there are elements
@@ -156,11 +174,13 @@ void Unnest::generateRepeatedColumns(
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = start; row < start + size; ++row) {
-    for (auto i = 0; i < rawMaxSizes_[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
+    std::fill(
+        rawRepeatedIndices + index,
+        rawRepeatedIndices + index + end - begin,
+        row);
+    index += end - begin;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   for (const auto& projection : identityProjections_) {
@@ -174,8 +194,7 @@ void Unnest::generateRepeatedColumns(
 
 const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
     column_index_t channel,
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   BufferPtr elementIndices = allocateIndices(numElements, pool());
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
@@ -191,38 +210,36 @@ const Unnest::UnnestChannelEncoding Unnest::generateEncodingForChannel(
   // Make dictionary index for elements column since they may be out of order.
   vector_size_t index = 0;
   bool identityMapping = true;
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto begin, auto end) {
     if (!currentDecoded.isNullAt(row)) {
       const auto offset = currentOffsets[currentIndices[row]];
       const auto unnestSize = currentSizes[currentIndices[row]];
+      const auto elementsEnd = std::min(end, unnestSize);
 
-      if (index != offset || unnestSize < maxSize) {
+      if (index != offset + begin || unnestSize < end) {
         identityMapping = false;
       }
 
-      for (auto i = 0; i < unnestSize; i++) {
+      for (auto i = begin; i < elementsEnd; i++) {
         rawElementIndices[index++] = offset + i;
       }
 
-      for (auto i = unnestSize; i < maxSize; ++i) {
+      for (auto i = std::max(begin, elementsEnd); i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
-    } else if (maxSize > 0) {
+    } else if (end > begin) {
       identityMapping = false;
 
-      for (auto i = 0; i < maxSize; ++i) {
+      for (auto i = begin; i < end; ++i) {
         bits::setNull(rawNulls, index++, true);
       }
     }
-  }
+  });
   return {elementIndices, nulls, identityMapping};
 }
 
 VectorPtr Unnest::generateOrdinalityVector(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   auto ordinalityVector =
       BaseVector::create<FlatVector<int64_t>>(BIGINT(), numElements, pool());
@@ -230,27 +247,25 @@ VectorPtr Unnest::generateOrdinalityVector(
   // Set the ordinality at each result row to be the index of the element in
   // the original array (or map) plus one.
   auto* rawOrdinality = ordinalityVector->mutableRawValues();
-  for (auto row = start; row < start + size; ++row) {
-    const auto maxSize = rawMaxSizes_[row];
-    std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-    rawOrdinality += maxSize;
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto begin, auto end) {
+    std::iota(rawOrdinality, rawOrdinality + end - begin, begin + 1);
+    rawOrdinality += end - begin;
+  });
 
   return ordinalityVector;
 }
 
 RowVectorPtr Unnest::generateOutput(
-    vector_size_t start,
-    vector_size_t size,
+    const RowRange& range,
     vector_size_t numElements) {
   std::vector<VectorPtr> outputs(outputType_->size());
-  generateRepeatedColumns(start, size, numElements, outputs);
+  generateRepeatedColumns(range, numElements, outputs);
 
   // Create unnest columns.
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto unnestChannelEncoding =
-        generateEncodingForChannel(channel, start, size, numElements);
+        generateEncodingForChannel(channel, range, numElements);
 
     auto& currentDecoded = unnestDecoded_[channel];
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
@@ -272,7 +287,7 @@ RowVectorPtr Unnest::generateOutput(
 
   if (withOrdinality_) {
     // Ordinality column is always at the end.
-    outputs.back() = generateOrdinalityVector(start, size, numElements);
+    outputs.back() = generateOrdinalityVector(range, numElements);
   }
 
   return std::make_shared<RowVector>(
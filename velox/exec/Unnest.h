@@ -39,21 +39,42 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
-  // Generate output for 'size' input rows starting from 'start' input row.
+  // A range of input rows to generate output for. The output of the first and
+  // last rows may be partial if the output of a row is split across batches.
+  struct RowRange {
+    // First input row.
+    vector_size_t start;
+    // Number of input rows.
+    vector_size_t size;
+    // Output row of the first input row to start from.
+    vector_size_t firstRowStart;
+    // Output row of the last input row to end before.
+    vector_size_t lastRowEnd;
+
+    // Calls 'func(row, begin, end)' for each input row with the range of its
+    // output rows to generate. 'rawMaxSizes' has the number of output rows of
+    // each input row.
+    template <typename TFunc>
+    void forEachRow(const vector_size_t* rawMaxSizes, TFunc func) const {
+      for (auto row = start; row < start + size; ++row) {
+        const auto begin = row == start ? firstRowStart : 0;
+        const auto end =
+            row == start + size - 1 ? lastRowEnd : rawMaxSizes[row];
+        func(row, begin, end);
+      }
+    }
+  };
+
+  // Generate output for 'range' of input rows.
   //
-  // @param start First input row to include in the output.
-  // @param size Number of input rows to include in the output.
+  // @param range Input rows to include in the output.
   // @param outputSize Pre-computed number of output rows.
-  RowVectorPtr generateOutput(
-      vector_size_t start,
-      vector_size_t size,
-      vector_size_t outputSize);
+  RowVectorPtr generateOutput(const RowRange& range, vector_size_t outputSize);
 
   // Invoked by generateOutput function above to generate the repeated output
   // columns.
   void generateRepeatedColumns(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements,
       std::vector<VectorPtr>& outputs);
 
@@ -69,17 +90,17 @@ class Unnest : public Operator {
   // Array or Map.
   const UnnestChannelEncoding generateEncodingForChannel(
       column_index_t channel,
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   // Invoked by generateOutput for the ordinality column.
   VectorPtr generateOrdinalityVector(
-      vector_size_t start,
-      vector_size_t size,
+      const RowRange& range,
       vector_size_t numElements);
 
   const bool withOrdinality_;
+  // See QueryConfig::kUnnestSplitOutput.
+  const bool splitOutput_;
   std::vector<column_index_t> unnestChannels_;
 
   std::vector<DecodedVector> unnestDecoded_;
@@ -93,5 +114,7 @@ class Unnest : public Operator {
 
   // Next 'input_' row to process in getOutput().
   vector_size_t nextInputRow_{0};
+  // Output row of 'nextInputRow_' to continue from if its output was split.
+  vector_size_t nextElement_{0};
 };
 } // namespace facebook::velox::exec
@@ -21,6 +21,35 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+bool useParallelPartitions(
+    const core::WindowNode& windowNode,
+    const core::QueryConfig& queryConfig) {
+  return queryConfig.windowParallelPartitions() && !windowNode.inputsSorted();
+}
+
+// Returns true if the rows of sorted input can be output before the whole
+// partition arrives. This is the case when all the functions support
+// streaming and no frame has an offset, which would need the rows around the
+// current row.
+bool canStreamRows(const core::WindowNode& windowNode) {
+  if (!windowNode.inputsSorted()) {
+    return false;
+  }
+  for (const auto& function : windowNode.windowFunctions()) {
+    if (function.frame.startValue != nullptr ||
+        function.frame.endValue != nullptr) {
+      return false;
+    }
+    if (!getWindowFunctionMetadata(function.functionCall->name())
+             .supportsStreaming) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 Window::Window(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -31,10 +60,14 @@ Window::Window(
           operatorId,
           windowNode->id(),
           "Window",
-          windowNode->canSpill(driverCtx->queryConfig())
+          windowNode->canSpill(driverCtx->queryConfig()) &&
+                  !useParallelPartitions(
+                      *windowNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       numInputColumns_(windowNode->inputType()->size()),
+      parallelPartitions_(
+          useParallelPartitions(*windowNode, driverCtx->queryConfig())),
       windowNode_(windowNode),
       currentPartition_(nullptr),
       stringAllocator_(pool()) {
@@ -42,7 +75,11 @@ Window::Window(
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   if (windowNode->inputsSorted()) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        canStreamRows(*windowNode));
   } else {
     windowBuild_ = std::make_unique<SortWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_, &spillStats_);
@@ -240,6 +277,66 @@ void Window::createPeerAndFrameBuffers() {
 void Window::noMoreInput() {
   Operator::noMoreInput();
   windowBuild_->noMoreInput();
+  maybeSharePartitions();
+}
+
+void Window::maybeSharePartitions() {
+  if (!parallelPartitions_) {
+    return;
+  }
+  auto* driver = operatorCtx_->driver();
+  const auto numDrivers = operatorCtx_->task()->numDrivers(driver);
+  if (numDrivers == 1) {
+    parallelPartitions_ = false;
+    return;
+  }
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), driver, &future_, promises, peers)) {
+    VELOX_CHECK(future_.valid());
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not
+    // the last to finish) can continue from the barrier and claim
+    // partitions.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  std::vector<Window*> windows{this};
+  windows.reserve(numDrivers);
+  for (auto& peer : peers) {
+    auto* window = dynamic_cast<Window*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(window);
+    windows.push_back(window);
+  }
+  VELOX_CHECK_EQ(windows.size(), numDrivers);
+
+  std::vector<SortWindowBuild*> builds;
+  builds.reserve(numDrivers);
+  for (auto* window : windows) {
+    auto* build = dynamic_cast<SortWindowBuild*>(window->windowBuild_.get());
+    VELOX_CHECK_NOT_NULL(build);
+    builds.push_back(build);
+  }
+  SortWindowBuild::shareSortedPartitions(builds);
+  for (auto* window : windows) {
+    window->partitionsShared_ = true;
+  }
+}
+
+BlockingReason Window::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
 }
 
 void Window::callResetPartition() {
@@ -575,17 +672,23 @@ vector_size_t Window::callApplyLoop(
   VELOX_DCHECK_NOT_NULL(currentPartition_);
   while (numOutputRowsLeft > 0) {
     auto rowsForCurrentPartition =
-        currentPartition_->numRows() - partitionOffset_;
+        currentPartition_->numRowsForProcessing() - partitionOffset_;
     if (rowsForCurrentPartition <= numOutputRowsLeft) {
       // Current partition can fit completely in the output buffer.
       // So output all its rows.
-      callApplyForPartitionRows(
-          partitionOffset_,
-          partitionOffset_ + rowsForCurrentPartition,
-          resultIndex,
-          result);
+      if (rowsForCurrentPartition > 0) {
+        callApplyForPartitionRows(
+            partitionOffset_,
+            partitionOffset_ + rowsForCurrentPartition,
+            resultIndex,
+            result);
+      }
       resultIndex += rowsForCurrentPartition;
       numOutputRowsLeft -= rowsForCurrentPartition;
+      if (!currentPartition_->complete()) {
+        // The rest of the partial partition has not arrived yet.
+        break;
+      }
       callResetPartition();
       if (!currentPartition_) {
         // The WindowBuild doesn't have any more partitions to process right
@@ -606,11 +709,45 @@ vector_size_t Window::callApplyLoop(
     }
   }
 
+  if (currentPartition_ != nullptr && currentPartition_->partial()) {
+    // The output has copies of the processed rows.
+    currentPartition_->removeProcessedRows(partitionOffset_);
+  }
+
   // Return the number of processed rows.
   return numOutputRows - numOutputRowsLeft;
 }
 
+RowVectorPtr Window::getParallelOutput() {
+  if (!partitionsShared_ || noMorePartitions_) {
+    return nullptr;
+  }
+
+  if (!currentPartition_) {
+    callResetPartition();
+    if (!currentPartition_) {
+      // The peers have claimed all the remaining partitions.
+      noMorePartitions_ = true;
+      return nullptr;
+    }
+  }
+
+  auto result = BaseVector::create<RowVector>(
+      outputType_, numRowsPerOutput_, operatorCtx_->pool());
+  auto numResultRows = callApplyLoop(numRowsPerOutput_, result);
+  if (!currentPartition_) {
+    noMorePartitions_ = true;
+  }
+  return numResultRows < numRowsPerOutput_
+      ? std::dynamic_pointer_cast<RowVector>(result->slice(0, numResultRows))
+      : result;
+}
+
 RowVectorPtr Window::getOutput() {
+  if (parallelPartitions_) {
+    return getParallelOutput();
+  }
+
   if (numRows_ == 0) {
     return nullptr;
   }
@@ -628,6 +765,12 @@ RowVectorPtr Window::getOutput() {
     }
   }
 
+  if (!currentPartition_->complete() &&
+      currentPartition_->numRowsForProcessing() == partitionOffset_) {
+    // Waiting for more rows of a partial partition.
+    return nullptr;
+  }
+
   auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
   auto result = BaseVector::create<RowVector>(
       outputType_, numOutputRows, operatorCtx_->pool());
@@ -56,11 +56,12 @@ class Window : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
+    if (parallelPartitions_) {
+      return noMorePartitions_;
+    }
     return noMoreInput_ && numRows_ == numProcessedRows_;
   }
 
@@ -88,6 +89,15 @@ class Window : public Operator {
     const std::optional<FrameChannelArg> end;
   };
 
+  // Waits for the peer drivers to finish their input if running with parallel
+  // partitions. The last driver to finish merges the sorted rows of all
+  // drivers and shares the partitions with them.
+  void maybeSharePartitions();
+
+  // Produces the output when the partitions are shared with the peers. The
+  // number of rows this driver outputs depends on the partitions it claims.
+  RowVectorPtr getParallelOutput();
+
   // Creates WindowFunction and frame objects for this operator.
   void createWindowFunctions();
 
@@ -155,6 +165,19 @@ class Window : public Operator {
 
   const vector_size_t numInputColumns_;
 
+  // True if the peer drivers share the sorted rows and claim the partitions
+  // one at a time. Reset if there are no peers.
+  bool parallelPartitions_;
+
+  // True once the shared partitions are set up for this driver.
+  bool partitionsShared_{false};
+
+  // True once no partitions are left to claim.
+  bool noMorePartitions_{false};
+
+  // Set while waiting for the peers to finish their input.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
   // WindowBuild is used to store input rows and return WindowPartitions
   // for the processing.
   std::unique_ptr<WindowBuild> windowBuild_;
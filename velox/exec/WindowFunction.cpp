@@ -42,12 +42,32 @@ bool registerWindowFunction(
     const std::string& name,
     std::vector<FunctionSignaturePtr> signatures,
     WindowFunctionFactory factory) {
+  return registerWindowFunction(
+      name,
+      std::move(signatures),
+      WindowFunction::Metadata::defaultMetadata(),
+      std::move(factory));
+}
+
+bool registerWindowFunction(
+    const std::string& name,
+    std::vector<FunctionSignaturePtr> signatures,
+    WindowFunction::Metadata metadata,
+    WindowFunctionFactory factory) {
   auto sanitizedName = sanitizeName(name);
   windowFunctions()[sanitizedName] = {
-      std::move(signatures), std::move(factory)};
+      std::move(signatures), std::move(factory), metadata};
   return true;
 }
 
+WindowFunction::Metadata getWindowFunctionMetadata(const std::string& name) {
+  auto sanitizedName = sanitizeName(name);
+  if (auto func = getWindowFunctionEntry(sanitizedName)) {
+    return func.value()->metadata;
+  }
+  return WindowFunction::Metadata::defaultMetadata();
+}
+
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name) {
   auto sanitizedName = sanitizeName(name);
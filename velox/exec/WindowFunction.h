@@ -33,6 +33,20 @@ struct WindowFunctionArg {
 
 class WindowFunction {
  public:
+  /// Properties of a window function the Window operator uses to choose how
+  /// to feed rows to it.
+  struct Metadata {
+    /// True if the result for a row depends only on the rows of the partition
+    /// up to and including the peer group of the row, and not on the frame or
+    /// the size of the partition, e.g. row_number() and rank(). The Window can
+    /// then output rows of a partition before receiving the whole partition.
+    bool supportsStreaming{false};
+
+    static Metadata defaultMetadata() {
+      return {};
+    }
+  };
+
   explicit WindowFunction(
       TypePtr resultType,
       memory::MemoryPool* pool,
@@ -151,14 +165,26 @@ bool registerWindowFunction(
     std::vector<FunctionSignaturePtr> signatures,
     WindowFunctionFactory factory);
 
+/// Same as above, with 'metadata' describing the function.
+bool registerWindowFunction(
+    const std::string& name,
+    std::vector<FunctionSignaturePtr> signatures,
+    WindowFunction::Metadata metadata,
+    WindowFunctionFactory factory);
+
 /// Returns signatures of the window function with the specified name.
 /// Returns empty std::optional if function with that name is not found.
 std::optional<std::vector<FunctionSignaturePtr>> getWindowFunctionSignatures(
     const std::string& name);
 
+/// Returns the metadata of the window function with the specified name.
+/// Returns the default metadata if the function is not found.
+WindowFunction::Metadata getWindowFunctionMetadata(const std::string& name);
+
 struct WindowFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   WindowFunctionFactory factory;
+  WindowFunction::Metadata metadata;
 };
 
 using WindowFunctionMap = std::unordered_map<std::string, WindowFunctionEntry>;
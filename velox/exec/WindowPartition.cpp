@@ -31,11 +31,54 @@ WindowPartition::WindowPartition(
   }
 }
 
+WindowPartition::WindowPartition(
+    RowContainer* data,
+    const std::vector<column_index_t>& inputMapping,
+    const std::vector<std::pair<column_index_t, core::SortOrder>>& sortKeyInfo)
+    : WindowPartition(data, folly::Range<char**>(), inputMapping, sortKeyInfo) {
+  partial_ = true;
+  complete_ = false;
+}
+
+void WindowPartition::addRows(const std::vector<char*>& rows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK(!complete_);
+  if (rows.empty()) {
+    return;
+  }
+  vector_size_t rowNumber = numRows();
+  for (auto* row : rows) {
+    // The rows of the last peer group are never removed, so 'rows_' has the
+    // previous row.
+    if (!rows_.empty() && compareRowsWithSortKeys(rows_.back(), row)) {
+      lastPeerGroupStart_ = rowNumber;
+    }
+    rows_.push_back(row);
+    ++rowNumber;
+  }
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
+void WindowPartition::removeProcessedRows(vector_size_t numRows) {
+  VELOX_CHECK(partial_);
+  VELOX_CHECK_LE(numRows, numRowsForProcessing());
+  const auto numRemoved = numRows - startRow_;
+  if (numRemoved <= 0) {
+    return;
+  }
+  data_->eraseRows(folly::Range<char**>(rows_.data(), numRemoved));
+  rows_.erase(rows_.begin(), rows_.begin() + numRemoved);
+  startRow_ = numRows;
+  partition_ = folly::Range(rows_.data(), rows_.size());
+}
+
 void WindowPartition::extractColumn(
     int32_t columnIndex,
     folly::Range<const vector_size_t*> rowNumbers,
     vector_size_t resultOffset,
     const VectorPtr& result) const {
+  VELOX_CHECK_EQ(
+      startRow_, 0, "Cannot access rows by number in a partial partition");
   RowContainer::extractColumn(
       partition_.data(),
       rowNumbers,
@@ -51,7 +94,7 @@ void WindowPartition::extractColumn(
     vector_size_t resultOffset,
     const VectorPtr& result) const {
   RowContainer::extractColumn(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       resultOffset,
@@ -64,7 +107,7 @@ void WindowPartition::extractNulls(
     vector_size_t numRows,
     const BufferPtr& nullsBuffer) const {
   RowContainer::extractNulls(
-      partition_.data() + partitionOffset,
+      partition_.data() + partitionOffset - startRow_,
       numRows,
       columns_[columnIndex],
       nullsBuffer);
@@ -162,7 +205,7 @@ std::pair<vector_size_t, vector_size_t> WindowPartition::computePeerBuffers(
       peerStart = i;
       peerEnd = i;
       while (peerEnd <= lastPartitionRow) {
-        if (peerCompare(partition_[peerStart], partition_[peerEnd])) {
+        if (peerCompare(rowAt(peerStart), rowAt(peerEnd))) {
           break;
         }
         peerEnd++;
@@ -309,6 +352,8 @@ void WindowPartition::computeKRangeFrameBounds(
     vector_size_t numRows,
     const vector_size_t* rawPeerBuffer,
     vector_size_t* rawFrameBounds) const {
+  VELOX_CHECK(
+      !partial_, "Range frames are not supported on partial partitions");
   CompareFlags flags;
   flags.ascending = sortKeyInfo_[0].second.isAscending();
   flags.nullsFirst = sortKeyInfo_[0].second.isNullsFirst();
@@ -42,11 +42,56 @@ class WindowPartition {
       const std::vector<std::pair<column_index_t, core::SortOrder>>&
           sortKeyInfo);
 
-  /// Returns the number of rows in the current WindowPartition.
+  /// Creates a partial partition that receives its rows with addRows() while
+  /// the earlier rows are processed. The rows processed by the Window are
+  /// removed with removeProcessedRows(). Row numbers are the positions of the
+  /// rows in the whole partition, so they do not change when rows are
+  /// removed. Partial partitions support only access to rows that are not
+  /// yet processed, which suffices for functions that support streaming.
+  WindowPartition(
+      RowContainer* data,
+      const std::vector<column_index_t>& inputMapping,
+      const std::vector<std::pair<column_index_t, core::SortOrder>>&
+          sortKeyInfo);
+
+  /// Returns the number of rows in the current WindowPartition. For a partial
+  /// partition, this includes the removed rows.
   vector_size_t numRows() const {
-    return partition_.size();
+    return startRow_ + partition_.size();
   }
 
+  /// Returns true if the partition was created with the partial constructor.
+  bool partial() const {
+    return partial_;
+  }
+
+  /// Returns true if all rows of the partition have been added. Always true
+  /// for partitions that are not partial.
+  bool complete() const {
+    return complete_;
+  }
+
+  /// Appends 'rows' to a partial partition. The rows must follow the rows
+  /// added so far in the order of the sort keys.
+  void addRows(const std::vector<char*>& rows);
+
+  /// Marks a partial partition as having all its rows.
+  void setComplete() {
+    VELOX_CHECK(partial_);
+    complete_ = true;
+  }
+
+  /// Returns the number of rows that can be processed. These are all the rows
+  /// of a complete partition. For an incomplete partition, these are the rows
+  /// before the last peer group, which may still get more rows.
+  vector_size_t numRowsForProcessing() const {
+    return complete_ ? numRows() : lastPeerGroupStart_;
+  }
+
+  /// Erases the rows of a partial partition before row number 'numRows' from
+  /// the RowContainer.
+  void removeProcessedRows(vector_size_t numRows);
+
   /// Copies the values at 'columnIndex' into 'result' (starting at
   /// 'resultOffset') for the rows at positions in the 'rowNumbers'
   /// array from the partition input data.
@@ -162,6 +207,11 @@ class WindowPartition {
       const vector_size_t* rawPeerBounds,
       vector_size_t* rawFrameBounds) const;
 
+  // Returns the row at 'rowNumber' in the partition.
+  char* rowAt(vector_size_t rowNumber) const {
+    return partition_[rowNumber - startRow_];
+  }
+
   // The RowContainer associated with the partition.
   // It is owned by the WindowBuild that creates the partition.
   RowContainer* data_;
@@ -172,6 +222,21 @@ class WindowPartition {
   // of WindowPartition.
   folly::Range<char**> partition_;
 
+  // Rows of a partial partition. 'partition_' points to these.
+  std::vector<char*> rows_;
+
+  // Row number of the first row in 'partition_'. Non-zero after rows of a
+  // partial partition are removed.
+  vector_size_t startRow_{0};
+
+  bool partial_{false};
+
+  bool complete_{true};
+
+  // Row number of the first row of the last peer group of a partial
+  // partition.
+  vector_size_t lastPeerGroupStart_{0};
+
   // Mapping from window input column -> index in data_. This is required
   // because the WindowBuild reorders data_ to place partition and sort keys
   // before other columns in data_. But the Window Operator and Function code
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// The executor and the worker index of the current thread.
+thread_local const WorkStealingExecutor* currentExecutor{nullptr};
+thread_local int32_t currentWorkerIndex{-1};
+} // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(int32_t numThreads) {
+  VELOX_CHECK_GT(numThreads, 0);
+  workers_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i]() { run(i); });
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> l(waitMutex_);
+    stopped_ = true;
+  }
+  waitCondition_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+int32_t WorkStealingExecutor::currentWorker() const {
+  return currentExecutor == this ? currentWorkerIndex : -1;
+}
+
+void WorkStealingExecutor::add(folly::Func func) {
+  auto index = currentWorker();
+  if (index < 0) {
+    index = nextWorker_++ % workers_.size();
+  }
+  auto& worker = *workers_[index];
+  {
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.queue.push_back(std::move(func));
+  }
+  ++numPending_;
+  if (numWaiting_ > 0) {
+    // Taking the mutex makes sure that a worker that found no pending tasks is
+    // waiting on the condition before it is notified.
+    std::lock_guard<std::mutex> l(waitMutex_);
+    waitCondition_.notify_one();
+  }
+}
+
+folly::Func WorkStealingExecutor::next(int32_t index) {
+  const int32_t numWorkers = workers_.size();
+  for (auto i = 0; i < numWorkers; ++i) {
+    auto& worker = *workers_[(index + i) % numWorkers];
+    std::lock_guard<std::mutex> l(worker.mutex);
+    if (worker.queue.empty()) {
+      continue;
+    }
+    folly::Func func;
+    if (i == 0) {
+      func = std::move(worker.queue.front());
+      worker.queue.pop_front();
+    } else {
+      // Steal the most recently added task. The owner reaches it last.
+      func = std::move(worker.queue.back());
+      worker.queue.pop_back();
+    }
+    --numPending_;
+    return func;
+  }
+  return nullptr;
+}
+
+bool WorkStealingExecutor::wait() {
+  std::unique_lock<std::mutex> l(waitMutex_);
+  ++numWaiting_;
+  waitCondition_.wait(l, [&]() { return numPending_ > 0 || stopped_; });
+  --numWaiting_;
+  return numPending_ > 0 || !stopped_;
+}
+
+void WorkStealingExecutor::run(int32_t index) {
+  currentExecutor = this;
+  currentWorkerIndex = index;
+  for (;;) {
+    auto func = next(index);
+    if (!func) {
+      if (!wait()) {
+        return;
+      }
+      continue;
+    }
+    try {
+      func();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "WorkStealingExecutor task threw unhandled exception: "
+                 << e.what();
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
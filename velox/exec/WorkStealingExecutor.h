@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// Executor with a run queue per worker thread. Drivers are enqueued with
+/// Executor::add() from Driver::enqueue(). A driver that yields or is
+/// continued from a worker thread of this executor is added to the queue of
+/// that thread, so that it resumes on the thread, and thus the core, whose
+/// caches hold its state. Tasks added from other threads are distributed round
+/// robin. A worker runs the tasks of its own queue in FIFO order and steals
+/// from the other queues when its own is empty. The queues have separate locks,
+/// so workers do not contend on a shared queue as with CPUThreadPoolExecutor.
+///
+/// Used for the drivers of a query by passing it as the executor of the
+/// QueryCtx.
+class WorkStealingExecutor : public folly::Executor {
+ public:
+  explicit WorkStealingExecutor(int32_t numThreads);
+
+  /// Runs the remaining tasks and joins the worker threads.
+  ~WorkStealingExecutor() override;
+
+  void add(folly::Func func) override;
+
+  int32_t numThreads() const {
+    return workers_.size();
+  }
+
+  /// Returns the index of the worker thread of 'this' that runs the caller or
+  /// -1 if the caller is not a worker thread of 'this'.
+  int32_t currentWorker() const;
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<folly::Func> queue;
+    std::thread thread;
+  };
+
+  void run(int32_t index);
+
+  // Returns the next task from the queue of worker 'index' or from the queue
+  // of another worker. Returns an empty function if all queues are empty.
+  folly::Func next(int32_t index);
+
+  // Waits until a task is added or 'this' is stopped. Returns false if 'this'
+  // is stopped and all tasks have run.
+  bool wait();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Worker to add the next task from a non-worker thread to.
+  std::atomic<uint32_t> nextWorker_{0};
+
+  // Number of tasks in all queues.
+  std::atomic<int64_t> numPending_{0};
+
+  // Number of workers waiting for a task.
+  std::atomic<int32_t> numWaiting_{0};
+
+  std::mutex waitMutex_;
+  std::condition_variable waitCondition_;
+  bool stopped_{false};
+};
+
+} // namespace facebook::velox::exec
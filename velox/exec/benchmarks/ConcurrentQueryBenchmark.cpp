@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <random>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/SharedArbitrator.h"
+#include "velox/connectors/tpch/TpchConnector.h"
+#include "velox/connectors/tpch/TpchConnectorSplit.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/ArbitratorTestUtil.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+
+/// Runs a mix of TPC-H like queries from many threads at the same time with a
+/// shared memory arbitrator of limited capacity. Reports throughput, latency
+/// percentiles, spilled bytes and arbitration counts. Unlike the single query
+/// benchmarks, this measures how queries slow down each other when they
+/// compete for memory and for the threads of the driver executor.
+///
+/// Example:
+///   velox_concurrent_query_benchmark --num_query_threads=32
+///       --query_mix=agg:2,join:1,orderby:1 --arbitrator_capacity=1073741824
+
+DEFINE_int32(
+    num_query_threads,
+    16,
+    "Number of threads that each run one query after another.");
+
+DEFINE_int32(
+    num_executor_threads,
+    0,
+    "Number of threads of the driver executor shared by all queries. 0 means "
+    "the number of cores.");
+
+DEFINE_int32(num_drivers, 4, "Number of drivers per pipeline of a query.");
+
+DEFINE_int32(duration_sec, 30, "For how long to run queries in seconds.");
+
+DEFINE_string(
+    query_mix,
+    "agg:1,join:1,orderby:1",
+    "Comma separated list of <query>:<weight>. Queries are 'agg', 'join' and "
+    "'orderby'. Each query thread picks the next query at random in "
+    "proportion to the weights.");
+
+DEFINE_double(scale_factor, 0.1, "TPC-H scale factor of the scanned tables.");
+
+DEFINE_int32(num_splits, 8, "Number of splits per scanned table.");
+
+DEFINE_int64(
+    arbitrator_capacity,
+    1L << 30,
+    "Capacity in bytes of the memory arbitrator shared by all queries.");
+
+DEFINE_int64(
+    query_capacity,
+    0,
+    "Memory capacity in bytes of each query. 0 means the arbitrator capacity.");
+
+DEFINE_bool(spill_enabled, true, "Enables spilling of the queries.");
+
+DEFINE_int32(seed, 1, "Seed for picking the queries.");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+const std::string kTpchConnectorId = "test-tpch";
+
+// Outcome of one query.
+struct QueryRun {
+  int32_t query;
+  uint64_t wallMicros;
+  uint64_t spilledBytes;
+  bool success;
+};
+
+class ConcurrentQueryBenchmark {
+ public:
+  ConcurrentQueryBenchmark()
+      : executor_(std::make_shared<folly::CPUThreadPoolExecutor>(
+            FLAGS_num_executor_threads > 0
+                ? FLAGS_num_executor_threads
+                : std::thread::hardware_concurrency())) {
+    parseQueryMix();
+  }
+
+  void run() {
+    auto* arbitrator = memory::memoryManager()->arbitrator();
+    const auto statsBefore = arbitrator->stats();
+    const auto spillDirectory = TempDirectoryPath::create();
+
+    std::atomic_bool stop{false};
+    std::vector<std::thread> threads;
+    std::vector<std::vector<QueryRun>> runs(FLAGS_num_query_threads);
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = 0; i < FLAGS_num_query_threads; ++i) {
+      threads.emplace_back([&, i]() {
+        std::mt19937 rng(FLAGS_seed + i);
+        std::uniform_int_distribution<int32_t> dist(0, totalWeight_ - 1);
+        int32_t sequence = 0;
+        while (!stop) {
+          const auto query = pickQuery(dist(rng));
+          runs[i].push_back(runQuery(
+              query,
+              fmt::format("{}/{}-{}", spillDirectory->getPath(), i, sequence)));
+          ++sequence;
+        }
+      });
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(FLAGS_duration_sec));
+    stop = true;
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    const auto elapsedMicros =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+    waitForAllTasksToBeDeleted();
+
+    std::vector<QueryRun> allRuns;
+    for (auto& threadRuns : runs) {
+      allRuns.insert(allRuns.end(), threadRuns.begin(), threadRuns.end());
+    }
+    printResults(allRuns, elapsedMicros, arbitrator->stats() - statsBefore);
+  }
+
+ private:
+  enum Query { kAgg, kJoin, kOrderBy };
+
+  static constexpr const char* kQueryNames[] = {"agg", "join", "orderby"};
+
+  void parseQueryMix() {
+    std::vector<folly::StringPiece> entries;
+    folly::split(',', FLAGS_query_mix, entries);
+    for (auto entry : entries) {
+      folly::StringPiece name;
+      int32_t weight;
+      VELOX_USER_CHECK(
+          folly::split(':', entry, name, weight),
+          "Bad --query_mix entry: {}",
+          entry.str());
+      VELOX_USER_CHECK_GT(weight, 0, "Bad --query_mix entry: {}", entry.str());
+      const auto it = std::find(
+          std::begin(kQueryNames), std::end(kQueryNames), name.str());
+      VELOX_USER_CHECK(
+          it != std::end(kQueryNames),
+          "Unknown query in --query_mix: {}",
+          name.str());
+      totalWeight_ += weight;
+      mix_.emplace_back(it - std::begin(kQueryNames), totalWeight_);
+    }
+    VELOX_USER_CHECK(!mix_.empty(), "--query_mix is empty");
+  }
+
+  // Returns the query whose range of cumulative weights contains 'value'.
+  int32_t pickQuery(int32_t value) const {
+    for (const auto& [query, cumulativeWeight] : mix_) {
+      if (value < cumulativeWeight) {
+        return query;
+      }
+    }
+    VELOX_UNREACHABLE();
+  }
+
+  // Returns the plan of 'query' and the ids of its scan nodes.
+  core::PlanNodePtr makePlan(
+      int32_t query,
+      std::vector<core::PlanNodeId>& scanIds) const {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId scanId;
+    core::PlanNodePtr plan;
+    switch (query) {
+      case kAgg:
+        // Q18 like aggregation with one group per order.
+        plan = PlanBuilder(planNodeIdGenerator)
+                   .tpchTableScan(
+                       tpch::Table::TBL_LINEITEM,
+                       {"l_orderkey", "l_quantity"},
+                       FLAGS_scale_factor)
+                   .capturePlanNodeId(scanId)
+                   .partialAggregation(
+                       {"l_orderkey"}, {"sum(l_quantity) AS qty"})
+                   .localPartition({"l_orderkey"})
+                   .finalAggregation()
+                   .filter("qty > 300.0")
+                   .planNode();
+        break;
+      case kJoin: {
+        // Q3 like join of lineitem with orders and aggregation by customer.
+        core::PlanNodeId ordersScanId;
+        auto orders = PlanBuilder(planNodeIdGenerator)
+                          .tpchTableScan(
+                              tpch::Table::TBL_ORDERS,
+                              {"o_orderkey", "o_custkey"},
+                              FLAGS_scale_factor)
+                          .capturePlanNodeId(ordersScanId)
+                          .planNode();
+        scanIds.push_back(ordersScanId);
+        plan = PlanBuilder(planNodeIdGenerator)
+                   .tpchTableScan(
+                       tpch::Table::TBL_LINEITEM,
+                       {"l_orderkey", "l_extendedprice"},
+                       FLAGS_scale_factor)
+                   .capturePlanNodeId(scanId)
+                   .hashJoin(
+                       {"l_orderkey"},
+                       {"o_orderkey"},
+                       orders,
+                       "",
+                       {"o_custkey", "l_extendedprice"})
+                   .partialAggregation(
+                       {"o_custkey"}, {"sum(l_extendedprice) AS revenue"})
+                   .localPartition({"o_custkey"})
+                   .finalAggregation()
+                   .topN({"revenue DESC"}, 10, false)
+                   .planNode();
+        break;
+      }
+      case kOrderBy:
+        plan = PlanBuilder(planNodeIdGenerator)
+                   .tpchTableScan(
+                       tpch::Table::TBL_ORDERS,
+                       {"o_orderkey", "o_totalprice", "o_orderdate"},
+                       FLAGS_scale_factor)
+                   .capturePlanNodeId(scanId)
+                   .orderBy({"o_totalprice DESC", "o_orderkey"}, false)
+                   .limit(0, 10, false)
+                   .planNode();
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    scanIds.push_back(scanId);
+    return plan;
+  }
+
+  QueryRun runQuery(int32_t query, const std::string& spillPath) {
+    std::vector<core::PlanNodeId> scanIds;
+    const auto plan = makePlan(query, scanIds);
+    const auto queryCtx = newQueryCtx(
+        memory::memoryManager(),
+        executor_.get(),
+        FLAGS_query_capacity > 0 ? FLAGS_query_capacity
+                                 : FLAGS_arbitrator_capacity);
+
+    AssertQueryBuilder builder(plan);
+    builder.queryCtx(queryCtx).maxDrivers(FLAGS_num_drivers);
+    for (const auto& scanId : scanIds) {
+      std::vector<Split> splits;
+      for (auto i = 0; i < FLAGS_num_splits; ++i) {
+        splits.emplace_back(
+            std::make_shared<connector::tpch::TpchConnectorSplit>(
+                kTpchConnectorId, FLAGS_num_splits, i));
+      }
+      builder.splits(scanId, std::move(splits));
+    }
+    if (FLAGS_spill_enabled) {
+      builder
+          .configs({
+              {core::QueryConfig::kSpillEnabled, "true"},
+              {core::QueryConfig::kAggregationSpillEnabled, "true"},
+              {core::QueryConfig::kJoinSpillEnabled, "true"},
+              {core::QueryConfig::kOrderBySpillEnabled, "true"},
+          })
+          .spillDirectory(spillPath);
+    }
+
+    QueryRun run{query, 0, 0, false};
+    std::shared_ptr<Task> task;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      builder.copyResults(pool_.get(), task);
+      run.success = true;
+    } catch (const VeloxException& e) {
+      // Queries that run out of memory or are aborted by the arbitrator are
+      // counted as failed. Anything else is a bug.
+      if (e.errorCode() != error_code::kMemCapExceeded.c_str() &&
+          e.errorCode() != error_code::kMemAborted.c_str()) {
+        throw;
+      }
+    }
+    run.wallMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    if (task != nullptr) {
+      for (const auto& [_, stats] : toPlanStats(task->taskStats())) {
+        run.spilledBytes += stats.spilledBytes;
+      }
+    }
+    return run;
+  }
+
+  static uint64_t percentile(std::vector<uint64_t>& values, int32_t pct) {
+    if (values.empty()) {
+      return 0;
+    }
+    std::sort(values.begin(), values.end());
+    return values[std::min<size_t>(
+        values.size() - 1, values.size() * pct / 100)];
+  }
+
+  void printResults(
+      const std::vector<QueryRun>& runs,
+      uint64_t elapsedMicros,
+      const memory::MemoryArbitrator::Stats& arbitratorStats) const {
+    std::vector<uint64_t> allLatencies;
+    uint64_t totalSpilledBytes = 0;
+    int32_t numFailed = 0;
+    for (int32_t query = kAgg; query <= kOrderBy; ++query) {
+      std::vector<uint64_t> latencies;
+      uint64_t spilledBytes = 0;
+      int32_t numQueryFailed = 0;
+      for (const auto& run : runs) {
+        if (run.query != query) {
+          continue;
+        }
+        spilledBytes += run.spilledBytes;
+        if (run.success) {
+          latencies.push_back(run.wallMicros);
+        } else {
+          ++numQueryFailed;
+        }
+      }
+      if (latencies.empty() && numQueryFailed == 0) {
+        continue;
+      }
+      allLatencies.insert(
+          allLatencies.end(), latencies.begin(), latencies.end());
+      totalSpilledBytes += spilledBytes;
+      numFailed += numQueryFailed;
+      std::cout << kQueryNames[query] << ": " << latencies.size()
+                << " succeeded, " << numQueryFailed << " failed, p50 "
+                << succinctMicros(percentile(latencies, 50)) << ", p99 "
+                << succinctMicros(percentile(latencies, 99)) << ", spilled "
+                << succinctBytes(spilledBytes) << std::endl;
+    }
+
+    const double seconds = elapsedMicros / 1'000'000.0;
+    std::cout << "total: " << allLatencies.size() << " succeeded, "
+              << numFailed << " failed in " << succinctMicros(elapsedMicros)
+              << ", " << fmt::format("{:.2f}", allLatencies.size() / seconds)
+              << " queries/s, p50 "
+              << succinctMicros(percentile(allLatencies, 50)) << ", p99 "
+              << succinctMicros(percentile(allLatencies, 99)) << ", spilled "
+              << succinctBytes(totalSpilledBytes) << std::endl;
+    std::cout << "arbitration: " << arbitratorStats.numRequests
+              << " requests, " << arbitratorStats.numSucceeded
+              << " succeeded, " << arbitratorStats.numAborted << " aborted, "
+              << arbitratorStats.numFailures << " failed, reclaimed "
+              << succinctBytes(arbitratorStats.numReclaimedBytes)
+              << ", arbitration time "
+              << succinctMicros(arbitratorStats.arbitrationTimeUs)
+              << ", queue time " << succinctMicros(arbitratorStats.queueTimeUs)
+              << std::endl;
+  }
+
+  const std::shared_ptr<folly::Executor> executor_;
+  const std::shared_ptr<memory::MemoryPool> rootPool_{
+      memory::memoryManager()->addRootPool("concurrentQueryBenchmark")};
+  const std::shared_ptr<memory::MemoryPool> pool_{
+      rootPool_->addLeafChild("concurrentQueryBenchmarkLeaf")};
+
+  // Query and cumulative weight of the entries of --query_mix.
+  std::vector<std::pair<int32_t, int32_t>> mix_;
+  int32_t totalWeight_{0};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::Init init{&argc, &argv};
+
+  memory::SharedArbitrator::registerFactory();
+  memory::MemoryManagerOptions options;
+  options.arbitratorKind = "SHARED";
+  options.arbitratorCapacity = FLAGS_arbitrator_capacity;
+  // Leave room for the results, which are not counted against the queries.
+  options.allocatorCapacity = FLAGS_arbitrator_capacity * 2;
+  memory::MemoryManager::initialize(options);
+
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+  filesystems::registerLocalFileSystem();
+  connector::registerConnector(
+      connector::getConnectorFactory(
+          connector::tpch::TpchConnectorFactory::kTpchConnectorName)
+          ->newConnector(
+              kTpchConnectorId, std::make_shared<core::MemConfig>()));
+
+  ConcurrentQueryBenchmark().run();
+
+  connector::unregisterConnector(kTpchConnectorId);
+  return 0;
+}
@@ -14,11 +14,13 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 
 #include "velox/core/QueryConfig.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -26,7 +28,9 @@
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/parse/TypeResolver.h"
+#include "velox/serializers/CompactRowSerializer.h"
 #include "velox/serializers/PrestoSerializer.h"
+#include "velox/serializers/UnsafeRowSerializer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 DEFINE_int32(width, 16, "Number of parties in shuffle");
@@ -42,6 +46,37 @@ DEFINE_int64(
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
 DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
 
+DEFINE_bool(
+    sweep,
+    false,
+    "Runs the cross product of the sweep_* lists instead of the fixed set of "
+    "benchmarks");
+DEFINE_string(
+    sweep_destinations,
+    "1,16,256,4096",
+    "Comma separated numbers of destinations (consumer tasks)");
+DEFINE_string(
+    sweep_encodings,
+    "flat,dictionary,constant,nested",
+    "Comma separated input encodings: flat, dictionary, constant or nested");
+DEFINE_string(
+    sweep_serdes,
+    "presto,compact,unsafe",
+    "Comma separated serdes: presto, compact or unsafe");
+DEFINE_string(
+    sweep_compression,
+    "none,lz4,zstd",
+    "Comma separated compression kinds of the shuffled pages");
+DEFINE_string(
+    sweep_batch_rows,
+    "50,1000,10000",
+    "Comma separated numbers of rows per input batch");
+DEFINE_int32(
+    sweep_rows,
+    100000,
+    "Number of input rows per producer driver in each sweep configuration");
+DEFINE_int32(sweep_producers, 4, "Number of producer tasks in the sweep");
+
 /// Benchmarks repartition/exchange with different batch sizes,
 /// numbers of destinations and data type mixes.  Generates a plan
 /// that 1. shuffles a constant input in each of n workers, sending
@@ -49,6 +84,12 @@ DEFINE_int32(dict_pct, 0, "Percentage of columns wrapped in dictionary");
 /// count the rows and send the count to a final single task stage
 /// that returns the sum of the counts. The sum is expected to be n *
 /// number of rows in constant input.
+///
+/// With --sweep, runs the same shuffle for each combination of number of
+/// destinations, input encoding, serde, compression and batch size given by
+/// the sweep_* flags and prints the throughput, the CPU time of
+/// repartitioning and exchange per row and the peak memory of a task for
+/// each.
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -64,6 +105,8 @@ struct Counters {
   int64_t exchangeNanos{0};
   int64_t exchangeRows{0};
   int64_t exchangeBatches{0};
+  // Largest peak memory of a single task.
+  int64_t peakBytes{0};
 
   std::string toString() {
     if (exchangeBatches == 0) {
@@ -105,11 +148,56 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  /// Returns 'numVectors' batches of 'rowsPerVector' rows of 'type'. All
+  /// columns except the partitioning key 'c0' are flat, dictionary or
+  /// constant encoded depending on 'encoding'. "nested" leaves the columns
+  /// flat and is meant to be used with a type with nested columns.
+  std::vector<RowVectorPtr> makeEncodedRows(
+      const RowTypePtr& type,
+      const std::string& encoding,
+      int32_t numVectors,
+      int32_t rowsPerVector) {
+    // 'dictPct' of 100 leaves all columns flat.
+    auto vectors = makeRows(type, numVectors, rowsPerVector, 100);
+    if (encoding == "flat" || encoding == "nested") {
+      return vectors;
+    }
+    VELOX_USER_CHECK(
+        encoding == "dictionary" || encoding == "constant",
+        "Unknown encoding: {}",
+        encoding);
+    for (auto& vector : vectors) {
+      const auto size = vector->size();
+      for (auto i = 1; i < vector->childrenSize(); ++i) {
+        auto& child = vector->childAt(i);
+        if (encoding == "dictionary") {
+          child = BaseVector::wrapInDictionary(
+              nullptr, makeIndicesInReverse(size), size, child);
+        } else {
+          child = BaseVector::wrapInConstant(size, 0, child);
+        }
+      }
+    }
+    return vectors;
+  }
+
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
       Counters& counters) {
+    run(vectors, width, taskWidth, width, taskWidth, counters);
+  }
+
+  /// Shuffles 'vectors' from 'numProducers' tasks of 'producerWidth' drivers
+  /// each to 'numConsumers' tasks of 'consumerWidth' drivers each.
+  void run(
+      std::vector<RowVectorPtr>& vectors,
+      int32_t numProducers,
+      int32_t producerWidth,
+      int32_t numConsumers,
+      int32_t consumerWidth,
+      Counters& counters) {
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
@@ -118,16 +206,16 @@ class ExchangeBenchmark : public VectorTestBase {
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
                         .values(vectors, true)
-                        .partitionedOutput({"c0"}, width)
+                        .partitionedOutput({"c0"}, numConsumers)
                         .planNode();
 
     auto startMicros = getCurrentTimeMicro();
-    for (int32_t counter = 0; counter < width; ++counter) {
+    for (int32_t counter = 0; counter < numProducers; ++counter) {
       auto leafTaskId = makeTaskId(iteration, "leaf", counter);
       leafTaskIds.push_back(leafTaskId);
       auto leafTask = makeTask(leafTaskId, leafPlan, counter);
       tasks.push_back(leafTask);
-      leafTask->start(taskWidth);
+      leafTask->start(producerWidth);
     }
 
     core::PlanNodePtr finalAggPlan;
@@ -139,13 +227,13 @@ class ExchangeBenchmark : public VectorTestBase {
                        .planNode();
 
     std::vector<exec::Split> finalAggSplits;
-    for (int i = 0; i < width; i++) {
+    for (int i = 0; i < numConsumers; i++) {
       auto taskId = makeTaskId(iteration, "final-agg", i);
       finalAggSplits.push_back(
           exec::Split(std::make_shared<exec::RemoteConnectorSplit>(taskId)));
       auto task = makeTask(taskId, finalAggPlan, i);
       tasks.push_back(task);
-      task->start(taskWidth);
+      task->start(consumerWidth);
       addRemoteSplits(task, leafTaskIds);
     }
 
@@ -156,7 +244,8 @@ class ExchangeBenchmark : public VectorTestBase {
 
     auto expected =
         makeRowVector({makeFlatVector<int64_t>(1, [&](auto /*row*/) {
-          return vectors.size() * vectors[0]->size() * width * taskWidth;
+          return vectors.size() * vectors[0]->size() * numProducers *
+              producerWidth;
         })});
 
     exec::test::AssertQueryBuilder(plan)
@@ -169,6 +258,8 @@ class ExchangeBenchmark : public VectorTestBase {
     int64_t exchangeBatches = 0;
     int64_t exchangeRows = 0;
     for (auto& task : tasks) {
+      counters.peakBytes =
+          std::max<int64_t>(counters.peakBytes, task->pool()->peakBytes());
       auto stats = task->taskStats();
       for (auto& pipeline : stats.pipelineStats) {
         for (auto& op : pipeline.operatorStats) {
@@ -187,7 +278,8 @@ class ExchangeBenchmark : public VectorTestBase {
     }
 
     counters.bytes += bytes;
-    counters.rows += width * vectors.size() * vectors[0]->size();
+    counters.rows +=
+        numProducers * producerWidth * vectors.size() * vectors[0]->size();
     counters.usec += elapsed;
     counters.repartitionNanos += repartitionNanos;
     counters.exchangeNanos += exchangeNanos;
@@ -344,6 +436,91 @@ int32_t ExchangeBenchmark::iteration_;
 
 std::unique_ptr<ExchangeBenchmark> bm;
 
+template <typename T>
+std::vector<T> parseList(const std::string& list) {
+  std::vector<T> result;
+  folly::split(',', list, result);
+  return result;
+}
+
+void setSerde(const std::string& name) {
+  deregisterVectorSerde();
+  if (name == "presto") {
+    serializer::presto::PrestoVectorSerde::registerVectorSerde();
+  } else if (name == "compact") {
+    serializer::CompactRowVectorSerde::registerVectorSerde();
+  } else if (name == "unsafe") {
+    serializer::spark::UnsafeRowVectorSerde::registerVectorSerde();
+  } else {
+    VELOX_USER_FAIL("Unknown serde: {}", name);
+  }
+}
+
+// Runs a shuffle for each combination of the sweep_* flags and prints one
+// line per combination. Consumer tasks run a single driver so that the large
+// fan-outs stay within the executor.
+void runSweep(const RowTypePtr& flatType, const RowTypePtr& deepType) {
+  const auto destinations = parseList<int32_t>(FLAGS_sweep_destinations);
+  const auto batchRows = parseList<int32_t>(FLAGS_sweep_batch_rows);
+  std::cout << fmt::format(
+                   "{:>8} {:>12} {:>8} {:>11} {:>6} {:>12} {:>10} {:>10}",
+                   "serde",
+                   "compression",
+                   "encoding",
+                   "batch rows",
+                   "dests",
+                   "bytes/s",
+                   "cpu/row",
+                   "peak")
+            << std::endl;
+  for (const auto& serde : parseList<std::string>(FLAGS_sweep_serdes)) {
+    setSerde(serde);
+    for (const auto& compression :
+         parseList<std::string>(FLAGS_sweep_compression)) {
+      OutputBufferManager::getInstance().lock()->testingSetCompression(
+          common::stringToCompressionKind(compression));
+      for (const auto& encoding :
+           parseList<std::string>(FLAGS_sweep_encodings)) {
+        for (auto rows : batchRows) {
+          auto vectors = bm->makeEncodedRows(
+              encoding == "nested" ? deepType : flatType,
+              encoding,
+              std::max(1, FLAGS_sweep_rows / rows),
+              rows);
+          for (auto numDestinations : destinations) {
+            Counters counters;
+            bm->run(
+                vectors,
+                FLAGS_sweep_producers,
+                FLAGS_task_width,
+                numDestinations,
+                1,
+                counters);
+            const auto cpuNanos =
+                counters.repartitionNanos + counters.exchangeNanos;
+            std::cout << fmt::format(
+                             "{:>8} {:>12} {:>8} {:>11} {:>6} {:>12} "
+                             "{:>10} {:>10}",
+                             serde,
+                             compression,
+                             encoding,
+                             rows,
+                             numDestinations,
+                             succinctBytes(
+                                 counters.bytes / (counters.usec / 1.0e6)),
+                             succinctNanos(cpuNanos / counters.rows),
+                             succinctBytes(counters.peakBytes))
+                      << std::endl;
+          }
+        }
+      }
+    }
+  }
+  setSerde("presto");
+  OutputBufferManager::getInstance().lock()->testingSetCompression(
+      common::CompressionKind::CompressionKind_NONE);
+}
+
 void runBenchmarks() {
   std::vector<RowVectorPtr> flat10k;
   std::vector<RowVectorPtr> deep10k;
@@ -411,6 +588,11 @@ void runBenchmarks() {
             MAP(BIGINT(),
                 ROW({{"s2_int", INTEGER()}, {"s2_string", VARCHAR()}})))}});
 
+  if (FLAGS_sweep) {
+    runSweep(flatType, deepType);
+    return;
+  }
+
   flat10k = bm->makeRows(flatType, 10, 10000, FLAGS_dict_pct);
   deep10k = bm->makeRows(deepType, 10, 10000, FLAGS_dict_pct);
   flat50 = bm->makeRows(flatType, 2000, 50, FLAGS_dict_pct);
@@ -36,7 +36,8 @@ struct HashTableBenchmarkParams {
   //  -the build & probe row schema,
   //  -the expected hash table size,
   //  -number of probing rows,
-  //  -build key repetition distribution.
+  //  -build key repetition distribution,
+  //  -optional limit on the bytes of each listJoinResults call.
   HashTableBenchmarkParams(
       BaseHashTable::HashMode mode,
       const TypePtr& buildType,
@@ -44,13 +45,15 @@ struct HashTableBenchmarkParams {
       int64_t probeSize,
       const std::vector<std::pair<int32_t, int32_t>>&
           keyRepeatTimesDistribution,
-      bool runErase)
+      bool runErase,
+      uint64_t maxBatchBytes = RowContainer::kUnlimited)
       : mode{mode},
         buildType{buildType},
         hashTableSize{hashTableSize},
         probeSize{probeSize},
         keyRepeatTimesDistribution{keyRepeatTimesDistribution},
-        runErase{runErase} {
+        runErase{runErase},
+        maxBatchBytes{maxBatchBytes} {
     int32_t distSum = 0;
     buildSize = 0;
     buildKeyRepeat.reserve(keyRepeatTimesDistribution.size());
@@ -93,6 +96,9 @@ struct HashTableBenchmarkParams {
     if (runErase) {
       title += ",withErase";
     }
+    if (maxBatchBytes != RowContainer::kUnlimited) {
+      title += fmt::format(",maxBatchBytes:{}", maxBatchBytes);
+    }
   }
 
   // Expected mode.
@@ -113,6 +119,10 @@ struct HashTableBenchmarkParams {
 
   bool runErase;
 
+  // Limit on the estimated output bytes of each listJoinResults call. The
+  // join key is treated as the projected build side column.
+  uint64_t maxBatchBytes;
+
   // Title for reporting
   std::string title;
 
@@ -410,6 +420,7 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
     auto batchSize = params_.hashTableSize;
     SelectivityInfo listJoinResultClocks;
     BaseHashTable::JoinResultIterator results;
+    results.fixedSizeListColumns = sizeof(int64_t);
     BufferPtr outputRowMapping;
     auto outputBatchSize = batchSize;
     std::vector<char*> outputTableRows;
@@ -429,7 +440,8 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
               results,
               false,
               mapping,
-              folly::Range(outputTableRows.data(), outputTableRows.size()));
+              folly::Range(outputTableRows.data(), outputTableRows.size()),
+              params_.maxBatchBytes);
         }
       }
     }
@@ -457,7 +469,8 @@ class HashTableListJoinResultBenchmark : public VectorTestBase {
         results,
         false,
         mapping,
-        folly::Range(outputTableRows.data(), outputTableRows.size()));
+        folly::Range(outputTableRows.data(), outputTableRows.size()),
+        RowContainer::kUnlimited);
     {
       SelectivityTimer timer(eraseClock, 0);
       topTable_->rows()->eraseRows(
@@ -539,6 +552,22 @@ int main(int argc, char** argv) {
     }
   }
 
+  // High fan-out joins with the output of each listJoinResults call capped at
+  // 1MB as HashProbe does with preferred_output_batch_bytes.
+  for (auto mode : hashModes) {
+    for (auto& dist : std::vector<std::vector<std::pair<int32_t, int32_t>>>{
+             {{20, 50}, {80, 0}}, {{100, 25}}}) {
+      params.emplace_back(HashTableBenchmarkParams(
+          mode,
+          onlyKeyType,
+          hashTableSize,
+          probeRowSize,
+          dist,
+          false,
+          1 << 20));
+    }
+  }
+
   for (auto& param : params) {
     folly::addBenchmark(__FILE__, param.title, [param, &bm, &results]() {
       combineResults(results, bm->run(param));
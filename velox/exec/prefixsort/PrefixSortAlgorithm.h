@@ -15,9 +15,12 @@
  */
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <tuple>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
@@ -151,6 +154,10 @@ class PrefixSortRunner {
   static const int kSmallSort = 7;
   static const int kMediumSort = 40;
 
+  // Within radixSort, ranges with fewer entries than this are sorted with
+  // quickSort.
+  static const int kMinRadixSortEntries = 64;
+
   template <typename TCompare>
   void quickSort(char* start, char* end, TCompare compare) const {
     quickSort(
@@ -159,6 +166,80 @@ class PrefixSortRunner {
         compare);
   }
 
+  /// Sorts the entries in [start, end) with an MSD radix sort on their first
+  /// 'keySize' bytes. The keys are compared as a sequence of 8 byte unsigned
+  /// words in native (little-endian) byte order, which is how PrefixSort
+  /// stores normalized keys, so 'keySize' must be a multiple of 8. Ranges of
+  /// fewer than kMinRadixSortEntries entries and ranges of entries with equal
+  /// keys are sorted with quickSort using 'compare', which must order the
+  /// entries by their keys first.
+  template <typename TCompare>
+  void radixSort(char* start, char* end, uint32_t keySize, TCompare compare)
+      const {
+    VELOX_CHECK_EQ(keySize % 8, 0);
+    VELOX_CHECK_LE(keySize, entrySize_);
+    // Ranges left to sort: first entry, number of entries and the index of
+    // the key byte to distribute on. Iterative to bound the stack use with
+    // long keys.
+    std::vector<std::tuple<char*, uint64_t, uint32_t>> ranges;
+    ranges.emplace_back(start, (end - start) / entrySize_, 0);
+    std::array<uint64_t, 256> counts;
+    std::array<uint64_t, 256> heads;
+    std::array<uint64_t, 256> tails;
+    while (!ranges.empty()) {
+      const auto [begin, numEntries, byteIndex] = ranges.back();
+      ranges.pop_back();
+      if (numEntries < kMinRadixSortEntries || byteIndex >= keySize) {
+        if (numEntries > 1) {
+          quickSort(begin, begin + numEntries * entrySize_, compare);
+        }
+        continue;
+      }
+
+      // The most significant byte of a little-endian word is its last byte.
+      const uint32_t offset = byteIndex - byteIndex % 8 + 7 - byteIndex % 8;
+      counts.fill(0);
+      for (uint64_t i = 0; i < numEntries; ++i) {
+        ++counts[static_cast<uint8_t>(begin[i * entrySize_ + offset])];
+      }
+      if (counts[static_cast<uint8_t>(begin[offset])] == numEntries) {
+        // All entries have the same byte.
+        ranges.emplace_back(begin, numEntries, byteIndex + 1);
+        continue;
+      }
+
+      uint64_t sum = 0;
+      for (auto i = 0; i < 256; ++i) {
+        heads[i] = sum;
+        sum += counts[i];
+        tails[i] = sum;
+      }
+      // Moves each entry to its bucket by swapping, American flag style.
+      for (auto bucket = 0; bucket < 256; ++bucket) {
+        while (heads[bucket] < tails[bucket]) {
+          char* entry = begin + heads[bucket] * entrySize_;
+          const auto byte = static_cast<uint8_t>(entry[offset]);
+          if (byte == bucket) {
+            ++heads[bucket];
+            continue;
+          }
+          swap(
+              detail::PrefixSortIterator(entry, entrySize_),
+              detail::PrefixSortIterator(
+                  begin + heads[byte]++ * entrySize_, entrySize_));
+        }
+      }
+      for (auto bucket = 0; bucket < 256; ++bucket) {
+        if (counts[bucket] > 1) {
+          ranges.emplace_back(
+              begin + (tails[bucket] - counts[bucket]) * entrySize_,
+              counts[bucket],
+              byteIndex + 1);
+        }
+      }
+    }
+  }
+
   /// For testing only.
   template <typename TCompare>
   FOLLY_ALWAYS_INLINE static char* testingMedian3(
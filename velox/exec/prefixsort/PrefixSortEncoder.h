@@ -53,6 +53,50 @@ class PrefixSortEncoder {
     }
   }
 
+  /// Encodes a string key truncated to 'maxLength' bytes.
+  /// 1. The first byte is the null byte, the same as for other types.
+  /// 2. The next 'maxLength' bytes are the first bytes of the string, padded
+  ///    with zeros.
+  /// 3. The last byte is min(size, maxLength + 1). If the string bytes of two
+  ///    values are equal, the value with the fewer bytes (or trailing zeros)
+  ///    is smaller. Two strings longer than 'maxLength' with equal first bytes
+  ///    compare equal, so the order of such strings must be decided from the
+  ///    full values.
+  /// Bytes 2 and 3 are inverted for descending order. 'maxLength' must be less
+  /// than 255.
+  FOLLY_ALWAYS_INLINE void encode(
+      std::optional<StringView> value,
+      char* dest,
+      uint32_t maxLength) const {
+    if (!value.has_value()) {
+      dest[0] = nullsFirst_ ? 0 : 1;
+      simd::memset(dest + 1, 0, maxLength + 1);
+      return;
+    }
+    dest[0] = nullsFirst_ ? 1 : 0;
+    const auto size = value->size();
+    const auto copySize = std::min<uint32_t>(size, maxLength);
+    simd::memcpy(dest + 1, value->data(), copySize);
+    simd::memset(dest + 1 + copySize, 0, maxLength - copySize);
+    dest[1 + maxLength] = static_cast<char>(std::min(size, maxLength + 1));
+    if (!ascending_) {
+      for (uint32_t i = 1; i < maxLength + 2; ++i) {
+        dest[i] = ~dest[i];
+      }
+    }
+  }
+
+  /// Returns true if 'lengthByte', the last byte of a string encoded by the
+  /// above function, shows that the string was not truncated.
+  FOLLY_ALWAYS_INLINE bool isStringComplete(
+      uint8_t lengthByte,
+      uint32_t maxLength) const {
+    if (!ascending_) {
+      lengthByte = ~lengthByte;
+    }
+    return lengthByte <= maxLength;
+  }
+
   /// @tparam T Type of value. Supported type are: uint64_t, int64_t, uint32_t,
   /// int32_t, float, double, Timestamp. TODO Add support for int16_t, uint16_t.
   template <typename T>
@@ -67,9 +111,11 @@ class PrefixSortEncoder {
   }
 
   /// @return For supported types, returns the encoded size, assume nullable.
-  ///         For not supported types, returns 'std::nullopt'.
+  ///         For not supported types, returns 'std::nullopt'. String types
+  ///         are supported if 'maxStringPrefixLength' is not 0.
   FOLLY_ALWAYS_INLINE static std::optional<uint32_t> encodedSize(
-      TypeKind typeKind) {
+      TypeKind typeKind,
+      uint32_t maxStringPrefixLength = 0) {
     switch ((typeKind)) {
       case ::facebook::velox::TypeKind::INTEGER: {
         return 5;
@@ -86,6 +132,13 @@ class PrefixSortEncoder {
       case ::facebook::velox::TypeKind::TIMESTAMP: {
         return 17;
       }
+      case ::facebook::velox::TypeKind::VARCHAR:
+      case ::facebook::velox::TypeKind::VARBINARY: {
+        if (maxStringPrefixLength == 0) {
+          return std::nullopt;
+        }
+        return maxStringPrefixLength + 2;
+      }
       default:
         return std::nullopt;
     }
@@ -55,6 +55,59 @@ class PrefixSortAlgorithmTest : public testing::Test,
     ASSERT_EQ(data1, data2);
   }
 
+  // Sorts 'size' entries of two 8 byte words and a payload word with
+  // radixSort and compares with std::sort. Words are compared as unsigned
+  // integers in native byte order. 'maxValue' bounds the values of the
+  // words to test buckets with many equal keys.
+  void testRadixSort(size_t size, uint64_t maxValue) {
+    constexpr int32_t kWords = 3;
+    std::vector<uint64_t> data(size * kWords);
+    for (auto i = 0; i < size; ++i) {
+      data[i * kWords] = folly::Random::rand64() % maxValue;
+      data[i * kWords + 1] = folly::Random::rand64() % maxValue;
+      data[i * kWords + 2] = i;
+    }
+    auto compare = [](char* a, char* b) {
+      const auto* left = reinterpret_cast<uint64_t*>(a);
+      const auto* right = reinterpret_cast<uint64_t*>(b);
+      for (auto i = 0; i < 2; ++i) {
+        if (left[i] != right[i]) {
+          return left[i] < right[i] ? -1 : 1;
+        }
+      }
+      return 0;
+    };
+
+    const auto original = data;
+    std::vector<std::array<uint64_t, kWords>> expected(size);
+    for (auto i = 0; i < size; ++i) {
+      for (auto j = 0; j < kWords; ++j) {
+        expected[i][j] = data[i * kWords + j];
+      }
+    }
+    std::sort(expected.begin(), expected.end(), [](auto& a, auto& b) {
+      return std::tie(a[0], a[1]) < std::tie(b[0], b[1]);
+    });
+
+    const uint32_t entrySize = kWords * sizeof(uint64_t);
+    auto swapBuffer = AlignedBuffer::allocate<char>(entrySize, pool());
+    PrefixSortRunner sortRunner(entrySize, swapBuffer->asMutable<char>());
+    char* start = reinterpret_cast<char*>(data.data());
+    sortRunner.radixSort(
+        start, start + size * entrySize, 2 * sizeof(uint64_t), compare);
+
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_EQ(data[i * kWords], expected[i][0]) << i;
+      ASSERT_EQ(data[i * kWords + 1], expected[i][1]) << i;
+    }
+    // The payload moves with its keys.
+    for (auto i = 0; i < size; ++i) {
+      const auto payload = data[i * kWords + 2];
+      ASSERT_EQ(original[payload * kWords], data[i * kWords]);
+      ASSERT_EQ(original[payload * kWords + 1], data[i * kWords + 1]);
+    }
+  }
+
  protected:
   static void SetUpTestCase() {
     memory::MemoryManager::testingSetInstance({});
@@ -70,6 +123,15 @@ TEST_F(PrefixSortAlgorithmTest, quickSort) {
   testQuickSort(PrefixSortRunner::kMediumSort + 1000);
 }
 
+TEST_F(PrefixSortAlgorithmTest, radixSort) {
+  testRadixSort(0, 10);
+  testRadixSort(PrefixSortRunner::kMinRadixSortEntries - 1, 1'000);
+  testRadixSort(10'000, std::numeric_limits<uint64_t>::max());
+  // Many equal keys, all in a few buckets of the leading bytes.
+  testRadixSort(10'000, 7);
+  testRadixSort(10'000, 1'000);
+}
+
 TEST_F(PrefixSortAlgorithmTest, testingMedian3) {
   // Generate 3 elements randomly as input data.
   std::vector<int64_t> data1(3);
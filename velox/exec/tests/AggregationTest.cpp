@@ -1172,6 +1172,126 @@ TEST_F(AggregationTest, spillAll) {
   }
 }
 
+TEST_F(AggregationTest, finalAggregationPartitionMerge) {
+  const int32_t numDrivers = 4;
+  auto inputs = makeVectors(rowType_, 100, 10);
+  // The parallelizable values node produces 'inputs' in each driver.
+  std::vector<RowVectorPtr> allInputs;
+  for (auto i = 0; i < numDrivers; ++i) {
+    allInputs.insert(allInputs.end(), inputs.begin(), inputs.end());
+  }
+  const std::vector<std::string> keys{"c0", "c6"};
+  const std::vector<std::string> aggregates{
+      "sum(c1)", "count(c2)", "avg(c4)", "max(c5)"};
+  auto expected = AssertQueryBuilder(PlanBuilder()
+                                         .values(allInputs)
+                                         .singleAggregation(keys, aggregates)
+                                         .planNode())
+                      .copyResults(pool_.get());
+
+  core::PlanNodeId aggregationId;
+  // No local partition between the partial and the final aggregation.
+  auto plan = PlanBuilder()
+                  .values(inputs, true)
+                  .partialAggregation(keys, aggregates)
+                  .finalAggregation()
+                  .capturePlanNodeId(aggregationId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .maxDrivers(numDrivers)
+                  .config(QueryConfig::kFinalAggregationPartitionMerge, true)
+                  .assertResults(expected);
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      planStats.at(aggregationId)
+          .customStats.at("partitionMergeRows")
+          .sum,
+      numDrivers * expected->size());
+
+  // Without the partition merge the drivers produce duplicate groups.
+  auto results = AssertQueryBuilder(plan)
+                     .maxDrivers(numDrivers)
+                     .copyResults(pool_.get());
+  ASSERT_EQ(results->size(), numDrivers * expected->size());
+}
+
+TEST_F(AggregationTest, columnarAccumulators) {
+  auto inputs = makeVectors(rowType_, 1'000, 10);
+  const std::vector<std::string> keys{"c0"};
+  std::vector<std::string> aggregates{
+      "count(1)", "count(c2)", "avg(c4)", "min(c3)", "max(c5)"};
+  for (auto i = 0; i < 32; ++i) {
+    aggregates.push_back(fmt::format("sum(c{})", i % 2 == 0 ? 1 : 2));
+  }
+
+  for (const bool partial : {false, true}) {
+    SCOPED_TRACE(fmt::format("partial: {}", partial));
+    auto builder = PlanBuilder().values(inputs);
+    if (partial) {
+      builder.partialAggregation(keys, aggregates).finalAggregation();
+    } else {
+      builder.singleAggregation(keys, aggregates);
+    }
+    auto plan = builder.planNode();
+    auto expected = AssertQueryBuilder(plan).copyResults(pool_.get());
+    AssertQueryBuilder(plan)
+        .config(QueryConfig::kAggregationColumnarAccumulators, true)
+        .assertResults(expected);
+  }
+
+  // Aggregates with variable width accumulators use the row layout.
+  auto plan = PlanBuilder()
+                  .values(inputs)
+                  .singleAggregation(keys, {"sum(c1)", "array_agg(c2)"})
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool_.get());
+  AssertQueryBuilder(plan)
+      .config(QueryConfig::kAggregationColumnarAccumulators, true)
+      .assertResults(expected);
+}
+
+TEST_F(AggregationTest, partialAggregationClusteredInput) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> clustered;
+  std::vector<RowVectorPtr> unclustered;
+  for (auto i = 0; i < 20; ++i) {
+    clustered.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize, [&](auto row) { return (i * batchSize + row) / 10; }),
+        makeFlatVector<int64_t>(batchSize, [](auto row) { return row; }),
+    }));
+    unclustered.push_back(makeRowVector({
+        makeFlatVector<int64_t>(batchSize, [](auto row) { return row % 100; }),
+        makeFlatVector<int64_t>(batchSize, [](auto row) { return row; }),
+    }));
+  }
+
+  for (const bool isClustered : {true, false}) {
+    SCOPED_TRACE(fmt::format("clustered: {}", isClustered));
+    const auto& data = isClustered ? clustered : unclustered;
+    createDuckDbTable(data);
+
+    core::PlanNodeId aggregationId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kPartialAggregationDetectClusteredInput, true)
+            .plan(PlanBuilder()
+                      .values(data)
+                      .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(aggregationId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, sum(c1), count(1) FROM tmp GROUP BY 1");
+    const auto stats = toPlanStats(task->taskStats()).at(aggregationId);
+    ASSERT_EQ(stats.customStats.count("clusteredInput"), isClustered ? 1 : 0);
+    if (isClustered) {
+      // The groups are output as the keys change, so each batch but the last
+      // leaves only its last group in the hash table.
+      ASSERT_GT(stats.outputVectors, 1);
+    }
+  }
+}
+
 // Verify number of memory allocations in the HashAggregation operator.
 TEST_F(AggregationTest, memoryAllocations) {
   vector_size_t size = 1'024;
@@ -1325,6 +1445,80 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsPreAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data});
+
+  core::PlanNodeId groupIdNodeId;
+  auto plan =
+      PlanBuilder()
+          .values({data})
+          .groupId({"k1", "k2"}, {{"k1", "k2"}, {"k1"}, {"k2"}, {}}, {"a", "b"})
+          .capturePlanNodeId(groupIdNodeId)
+          .singleAggregation(
+              {"k1", "k2", "group_id"},
+              {"count(1) as count_1",
+               "sum(a) as sum_a",
+               "max(b) as max_b",
+               "avg(a) as avg_a"})
+          .project({"k1", "k2", "count_1", "sum_a", "max_b", "avg_a"})
+          .planNode();
+  const std::string sql =
+      "SELECT k1, k2, count(1), sum(a), max(b), avg(a) FROM tmp "
+      "GROUP BY CUBE (k1, k2)";
+
+  // The GroupId operator duplicates the 11 * 17 partial groups, not the input
+  // rows.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_).assertResults(sql);
+  ASSERT_EQ(
+      toPlanStats(task->taskStats()).at(groupIdNodeId).inputRows, 11 * 17);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(QueryConfig::kGroupingSetsPreAggregation, false)
+             .assertResults(sql);
+  ASSERT_EQ(toPlanStats(task->taskStats()).at(groupIdNodeId).inputRows, size);
+
+  // Global grouping set over empty input.
+  plan = PlanBuilder()
+             .values({data})
+             .filter("a < 0")
+             .groupId({"k1"}, {{"k1"}, {}}, {"a"})
+             .singleAggregation(
+                 {"k1", "group_id"}, {"count(1) as count_1", "sum(a) as sum_a"})
+             .project({"k1", "count_1", "sum_a"})
+             .planNode();
+  assertQuery(
+      plan,
+      "SELECT k1, count(1), sum(a) FROM tmp WHERE a < 0 "
+      "GROUP BY GROUPING SETS ((k1), ())");
+
+  // An aggregation input that copies a grouping key keeps its values in the
+  // grouping sets without that key.
+  plan = PlanBuilder()
+             .values({data})
+             .project({"k1", "k2", "a", "b", "k1 AS k1_input"})
+             .groupId({"k1", "k2"}, {{"k1"}, {"k2"}}, {"a", "k1_input"})
+             .singleAggregation(
+                 {"k1", "k2", "group_id"},
+                 {"count(k1_input) as count_k1", "sum(a) as sum_a"})
+             .project({"k1", "k2", "count_k1", "sum_a"})
+             .planNode();
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(k1), sum(a) FROM tmp "
+      "GROUP BY GROUPING SETS ((k1), (k2))");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1833,6 +2027,45 @@ TEST_F(AggregationTest, distinctWithSpilling) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, distinctAggregationHashTable) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"},
+                      {"count(DISTINCT c1)",
+                       "sum(DISTINCT c2)",
+                       "count(DISTINCT c6)",
+                       "count(c1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kDistinctAggregationHashTable, true)
+      .assertResults(
+          "SELECT c0, count(DISTINCT c1), sum(DISTINCT c2), count(DISTINCT c6), count(c1) FROM tmp GROUP BY c0");
+
+  // Global aggregation.
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation({}, {"count(DISTINCT c1)", "sum(DISTINCT c2)"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kDistinctAggregationHashTable, true)
+      .assertResults("SELECT count(DISTINCT c1), sum(DISTINCT c2) FROM tmp");
+
+  // Masked distinct aggregation.
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0", "c1", "c2 % 3 = 0 AS m"})
+             .singleAggregation({"c0"}, {"count(DISTINCT c1)"}, {"m"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kDistinctAggregationHashTable, true)
+      .assertResults(
+          "SELECT c0, count(DISTINCT c1) FILTER (WHERE c2 % 3 = 0) FROM tmp GROUP BY c0");
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
@@ -1858,6 +2091,60 @@ TEST_F(AggregationTest, spillingForAggrsWithDistinct) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, spillingForAggrsWithDistinctHashTable) {
+  auto vectors = makeVectors(rowType_, 100, 10);
+  createDuckDbTable(vectors);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+
+  auto testPlan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    SCOPED_TRACE(sql);
+    TestScopedSpillInjection scopedSpillInjection(100);
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->getPath())
+                    .config(QueryConfig::kSpillEnabled, true)
+                    .config(QueryConfig::kAggregationSpillEnabled, true)
+                    .config(QueryConfig::kDistinctAggregationHashTable, true)
+                    .plan(plan)
+                    .assertResults(sql);
+
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    auto& stats = taskStats.at(aggrNodeId);
+    checkSpillStats(stats, true);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  // Few groups and distinct values so that the same inputs of a group are in
+  // several spill runs.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 % 11 AS k", "c1 % 5 AS v", "c6"})
+                  .singleAggregation(
+                      {"k"},
+                      {"count(DISTINCT v)",
+                       "sum(DISTINCT v)",
+                       "count(DISTINCT c6)",
+                       "count(v)"})
+                  .capturePlanNodeId(aggrNodeId)
+                  .planNode();
+  testPlan(
+      plan,
+      "SELECT c0 % 11, count(DISTINCT c1 % 5), sum(DISTINCT c1 % 5), "
+      "count(DISTINCT c6), count(c1 % 5) FROM tmp GROUP BY 1");
+
+  // Masked distinct aggregation.
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0 % 11 AS k", "c1 % 5 AS v", "c2 % 3 = 0 AS m"})
+             .singleAggregation({"k"}, {"count(DISTINCT v)"}, {"m"})
+             .capturePlanNodeId(aggrNodeId)
+             .planNode();
+  testPlan(
+      plan,
+      "SELECT c0 % 11, count(DISTINCT c1 % 5) FILTER (WHERE c2 % 3 = 0) "
+      "FROM tmp GROUP BY 1");
+}
+
 TEST_F(AggregationTest, spillingForAggrsWithSorting) {
   auto vectors = makeVectors(rowType_, 100, 10);
   createDuckDbTable(vectors);
@@ -232,6 +232,79 @@ TEST_F(ContainerRowSerdeTest, arrayOfBigint) {
   testRoundTrip(data);
 }
 
+TEST_F(ContainerRowSerdeTest, fixedWidthArrays) {
+  // Arrays of flat fixed-width elements are serialized and deserialized with
+  // bulk copies. Use arrays longer than 64 elements at offsets that are not
+  // multiples of 64 to cover copying the null flags word by word.
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 1'000;
+  opts.nullRatio = 0.2;
+  VectorFuzzer fuzzer(opts, pool());
+  const std::vector<vector_size_t> offsets = {0, 3, 70, 71, 200, 333, 600};
+  const auto numElements = opts.vectorSize;
+
+  const std::vector<TypePtr> types = {
+      TINYINT(), INTEGER(), BIGINT(), HUGEINT(), DOUBLE(), TIMESTAMP()};
+  for (const auto& type : types) {
+    SCOPED_TRACE(type->toString());
+    auto elements = fuzzer.fuzzFlat(type);
+    auto data = makeArrayVector(offsets, elements);
+    testRoundTrip(data);
+    testCompare(data);
+
+    auto noNulls = makeArrayVector(offsets, fuzzer.fuzzFlatNotNull(type));
+    testRoundTrip(noNulls);
+    testCompare(noNulls);
+
+    // The results match the generic path taken for elements that are not
+    // flat.
+    auto wrapped = makeArrayVector(
+        offsets,
+        BaseVector::wrapInDictionary(
+            nullptr,
+            makeIndices(numElements, [](auto row) { return row; }),
+            numElements,
+            elements));
+    auto positions = serializeWithPositions(data);
+    DecodedVector decoded(*data);
+    DecodedVector decodedWrapped(*wrapped);
+    CompareFlags flags;
+    for (auto i = 0; i < data->size(); ++i) {
+      for (auto j = 0; j < data->size(); ++j) {
+        auto left = HashStringAllocator::prepareRead(positions[i].header);
+        const auto result = ContainerRowSerde::compare(left, decoded, j, flags);
+        left = HashStringAllocator::prepareRead(positions[i].header);
+        ASSERT_EQ(
+            result,
+            ContainerRowSerde::compare(left, decodedWrapped, j, flags));
+
+        left = HashStringAllocator::prepareRead(positions[i].header);
+        auto right = HashStringAllocator::prepareRead(positions[j].header);
+        const auto streamResult =
+            ContainerRowSerde::compare(left, right, data->type().get(), flags);
+        ASSERT_EQ(result < 0, streamResult < 0) << i << " " << j;
+        ASSERT_EQ(result == 0, streamResult == 0) << i << " " << j;
+      }
+    }
+    allocator_.clear();
+  }
+}
+
+TEST_F(ContainerRowSerdeTest, fixedWidthArrayHash) {
+  auto data = makeNullableArrayVector<int64_t>({
+      {{{1, std::nullopt, 2, 3}}},
+      {{{3, 2, 1, std::nullopt}}},
+      {{std::vector<std::optional<int64_t>>({})}},
+  });
+  auto positions = serializeWithPositions(data);
+  for (auto i = 0; i < data->size(); ++i) {
+    auto stream = HashStringAllocator::prepareRead(positions[i].header);
+    ASSERT_EQ(
+        data->hashValueAt(i),
+        ContainerRowSerde::hash(stream, data->type().get()));
+  }
+}
+
 TEST_F(ContainerRowSerdeTest, arrayOfString) {
   auto data = makeArrayVector<std::string>({
       {"a", "b", "Longer string ...."},
@@ -1548,6 +1548,161 @@ DEBUG_ONLY_TEST_F(DriverTest, driverCpuTimeSlicingCheck) {
   }
 }
 
+TEST_F(DriverTest, schedulingPriority) {
+  // A single priority.
+  ASSERT_EQ(Driver::schedulingPriority(0, 10, 1), 0);
+  ASSERT_EQ(Driver::schedulingPriority(1'000, 10, 1), 0);
+
+  // Two priorities are -1 and 0.
+  ASSERT_EQ(Driver::schedulingPriority(0, 10, 2), 0);
+  ASSERT_EQ(Driver::schedulingPriority(9, 10, 2), 0);
+  ASSERT_EQ(Driver::schedulingPriority(10, 10, 2), -1);
+  ASSERT_EQ(Driver::schedulingPriority(1'000, 10, 2), -1);
+
+  // Five priorities are -2 to 2. The query drops one priority at 10, 40 and
+  // 160ms.
+  ASSERT_EQ(Driver::schedulingPriority(0, 10, 5), 2);
+  ASSERT_EQ(Driver::schedulingPriority(10, 10, 5), 1);
+  ASSERT_EQ(Driver::schedulingPriority(39, 10, 5), 1);
+  ASSERT_EQ(Driver::schedulingPriority(40, 10, 5), 0);
+  ASSERT_EQ(Driver::schedulingPriority(160, 10, 5), -1);
+  ASSERT_EQ(Driver::schedulingPriority(640, 10, 5), -2);
+  ASSERT_EQ(
+      Driver::schedulingPriority(std::numeric_limits<uint64_t>::max(), 10, 5),
+      -2);
+  ASSERT_EQ(
+      Driver::schedulingPriority(std::numeric_limits<uint64_t>::max(), 1, 127),
+      -63);
+}
+
+TEST_F(DriverTest, priorityExecutor) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 7; }),
+         makeFlatVector<int64_t>(1'000, [&](auto row) { return row + i; })}));
+  }
+  createDuckDbTable(batches);
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4, 3);
+  const auto plan = PlanBuilder()
+                        .values(batches, true)
+                        .partialAggregation({"c0"}, {"sum(c1)"})
+                        .localPartition({"c0"})
+                        .finalAggregation()
+                        .planNode();
+  const std::string duckDbSql = "SELECT c0, sum(c1) * 4 FROM tmp GROUP BY c0";
+  auto queryCtx = core::QueryCtx::create(
+      executor.get(),
+      core::QueryConfig{
+          {{core::QueryConfig::kDriverPriorityQuantumMs, "1"},
+           {core::QueryConfig::kDriverCpuTimeSliceLimitMs, "1"}}});
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .queryCtx(queryCtx)
+      .maxDrivers(4)
+      .assertResults(duckDbSql);
+}
+
+TEST_F(DriverTest, resumeAtBlockedOperator) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 20; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 11; }),
+         makeFlatVector<int64_t>(1'000, [&](auto row) { return row * i; })}));
+  }
+  createDuckDbTable(batches);
+
+  // The small local exchange buffer blocks the producers on the consumers and
+  // the consumers on the producers.
+  const auto plan = PlanBuilder()
+                        .values(batches, true)
+                        .project({"c0", "c1 + 1 AS c1"})
+                        .filter("c1 % 3 <> 0")
+                        .localPartition({"c0"})
+                        .project({"c0", "c1 * 2 AS c1"})
+                        .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                        .planNode();
+  const std::string duckDbSql =
+      "SELECT c0, sum((c1 + 1) * 2) * 4, count(1) * 4 FROM tmp "
+      "WHERE (c1 + 1) % 3 <> 0 GROUP BY c0";
+  for (const auto resume : {false, true}) {
+    SCOPED_TRACE(fmt::format("resume: {}", resume));
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(
+            core::QueryConfig::kDriverResumeAtBlockedOperator,
+            resume ? "true" : "false")
+        .config(core::QueryConfig::kMaxLocalExchangeBufferSize, "1")
+        .maxDrivers(4)
+        .assertResults(duckDbSql);
+  }
+}
+
+TEST_F(DriverTest, fuseOperatorChains) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 20; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row % 13; }),
+         makeFlatVector<int64_t>(100, [&](auto row) { return row + i; })}));
+  }
+  createDuckDbTable(batches);
+
+  core::PlanNodeId projectId;
+  core::PlanNodeId aggregationId;
+  const auto plan = PlanBuilder()
+                        .values(batches)
+                        .filter("c1 % 2 = 0")
+                        .project({"c0", "c1 * 3 AS c1"})
+                        .capturePlanNodeId(projectId)
+                        .partialAggregation({"c0"}, {"sum(c1)"})
+                        .capturePlanNodeId(aggregationId)
+                        .finalAggregation()
+                        .planNode();
+  for (const auto fuse : {false, true}) {
+    SCOPED_TRACE(fmt::format("fuse: {}", fuse));
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kDriverFuseOperatorChains,
+                fuse ? "true" : "false")
+            .assertResults(
+                "SELECT c0, sum(c1 * 3) FROM tmp WHERE c1 % 2 = 0 GROUP BY c0");
+
+    // The stats are kept per operator either way.
+    const auto stats = toPlanStats(task->taskStats());
+    ASSERT_EQ(stats.at(projectId).inputRows, 2'000);
+    ASSERT_EQ(stats.at(projectId).outputRows, 1'000);
+    ASSERT_EQ(stats.at(aggregationId).inputRows, 1'000);
+  }
+}
+
+TEST_F(DriverTest, hardwareCounters) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row; })});
+  core::PlanNodeId projectId;
+  const auto plan = PlanBuilder()
+                        .values({data, data})
+                        .project({"c0 * 2 AS c0"})
+                        .capturePlanNodeId(projectId)
+                        .planNode();
+  auto task =
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kOperatorTrackHardwareCounters, "true")
+          .assertResults(makeRowVector({makeFlatVector<int64_t>(
+              20'000, [](auto row) { return (row % 10'000) * 2; })}));
+  const auto& runtimeStats =
+      toPlanStats(task->taskStats()).at(projectId).customStats;
+  if (!process::PerfCounters::available()) {
+    ASSERT_EQ(runtimeStats.count("hwInstructions"), 0);
+    return;
+  }
+  // Counted for the 2 addInput and at least 2 getOutput calls.
+  ASSERT_GE(runtimeStats.at("hwInstructions").count, 4);
+  ASSERT_GT(runtimeStats.at("hwInstructions").sum, 0);
+  ASSERT_GT(runtimeStats.at("hwCycles").sum, 0);
+  ASSERT_EQ(runtimeStats.count("hwCacheMisses"), 1);
+  ASSERT_EQ(runtimeStats.count("hwBranchMisses"), 1);
+}
+
 namespace {
 
 template <typename T>
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverTimeline.h"
+
+#include <folly/json.h>
+
+#include "velox/exec/Task.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+using State = DriverTimeline::State;
+
+class DriverTimelineTest : public OperatorTestBase {};
+
+TEST_F(DriverTimelineTest, ringBuffer) {
+  DriverTimeline timeline(3);
+  for (auto i = 0; i < 5; ++i) {
+    timeline.record({static_cast<uint64_t>(100 + i), 0, i, State::kRunning});
+  }
+  const auto events = timeline.events();
+  ASSERT_EQ(events.size(), 3);
+  for (auto i = 0; i < 3; ++i) {
+    ASSERT_EQ(events[i].timeUs, 102 + i);
+    ASSERT_EQ(events[i].driverId, 2 + i);
+  }
+}
+
+TEST_F(DriverTimelineTest, chromeTrace) {
+  DriverTimeline timeline(10);
+  timeline.record({100, 0, 0, State::kQueued});
+  timeline.record({110, 0, 0, State::kRunning});
+  timeline.record(
+      {150, 0, 0, State::kBlocked, BlockingReason::kWaitForSplit, 0});
+  timeline.record({120, 1, 0, State::kRunning});
+  timeline.record({170, 1, 0, State::kFinished});
+
+  const auto trace = folly::parseJson(timeline.toChromeTrace());
+  const auto& events = trace["traceEvents"];
+  std::vector<std::string> names;
+  std::vector<std::string> phases;
+  for (const auto& event : events) {
+    if (event["ph"] == "M") {
+      continue;
+    }
+    names.push_back(event["name"].asString());
+    phases.push_back(event["ph"].asString());
+  }
+  ASSERT_EQ(
+      names,
+      std::vector<std::string>(
+          {"queued",
+           "running",
+           "blocked kWaitForSplit",
+           "running",
+           "finished"}));
+  ASSERT_EQ(phases, std::vector<std::string>({"X", "X", "i", "X", "i"}));
+
+  // The running state of driver 0 of pipeline 0 lasts until it blocks.
+  for (const auto& event : events) {
+    if (event["ph"] == "X" && event["pid"] == 0 &&
+        event["name"] == "running") {
+      ASSERT_EQ(event["ts"].asInt(), 110);
+      ASSERT_EQ(event["dur"].asInt(), 40);
+    }
+    if (event["ph"] == "i" && event["pid"] == 0) {
+      ASSERT_EQ(event["args"]["operatorId"].asInt(), 0);
+    }
+  }
+}
+
+TEST_F(DriverTimelineTest, query) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row % 3; }),
+         makeFlatVector<int64_t>(100, [i](auto row) { return row + i; })}));
+  }
+  createDuckDbTable(batches);
+  const auto plan = PlanBuilder()
+                        .values(batches, true)
+                        .partialAggregation({"c0"}, {"sum(c1)"})
+                        .localPartition({"c0"})
+                        .finalAggregation()
+                        .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .maxDrivers(2)
+                  .assertResults("SELECT c0, sum(c1) * 2 FROM tmp GROUP BY c0");
+  ASSERT_EQ(task->driverTimeline(), nullptr);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(core::QueryConfig::kDriverTimelineCapacity, "1000")
+             .maxDrivers(2)
+             .assertResults("SELECT c0, sum(c1) * 2 FROM tmp GROUP BY c0");
+  auto* timeline = task->driverTimeline();
+  ASSERT_NE(timeline, nullptr);
+
+  // Each of the 2 drivers of the 2 pipelines is queued, runs and finishes.
+  std::map<std::pair<int32_t, int32_t>, std::vector<State>> states;
+  for (const auto& event : timeline->events()) {
+    states[{event.pipelineId, event.driverId}].push_back(event.state);
+  }
+  ASSERT_EQ(states.size(), 4);
+  for (const auto& [id, driverStates] : states) {
+    ASSERT_GE(driverStates.size(), 3);
+    ASSERT_EQ(driverStates.front(), State::kQueued);
+    ASSERT_EQ(driverStates[1], State::kRunning);
+    ASSERT_EQ(driverStates.back(), State::kFinished);
+  }
+  ASSERT_NO_THROW(folly::parseJson(timeline->toChromeTrace()));
+}
+
+} // namespace facebook::velox::exec::test
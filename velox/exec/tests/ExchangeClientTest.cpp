@@ -13,9 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/executors/ManualExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -28,6 +30,121 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Serves 'numPages' pages of 'pageSize' bytes. A fast source answers data
+// requests right away. A slow source answers only when respond() is called.
+class TestingPagedExchangeSource : public ExchangeSource {
+ public:
+  TestingPagedExchangeSource(
+      const std::string& taskId,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool,
+      int32_t numPages,
+      int64_t pageSize,
+      bool fast)
+      : ExchangeSource(taskId, 0, std::move(queue), pool),
+        pageSize_(pageSize),
+        fast_(fast),
+        numPages_(numPages) {}
+
+  bool shouldRequestLocked() override {
+    if (atEnd_ || requestPending_) {
+      return false;
+    }
+    requestPending_ = true;
+    return true;
+  }
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      std::chrono::microseconds /*maxWait*/) override {
+    std::lock_guard<std::mutex> l(mutex_);
+    requestedBytes_.push_back(maxBytes);
+    if (fast_) {
+      return folly::makeSemiFuture(makeResponse(maxBytes));
+    }
+    VELOX_CHECK(!promise_.has_value());
+    promise_.emplace();
+    pendingBytes_ = maxBytes;
+    return promise_->getSemiFuture();
+  }
+
+  folly::SemiFuture<Response> requestDataSizes(
+      std::chrono::microseconds /*maxWait*/) override {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    return folly::makeSemiFuture(
+        Response{0, false, std::vector<int64_t>(numPages_, pageSize_)});
+  }
+
+  void close() override {}
+
+  folly::F14FastMap<std::string, int64_t> stats() const override {
+    return {};
+  }
+
+  // Answers the pending request of a slow source, if any. Returns false if
+  // there is none.
+  bool respond() {
+    std::optional<folly::Promise<Response>> promise;
+    int64_t maxBytes;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (!promise_.has_value()) {
+        return false;
+      }
+      promise.swap(promise_);
+      maxBytes = pendingBytes_;
+    }
+    promise->setValue(makeResponse(maxBytes));
+    return true;
+  }
+
+  std::vector<int64_t> requestedBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return requestedBytes_;
+  }
+
+ private:
+  // Enqueues the pages that fit in 'maxBytes' and returns the response for
+  // them.
+  Response makeResponse(int64_t maxBytes) {
+    std::vector<ContinuePromise> promises;
+    int32_t numPages;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      numPages = std::min<int64_t>(numPages_, maxBytes / pageSize_);
+      for (auto i = 0; i < numPages; ++i) {
+        auto ioBuf = folly::IOBuf::create(pageSize_);
+        ioBuf->append(pageSize_);
+        queue_->enqueueLocked(
+            std::make_unique<SerializedPage>(std::move(ioBuf)), promises);
+      }
+      numPages_ -= numPages;
+      atEnd_ = numPages_ == 0;
+      if (atEnd_) {
+        queue_->enqueueLocked(nullptr, promises);
+      }
+      requestPending_ = false;
+    }
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+    return Response{
+        numPages * pageSize_,
+        atEnd_,
+        std::vector<int64_t>(numPages_, pageSize_)};
+  }
+
+  const int64_t pageSize_;
+  const bool fast_;
+  int32_t numPages_;
+
+  mutable std::mutex mutex_;
+  std::vector<int64_t> requestedBytes_;
+  std::optional<folly::Promise<Response>> promise_;
+  int64_t pendingBytes_{0};
+};
+
 class ExchangeClientTest : public testing::Test,
                            public velox::test::VectorTestBase {
  protected:
@@ -266,6 +383,109 @@ TEST_F(ExchangeClientTest, flowControl) {
   client->close();
 }
 
+TEST_F(ExchangeClientTest, sourceCredits) {
+  constexpr int64_t kPageSize = 1'000;
+  constexpr int32_t kNumPages = 30;
+  std::shared_ptr<TestingPagedExchangeSource> fastSource;
+  std::shared_ptr<TestingPagedExchangeSource> slowSource;
+  exec::ExchangeSource::registerFactory(
+      [&](const auto& taskId, auto /*destination*/, auto queue, auto pool)
+          -> std::shared_ptr<ExchangeSource> {
+        auto source = std::make_shared<TestingPagedExchangeSource>(
+            taskId, queue, pool, kNumPages, kPageSize, taskId == "fast");
+        (taskId == "fast" ? fastSource : slowSource) = source;
+        return source;
+      });
+
+  // Runs the response callbacks only when drained, so that the order of
+  // requests does not depend on timing.
+  folly::ManualExecutor executor;
+  auto client = std::make_shared<ExchangeClient>(
+      "test", 0, 10 * kPageSize, pool(), &executor);
+  client->addRemoteTaskId("fast");
+  client->addRemoteTaskId("slow");
+  client->noMoreRemoteTasks();
+
+  // Both sources report their pages. Without throughput estimates the fast
+  // source, which reports first, gets the whole buffer and answers at once.
+  executor.drain();
+  ASSERT_EQ(fastSource->requestedBytes(), std::vector<int64_t>{10 * kPageSize});
+  ASSERT_TRUE(slowSource->requestedBytes().empty());
+
+  // Once the buffer is free, the slow source is capped at an even share.
+  bool atEnd;
+  ContinueFuture future;
+  auto pages = client->next(1 << 20, &atEnd, &future);
+  int32_t numReceivedPages = pages.size();
+  ASSERT_EQ(numReceivedPages, 10);
+  ASSERT_EQ(slowSource->requestedBytes(), std::vector<int64_t>{5 * kPageSize});
+  ASSERT_EQ(client->stats().at("numCreditLimitedRequests").sum, 1);
+
+  // Consume everything. The fast source answers in the first drain, the slow
+  // one only after a delay.
+  for (auto i = 0; !atEnd; ++i) {
+    ASSERT_LT(i, 1'000);
+    executor.drain();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    if (slowSource->respond()) {
+      executor.drain();
+    }
+    pages = client->next(1 << 20, &atEnd, &future);
+    numReceivedPages += pages.size();
+  }
+  ASSERT_EQ(numReceivedPages, 2 * kNumPages);
+
+  // Every request asks for at least one page.
+  for (const auto& source : {fastSource, slowSource}) {
+    for (auto bytes : source->requestedBytes()) {
+      ASSERT_GE(bytes, kPageSize);
+    }
+  }
+  ASSERT_GT(client->stats().at("numCreditLimitedRequests").sum, 0);
+
+  client->close();
+  executor.drain();
+  fastSource.reset();
+  slowSource.reset();
+}
+
+TEST_F(ExchangeClientTest, inProcessExchangeSource) {
+  exec::ExchangeSource::registerFactory(InProcessExchangeSource::create);
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutputArbitrary()
+                  .planNode();
+  const auto taskId = InProcessExchangeSource::kScheme + "producer";
+  auto task = makeTask(taskId, plan);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kArbitrary, 1, 1);
+  int64_t enqueuedBytes{0};
+  for (auto i = 0; i < 3; ++i) {
+    enqueuedBytes += enqueue(taskId, 0, data);
+  }
+
+  auto client =
+      std::make_shared<ExchangeClient>("test", 0, 1 << 20, pool(), executor());
+  client->addRemoteTaskId(taskId);
+  const auto pages = fetchPages(*client, 3);
+  int64_t receivedBytes{0};
+  for (const auto& page : pages) {
+    receivedBytes += page->size();
+  }
+  ASSERT_EQ(enqueuedBytes, receivedBytes);
+
+  const auto stats = client->stats();
+  ASSERT_EQ(3, stats.at("inProcessExchangeSource.numPages").sum);
+  ASSERT_EQ(enqueuedBytes, stats.at("inProcessExchangeSource.totalBytes").sum);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+  client->close();
+}
+
 TEST_F(ExchangeClientTest, largeSinglePage) {
   auto data = {
       makeRowVector({makeFlatVector<int64_t>(10000, folly::identity)}),
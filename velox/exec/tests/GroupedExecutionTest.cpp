@@ -312,6 +312,63 @@ TEST_F(GroupedExecutionTest, groupedExecutionWithOutputBuffer) {
   EXPECT_EQ(18, taskStats.pipelineStats[1].operatorStats[1].inputVectors);
 }
 
+TEST_F(GroupedExecutionTest, splitGroupMemoryBudget) {
+  auto vectors = makeVectors(4, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+
+  // A budget that fits no split group and one that fits all.
+  for (const uint64_t budget : {uint64_t{1}, uint64_t{1} << 40}) {
+    SCOPED_TRACE(fmt::format("budget: {}", budget));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId tableScanNodeId;
+    auto planFragment = PlanBuilder(planNodeIdGenerator)
+                            .tableScan(rowType_)
+                            .capturePlanNodeId(tableScanNodeId)
+                            .singleAggregation({"c0"}, {"count(1)"})
+                            .partitionedOutput({}, 1)
+                            .planFragment();
+    planFragment.executionStrategy = core::ExecutionStrategy::kGrouped;
+    planFragment.groupedExecutionLeafNodeIds.emplace(tableScanNodeId);
+    planFragment.numSplitGroups = 4;
+    auto queryCtx = core::QueryCtx::create(
+        executor_.get(),
+        core::QueryConfig{
+            {{core::QueryConfig::kSplitGroupMemoryBudget,
+              std::to_string(budget)}}});
+    auto task = exec::Task::create(
+        "0",
+        std::move(planFragment),
+        0,
+        std::move(queryCtx),
+        Task::ExecutionMode::kParallel);
+    // 1 driver per split group and up to 3 concurrent split groups.
+    task->start(1, 3);
+    for (auto group = 0; group < 4; ++group) {
+      task->addSplit("0", makeHiveSplitWithGroup(filePath->getPath(), group));
+    }
+
+    // No split group completed, so only one runs.
+    EXPECT_EQ(1, task->numRunningDrivers());
+
+    // The other 3 split groups run if they fit in the budget.
+    task->noMoreSplitsForGroup("0", 0);
+    waitForFinishedDrivers(task, 1);
+    EXPECT_EQ(std::unordered_set<int32_t>({0}), getCompletedSplitGroups(task));
+    EXPECT_EQ(budget == 1 ? 1 : 3, task->numRunningDrivers());
+
+    for (auto group = 1; group < 4; ++group) {
+      task->noMoreSplitsForGroup("0", group);
+    }
+    task->noMoreSplits("0");
+    waitForFinishedDrivers(task, 4);
+    EXPECT_EQ(0, task->numRunningDrivers());
+    auto outputBufferManager = exec::OutputBufferManager::getInstance().lock();
+    outputBufferManager->deleteResults(task->taskId(), 0);
+    EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  }
+}
+
 DEBUG_ONLY_TEST_F(
     GroupedExecutionTest,
     groupedExecutionWithHashJoinSpillCheck) {
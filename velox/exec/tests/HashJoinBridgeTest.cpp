@@ -612,6 +612,43 @@ TEST(HashJoinBridgeTest, hashJoinTableSpillType) {
         hashJoinTableSpillType(tableType, testData.joinType);
     ASSERT_TRUE(spillType->equivalent(*testData.expectedTableSpillType));
     ASSERT_EQ(spillType->names(), testData.expectedTableSpillType->names());
+    ASSERT_TRUE(isHashJoinTableSpillType(spillType, testData.joinType));
+    ASSERT_FALSE(isHashJoinTableSerializedSpillType(spillType));
+  }
+}
+
+TEST(HashJoinBridgeTest, hashJoinTableSerializedSpillType) {
+  const RowTypePtr tableType = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  struct {
+    core::JoinType joinType;
+    RowTypePtr expectedTableSpillType;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinType: {}, expectedTableSpillType: {}",
+          joinTypeName(joinType),
+          expectedTableSpillType->toString());
+    }
+  } testSettings[] = {
+      {core::JoinType::kFull,
+       ROW({"k1", "k2", "__probedFlag", "__serializedRow"},
+           {BIGINT(), VARCHAR(), BOOLEAN(), VARBINARY()})},
+      {core::JoinType::kLeft,
+       ROW({"k1", "k2", "__serializedRow"},
+           {BIGINT(), VARCHAR(), VARBINARY()})},
+      {core::JoinType::kAnti, tableType}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    const RowTypePtr spillType =
+        hashJoinTableSpillType(tableType, testData.joinType, true);
+    ASSERT_TRUE(spillType->equivalent(*testData.expectedTableSpillType));
+    ASSERT_EQ(spillType->names(), testData.expectedTableSpillType->names());
+    ASSERT_TRUE(isHashJoinTableSpillType(spillType, testData.joinType));
+    ASSERT_EQ(
+        isHashJoinTableSerializedSpillType(spillType),
+        testData.joinType != core::JoinType::kAnti);
   }
 }
 } // namespace facebook::velox::exec::test
@@ -24,6 +24,7 @@
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/ArbitratorTestUtil.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -180,6 +181,26 @@ int32_t maxHashBuildSpillLevel(const exec::Task& task) {
   return maxSpillLevel;
 }
 
+// Returns the number of hash build spilled rows by spill level of 'task'.
+std::map<int32_t, int64_t> hashBuildSpilledRowsByLevel(const exec::Task& task) {
+  std::map<int32_t, int64_t> spilledRows;
+  for (auto& pipelineStat : task.taskStats().pipelineStats) {
+    for (auto& operatorStat : pipelineStat.operatorStats) {
+      if (operatorStat.operatorType != "HashBuild") {
+        continue;
+      }
+      for (int32_t level = 0; level <= 4; ++level) {
+        const auto it = operatorStat.runtimeStats.find(
+            Operator::kSpilledRowsAtLevel + std::to_string(level));
+        if (it != operatorStat.runtimeStats.end()) {
+          spilledRows[level] += it->second.sum;
+        }
+      }
+    }
+  }
+  return spilledRows;
+}
+
 std::pair<int32_t, int32_t> numTaskSpillFiles(const exec::Task& task) {
   int32_t numBuildFiles = 0;
   int32_t numProbeFiles = 0;
@@ -692,6 +713,16 @@ class HashJoinBuilder {
         if (maxSpillLevel != -1) {
           ASSERT_EQ(maxHashBuildSpillLevel(*task), maxSpillLevel);
         }
+        const auto spilledRowsByLevel = hashBuildSpilledRowsByLevel(*task);
+        ASSERT_GT(spilledRowsByLevel.count(0), 0);
+        int64_t totalSpilledRowsByLevel{0};
+        for (const auto& [level, rows] : spilledRowsByLevel) {
+          if (maxSpillLevel != -1) {
+            ASSERT_LE(level, maxSpillLevel);
+          }
+          totalSpilledRowsByLevel += rows;
+        }
+        ASSERT_LE(totalSpilledRowsByLevel, statsPair.first.spilledRows);
         verifyTaskSpilledRuntimeStats(*task, true);
       }
       if (statsPair.first.spilledBytes > 0 &&
@@ -3235,6 +3266,48 @@ TEST_P(MultiThreadedHashJoinTest, noSpillLevelLimit) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, serializedRowsSpill) {
+  struct {
+    core::JoinType joinType;
+    std::string joinClause;
+
+    std::string debugString() const {
+      return fmt::format("joinType: {}", joinTypeName(joinType));
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner, "INNER JOIN"},
+      {core::JoinType::kLeft, "LEFT JOIN"},
+      {core::JoinType::kFull, "FULL OUTER JOIN"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT(), VARCHAR()})
+        .probeVectors(1600, 5)
+        .buildVectors(1500, 5)
+        .joinType(testData.joinType)
+        .joinOutputLayout({"t_k0", "t_k1", "t_data", "u_k0", "u_k1", "u_data"})
+        .referenceQuery(fmt::format(
+            "SELECT t_k0, t_k1, t_data, u_k0, u_k1, u_data FROM t {} u "
+            "ON t.t_k0 = u.u_k0 AND t.t_k1 = u.u_k1",
+            testData.joinClause))
+        .maxSpillLevel(-1)
+        .config(core::QueryConfig::kSpillStartPartitionBit, "48")
+        .config(core::QueryConfig::kSpillNumPartitionBits, "3")
+        .config(core::QueryConfig::kJoinSpillSerializedRows, "true")
+        .checkSpillStats(false)
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          if (!hasSpill) {
+            return;
+          }
+          // The restored partitions are spilled again at the next levels.
+          ASSERT_GT(maxHashBuildSpillLevel(*task), 0);
+        })
+        .run();
+  }
+}
+
 // Verify that dynamic filter pushed down from null-aware right semi project
 // join into table scan doesn't filter out nulls.
 TEST_F(HashJoinTest, nullAwareRightSemiProjectOverScan) {
@@ -4774,6 +4847,168 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, sharedHashTableAcrossTasks) {
+  const int32_t numTasks = 4;
+  auto probeVectors = makeBatches(10, [&](int32_t /*unused*/) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 300; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    });
+  });
+  auto buildVectors = makeBatches(5, [&](int32_t batch) {
+    return makeRowVector(
+        {"u0", "u1"},
+        {
+            makeFlatVector<int32_t>(
+                100, [&](auto row) { return row + batch * 100; }),
+            makeFlatVector<int64_t>(100, [](auto row) { return row * 10; }),
+        });
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors, true)
+                    .hashJoin(
+                        {"c0"},
+                        {"u0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors, true)
+                            .planNode(),
+                        "",
+                        {"c0", "c1", "u1"},
+                        joinType,
+                        false,
+                        true)
+                    .planNode();
+    const auto duckDbSql = fmt::format(
+        "SELECT t.c0, t.c1, u.u1 FROM t {} JOIN u ON t.c0 = u.u0",
+        joinType == core::JoinType::kInner ? "INNER" : "LEFT");
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(2)
+        .assertResults(duckDbSql);
+    waitForAllTasksToBeDeleted();
+    ASSERT_EQ(HashTableCache::instance()->numEntries(), 0);
+
+    // The tasks of the same query share one copy of the build side.
+    auto queryCtx = core::QueryCtx::create(driverExecutor_.get());
+    std::vector<RowVectorPtr> results(numTasks);
+    std::vector<std::thread> threads;
+    threads.reserve(numTasks);
+    for (int32_t i = 0; i < numTasks; ++i) {
+      threads.emplace_back([&, i]() {
+        results[i] = AssertQueryBuilder(plan)
+                         .queryCtx(queryCtx)
+                         .maxDrivers(2)
+                         .copyResults(pool_.get());
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (const auto& result : results) {
+      assertResults(
+          {result}, plan->outputType(), duckDbSql, duckDbQueryRunner_);
+    }
+    waitForAllTasksToBeDeleted();
+    ASSERT_EQ(HashTableCache::instance()->numEntries(), 0);
+  }
+}
+
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 1'000;
+  // More distinct build keys than VectorHasher tracks, so there is no exact
+  // dynamic filter.
+  const int32_t numRowsBuild = 2 * VectorHasher::kMaxDistinct;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    // Every 10th probe row has a match.
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe,
+            [&](auto row) {
+              const auto key = (row + i * numRowsProbe) * 1'000'003L;
+              return row % 10 == 0 ? key : key + 1;
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->getPath(), rowVector);
+  }
+
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u_c0", "u_c1"},
+      {makeFlatVector<int64_t>(
+           numRowsBuild, [](auto row) { return row * 1'000'003L; }),
+       makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; })})};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  core::PlanNodeId joinId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(probeType)
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values(buildVectors)
+                        .planNode(),
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .capturePlanNodeId(joinId)
+                .planNode();
+
+  SplitInput splitInput;
+  for (const auto& file : tempFiles) {
+    splitInput[probeScanId].emplace_back(
+        makeHiveConnectorSplit(file->getPath()));
+  }
+
+  for (const auto bloomFilterMaxSize : {0, 16 << 20}) {
+    SCOPED_TRACE(fmt::format("bloomFilterMaxSize: {}", bloomFilterMaxSize));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .config(
+            core::QueryConfig::kHashJoinBloomFilterMaxSize,
+            std::to_string(bloomFilterMaxSize))
+        .inputSplits(splitInput)
+        .referenceQuery(
+            "SELECT t.c0, t.c1, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          if (hasSpill || bloomFilterMaxSize == 0) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            // The join is not replaced because the Bloom filter is not exact.
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            ASSERT_LT(
+                getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+            auto planStats = toPlanStats(task->taskStats());
+            ASSERT_EQ(
+                planStats.at(probeScanId).dynamicFilterStats.producerNodeIds,
+                std::unordered_set<core::PlanNodeId>({joinId}));
+          }
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersStatsWithChainedJoins) {
   const int32_t numSplits = 10;
   const int32_t numProbeRows = 333;
@@ -5316,6 +5551,54 @@ TEST_F(HashJoinTest, spillFileSize) {
   }
 }
 
+TEST_F(HashJoinTest, spillRestoreInChunks) {
+  struct {
+    core::JoinType joinType;
+    std::string referenceQuery;
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t.t_k0 = u.u_k0"},
+      {core::JoinType::kRight,
+       "SELECT t_k0, t_data, u_k0, u_data FROM t "
+       "RIGHT JOIN u ON t.t_k0 = u.u_k0"}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(core::joinTypeName(testData.joinType));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .keyTypes({BIGINT()})
+        .probeVectors(100, 3)
+        .buildVectors(100, 3)
+        .joinType(testData.joinType)
+        .referenceQuery(testData.referenceQuery)
+        .config(core::QueryConfig::kSpillStartPartitionBit, "48")
+        .config(core::QueryConfig::kSpillNumPartitionBits, "3")
+        // Spill each batch into a separate file and restore the partitions,
+        // which can't be spilled again with max spill level of 0, one file at
+        // a time.
+        .config(core::QueryConfig::kMaxSpillFileSize, "1")
+        .config(core::QueryConfig::kHashJoinSpillRestoreChunkBytes, "1")
+        .checkSpillStats(false)
+        .maxSpillLevel(0)
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          if (!hasSpill) {
+            return;
+          }
+          int64_t numRestoreChunks = 0;
+          for (auto& pipelineStat : task->taskStats().pipelineStats) {
+            for (auto& operatorStat : pipelineStat.operatorStats) {
+              if (operatorStat.operatorType == "HashProbe" &&
+                  operatorStat.runtimeStats.count("spillRestoreChunks") != 0) {
+                numRestoreChunks +=
+                    operatorStat.runtimeStats["spillRestoreChunks"].sum;
+              }
+            }
+          }
+          ASSERT_GT(numRestoreChunks, 0);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, spillPartitionBitsOverlap) {
   auto builder =
       HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
@@ -120,6 +120,48 @@ TEST_F(HashPartitionFunctionTest, function) {
   }
 }
 
+TEST_F(HashPartitionFunctionTest, spreadHotKeys) {
+  const int numPartitions = 8;
+  const int numRows = 99'999;
+  // A third of the rows have key 0.
+  auto vector = makeRowVector({makeFlatVector<int64_t>(
+      numRows, [](auto row) { return row % 3 == 0 ? 0 : row; })});
+  auto rowType = asRowType(vector->type());
+
+  std::vector<uint32_t> hashPartitions;
+  HashPartitionFunction hashFunction(numPartitions, rowType, {0});
+  hashFunction.partition(*vector, hashPartitions);
+  ASSERT_EQ(hashFunction.numHotKeyRows(), 0);
+
+  std::vector<uint32_t> spreadPartitions;
+  HashPartitionFunction spreadFunction(
+      numPartitions, rowType, {0}, {}, true /*spreadHotKeys*/);
+  spreadFunction.partition(*vector, spreadPartitions);
+  ASSERT_EQ(spreadFunction.numHotKeyRows(), numRows / 3);
+
+  std::vector<int32_t> partitionSizes(numPartitions);
+  for (auto row = 0; row < numRows; ++row) {
+    ++partitionSizes[spreadPartitions[row]];
+    if (row % 3 != 0) {
+      // Rows without the hot key keep their hash partition.
+      ASSERT_EQ(hashPartitions[row], spreadPartitions[row]);
+    }
+  }
+  for (auto size : partitionSizes) {
+    EXPECT_LT(size, 2 * numRows / numPartitions);
+  }
+
+  // Too few rows to detect hot keys.
+  auto smallVector = makeRowVector({makeFlatVector<int64_t>(
+      HashPartitionFunction::kHotKeySampleStride *
+          (HashPartitionFunction::kMinHotKeySampledRows - 1),
+      [](auto /*row*/) { return 0; })});
+  HashPartitionFunction smallFunction(
+      numPartitions, rowType, {0}, {}, true /*spreadHotKeys*/);
+  smallFunction.partition(*smallVector, spreadPartitions);
+  ASSERT_EQ(smallFunction.numHotKeyRows(), 0);
+}
+
 TEST_F(HashPartitionFunctionTest, spec) {
   Type::registerSerDe();
   core::ITypedExpr::registerSerDe();
@@ -157,6 +199,20 @@ TEST_F(HashPartitionFunctionTest, spec) {
     auto copy = HashPartitionFunctionSpec::deserialize(serialized, pool());
     ASSERT_EQ(hashSpec->toString(), copy->toString());
   }
+
+  // The test case with hot key spreading.
+  {
+    auto hashSpec = std::make_unique<exec::HashPartitionFunctionSpec>(
+        inputType,
+        std::vector<column_index_t>{0, 1},
+        std::vector<VectorPtr>{},
+        true);
+    ASSERT_EQ("HASH(c0, c1) SPREAD_HOT_KEYS", hashSpec->toString());
+
+    auto copy =
+        HashPartitionFunctionSpec::deserialize(hashSpec->serialize(), pool());
+    ASSERT_EQ(hashSpec->toString(), copy->toString());
+  }
 }
 
 TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
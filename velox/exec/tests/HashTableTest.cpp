@@ -156,6 +156,7 @@ class HashTableTest : public testing::TestWithParam<bool>,
         topTable_->estimateHashTableSize(numRows);
     const uint64_t usedMemoryBytes = topTable_->rows()->pool()->usedBytes();
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setRadixPartitionedProbe(radixPartitionedProbe_);
     ASSERT_GE(
         estimatedTableSize,
         topTable_->rows()->pool()->usedBytes() - usedMemoryBytes);
@@ -567,6 +568,8 @@ class HashTableTest : public testing::TestWithParam<bool>,
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Enables radix partitioning of the probe rows by table region.
+  bool radixPartitionedProbe_ = false;
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -617,6 +620,24 @@ TEST_P(HashTableTest, mixed6Sparse) {
           {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
   keySpacing_ = 1000;
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
+  // The table is larger than the cache, so is probed with group prefetch.
+  ASSERT_GT(topTable_->stats().numPrefetchProbes, 0);
+}
+
+TEST_P(HashTableTest, mixed6SparseRadixPartitionedProbe) {
+  auto type =
+      ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  radixPartitionedProbe_ = true;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 5, type, 6);
+}
+
+TEST_P(HashTableTest, int2SparseNormalizedRadixPartitionedProbe) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  radixPartitionedProbe_ = true;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
 }
 
 // It should be safe to call clear() before we insert any data into HashTable
@@ -702,6 +723,61 @@ TEST_P(HashTableTest, bestWithReserveOverflow) {
   }
 }
 
+TEST_P(HashTableTest, twoWordNormalizedKey) {
+  auto rowType =
+      ROW({"a", "b", "c", "d"}, {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  const auto numKeys = 4;
+  auto table = createHashTableForAggregation(rowType, numKeys);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+
+  // Neither the ranges nor the 60K distinct values per key with reserve fit
+  // in 64 bits when combined: 90K ^ 4 > 2 ^ 64. The first 3 keys fit in one
+  // word and the last one in another.
+  const vector_size_t numRows = 60'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          numRows, [](auto row) { return row * 1'000'000'000'000L; }),
+      makeFlatVector<int64_t>(
+          numRows, [](auto row) { return 1 + row * 1'000'000'000'000L; }),
+      makeFlatVector<int64_t>(
+          numRows, [](auto row) { return 2 + row * 1'000'000'000'000L; }),
+      makeFlatVector<int64_t>(
+          numRows,
+          [](auto row) { return 3 + (row / 2) * 1'000'000'000'000L; }),
+  });
+
+  auto probe = [&]() {
+    SelectivityVector rows(numRows);
+    table->prepareForGroupProbe(
+        *lookup,
+        data,
+        rows,
+        false,
+        BaseHashTable::kNoSpillInputStartPartitionBit);
+    table->groupProbe(*lookup);
+  };
+  probe();
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
+  ASSERT_TRUE(table->hasTwoWordNormalizedKeys());
+  ASSERT_EQ(table->numDistinct(), numRows);
+  ASSERT_EQ(lookup->newGroups.size(), numRows);
+  const auto firstHits = lookup->hits;
+
+  // Probing the same keys again finds the same groups.
+  probe();
+  ASSERT_TRUE(table->hasTwoWordNormalizedKeys());
+  ASSERT_EQ(table->numDistinct(), numRows);
+  ASSERT_TRUE(lookup->newGroups.empty());
+  for (auto row = 0; row < numRows; ++row) {
+    ASSERT_EQ(lookup->hits[row], firstHits[row]);
+  }
+
+  // Keys of 2 parts never get two word normalized keys.
+  auto twoKeyTable =
+      createHashTableForAggregation(ROW({"a", "b"}, {BIGINT(), BIGINT()}), 2);
+  ASSERT_EQ(twoKeyTable->rows()->numNormalizedKeyWords(), 1);
+}
+
 /// Test edge case that used to trigger a rounding error in
 /// HashTable::enableRangeWhereCan.
 TEST_P(HashTableTest, enableRangeWhereCan) {
@@ -1104,6 +1180,147 @@ TEST_P(HashTableTest, toStringMultipleKeys) {
   ASSERT_NO_THROW(table->toString());
 }
 
+TEST_P(HashTableTest, arrayJoinLayout) {
+  // Build keys 0..999, each 3 times. Probe keys 0..1999.
+  auto buildData = makeRowVector({
+      makeFlatVector<int64_t>(3'000, [](auto row) { return row % 1'000; }),
+  });
+  auto probeData = makeRowVector({
+      makeFlatVector<int64_t>(2'000, [](auto row) { return row; }),
+  });
+
+  auto probe = [&](BaseHashTable& table, HashLookup& lookup) {
+    lookup.reset(probeData->size());
+    SelectivityVector rows(probeData->size());
+    VectorHasher::ScratchMemory scratchMemory;
+    table.hashers()[0]->lookupValueIds(
+        *probeData->childAt(0), rows, scratchMemory, lookup.hashes);
+    lookup.rows.clear();
+    rows.applyToSelected([&](auto row) { lookup.rows.push_back(row); });
+    std::fill(lookup.hits.begin(), lookup.hits.end(), nullptr);
+    table.joinProbe(lookup);
+  };
+
+  for (const bool matchOnly : {false, true}) {
+    SCOPED_TRACE(fmt::format("matchOnly {}", matchOnly));
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    auto table = HashTable<true>::createForJoin(
+        std::move(hashers),
+        {}, /*dependentTypes*/
+        !matchOnly /*allowDuplicates*/,
+        false /*hasProbedFlag*/,
+        1 /*minTableSizeForParallelJoinBuild*/,
+        pool());
+    if (matchOnly) {
+      table->setMatchOnlyJoin();
+    }
+    store(*table->rows(), buildData);
+    table->prepareJoinTable({});
+    ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kArray);
+    ASSERT_EQ(table->hasArrayMatchBits(), matchOnly);
+    ASSERT_EQ(table->hasArrayDuplicateOffsets(), !matchOnly);
+
+    HashLookup lookup(table->hashers());
+    probe(*table, lookup);
+    for (auto row = 0; row < probeData->size(); ++row) {
+      ASSERT_EQ(lookup.hits[row] != nullptr, row < 1'000);
+    }
+    if (matchOnly) {
+      continue;
+    }
+
+    BaseHashTable::JoinResultIterator iter;
+    iter.reset(lookup);
+    std::vector<vector_size_t> inputRows(100);
+    std::vector<char*> hits(100);
+    std::vector<int32_t> numMatches(probeData->size());
+    auto keys = BaseVector::create<FlatVector<int64_t>>(BIGINT(), 100, pool());
+    while (!iter.atEnd()) {
+      const auto numOut = table->listJoinResults(
+          iter,
+          false,
+          folly::Range(inputRows.data(), inputRows.size()),
+          folly::Range(hits.data(), hits.size()),
+          RowContainer::kUnlimited);
+      table->rows()->extractColumn(hits.data(), numOut, 0, keys);
+      for (auto i = 0; i < numOut; ++i) {
+        ASSERT_EQ(keys->valueAt(i), inputRows[i]);
+        ++numMatches[inputRows[i]];
+      }
+    }
+    for (auto row = 0; row < probeData->size(); ++row) {
+      ASSERT_EQ(numMatches[row], row < 1'000 ? 3 : 0);
+    }
+  }
+}
+
+TEST_P(HashTableTest, listJoinResultsMaxBytes) {
+  // 10 keys with 100 build rows each and a 100 byte string payload.
+  auto buildData = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 10; }),
+      makeFlatVector<std::string>(
+          1'000, [](auto /*row*/) { return std::string(100, 'x'); }),
+  });
+  auto probeKeys = makeFlatVector<int64_t>(10, folly::identity);
+
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+  auto table = HashTable<true>::createForJoin(
+      std::move(hashers),
+      {VARCHAR()}, /*dependentTypes*/
+      true /*allowDuplicates*/,
+      false /*hasProbedFlag*/,
+      1 /*minTableSizeForParallelJoinBuild*/,
+      pool());
+  store(*table->rows(), buildData);
+  table->prepareJoinTable({});
+
+  HashLookup lookup(table->hashers());
+  lookup.reset(probeKeys->size());
+  SelectivityVector rows(probeKeys->size());
+  VectorHasher::ScratchMemory scratchMemory;
+  ASSERT_TRUE(table->hashers()[0]->lookupValueIds(
+      *probeKeys, rows, scratchMemory, lookup.hashes));
+  std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
+  table->joinProbe(lookup);
+
+  const auto listAll = [&](BaseHashTable::JoinResultIterator& iter,
+                           uint64_t maxBytes,
+                           int32_t maxRowsPerCall) {
+    iter.reset(lookup);
+    std::vector<vector_size_t> inputRows(100);
+    std::vector<char*> hits(100);
+    int32_t numResults = 0;
+    while (!iter.atEnd()) {
+      const auto numOut = table->listJoinResults(
+          iter,
+          false,
+          folly::Range(inputRows.data(), inputRows.size()),
+          folly::Range(hits.data(), hits.size()),
+          maxBytes);
+      ASSERT_LE(numOut, maxRowsPerCall);
+      numResults += numOut;
+    }
+    ASSERT_EQ(numResults, 1'000);
+  };
+
+  {
+    SCOPED_TRACE("variable width");
+    BaseHashTable::JoinResultIterator iter;
+    iter.varSizeListColumns = {1};
+    listAll(iter, 1'000, 10);
+    listAll(iter, RowContainer::kUnlimited, 100);
+  }
+  {
+    SCOPED_TRACE("fixed width");
+    BaseHashTable::JoinResultIterator iter;
+    iter.fixedSizeListColumns = sizeof(int64_t);
+    listAll(iter, 80, 10);
+    listAll(iter, 1, 1);
+  }
+}
+
 TEST(HashTableTest, tableInsertPartitionInfo) {
   std::vector<char*> overflows;
   const auto testFn = [&](PartitionBoundIndexType start,
@@ -285,6 +285,58 @@ TEST_F(LocalPartitionTest, maxBufferSizePartition) {
   verifyExchangeSourceOperatorStats(task, 2100, 42);
 }
 
+TEST_F(LocalPartitionTest, minBatchRows) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 21; i++) {
+    vectors.emplace_back(makeRowVector({makeFlatVector<int32_t>(
+        100, [i](auto row) { return -71 + i * 10 + row; })}));
+  }
+
+  createDuckDbTable(vectors);
+
+  auto filePaths = writeToFiles(vectors);
+
+  auto rowType = asRowType(vectors[0]->type());
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+  std::vector<core::PlanNodeId> scanNodeIds;
+
+  auto scanNode = [&]() {
+    auto node = PlanBuilder(planNodeIdGenerator).tableScan(rowType).planNode();
+    scanNodeIds.push_back(node->id());
+    return node;
+  };
+
+  auto op = PlanBuilder(planNodeIdGenerator)
+                .localPartition(
+                    {"c0"},
+                    {
+                        scanNode(),
+                        scanNode(),
+                        scanNode(),
+                    })
+                .partialAggregation({"c0"}, {"count(1)"})
+                .planNode();
+
+  AssertQueryBuilder queryBuilder(op, duckDbQueryRunner_);
+  queryBuilder.maxDrivers(2);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    queryBuilder.split(
+        scanNodeIds[i % 3], makeHiveConnectorSplit(filePaths[i]->getPath()));
+  }
+  queryBuilder.config(core::QueryConfig::kLocalExchangeMinBatchRows, "300");
+  auto task =
+      queryBuilder.assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+
+  // Each input vector is split in 2 partitions of about 50 rows. These are
+  // accumulated into batches of at least 300 rows except for the last batch
+  // of each producer and partition.
+  auto stats = task->taskStats().pipelineStats[0].operatorStats.front();
+  ASSERT_EQ(stats.inputPositions, 2100);
+  ASSERT_LE(stats.inputVectors, 2100 / 300 + 12);
+}
+
 TEST_F(LocalPartitionTest, indicesBufferCapacity) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
@@ -141,3 +141,47 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, multipleMarkers) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 3; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [&](auto row) { return row % 7; }),
+        makeFlatVector<int32_t>(100, [&](auto row) { return (row + i) % 5; }),
+        makeFlatVector<int64_t>(100, [&](auto row) { return row % 11 + i; }),
+    }));
+  }
+
+  // A single node computing all markers, two of which share their keys.
+  auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .markDistinct(
+              {"c1_distinct", "c2_distinct", "c1_distinct_2"},
+              {{"c0", "c1"}, {"c0", "c2"}, {"c0", "c1"}})
+          .planNode();
+  auto results = AssertQueryBuilder(plan).copyResults(pool());
+
+  auto chainedPlan = PlanBuilder()
+                         .values(vectors)
+                         .markDistinct("c1_distinct", {"c0", "c1"})
+                         .markDistinct("c2_distinct", {"c0", "c2"})
+                         .markDistinct("c1_distinct_2", {"c0", "c1"})
+                         .planNode();
+  auto expected = AssertQueryBuilder(chainedPlan).copyResults(pool());
+  assertEqualVectors(expected, results);
+
+  plan = PlanBuilder()
+             .values(vectors)
+             .markDistinct(
+                 {"c1_distinct", "c2_distinct"}, {{"c0", "c1"}, {"c0", "c2"}})
+             .singleAggregation(
+                 {"c0"},
+                 {"sum(c1)", "sum(c2)"},
+                 {"c1_distinct", "c2_distinct"})
+             .planNode();
+  createDuckDbTable(vectors);
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
+}
@@ -220,6 +220,19 @@ TEST_F(MergeJoinTest, allRowsMatch) {
   testJoin(rightKeys, leftKeys);
 }
 
+TEST_F(MergeJoinTest, longRunsAndGaps) {
+  // Long runs of equal keys on both sides, so that the matching right rows
+  // span several output batches.
+  testJoin<int64_t>(
+      [](auto row) { return row / 100 * 3; },
+      [](auto row) { return row / 37 * 2; });
+
+  // Long stretches of keys without a match on either side.
+  testJoin<int16_t>(
+      [](auto row) { return row < 1'000 ? row : row * 5; },
+      [](auto row) { return row < 300 ? row - 300 : row * 3; });
+}
+
 TEST_F(MergeJoinTest, aggregationOverJoin) {
   auto left =
       makeRowVector({"t_c0"}, {makeFlatVector<int32_t>({1, 2, 3, 4, 5})});
@@ -21,6 +21,7 @@
 #include "velox/dwio/common/FileSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/Merge.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/PartitionedOutput.h"
 #include "velox/exec/PlanNodeStats.h"
@@ -441,6 +442,67 @@ TEST_F(MultiFragmentTest, mergeExchange) {
   EXPECT_LT(0, mergeExchangeStats.rawInputBytes);
 }
 
+TEST_F(MultiFragmentTest, mergeExchangeAdaptiveBuffer) {
+  setupSources(20, 1000);
+  configSettings_[core::QueryConfig::kMergeExchangeAdaptiveBufferEnabled] =
+      "true";
+  configSettings_[core::QueryConfig::kMaxMergeExchangeBufferSize] = "100000";
+  configSettings_[core::QueryConfig::kPreferredOutputBatchRows] = "100";
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  std::vector<std::string> partialSortTaskIds;
+  RowTypePtr outputType;
+
+  // Each sort task reads 2 of the files.
+  for (int i = 0; i < 10; ++i) {
+    auto sortTaskId = makeTaskId("orderby", tasks.size());
+    partialSortTaskIds.push_back(sortTaskId);
+    auto partialSortPlan = PlanBuilder()
+                               .tableScan(rowType_)
+                               .orderBy({"c0"}, false)
+                               .partitionedOutput({}, 1)
+                               .planNode();
+
+    auto sortTask = makeTask(sortTaskId, partialSortPlan, tasks.size());
+    tasks.push_back(sortTask);
+    sortTask->start(1);
+    addHiveSplits(
+        sortTask,
+        std::vector<std::shared_ptr<TempFilePath>>(
+            filePaths_.begin() + 2 * i, filePaths_.begin() + 2 * i + 2));
+    outputType = partialSortPlan->outputType();
+  }
+
+  auto finalSortTaskId = makeTaskId("orderby", tasks.size());
+  core::PlanNodeId mergeExchangeId;
+  auto finalSortPlan = PlanBuilder()
+                           .mergeExchange(outputType, {"c0"})
+                           .capturePlanNodeId(mergeExchangeId)
+                           .partitionedOutput({}, 1)
+                           .planNode();
+
+  auto task = makeTask(finalSortTaskId, finalSortPlan, 0);
+  tasks.push_back(task);
+  task->start(1);
+  addRemoteSplits(task, partialSortTaskIds);
+
+  auto op = PlanBuilder().exchange(outputType).planNode();
+  assertQueryOrdered(
+      op, {finalSortTaskId}, "SELECT * FROM tmp ORDER BY 1 NULLS LAST", {0});
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+
+  const auto finalSortStats = toPlanStats(task->taskStats());
+  const auto& mergeExchangeStats = finalSortStats.at(mergeExchangeId);
+  EXPECT_EQ(20'000, mergeExchangeStats.inputRows);
+  EXPECT_LT(
+      0,
+      mergeExchangeStats.customStats.at(MergeExchange::kNumBufferRebalances)
+          .sum);
+}
+
 // Test reordering and dropping columns in PartitionedOutput operator.
 TEST_F(MultiFragmentTest, partitionedOutput) {
   setupSources(10, 1000);
@@ -2035,6 +2097,52 @@ TEST_F(MultiFragmentTest, mergeSmallBatchesInExchange) {
   test(100'000, 1);
 }
 
+TEST_F(MultiFragmentTest, coalesceSmallPagesInExchange) {
+  auto data = makeRowVector({makeFlatVector<int32_t>({1, 2, 3})});
+  auto producerPlan =
+      test::PlanBuilder().values({data}).partitionedOutput({}, 1).planNode();
+  const auto producerTaskId = "local://t1";
+  auto producerTask = makeTask(producerTaskId, producerPlan);
+  bufferManager_->initializeTask(
+      producerTask, core::PartitionedOutputNode::Kind::kPartitioned, 1, 1);
+  auto cleanupGuard = folly::makeGuard([&]() {
+    producerTask->requestCancel();
+    bufferManager_->removeTask(producerTaskId);
+  });
+
+  // Produce small pages with pauses in between, so that without coalescing
+  // the Exchange would see them one at a time.
+  constexpr int32_t kNumPages = 10;
+  std::thread producer([&]() {
+    for (auto i = 0; i < kNumPages; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      enqueue(producerTaskId, 0, data);
+    }
+    bufferManager_->noMoreData(producerTaskId);
+  });
+
+  auto plan = test::PlanBuilder().exchange(asRowType(data->type())).planNode();
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(
+          3 * kNumPages, [](auto row) { return 1 + row % 3; }),
+  });
+  auto task = test::AssertQueryBuilder(plan)
+                  .split(remoteSplit(producerTaskId))
+                  .destination(0)
+                  .config(
+                      core::QueryConfig::kExchangeCoalesceMaxWaitMs, "10000")
+                  .assertResults(expected);
+  producer.join();
+
+  auto taskStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = taskStats.at("0");
+  ASSERT_EQ(expected->size(), stats.outputRows);
+  // The deadline is far beyond the time to produce all pages, so all of them
+  // end up in one batch.
+  ASSERT_EQ(1, stats.outputVectors);
+  ASSERT_LT(0, stats.customStats.at(Exchange::kNumCoalesceWaits).sum);
+}
+
 TEST_F(MultiFragmentTest, compression) {
   bufferManager_->testingSetCompression(
       common::CompressionKind::CompressionKind_LZ4);
@@ -2083,8 +2191,11 @@ TEST_F(MultiFragmentTest, compression) {
           producerStats.customStats.at("compressedBytes").sum,
           producerStats.customStats.at("compressionInputBytes").sum);
       EXPECT_EQ(0, producerStats.customStats.at("compressionSkippedBytes").sum);
+      EXPECT_GT(100, producerStats.customStats.at("compressionRatioPct").max);
+      EXPECT_EQ(0, producerStats.customStats.at("compressionMisses").sum);
     } else {
       EXPECT_LT(0, producerStats.customStats.at("compressionSkippedBytes").sum);
+      EXPECT_LT(0, producerStats.customStats.at("compressionMisses").sum);
     }
   };
 
@@ -204,6 +204,40 @@ TEST_F(NestedLoopJoinTest, basic) {
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
 
+TEST_F(NestedLoopJoinTest, bandJoin) {
+  RowTypePtr buildType =
+      ROW({{"u0", BIGINT()}, {"u1", BIGINT()}, {"u2", BIGINT()}});
+  auto probeVectors = makeBatches(20, 5, probeType_, pool_.get());
+  auto buildVectors = makeBatches(18, 5, buildType, pool_.get());
+
+  setBuildType(buildType);
+  setComparisons({"BETWEEN"});
+  setJoinConditionStr("t0 {0} u0 AND u1");
+  setQueryStr("SELECT t0, u0 FROM t {0} JOIN u ON t0 {1} u0 AND u1");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+
+  // Intervals of different lengths that overlap, with a residual condition
+  // that is not a bound.
+  auto probe = makeRowVector(
+      {"t0"},
+      {makeNullableFlatVector<int64_t>(
+          {1, 5, std::nullopt, 17, 30, 42, 42, -3, 100})});
+  auto build = makeRowVector(
+      {"u0", "u1", "u2"},
+      {
+          makeNullableFlatVector<int64_t>(
+              {0, 40, 3, std::nullopt, 16, 5, 41, 90}),
+          makeNullableFlatVector<int64_t>({2, 50, 20, 10, 17, 5, 43, 95}),
+          makeFlatVector<int64_t>({1, 2, 3, 4, 5, 6, 7, 8}),
+      });
+  setComparisons({"<="});
+  setJoinConditionStr("u0 {0} t0 AND t0 {0} u1 AND t0 + u2 <> 20");
+  setQueryStr(
+      "SELECT t0, u0 FROM t {0} JOIN u ON u0 {1} t0 AND t0 {1} u1 "
+      "AND t0 + u2 <> 20");
+  runSingleAndMultiDriverTest({probe}, {build});
+}
+
 TEST_F(NestedLoopJoinTest, emptyProbe) {
   auto probeVectors = makeBatches(0, 5, probeType_, pool_.get());
   auto buildVectors = makeBatches(18, 5, buildType_, pool_.get());
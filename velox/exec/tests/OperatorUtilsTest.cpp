@@ -154,6 +154,45 @@ TEST_F(OperatorUtilsTest, wrapChildConstant) {
   ASSERT_TRUE(wrapped->equalValueAt(constant.get(), 100, 100));
 }
 
+TEST_F(OperatorUtilsTest, wrapChildDictionary) {
+  auto base = makeFlatVector<int64_t>(100, [](auto row) { return row * 10; });
+  auto innerIndices = makeIndicesInReverse(100);
+  auto dictionary = wrapInDictionary(innerIndices, 100, base);
+  auto otherDictionary = wrapInDictionary(
+      innerIndices, 100, makeFlatVector<int32_t>(100, folly::identity));
+
+  const vector_size_t size = 50;
+  auto mapping = makeIndices(size, [](auto row) { return row * 2; });
+
+  // A dictionary over a dictionary is combined into one over the base.
+  auto wrapped = exec::wrapChild(size, mapping, dictionary);
+  ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, wrapped->encoding());
+  ASSERT_EQ(base.get(), wrapped->valueVector().get());
+  for (auto i = 0; i < size; ++i) {
+    ASSERT_TRUE(wrapped->equalValueAt(dictionary.get(), i, i * 2));
+  }
+
+  // Children with the same indices share the combined indices.
+  auto row = exec::wrap(
+      size, mapping, makeRowVector({dictionary, otherDictionary, base}));
+  ASSERT_EQ(base.get(), row->childAt(0)->valueVector().get());
+  ASSERT_EQ(
+      row->childAt(0)->wrapInfo().get(), row->childAt(1)->wrapInfo().get());
+  ASSERT_EQ(mapping.get(), row->childAt(2)->wrapInfo().get());
+  assertEqualVectors(
+      makeFlatVector<int64_t>(size, [](auto row) { return 990 - row * 20; }),
+      row->childAt(0));
+
+  // A dictionary that adds nulls is wrapped as is.
+  auto nullsDictionary = BaseVector::wrapInDictionary(
+      makeNulls(100, nullEvery(3)), innerIndices, 100, base);
+  wrapped = exec::wrapChild(size, mapping, nullsDictionary);
+  ASSERT_EQ(nullsDictionary.get(), wrapped->valueVector().get());
+  for (auto i = 0; i < size; ++i) {
+    ASSERT_TRUE(wrapped->equalValueAt(nullsDictionary.get(), i, i * 2));
+  }
+}
+
 TEST_F(OperatorUtilsTest, gatherCopy) {
   std::shared_ptr<const RowType> rowType;
   std::shared_ptr<const RowType> reversedRowType;
@@ -366,6 +366,45 @@ TEST_F(OrderByTest, multiBatchResult) {
   testSingleKey(vectors, "c0");
 }
 
+TEST_F(OrderByTest, parallelSort) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (batchSize * i + row) % 997; },
+        nullEvery(5));
+    auto c1 = makeFlatVector<StringView>(batchSize, [](vector_size_t row) {
+      return StringView::makeInline(std::to_string(row % 101));
+    });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+
+  // Each driver reads all 'vectors'.
+  const int32_t numDrivers = 4;
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < numDrivers; ++i) {
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  core::PlanNodeId orderById;
+  auto plan = PlanBuilder()
+                  .values(vectors, true)
+                  .orderBy({"c0 DESC NULLS FIRST", "c1"}, false)
+                  .capturePlanNodeId(orderById)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kOrderByParallelSort, "true")
+                  .maxDrivers(numDrivers)
+                  .assertResults(
+                      "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1",
+                      {{0, 1}});
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(orderById).numDrivers, numDrivers);
+  ASSERT_EQ(planStats.at(orderById).outputRows, 5 * batchSize * numDrivers);
+}
+
 TEST_F(OrderByTest, varfields) {
   vector_size_t batchSize = 1000;
   std::vector<RowVectorPtr> vectors;
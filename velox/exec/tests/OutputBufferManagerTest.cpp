@@ -880,6 +880,49 @@ TEST_F(OutputBufferManagerTest, basicBroadcast) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(OutputBufferManagerTest, broadcastSharesPages) {
+  // A page enqueued to a broadcast buffer is buffered once, not once per
+  // destination, and stays buffered until all destinations acknowledge it.
+  constexpr int32_t kNumDestinations = 100;
+  constexpr int32_t kNumPages = 5;
+  const std::string taskId = "t0";
+  initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kBroadcast,
+      kNumDestinations,
+      1);
+  bufferManager_->updateOutputBuffers(taskId, kNumDestinations, true);
+
+  uint64_t totalBytes{0};
+  for (auto i = 0; i < kNumPages; ++i) {
+    totalBytes += enqueue(taskId, 0, rowType_, 100);
+  }
+  auto stats = getStats(taskId);
+  ASSERT_EQ(kNumPages, stats.bufferedPages);
+  ASSERT_EQ(totalBytes, stats.bufferedBytes);
+
+  for (auto destination = 0; destination < kNumDestinations; ++destination) {
+    for (auto sequence = 0; sequence < kNumPages; ++sequence) {
+      fetchOne(taskId, destination, sequence, 1);
+      acknowledge(taskId, destination, sequence + 1);
+    }
+    stats = getStats(taskId);
+    if (destination < kNumDestinations - 1) {
+      ASSERT_EQ(totalBytes, stats.bufferedBytes);
+    }
+  }
+  ASSERT_EQ(0, stats.bufferedPages);
+  ASSERT_EQ(0, stats.bufferedBytes);
+
+  noMoreData(taskId);
+  for (auto destination = 0; destination < kNumDestinations; ++destination) {
+    fetchEndMarker(taskId, destination, kNumPages);
+  }
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(OutputBufferManagerTest, basicArbitrary) {
   const vector_size_t size = 100;
   int numDestinations = 5;
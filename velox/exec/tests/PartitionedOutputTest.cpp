@@ -18,6 +18,7 @@
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec::test {
 
@@ -141,4 +142,135 @@ TEST_F(PartitionedOutputTest, flush) {
   EXPECT_EQ(partition1.size(), 2);
 }
 
+TEST_F(PartitionedOutputTest, preserveEncodings) {
+  // A dictionary encoded column with few distinct large values.
+  constexpr vector_size_t kSize = 1'000;
+  constexpr int32_t kNumBatches = 10;
+  auto values = makeFlatVector<std::string>(
+      {std::string(100, 'a'),
+       std::string(100, 'b'),
+       std::string(100, 'c'),
+       std::string(100, 'd')});
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int32_t>(kSize, [](auto row) { return row; }),
+       wrapInDictionary(
+           makeIndices(kSize, [](auto row) { return row % 4; }),
+           kSize,
+           values)});
+  const auto outputType = ROW({"v1"}, {VARCHAR()});
+
+  const auto runTask = [&](bool preserveEncodings) {
+    auto plan = PlanBuilder()
+                    .values({input}, false, kNumBatches)
+                    .partitionedOutput({}, 1, std::vector<std::string>{"v1"})
+                    .planNode();
+    const auto taskId = fmt::format(
+        "local://test-partitioned-output-preserve-encodings-{}",
+        preserveEncodings);
+    auto task = Task::create(
+        taskId,
+        core::PlanFragment{plan},
+        0,
+        createQueryContext(
+            {{core::QueryConfig::kPartitionedOutputPreserveEncodings,
+              preserveEncodings ? "true" : "false"}}),
+        Task::ExecutionMode::kParallel);
+    task->start(1);
+    auto pages = getAllData(taskId, 0);
+    EXPECT_TRUE(waitForTaskCompletion(task.get()));
+    return pages;
+  };
+
+  const auto flatPages = runTask(false);
+  const auto encodedPages = runTask(true);
+
+  uint64_t flatBytes{0};
+  for (const auto& page : flatPages) {
+    flatBytes += page->computeChainDataLength();
+  }
+  uint64_t encodedBytes{0};
+  RowVectorPtr result;
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  for (const auto& page : encodedPages) {
+    encodedBytes += page->computeChainDataLength();
+    SerializedPage serializedPage(page->clone());
+    auto stream = serializedPage.prepareStreamForDeserialize();
+    while (!stream.atEnd()) {
+      getVectorSerde()->deserialize(
+          &stream,
+          pool(),
+          outputType,
+          &result,
+          result == nullptr ? 0 : result->size(),
+          &options);
+    }
+  }
+  ASSERT_LT(encodedBytes * 4, flatBytes);
+
+  auto expected = BaseVector::create<RowVector>(outputType, 0, pool());
+  const auto batch = makeRowVector({"v1"}, {input->childAt(1)});
+  for (auto i = 0; i < kNumBatches; ++i) {
+    expected->append(batch.get());
+  }
+  assertEqualVectors(expected, result);
+}
+
+TEST_F(PartitionedOutputTest, manyDestinations) {
+  // Verifies that each row goes to exactly one of many destinations and that
+  // destinations without rows in a batch are left alone.
+  constexpr vector_size_t kSize = 1'000;
+  constexpr int32_t kNumBatches = 5;
+  constexpr int32_t kNumDestinations = 100;
+  auto input = makeRowVector(
+      {"p1", "v1"},
+      {makeFlatVector<int32_t>(kSize, [](auto row) { return row % 300; }),
+       makeFlatVector<int64_t>(kSize, [](auto row) { return row; })});
+
+  auto plan = PlanBuilder()
+                  .values({input}, false, kNumBatches)
+                  .partitionedOutput({"p1"}, kNumDestinations)
+                  .planNode();
+  const auto taskId = "local://test-partitioned-output-many-destinations";
+  auto task = Task::create(
+      taskId,
+      core::PlanFragment{plan},
+      0,
+      createQueryContext({}),
+      Task::ExecutionMode::kParallel);
+  task->start(1);
+
+  const auto rowType = asRowType(input->type());
+  // Destination of each key and number of rows of each value.
+  std::unordered_map<int32_t, int32_t> keyDestinations;
+  std::unordered_map<int64_t, int32_t> valueCounts;
+  vector_size_t numRows{0};
+  for (auto destination = 0; destination < kNumDestinations; ++destination) {
+    for (const auto& page : getAllData(taskId, destination)) {
+      SerializedPage serializedPage(page->clone());
+      auto stream = serializedPage.prepareStreamForDeserialize();
+      while (!stream.atEnd()) {
+        RowVectorPtr result;
+        getVectorSerde()->deserialize(&stream, pool(), rowType, &result);
+        auto* keys = result->childAt(0)->as<SimpleVector<int32_t>>();
+        auto* values = result->childAt(1)->as<SimpleVector<int64_t>>();
+        for (auto i = 0; i < result->size(); ++i) {
+          auto it = keyDestinations.emplace(keys->valueAt(i), destination);
+          ASSERT_EQ(it.first->second, destination);
+          ++valueCounts[values->valueAt(i)];
+        }
+        numRows += result->size();
+      }
+    }
+  }
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+
+  ASSERT_EQ(numRows, kSize * kNumBatches);
+  ASSERT_EQ(keyDestinations.size(), 300);
+  ASSERT_EQ(valueCounts.size(), kSize);
+  for (const auto& [value, count] : valueCounts) {
+    ASSERT_EQ(count, kNumBatches);
+  }
+}
+
 } // namespace facebook::velox::exec::test
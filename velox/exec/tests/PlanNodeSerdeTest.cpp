@@ -124,6 +124,12 @@ TEST_F(PlanNodeSerdeTest, markDistinct) {
                   .markDistinct("marker", {"c0", "c1", "c2"})
                   .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .markDistinct({"m0", "m1"}, {{"c0", "c1"}, {"c2"}})
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, nestedLoopJoin) {
@@ -300,6 +306,21 @@ TEST_F(PlanNodeSerdeTest, mergeJoin) {
              .planNode();
 
   testSerde(plan);
+
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({probe})
+             .hashJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({build}).planNode(),
+                 "", // no filter
+                 {"t0", "t1", "u2", "t2"},
+                 core::JoinType::kInner,
+                 false, // nullAware
+                 true) // useHashTableCache
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, orderBy) {
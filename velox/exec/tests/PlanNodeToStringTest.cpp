@@ -901,4 +901,13 @@ TEST_F(PlanNodeToStringTest, markDistinct) {
   ASSERT_EQ(
       "-- MarkDistinct[1][a, b] -> a:VARCHAR, b:BIGINT, c:BIGINT, marker:BOOLEAN\n",
       op->toString(true, false));
+
+  op = PlanBuilder()
+           .tableScan(ROW({"a", "b", "c"}, {VARCHAR(), BIGINT(), BIGINT()}))
+           .markDistinct({"m0", "m1"}, {{"a", "b"}, {"c"}})
+           .planNode();
+  ASSERT_EQ(
+      "-- MarkDistinct[1][m0: a, b; m1: c] -> a:VARCHAR, b:BIGINT, c:BIGINT, "
+      "m0:BOOLEAN, m1:BOOLEAN\n",
+      op->toString(true, false));
 }
@@ -41,7 +41,10 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
 
   void testPrefixSort(
       const std::vector<CompareFlags>& compareFlags,
-      const RowVectorPtr& data) {
+      const RowVectorPtr& data,
+      uint32_t maxStringPrefixLength = 16,
+      bool radixSort = false,
+      const std::function<void(RowContainer&)>& prepareContainer = nullptr) {
     const auto numRows = data->size();
     const auto expectedResult =
         generateExpectedResult(compareFlags, numRows, data);
@@ -57,6 +60,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         rowType->children().end()};
 
     RowContainer rowContainer(keyTypes, payloadTypes, pool_.get());
+    if (prepareContainer) {
+      prepareContainer(rowContainer);
+    }
     std::vector<char*> rows = storeRows(numRows, data, &rowContainer);
 
     // Use PrefixSort to sort rows.
@@ -67,7 +73,9 @@ class PrefixSortTest : public exec::test::OperatorTestBase {
         compareFlags,
         {1024,
          // Set threshold to 0 to enable prefix-sort in small dataset.
-         0});
+         0,
+         maxStringPrefixLength,
+         radixSort});
 
     // Extract data from the RowContainer in order.
     const RowVectorPtr actual =
@@ -217,6 +225,88 @@ TEST_F(PrefixSortTest, multipleKeys) {
   }
 }
 
+TEST_F(PrefixSortTest, stringPrefix) {
+  // Strings shorter than, equal to and longer than the prefix, with shared
+  // prefixes and trailing zero bytes.
+  const std::string zero(1, '\0');
+  const auto strings = makeNullableFlatVector<std::string>(
+      {"abcdefgh",
+       "abcdefghij",
+       "abcdefghik",
+       "abc",
+       "abc" + zero,
+       "abc" + zero + zero,
+       std::nullopt,
+       "",
+       zero,
+       "abcdefg",
+       "abcdefghij",
+       "b",
+       "abcdefgh" + zero,
+       std::nullopt});
+  const auto numbers = makeFlatVector<int64_t>(
+      strings->size(), [](auto row) { return row % 3; });
+
+  for (auto maxStringPrefixLength : {1, 4, 8, 16}) {
+    SCOPED_TRACE(fmt::format("prefix length {}", maxStringPrefixLength));
+    testPrefixSort({kAsc}, makeRowVector({strings}), maxStringPrefixLength);
+    testPrefixSort({kDesc}, makeRowVector({strings}), maxStringPrefixLength);
+
+    // The key after the string is compared with the RowContainer.
+    const auto data = makeRowVector({strings, numbers});
+    testPrefixSort({kAsc, kDesc}, data, maxStringPrefixLength);
+    testPrefixSort({kDesc, kAsc}, data, maxStringPrefixLength);
+
+    // The string key after a normalized key.
+    const auto reversed = makeRowVector({numbers, strings});
+    testPrefixSort({kAsc, kAsc}, reversed, maxStringPrefixLength);
+    testPrefixSort({kDesc, kDesc}, reversed, maxStringPrefixLength);
+  }
+
+  // String prefixes disabled.
+  testPrefixSort({kAsc}, makeRowVector({strings}), 0);
+}
+
+TEST_F(PrefixSortTest, multipartStringPrefix) {
+  // Leaves little free space in the string allocator, so that the next long
+  // string is stored in several blocks, the first of which is short.
+  const auto fragment = [](RowContainer& rowContainer) {
+    auto& allocator = rowContainer.stringAllocator();
+    allocator.allocate(HashStringAllocator::kMinAlloc);
+    while (allocator.freeSpace() > 200) {
+      allocator.allocate(std::min<int32_t>(
+          allocator.freeSpace() - 100, HashStringAllocator::kMaxAlloc));
+    }
+  };
+
+  // The strings differ only after the first 150 bytes. The first one is
+  // stored first and does not fit in the free space.
+  const std::string common(150, 'a');
+  const auto strings = makeFlatVector<std::string>({
+      common + "b" + std::string(20'000, 'x'),
+      common + "c",
+      common + "a",
+      common + "b",
+      common + "bb",
+      common + "b" + std::string(20'000, 'w'),
+  });
+  const auto data = makeRowVector({strings});
+
+  {
+    RowContainer rowContainer({VARCHAR()}, pool_.get());
+    fragment(rowContainer);
+    auto rows = storeRows(1, data, &rowContainer);
+    const auto value = *reinterpret_cast<StringView*>(
+        rows[0] + rowContainer.columnAt(0).offset());
+    const auto* header = HashStringAllocator::headerOf(value.data());
+    ASSERT_TRUE(header->isContinued());
+    ASSERT_LT(header->size(), common.size());
+  }
+
+  testPrefixSort({kAsc}, data, 200, false, fragment);
+  testPrefixSort({kDesc}, data, 200, false, fragment);
+}
+
 TEST_F(PrefixSortTest, fuzz) {
   std::vector<TypePtr> keyTypes = {
       INTEGER(),
@@ -237,6 +327,8 @@ TEST_F(PrefixSortTest, fuzz) {
 
     testPrefixSort({kAsc}, data);
     testPrefixSort({kDesc}, data);
+    testPrefixSort({kAsc}, data, 16, true);
+    testPrefixSort({kDesc}, data, 16, true);
   }
 }
 
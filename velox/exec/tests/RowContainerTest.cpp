@@ -1814,6 +1814,88 @@ TEST_F(RowContainerTest, partialWriteComplexTypedRow) {
   rowContainer->eraseRows(folly::Range<char**>(&row, 1));
 }
 
+TEST_F(RowContainerTest, compactVariableWidthData) {
+  constexpr int32_t kNumRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, folly::identity),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) {
+            // A few strings do not fit in one block. Only the first one is
+            // kept below.
+            const auto size =
+                row == 0 || row % 1'000 == 1 ? 100'000 : 20 + row % 50;
+            return std::string(size, 'a' + row % 26);
+          },
+          nullEvery(7, 1)),
+      makeArrayVector<int64_t>(
+          kNumRows,
+          [](auto row) { return row % 10; },
+          [](auto row) { return row; },
+          nullEvery(11)),
+  });
+  auto rowContainer = std::make_unique<RowContainer>(
+      data->type()->asRow().children(), pool_.get());
+  std::vector<DecodedVector> decodedVectors;
+  for (auto& vector : data->children()) {
+    decodedVectors.emplace_back(*vector);
+  }
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = rowContainer->newRow();
+    for (auto j = 0; j < decodedVectors.size(); ++j) {
+      rowContainer->store(decodedVectors[j], i, rows[i], j);
+    }
+  }
+
+  // Erase all but every 10th row.
+  std::vector<char*> erased;
+  std::vector<char*> kept;
+  std::vector<vector_size_t> keptIndices;
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (i % 10 == 0) {
+      kept.push_back(rows[i]);
+      keptIndices.push_back(i);
+    } else {
+      erased.push_back(rows[i]);
+    }
+  }
+  rowContainer->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+  const auto fragmentation = rowContainer->stringAllocator().fragmentation();
+  ASSERT_GT(fragmentation, 0.5);
+
+  ASSERT_TRUE(rowContainer->canCompactVariableWidthData());
+  const auto retainedBytes = rowContainer->stringAllocator().retainedSize();
+  const auto compactedBytes =
+      rowContainer->compactVariableWidthData(pool_.get());
+  EXPECT_GT(compactedBytes, 0);
+  EXPECT_EQ(
+      rowContainer->stringAllocator().retainedSize(),
+      retainedBytes - compactedBytes);
+  EXPECT_LT(rowContainer->stringAllocator().fragmentation(), fragmentation);
+  rowContainer->stringAllocator().checkConsistency();
+  rowContainer->checkConsistency();
+
+  const auto indices = makeIndices(keptIndices);
+  for (auto i = 0; i < decodedVectors.size(); ++i) {
+    auto result =
+        BaseVector::create(data->childAt(i)->type(), kept.size(), pool());
+    rowContainer->extractColumn(kept.data(), kept.size(), i, result);
+    assertEqualVectors(wrapInDictionary(indices, data->childAt(i)), result);
+  }
+
+  for (auto i = 0; i < kept.size(); ++i) {
+    EXPECT_TRUE(rowContainer->equals<true>(
+        kept[i], rowContainer->columnAt(1), decodedVectors[1], keptIndices[i]));
+  }
+
+  // New rows reuse the erased rows after compaction.
+  auto row = rowContainer->newRow();
+  rowContainer->store(decodedVectors[1], 1, row, 1);
+  EXPECT_NE(std::find(erased.begin(), erased.end(), row), erased.end());
+  rowContainer->clear();
+}
+
 TEST_F(RowContainerTest, extractSerializedRow) {
   VectorFuzzer fuzzer(
       {
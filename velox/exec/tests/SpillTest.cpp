@@ -18,6 +18,8 @@
 #include <algorithm>
 #include <memory>
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
@@ -516,6 +518,171 @@ TEST_P(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_P(SpillTest, spillEncodeSortedRuns) {
+  // Each sort key repeats 100 times and 'c1' only changes with the key.
+  const vector_size_t numRows = 10'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(numRows, [](auto row) { return row / 100; }),
+      makeFlatVector<std::string>(
+          numRows,
+          [](auto row) {
+            return fmt::format("some long value {}", row / 100);
+          }),
+      makeFlatVector<int32_t>(numRows, [](auto row) { return row; }),
+  });
+  const std::vector<CompareFlags> compareFlags{CompareFlags{true, true}};
+
+  uint64_t spilledBytes[2];
+  for (const bool encodeSortedRuns : {false, true}) {
+    SCOPED_TRACE(fmt::format("encodeSortedRuns: {}", encodeSortedRuns));
+    spillStats_.wlock()->reset();
+    SpillState state(
+        [&]() -> const std::string& { return tempDir_->getPath(); },
+        updateSpilledBytesCb_,
+        fmt::format("test-{}", encodeSortedRuns),
+        1,
+        1,
+        compareFlags,
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &spillStats_,
+        {},
+        encodeSortedRuns);
+    state.setPartitionSpilled(0);
+    state.appendToPartition(0, data);
+    state.finishFile(0);
+    spilledBytes[encodeSortedRuns] = spillStats_.rlock()->spilledBytes;
+
+    SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+    auto merge = spillPartition.createOrderedReader(pool(), &spillStats_);
+    for (auto i = 0; i < numRows; ++i) {
+      auto* stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      const auto index = stream->currentIndex();
+      ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(index), i / 100);
+      ASSERT_EQ(
+          stream->decoded(1).valueAt<StringView>(index).str(),
+          fmt::format("some long value {}", i / 100));
+      ASSERT_EQ(stream->decoded(2).valueAt<int32_t>(index), i);
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+  }
+  if (compressionKind_ == common::CompressionKind::CompressionKind_NONE) {
+    ASSERT_LT(spilledBytes[1], spilledBytes[0] / 2);
+  }
+}
+
+TEST_P(SpillTest, asyncIo) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(2);
+  const int32_t numBatches = 10;
+  const vector_size_t numRowsPerBatch = 100'000;
+  const std::vector<CompareFlags> compareFlags{CompareFlags{true, true}};
+  spillStats_.wlock()->reset();
+
+  // Writes each batch to its own buffer and reads the 8MB of the file in
+  // several read buffers.
+  SpillState state(
+      [&]() -> const std::string& { return tempDir_->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      compareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      {},
+      false,
+      executor.get());
+  state.setPartitionSpilled(0);
+  for (auto batch = 0; batch < numBatches; ++batch) {
+    auto data = makeRowVector({makeFlatVector<int64_t>(
+        numRowsPerBatch,
+        [&](auto row) { return batch * numRowsPerBatch + row; })});
+    state.appendToPartition(0, data);
+  }
+  state.finishFile(0);
+  ASSERT_EQ(spillStats_.rlock()->spillWrites, numBatches);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, state.finish(0));
+  auto merge = spillPartition.createOrderedReader(
+      pool(), &spillStats_, executor.get());
+  for (auto i = 0; i < numBatches * numRowsPerBatch; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+    stream->pop();
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+  ASSERT_GT(spillStats_.rlock()->spillReads, 1);
+}
+
+TEST_P(SpillTest, offloadFiles) {
+  auto remoteDir = exec::test::TempDirectoryPath::create();
+  const int32_t numFiles = 4;
+  const vector_size_t numRowsPerFile = 1'000;
+  const std::vector<CompareFlags> compareFlags{CompareFlags{true, true}};
+
+  // Moves every other finished file.
+  int32_t numFinishedFiles{0};
+  common::SpillFileOffloadCB offloadCb = [&](uint64_t fileSize) {
+    EXPECT_GT(fileSize, 0);
+    return numFinishedFiles++ % 2 == 0 ? remoteDir->getPath() : "";
+  };
+  SpillState state(
+      [&]() -> const std::string& { return tempDir_->getPath(); },
+      updateSpilledBytesCb_,
+      "test",
+      1,
+      1,
+      compareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &spillStats_,
+      {},
+      false,
+      nullptr,
+      offloadCb);
+  state.setPartitionSpilled(0);
+  for (auto file = 0; file < numFiles; ++file) {
+    auto data = makeRowVector({makeFlatVector<int64_t>(
+        numRowsPerFile, [&](auto row) { return row * numFiles + file; })});
+    state.appendToPartition(0, data);
+    state.finishFile(0);
+  }
+  ASSERT_EQ(numFinishedFiles, numFiles);
+
+  auto files = state.finish(0);
+  ASSERT_EQ(files.size(), numFiles);
+  auto fs = filesystems::getFileSystem(tempDir_->getPath(), nullptr);
+  for (auto i = 0; i < numFiles; ++i) {
+    ASSERT_EQ(files[i].path.find(remoteDir->getPath()) == 0, i % 2 == 0)
+        << files[i].path;
+    ASSERT_TRUE(fs->exists(files[i].path));
+    ASSERT_EQ(fs->openFileForRead(files[i].path)->size(), files[i].size);
+  }
+  ASSERT_EQ(fs->list(remoteDir->getPath()).size(), numFiles / 2);
+  ASSERT_EQ(
+      runtimeStats_["spillOffloadedBytes"].sum, files[0].size + files[2].size);
+
+  SpillPartition spillPartition(SpillPartitionId{0, 0}, std::move(files));
+  auto merge = spillPartition.createOrderedReader(pool(), &spillStats_);
+  for (auto i = 0; i < numFiles * numRowsPerFile; ++i) {
+    auto* stream = merge->next();
+    ASSERT_NE(stream, nullptr);
+    ASSERT_EQ(stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+    stream->pop();
+  }
+  ASSERT_EQ(merge->next(), nullptr);
+}
+
 TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
@@ -758,6 +925,30 @@ TEST_P(SpillTest, spillPartitionSpilt) {
   }
 }
 
+TEST_P(SpillTest, spillPartitionTakeFiles) {
+  const int numBatches = 10;
+  const int numRowsPerBatch = 50;
+  // Spill each batch into a separate file.
+  setupSpillState(1, 0, 1, numBatches, numRowsPerBatch);
+  const SpillPartitionId id(0, 0);
+  auto spillPartition = std::make_unique<SpillPartition>(id, state_->finish(0));
+  const auto totalNumFiles = spillPartition->numFiles();
+  ASSERT_GT(totalNumFiles, 2);
+  const auto totalSize = spillPartition->size();
+
+  // Takes at least one file even if it exceeds the byte limit.
+  auto chunk = spillPartition->takeFiles(1);
+  ASSERT_EQ(chunk->id(), id);
+  ASSERT_EQ(chunk->numFiles(), 1);
+  ASSERT_EQ(spillPartition->numFiles(), totalNumFiles - 1);
+  ASSERT_EQ(chunk->size() + spillPartition->size(), totalSize);
+
+  chunk = spillPartition->takeFiles(totalSize);
+  ASSERT_EQ(chunk->numFiles(), totalNumFiles - 1);
+  ASSERT_EQ(spillPartition->numFiles(), 0);
+  ASSERT_EQ(spillPartition->size(), 0);
+}
+
 TEST_P(SpillTest, nonExistSpillFileOnDeletion) {
   const int32_t numRowsPerBatch = 50;
   std::vector<RowVectorPtr> batches;
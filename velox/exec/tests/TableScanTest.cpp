@@ -1454,6 +1454,35 @@ TEST_F(TableScanTest, preloadingSplitClose) {
   latch.wait();
 }
 
+TEST_F(TableScanTest, splitPreloadMemoryBudget) {
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->getPath(), vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto budget : {0, 1}) {
+    SCOPED_TRACE(fmt::format("budget {}", budget));
+    auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                    .plan(tableScanNode())
+                    .splits(makeHiveConnectorSplits(filePaths))
+                    .config(QueryConfig::kMaxSplitPreloadPerDriver, "2")
+                    .config(
+                        QueryConfig::kSplitPreloadMemoryBudget,
+                        std::to_string(budget))
+                    .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    ASSERT_GT(stats.at("preloadedSplits").sum, 0);
+    if (budget == 0) {
+      ASSERT_EQ(stats.count("splitPreloadsOverBudget"), 0);
+    } else {
+      // Preloads hold at least one byte once started.
+      ASSERT_GT(stats.at("splitPreloadsOverBudget").sum, 0);
+    }
+  }
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -3204,6 +3233,20 @@ TEST_F(TableScanTest, aggregationPushdown) {
   // 5 aggregates processing 10K rows each via pushdown.
   EXPECT_EQ(5 * 10'000, loadedToValueHook(task, 1));
 
+  op = PlanBuilder()
+           .tableScan(rowType_)
+           .singleAggregation(
+               {"c5"},
+               {"count(c0)", "count(c1)", "count(c2)", "count(c3)", "count(c4)"})
+           .planNode();
+
+  task = assertQuery(
+      op,
+      {filePath},
+      "SELECT c5, count(c0), count(c1), count(c2), count(c3), count(c4) FROM tmp group by c5");
+  // 5 aggregates processing 10K rows each via pushdown.
+  EXPECT_EQ(5 * 10'000, loadedToValueHook(task, 1));
+
   // Pushdown should also happen if there is a FilterProject node that doesn't
   // touch columns being aggregated
   op = PlanBuilder()
@@ -4204,6 +4247,90 @@ TEST_F(TableScanTest, partitionKeyNotMatchPartitionKeysHandle) {
   assertQuery(op, split, "SELECT c0 FROM tmp");
 }
 
+TEST_F(TableScanTest, partitionFilterSkipsSplitWithoutOpeningFile) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  createDuckDbTable(vectors);
+
+  // The files of the splits rejected by the filter on 'ds' do not exist, so
+  // the query fails if they are opened.
+  const auto missingPath = filePath->getPath() + ".missing";
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits = {
+      HiveConnectorSplitBuilder(filePath->getPath())
+          .partitionKey("ds", "2021-12-02")
+          .build(),
+      HiveConnectorSplitBuilder(missingPath)
+          .partitionKey("ds", "2021-12-03")
+          .build(),
+      HiveConnectorSplitBuilder(missingPath)
+          .partitionKey("ds", std::nullopt)
+          .build(),
+  };
+
+  ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  auto op = PlanBuilder()
+                .startTableScan()
+                .outputType(ROW({"c0", "ds"}, {BIGINT(), VARCHAR()}))
+                .assignments(assignments)
+                .subfieldFilters({"ds = '2021-12-02'"})
+                .endTableScan()
+                .planNode();
+  auto task = HiveConnectorTestBase::assertQuery(
+      op, splits, "SELECT c0, '2021-12-02' FROM tmp", 0);
+  EXPECT_EQ(2, getSkippedSplitsStat(task));
+}
+
+TEST_F(TableScanTest, dynamicFilterAfterSplitPreload) {
+  auto vectors = makeVectors(1, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->getPath(), vectors);
+  auto split = HiveConnectorSplitBuilder(filePath->getPath())
+                   .partitionKey("ds", "2021-12-02")
+                   .build();
+
+  auto outputType = ROW({"c0", "ds"}, {BIGINT(), VARCHAR()});
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignments = {
+          {"c0", regularColumn("c0", BIGINT())},
+          {"ds", partitionKey("ds", VARCHAR())}};
+  auto sessionProperties = std::make_shared<core::MemConfig>();
+  connector::ConnectorQueryCtx connectorQueryCtx(
+      pool_.get(),
+      rootPool_.get(),
+      sessionProperties.get(),
+      nullptr,
+      nullptr,
+      nullptr,
+      "query.TableScanTest",
+      "task.TableScanTest",
+      "planNodeId.TableScanTest",
+      0);
+  auto connector = connector::getConnector(kHiveConnectorId);
+  auto tableHandle = makeTableHandle();
+  auto dataSource = connector->createDataSource(
+      outputType, tableHandle, assignments, &connectorQueryCtx);
+  auto preloadedSource = connector->createDataSource(
+      outputType, tableHandle, assignments, &connectorQueryCtx);
+
+  // The split is prepared before the dynamic filter on the partition key
+  // arrives. The filter still skips it.
+  preloadedSource->addSplit(split);
+  dataSource->addDynamicFilter(
+      1,
+      std::make_shared<common::BytesValues>(
+          std::vector<std::string>{"2021-12-03"}, false));
+  dataSource->setFromDataSource(std::move(preloadedSource));
+
+  ContinueFuture future;
+  auto result = dataSource->next(1'000, future);
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result.value(), nullptr);
+  ASSERT_EQ(dataSource->runtimeStats().at("skippedSplits").value, 1);
+}
+
 TEST_F(TableScanTest, readFlatMapAsStruct) {
   constexpr int kSize = 10;
   std::vector<std::string> keys = {"1", "2", "3"};
@@ -1546,6 +1546,58 @@ DEBUG_ONLY_TEST_F(TaskTest, driverCounters) {
   ASSERT_EQ(driverCounts.numBlockedDrivers.size(), 0);
 }
 
+DEBUG_ONLY_TEST_F(TaskTest, maxRunningDrivers) {
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(100, [](auto row) { return row % 3; }),
+         makeFlatVector<int64_t>(100, [i](auto row) { return row + i; })}));
+  }
+  createDuckDbTable(batches);
+  const auto plan = PlanBuilder()
+                        .values(batches, true)
+                        .partialAggregation({"c0"}, {"sum(c1)"})
+                        .localPartition({"c0"})
+                        .finalAggregation()
+                        .planNode();
+
+  std::atomic_int32_t maxOnThreadDrivers{0};
+  std::atomic_bool raiseLimit{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Values::getOutput",
+      std::function<void(const exec::Values*)>([&](const exec::Values*
+                                                       values) {
+        auto& task = values->testingOperatorCtx()->task();
+        const auto numOnThread = task->driverCounts().numOnThreadDrivers;
+        if (numOnThread > maxOnThreadDrivers) {
+          maxOnThreadDrivers = numOnThread;
+        }
+        if (raiseLimit.exchange(false)) {
+          task->setMaxRunningDrivers(0);
+        }
+        /* sleep override */
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }));
+
+  for (const bool raise : {false, true}) {
+    SCOPED_TRACE(fmt::format("raise: {}", raise));
+    maxOnThreadDrivers = 0;
+    raiseLimit = raise;
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .config(core::QueryConfig::kMaxRunningDriversPerTask, "1")
+                    .maxDrivers(4)
+                    .assertResults(
+                        "SELECT c0, sum(c1) * 4 FROM tmp GROUP BY c0");
+    if (raise) {
+      ASSERT_EQ(task->maxRunningDrivers(), 0);
+    } else {
+      // Only one of the 8 drivers is on thread at a time.
+      ASSERT_EQ(task->maxRunningDrivers(), 1);
+      ASSERT_EQ(maxOnThreadDrivers, 1);
+    }
+  }
+}
+
 TEST_F(TaskTest, driverCreationMemoryAllocationCheck) {
   exec::Operator::registerOperator(std::make_unique<TestBadMemoryTranslator>());
   auto data = makeRowVector({
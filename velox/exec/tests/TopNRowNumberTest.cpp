@@ -243,6 +243,36 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(1, 1);
 }
 
+TEST_F(TopNRowNumberTest, limitsAroundInlineHeap) {
+  // 20 partitions of 500 rows each in random order, so that heaps of rows
+  // that are not stored inline grow and rows are replaced.
+  const vector_size_t size = 10'000;
+  auto data = split(
+      makeRowVector({
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 20; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return (row * 7'919) % 10'007; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      }),
+      10);
+
+  createDuckDbTable(data);
+
+  for (auto limit : {15, 16, 17, 40, 1'000}) {
+    SCOPED_TRACE(fmt::format("Limit: {}", limit));
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRowNumber({"c0"}, {"c1"}, limit, true)
+                    .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, row_number() over (partition by c0 order by c1) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            limit));
+  }
+}
+
 TEST_F(TopNRowNumberTest, abandonPartialEarly) {
   auto data = makeRowVector(
       {"p", "s"},
@@ -14,13 +14,15 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
-#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
-class TopNTest : public OperatorTestBase {
+class TopNTest : public HiveConnectorTestBase {
  protected:
   static std::vector<std::string> getSortOrderSqls() {
     return {"NULLS LAST", "NULLS FIRST", "DESC NULLS FIRST", "DESC NULLS LAST"};
@@ -284,6 +286,162 @@ TEST_F(TopNTest, onlyKeys) {
   testTwoKeys(vectors, "c0", "c1", 200);
 }
 
+TEST_F(TopNTest, thresholdFilter) {
+  const int32_t numFiles = 10;
+  const int32_t numRows = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  auto files = makeFilePaths(numFiles);
+  for (int32_t i = 0; i < numFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows, [&](auto row) { return i * numRows + row; }),
+        makeFlatVector<StringView>(
+            numRows,
+            [&](auto row) {
+              return StringView::makeInline(fmt::format("{:06}", i + row));
+            }),
+    }));
+    writeToFile(files[i]->getPath(), vectors.back());
+  }
+  createDuckDbTable(vectors);
+  const auto rowType = asRowType(vectors[0]->type());
+
+  for (const auto& key : {"c0", "c1"}) {
+    for (const auto& sortOrderSql : getSortOrderSqls()) {
+      const auto sql = fmt::format("{} {}", key, sortOrderSql);
+      SCOPED_TRACE(sql);
+      core::PlanNodeId scanId;
+      core::PlanNodeId topNId;
+      auto plan = PlanBuilder()
+                      .tableScan(rowType)
+                      .capturePlanNodeId(scanId)
+                      .topN({sql}, 10, false)
+                      .capturePlanNodeId(topNId)
+                      .planNode();
+      auto task = assertQueryOrdered(
+          plan,
+          makeHiveConnectorSplits(files),
+          fmt::format("SELECT * FROM tmp ORDER BY {} LIMIT 10", sql),
+          {rowType->getChildIdx(key)});
+
+      const auto planStats = toPlanStats(task->taskStats());
+      const auto& scanStats = planStats.at(scanId);
+      ASSERT_EQ(
+          scanStats.dynamicFilterStats.producerNodeIds,
+          std::unordered_set<core::PlanNodeId>({topNId}));
+      ASSERT_LT(scanStats.outputRows, numFiles * numRows);
+    }
+  }
+}
+
+TEST_F(TopNTest, thresholdFilterThroughJoin) {
+  const int32_t numFiles = 10;
+  const int32_t numRows = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  auto files = makeFilePaths(numFiles);
+  for (int32_t i = 0; i < numFiles; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows, [&](auto row) { return i * numRows + row; }),
+    }));
+    writeToFile(files[i]->getPath(), vectors.back());
+  }
+  createDuckDbTable("t", vectors);
+  // Every build key has a match, so the outer joins produce no null probe
+  // keys unless the probe rows are dropped below the join.
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u0"},
+      {makeFlatVector<int64_t>(
+          numFiles * numRows / 3, [](auto row) { return row * 3; })})};
+  createDuckDbTable("u", buildVectors);
+  const auto rowType = asRowType(vectors[0]->type());
+
+  struct {
+    core::JoinType joinType;
+    bool expectThresholdFilter;
+  } testSettings[] = {
+      {core::JoinType::kInner, true},
+      {core::JoinType::kLeft, true},
+      {core::JoinType::kRight, false},
+      {core::JoinType::kFull, false}};
+  for (const auto& testData : testSettings) {
+    for (const auto& sortOrderSql : getSortOrderSqls()) {
+      const auto sql = fmt::format("c0 {}", sortOrderSql);
+      SCOPED_TRACE(fmt::format(
+          "{} {}", core::joinTypeName(testData.joinType), sql));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      core::PlanNodeId scanId;
+      core::PlanNodeId topNId;
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .tableScan(rowType)
+                      .capturePlanNodeId(scanId)
+                      .hashJoin(
+                          {"c0"},
+                          {"u0"},
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(buildVectors)
+                              .planNode(),
+                          "",
+                          {"c0", "u0"},
+                          testData.joinType)
+                      .topN({sql}, 10, false)
+                      .capturePlanNodeId(topNId)
+                      .planNode();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .splits(scanId, makeHiveConnectorSplits(files))
+              .assertResults(
+                  fmt::format(
+                      "SELECT c0, u0 FROM t {} JOIN u ON c0 = u0 "
+                      "ORDER BY {} LIMIT 10",
+                      core::joinTypeName(testData.joinType),
+                      sql),
+                  {{0}});
+
+      const auto planStats = toPlanStats(task->taskStats());
+      ASSERT_EQ(
+          planStats.at(scanId).dynamicFilterStats.producerNodeIds.count(
+              topNId),
+          testData.expectThresholdFilter ? 1 : 0);
+    }
+  }
+}
+
+TEST_F(TopNTest, noThresholdFilterBelowLimit) {
+  const int32_t numFiles = 10;
+  const int32_t numRows = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  auto files = makeFilePaths(numFiles);
+  for (int32_t i = 0; i < numFiles; ++i) {
+    // The last file has the smallest values but is beyond the limit.
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRows,
+            [&](auto row) {
+              return i == numFiles - 1 ? -row - 1 : i * numRows + row;
+            }),
+    }));
+    writeToFile(files[i]->getPath(), vectors.back());
+  }
+  const auto rowType = asRowType(vectors[0]->type());
+
+  core::PlanNodeId scanId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType)
+                  .capturePlanNodeId(scanId)
+                  .limit(0, numRows * (numFiles / 2), false)
+                  .topN({"c0"}, 10, false)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .splits(makeHiveConnectorSplits(files))
+                  .assertResults(makeRowVector({makeFlatVector<int64_t>(
+                      10, [](auto row) { return row; })}));
+
+  const auto planStats = toPlanStats(task->taskStats());
+  ASSERT_TRUE(
+      planStats.at(scanId).dynamicFilterStats.producerNodeIds.empty());
+}
+
 TEST_F(TopNTest, planNodeValidation) {
   auto data = makeRowVector(
       ROW({"a", "b"},
@@ -406,6 +406,46 @@ TEST_F(UnnestTest, allEmptyOrNullMaps) {
   assertQueryReturnsEmptyResult(op);
 }
 
+TEST_F(UnnestTest, splitOutput) {
+  // Arrays of 0 to 9 elements, every 7th array is null.
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      makeArrayVector<int64_t>(
+          1'000,
+          [](auto row) { return row % 10; },
+          [](auto row, auto index) { return row * 10 + index; },
+          [](auto row) { return row % 7 == 0; }),
+      makeMapVector<int32_t, int64_t>(
+          1'000,
+          [](auto row) { return row % 4; },
+          [](auto row) { return row % 4; },
+          [](auto row) { return row; }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                  .capturePlanNodeId(unnestId)
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  for (const auto* batchRows : {"1", "3", "17", "100000"}) {
+    SCOPED_TRACE(batchRows);
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, batchRows)
+            .config(core::QueryConfig::kUnnestSplitOutput, "true")
+            .assertResults(expected);
+
+    // All batches but the last are full.
+    const auto stats = exec::toPlanStats(task->taskStats()).at(unnestId);
+    const auto maxRows = std::stoi(batchRows);
+    ASSERT_EQ(
+        (stats.outputRows + maxRows - 1) / maxRows, stats.outputVectors);
+  }
+}
+
 TEST_F(UnnestTest, batchSize) {
   auto data = makeRowVector({
       makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
@@ -457,4 +497,19 @@ TEST_F(UnnestTest, batchSize) {
     ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
     ASSERT_EQ(1, stats.at(unnestId).outputVectors);
   }
+
+  // With adaptive batch sizes, 17 rows per output are used until the size of
+  // the output rows is known. Then the batches are sized by bytes.
+  {
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "17")
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, "80000")
+            .config(core::QueryConfig::kAdaptiveOutputBatchSizeEnabled, "true")
+            .assertResults({expected});
+    auto stats = exec::toPlanStats(task->taskStats());
+
+    ASSERT_EQ(30'000, stats.at(unnestId).outputRows);
+    ASSERT_LT(stats.at(unnestId).outputVectors, 100);
+  }
 }
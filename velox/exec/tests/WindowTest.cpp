@@ -79,6 +79,94 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+TEST_F(WindowTest, parallelPartitions) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 17; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  // Each of the drivers reads all of 'data', so that every partition has rows
+  // from all the drivers.
+  const int32_t numDrivers = 4;
+  std::vector<RowVectorPtr> allData;
+  for (auto i = 0; i < numDrivers; ++i) {
+    allData.push_back(data);
+  }
+  createDuckDbTable(allData);
+
+  auto plan =
+      PlanBuilder()
+          .values(split(data, 5), true)
+          .window(
+              {"row_number() over (partition by p order by s, d)",
+               "sum(d) over (partition by p order by s)"})
+          .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kWindowParallelPartitions, "true")
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+      .maxDrivers(numDrivers)
+      .assertResults(
+          "SELECT *, row_number() over (partition by p order by s, d), "
+          "sum(d) over (partition by p order by s) "
+          "FROM tmp");
+
+  // A single driver does not wait for peers.
+  createDuckDbTable({data});
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kWindowParallelPartitions, "true")
+      .maxDrivers(1)
+      .assertResults(
+          "SELECT *, row_number() over (partition by p order by s, d), "
+          "sum(d) over (partition by p order by s) "
+          "FROM tmp");
+}
+
+TEST_F(WindowTest, streamingRankFunctions) {
+  // Sorted on (p, s). Partitions and peer groups span many input batches.
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<int16_t>(size, [](auto row) { return row / 3'000; }),
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 70; }),
+      });
+  createDuckDbTable({data});
+
+  auto plan = PlanBuilder()
+                  .values(split(data, 100))
+                  .streamingWindow(
+                      {"row_number() over (partition by p order by s)",
+                       "rank() over (partition by p order by s)",
+                       "dense_rank() over (partition by p order by s)"})
+                  .project({"d", "p", "s", "w1", "w2"})
+                  .planNode();
+
+  // row_number() is not deterministic within peers, so it is not compared.
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+      .assertResults(
+          "SELECT d, p, s, rank() over (partition by p order by s), "
+          "dense_rank() over (partition by p order by s) FROM tmp");
+
+  plan = PlanBuilder()
+             .values(split(data, 100))
+             .streamingWindow({"row_number() over (partition by p order by s)"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT *, row_number() over (partition by p order by s, d) "
+          "FROM tmp");
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/WorkStealingExecutor.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+class WorkStealingExecutorTest : public OperatorTestBase {};
+
+TEST_F(WorkStealingExecutorTest, basic) {
+  std::atomic<int32_t> count{0};
+  std::atomic<int32_t> numNonWorker{0};
+  {
+    WorkStealingExecutor executor(4);
+    ASSERT_EQ(executor.numThreads(), 4);
+    ASSERT_EQ(executor.currentWorker(), -1);
+    for (auto i = 0; i < 10'000; ++i) {
+      executor.add([&]() {
+        if (executor.currentWorker() < 0) {
+          ++numNonWorker;
+        }
+        ++count;
+      });
+    }
+    // The destructor runs the remaining tasks.
+  }
+  ASSERT_EQ(count, 10'000);
+  ASSERT_EQ(numNonWorker, 0);
+}
+
+TEST_F(WorkStealingExecutorTest, addFromWorker) {
+  std::atomic<int32_t> count{0};
+  {
+    WorkStealingExecutor executor(1);
+    std::function<void(int32_t)> addTask = [&](int32_t depth) {
+      executor.add([&, depth]() {
+        // With one worker, tasks added by a task run on the same worker.
+        EXPECT_EQ(executor.currentWorker(), 0);
+        ++count;
+        if (depth > 0) {
+          addTask(depth - 1);
+        }
+      });
+    };
+    for (auto i = 0; i < 100; ++i) {
+      addTask(10);
+    }
+  }
+  ASSERT_EQ(count, 100 * 11);
+
+  // Tasks that add tasks to their own queue are stolen by idle workers.
+  count = 0;
+  {
+    WorkStealingExecutor executor(8);
+    std::function<void(int32_t)> addTask = [&](int32_t depth) {
+      executor.add([&, depth]() {
+        ++count;
+        if (depth > 0) {
+          addTask(depth - 1);
+          addTask(depth - 1);
+        }
+      });
+    };
+    addTask(12);
+  }
+  ASSERT_EQ(count, (1 << 13) - 1);
+}
+
+TEST_F(WorkStealingExecutorTest, query) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  createDuckDbTable({data, data, data, data});
+
+  // Each of the 4 drivers of the Values node produces 'data'.
+  auto executor = std::make_unique<WorkStealingExecutor>(4);
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .partialAggregation({"c0"}, {"sum(c1)"})
+                  .localPartition({"c0"})
+                  .finalAggregation()
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .queryCtx(core::QueryCtx::create(executor.get()))
+      .maxDrivers(4)
+      .assertResults("SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+}
+
+} // namespace facebook::velox::exec::test
@@ -1330,7 +1330,8 @@ PlanBuilder& PlanBuilder::hashJoin(
     const std::string& filter,
     const std::vector<std::string>& outputLayout,
     core::JoinType joinType,
-    bool nullAware) {
+    bool nullAware,
+    bool useHashTableCache) {
   VELOX_CHECK_NOT_NULL(planNode_, "HashJoin cannot be the source node");
   VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
 
@@ -1371,7 +1372,8 @@ PlanBuilder& PlanBuilder::hashJoin(
       std::move(filterExpr),
       std::move(planNode_),
       build,
-      outputType);
+      outputType,
+      useHashTableCache);
   return *this;
 }
 
@@ -1823,6 +1825,22 @@ PlanBuilder& PlanBuilder::markDistinct(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::markDistinct(
+    std::vector<std::string> markerKeys,
+    const std::vector<std::vector<std::string>>& distinctKeys) {
+  VELOX_CHECK_NOT_NULL(planNode_, "MarkDistinct cannot be the source node");
+  std::vector<std::vector<core::FieldAccessTypedExprPtr>> distinctKeyFields;
+  for (const auto& keys : distinctKeys) {
+    distinctKeyFields.push_back(fields(planNode_->outputType(), keys));
+  }
+  planNode_ = std::make_shared<core::MarkDistinctNode>(
+      nextPlanNodeId(),
+      std::move(markerKeys),
+      std::move(distinctKeyFields),
+      planNode_);
+  return *this;
+}
+
 core::PlanNodeId PlanBuilder::nextPlanNodeId() {
   return planNodeIdGenerator_->next();
 }
@@ -827,6 +827,8 @@ class PlanBuilder {
   /// @param joinType Type of the join: inner, left, right, full, semi, or anti.
   /// @param nullAware Applies to semi and anti joins. Indicates whether the
   /// join follows IN (null-aware) or EXISTS (regular) semantic.
+  /// @param useHashTableCache If true, the tasks of the same query share a
+  /// single copy of the build side hash table.
   PlanBuilder& hashJoin(
       const std::vector<std::string>& leftKeys,
       const std::vector<std::string>& rightKeys,
@@ -834,7 +836,8 @@ class PlanBuilder {
       const std::string& filter,
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner,
-      bool nullAware = false);
+      bool nullAware = false,
+      bool useHashTableCache = false);
 
   /// Add a MergeJoinNode to join two inputs using one or more join keys and an
   /// optional filter. The caller is responsible to ensure that inputs are
@@ -952,6 +955,15 @@ class PlanBuilder {
       std::string markerKey,
       const std::vector<std::string>& distinctKeys);
 
+  /// Add a MarkDistinctNode computing several aggregate mask channels in one
+  /// operator.
+  /// @param markerKeys Names of output mask channels
+  /// @param distinctKeys Columns to be marked distinct for each of
+  /// 'markerKeys'.
+  PlanBuilder& markDistinct(
+      std::vector<std::string> markerKeys,
+      const std::vector<std::vector<std::string>>& distinctKeys);
+
   /// Stores the latest plan node ID into the specified variable. Useful for
   /// capturing IDs of the leaf plan nodes (table scans, exchanges, etc.) to use
   /// when adding splits at runtime.
@@ -19,6 +19,12 @@
 
 DECLARE_int32(wave_reader_rows_per_tb);
 
+DEFINE_bool(
+    wave_pinned_staging,
+    true,
+    "Copy scan data to the device from pinned host memory asynchronously "
+    "instead of writing it to unified memory from the host thread");
+
 namespace facebook::velox::wave {
 
 BufferId SplitStaging::add(Staging& staging) {
@@ -49,11 +55,24 @@ void SplitStaging::transfer(WaveStream& waveStream, Stream& stream) {
   }
   deviceBuffer_ = waveStream.arena().allocate<char>(fill_);
   auto universal = deviceBuffer_->as<char>();
-  for (auto i = 0; i < offsets_.size(); ++i) {
-    memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+  if (FLAGS_wave_pinned_staging) {
+    // Gathers the pieces in pinned memory and copies them with one DMA on
+    // 'stream'. The copy overlaps with the kernels and copies of other
+    // streams and the host does not wait for it. 'hostBuffer_' is kept until
+    // 'this' is freed, after the work on 'stream' has completed.
+    hostBuffer_ = waveStream.hostArena().allocate<char>(fill_);
+    auto pinned = hostBuffer_->as<char>();
+    for (auto i = 0; i < offsets_.size(); ++i) {
+      memcpy(pinned + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
+    stream.hostToDeviceAsync(universal, pinned, fill_);
+  } else {
+    for (auto i = 0; i < offsets_.size(); ++i) {
+      memcpy(universal + offsets_[i], staging_[i].hostData, staging_[i].size);
+    }
+    stream.prefetch(
+        getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
   }
-  stream.prefetch(
-      getDevice(), deviceBuffer_->as<char>(), deviceBuffer_->size());
   for (auto& pair : patch_) {
     *reinterpret_cast<int64_t*>(pair.second) +=
         reinterpret_cast<int64_t>(universal) + offsets_[pair.first];
@@ -73,7 +73,9 @@ class SplitStaging {
   int64_t bytesToDevice() const {
     return fill_;
   }
-  // Starts the transfers registered with add( on 'stream').
+  // Starts the transfers registered with add( on 'stream'). The data is
+  // staged in pinned host memory from the host arena of 'waveStream' and
+  // copied asynchronously unless --wave_pinned_staging is false.
   void transfer(WaveStream& waveStream, Stream& stream);
 
  private:
@@ -75,6 +75,7 @@ enum class DecodeStep {
   kRleTotalLength,
   kRleBool,
   kRle,
+  kRleBitpack,
   kDictionary,
   kDictionaryOnBitpack,
   kVarint,
@@ -306,6 +307,23 @@ struct alignas(16) GpuDecode {
     const void* result;
   };
 
+  struct RleBitpack {
+    // Parquet RLE/bit-packed hybrid data without the length prefix, e.g.
+    // repetition or definition levels or dictionary indices.
+    const uint8_t* input;
+    // Byte size of 'input'.
+    int32_t size;
+    // Bit width of each value, at most 32.
+    int32_t bitWidth;
+    // Number of values to decode. The last bit-packed run may have padding
+    // past this.
+    int32_t numValues;
+    // Type of the result, SMALLINT for levels or INTEGER for indices.
+    WaveTypeKind resultType;
+    // Starting address of the result.
+    void* result;
+  };
+
   struct MakeScatterIndices {
     // Input bits.
     const uint8_t* bits;
@@ -359,6 +377,7 @@ struct alignas(16) GpuDecode {
     SparseBool sparseBool;
     RleTotalLength rleTotalLength;
     Rle rle;
+    RleBitpack rleBitpack;
     MakeScatterIndices makeScatterIndices;
     RowCountNoFilter rowCountNoFilter;
     CountBits countBits;
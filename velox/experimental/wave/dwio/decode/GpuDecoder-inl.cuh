@@ -500,6 +500,111 @@ __device__ void decodeRle(GpuDecode& plan) {
   }
 }
 
+// Runs of Parquet RLE/bit-packed hybrid data parsed by one thread for the
+// whole TB.
+template <int32_t kBlockSize>
+struct RleBitpackRuns {
+  // First value of each run, followed by the end of the last run.
+  int32_t starts[kBlockSize + 1];
+  // Bit offset of the values of a bit-packed run in the input, -1 for an RLE
+  // run.
+  int32_t bitOffsets[kBlockSize];
+  // The repeated value of an RLE run.
+  uint32_t values[kBlockSize];
+  int32_t numRuns;
+  // Byte offset of the next run header in the input.
+  int32_t position;
+};
+
+// The run headers are a sequential varint stream, so thread 0 parses up to
+// kBlockSize runs at a time and the TB then expands them in parallel.
+template <int kBlockSize, typename T>
+__device__ void decodeRleBitpack(GpuDecode::RleBitpack& op) {
+  extern __shared__ char smem[];
+  auto* runs = reinterpret_cast<RleBitpackRuns<kBlockSize>*>(smem);
+  auto* input = reinterpret_cast<const char*>(op.input);
+  auto* result = reinterpret_cast<T*>(op.result);
+  const int32_t valueBytes = (op.bitWidth + 7) / 8;
+  int32_t row = 0;
+  if (threadIdx.x == 0) {
+    runs->position = 0;
+  }
+  for (;;) {
+    if (threadIdx.x == 0) {
+      const char* pos = input + runs->position;
+      const char* end = input + op.size;
+      int32_t numRuns = 0;
+      int32_t start = row;
+      while (numRuns < kBlockSize && start < op.numValues && pos < end) {
+        const auto header = readVarint32(&pos);
+        runs->starts[numRuns] = start;
+        if (header & 1) {
+          // Groups of 8 bit-packed values.
+          const int32_t numGroups = header >> 1;
+          runs->bitOffsets[numRuns] = (pos - input) * 8;
+          start += numGroups * 8;
+          pos += numGroups * op.bitWidth;
+        } else {
+          // A little endian value repeated 'header >> 1' times.
+          uint32_t value = 0;
+          for (auto i = 0; i < valueBytes; ++i) {
+            value |= static_cast<uint32_t>(static_cast<uint8_t>(pos[i]))
+                << (8 * i);
+          }
+          runs->bitOffsets[numRuns] = -1;
+          runs->values[numRuns] = value;
+          start += header >> 1;
+          pos += valueBytes;
+        }
+        ++numRuns;
+      }
+      runs->starts[numRuns] = min(start, op.numValues);
+      runs->numRuns = numRuns;
+      runs->position = pos - input;
+    }
+    __syncthreads();
+    const int32_t numRuns = runs->numRuns;
+    if (numRuns == 0) {
+      break;
+    }
+    const int32_t end = runs->starts[numRuns];
+    for (int32_t i = row + threadIdx.x; i < end; i += blockDim.x) {
+      const auto run = upperBound(runs->starts, numRuns, i) - 1;
+      const auto bitOffset = runs->bitOffsets[run];
+      result[i] = bitOffset < 0
+          ? runs->values[run]
+          : loadBits32(
+                input,
+                bitOffset + (i - runs->starts[run]) * op.bitWidth,
+                op.bitWidth);
+    }
+    row = end;
+    // All threads are done with 'runs' before thread 0 refills it.
+    __syncthreads();
+  }
+}
+
+template <int kBlockSize>
+__device__ void decodeRleBitpack(GpuDecode& plan) {
+  auto& op = plan.data.rleBitpack;
+  switch (op.resultType) {
+    case WaveTypeKind::TINYINT:
+      decodeRleBitpack<kBlockSize, uint8_t>(op);
+      break;
+    case WaveTypeKind::SMALLINT:
+      decodeRleBitpack<kBlockSize, uint16_t>(op);
+      break;
+    case WaveTypeKind::INTEGER:
+      decodeRleBitpack<kBlockSize, uint32_t>(op);
+      break;
+    default:
+      if (threadIdx.x == 0) {
+        printf("ERROR: Unsupported result type for RleBitpack\n");
+        assert(false);
+      }
+  }
+}
+
 template <int kBlockSize>
 __device__ void makeScatterIndices(GpuDecode::MakeScatterIndices& op) {
   auto indicesCount = scatterIndices<kBlockSize>(
@@ -515,6 +620,11 @@ inline __device__ T randomAccessDecode(const GpuDecode* op, int32_t idx) {
     case DecodeStep::kDictionaryOnBitpack: {
       const auto& d = op->data.dictionaryOnBitpack;
       auto width = d.bitWidth;
+      if (d.alphabet) {
+        // Filters see the dictionary value. Indices are at most 32 bits.
+        return reinterpret_cast<const T*>(
+            d.alphabet)[loadBits32(d.indices, idx * width, width)];
+      }
       if (sizeof(T) == 4 || width <= 32) {
         return loadBits32(d.indices, idx * width, width) + d.baseline;
       } else {
@@ -883,6 +993,9 @@ __device__ void decodeSwitch(GpuDecode& op) {
     case DecodeStep::kRle:
       detail::decodeRle<kBlockSize>(op);
       break;
+    case DecodeStep::kRleBitpack:
+      detail::decodeRleBitpack<kBlockSize>(op);
+      break;
     case DecodeStep::kMakeScatterIndices:
       detail::makeScatterIndices<kBlockSize>(op.data.makeScatterIndices);
       break;
@@ -926,6 +1039,8 @@ int32_t sharedMemorySizeForDecode(DecodeStep step) {
     case DecodeStep::kMakeScatterIndices:
     case DecodeStep::kLengthToOffset:
       return sizeof(typename BlockScan32::TempStorage);
+    case DecodeStep::kRleBitpack:
+      return sizeof(RleBitpackRuns<kBlockSize>);
     default:
       assert(false); // Undefined.
       return 0;
@@ -128,6 +128,61 @@ void makeBitpackDict(
       reinterpret_cast<T*>(memory), dictBytes + bitBytes + scatterBytes);
 }
 
+void appendVarint(uint32_t value, std::vector<uint8_t>& out) {
+  while (value >= 128) {
+    out.push_back(0x80 | (value & 0x7f));
+    value >>= 7;
+  }
+  out.push_back(value);
+}
+
+int32_t runLength(const std::vector<uint32_t>& values, int32_t begin) {
+  auto end = begin;
+  while (end < values.size() && values[end] == values[begin]) {
+    ++end;
+  }
+  return end - begin;
+}
+
+// Encodes 'values' as Parquet RLE/bit-packed hybrid data. Runs of 8 or more
+// equal values are RLE encoded and the rest is bit-packed in groups of 8.
+std::vector<uint8_t> encodeRleBitpack(
+    const std::vector<uint32_t>& values,
+    int32_t bitWidth) {
+  const int32_t numValues = values.size();
+  std::vector<uint8_t> out;
+  int32_t i = 0;
+  while (i < numValues) {
+    auto length = runLength(values, i);
+    if (length >= 8) {
+      appendVarint(length << 1, out);
+      for (auto byte = 0; byte < (bitWidth + 7) / 8; ++byte) {
+        out.push_back(values[i] >> (8 * byte));
+      }
+      i += length;
+      continue;
+    }
+    const auto begin = i;
+    int32_t numGroups = 0;
+    while (i < numValues && runLength(values, i) < 8) {
+      i = std::min(i + 8, numValues);
+      ++numGroups;
+    }
+    appendVarint((numGroups << 1) | 1, out);
+    const auto bitsStart = out.size();
+    out.resize(bitsStart + numGroups * bitWidth);
+    for (auto j = 0; j < numGroups * 8; ++j) {
+      const uint64_t value = begin + j < i ? values[begin + j] : 0;
+      for (auto bit = 0; bit < bitWidth; ++bit) {
+        if (value & (1UL << bit)) {
+          setBit(&out[bitsStart], j * bitWidth + bit);
+        }
+      }
+    }
+  }
+  return out;
+}
+
 class GpuDecoderTest : public ::testing::Test {
  protected:
   void SetUp() override {
@@ -548,6 +603,107 @@ class GpuDecoderTest : public ::testing::Test {
     }
   }
 
+  template <typename T, int kBlockSize>
+  void testRleBitpack(int32_t bitWidth, int32_t numValues, int32_t numBlocks) {
+    // Runs of 1000 equal values alternate with random values.
+    std::vector<uint64_t> random(numValues);
+    fillRandom(random.data(), numValues);
+    std::vector<uint32_t> values(numValues);
+    const uint32_t mask = (1U << bitWidth) - 1;
+    for (auto i = 0; i < numValues; ++i) {
+      values[i] = ((i / 1000) % 2 == 0 ? random[i / 1000] : random[i]) & mask;
+    }
+    auto encoded = encodeRleBitpack(values, bitWidth);
+    // Bits are loaded by 32 bit words and may read past the end.
+    auto input = allocate<uint8_t>(encoded.size() + 8);
+    memcpy(input.get(), encoded.data(), encoded.size());
+    auto result = allocate<T>(numValues * numBlocks);
+    auto ops = allocate<GpuDecode>(numBlocks);
+    for (auto i = 0; i < numBlocks; ++i) {
+      ops[i].step = DecodeStep::kRleBitpack;
+      auto& op = ops[i].data.rleBitpack;
+      op.input = input.get();
+      op.size = encoded.size();
+      op.bitWidth = bitWidth;
+      op.numValues = numValues;
+      op.resultType =
+          sizeof(T) == 2 ? WaveTypeKind::SMALLINT : WaveTypeKind::INTEGER;
+      op.result = result.get() + i * numValues;
+    }
+    testCase(
+        fmt::format("rle bitpack bitWidth={}", bitWidth),
+        [&] { decodeGlobal<kBlockSize>(ops.get(), numBlocks); },
+        numValues * numBlocks * sizeof(T),
+        3);
+    for (auto i = 0; i < numBlocks; ++i) {
+      for (auto j = 0; j < numValues; ++j) {
+        ASSERT_EQ(result[i * numValues + j], values[j]) << i << " " << j;
+      }
+    }
+  }
+
+  // Decodes bit-packed dictionary indices with a range filter on the
+  // dictionary values.
+  void testSelectiveDictionary(int32_t bitWidth, int32_t numLoops) {
+    constexpr int32_t kBlockSize = 256;
+    const int32_t numRows = numLoops * kBlockSize;
+    gpu::CudaPtr<char[]> ptr;
+    int64_t* dict;
+    uint64_t* bits;
+    int64_t* result;
+    makeBitpackDict(bitWidth, numRows, ptr, dict, bits, result, nullptr);
+    auto status = allocate<BlockStatus>(numLoops);
+    auto resultRows = allocate<int32_t>(numRows);
+    auto temp = allocate<int32_t>(kBlockSize);
+    auto ops = allocate<GpuDecode>(1);
+    auto& op = ops[0];
+    op.step = DecodeStep::kSelective64;
+    op.encoding = DecodeStep::kDictionaryOnBitpack;
+    op.dataType = WaveTypeKind::BIGINT;
+    op.nullMode = NullMode::kDenseNonNull;
+    op.numRowsPerThread = numLoops;
+    op.baseRow = 0;
+    op.maxRow = numRows;
+    op.blockStatus = status.get();
+    op.filterRowCount = nullptr;
+    op.temp = temp.get();
+    op.resultRows = resultRows.get();
+    op.resultNulls = nullptr;
+    op.result = result;
+    const int64_t lower = dict[10];
+    const int64_t upper = dict[100];
+    op.filterKind = WaveFilterKind::kBigintRange;
+    op.filter.int64Range[0] = lower;
+    op.filter.int64Range[1] = upper;
+    auto& d = op.data.dictionaryOnBitpack;
+    d.dataType = WaveTypeKind::BIGINT;
+    d.alphabet = dict;
+    d.indices = bits;
+    d.bitWidth = bitWidth;
+    d.baseline = 0;
+    decodeGlobal<kBlockSize>(ops.get(), 1);
+    CUDA_CHECK_FATAL(cudaGetLastError());
+    CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+    const uint64_t mask = (1UL << bitWidth) - 1;
+    for (auto loop = 0; loop < numLoops; ++loop) {
+      int32_t numHits = 0;
+      for (auto i = 0; i < kBlockSize; ++i) {
+        const auto row = loop * kBlockSize + i;
+        const auto index = (*addBytes(bits, row * bitWidth / 8) >>
+                            (row * bitWidth % 8)) &
+            mask;
+        const auto value = dict[index];
+        if (value < lower || value > upper) {
+          continue;
+        }
+        const auto resultIdx = loop * kBlockSize + numHits++;
+        ASSERT_EQ(resultRows[resultIdx], row);
+        ASSERT_EQ(result[resultIdx], value);
+      }
+      ASSERT_EQ(status[loop].numRows, numHits);
+    }
+  }
+
   void testCountBits(int32_t numWords, int32_t stride) {
     auto bits = allocate<uint8_t>(numWords * 8);
     fillRandomBits(bits.get(), 0.5, numWords * 64);
@@ -621,6 +777,17 @@ TEST_F(GpuDecoderTest, rle) {
   testRle<int64_t, 256>(40'000'003, 1024);
 }
 
+TEST_F(GpuDecoderTest, rleBitpack) {
+  // Definition levels, small and large dictionary indices.
+  testRleBitpack<uint16_t, 256>(1, 100'003, 64);
+  testRleBitpack<uint32_t, 256>(5, 100'003, 64);
+  testRleBitpack<uint32_t, 256>(17, 100'003, 64);
+}
+
+TEST_F(GpuDecoderTest, selectiveDictionary) {
+  testSelectiveDictionary(11, 4);
+}
+
 TEST_F(GpuDecoderTest, makeScatterIndices) {
   testMakeScatterIndices<256>(40013, 1024);
 }
@@ -20,6 +20,11 @@
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/experimental/wave/exec/Vectors.h"
 
+DEFINE_int32(
+    velox_wave_aggregation_key_cardinality,
+    4,
+    "Most distinct values of each grouping key of an aggregation on the GPU");
+
 #define KEY_TYPE_DISPATCH(_func, _kindExpr, ...)              \
   [&]() {                                                     \
     auto _kind = (_kindExpr);                                 \
@@ -39,9 +44,36 @@ namespace facebook::velox::wave {
 
 namespace {
 
-constexpr int kInitialNumGroups = 16;
 constexpr int kInitialTableCapacity = 64;
 
+// Returns the number of groups for 'numKeys' keys with 'keyCardinality'
+// values each or -1 if it is more than Aggregation::kMaxGroups.
+int32_t numGroups(int32_t numKeys, int32_t keyCardinality) {
+  int64_t result = 1;
+  for (auto i = 0; i < numKeys; ++i) {
+    result *= keyCardinality;
+    if (result > Aggregation::kMaxGroups) {
+      return -1;
+    }
+  }
+  return result;
+}
+
+bool isWaveType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
 template <typename T>
 Aggregation::IdMapHolder createIdMap(GpuArena& arena, int capacity) {
   Aggregation::IdMapHolder holder;
@@ -75,6 +107,47 @@ void Aggregation::toAggregateInfo(
   VELOX_CHECK_NOT_NULL(out->function);
 }
 
+// static
+bool Aggregation::canRun(
+    const core::AggregationNode& node,
+    const aggregation::AggregateFunctionRegistry& functionRegistry) {
+  if (node.step() != core::AggregationNode::Step::kSingle ||
+      !node.preGroupedKeys().empty() || !node.globalGroupingSets().empty() ||
+      FLAGS_velox_wave_aggregation_key_cardinality < 1 ||
+      numGroups(
+          node.groupingKeys().size(),
+          FLAGS_velox_wave_aggregation_key_cardinality) < 0) {
+    return false;
+  }
+  const auto& inputType = node.sources()[0]->outputType();
+  for (const auto& key : node.groupingKeys()) {
+    const auto kind = key->type()->kind();
+    if (kind != TypeKind::INTEGER && kind != TypeKind::BIGINT &&
+        kind != TypeKind::VARCHAR) {
+      return false;
+    }
+  }
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.mask || aggregate.distinct ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    std::vector<PhysicalType> argTypes;
+    for (const auto& arg : aggregate.call->inputs()) {
+      const auto channel = exec::exprToChannel(arg.get(), inputType);
+      if (channel == kConstantChannel ||
+          !isWaveType(*inputType->childAt(channel))) {
+        return false;
+      }
+      argTypes.push_back(fromCpuType(*inputType->childAt(channel)));
+    }
+    if (!functionRegistry.getFunction(aggregate.call->name(), argTypes)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 Aggregation::Aggregation(
     CompileState& state,
     const core::AggregationNode& node,
@@ -90,7 +163,10 @@ Aggregation::Aggregation(
       1, containerHolder_.container);
   container_->numKeys = node.groupingKeys().size();
   container_->numAggregates = node.aggregates().size();
-  container_->numGroups = kInitialNumGroups;
+  container_->keyCardinality = FLAGS_velox_wave_aggregation_key_cardinality;
+  container_->numGroups =
+      numGroups(container_->numKeys, container_->keyCardinality);
+  VELOX_CHECK_GT(container_->numGroups, 0);
   container_->actualNumGroups = 0;
   container_->keyTypes = arena_->allocate<PhysicalType>(
       container_->numKeys, containerHolder_.keyTypes);
@@ -108,8 +184,12 @@ Aggregation::Aggregation(
     keyChannels_[i] = j;
     container_->keyTypes[i] = fromCpuType(*inputType->childAt(j));
     auto kind = container_->keyTypes[i].kind;
+    // Leaves room for the IdMap to report more than 'keyCardinality' values.
+    const auto tableCapacity = std::max<int32_t>(
+        kInitialTableCapacity,
+        bits::nextPowerOfTwo(2 * container_->keyCardinality));
     containerHolder_.idMapHolders[i] =
-        KEY_TYPE_DISPATCH(createIdMap, kind, *arena_, kInitialTableCapacity);
+        KEY_TYPE_DISPATCH(createIdMap, kind, *arena_, tableCapacity);
     container_->idMaps[i] = containerHolder_.idMapHolders[i].idMap->as<void*>();
     containerHolder_.keys[i] =
         KEY_TYPE_DISPATCH(arena_->allocate, kind, container_->numGroups);
@@ -203,6 +283,7 @@ void Aggregation::normalizeKeys() {
     programs[j].instructions = instructions;
   }
   auto* status = getStatus(numBlocks, holder.status);
+  holder.numBlocks = numBlocks;
   aggregation::call(*flushStream_, numBlocks, programs, nullptr, status, 0);
 }
 
@@ -235,18 +316,40 @@ void Aggregation::doAggregates() {
     }
   }
   auto* status = getStatus(aggregates_.size(), holder.status);
+  holder.numBlocks = aggregates_.size();
   aggregation::call(
       *flushStream_, aggregates_.size(), programs, nullptr, status, 0);
 }
 
 void Aggregation::waitFlushDone() {
   flushDone_.wait();
+  checkFlushStatus(normalizeKeysHolder_);
+  checkFlushStatus(aggregateHolder_);
   for (auto& input : inputs_) {
     stats_.ingestedRowCount += input->size();
   }
   stats_.gpuTimeMs += flushDone_.elapsedTime(flushStart_);
 }
 
+void Aggregation::checkFlushStatus(const ProgramsHolder& holder) const {
+  const auto* status = holder.status->as<BlockStatus>();
+  for (auto i = 0; i < holder.numBlocks; ++i) {
+    for (auto j = 0; j < kBlockSize; ++j) {
+      switch (status[i].errors[j]) {
+        case ErrorCode::kOk:
+          continue;
+        case ErrorCode::kInsufficientMemory:
+          VELOX_FAIL(
+              "Grouping key of Wave aggregation has more than {} distinct "
+              "values. Increase --velox_wave_aggregation_key_cardinality",
+              container_->keyCardinality);
+        default:
+          VELOX_FAIL("Wave aggregation failed");
+      }
+    }
+  }
+}
+
 void Aggregation::flush(bool noMoreInput) {
   if (noMoreInput) {
     if (!noMoreInput_) {
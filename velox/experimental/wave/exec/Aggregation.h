@@ -25,6 +25,19 @@ namespace facebook::velox::wave {
 
 class Aggregation : public WaveOperator {
  public:
+  /// Most groups of an aggregation on the GPU. Each group has an accumulator
+  /// per thread of a block for each aggregate.
+  static constexpr int32_t kMaxGroups = 4096;
+
+  /// Returns true if 'node' can run on the GPU. This requires a single step
+  /// aggregation on INTEGER, BIGINT or VARCHAR keys with aggregates over
+  /// columns that 'functionRegistry' has, and at most kMaxGroups groups for
+  /// --velox_wave_aggregation_key_cardinality values of each key. Other
+  /// aggregations stay on the CPU.
+  static bool canRun(
+      const core::AggregationNode& node,
+      const aggregation::AggregateFunctionRegistry& functionRegistry);
+
   Aggregation(
       CompileState&,
       const core::AggregationNode&,
@@ -77,6 +90,7 @@ class Aggregation : public WaveOperator {
   struct ProgramsHolder {
     WaveBufferPtr programs;
     WaveBufferPtr status;
+    int32_t numBlocks{0};
     WaveBufferPtr instructions;
     std::vector<WaveBufferPtr> operands;
     std::vector<WaveVectorPtr> results;
@@ -87,6 +101,10 @@ class Aggregation : public WaveOperator {
   void doAggregates();
   void waitFlushDone();
 
+  // Throws if a block of the last flush failed, e.g. because a key has more
+  // distinct values than the groups have room for.
+  void checkFlushStatus(const ProgramsHolder& holder) const;
+
   GpuArena* arena_;
   std::shared_ptr<aggregation::AggregateFunctionRegistry> functionRegistry_;
 
@@ -78,23 +78,25 @@ namespace facebook::velox::wave::aggregation {
 
 namespace {
 
-constexpr int kNormalizationRadix = 4;
-
 struct BlockInfo {
   int base;
   char* shared;
 };
 
 template <typename T>
-__device__ ErrorCode
-normalize(BlockInfo* block, void* idMap, Operand* key, int32_t& result) {
+__device__ ErrorCode normalize(
+    BlockInfo* block,
+    void* idMap,
+    Operand* key,
+    int32_t radix,
+    int32_t& result) {
   auto* typedIdMap = reinterpret_cast<IdMap<T>*>(idMap);
   auto id = typedIdMap->makeId(value<T>(key, block->base, block->shared));
-  if (id == -1) {
+  // The key has more distinct values than there are groups for.
+  if (id == -1 || id > radix) {
     return ErrorCode::kInsufficientMemory;
   }
-  assert(typedIdMap->cardinality() <= kNormalizationRadix);
-  result = kNormalizationRadix * result + id - 1;
+  result = radix * result + id - 1;
   return ErrorCode::kOk;
 }
 
@@ -125,6 +127,7 @@ __device__ ErrorCode run(BlockInfo* block, NormalizeKeys* normalizeKeys) {
         block,
         container->idMaps[i],
         &normalizeKeys->inputs[i],
+        container->keyCardinality,
         result));
   }
   assert(result < container->numGroups);
@@ -34,6 +34,9 @@ struct GroupsContainer {
   int32_t numAggregates;
   int32_t numGroups;
   int32_t actualNumGroups;
+  // Most distinct values of each key. 'numGroups' is 'keyCardinality' to the
+  // power of 'numKeys'.
+  int32_t keyCardinality;
   PhysicalType* keyTypes;
   void** idMaps;
   Group* groups;
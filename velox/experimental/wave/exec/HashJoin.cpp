@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoin.h"
+
+#include <numeric>
+
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/WaveDriver.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+bool isKeyType(const Type& type) {
+  return type.kind() == TypeKind::INTEGER || type.kind() == TypeKind::BIGINT;
+}
+
+// Returns true for types whose values are copied as they are by
+// join::gather().
+bool isFixedWidth(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the type of the rows of the CPU hash table: the build side keys
+// followed by the other build side columns.
+RowTypePtr makeTableType(const core::HashJoinNode& node) {
+  const auto& buildType = node.sources()[1]->outputType();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  std::unordered_set<column_index_t> keyChannels;
+  for (const auto& key : node.rightKeys()) {
+    const auto channel = buildType->getChildIdx(key->name());
+    names.push_back(buildType->nameOf(channel));
+    types.push_back(buildType->childAt(channel));
+    keyChannels.insert(channel);
+  }
+  for (auto i = 0; i < buildType->size(); ++i) {
+    if (keyChannels.count(i) == 0) {
+      names.push_back(buildType->nameOf(i));
+      types.push_back(buildType->childAt(i));
+    }
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+// Copies 'source' to a new WaveVector in 'arena'.
+WaveVectorPtr toWaveVector(const BaseVector& source, GpuArena& arena) {
+  const auto size = source.size();
+  auto result = WaveVector::create(source.type(), arena);
+  result->resize(size, source.mayHaveNulls());
+  if (size == 0) {
+    return result;
+  }
+  std::memcpy(
+      result->values<char>(),
+      source.values()->as<char>(),
+      size * source.type()->cppSizeInBytes());
+  if (source.mayHaveNulls()) {
+    auto* nulls = result->nulls();
+    for (auto i = 0; i < size; ++i) {
+      nulls[i] = source.isNullAt(i) ? kNull : kNotNull;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+// static
+bool HashJoin::canRun(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter() || node.isNullAware()) {
+    return false;
+  }
+  std::unordered_set<std::string> buildKeyNames;
+  for (auto i = 0; i < node.leftKeys().size(); ++i) {
+    const auto& probeKey = *node.leftKeys()[i]->type();
+    const auto& buildKey = *node.rightKeys()[i]->type();
+    if (!isKeyType(probeKey) || probeKey.kind() != buildKey.kind() ||
+        !buildKeyNames.insert(node.rightKeys()[i]->name()).second) {
+      return false;
+    }
+  }
+  for (const auto& type : node.outputType()->children()) {
+    if (!isFixedWidth(*type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+HashJoin::HashJoin(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType(), node.id()),
+      probeType_(node.sources()[0]->outputType()),
+      tableType_(makeTableType(node)),
+      arena_(&state.arena()) {
+  VELOX_CHECK(canRun(node));
+  isExpanding_ = true;
+  for (const auto& key : node.leftKeys()) {
+    probeKeyChannels_.push_back(probeType_->getChildIdx(key->name()));
+  }
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    const auto& name = outputType_->nameOf(i);
+    if (auto channel = probeType_->getChildIdxIfExists(name)) {
+      probeProjections_.emplace_back(i, channel.value());
+    } else {
+      buildProjections_.emplace_back(i, tableType_->getChildIdx(name));
+    }
+  }
+}
+
+HashJoin::~HashJoin() {
+  if (probeStream_) {
+    WaveStream::releaseStream(std::move(probeStream_));
+  }
+}
+
+exec::BlockingReason HashJoin::isBlocked(ContinueFuture* future) {
+  if (joinTable_ || tryLoadTable(future)) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  return exec::BlockingReason::kWaitForJoinBuild;
+}
+
+bool HashJoin::tryLoadTable(ContinueFuture* future) {
+  auto* operatorCtx = driver_->operatorCtx();
+  auto bridge = operatorCtx->task()->getHashJoinBridge(
+      operatorCtx->driverCtx()->splitGroupId, planNodeId_);
+  auto result = bridge->tableOrFuture(future);
+  if (!result.has_value()) {
+    return false;
+  }
+  VELOX_CHECK(
+      result->spillPartitionIds.empty() &&
+          !result->restoredPartitionId.has_value(),
+      "Wave hash join does not support a spilled build side");
+  loadTable(*result->table);
+  return true;
+}
+
+void HashJoin::loadTable(exec::BaseHashTable& table) {
+  std::vector<char*> rows;
+  exec::BaseHashTable::RowsIterator iter;
+  std::vector<char*> batch(1'024);
+  while (auto numRows = table.listAllRows(
+             &iter,
+             batch.size(),
+             std::numeric_limits<uint64_t>::max(),
+             batch.data())) {
+    rows.insert(rows.end(), batch.begin(), batch.begin() + numRows);
+  }
+  const int32_t numRows = rows.size();
+  const int32_t numKeys = probeKeyChannels_.size();
+
+  // Copies the keys and the build side output columns to the device.
+  auto* pool = driver_->operatorCtx()->pool();
+  auto& columns = tableHolder_.columns;
+  columns.resize(tableType_->size());
+  auto copyColumn = [&](column_index_t channel) {
+    if (columns[channel]) {
+      return;
+    }
+    auto vector =
+        BaseVector::create(tableType_->childAt(channel), numRows, pool);
+    table.rows()->extractColumn(rows.data(), numRows, channel, vector);
+    columns[channel] = toWaveVector(*vector, *arena_);
+  };
+  for (auto i = 0; i < numKeys; ++i) {
+    copyColumn(i);
+  }
+  for (const auto& [outputChannel, tableChannel] : buildProjections_) {
+    copyColumn(tableChannel);
+  }
+
+  joinTable_ = arena_->allocate<join::JoinTable>(1, tableHolder_.table);
+  joinTable_->numKeys = numKeys;
+  joinTable_->keyTypes =
+      arena_->allocate<PhysicalType>(numKeys, tableHolder_.keyTypes);
+  joinTable_->buildKeys =
+      arena_->allocate<Operand>(numKeys, tableHolder_.buildKeys);
+  for (auto i = 0; i < numKeys; ++i) {
+    joinTable_->keyTypes[i] = fromCpuType(*tableType_->childAt(i));
+    columns[i]->toOperand(&joinTable_->buildKeys[i]);
+  }
+  joinTable_->numBuildRows = numRows;
+  joinTable_->rowNumbers = arena_->allocate<int32_t>(
+      std::max<int32_t>(numRows, 1), tableHolder_.rowNumbers);
+  std::iota(joinTable_->rowNumbers, joinTable_->rowNumbers + numRows, 0);
+
+  // A bucket has 4 entries. The table is at most half full.
+  const int32_t numBuckets =
+      bits::nextPowerOfTwo(std::max<int32_t>(1, numRows / 2 + 1));
+  auto* buckets =
+      arena_->allocate<GpuBucketMembers>(numBuckets, tableHolder_.buckets);
+  std::memset(buckets, 0, numBuckets * sizeof(GpuBucketMembers));
+  joinTable_->buckets = reinterpret_cast<GpuBucket*>(buckets);
+  joinTable_->sizeMask = numBuckets - 1;
+  joinTable_->partitionMask = 0;
+  joinTable_->partitionShift = 0;
+  joinTable_->allocators = nullptr;
+
+  probeStream_ = WaveStream::streamFromReserve();
+  join::buildTable(*probeStream_, joinTable_);
+  probeStream_->wait();
+  VLOG(1) << "Built device hash join table with " << numRows << " rows";
+}
+
+void HashJoin::flush(bool noMoreInput) {
+  if (noMoreInput) {
+    noMoreInput_ = true;
+  }
+  if (joinTable_) {
+    startProbes();
+  }
+}
+
+void HashJoin::startProbes() {
+  for (auto& input : buffered_) {
+    Probe probe;
+    const auto numRows = input->size();
+    auto* probeKeys = arena_->allocate<Operand>(
+        probeKeyChannels_.size(), probe.probeKeys);
+    for (auto i = 0; i < probeKeyChannels_.size(); ++i) {
+      input->childAt(probeKeyChannels_[i]).toOperand(&probeKeys[i]);
+    }
+    auto* numMatches = arena_->allocate<int32_t>(
+        std::max<int32_t>(numRows, 1), probe.numMatches);
+    join::countMatches(
+        *probeStream_, joinTable_, probeKeys, numRows, numMatches);
+    probe.input = std::move(input);
+    probes_.push_back(std::move(probe));
+  }
+  buffered_.clear();
+}
+
+void HashJoin::finishCount(Probe& probe) {
+  probeStream_->wait();
+  const auto numRows = probe.input->size();
+  const auto* numMatches = probe.numMatches->as<int32_t>();
+  auto* offsets =
+      arena_->allocate<int32_t>(std::max<int32_t>(numRows, 1), probe.offsets);
+  int64_t total = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    offsets[i] = total;
+    total += numMatches[i];
+  }
+  VELOX_CHECK_LE(
+      total,
+      std::numeric_limits<int32_t>::max(),
+      "Too many matches for a batch of Wave hash join probe input");
+  probe.totalMatches = total;
+}
+
+int32_t HashJoin::canAdvance(WaveStream& /*stream*/) {
+  if (!joinTable_) {
+    return 0;
+  }
+  if (!buffered_.empty()) {
+    startProbes();
+  }
+  while (!probes_.empty()) {
+    auto& probe = probes_.front();
+    if (!probe.offsets) {
+      finishCount(probe);
+    }
+    if (probe.totalMatches > 0) {
+      return probe.totalMatches;
+    }
+    probes_.pop_front();
+  }
+  return 0;
+}
+
+void HashJoin::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(!probes_.empty());
+  auto probe = std::move(probes_.front());
+  probes_.pop_front();
+  const auto numRows = probe.totalMatches;
+  VELOX_CHECK_EQ(maxRows, numRows);
+  outputSize_ = numRows;
+
+  auto exec = std::make_unique<Executable>();
+  auto* probeRows =
+      arena_->allocate<int32_t>(numRows, exec->deviceData.emplace_back());
+  auto* buildRows =
+      arena_->allocate<int32_t>(numRows, exec->deviceData.emplace_back());
+  const auto numColumns = outputType_->size();
+  exec->operands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  auto* sources =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  auto* columns = arena_->allocate<join::GatherColumn>(
+      numColumns, exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->firstOutputOperandIdx = 0;
+  exec->output.resize(numColumns);
+  auto addColumn =
+      [&](column_index_t outputChannel, WaveVector& source, int32_t* rows) {
+        const auto& type = outputType_->childAt(outputChannel);
+        auto column = WaveVector::create(type, *arena_);
+        column->resize(numRows, source.mayHaveNulls());
+        column->toOperand(&exec->operands[outputChannel]);
+        source.toOperand(&sources[outputChannel]);
+        columns[outputChannel] = {
+            .source = &sources[outputChannel],
+            .rows = rows,
+            .result = &exec->operands[outputChannel],
+            .width = static_cast<int32_t>(type->cppSizeInBytes())};
+        exec->output[outputChannel] = std::move(column);
+      };
+  for (const auto& [outputChannel, inputChannel] : probeProjections_) {
+    addColumn(outputChannel, probe.input->childAt(inputChannel), probeRows);
+  }
+  for (const auto& [outputChannel, tableChannel] : buildProjections_) {
+    addColumn(outputChannel, *tableHolder_.columns[tableChannel], buildRows);
+  }
+
+  const auto numBlocks = bits::roundUp(numRows, kBlockSize) / kBlockSize;
+  auto* rowStatus =
+      arena_->allocate<BlockStatus>(numBlocks, exec->deviceData.emplace_back());
+  bzero(rowStatus, numBlocks * sizeof(BlockStatus));
+  for (auto i = 0; i < numBlocks; ++i) {
+    rowStatus[i].numRows =
+        i == numBlocks - 1 ? numRows - kBlockSize * i : kBlockSize;
+  }
+  // The probe input, its keys and offsets are read by the kernels.
+  auto* probeKeys = probe.probeKeys->as<Operand>();
+  const auto* offsets = probe.offsets->as<int32_t>();
+  const auto numProbeRows = probe.input->size();
+  exec->deviceData.push_back(std::move(probe.probeKeys));
+  exec->deviceData.push_back(std::move(probe.offsets));
+  exec->intermediates.push_back(std::move(probe.input));
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        auto control = std::make_unique<LaunchControl>(id_, numRows);
+        control->status = rowStatus;
+        waveStream.addLaunchControl(id_, std::move(control));
+        join::listMatches(
+            *stream,
+            joinTable_,
+            probeKeys,
+            numProbeRows,
+            offsets,
+            probeRows,
+            buildRows);
+        join::gather(*stream, columns, numColumns, numRows);
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+}
+
+} // namespace facebook::velox::wave
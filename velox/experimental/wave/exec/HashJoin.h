@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashTable.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Probe side of an inner hash join on the GPU. The build side is built by
+/// the CPU HashBuild operators. When their table is ready, its rows are copied
+/// to the device and inserted into a device hash table. Each batch of probe
+/// input is then joined on the device in two passes: one counts the matches
+/// of each probe row and one writes the matching row numbers, from which the
+/// output columns are gathered.
+class HashJoin : public WaveOperator {
+ public:
+  /// Returns true if 'node' can run on the GPU. This requires an inner join
+  /// without filter on INTEGER or BIGINT keys with fixed width output columns.
+  /// Other joins stay on the CPU.
+  static bool canRun(const core::HashJoinNode& node);
+
+  HashJoin(CompileState& state, const core::HashJoinNode& node);
+
+  ~HashJoin() override;
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance(WaveStream& stream) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && buffered_.empty() && probes_.empty();
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return outputSize_;
+  }
+
+  std::string toString() const override {
+    return "HashJoin";
+  }
+
+ private:
+  // A batch of probe input and the counts of its matches.
+  struct Probe {
+    WaveVectorPtr input;
+    WaveBufferPtr probeKeys;
+    WaveBufferPtr numMatches;
+    // Set after the counts have arrived.
+    WaveBufferPtr offsets;
+    int32_t totalMatches{0};
+  };
+
+  // Gets the table from the join bridge and makes the device table if the
+  // build side is done. Returns false and sets 'future' otherwise.
+  bool tryLoadTable(ContinueFuture* future);
+
+  // Copies the rows of 'table' to the device and inserts them into
+  // 'joinTable_'.
+  void loadTable(exec::BaseHashTable& table);
+
+  // Starts counting the matches of the buffered input.
+  void startProbes();
+
+  // Waits for the counts of the first of 'probes_' and sets its offsets.
+  void finishCount(Probe& probe);
+
+  const RowTypePtr probeType_;
+  const RowTypePtr tableType_;
+
+  // Channels of the keys in the probe input.
+  std::vector<column_index_t> probeKeyChannels_;
+
+  // Output channel and probe input channel of the probe side output columns.
+  std::vector<std::pair<column_index_t, column_index_t>> probeProjections_;
+
+  // Output channel and table channel of the build side output columns.
+  std::vector<std::pair<column_index_t, column_index_t>> buildProjections_;
+
+  GpuArena* arena_;
+
+  join::JoinTable* joinTable_{nullptr};
+  struct {
+    WaveBufferPtr table;
+    WaveBufferPtr keyTypes;
+    WaveBufferPtr buildKeys;
+    WaveBufferPtr buckets;
+    WaveBufferPtr rowNumbers;
+    // The build side columns, indexed by table channel. Only keys and output
+    // columns are set.
+    std::vector<WaveVectorPtr> columns;
+  } tableHolder_;
+
+  std::vector<WaveVectorPtr> buffered_;
+
+  // Probe input waiting for its output, in arrival order.
+  std::deque<Probe> probes_;
+
+  // Stream for building the table and counting matches.
+  std::unique_ptr<Stream> probeStream_;
+
+  vector_size_t outputSize_{0};
+  bool noMoreInput_{false};
+};
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Hash.h"
+#include "velox/experimental/wave/common/HashTable.cuh"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+namespace facebook::velox::wave::join {
+
+namespace {
+
+// Returns the position of 'row' in the values and nulls of 'op'.
+__device__ inline int32_t valueIndex(const Operand* op, int32_t row) {
+  if (op->indices && op->indices[0]) {
+    return op->indices[0][row];
+  }
+  return row & op->indexMask;
+}
+
+template <typename T>
+__device__ inline bool nonNullValue(const Operand* op, int32_t row, T& value) {
+  auto index = valueIndex(op, row);
+  if (op->nulls && op->nulls[index] == kNull) {
+    return false;
+  }
+  value = reinterpret_cast<const T*>(op->base)[index];
+  return true;
+}
+
+template <typename T>
+__device__ inline bool hashKey(const Operand* op, int32_t row, uint64_t& hash) {
+  T value;
+  if (!nonNullValue(op, row, value)) {
+    return false;
+  }
+  hash = hashMix(hash, IntHasher32<T>()(value));
+  return true;
+}
+
+// Sets 'hash' to the hash of the keys of 'row'. Returns false if a key is
+// null.
+__device__ bool hashRow(
+    const JoinTable* table,
+    const Operand* keys,
+    int32_t row,
+    uint64_t& hash) {
+  hash = 1;
+  for (auto i = 0; i < table->numKeys; ++i) {
+    const bool notNull = table->keyTypes[i].kind == PhysicalType::kInt32
+        ? hashKey<int32_t>(&keys[i], row, hash)
+        : hashKey<int64_t>(&keys[i], row, hash);
+    if (!notNull) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+__device__ inline bool keyEquals(
+    const Operand* probe,
+    int32_t probeRow,
+    const Operand* build,
+    int32_t buildRow) {
+  return reinterpret_cast<const T*>(probe->base)[valueIndex(probe, probeRow)] ==
+      reinterpret_cast<const T*>(build->base)[valueIndex(build, buildRow)];
+}
+
+// Returns true if the keys of 'probeRow' are equal to the keys of 'buildRow'.
+// Neither has null keys.
+__device__ bool keysEqual(
+    const JoinTable* table,
+    const Operand* probeKeys,
+    int32_t probeRow,
+    int32_t buildRow) {
+  for (auto i = 0; i < table->numKeys; ++i) {
+    const bool equal = table->keyTypes[i].kind == PhysicalType::kInt32
+        ? keyEquals<int32_t>(
+              &probeKeys[i], probeRow, &table->buildKeys[i], buildRow)
+        : keyEquals<int64_t>(
+              &probeKeys[i], probeRow, &table->buildKeys[i], buildRow);
+    if (!equal) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Calls 'func' with the build side row number of each match of 'probeRow'.
+template <typename Func>
+__device__ void forEachMatch(
+    const JoinTable* table,
+    const Operand* probeKeys,
+    int32_t probeRow,
+    Func func) {
+  uint64_t hash;
+  if (!hashRow(table, probeKeys, probeRow, hash)) {
+    return;
+  }
+  uint32_t tagWord = hashTag(hash);
+  tagWord |= tagWord << 8;
+  tagWord = tagWord | tagWord << 16;
+  auto bucketIdx = hash & table->sizeMask;
+  for (;;) {
+    const GpuBucket* bucket = table->buckets + bucketIdx;
+    const auto tags = bucket->tags;
+    auto hits = __vcmpeq4(tags, tagWord) & 0x01010101;
+    while (hits) {
+      const auto hitIdx = (__ffs(hits) - 1) / 8;
+      const auto buildRow = *bucket->load<int32_t>(hitIdx);
+      if (keysEqual(table, probeKeys, probeRow, buildRow)) {
+        func(buildRow);
+      }
+      hits = hits & (hits - 1);
+    }
+    if (__vcmpeq4(tags, 0)) {
+      return;
+    }
+    bucketIdx = (bucketIdx + 1) & table->sizeMask;
+  }
+}
+
+__global__ void buildTableKernel(JoinTable* table) {
+  const int32_t row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row >= table->numBuildRows) {
+    return;
+  }
+  uint64_t hash;
+  if (!hashRow(table, table->buildKeys, row, hash)) {
+    return;
+  }
+  const uint8_t tag = hashTag(hash);
+  auto bucketIdx = hash & table->sizeMask;
+  for (;;) {
+    GpuBucket* bucket = table->buckets + bucketIdx;
+    auto tags = asDeviceAtomic<uint32_t>(&bucket->tags)
+                    ->load(cuda::memory_order_consume);
+    auto empty = __vcmpeq4(tags, 0) & 0x01010101;
+    while (empty) {
+      const auto idx = (__ffs(empty) - 1) / 8;
+      if (bucket->addNewTag(tag, tags, idx * 8)) {
+        bucket->store(idx, &table->rowNumbers[row]);
+        return;
+      }
+      // Another row took a slot. Retry with the new tags.
+      tags = asDeviceAtomic<uint32_t>(&bucket->tags)
+                 ->load(cuda::memory_order_consume);
+      empty = __vcmpeq4(tags, 0) & 0x01010101;
+    }
+    bucketIdx = (bucketIdx + 1) & table->sizeMask;
+  }
+}
+
+__global__ void countMatchesKernel(
+    JoinTable* table,
+    Operand* probeKeys,
+    int32_t numRows,
+    int32_t* numMatches) {
+  const int32_t row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row >= numRows) {
+    return;
+  }
+  int32_t count = 0;
+  forEachMatch(table, probeKeys, row, [&](int32_t) { ++count; });
+  numMatches[row] = count;
+}
+
+__global__ void listMatchesKernel(
+    JoinTable* table,
+    Operand* probeKeys,
+    int32_t numRows,
+    const int32_t* offsets,
+    int32_t* probeRows,
+    int32_t* buildRows) {
+  const int32_t row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row >= numRows) {
+    return;
+  }
+  auto offset = offsets[row];
+  forEachMatch(table, probeKeys, row, [&](int32_t buildRow) {
+    probeRows[offset] = row;
+    buildRows[offset] = buildRow;
+    ++offset;
+  });
+}
+
+template <typename T>
+__device__ inline void gatherValue(GatherColumn& column, int32_t row) {
+  const auto index = valueIndex(column.source, column.rows[row]);
+  reinterpret_cast<T*>(column.result->base)[row] =
+      reinterpret_cast<const T*>(column.source->base)[index];
+  if (column.result->nulls) {
+    column.result->nulls[row] =
+        column.source->nulls ? column.source->nulls[index] : kNotNull;
+  }
+}
+
+// Column blockIdx.y is gathered by blocks of rows.
+__global__ void
+gatherKernel(GatherColumn* columns, int32_t numColumns, int32_t numRows) {
+  const int32_t row = blockIdx.x * blockDim.x + threadIdx.x;
+  if (row >= numRows) {
+    return;
+  }
+  auto& column = columns[blockIdx.y];
+  switch (column.width) {
+    case 1:
+      gatherValue<int8_t>(column, row);
+      break;
+    case 2:
+      gatherValue<int16_t>(column, row);
+      break;
+    case 4:
+      gatherValue<int32_t>(column, row);
+      break;
+    case 8:
+      gatherValue<int64_t>(column, row);
+      break;
+    default:
+      assert(false);
+  }
+}
+
+int32_t numBlocks(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+} // namespace
+
+void buildTable(Stream& stream, JoinTable* table) {
+  if (table->numBuildRows == 0) {
+    return;
+  }
+  buildTableKernel<<<
+      numBlocks(table->numBuildRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(table);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void countMatches(
+    Stream& stream,
+    JoinTable* table,
+    Operand* probeKeys,
+    int32_t numRows,
+    int32_t* numMatches) {
+  if (numRows == 0) {
+    return;
+  }
+  countMatchesKernel<<<
+      numBlocks(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(table, probeKeys, numRows, numMatches);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void listMatches(
+    Stream& stream,
+    JoinTable* table,
+    Operand* probeKeys,
+    int32_t numRows,
+    const int32_t* offsets,
+    int32_t* probeRows,
+    int32_t* buildRows) {
+  if (numRows == 0) {
+    return;
+  }
+  listMatchesKernel<<<
+      numBlocks(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(
+      table, probeKeys, numRows, offsets, probeRows, buildRows);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void gather(
+    Stream& stream,
+    GatherColumn* columns,
+    int32_t numColumns,
+    int32_t numRows) {
+  if (numRows == 0 || numColumns == 0) {
+    return;
+  }
+  gatherKernel<<<
+      dim3(numBlocks(numRows), numColumns),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(columns, numColumns, numRows);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::join
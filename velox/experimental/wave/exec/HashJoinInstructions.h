@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/HashTable.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+namespace facebook::velox::wave::join {
+
+/// Hash table over the build side of a hash join. The entries in
+/// 'buckets' point to elements of 'rowNumbers', which give the build side
+/// row. Build side rows with equal keys have an entry each.
+struct JoinTable : public GpuHashTableBase {
+  int32_t numKeys;
+  // Type of each key, kInt32 or kInt64.
+  PhysicalType* keyTypes;
+  // Build side key columns.
+  Operand* buildKeys;
+  int32_t numBuildRows;
+  // 'rowNumbers[i]' is i.
+  int32_t* rowNumbers;
+};
+
+/// Copies 'numRows' values of 'source' at 'rows' to 'result'.
+struct GatherColumn {
+  Operand* source;
+  const int32_t* rows;
+  Operand* result;
+  // Size of a value in bytes, 1, 2, 4 or 8.
+  int32_t width;
+};
+
+/// Inserts the build side rows of 'table' that have no null keys. The buckets
+/// must be zeroed and have room for all rows.
+void buildTable(Stream& stream, JoinTable* table);
+
+/// Sets 'numMatches[i]' to the number of build side rows of 'table' that match
+/// row i of 'probeKeys'. Rows with a null key have no matches.
+void countMatches(
+    Stream& stream,
+    JoinTable* table,
+    Operand* probeKeys,
+    int32_t numRows,
+    int32_t* numMatches);
+
+/// Writes the probe and build side row numbers of the matches of probe row i
+/// from position 'offsets[i]' of 'probeRows' and 'buildRows'. 'offsets' is the
+/// exclusive prefix sum of the counts from countMatches().
+void listMatches(
+    Stream& stream,
+    JoinTable* table,
+    Operand* probeKeys,
+    int32_t numRows,
+    const int32_t* offsets,
+    int32_t* probeRows,
+    int32_t* buildRows);
+
+/// Fills the first 'numRows' rows of the results of 'columns'.
+void gather(
+    Stream& stream,
+    GatherColumn* columns,
+    int32_t numColumns,
+    int32_t numRows);
+
+} // namespace facebook::velox::wave::join
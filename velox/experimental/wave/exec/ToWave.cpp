@@ -17,6 +17,7 @@
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashJoin.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/TableScan.h"
 #include "velox/experimental/wave/exec/Values.h"
@@ -414,15 +415,25 @@ bool CompileState::addOperator(
     }
     addFilterProject(op, outputType, nodeIndex);
   } else if (name == "Aggregation") {
-    if (!reserveMemory()) {
-      return false;
-    }
     auto* node = dynamic_cast<const core::AggregationNode*>(
         driverFactory_.planNodes[nodeIndex].get());
     VELOX_CHECK_NOT_NULL(node);
+    if (!Aggregation::canRun(*node, *aggregateFunctionRegistry()) ||
+        !reserveMemory()) {
+      return false;
+    }
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!HashJoin::canRun(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashJoin>(*this, *node));
+    outputType = node->outputType();
   } else if (name == "TableScan") {
     if (!reserveMemory()) {
       return false;
@@ -466,6 +466,11 @@ class WaveStream {
     return arena_;
   }
 
+  /// Pinned host memory for staging transfers to the device.
+  GpuArena& hostArena() {
+    return hostArena_;
+  }
+
   void setNullable(const AbstractOperand& op, bool nullable) {
     operandNullable_[op.id] = nullable;
   }
@@ -59,6 +59,10 @@ RowVectorPtr WaveDriver::getOutput() {
   VLOG(1) << "Getting output";
   for (;;) {
     startMore();
+    if (blockingFuture_.valid()) {
+      // An operator waits, e.g. for the build side of a join.
+      return nullptr;
+    }
     bool running = false;
     for (int i = pipelines_.size() - 1; i >= 0; --i) {
       if (pipelines_[i].streams.empty()) {
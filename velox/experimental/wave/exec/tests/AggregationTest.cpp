@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
 #include <random>
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -27,6 +28,8 @@ DEFINE_int32(batch_size, 1000, "");
 DEFINE_int32(num_batches, 100, "");
 DEFINE_int64(random_seed, -1, "");
 
+DECLARE_int32(velox_wave_aggregation_key_cardinality);
+
 namespace facebook::velox::wave {
 namespace {
 
@@ -114,6 +117,58 @@ TEST_F(AggregationTest, multiKeySingleAggregate) {
   AssertQueryBuilder(plan).assertResults(expected);
 }
 
+TEST_F(AggregationTest, keyCardinality) {
+  constexpr int kSize = 1'000;
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](int i) { return i % 5; }),
+      makeFlatVector<int32_t>(kSize, [](int i) { return i % 7; }),
+      makeFlatVector<int64_t>(kSize, folly::identity),
+  });
+  auto plan = PlanBuilder()
+                  .values({vector})
+                  .singleAggregation({"c0", "c1"}, {"sum(c2)", "count(c2)"})
+                  .planNode();
+  createDuckDbTable({vector});
+
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_wave_aggregation_key_cardinality = 8;
+  assertQuery(plan, "SELECT c0, c1, sum(c2), count(c2) FROM tmp GROUP BY 1, 2");
+
+  // 7 values of c1 do not fit.
+  FLAGS_velox_wave_aggregation_key_cardinality = 6;
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan).copyResults(pool()),
+      "Grouping key of Wave aggregation has more than 6 distinct values");
+
+  // Too many groups for the GPU. The aggregation runs on the CPU.
+  FLAGS_velox_wave_aggregation_key_cardinality = 128;
+  assertQuery(plan, "SELECT c0, c1, sum(c2), count(c2) FROM tmp GROUP BY 1, 2");
+}
+
+TEST_F(AggregationTest, unsupportedOnCpu) {
+  constexpr int kSize = 100;
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](int i) { return i % 3; }),
+      makeFlatVector<int64_t>(kSize, folly::identity),
+  });
+  createDuckDbTable({vector});
+
+  // Partial aggregation and functions without a GPU implementation run on the
+  // CPU.
+  auto plan = PlanBuilder()
+                  .values({vector})
+                  .partialAggregation({"c0"}, {"sum(c1)"})
+                  .finalAggregation()
+                  .planNode();
+  assertQuery(plan, "SELECT c0, sum(c1) FROM tmp GROUP BY 1");
+
+  plan = PlanBuilder()
+             .values({vector})
+             .singleAggregation({"c0"}, {"max(c1)"})
+             .planNode();
+  assertQuery(plan, "SELECT c0, max(c1) FROM tmp GROUP BY 1");
+}
+
 TEST_F(AggregationTest, tpchQ1) {
   // TODO: Use StringView instead of int64_t for keys.
   struct {
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    OperatorTestBase::SetUp();
+  }
+
+  // Returns a probe side with keys 0-99 in 'c0' and the row number in 'c1'.
+  std::vector<RowVectorPtr> makeProbe(int32_t numBatches) {
+    std::vector<RowVectorPtr> batches;
+    for (auto i = 0; i < numBatches; ++i) {
+      batches.push_back(makeRowVector({
+          makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+          makeFlatVector<int32_t>(
+              1'000, [&](auto row) { return i * 1'000 + row; }),
+      }));
+    }
+    return batches;
+  }
+};
+
+TEST_F(HashJoinTest, singleKey) {
+  auto probe = makeProbe(3);
+  // Keys 0, 3, 6 ... 147. Each key has two rows.
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(100, [](auto row) { return row / 2 * 3; }),
+          makeFlatVector<double>(100, [](auto row) { return row * 0.5; }),
+      });
+  createDuckDbTable("t", probe);
+  createDuckDbTable("u", {build});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildPlan =
+      PlanBuilder(planNodeIdGenerator).values({build}).planNode();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe)
+                  .hashJoin({"c0"}, {"u0"}, buildPlan, "", {"c0", "c1", "u1"})
+                  .planNode();
+  assertQuery(plan, "SELECT c0, c1, u1 FROM t, u WHERE c0 = u0");
+}
+
+TEST_F(HashJoinTest, multipleKeys) {
+  // Every 10th 'c1' is null and does not match.
+  auto probe = makeRowVector({
+      makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; }),
+      makeFlatVector<int64_t>(
+          1'000, [](auto row) { return row % 11; }, nullEvery(10)),
+      makeFlatVector<int64_t>(1'000, folly::identity),
+  });
+  auto build = makeRowVector(
+      {"u0", "u1", "u2"},
+      {
+          makeFlatVector<int32_t>(50, [](auto row) { return row % 7; }),
+          makeFlatVector<int64_t>(50, [](auto row) { return row % 11; }),
+          makeFlatVector<int16_t>(50, folly::identity),
+      });
+  createDuckDbTable("t", {probe});
+  createDuckDbTable("u", {build});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildPlan =
+      PlanBuilder(planNodeIdGenerator).values({build}).planNode();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"c0", "c1"},
+                      {"u0", "u1"},
+                      buildPlan,
+                      "",
+                      {"c2", "u0", "u2"})
+                  .planNode();
+  assertQuery(plan, "SELECT c2, u0, u2 FROM t, u WHERE c0 = u0 AND c1 = u1");
+}
+
+TEST_F(HashJoinTest, emptyBuild) {
+  auto probe = makeProbe(2);
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(0, folly::identity),
+       makeFlatVector<int64_t>(0, folly::identity)});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildPlan =
+      PlanBuilder(planNodeIdGenerator).values({build}).planNode();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe)
+                  .hashJoin({"c0"}, {"u0"}, buildPlan, "", {"c1", "u1"})
+                  .planNode();
+  AssertQueryBuilder(plan).assertEmptyResults();
+}
+
+TEST_F(HashJoinTest, unsupportedOnCpu) {
+  auto probe = makeProbe(2);
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(10, folly::identity),
+          makeFlatVector<std::string>(
+              10, [](auto row) { return std::to_string(row); }),
+      });
+  createDuckDbTable("t", probe);
+  createDuckDbTable("u", {build});
+
+  // Left joins and string columns are not supported on the GPU.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildPlan =
+      PlanBuilder(planNodeIdGenerator).values({build}).planNode();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probe)
+                  .hashJoin(
+                      {"c0"},
+                      {"u0"},
+                      buildPlan,
+                      "",
+                      {"c0", "c1", "u1"},
+                      core::JoinType::kLeft)
+                  .planNode();
+  assertQuery(plan, "SELECT c0, c1, u1 FROM t LEFT JOIN u ON c0 = u0");
+
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values(probe)
+             .hashJoin({"c0"}, {"u0"}, buildPlan, "", {"c1", "u1"})
+             .planNode();
+  assertQuery(plan, "SELECT c1, u1 FROM t, u WHERE c0 = u0");
+}
+
+} // namespace
+} // namespace facebook::velox::wave
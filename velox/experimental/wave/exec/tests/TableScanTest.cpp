@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <cuda_runtime.h> // @manual
+#include <gflags/gflags.h>
 #include "velox/exec/ExchangeSource.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
@@ -31,6 +32,8 @@ using namespace facebook::velox::core;
 using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
 
+DECLARE_bool(wave_pinned_staging);
+
 class TableScanTest : public virtual HiveConnectorTestBase {
  protected:
   void SetUp() override {
@@ -171,6 +174,17 @@ TEST_F(TableScanTest, basic) {
   ASSERT_TRUE(it != planStats.end());
 }
 
+TEST_F(TableScanTest, unifiedMemoryStaging) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_wave_pinned_staging = false;
+  auto type = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto vectors = makeVectors(type, 10, 1'000);
+  auto splits = makeTable("test", vectors);
+  createDuckDbTable(vectors);
+
+  assertQuery(tableScanNode(type), splits, "SELECT * FROM tmp");
+}
+
 TEST_F(TableScanTest, filter) {
   auto type =
       ROW({"c0", "c1", "c2", "c3"}, {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
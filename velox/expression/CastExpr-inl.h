@@ -41,17 +41,6 @@ inline std::string makeErrorMessage(
       details);
 }
 
-inline std::exception_ptr makeBadCastException(
-    const TypePtr& resultType,
-    const BaseVector& input,
-    vector_size_t row,
-    const std::string& errorDetails) {
-  return std::make_exception_ptr(VeloxUserError(
-      std::current_exception(),
-      makeErrorMessage(input, row, resultType, errorDetails),
-      false));
-}
-
 /// @brief Convert the unscaled value of a decimal to varchar and write to raw
 /// string buffer from start position.
 /// @tparam T The type of input value.
@@ -289,6 +278,21 @@ void CastExpr::applyToSelectedNoThrowLocal(
   }
 }
 
+template <typename MakeMessage>
+void CastExpr::setError(
+    EvalCtx& context,
+    BaseVector& result,
+    vector_size_t row,
+    MakeMessage&& makeMessage) {
+  if (setNullInResultAtError()) {
+    result.setNull(row, true);
+  } else if (context.captureErrorDetails()) {
+    context.setStatus(row, Status::UserError("{}", makeMessage()));
+  } else {
+    context.setStatus(row, Status::UserError());
+  }
+}
+
 /// The per-row level Kernel
 /// @tparam ToKind The cast target type
 /// @tparam FromKind The expression type
@@ -304,18 +308,10 @@ void CastExpr::applyCastKernel(
     FlatVector<typename TypeTraits<ToKind>::NativeType>* result) {
   bool wrapException = true;
   auto setError = [&](const std::string& details) {
-    if (setNullInResultAtError()) {
-      result->setNull(row, true);
-    } else {
-      wrapException = false;
-      if (context.captureErrorDetails()) {
-        const auto errorDetails =
-            makeErrorMessage(*input, row, result->type(), details);
-        context.setStatus(row, Status::UserError("{}", errorDetails));
-      } else {
-        context.setStatus(row, Status::UserError());
-      }
-    }
+    wrapException = false;
+    this->setError(context, *result, row, [&]() {
+      return makeErrorMessage(*input, row, result->type(), details);
+    });
   };
 
   try {
@@ -400,14 +396,9 @@ void CastExpr::applyDecimalCastKernel(
         if (status.ok()) {
           castResultRawBuffer[row] = rescaledValue;
         } else {
-          if (setNullInResultAtError()) {
-            castResult->setNull(row, true);
-          } else {
-            context.setVeloxExceptionError(
-                row,
-                std::make_exception_ptr(VeloxUserError(
-                    std::current_exception(), status.message(), false)));
-          }
+          setError(context, *castResult, row, [&]() {
+            return status.message();
+          });
         }
       });
 }
@@ -459,12 +450,9 @@ void CastExpr::applyFloatingPointToDecimalCastKernel(
     if (status.ok()) {
       rawResults[row] = output;
     } else {
-      if (setNullInResultAtError()) {
-        result->setNull(row, true);
-      } else {
-        context.setVeloxExceptionError(
-            row, makeBadCastException(toType, input, row, status.message()));
-      }
+      setError(context, *result, row, [&]() {
+        return makeErrorMessage(input, row, toType, status.message());
+      });
     }
   });
 }
@@ -490,12 +478,9 @@ void CastExpr::applyVarcharToDecimalCastKernel(
     if (status.ok()) {
       rawBuffer[row] = decimalValue;
     } else {
-      if (setNullInResultAtError()) {
-        result->setNull(row, true);
-      } else {
-        context.setVeloxExceptionError(
-            row, makeBadCastException(toType, input, row, status.message()));
-      }
+      setError(context, *result, row, [&]() {
+        return makeErrorMessage(input, row, toType, status.message());
+      });
     }
   });
 }
@@ -518,11 +503,14 @@ VectorPtr CastExpr::applyDecimalToFloatCast(
   const auto scaleFactor = DecimalUtil::kPowersOfTen[precisionScale.second];
   applyToSelectedNoThrowLocal(context, rows, result, [&](int row) {
     const auto output =
-        util::Converter<ToKind>::tryCast(simpleInput->valueAt(row))
-            .thenOrThrow(folly::identity, [&](const Status& status) {
-              VELOX_USER_FAIL("{}", status.message());
-            });
-    resultBuffer[row] = output / scaleFactor;
+        util::Converter<ToKind>::tryCast(simpleInput->valueAt(row));
+    if (output.hasError()) {
+      setError(context, *result, row, [&]() {
+        return output.error().message();
+      });
+      return;
+    }
+    resultBuffer[row] = output.value() / scaleFactor;
   });
   return result;
 }
@@ -559,17 +547,13 @@ VectorPtr CastExpr::applyDecimalToIntegralCast(
       integralPart += needsRoundUp ? sign : 0;
       if (integralPart > std::numeric_limits<To>::max() ||
           integralPart < std::numeric_limits<To>::min()) {
-        if (setNullInResultAtError()) {
-          result->setNull(row, true);
-        } else {
-          context.setVeloxExceptionError(
+        setError(context, *result, row, [&]() {
+          return makeErrorMessage(
+              input,
               row,
-              makeBadCastException(
-                  result->type(),
-                  input,
-                  row,
-                  makeErrorMessage(input, row, toType) + "Out of bounds."));
-        }
+              result->type(),
+              makeErrorMessage(input, row, toType) + "Out of bounds.");
+        });
         return;
       }
 
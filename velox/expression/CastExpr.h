@@ -163,6 +163,17 @@ class CastExpr : public SpecialForm {
       VectorPtr& result,
       Func&& func);
 
+  // Reports a cast failure for 'row' without throwing. Sets 'row' of 'result'
+  // to null if setNullInResultAtError() is true, otherwise records a user
+  // error in 'context'. 'makeMessage' is called only if error details are
+  // captured, e.g. not under TRY.
+  template <typename MakeMessage>
+  void setError(
+      EvalCtx& context,
+      BaseVector& result,
+      vector_size_t row,
+      MakeMessage&& makeMessage);
+
   /// The per-row level Kernel
   /// @tparam ToKind The cast target type
   /// @tparam FromKind The expression type
@@ -59,6 +59,13 @@ void CoalesceExpr::evalSpecialForm(
 
   exec::LocalDecodedVector decodedVector(context);
   for (int i = 0; i < inputs_.size(); i++) {
+    // Load fields shared with other inputs only for the rows that are still
+    // null.
+    for (auto* field : inputs_[i]->distinctFields()) {
+      if (multiplyReferencedFields_.count(field) > 0) {
+        context.ensureFieldLoaded(field->index(context), *activeRows);
+      }
+    }
     inputs_[i]->eval(*activeRows, context, result);
 
     if (!result->mayHaveNulls()) {
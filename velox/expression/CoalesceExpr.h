@@ -34,11 +34,21 @@ class CoalesceExpr : public SpecialForm {
       EvalCtx& context,
       VectorPtr& result) override;
 
+  bool isConditional() const override {
+    return true;
+  }
+
  private:
   void computePropagatesNulls() override {
     propagatesNulls_ = false;
   }
 
+  // Each input is evaluated on the rows for which the previous inputs
+  // returned null.
+  bool evaluatesArgumentsOnNonIncreasingSelection() const override {
+    return true;
+  }
+
   static TypePtr resolveType(const std::vector<TypePtr>& argTypes);
 
   friend class CoalesceCallToSpecialForm;
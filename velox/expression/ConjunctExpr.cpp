@@ -174,6 +174,14 @@ void ConjunctExpr::evalSpecialForm(
     reorderEnabledChecked_ = true;
   }
   if (reorderEnabled_) {
+    // Weigh recent batches more so that the order follows changes in the
+    // selectivity and cost of the inputs.
+    if (++numEvalsSinceDecay_ == kSelectivityDecayInterval) {
+      for (auto& selectivity : selectivity_) {
+        selectivity.decay();
+      }
+      numEvalsSinceDecay_ = 0;
+    }
     maybeReorderInputs();
   }
 }
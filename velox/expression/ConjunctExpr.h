@@ -60,6 +60,10 @@ class ConjunctExpr : public SpecialForm {
     return true;
   }
 
+  bool isAnd() const {
+    return isAnd_;
+  }
+
   const SelectivityInfo& selectivityAt(int32_t index) {
     return selectivity_[inputOrder_[index]];
   }
@@ -94,8 +98,13 @@ class ConjunctExpr : public SpecialForm {
   // temp space for nulls and values of inputs
   BufferPtr tempValues_;
   BufferPtr tempNulls_;
+  // Number of evaluations after which 'selectivity_' is decayed.
+  static constexpr int32_t kSelectivityDecayInterval = 64;
+
   bool reorderEnabledChecked_ = false;
   bool reorderEnabled_;
+  // Number of evaluations since 'selectivity_' was last decayed.
+  int32_t numEvalsSinceDecay_{0};
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
 
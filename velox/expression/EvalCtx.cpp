@@ -35,7 +35,21 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx, ExprSet* exprSet, const RowVector* row)
               ? execCtx->queryCtx()
                     ->queryConfig()
                     .maxSharedSubexprResultsCached()
-              : core::QueryConfig({}).maxSharedSubexprResultsCached()) {
+              : core::QueryConfig({}).maxSharedSubexprResultsCached()),
+      maxDictionaryMemoBytes_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()->queryConfig().maxDictionaryMemoBytes()
+              : core::QueryConfig({}).maxDictionaryMemoBytes()),
+      minSharedSubexprCostNanosPerRow_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()
+                    ->queryConfig()
+                    .minSharedSubexprCostNanosPerRow()
+              : core::QueryConfig({}).minSharedSubexprCostNanosPerRow()),
+      exprProfilingEnabled_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()->queryConfig().exprProfilingEnabled()
+              : false) {
   // TODO Change the API to replace raw pointers with non-const references.
   // Sanity check inputs to prevent crashes.
   VELOX_CHECK_NOT_NULL(execCtx);
@@ -62,7 +76,21 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
               ? execCtx->queryCtx()
                     ->queryConfig()
                     .maxSharedSubexprResultsCached()
-              : core::QueryConfig({}).maxSharedSubexprResultsCached()) {
+              : core::QueryConfig({}).maxSharedSubexprResultsCached()),
+      maxDictionaryMemoBytes_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()->queryConfig().maxDictionaryMemoBytes()
+              : core::QueryConfig({}).maxDictionaryMemoBytes()),
+      minSharedSubexprCostNanosPerRow_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()
+                    ->queryConfig()
+                    .minSharedSubexprCostNanosPerRow()
+              : core::QueryConfig({}).minSharedSubexprCostNanosPerRow()),
+      exprProfilingEnabled_(
+          execCtx->queryCtx()
+              ? execCtx->queryCtx()->queryConfig().exprProfilingEnabled()
+              : false) {
   VELOX_CHECK_NOT_NULL(execCtx);
 }
 
@@ -314,7 +342,9 @@ VectorPtr EvalCtx::ensureFieldLoaded(
     const SelectivityVector& rows) {
   auto field = getField(index);
   if (isLazyNotLoaded(*field)) {
-    const auto& rowsToLoad = isFinalSelection_ ? rows : *finalSelection_;
+    const auto& rowsToLoad =
+        isFinalSelection_ || loadLazyForEvaluatedRowsOnly_ ? rows
+                                                           : *finalSelection_;
 
     LocalDecodedVector holder(*this);
     auto decoded = holder.get();
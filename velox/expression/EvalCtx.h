@@ -388,6 +388,20 @@ class EvalCtx {
     return &captureErrorDetails_;
   }
 
+  /// True if the unloaded LazyVectors in 'row' are not accessed other than by
+  /// the expressions being evaluated. Set by operators that load the inputs
+  /// they pass through before evaluating expressions. LazyVectors are then
+  /// loaded only for the rows an expression is evaluated on, e.g. for the
+  /// rows taken by a CASE branch, instead of for all rows of the upper-most
+  /// IF, OR or COALESCE.
+  bool loadLazyForEvaluatedRowsOnly() const {
+    return loadLazyForEvaluatedRowsOnly_;
+  }
+
+  void setLoadLazyForEvaluatedRowsOnly(bool value) {
+    loadLazyForEvaluatedRowsOnly_ = value;
+  }
+
   bool nullsPruned() const {
     return nullsPruned_;
   }
@@ -518,6 +532,24 @@ class EvalCtx {
     return maxSharedSubexprResultsCached_;
   }
 
+  /// Returns the maximum number of bytes an expression may retain in results
+  /// cached across batches by Expr::evalWithMemo.
+  uint64_t maxDictionaryMemoBytes() const {
+    return maxDictionaryMemoBytes_;
+  }
+
+  /// Returns the minimum cost in nanoseconds per row for the results of a
+  /// shared subexpression to be cached. 0 if all are cached.
+  uint64_t minSharedSubexprCostNanosPerRow() const {
+    return minSharedSubexprCostNanosPerRow_;
+  }
+
+  /// Returns true if expressions collect the counters enabled by
+  /// QueryConfig::kExprProfilingEnabled.
+  bool exprProfilingEnabled() const {
+    return exprProfilingEnabled_;
+  }
+
  private:
   void ensureErrorsVectorSize(EvalErrorsPtr& errors, vector_size_t size) const;
 
@@ -539,6 +571,9 @@ class EvalCtx {
   const RowVector* row_;
   const bool cacheEnabled_;
   const uint32_t maxSharedSubexprResultsCached_;
+  const uint64_t maxDictionaryMemoBytes_;
+  const uint64_t minSharedSubexprCostNanosPerRow_;
+  const bool exprProfilingEnabled_;
   bool inputFlatNoNulls_;
 
   // Corresponds 1:1 to children of 'row_'. Set to an inner vector
@@ -557,6 +592,8 @@ class EvalCtx {
 
   bool captureErrorDetails_{true};
 
+  bool loadLazyForEvaluatedRowsOnly_{false};
+
   // True if the current set of rows will not grow, e.g. not under and IF or OR.
   bool isFinalSelection_{true};
 
@@ -29,6 +29,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/ExprCompiler.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedEvaluator.h"
 #include "velox/expression/PeeledEncoding.h"
 #include "velox/expression/ScopedVarSetter.h"
 #include "velox/expression/VectorFunction.h"
@@ -99,7 +100,8 @@ bool isMember(
   return std::find(fields.begin(), fields.end(), &field) != fields.end();
 }
 
-// Returns true if input expression or any sub-expression is an IF, AND or OR.
+// Returns true if input expression or any sub-expression is an IF, AND, OR or
+// COALESCE.
 bool hasConditionals(Expr* expr) {
   if (expr->isConditional()) {
     return true;
@@ -708,6 +710,9 @@ void Expr::evalFlatNoNulls(
     EvalCtx& context,
     VectorPtr& result,
     const ExprSet* parentExprSet) {
+  if (fusedEvaluator_ && fusedEvaluator_->eval(rows, context, result)) {
+    return;
+  }
   if (shouldEvaluateSharedSubexp()) {
     evaluateSharedSubexpr(
         rows,
@@ -773,6 +778,12 @@ void Expr::eval(
     EvalCtx& context,
     VectorPtr& result,
     const ExprSet* parentExprSet) {
+  if (fusedEvaluator_ && context.throwOnError() &&
+      fusedEvaluator_->eval(rows, context, result)) {
+    checkResultInternalState(result);
+    return;
+  }
+
   if (supportsFlatNoNullsFastPath_ && context.throwOnError() &&
       context.inputFlatNoNulls() && rows.countSelected() < 1'000) {
     evalFlatNoNulls(rows, context, result, parentExprSet);
@@ -851,6 +862,31 @@ void Expr::evaluateSharedSubexpr(
     EvalCtx& context,
     VectorPtr& result,
     TEval eval) {
+  const auto minCostNanosPerRow = context.minSharedSubexprCostNanosPerRow();
+  if (minCostNanosPerRow > 0) {
+    if (sharedSubexprTooCheap_) {
+      eval(rows, context, result);
+      return;
+    }
+    if (sharedSubexprCostRows_ < kSharedSubexprCostSampleRows) {
+      // Measures the cost of evaluating 'this' without the cache. Cheap
+      // expressions are recomputed for each reference instead of keeping and
+      // copying their results.
+      const auto start = std::chrono::steady_clock::now();
+      eval(rows, context, result);
+      sharedSubexprCostNanos_ +=
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+      sharedSubexprCostRows_ += rows.countSelected();
+      if (sharedSubexprCostRows_ >= kSharedSubexprCostSampleRows) {
+        sharedSubexprTooCheap_ = sharedSubexprCostNanos_ <
+            minCostNanosPerRow * sharedSubexprCostRows_;
+      }
+      return;
+    }
+  }
+
   // Captures the inputs referenced by distinctFields_.
   std::vector<const BaseVector*> expressionInputFields;
   for (auto* field : distinctFields_) {
@@ -1069,6 +1105,9 @@ void Expr::evalEncodings(
             finalRowsHolder);
         auto* newRows = peelEncodingsResult.newRows;
         if (newRows) {
+          if (context.exprProfilingEnabled()) {
+            ++stats_.numPeeledVectors;
+          }
           VectorPtr peeledResult;
           // peelEncodings() can potentially produce an empty selectivity
           // vector if all selected values we are waiting for are nulls. So,
@@ -1199,6 +1238,12 @@ void Expr::evalWithMemo(
 
   if (baseOfDictionaryRepeats_ == 1) {
     evalWithNulls(rows, context, result);
+    if (result->retainedSize() > context.maxDictionaryMemoBytes()) {
+      // Too large to keep across batches. Start over on the next batch.
+      baseOfDictionaryRepeats_ = 0;
+      context.releaseVector(base);
+      return;
+    }
     baseOfDictionary_ = base;
     dictionaryCache_ = result;
     if (!cachedDictionaryIndices_) {
@@ -1216,6 +1261,9 @@ void Expr::evalWithMemo(
     VELOX_DCHECK(cached != nullptr);
     cached->intersect(*cachedDictionaryIndices_);
     if (cached->hasSelections()) {
+      if (context.exprProfilingEnabled()) {
+        stats_.numMemoHits += cached->countSelected();
+      }
       context.ensureWritable(rows, type(), result);
       result->copy(dictionaryCache_.get(), *cached, nullptr);
     }
@@ -1235,6 +1283,11 @@ void Expr::evalWithMemo(
 
     evalWithNulls(*uncached, context, result);
     context.deselectErrors(*uncached);
+    if (dictionaryCache_->retainedSize() > context.maxDictionaryMemoBytes()) {
+      // The cache is full. Keep serving the rows already in it.
+      context.releaseVector(base);
+      return;
+    }
     context.exprSet()->addToMemo(this);
     auto newCacheSize = uncached->end();
 
@@ -1462,6 +1515,9 @@ bool Expr::applyFunctionWithPeeling(
   if (!peeledEncoding) {
     return false;
   }
+  if (context.exprProfilingEnabled()) {
+    ++stats_.numPeeledVectors;
+  }
   inputValues_ = std::move(peeledVectors);
   peeledVectors.clear();
 
@@ -1498,6 +1554,9 @@ void Expr::applyFunction(
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
+  const auto startBytes = context.exprProfilingEnabled()
+      ? context.pool()->stats().cumulativeBytes
+      : 0;
   auto timer = cpuWallTimer();
 
   computeIsAsciiForInputs(vectorFunction_.get(), inputValues_, rows);
@@ -1538,6 +1597,10 @@ void Expr::applyFunction(
     result->asUnchecked<SimpleVector<StringView>>()->setIsAscii(
         isAscii.value(), rows);
   }
+
+  if (context.exprProfilingEnabled()) {
+    addProfile(rows, context, result, startBytes);
+  }
 }
 
 void Expr::evalSpecialFormWithStats(
@@ -1546,9 +1609,37 @@ void Expr::evalSpecialFormWithStats(
     VectorPtr& result) {
   stats_.numProcessedVectors += 1;
   stats_.numProcessedRows += rows.countSelected();
+  const auto startBytes = context.exprProfilingEnabled()
+      ? context.pool()->stats().cumulativeBytes
+      : 0;
   auto timer = cpuWallTimer();
 
   evalSpecialForm(rows, context, result);
+
+  if (context.exprProfilingEnabled()) {
+    addProfile(rows, context, result, startBytes);
+  }
+}
+
+void Expr::addProfile(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    const VectorPtr& result,
+    uint64_t startBytes) {
+  stats_.profiled = true;
+  stats_.allocatedBytes += context.pool()->stats().cumulativeBytes - startBytes;
+  if (result == nullptr) {
+    return;
+  }
+  auto numOutputRows = rows.countSelected();
+  if (result->mayHaveNulls()) {
+    rows.applyToSelected([&](auto row) {
+      if (result->isNullAt(row)) {
+        --numOutputRows;
+      }
+    });
+  }
+  stats_.numOutputRows += numOutputRows;
 }
 
 namespace {
@@ -1575,7 +1666,14 @@ void printExprTree(
   if (withStats) {
     out << " [cpu time: " << succinctNanos(stats.timing.cpuNanos)
         << ", rows: " << stats.numProcessedRows
-        << ", batches: " << stats.numProcessedVectors << "]";
+        << ", batches: " << stats.numProcessedVectors;
+    if (stats.profiled) {
+      out << ", output rows: " << stats.numOutputRows
+          << ", allocated: " << succinctBytes(stats.allocatedBytes)
+          << ", peeled batches: " << stats.numPeeledVectors
+          << ", memo hits: " << stats.numMemoHits;
+    }
+    out << "]";
   }
   out << " -> " << expr.type()->toString() << " [#" << id << "]" << std::endl;
 
@@ -1682,33 +1780,38 @@ common::Subfield extractSubfield(
       return {};
     }
     auto* index = expr->inputs()[1]->as<ConstantExpr>();
-    if (!index) {
+    if (!index || index->value()->isNullAt(0)) {
       return {};
     }
+    int64_t longIndex;
     switch (index->value()->typeKind()) {
       case TypeKind::TINYINT:
-        path.push_back(std::make_unique<common::Subfield::LongSubscript>(
-            index->value()->as<ConstantVector<int8_t>>()->value()));
+        longIndex = index->value()->as<ConstantVector<int8_t>>()->value();
         break;
       case TypeKind::SMALLINT:
-        path.push_back(std::make_unique<common::Subfield::LongSubscript>(
-            index->value()->as<ConstantVector<int16_t>>()->value()));
+        longIndex = index->value()->as<ConstantVector<int16_t>>()->value();
         break;
       case TypeKind::INTEGER:
-        path.push_back(std::make_unique<common::Subfield::LongSubscript>(
-            index->value()->as<ConstantVector<int32_t>>()->value()));
+        longIndex = index->value()->as<ConstantVector<int32_t>>()->value();
         break;
       case TypeKind::BIGINT:
-        path.push_back(std::make_unique<common::Subfield::LongSubscript>(
-            index->value()->as<ConstantVector<int64_t>>()->value()));
+        longIndex = index->value()->as<ConstantVector<int64_t>>()->value();
         break;
       case TypeKind::VARCHAR:
         path.push_back(std::make_unique<common::Subfield::StringSubscript>(
             index->value()->as<ConstantVector<StringView>>()->value()));
-        break;
+        expr = expr->inputs()[0].get();
+        continue;
       default:
         return {};
     }
+    // Arrays are pruned to their first elements, which does not preserve the
+    // elements addressed from the end by a negative index.
+    if (longIndex <= 0 && expr->inputs()[0]->type()->isArray()) {
+      return {};
+    }
+    path.push_back(
+        std::make_unique<common::Subfield::LongSubscript>(longIndex));
     expr = expr->inputs()[0].get();
   }
 }
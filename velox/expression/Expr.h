@@ -46,6 +46,7 @@ namespace facebook::velox::exec {
 
 class ExprSet;
 class FieldReference;
+class FusedEvaluator;
 class VectorFunction;
 
 struct ExprStats {
@@ -59,18 +60,55 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// The counters below require QueryConfig.exprProfilingEnabled() to be
+  /// 'true'.
+
+  /// Number of processed rows with a non-null result.
+  uint64_t numOutputRows{0};
+
+  /// Bytes allocated from the memory pool while evaluating the expression.
+  /// Includes the allocations of the inputs of special forms.
+  uint64_t allocatedBytes{0};
+
+  /// Number of batches evaluated on peeled inputs.
+  uint64_t numPeeledVectors{0};
+
+  /// Number of rows served from the dictionary memo of Expr::evalWithMemo.
+  uint64_t numMemoHits{0};
+
+  /// True if the counters above were collected.
+  bool profiled{false};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numOutputRows += other.numOutputRows;
+    allocatedBytes += other.allocatedBytes;
+    numPeeledVectors += other.numPeeledVectors;
+    numMemoHits += other.numMemoHits;
+    profiled |= other.profiled;
   }
 
   std::string toString() const {
+    if (!profiled) {
+      return fmt::format(
+          "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+          timing.toString(),
+          numProcessedRows,
+          numProcessedVectors);
+    }
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numOutputRows: {}, allocatedBytes: {}, numPeeledVectors: {}, "
+        "numMemoHits: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numOutputRows,
+        allocatedBytes,
+        numPeeledVectors,
+        numMemoHits);
   }
 };
 
@@ -373,6 +411,16 @@ class Expr {
     return vectorFunctionMetadata_;
   }
 
+  /// Sets an evaluator that evaluates 'this' and its inputs in one pass when
+  /// the inputs are flat or constant and have no nulls.
+  void setFusedEvaluator(std::shared_ptr<FusedEvaluator> fusedEvaluator) {
+    fusedEvaluator_ = std::move(fusedEvaluator);
+  }
+
+  bool hasFusedEvaluator() const {
+    return fusedEvaluator_ != nullptr;
+  }
+
   auto& inputValues() {
     return inputValues_;
   }
@@ -500,6 +548,15 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Adds the rows of 'result' that are not null and the bytes allocated from
+  // the pool of 'context' since 'startBytes' to the profiling counters in
+  // 'stats_'.
+  void addProfile(
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      const VectorPtr& result,
+      uint64_t startBytes);
+
  protected:
   void appendInputs(std::stringstream& stream) const;
 
@@ -558,7 +615,7 @@ class Expr {
 
   // True if this is a spcial form where the next argument will always be
   // evaluated on a subset of the rows for which the previous one was evaluated.
-  // This is true of AND and no other at this time.  This implies that lazies
+  // This is true of AND and COALESCE.  This implies that lazies
   // can be loaded on first use and not before starting evaluating the form.
   // This is so because a subsequent use will never access rows that were not in
   // scope for the previous one.
@@ -602,6 +659,10 @@ class Expr {
 
   bool isMultiplyReferenced_ = false;
 
+  // Evaluates 'this' and its inputs in one pass if set. See
+  // QueryConfig::kExprFusedEvalEnabled.
+  std::shared_ptr<FusedEvaluator> fusedEvaluator_;
+
   std::vector<VectorPtr> inputValues_;
 
   struct SharedResults {
@@ -615,6 +676,20 @@ class Expr {
   // evaluateSharedSubexpr() is called to the cached shared results.
   std::map<std::vector<const BaseVector*>, SharedResults> sharedSubexprResults_;
 
+  // Number of rows to measure the cost of a shared subexpression over before
+  // deciding whether to cache its results.
+  static constexpr uint64_t kSharedSubexprCostSampleRows = 10'000;
+
+  // Time and number of rows of the evaluations measured to decide whether
+  // 'this' is expensive enough to cache. See
+  // QueryConfig::kMinSharedSubexprCostNanosPerRow.
+  uint64_t sharedSubexprCostNanos_{0};
+  uint64_t sharedSubexprCostRows_{0};
+
+  // True if the measured cost per row of 'this' is below the minimum, so that
+  // the results are not cached.
+  bool sharedSubexprTooCheap_{false};
+
   // Pointers to the last base vector of cachable dictionary input. Used to
   // check if the current input's base vector is the same as the last. If it's
   // the same, then results can be cached.
@@ -870,6 +945,10 @@ class SimpleExpressionEvaluator : public core::ExpressionEvaluator {
 
 class Subscript : public exec::VectorFunction {
  public:
+  /// Returns true if a subscript with a constant index may be extracted as a
+  /// subfield for pruning in the reader. The reader then returns only the
+  /// requested map keys or the array elements up to the largest index, so the
+  /// function must return the same result on the pruned map or array.
   virtual bool canPushdown() const {
     return false;
   }
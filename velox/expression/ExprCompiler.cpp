@@ -21,6 +21,7 @@
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/expression/FusedEvaluator.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/RowConstructor.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -296,7 +297,7 @@ std::shared_ptr<Expr> compileLambda(
       std::move(signature),
       std::move(captureReferences),
       std::move(body),
-      config.exprTrackCpuUsage());
+      config.exprTrackCpuUsage() || config.exprProfilingEnabled());
 }
 
 ExprPtr tryFoldIfConstant(const ExprPtr& expr, Scope* scope) {
@@ -356,6 +357,21 @@ core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   return expr;
 }
 
+/// Applies the registered expression set re-writes to 'sources'. Returns
+/// 'sources' if none of them applies.
+std::vector<TypedExprPtr> rewriteExpressionSet(
+    const std::vector<TypedExprPtr>& sources) {
+  std::vector<TypedExprPtr> rewritten = sources;
+  for (auto& rewrite : expressionSetRewrites()) {
+    auto result = rewrite(rewritten);
+    if (!result.empty()) {
+      VELOX_CHECK_EQ(result.size(), rewritten.size());
+      rewritten = std::move(result);
+    }
+  }
+  return rewritten;
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -376,7 +392,8 @@ ExprPtr compileRewrittenExpression(
     return alreadyCompiled;
   }
 
-  const bool trackCpuUsage = config.exprTrackCpuUsage();
+  const bool trackCpuUsage =
+      config.exprTrackCpuUsage() || config.exprProfilingEnabled();
 
   ExprPtr result;
   auto resultType = expr->type();
@@ -574,6 +591,20 @@ std::unordered_set<std::string> collectFlatteningCandidates(
     return flatteningCandidates;
   });
 }
+
+/// Sets a FusedEvaluator on the largest subtrees of 'expr' that can be fused.
+void enableFusedEval(Expr& expr) {
+  if (expr.hasFusedEvaluator()) {
+    return;
+  }
+  if (auto evaluator = FusedEvaluator::create(expr)) {
+    expr.setFusedEvaluator(std::move(evaluator));
+    return;
+  }
+  for (const auto& input : expr.inputs()) {
+    enableFusedEval(*input);
+  }
+}
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
@@ -585,11 +616,13 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  const auto rewrittenSources = rewriteExpressionSet(sources);
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewrittenSources);
 
-  for (auto& source : sources) {
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
@@ -598,6 +631,11 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
         flatteningCandidates,
         enableConstantFolding));
   }
+  if (execCtx->queryCtx()->queryConfig().exprFusedEvalEnabled()) {
+    for (auto& expr : exprs) {
+      enableFusedEval(*expr);
+    }
+  }
   return exprs;
 }
 
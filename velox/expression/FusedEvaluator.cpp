@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/FusedEvaluator.h"
+
+#include <array>
+#include <cstring>
+
+#include "velox/expression/ConjunctExpr.h"
+#include "velox/expression/ConstantExpr.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Returns the size of a value of 'kind' in the scratch buffers or 0 if 'kind'
+// is not supported.
+int32_t valueWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+void gather(
+    const void* values,
+    const vector_size_t* rows,
+    int32_t numRows,
+    void* result) {
+  auto* typedValues = reinterpret_cast<const T*>(values);
+  auto* typedResult = reinterpret_cast<T*>(result);
+  for (auto i = 0; i < numRows; ++i) {
+    typedResult[i] = typedValues[rows[i]];
+  }
+}
+
+template <typename T>
+void scatter(
+    const void* values,
+    const vector_size_t* rows,
+    int32_t numRows,
+    void* result) {
+  auto* typedValues = reinterpret_cast<const T*>(values);
+  auto* typedResult = reinterpret_cast<T*>(result);
+  for (auto i = 0; i < numRows; ++i) {
+    typedResult[rows[i]] = typedValues[i];
+  }
+}
+
+// Calls 'func' with an integer type of 'width' bytes.
+template <typename Func>
+void widthDispatch(int32_t width, Func func) {
+  switch (width) {
+    case 1:
+      return func(int8_t());
+    case 2:
+      return func(int16_t());
+    case 4:
+      return func(int32_t());
+    case 8:
+      return func(int64_t());
+    default:
+      VELOX_UNREACHABLE("Bad width {}", width);
+  }
+}
+} // namespace
+
+// static
+std::unique_ptr<FusedEvaluator> FusedEvaluator::create(const Expr& expr) {
+  std::unique_ptr<FusedEvaluator> evaluator(new FusedEvaluator());
+  int32_t numCalls = 0;
+  if (evaluator->addSteps(expr, numCalls) < 0 || numCalls < 2) {
+    return nullptr;
+  }
+  const auto numSteps = evaluator->steps_.size();
+  evaluator->inputs_.resize(numSteps);
+  evaluator->values_.resize(numSteps);
+  evaluator->scratch_.resize(numSteps * kBlockSize * sizeof(int64_t));
+  for (auto i = 0; i < numSteps; ++i) {
+    const auto& step = evaluator->steps_[i];
+    if (step.kind != StepKind::kConstant) {
+      continue;
+    }
+    auto* value = static_cast<const char*>(step.constant->valuesAsVoid());
+    auto* scratch = evaluator->scratch(i);
+    for (auto row = 0; row < kBlockSize; ++row) {
+      std::memcpy(scratch + row * step.width, value, step.width);
+    }
+    evaluator->values_[i] = scratch;
+  }
+  return evaluator;
+}
+
+int32_t FusedEvaluator::addSteps(const Expr& expr, int32_t& numCalls) {
+  Step step;
+  step.type = expr.type();
+  step.width = valueWidth(step.type->kind());
+  if (step.width == 0 || !expr.isDeterministic()) {
+    return -1;
+  }
+  if (auto* field = dynamic_cast<const FieldReference*>(&expr)) {
+    if (!field->inputs().empty()) {
+      return -1;
+    }
+    step.kind = StepKind::kField;
+    step.field = const_cast<FieldReference*>(field);
+  } else if (auto* constant = dynamic_cast<const ConstantExpr*>(&expr)) {
+    if (constant->value()->isNullAt(0)) {
+      return -1;
+    }
+    step.kind = StepKind::kConstant;
+    step.constant = constant->value();
+  } else if (auto* conjunct = dynamic_cast<const ConjunctExpr*>(&expr)) {
+    step.kind = conjunct->isAnd() ? StepKind::kAnd : StepKind::kOr;
+  } else if (!expr.isSpecialForm()) {
+    for (const auto& input : expr.inputs()) {
+      step.argTypes.push_back(input->type());
+    }
+    if (!expr.vectorFunction()->supportsFusedEval(step.argTypes)) {
+      return -1;
+    }
+    step.kind = StepKind::kCall;
+    step.function = expr.vectorFunction().get();
+    ++numCalls;
+  } else {
+    return -1;
+  }
+  for (const auto& input : expr.inputs()) {
+    const auto arg = addSteps(*input, numCalls);
+    if (arg < 0) {
+      return -1;
+    }
+    step.args.push_back(arg);
+  }
+  steps_.push_back(std::move(step));
+  return steps_.size() - 1;
+}
+
+bool FusedEvaluator::prepareInputs(
+    const SelectivityVector& rows,
+    EvalCtx& context) {
+  for (auto i = 0; i < steps_.size(); ++i) {
+    auto& step = steps_[i];
+    if (step.kind != StepKind::kField) {
+      continue;
+    }
+    const auto& input = context.getField(step.field->index(context));
+    if ((!input->isFlatEncoding() && !input->isConstantEncoding()) ||
+        input->mayHaveNulls() || input->size() < rows.end()) {
+      return false;
+    }
+    inputs_[i] = input.get();
+    if (input->isConstantEncoding()) {
+      auto* value = static_cast<const char*>(input->valuesAsVoid());
+      auto* scratch = this->scratch(i);
+      for (auto row = 0; row < kBlockSize; ++row) {
+        std::memcpy(scratch + row * step.width, value, step.width);
+      }
+      values_[i] = scratch;
+    }
+  }
+  return true;
+}
+
+bool FusedEvaluator::evalBlock(const vector_size_t* rows, int32_t numRows) {
+  const bool contiguous = rows[numRows - 1] - rows[0] == numRows - 1;
+  for (auto i = 0; i < steps_.size(); ++i) {
+    const auto& step = steps_[i];
+    switch (step.kind) {
+      case StepKind::kField: {
+        const auto* input = inputs_[i];
+        if (input->isConstantEncoding()) {
+          break;
+        }
+        if (step.type->kind() == TypeKind::BOOLEAN) {
+          const auto* bits = input->values()->as<uint64_t>();
+          auto* result = reinterpret_cast<bool*>(scratch(i));
+          for (auto j = 0; j < numRows; ++j) {
+            result[j] = bits::isBitSet(bits, rows[j]);
+          }
+          values_[i] = result;
+        } else if (contiguous) {
+          values_[i] = static_cast<const char*>(input->valuesAsVoid()) +
+              rows[0] * step.width;
+        } else {
+          widthDispatch(step.width, [&](auto value) {
+            gather<decltype(value)>(
+                input->valuesAsVoid(), rows, numRows, scratch(i));
+          });
+          values_[i] = scratch(i);
+        }
+        break;
+      }
+      case StepKind::kConstant:
+        break;
+      case StepKind::kCall: {
+        args_.resize(step.args.size());
+        for (auto j = 0; j < step.args.size(); ++j) {
+          args_[j] = values_[step.args[j]];
+        }
+        if (!step.function->applyFused(
+                step.argTypes, numRows, args_.data(), scratch(i))) {
+          return false;
+        }
+        values_[i] = scratch(i);
+        break;
+      }
+      case StepKind::kAnd:
+      case StepKind::kOr: {
+        auto* result = reinterpret_cast<bool*>(scratch(i));
+        std::memcpy(result, values_[step.args[0]], numRows);
+        for (auto j = 1; j < step.args.size(); ++j) {
+          const auto* arg = static_cast<const bool*>(values_[step.args[j]]);
+          if (step.kind == StepKind::kAnd) {
+            for (auto row = 0; row < numRows; ++row) {
+              result[row] = result[row] & arg[row];
+            }
+          } else {
+            for (auto row = 0; row < numRows; ++row) {
+              result[row] = result[row] | arg[row];
+            }
+          }
+        }
+        values_[i] = result;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+bool FusedEvaluator::eval(
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  if (!rows.hasSelections() || !prepareInputs(rows, context)) {
+    return false;
+  }
+  const auto& root = steps_.back();
+  const bool isBoolean = root.type->kind() == TypeKind::BOOLEAN;
+  VectorPtr localResult;
+  context.ensureWritable(rows, root.type, localResult);
+  localResult->clearNulls(rows);
+  auto* rawResult = localResult->values()->asMutable<char>();
+
+  std::array<vector_size_t, kBlockSize> blockRows;
+  int32_t numRows = 0;
+  bool ok = true;
+  auto evalAndStore = [&]() {
+    if (!evalBlock(blockRows.data(), numRows)) {
+      ok = false;
+      return;
+    }
+    const auto* values = values_.back();
+    if (isBoolean) {
+      const auto* bools = static_cast<const bool*>(values);
+      auto* bits = reinterpret_cast<uint64_t*>(rawResult);
+      for (auto i = 0; i < numRows; ++i) {
+        bits::setBit(bits, blockRows[i], bools[i]);
+      }
+    } else {
+      widthDispatch(root.width, [&](auto value) {
+        scatter<decltype(value)>(values, blockRows.data(), numRows, rawResult);
+      });
+    }
+    numRows = 0;
+  };
+  try {
+    rows.applyToSelected([&](auto row) {
+      if (!ok) {
+        return;
+      }
+      blockRows[numRows++] = row;
+      if (numRows == kBlockSize) {
+        evalAndStore();
+      }
+    });
+    if (ok && numRows > 0) {
+      evalAndStore();
+    }
+  } catch (const std::exception&) {
+    // The regular evaluation reports the error if it is not masked by a
+    // conditional.
+    ok = false;
+  }
+  if (!ok) {
+    context.releaseVector(localResult);
+    return false;
+  }
+  context.moveOrCopyResult(localResult, rows, result);
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/RawVector.h"
+#include "velox/expression/Expr.h"
+
+namespace facebook::velox::exec {
+
+/// Evaluates a tree of deterministic simple functions, AND and OR over
+/// fixed-width columns and constants in a single pass over blocks of rows.
+/// The intermediate results of a block are kept in small scratch buffers
+/// instead of being materialized in a vector per function call. For example,
+/// 'a * b + c > d AND e < f' is evaluated without making the 5 intermediate
+/// vectors of the regular evaluation.
+///
+/// Set on an Expr by compileExpressions() if enabled by
+/// QueryConfig::kExprFusedEvalEnabled.
+class FusedEvaluator {
+ public:
+  /// Number of rows evaluated at a time.
+  static constexpr int32_t kBlockSize = 256;
+
+  /// Returns an evaluator for the tree rooted at 'expr' or nullptr if the tree
+  /// contains an expression that cannot be fused or has fewer than two
+  /// function calls.
+  static std::unique_ptr<FusedEvaluator> create(const Expr& expr);
+
+  /// Evaluates the tree for 'rows' and sets 'result'. Returns false without
+  /// changing 'result' if an input is not flat or constant without nulls or
+  /// if a function returns null or fails for one of 'rows'. The caller then
+  /// evaluates the tree the regular way, which produces the nulls and
+  /// errors.
+  bool eval(const SelectivityVector& rows, EvalCtx& context, VectorPtr& result);
+
+ private:
+  enum class StepKind { kField, kConstant, kCall, kAnd, kOr };
+
+  // One node of the tree. Steps are in post order, the last step is the root.
+  struct Step {
+    StepKind kind;
+    TypePtr type;
+    // Size of a value in bytes. Booleans take one byte.
+    int32_t width;
+    // Field for kField.
+    FieldReference* field{nullptr};
+    // Value for kConstant.
+    VectorPtr constant;
+    // Function and argument types for kCall.
+    const VectorFunction* function{nullptr};
+    std::vector<TypePtr> argTypes;
+    // Indices of the steps producing the arguments.
+    std::vector<int32_t> args;
+  };
+
+  FusedEvaluator() = default;
+
+  // Adds the steps for 'expr' and its inputs and returns the index of the step
+  // for 'expr' or -1 if 'expr' cannot be fused.
+  int32_t addSteps(const Expr& expr, int32_t& numCalls);
+
+  // Returns the start of the scratch buffer of 'step'.
+  char* scratch(int32_t step) {
+    return scratch_.data() + step * kBlockSize * sizeof(int64_t);
+  }
+
+  // Sets 'inputs_' and the scratch buffers of constant inputs. Returns false
+  // if an input is not flat or constant without nulls.
+  bool prepareInputs(const SelectivityVector& rows, EvalCtx& context);
+
+  // Evaluates the steps for 'numRows' rows in 'rows' and sets 'values_' to
+  // the values of each step. Returns false if a function returned null or an
+  // error.
+  bool evalBlock(const vector_size_t* rows, int32_t numRows);
+
+  std::vector<Step> steps_;
+
+  // Input vector of each kField step, nullptr for other steps.
+  std::vector<const BaseVector*> inputs_;
+
+  // Values of each step for the current block. Point to 'scratch_' or to the
+  // values of a flat input.
+  std::vector<const void*> values_;
+
+  // Argument pointers of a kCall step.
+  std::vector<const void*> args_;
+
+  // Scratch space for kBlockSize values of each step.
+  raw_vector<char> scratch_;
+};
+
+} // namespace facebook::velox::exec
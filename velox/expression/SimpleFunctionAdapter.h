@@ -93,6 +93,36 @@ class SimpleFunctionAdapter : public VectorFunction {
   constexpr int32_t reuseStringsFromArgValue() const {
     return udf_reuse_strings_from_arg<typename FUNC::udf_struct_t>();
   }
+  // True if the function has default null behavior, no ASCII or null-free
+  // variants and takes and returns arithmetic C++ types, so that it can be
+  // applied to arrays of values by applyFused().
+  static constexpr bool fusedEvalEligible() {
+    if constexpr (
+        FUNC::num_args == 0 || !FUNC::is_default_null_behavior ||
+        FUNC::udf_has_callNullFree || FUNC::has_ascii ||
+        !std::is_arithmetic_v<T>) {
+      return false;
+    } else {
+      return fusedEvalEligibleArgs(std::make_index_sequence<FUNC::num_args>());
+    }
+  }
+
+  // True if the rows can be evaluated by applyDense(). Rows are evaluated
+  // again if applyDense() fails, so the function must be deterministic.
+  static constexpr bool denseIterationEligible() {
+    return fusedEvalEligible() &&
+        return_type_traits::typeKind != TypeKind::BOOLEAN &&
+        udf_is_deterministic<typename FUNC::udf_struct_t>();
+  }
+
+  template <size_t... Is>
+  static constexpr bool fusedEvalEligibleArgs(std::index_sequence<Is...>) {
+    return (
+        (!isVariadicType<arg_at<Is>>::value &&
+         std::is_arithmetic_v<exec_arg_at<Is>>) &&
+        ...);
+  }
+
   template <size_t... Is>
   bool allArgsPrimitiveImpl(std::index_sequence<Is...>) const {
     return ([&]() {
@@ -173,7 +203,7 @@ class SimpleFunctionAdapter : public VectorFunction {
         EvalCtx& _context,
         VectorPtr& _result,
         bool isResultReused)
-        : rows{_rows}, context{_context} {
+        : rows{_rows}, context{_context}, isResultReused{isResultReused} {
       // If we're reusing the input, we've already checked that the vector
       // is unique, as is nulls.  We also know the size of the vector is
       // at least as large as the size of rows.
@@ -205,6 +235,7 @@ class SimpleFunctionAdapter : public VectorFunction {
     result_vector_t* result;
     VectorWriter<typename FUNC::return_type> resultWriter;
     EvalCtx& context;
+    const bool isResultReused;
     bool allAscii{false};
     bool mayHaveNullsRecursive{false};
   };
@@ -443,6 +474,31 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  bool supportsFusedEval(
+      const std::vector<TypePtr>& /*argTypes*/) const override {
+    if constexpr (fusedEvalEligible()) {
+      return initializeException_ == nullptr;
+    } else {
+      return false;
+    }
+  }
+
+  bool applyFused(
+      const std::vector<TypePtr>& argTypes,
+      vector_size_t size,
+      const void* const* args,
+      void* result) const override {
+    if constexpr (fusedEvalEligible()) {
+      return applyFusedImpl(
+          size,
+          args,
+          static_cast<T*>(result),
+          std::make_index_sequence<FUNC::num_args>());
+    } else {
+      return VectorFunction::applyFused(argTypes, size, args, result);
+    }
+  }
+
   bool ensureStringEncodingSetAtAllInputs() const override {
     return fn_->has_ascii;
   }
@@ -611,6 +667,13 @@ class SimpleFunctionAdapter : public VectorFunction {
           bits::setNull(nullBuffer, row);
         }
       };
+      if constexpr (denseIterationEligible()) {
+        if (applyContext.rows->isAllSelected() &&
+            !applyContext.isResultReused && (!readers.mayHaveNulls() && ...) &&
+            applyDense(applyContext, data, readers...)) {
+          return;
+        }
+      }
       if (callNullFree) {
         // This results in some code duplication, but applying this check
         // once per batch instead of once per row shows a significant
@@ -740,6 +803,53 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
   }
 
+  // Evaluates the function for all rows from begin() to end() of the rows of
+  // 'applyContext' without per-row error handling or null tracking, so that
+  // the loop can be vectorized if the function is inlined. Returns false if
+  // the function threw or returned an error or null for a row. The caller
+  // then evaluates the rows again the regular way.
+  template <typename TData, typename... TReader>
+  bool applyDense(
+      ApplyContext& applyContext,
+      TData* data,
+      TReader&... readers) const {
+    const auto end = applyContext.rows->end();
+    bool ok = true;
+    try {
+      for (auto row = applyContext.rows->begin(); row < end; ++row) {
+        typename return_type_traits::NativeType out{};
+        bool notNull;
+        auto status = doApplyNotNull<0>(row, out, notNull, readers...);
+        ok &= status.ok() && notNull;
+        data[row] = out;
+      }
+    } catch (const std::exception&) {
+      return false;
+    }
+    return ok;
+  }
+
+  template <size_t... Is>
+  bool applyFusedImpl(
+      vector_size_t size,
+      const void* const* args,
+      T* result,
+      std::index_sequence<Is...>) const {
+    for (vector_size_t i = 0; i < size; ++i) {
+      T out{};
+      bool notNull;
+      auto status = (*fn_).call(
+          out,
+          notNull,
+          reinterpret_cast<const exec_arg_at<Is>*>(args[Is])[i]...);
+      if (UNLIKELY(!status.ok() || !notNull)) {
+        return false;
+      }
+      result[i] = out;
+    }
+    return true;
+  }
+
   template <typename Func>
   void applyUdf(ApplyContext& applyContext, Func func) const {
     if constexpr (IsArrayWriter<T>::value || IsMapWriter<T>::value) {
@@ -16,6 +16,8 @@
 
 #include "velox/expression/SimpleFunctionRegistry.h"
 
+#include "velox/common/base/BitUtil.h"
+
 namespace facebook::velox::exec {
 namespace {
 
@@ -40,6 +42,7 @@ bool SimpleFunctionRegistry::registerFunctionInternal(
     bool overwrite) {
   const auto sanitizedName = sanitizeName(name);
   return registeredFunctions_.withWLock([&](auto& map) {
+    resolutionCache_.wlock()->clear();
     SignatureMap& signatureMap = map[sanitizedName];
     auto& functions = signatureMap[*metadata->signature()];
 
@@ -144,60 +147,113 @@ bool physicalTypeMatches(const TypePtr& type, const TypePtr& physicalType) {
 
 } // namespace
 
-std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
-SimpleFunctionRegistry::resolveFunction(
+bool SimpleFunctionRegistry::ResolutionKey::operator==(
+    const ResolutionKey& other) const {
+  if (name != other.name || argTypes.size() != other.argTypes.size()) {
+    return false;
+  }
+  for (auto i = 0; i < argTypes.size(); ++i) {
+    if (*argTypes[i] != *other.argTypes[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t SimpleFunctionRegistry::ResolutionKeyHasher::operator()(
+    const ResolutionKey& key) const {
+  auto hash = std::hash<std::string>()(key.name);
+  for (const auto& type : key.argTypes) {
+    hash = bits::hashMix(hash, type->hashKind());
+  }
+  return hash;
+}
+
+// static
+std::optional<SimpleFunctionRegistry::ResolvedEntry>
+SimpleFunctionRegistry::bindFunction(
+    const FunctionMap& map,
     const std::string& name,
-    const std::vector<TypePtr>& argTypes) const {
+    const std::vector<TypePtr>& argTypes) {
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
-  registeredFunctions_.withRLock([&](const auto& map) {
-    if (const auto* signatureMap = getSignatureMap(name, map)) {
-      for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
-        SignatureBinder binder(candidateSignature, argTypes);
-        if (binder.tryBind()) {
-          for (const auto& currentCandidate : functionEntry) {
-            const auto& m = currentCandidate->getMetadata();
-
-            // For variadic signatures, number of arguments in function call may
-            // be one less than number of arguments in the signature.
-            const auto numArgsToMatch =
-                std::min(argTypes.size(), m.argPhysicalTypes().size());
-
-            bool match = true;
-            for (auto i = 0; i < numArgsToMatch; ++i) {
-              if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
-                match = false;
-                break;
-              }
-            }
+  if (const auto* signatureMap = getSignatureMap(name, map)) {
+    for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
+      SignatureBinder binder(candidateSignature, argTypes);
+      if (binder.tryBind()) {
+        for (const auto& currentCandidate : functionEntry) {
+          const auto& m = currentCandidate->getMetadata();
 
-            if (!match) {
-              continue;
+          // For variadic signatures, number of arguments in function call may
+          // be one less than number of arguments in the signature.
+          const auto numArgsToMatch =
+              std::min(argTypes.size(), m.argPhysicalTypes().size());
+
+          bool match = true;
+          for (auto i = 0; i < numArgsToMatch; ++i) {
+            if (!physicalTypeMatches(argTypes[i], m.argPhysicalTypes()[i])) {
+              match = false;
+              break;
             }
+          }
 
-            if (!selectedCandidate ||
-                currentCandidate->getMetadata().priority() <
-                    selectedCandidate->getMetadata().priority()) {
-              auto resultType = binder.tryResolveReturnType();
-              VELOX_CHECK_NOT_NULL(resultType);
+          if (!match) {
+            continue;
+          }
 
-              if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
-                selectedCandidate = currentCandidate.get();
-                selectedCandidateType = resultType;
-              }
+          if (!selectedCandidate ||
+              currentCandidate->getMetadata().priority() <
+                  selectedCandidate->getMetadata().priority()) {
+            auto resultType = binder.tryResolveReturnType();
+            VELOX_CHECK_NOT_NULL(resultType);
+
+            if (physicalTypeMatches(resultType, m.resultPhysicalType())) {
+              selectedCandidate = currentCandidate.get();
+              selectedCandidateType = resultType;
             }
           }
         }
       }
     }
-  });
+  }
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
 
   return selectedCandidate
-      ? std::optional<ResolvedSimpleFunction>(
-            ResolvedSimpleFunction(*selectedCandidate, selectedCandidateType))
+      ? std::optional<ResolvedEntry>(
+            ResolvedEntry{selectedCandidate, selectedCandidateType})
       : std::nullopt;
 }
 
+std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
+SimpleFunctionRegistry::resolveFunction(
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes) const {
+  ResolutionKey key{name, argTypes};
+  return registeredFunctions_.withRLock(
+      [&](const auto& map) -> std::optional<ResolvedSimpleFunction> {
+        std::optional<ResolvedEntry> resolved;
+        {
+          auto cache = resolutionCache_.rlock();
+          auto it = cache->find(key);
+          if (it != cache->end()) {
+            resolved = it->second;
+          }
+        }
+        if (!resolved.has_value()) {
+          resolved = bindFunction(map, name, argTypes);
+          if (!resolved.has_value()) {
+            return std::nullopt;
+          }
+          auto cache = resolutionCache_.wlock();
+          if (cache->size() >= kMaxResolutionCacheSize) {
+            cache->clear();
+          }
+          cache->emplace(std::move(key), *resolved);
+        }
+        return ResolvedSimpleFunction(
+            *resolved->functionEntry, resolved->type);
+      });
+}
+
 } // namespace facebook::velox::exec
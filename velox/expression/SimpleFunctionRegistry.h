@@ -104,7 +104,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolutionCache_.wlock()->clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -144,11 +147,49 @@ class SimpleFunctionRegistry {
     const TypePtr type_;
   };
 
+  /// Returns the function with the highest priority among the ones whose
+  /// signature binds to 'argTypes'. The result is cached by name and argument
+  /// types, so that compiling many expressions of the same shape binds each
+  /// signature once. The cache is cleared on registration.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
+  /// Returns the number of cached resolutions. Used in tests.
+  size_t resolutionCacheSize() const {
+    return resolutionCache_.rlock()->size();
+  }
+
  private:
+  /// Maximum number of cached resolutions. The cache is cleared when full.
+  static constexpr size_t kMaxResolutionCacheSize = 10'000;
+
+  struct ResolutionKey {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const ResolutionKey& other) const;
+  };
+
+  struct ResolutionKeyHasher {
+    size_t operator()(const ResolutionKey& key) const;
+  };
+
+  struct ResolvedEntry {
+    const FunctionEntry* functionEntry;
+    TypePtr type;
+  };
+
+  using ResolutionCache =
+      std::unordered_map<ResolutionKey, ResolvedEntry, ResolutionKeyHasher>;
+
+  // Binds the signatures of 'name' to 'argTypes'. Must be called under a read
+  // lock of 'registeredFunctions_'.
+  static std::optional<ResolvedEntry> bindFunction(
+      const FunctionMap& map,
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes);
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -167,6 +208,11 @@ class SimpleFunctionRegistry {
       bool overwrite);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // Resolutions of successful resolveFunction() calls. Entries point into
+  // 'registeredFunctions_' and are cleared under its write lock whenever it
+  // changes. Always locked after 'registeredFunctions_'.
+  mutable folly::Synchronized<ResolutionCache> resolutionCache_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
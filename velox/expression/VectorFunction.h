@@ -91,6 +91,27 @@ class VectorFunction {
     return false;
   }
 
+  /// Returns true if the function can be evaluated with applyFused() for
+  /// arguments of 'argTypes'. Used by FusedEvaluator.
+  virtual bool supportsFusedEval(
+      const std::vector<TypePtr>& /*argTypes*/) const {
+    return false;
+  }
+
+  /// Evaluates the function on 'size' rows of non-null arguments of
+  /// 'argTypes'. 'args[i]' points to 'size' consecutive values of the C++ type
+  /// of argument 'i' and 'result' to space for 'size' values of the result
+  /// type. Booleans take one byte per value. Returns false if the function
+  /// returned null or an error status for any of the rows. The values in
+  /// 'result' are then undefined.
+  virtual bool applyFused(
+      const std::vector<TypePtr>& /*argTypes*/,
+      vector_size_t /*size*/,
+      const void* const* /*args*/,
+      void* /*result*/) const {
+    VELOX_UNSUPPORTED("Function does not support fused evaluation");
+  }
+
   // The evaluation engine will scan and set the string encoding of the
   // specified input arguments when presented if their type is VARCHAR before
   // applying the function
@@ -285,6 +306,22 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the expressions compiled into one ExprSet and
+/// returns equivalent expressions or an empty vector if re-write is not
+/// possible. Unlike ExpressionRewrite, it can rewrite expressions to share
+/// work, e.g. by replacing similar calls in several expressions with one call
+/// that is evaluated once.
+using ExpressionSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered expression set re-writes.
+std::vector<ExpressionSetRewrite>& expressionSetRewrites();
+
+/// Appends a 'rewrite' to 'expressionSetRewrites'. Set re-writes are applied
+/// in the order they were registered, each to the result of the previous one,
+/// before the expressions are compiled and before 'expressionRewrites'.
+void registerExpressionSetRewrite(ExpressionSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
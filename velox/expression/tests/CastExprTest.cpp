@@ -2039,6 +2039,26 @@ TEST_F(CastExprTest, castInTry) {
       ARRAY(ARRAY(VARCHAR())), ARRAY(ARRAY(BIGINT())), nested, nestedExpected);
 }
 
+TEST_F(CastExprTest, tryCastToDecimal) {
+  // Invalid rows are reported without exceptions and turned into nulls.
+  auto input = makeRowVector({makeFlatVector<StringView>(
+      {"1.5", "abc", "123456.0", "-2", "1.5x", "0.01"})});
+  auto expected = makeNullableFlatVector<int64_t>(
+      {150, std::nullopt, std::nullopt, -200, std::nullopt, 1},
+      DECIMAL(5, 2));
+  assertEqualVectors(
+      expected, evaluate("try_cast(c0 as decimal(5, 2))", input));
+  assertEqualVectors(
+      expected, evaluate("try(cast(c0 as decimal(5, 2)))", input));
+
+  input = makeRowVector({makeFlatVector<int64_t>(
+      {100, 12'345'678, -50, -12'345'678}, DECIMAL(10, 2))});
+  expected = makeNullableFlatVector<int64_t>(
+      {100, std::nullopt, -50, std::nullopt}, DECIMAL(5, 2));
+  assertEqualVectors(
+      expected, evaluate("try_cast(c0 as decimal(5, 2))", input));
+}
+
 TEST_F(CastExprTest, doubleToDecimal) {
   // Double to short decimal.
   const auto input = makeFlatVector<double>(
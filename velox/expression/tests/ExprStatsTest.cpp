@@ -423,3 +423,48 @@ TEST_F(ExprStatsTest, complexConstants) {
 
   ASSERT_TRUE(exec::unregisterExprSetListener(listener));
 }
+
+TEST_F(ExprStatsTest, profiling) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprProfilingEnabled, "true"},
+  });
+
+  vector_size_t size = 1'024;
+
+  // Use dictionary encoding to repeat each row 5 times. Values above 127 do
+  // not fit in a TINYINT.
+  auto indices = makeIndices(size, [](auto row) { return row / 5; });
+  auto data = makeRowVector({
+      wrapInDictionary(
+          indices,
+          size,
+          makeFlatVector<int32_t>(size, [](auto row) { return row; })),
+  });
+
+  auto exprSet =
+      compileExpressions({"try_cast(c0 as tinyint)"}, asRowType(data->type()));
+
+  // The first batch sees a new dictionary, the second populates the memo, the
+  // third is served from the memo.
+  for (auto i = 0; i < 3; ++i) {
+    evaluate(*exprSet, data);
+  }
+
+  auto stats = exprSet->stats();
+  ASSERT_EQ(1, stats.count("try_cast"));
+  const auto& castStats = stats.at("try_cast");
+  ASSERT_TRUE(castStats.profiled);
+  ASSERT_EQ(2 * 205, castStats.numProcessedRows);
+  ASSERT_EQ(2 * 128, castStats.numOutputRows);
+  ASSERT_EQ(3, castStats.numPeeledVectors);
+  ASSERT_EQ(205, castStats.numMemoHits);
+  ASSERT_GT(castStats.allocatedBytes, 0);
+
+  ASSERT_THAT(
+      exec::printExprWithStats(*exprSet),
+      ::testing::MatchesRegex(
+          "try_cast.c0 as TINYINT. .cpu time: .+, rows: 410, batches: 2, "
+          "output rows: 256, allocated: .+, peeled batches: 3, "
+          "memo hits: 205. -> TINYINT .#1.\n"
+          "   c0 .+\n"));
+}
@@ -1304,6 +1304,65 @@ TEST_P(ParameterizedExprTest, selectiveLazyLoadingOr) {
   assertEqualVectors(expected, result);
 }
 
+TEST_P(ParameterizedExprTest, selectiveLazyLoadingConditionals) {
+  const vector_size_t size = 1'000;
+
+  // Evaluate CASE and COALESCE on a lazy vector used in a branch taken by one
+  // in 10 rows. When the lazy vector is not accessed outside the expression,
+  // it is loaded only for the rows that reach the branch.
+  vector_size_t numLoaded = 0;
+  auto makeLazy = [&]() {
+    return std::make_shared<LazyVector>(
+        pool_.get(),
+        BIGINT(),
+        size,
+        std::make_unique<test::SimpleVectorLoader>([&](auto rows) {
+          numLoaded += rows.size();
+          return makeFlatVector<int64_t>(
+              rows.back() + 1, [](auto row) { return row; });
+        }));
+  };
+  auto evaluateLoading = [&](const std::string& text,
+                             const RowVectorPtr& input,
+                             bool evaluatedRowsOnly) {
+    numLoaded = 0;
+    auto exprSet = compileExpression(text, asRowType(input->type()));
+    exec::EvalCtx context(execCtx_.get(), exprSet.get(), input.get());
+    context.setLoadLazyForEvaluatedRowsOnly(evaluatedRowsOnly);
+    SelectivityVector rows(size);
+    std::vector<VectorPtr> result(1);
+    exprSet->eval(rows, context, result);
+    return result[0];
+  };
+
+  auto c0 = makeFlatVector<int64_t>(size, [](auto row) { return row % 10; });
+  auto expected = makeFlatVector<int64_t>(
+      size, [](auto row) { return row % 10 == 0 ? row + 1 : 0; });
+  const std::string caseExpr = "case when c0 = 0 then c1 + 1 else 0 end";
+  assertEqualVectors(
+      expected,
+      evaluateLoading(caseExpr, makeRowVector({c0, makeLazy()}), true));
+  EXPECT_EQ(numLoaded, size / 10);
+  assertEqualVectors(
+      expected,
+      evaluateLoading(caseExpr, makeRowVector({c0, makeLazy()}), false));
+  EXPECT_EQ(numLoaded, size);
+
+  // 'c1' is referenced by 2 inputs of COALESCE and is loaded for the rows
+  // where 'c0' is null.
+  c0 = makeFlatVector<int64_t>(
+      size, [](auto row) { return row; }, nullEvery(10));
+  expected = makeFlatVector<int64_t>(
+      size, [](auto row) { return row % 10 == 0 ? row + 1 : row; });
+  assertEqualVectors(
+      expected,
+      evaluateLoading(
+          "coalesce(c0, c1 + 1, c1 * 2)",
+          makeRowVector({c0, makeLazy()}),
+          true));
+  EXPECT_EQ(numLoaded, size / 10);
+}
+
 TEST_P(ParameterizedExprTest, lazyVectorAccessTwiceWithDifferentRows) {
   const vector_size_t size = 4;
 
@@ -2155,6 +2214,35 @@ TEST_F(ExprTest, memo) {
   VELOX_CHECK(base.unique());
 }
 
+TEST_F(ExprTest, memoMaxBytes) {
+  // Verify that results are not cached across batches when they exceed
+  // max_dictionary_memo_bytes.
+  auto base = makeArrayVector<int64_t>(
+      1'000,
+      [](auto row) { return row % 5 + 1; },
+      [](auto row, auto index) { return (row % 3) + index; });
+  auto evenIndices = makeIndices(100, [](auto row) { return 8 + row * 2; });
+
+  auto queryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kMaxDictionaryMemoBytes, "0"}}));
+  core::ExecCtx execCtx(pool_.get(), queryCtx.get());
+  auto exprSet = compileExpression("c0[1] = 1", ROW({"c0"}, {base->type()}));
+  auto expectedResult = makeFlatVector<bool>(
+      100, [](auto row) { return (8 + row * 2) % 3 == 1; });
+
+  for (auto i = 0; i < 3; ++i) {
+    auto input = makeRowVector({wrapInDictionary(evenIndices, 100, base)});
+    SelectivityVector rows(input->size());
+    std::vector<VectorPtr> results(1);
+    exec::EvalCtx context(&execCtx, exprSet.get(), input.get());
+    exprSet->eval(rows, context, results);
+    assertEqualVectors(expectedResult, results[0]);
+    ASSERT_EQ(exprSet->stats()["eq"].numProcessedRows, 100 * (i + 1));
+  }
+}
+
 // This test triggers the situation when peelEncodings() produces an empty
 // selectivity vector, which if passed to evalWithMemo() causes the latter to
 // produce null Expr::dictionaryCache_, which leads to a crash in evaluation
@@ -4316,6 +4404,35 @@ TEST_F(ExprTest, commonSubExpressionWithPeeling) {
   }
 }
 
+TEST_F(ExprTest, sharedSubexprMinCost) {
+  registerFunction<DefaultNullFunc, int64_t, int64_t, int64_t>(
+      {"default_null"});
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(100, [](auto row) { return row; })});
+  const std::vector<std::string> expressions = {
+      "default_null(c0, c0) > 10", "default_null(c0, c0)"};
+
+  // The shared subexpression is evaluated once for both expressions.
+  totalDefaultNullFunc = 0;
+  auto expected = evaluateMultiple(expressions, data);
+  ASSERT_EQ(totalDefaultNullFunc, 100);
+
+  // Nothing is as expensive as the minimum cost, so the shared subexpression
+  // is evaluated for each reference.
+  auto queryCtx = core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig(std::unordered_map<std::string, std::string>{
+          {core::QueryConfig::kMinSharedSubexprCostNanosPerRow,
+           "1000000000"}}));
+  core::ExecCtx execCtx(pool_.get(), queryCtx.get());
+  totalDefaultNullFunc = 0;
+  auto results = evaluateMultiple(expressions, data, std::nullopt, &execCtx);
+  ASSERT_EQ(totalDefaultNullFunc, 200);
+  for (auto i = 0; i < expressions.size(); ++i) {
+    assertEqualVectors(expected[i], results[i]);
+  }
+}
+
 TEST_P(ParameterizedExprTest, dictionaryOverLoadedLazy) {
   // This test verifies a corner case where peeling does not go past a loaded
   // lazy layer which caused wrong set of inputs being passed to shared
@@ -4503,6 +4620,10 @@ TEST_P(ParameterizedExprTest, extractSubfields) {
   validate("c0[1].c0c1['foo'] > 0", {"c0[1].c0c1[\"foo\"]"});
   validate("c0[1].c0c0[c1[1]] > 0", {"c0[1].c0c0", "c1[1]"});
   validate("element_at(c1, -1)", {"c1"});
+  validate("element_at(c1, 2) + c1[1]", {"c1[1]", "c1[2]"});
+  validate("element_at(c0[1].c0c0, -1) > 0", {"c0[1].c0c0[-1]"});
+  validate("element_at(c0[1].c0c1, 'foo') > 0", {"c0[1].c0c1[\"foo\"]"});
+  validate("element_at(element_at(c2, 1), 3) > 0", {"c2[1][3]"});
   validate("transform(c0, x -> x.c0c0[0] + c1[1])", {"c0", "c1[1]"});
   validate("transform(c0, c1 -> c1.c0c0[0])", {"c0"});
   validate("reduce(c1, 0, (c0, c3) -> c0 + c3, c2 -> c2)", {"c1"});
@@ -4792,6 +4913,77 @@ TEST_P(ParameterizedExprTest, evaluatesArgumentsOnNonIncreasingSelection) {
   }
 }
 
+TEST_F(ExprTest, fusedEval) {
+  queryCtx_ = velox::core::QueryCtx::create(
+      nullptr,
+      core::QueryConfig({{core::QueryConfig::kExprFusedEvalEnabled, "true"}}));
+  execCtx_ = std::make_unique<core::ExecCtx>(pool_.get(), queryCtx_.get());
+
+  constexpr vector_size_t kSize = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 17; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 5; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 7; }),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 31; }),
+      makeFlatVector<double>(kSize, [](auto row) { return row * 0.1; }),
+      makeConstant<double>(50.0, kSize),
+  });
+  auto expected = [&](auto row) {
+    return (row % 17) * (row % 5) + row % 7 > row % 31 && row * 0.1 < 50.0;
+  };
+
+  const std::string sql = "c0 * c1 + c2 > c3 AND c4 < c5";
+  auto exprSet = compileExpression(sql, asRowType(data->type()));
+  ASSERT_TRUE(exprSet->exprs()[0]->hasFusedEvaluator());
+  assertEqualVectors(
+      makeFlatVector<bool>(kSize, expected), evaluate(exprSet.get(), data));
+
+  // Subset of rows.
+  SelectivityVector rows(kSize);
+  for (auto row = 0; row < kSize; row += 3) {
+    rows.setValid(row, false);
+  }
+  rows.updateBounds();
+  auto result = evaluateMultiple({sql}, data, rows)[0];
+  rows.applyToSelected([&](auto row) {
+    ASSERT_EQ(result->asFlatVector<bool>()->valueAt(row), expected(row));
+  });
+
+  // Constants.
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return (row % 17) * 2 + 1 + row % 5; }),
+      evaluate("c0 * 2 + 1 + c1", data));
+
+  // An error on rows that AND does not evaluate the division on.
+  assertEqualVectors(
+      makeFlatVector<bool>(
+          kSize,
+          [](auto row) {
+            return row % 5 != 0 && (row % 17) / (row % 5) > 1 &&
+                row % 17 + row % 5 > 3;
+          }),
+      evaluate("c1 <> 0 AND c0 / c1 > 1 AND c0 + c1 > 3", data));
+
+  // Errors are reported as without fusion.
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "c0 * c1 > 0",
+          makeRowVector(
+              {makeFlatVector<int64_t>({1, 1LL << 62}),
+               makeFlatVector<int64_t>({1, 1LL << 62})})),
+      "overflow");
+
+  // Inputs with nulls are evaluated without fusion.
+  auto withNulls = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, std::nullopt, 3}),
+      makeFlatVector<int64_t>({1, 2, 3}),
+  });
+  assertEqualVectors(
+      makeNullableFlatVector<bool>({true, std::nullopt, true}),
+      evaluate("c0 * c1 + c1 > c0", withNulls));
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     ExprTest,
     ParameterizedExprTest,
@@ -1542,4 +1542,63 @@ TEST_F(SimpleFunctionTest, noThrow) {
       "Input must not be 6");
 }
 
+template <typename TExec>
+struct DenseAddFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  void call(int64_t& out, const int64_t& a, const int64_t& b) {
+    out = a + b;
+  }
+};
+
+template <typename TExec>
+struct HalfOfEvenFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(TExec);
+
+  bool call(int64_t& out, const int64_t& in) {
+    out = in / 2;
+    return in % 2 == 0;
+  }
+};
+
+// Verifies that errors and nulls are reported for the right rows when all rows
+// of flat and constant inputs are evaluated in one dense loop first.
+TEST_F(SimpleFunctionTest, denseIteration) {
+  registerFunction<NoThrowFunction, int64_t, int64_t>({"no_throw"});
+  registerFunction<HalfOfEvenFunction, int64_t, int64_t>({"half_of_even"});
+  registerFunction<DenseAddFunction, int64_t, int64_t, int64_t>(
+      {"dense_add"});
+
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 6 + 12; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+
+  auto result = evaluate("no_throw(c0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row + 2; }),
+      result);
+
+  result = evaluate("try(no_throw(dense_add(c0, c1)))", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          1'000,
+          [](auto row) { return (row * 7 + 12) / 6; },
+          [](auto row) { return row % 6 != 0; }),
+      result);
+
+  result = evaluate("dense_add(c1, cast(5 as bigint))", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row + 5; }),
+      result);
+
+  result = evaluate("half_of_even(dense_add(c0, c1))", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          1'000,
+          [](auto row) { return (row * 7 + 12) / 2; },
+          [](auto row) { return row % 2 == 1; }),
+      result);
+}
+
 } // namespace
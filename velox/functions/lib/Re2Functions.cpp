@@ -14,15 +14,16 @@
  * limitations under the License.
  */
 #include "velox/functions/lib/Re2Functions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/functions/lib/string/StringImpl.h"
 
+#include <folly/Synchronized.h>
 #include <re2/re2.h>
+#include <re2/set.h>
 
 namespace facebook::velox::functions {
 namespace {
 
-static const int kMaxCompiledRegexes = 20;
-
 void checkForBadPattern(const RE2& re) {
   if (UNLIKELY(!re.ok())) {
     VELOX_USER_FAIL("invalid regular expression:{}", re.error());
@@ -34,13 +35,64 @@ re2::StringPiece toStringPiece(const T& s) {
   return re2::StringPiece(s.data(), s.size());
 }
 
-// A cache of compiled regular expressions (RE2 instances). Allows up to
-// 'kMaxCompiledRegexes' different expressions.
+// A process-wide cache of compiled regular expressions shared by the
+// functions of all drivers and queries, so that a pattern seen by many
+// drivers or batches is compiled once. Matching with an RE2 instance is
+// thread-safe. Holds up to 'kMaxSize' expressions and drops an arbitrary one
+// when full. Functions keep the expressions they use alive.
+class SharedReCache {
+ public:
+  static SharedReCache& instance() {
+    static SharedReCache cache;
+    return cache;
+  }
+
+  // Returns 'regex' compiled with RE2::Quiet and 'dotNl' as the dot_nl
+  // option. Throws if 'regex' is invalid.
+  std::shared_ptr<RE2> findOrCompile(std::string_view regex, bool dotNl) {
+    std::string key;
+    key.reserve(regex.size() + 1);
+    key.push_back(dotNl ? '1' : '0');
+    key.append(regex);
+    {
+      auto cache = cache_.rlock();
+      auto it = cache->find(key);
+      if (it != cache->end()) {
+        return it->second;
+      }
+    }
+
+    RE2::Options options{RE2::Quiet};
+    options.set_dot_nl(dotNl);
+    auto re = std::make_shared<RE2>(toStringPiece(regex), options);
+    checkForBadPattern(*re);
+
+    auto cache = cache_.wlock();
+    if (cache->size() >= kMaxSize) {
+      cache->erase(cache->begin());
+    }
+    return cache->emplace(std::move(key), std::move(re)).first->second;
+  }
+
+ private:
+  static constexpr size_t kMaxSize = 1'000;
+
+  folly::Synchronized<folly::F14FastMap<std::string, std::shared_ptr<RE2>>>
+      cache_;
+};
+
+// The compiled regular expressions (RE2 instances) used by one function
+// instance. Allows up to 'maxCompiledRegexes' different expressions, see
+// QueryConfig::kExprMaxCompiledRegexes.
 //
 // Compiling regular expressions is expensive. It can take up to 200 times
-// more CPU time to compile a regex vs. evaluate it.
+// more CPU time to compile a regex vs. evaluate it. The expressions come from
+// SharedReCache, so each one is compiled once per process.
 class ReCache {
  public:
+  explicit ReCache(uint32_t maxCompiledRegexes)
+      : maxCompiledRegexes_(maxCompiledRegexes) {}
+
   RE2* findOrCompile(const StringView& pattern) {
     const std::string key = pattern;
 
@@ -50,10 +102,9 @@ class ReCache {
     }
 
     VELOX_USER_CHECK_LT(
-        cache_.size(), kMaxCompiledRegexes, "Max number of regex reached");
+        cache_.size(), maxCompiledRegexes_, "Max number of regex reached");
 
-    auto re = std::make_unique<RE2>(toStringPiece(pattern), RE2::Quiet);
-    checkForBadPattern(*re);
+    auto re = SharedReCache::instance().findOrCompile(key, false);
 
     auto [it, inserted] = cache_.emplace(key, std::move(re));
     VELOX_CHECK(inserted);
@@ -62,7 +113,8 @@ class ReCache {
   }
 
  private:
-  folly::F14FastMap<std::string, std::unique_ptr<RE2>> cache_;
+  const uint32_t maxCompiledRegexes_;
+  folly::F14FastMap<std::string, std::shared_ptr<RE2>> cache_;
 };
 
 std::string printTypesCsv(
@@ -200,6 +252,38 @@ std::string likePatternToRe2(
   return regex;
 }
 
+// Returns the longest run of literal characters in LIKE 'pattern'. Every
+// string that matches 'pattern' contains this run.
+std::string longestLikeLiteral(
+    StringView pattern,
+    std::optional<char> escapeChar) {
+  std::string longest;
+  std::string current;
+  bool escaped = false;
+  for (const char c : pattern) {
+    if (!escaped && c == escapeChar) {
+      escaped = true;
+      continue;
+    }
+    if (!escaped && (c == '%' || c == '_')) {
+      if (current.size() > longest.size()) {
+        longest.swap(current);
+      }
+      current.clear();
+    } else {
+      current.push_back(c);
+    }
+    escaped = false;
+  }
+  return current.size() > longest.size() ? current : longest;
+}
+
+// Returns true if 'input' contains 'literal'.
+bool containsLiteral(StringView input, const std::string& literal) {
+  return simd::findSubstring(
+             input.data(), input.size(), literal.data(), literal.size()) >= 0;
+}
+
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public exec::VectorFunction {
  public:
@@ -234,6 +318,8 @@ class Re2MatchConstantPattern final : public exec::VectorFunction {
 template <bool (*Fn)(StringView, const RE2&)>
 class Re2Match final : public exec::VectorFunction {
  public:
+  explicit Re2Match(uint32_t maxCompiledRegexes) : cache_(maxCompiledRegexes) {}
+
   void apply(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -354,8 +440,9 @@ class Re2SearchAndExtractConstantPattern final : public exec::VectorFunction {
 template <typename T>
 class Re2SearchAndExtract final : public exec::VectorFunction {
  public:
-  explicit Re2SearchAndExtract(bool emptyNoMatch)
-      : emptyNoMatch_(emptyNoMatch) {}
+  Re2SearchAndExtract(bool emptyNoMatch, uint32_t maxCompiledRegexes)
+      : emptyNoMatch_(emptyNoMatch), cache_(maxCompiledRegexes) {}
+
   void apply(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -799,7 +886,8 @@ class OptimizedLike final : public exec::VectorFunction {
 // fast path that avoids compiling the regular expression.
 class LikeWithRe2 final : public exec::VectorFunction {
  public:
-  LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
+  LikeWithRe2(StringView pattern, std::optional<char> escapeChar)
+      : literal_(longestLikeLiteral(pattern, escapeChar)) {
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
     re_.emplace(
@@ -837,15 +925,15 @@ class LikeWithRe2 final : public exec::VectorFunction {
     if (toSearch->isIdentityMapping()) {
       auto rawStrings = toSearch->data<StringView>();
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-        result.set(i, re2FullMatch(rawStrings[i], *re_));
+        result.set(i, match(rawStrings[i]));
       });
       return;
     }
 
     if (toSearch->isConstantMapping()) {
-      bool match = re2FullMatch(toSearch->valueAt<StringView>(0), *re_);
+      bool matchResult = match(toSearch->valueAt<StringView>(0));
       context.applyToSelectedNoThrow(
-          rows, [&](vector_size_t i) { result.set(i, match); });
+          rows, [&](vector_size_t i) { result.set(i, matchResult); });
       return;
     }
 
@@ -856,16 +944,28 @@ class LikeWithRe2 final : public exec::VectorFunction {
   }
 
  private:
+  // Runs the regular expression only on strings that contain 'literal_'.
+  bool match(StringView input) const {
+    return (literal_.empty() || containsLiteral(input, literal_)) &&
+        re2FullMatch(input, *re_);
+  }
+
+  // The longest literal in the pattern. Empty if the pattern has none.
+  const std::string literal_;
   std::optional<RE2> re_;
   bool validPattern_;
 };
 
 // This function is constructed when pattern or escape are not constants.
-// It allows up to kMaxCompiledRegexes different regular expressions to be
-// compiled throughout the query lifetime per expression and thread of
-// execution, note that optimized regular expressions that are not compiled are
-// not counted.
+// It allows up to 'maxCompiledRegexes' different regular expressions to be
+// used throughout the query lifetime per expression and thread of execution,
+// note that optimized regular expressions that are not compiled are not
+// counted. The expressions are compiled once per process in SharedReCache.
 class LikeGeneric final : public exec::VectorFunction {
+ public:
+  explicit LikeGeneric(uint32_t maxCompiledRegexes)
+      : maxCompiledRegexes_(maxCompiledRegexes) {}
+
   void apply(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -983,7 +1083,7 @@ class LikeGeneric final : public exec::VectorFunction {
 
     VELOX_USER_CHECK_LT(
         compiledRegularExpressions_.size(),
-        kMaxCompiledRegexes,
+        maxCompiledRegexes_,
         "Max number of regex reached");
 
     bool validEscapeUsage;
@@ -992,10 +1092,7 @@ class LikeGeneric final : public exec::VectorFunction {
         validEscapeUsage,
         "Escape character must be followed by '%', '_' or the escape character itself");
 
-    RE2::Options opt{RE2::Quiet};
-    opt.set_dot_nl(true);
-    auto re = std::make_unique<RE2>(toStringPiece(regex), opt);
-    checkForBadPattern(*re);
+    auto re = SharedReCache::instance().findOrCompile(regex, true);
 
     auto [it, inserted] =
         compiledRegularExpressions_.emplace(key, std::move(re));
@@ -1004,12 +1101,159 @@ class LikeGeneric final : public exec::VectorFunction {
     return it->second.get();
   }
 
+  const uint32_t maxCompiledRegexes_;
+
   mutable folly::F14FastMap<
       std::pair<std::string, std::optional<char>>,
-      std::unique_ptr<RE2>>
+      std::shared_ptr<RE2>>
       compiledRegularExpressions_;
 };
 
+template <bool isAscii>
+bool matchOptimizedLike(
+    const StringView& input,
+    const PatternMetadata& patternMetadata) {
+  switch (patternMetadata.patternKind()) {
+    case PatternKind::kExactlyN:
+      return OptimizedLike<PatternKind::kExactlyN>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kAtLeastN:
+      return OptimizedLike<PatternKind::kAtLeastN>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kFixed:
+      return OptimizedLike<PatternKind::kFixed>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kRelaxedFixed:
+      return OptimizedLike<PatternKind::kRelaxedFixed>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kPrefix:
+      return OptimizedLike<PatternKind::kPrefix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kRelaxedPrefix:
+      return OptimizedLike<PatternKind::kRelaxedPrefix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kSuffix:
+      return OptimizedLike<PatternKind::kSuffix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kRelaxedSuffix:
+      return OptimizedLike<PatternKind::kRelaxedSuffix>::match<isAscii>(
+          input, patternMetadata);
+    case PatternKind::kSubstring:
+      return OptimizedLike<PatternKind::kSubstring>::match<isAscii>(
+          input, patternMetadata);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Evaluates 'input LIKE pattern1 OR input LIKE pattern2 ...' for constant
+// patterns without escape character in one pass over the input. Patterns with
+// a fast path are checked first. The other patterns are compiled into one
+// RE2::Set, which runs only on strings that contain the longest literal of at
+// least one of these patterns.
+class LikeAny final : public exec::VectorFunction {
+ public:
+  explicit LikeAny(const std::vector<StringView>& patterns) {
+    std::vector<std::string> regexes;
+    for (const auto& pattern : patterns) {
+      auto patternMetadata =
+          determinePatternKind(std::string_view(pattern), std::nullopt);
+      switch (patternMetadata.patternKind()) {
+        case PatternKind::kGeneric: {
+          bool validPattern;
+          regexes.push_back(
+              likePatternToRe2(pattern, std::nullopt, validPattern));
+          literals_.push_back(longestLikeLiteral(pattern, std::nullopt));
+          alwaysMatchSet_ |= literals_.back().empty();
+          break;
+        }
+        case PatternKind::kExactlyN:
+        case PatternKind::kAtLeastN:
+        case PatternKind::kRelaxedFixed:
+        case PatternKind::kRelaxedPrefix:
+        case PatternKind::kRelaxedSuffix:
+          utf8Sensitive_ = true;
+          [[fallthrough]];
+        default:
+          optimized_.push_back(std::move(patternMetadata));
+      }
+    }
+    if (regexes.empty()) {
+      return;
+    }
+    RE2::Options opt{RE2::Quiet};
+    opt.set_dot_nl(true);
+    set_ = std::make_unique<RE2::Set>(opt, RE2::ANCHOR_BOTH);
+    for (const auto& regex : regexes) {
+      std::string error;
+      VELOX_USER_CHECK_GE(
+          set_->Add(toStringPiece(regex), &error),
+          0,
+          "invalid regular expression:{}",
+          error);
+    }
+    VELOX_CHECK(set_->Compile(), "Failed to compile LIKE patterns");
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    const bool isAscii = !utf8Sensitive_ || isAsciiArg(rows, args[0]);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto toSearch = decodedArgs.at(0);
+    if (isAscii) {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+        result.set(i, match<true>(toSearch->valueAt<StringView>(i)));
+      });
+    } else {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+        result.set(i, match<false>(toSearch->valueAt<StringView>(i)));
+      });
+    }
+  }
+
+ private:
+  template <bool isAscii>
+  bool match(const StringView& input) const {
+    for (const auto& patternMetadata : optimized_) {
+      if (matchOptimizedLike<isAscii>(input, patternMetadata)) {
+        return true;
+      }
+    }
+    if (set_ == nullptr) {
+      return false;
+    }
+    if (!alwaysMatchSet_ &&
+        std::none_of(
+            literals_.begin(), literals_.end(), [&](const auto& literal) {
+              return containsLiteral(input, literal);
+            })) {
+      return false;
+    }
+    return set_->Match(toStringPiece(input), nullptr);
+  }
+
+  // Patterns matched without regular expression.
+  std::vector<PatternMetadata> optimized_;
+
+  // True if one of 'optimized_' depends on the input being ASCII.
+  bool utf8Sensitive_{false};
+
+  // The other patterns.
+  std::unique_ptr<RE2::Set> set_;
+
+  // The longest literal of each pattern in 'set_'.
+  std::vector<std::string> literals_;
+
+  // True if a pattern in 'set_' has no literal, so that 'set_' runs on every
+  // string.
+  bool alwaysMatchSet_{false};
+};
+
 void re2ExtractAll(
     exec::VectorWriter<Array<Varchar>>& resultWriter,
     const RE2& re,
@@ -1120,6 +1364,9 @@ class Re2ExtractAllConstantPattern final : public exec::VectorFunction {
 template <typename T>
 class Re2ExtractAll final : public exec::VectorFunction {
  public:
+  explicit Re2ExtractAll(uint32_t maxCompiledRegexes)
+      : cache_(maxCompiledRegexes) {}
+
   void apply(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -1179,7 +1426,8 @@ class Re2ExtractAll final : public exec::VectorFunction {
 template <bool (*Fn)(StringView, const RE2&)>
 std::shared_ptr<exec::VectorFunction> makeRe2MatchImpl(
     const std::string& name,
-    const std::vector<exec::VectorFunctionArg>& inputArgs) {
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config) {
   if (inputArgs.size() != 2 || !inputArgs[0].type->isVarchar() ||
       !inputArgs[1].type->isVarchar()) {
     VELOX_UNSUPPORTED(
@@ -1195,7 +1443,7 @@ std::shared_ptr<exec::VectorFunction> makeRe2MatchImpl(
         constantPattern->as<ConstantVector<StringView>>()->valueAt(0));
   }
 
-  return std::make_shared<Re2Match<Fn>>();
+  return std::make_shared<Re2Match<Fn>>(config.exprMaxCompiledRegexes());
 }
 
 } // namespace
@@ -1203,8 +1451,8 @@ std::shared_ptr<exec::VectorFunction> makeRe2MatchImpl(
 std::shared_ptr<exec::VectorFunction> makeRe2Match(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
-    const core::QueryConfig& /*config*/) {
-  return makeRe2MatchImpl<re2FullMatch>(name, inputArgs);
+    const core::QueryConfig& config) {
+  return makeRe2MatchImpl<re2FullMatch>(name, inputArgs, config);
 }
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2MatchSignatures() {
@@ -1219,8 +1467,8 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2MatchSignatures() {
 std::shared_ptr<exec::VectorFunction> makeRe2Search(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
-    const core::QueryConfig& /*config*/) {
-  return makeRe2MatchImpl<re2PartialMatch>(name, inputArgs);
+    const core::QueryConfig& config) {
+  return makeRe2MatchImpl<re2PartialMatch>(name, inputArgs, config);
 }
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures() {
@@ -1235,7 +1483,7 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures() {
 std::shared_ptr<exec::VectorFunction> makeRe2Extract(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
-    const core::QueryConfig& /*config*/,
+    const core::QueryConfig& config,
     const bool emptyNoMatch) {
   auto numArgs = inputArgs.size();
   VELOX_USER_CHECK(
@@ -1286,9 +1534,11 @@ std::shared_ptr<exec::VectorFunction> makeRe2Extract(
 
   switch (groupIdTypeKind) {
     case TypeKind::INTEGER:
-      return std::make_shared<Re2SearchAndExtract<int32_t>>(emptyNoMatch);
+      return std::make_shared<Re2SearchAndExtract<int32_t>>(
+          emptyNoMatch, config.exprMaxCompiledRegexes());
     case TypeKind::BIGINT:
-      return std::make_shared<Re2SearchAndExtract<int64_t>>(emptyNoMatch);
+      return std::make_shared<Re2SearchAndExtract<int64_t>>(
+          emptyNoMatch, config.exprMaxCompiledRegexes());
     default:
       VELOX_UNREACHABLE();
   }
@@ -1742,14 +1992,14 @@ PatternMetadata determinePatternKind(
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
-    const core::QueryConfig& /*config*/) {
+    const core::QueryConfig& config) {
   auto numArgs = inputArgs.size();
 
   std::optional<char> escapeChar;
   if (numArgs == 3) {
     BaseVector* escape = inputArgs[2].constantValue.get();
     if (!escape) {
-      return std::make_shared<LikeGeneric>();
+      return std::make_shared<LikeGeneric>(config.exprMaxCompiledRegexes());
     }
 
     auto constantEscape = escape->as<ConstantVector<StringView>>();
@@ -1775,7 +2025,7 @@ std::shared_ptr<exec::VectorFunction> makeLike(
 
   BaseVector* constantPattern = inputArgs[1].constantValue.get();
   if (!constantPattern) {
-    return std::make_shared<LikeGeneric>();
+    return std::make_shared<LikeGeneric>(config.exprMaxCompiledRegexes());
   }
 
   if (constantPattern->isNullAt(0)) {
@@ -1825,6 +2075,148 @@ std::shared_ptr<exec::VectorFunction> makeLike(
   }
 }
 
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  std::vector<StringView> patterns;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    BaseVector* constantPattern = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        constantPattern != nullptr && !constantPattern->isNullAt(0),
+        "{} requires constant non-null patterns",
+        name);
+    patterns.push_back(
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0));
+  }
+  try {
+    return std::make_shared<LikeAny>(patterns);
+  } catch (...) {
+    return std::make_shared<exec::AlwaysFailingVectorFunction>(
+        std::current_exception());
+  }
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures() {
+  // varchar, varchar... -> boolean
+  return {
+      exec::FunctionSignatureBuilder()
+          .returnType("boolean")
+          .argumentType("varchar")
+          .constantArgumentType("varchar")
+          .variableArity()
+          .build(),
+  };
+}
+
+namespace {
+
+// Appends the inputs of nested 'or' calls in 'expr' to 'disjuncts'.
+void flattenOr(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& disjuncts) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenOr(input, disjuncts);
+    }
+  } else {
+    disjuncts.push_back(expr);
+  }
+}
+
+// Returns the column of 'expr' if 'expr' is 'like(column, pattern)' with a
+// constant non-null pattern and no escape character, nullptr otherwise.
+const core::FieldAccessTypedExpr* likeColumn(
+    const core::TypedExprPtr& expr,
+    const std::string& likeName) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != likeName ||
+      call->inputs().size() != 2) {
+    return nullptr;
+  }
+  auto* pattern =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  if (pattern == nullptr || !pattern->type()->isVarchar() ||
+      (pattern->hasValueVector() ? pattern->valueVector()->isNullAt(0)
+                                 : pattern->value().isNull())) {
+    return nullptr;
+  }
+  return dynamic_cast<const core::FieldAccessTypedExpr*>(
+      call->inputs()[0].get());
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteLikeDisjunction(
+    const std::string& likeName,
+    const std::string& likeAnyName,
+    const core::TypedExprPtr& expr) {
+  auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+  std::vector<core::TypedExprPtr> disjuncts;
+  flattenOr(expr, disjuncts);
+
+  // The LIKE calls on each column. The group of a column takes the place of
+  // its first LIKE call. 'groupOfDisjunct' is the group of the first LIKE call
+  // on a column, kNoGroup for other disjuncts and kInGroup for the other LIKE
+  // calls.
+  constexpr int32_t kNoGroup = -1;
+  constexpr int32_t kInGroup = -2;
+  std::vector<std::vector<core::TypedExprPtr>> groups;
+  std::vector<int32_t> groupOfDisjunct(disjuncts.size(), kNoGroup);
+  bool rewrite = false;
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    auto* column = likeColumn(disjuncts[i], likeName);
+    if (column == nullptr) {
+      continue;
+    }
+    auto it = std::find_if(groups.begin(), groups.end(), [&](auto& group) {
+      return *group[0]->inputs()[0] == *column;
+    });
+    if (it == groups.end()) {
+      groupOfDisjunct[i] = groups.size();
+      groups.push_back({disjuncts[i]});
+    } else {
+      groupOfDisjunct[i] = kInGroup;
+      it->push_back(disjuncts[i]);
+      rewrite = true;
+    }
+  }
+  if (!rewrite) {
+    return nullptr;
+  }
+
+  std::vector<core::TypedExprPtr> newDisjuncts;
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    if (groupOfDisjunct[i] == kNoGroup) {
+      newDisjuncts.push_back(disjuncts[i]);
+      continue;
+    }
+    if (groupOfDisjunct[i] == kInGroup) {
+      continue;
+    }
+    const auto& group = groups[groupOfDisjunct[i]];
+    if (group.size() == 1) {
+      newDisjuncts.push_back(group[0]);
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{group[0]->inputs()[0]};
+    for (const auto& like : group) {
+      inputs.push_back(like->inputs()[1]);
+    }
+    newDisjuncts.push_back(std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(), std::move(inputs), likeAnyName));
+  }
+  if (newDisjuncts.size() == 1) {
+    return newDisjuncts[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(newDisjuncts), "or");
+}
+
 std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures() {
   // varchar, varchar -> boolean
   // varchar, varchar, varchar -> boolean
@@ -1846,7 +2238,7 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures() {
 std::shared_ptr<exec::VectorFunction> makeRe2ExtractAll(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
-    const core::QueryConfig& /*config*/) {
+    const core::QueryConfig& config) {
   auto numArgs = inputArgs.size();
   VELOX_USER_CHECK(
       numArgs == 2 || numArgs == 3,
@@ -1893,9 +2285,11 @@ std::shared_ptr<exec::VectorFunction> makeRe2ExtractAll(
 
   switch (groupIdTypeKind) {
     case TypeKind::INTEGER:
-      return std::make_shared<Re2ExtractAll<int32_t>>();
+      return std::make_shared<Re2ExtractAll<int32_t>>(
+          config.exprMaxCompiledRegexes());
     case TypeKind::BIGINT:
-      return std::make_shared<Re2ExtractAll<int64_t>>();
+      return std::make_shared<Re2ExtractAll<int64_t>>(
+          config.exprMaxCompiledRegexes());
     default:
       VELOX_UNREACHABLE();
   }
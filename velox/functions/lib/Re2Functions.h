@@ -20,6 +20,7 @@
 
 #include <re2/re2.h>
 
+#include "velox/core/Expressions.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/Udf.h"
 #include "velox/vector/BaseVector.h"
@@ -213,6 +214,33 @@ std::shared_ptr<exec::VectorFunction> makeLike(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> likeSignatures();
 
+/// like_any(string, pattern1, pattern2, ...) → bool
+///
+/// Returns whether string matches any of the constant LIKE patterns. Same as
+/// 'string LIKE pattern1 OR string LIKE pattern2 ...', but makes a single pass
+/// over the input. Patterns that need a regular expression are matched
+/// together by one RE2::Set, which runs only if the input contains a literal
+/// required by one of these patterns.
+std::shared_ptr<exec::VectorFunction> makeLikeAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> likeAnySignatures();
+
+/// Rewrites an 'or' of two or more 'likeName(column, pattern)' calls on the
+/// same column with constant patterns into 'likeAnyName(column, pattern1,
+/// pattern2, ...)'. Other disjuncts are kept. For example, rewrites
+///     a LIKE '%x%y' OR b > 0 OR a LIKE 'z%'
+/// into
+///     likeAnyName(a, '%x%y', 'z%') OR b > 0
+///
+/// Returns new expression or nullptr if rewrite is not possible.
+core::TypedExprPtr rewriteLikeDisjunction(
+    const std::string& likeName,
+    const std::string& likeAnyName,
+    const core::TypedExprPtr& expr);
+
 /// re2ExtractAll(string, pattern, group_id) → array<string>
 /// re2ExtractAll(string, pattern) → array<string>
 ///
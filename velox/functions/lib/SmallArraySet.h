@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::functions {
+
+/// Set of at most kMaxSize scalar values stored in an inline array. Lookups
+/// compare the value with all the values in the set without branching, which
+/// the compiler vectorizes for fixed-width types. For the few values of a short
+/// array this is faster than hashing and does not allocate. Has the subset of
+/// the folly::F14FastSet API used by the array set functions and the same
+/// semantics as util::floating_point::HashSetNaNAware: NaNs are equal to each
+/// other.
+template <typename T>
+class SmallArraySet {
+ public:
+  /// Arrays up to this size are processed with a SmallArraySet.
+  static constexpr int32_t kMaxSize = 16;
+
+  size_t count(const T& value) const {
+    bool found = false;
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        for (auto i = 0; i < size_; ++i) {
+          found |= std::isnan(values_[i]);
+        }
+        return found;
+      }
+    }
+    for (auto i = 0; i < size_; ++i) {
+      found |= values_[i] == value;
+    }
+    return found;
+  }
+
+  /// Adds 'value' if not in the set. Returns a pointer to the added value and
+  /// true if 'value' was added, nullptr and false otherwise.
+  std::pair<const T*, bool> insert(const T& value) {
+    if (count(value)) {
+      return {nullptr, false};
+    }
+    VELOX_DCHECK_LT(size_, kMaxSize);
+    values_[size_] = value;
+    return {&values_[size_++], true};
+  }
+
+  void clear() {
+    size_ = 0;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  std::array<T, kMaxSize> values_;
+  int32_t size_{0};
+};
+
+} // namespace facebook::velox::functions
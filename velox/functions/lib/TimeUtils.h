@@ -47,9 +47,47 @@ getSeconds(Timestamp timestamp, const date::time_zone* timeZone) {
   }
 }
 
+/// Converts timestamps to local time in a time zone. Caches the offset of the
+/// period between two transitions of the time zone that contains the last
+/// converted timestamp. The timestamps of a batch are usually close together,
+/// so most conversions skip the lookup in the time zone database.
+class TimeZoneOffsetCache {
+ public:
+  /// Returns the seconds of 'timestamp' in 'timeZone', like
+  /// getSeconds(timestamp, &timeZone).
+  FOLLY_ALWAYS_INLINE int64_t
+  toLocalSeconds(Timestamp timestamp, const date::time_zone& timeZone) {
+    const auto seconds = timestamp.getSeconds();
+    if (&timeZone == timeZone_ && seconds >= begin_ && seconds < end_) {
+      return seconds + offset_;
+    }
+    return lookup(timestamp, timeZone);
+  }
+
+ private:
+  int64_t lookup(Timestamp timestamp, const date::time_zone& timeZone) {
+    const auto seconds = timestamp.getSeconds();
+    timestamp.toTimezone(timeZone);
+    const auto info = timeZone.get_info(
+        date::sys_seconds(std::chrono::seconds(seconds)));
+    timeZone_ = &timeZone;
+    begin_ = info.begin.time_since_epoch().count();
+    end_ = info.end.time_since_epoch().count();
+    offset_ = timestamp.getSeconds() - seconds;
+    return timestamp.getSeconds();
+  }
+
+  const date::time_zone* timeZone_{nullptr};
+  // Period of 'timeZone_' in seconds since epoch in which the offset from UTC
+  // is 'offset_' seconds.
+  int64_t begin_{0};
+  int64_t end_{0};
+  int64_t offset_{0};
+};
+
+// Returns the date and time of 'seconds' since epoch.
 FOLLY_ALWAYS_INLINE
-std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
-  int64_t seconds = getSeconds(timestamp, timeZone);
+std::tm secondsToDateTime(int64_t seconds) {
   std::tm dateTime;
   VELOX_USER_CHECK(
       Timestamp::epochToUtc(seconds, dateTime),
@@ -58,6 +96,11 @@ std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
   return dateTime;
 }
 
+FOLLY_ALWAYS_INLINE
+std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
+  return secondsToDateTime(getSeconds(timestamp, timeZone));
+}
+
 // days is the number of days since Epoch.
 FOLLY_ALWAYS_INLINE
 std::tm getDateTime(int32_t days) {
@@ -96,6 +139,7 @@ template <typename T>
 struct InitSessionTimezone {
   VELOX_DEFINE_FUNCTION_TYPES(T);
   const date::time_zone* timeZone_{nullptr};
+  TimeZoneOffsetCache offsetCache_;
 
   FOLLY_ALWAYS_INLINE void initialize(
       const std::vector<TypePtr>& /*inputTypes*/,
@@ -103,5 +147,15 @@ struct InitSessionTimezone {
       const arg_type<Timestamp>* /*timestamp*/) {
     timeZone_ = getTimeZoneFromConfig(config);
   }
+
+  /// Returns the date and time of 'timestamp' in the session time zone, like
+  /// getDateTime(timestamp, timeZone_).
+  FOLLY_ALWAYS_INLINE std::tm getDateTime(Timestamp timestamp) {
+    if (timeZone_ == nullptr) {
+      return secondsToDateTime(timestamp.getSeconds());
+    }
+    return secondsToDateTime(
+        offsetCache_.toLocalSeconds(timestamp, *timeZone_));
+  }
 };
 } // namespace facebook::velox::functions
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <xsimd/xsimd.hpp>
+
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationHook.h"
 #include "velox/vector/DecodedVector.h"
@@ -180,6 +182,14 @@ class SimpleNumericAggregate : public exec::Aggregate {
       });
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
+      if (rows.isAllSelected() && rows.begin() < rows.end()) {
+        // Reduce the range in a local and update the group once.
+        for (auto i = rows.begin(); i < rows.end(); ++i) {
+          updateSingleValue(initialValue, TData(data[i]));
+        }
+        updateNonNullValue<true, TData>(group, initialValue, updateSingleValue);
+        return;
+      }
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue<true, TData>(
             group, TData(data[i]), updateSingleValue);
@@ -192,6 +202,69 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Returns the values of 'arg' if 'arg' is flat without nulls and 'rows' is a
+  // non-empty contiguous range. Returns nullptr otherwise. Used by the single
+  // group fast paths which reduce the range with SIMD before updating the
+  // group.
+  template <typename TValue>
+  static const TValue* flatNoNullsRange(
+      const SelectivityVector& rows,
+      const VectorPtr& arg) {
+    if constexpr (std::is_same_v<TValue, bool>) {
+      return nullptr;
+    } else {
+      if (!rows.isAllSelected() || rows.begin() >= rows.end() ||
+          !arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return nullptr;
+      }
+      return arg->asUnchecked<FlatVector<TValue>>()->rawValues();
+    }
+  }
+
+  // Returns the sum of 'values' in [begin, end). Reassociates the additions
+  // across the SIMD lanes.
+  template <typename T>
+  static T simdSum(const T* values, vector_size_t begin, vector_size_t end) {
+    using Batch = xsimd::batch<T>;
+    Batch sums(T(0));
+    auto i = begin;
+    for (; i + Batch::size <= end; i += Batch::size) {
+      sums += Batch::load_unaligned(values + i);
+    }
+    T sum = xsimd::reduce_add(sums);
+    for (; i < end; ++i) {
+      sum += values[i];
+    }
+    return sum;
+  }
+
+  // Returns the min or max of 'values' in [begin, end). For integer types
+  // only, floating point types need NaN aware comparisons.
+  template <typename T, bool isMin>
+  static T simdMinMax(const T* values, vector_size_t begin, vector_size_t end) {
+    static_assert(std::is_integral_v<T> && sizeof(T) <= sizeof(int64_t));
+    using Batch = xsimd::batch<T>;
+    auto i = begin;
+    T result = values[i];
+    if (i + Batch::size <= end) {
+      auto batch = Batch::load_unaligned(values + i);
+      for (i += Batch::size; i + Batch::size <= end; i += Batch::size) {
+        const auto next = Batch::load_unaligned(values + i);
+        batch = isMin ? xsimd::min(batch, next) : xsimd::max(batch, next);
+      }
+      alignas(xsimd::default_arch::alignment()) T lanes[Batch::size];
+      batch.store_aligned(lanes);
+      for (auto lane : lanes) {
+        result = isMin ? std::min(result, lane) : std::max(result, lane);
+      }
+    }
+    for (; i < end; ++i) {
+      result =
+          isMin ? std::min(result, values[i]) : std::max(result, values[i]);
+    }
+    return result;
+  }
+
   template <typename THook>
   void
   pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
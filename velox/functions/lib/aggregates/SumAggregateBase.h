@@ -85,6 +85,9 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (addSingleGroupFlatRange<TInput>(group, rows, args[0])) {
+      return;
+    }
     BaseAggregate::template updateOneGroup<TAccumulator>(
         group,
         rows,
@@ -100,6 +103,9 @@ class SumAggregateBase
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (addSingleGroupFlatRange<TAccumulator>(group, rows, args[0])) {
+      return;
+    }
     BaseAggregate::template updateOneGroup<TAccumulator, TAccumulator>(
         group,
         rows,
@@ -150,6 +156,44 @@ class SumAggregateBase
   }
 
  private:
+  // Fast path for a contiguous range of flat values without nulls. Sums
+  // doubles with SIMD and integers narrower than a bigint accumulator without
+  // overflow checks, which is safe as a vector has less than 2^31 rows. The
+  // group is then updated once. Returns false if the fast path does not apply.
+  template <typename TValue>
+  bool addSingleGroupFlatRange(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg) {
+    constexpr bool kSimdSum =
+        std::is_same_v<TValue, double> && std::is_same_v<TAccumulator, double>;
+    constexpr bool kWideningSum = std::is_integral_v<TValue> &&
+        !std::is_same_v<TValue, bool> && sizeof(TValue) < sizeof(int64_t) &&
+        std::is_same_v<TAccumulator, int64_t>;
+    if constexpr (!kSimdSum && !kWideningSum) {
+      return false;
+    } else {
+      const auto* values =
+          BaseAggregate::template flatNoNullsRange<TValue>(rows, arg);
+      if (values == nullptr) {
+        return false;
+      }
+      TAccumulator sum;
+      if constexpr (kSimdSum) {
+        sum = BaseAggregate::simdSum(values, rows.begin(), rows.end());
+      } else {
+        sum = 0;
+        for (auto i = rows.begin(); i < rows.end(); ++i) {
+          sum += values[i];
+        }
+      }
+      exec::Aggregate::clearNull(group);
+      updateSingleValue<TAccumulator>(
+          *exec::Aggregate::value<TAccumulator>(group), sum);
+      return true;
+    }
+  }
+
   /// Update functions that check for overflows for integer types.
   /// For floating points, an overflow results in +/- infinity which is a
   /// valid output.
@@ -61,6 +61,10 @@ void ValueList::appendNonNull(
     vector_size_t index,
     HashStringAllocator* allocator) {
   prepareAppend(allocator);
+  if (tryAppendFixedWidth(values, index)) {
+    ++size_;
+    return;
+  }
   ByteOutputStream stream(allocator);
   allocator->extendWrite(dataCurrent_, stream);
   // The stream may have a tail of a previous write.
@@ -76,6 +80,66 @@ void ValueList::appendNonNull(
       allocator->finishWrite(stream, std::clamp(bytes_ / 2, 24, 1024)).second;
 }
 
+bool ValueList::tryAppendFixedWidth(
+    const BaseVector& values,
+    vector_size_t index) {
+  if (values.encoding() != VectorEncoding::Simple::FLAT ||
+      !exec::ContainerRowSerde::isFixedWidth(values.typeKind()) ||
+      values.values() == nullptr) {
+    return false;
+  }
+  const int32_t width = values.type()->cppSizeInBytes();
+  if (dataCurrent_.header->usableSize() - dataCurrent_.offset() < width) {
+    return false;
+  }
+  memcpy(
+      dataCurrent_.position,
+      values.values()->as<char>() + index * width,
+      width);
+  dataCurrent_.position += width;
+  bytes_ += width;
+  return true;
+}
+
+void ValueList::appendFixedWidthRange(
+    const BaseVector& values,
+    vector_size_t offset,
+    vector_size_t size,
+    HashStringAllocator* allocator) {
+  const int32_t width = values.type()->cppSizeInBytes();
+  const auto* rawValues = values.values()->as<char>();
+  const auto* rawNulls = values.rawNulls();
+  const auto end = offset + size;
+  auto index = offset;
+  while (index < end) {
+    prepareAppend(allocator);
+    const auto batchEnd = std::min<vector_size_t>(end, index + 64 - size_ % 64);
+    ByteOutputStream stream(allocator);
+    allocator->extendWrite(dataCurrent_, stream);
+    const auto initialSize = stream.size();
+    auto appendRun = [&](vector_size_t begin, vector_size_t runEnd) {
+      if (runEnd > begin) {
+        stream.appendStringView(std::string_view(
+            rawValues + begin * width, (runEnd - begin) * width));
+      }
+    };
+    auto runBegin = index;
+    for (; index < batchEnd; ++index) {
+      if (rawNulls && bits::isBitNull(rawNulls, index)) {
+        appendRun(runBegin, index);
+        lastNulls_ |= 1UL << (size_ % 64);
+        runBegin = index + 1;
+      }
+      ++size_;
+    }
+    appendRun(runBegin, batchEnd);
+    bytes_ += stream.size() - initialSize;
+    dataCurrent_ =
+        allocator->finishWrite(stream, std::clamp(bytes_ / 2, 24, 1024))
+            .second;
+  }
+}
+
 void ValueList::appendValue(
     const DecodedVector& decoded,
     vector_size_t index,
@@ -93,6 +157,12 @@ void ValueList::appendRange(
     vector_size_t offset,
     vector_size_t size,
     HashStringAllocator* allocator) {
+  if (vector->encoding() == VectorEncoding::Simple::FLAT &&
+      exec::ContainerRowSerde::isFixedWidth(vector->typeKind()) &&
+      vector->values() != nullptr) {
+    appendFixedWidthRange(*vector, offset, size, allocator);
+    return;
+  }
   for (auto index = offset; index < offset + size; ++index) {
     if (vector->isNullAt(index)) {
       appendNull(allocator);
@@ -93,6 +93,19 @@ class ValueList {
       vector_size_t index,
       HashStringAllocator* allocator);
 
+  // Appends a non-null value of a flat vector of fixed-width values without
+  // opening a write on 'allocator' if it fits in the space reserved after the
+  // last appended value. Returns false if the value was not appended.
+  bool tryAppendFixedWidth(const BaseVector& values, vector_size_t index);
+
+  // Appends a range of a flat vector of fixed-width values. Writes the values
+  // up to the end of each word of null flags with one write.
+  void appendFixedWidthRange(
+      const BaseVector& values,
+      vector_size_t offset,
+      vector_size_t size,
+      HashStringAllocator* allocator);
+
   void prepareAppend(HashStringAllocator* allocator);
 
   // Writes lastNulls_ word to the 'nulls' block.
@@ -110,6 +110,35 @@ TEST_F(ValueListTest, integers) {
   }
 }
 
+TEST_F(ValueListTest, fixedWidthRanges) {
+  auto data = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; }, test::VectorMaker::nullEvery(13));
+  testRoundTrip(data);
+  testRoundTrip(makeFlatVector<Timestamp>(
+      100,
+      [](auto row) { return Timestamp(row, row); },
+      test::VectorMaker::nullEvery(3)));
+
+  // Append ranges that start and end inside words of null flags, mixed with
+  // single values.
+  DecodedVector decoded(*data);
+  aggregate::ValueList values;
+  vector_size_t offset = 0;
+  for (auto step = 1; offset < data->size(); ++step) {
+    const auto size = std::min<vector_size_t>(step, data->size() - offset);
+    if (step % 3 == 0) {
+      for (auto i = offset; i < offset + size; ++i) {
+        values.appendValue(decoded, i, allocator());
+      }
+    } else {
+      values.appendRange(data, offset, size, allocator());
+    }
+    offset += size;
+  }
+  ASSERT_EQ(data->size(), values.size());
+  assertEqualVectors(data, read(values, data->type(), data->size()));
+}
+
 TEST_F(ValueListTest, arrays) {
   // No nulls.
   int32_t kSizeCaps[] = {730, 4000, 7500, 50000};
@@ -177,6 +177,19 @@ TEST_F(StringImplTest, length) {
   }
 }
 
+TEST_F(StringImplTest, isAscii) {
+  for (auto length : {0, 1, 7, 8, 9, 31, 32, 33, 64, 100}) {
+    std::string input(length, 'a');
+    ASSERT_TRUE(isAscii(input.data(), input.size())) << length;
+    // A non-ASCII byte anywhere, including the last partial word, is found.
+    for (auto i = 0; i < length; ++i) {
+      input[i] = '\xc3';
+      ASSERT_FALSE(isAscii(input.data(), input.size())) << length << " " << i;
+      input[i] = 'a';
+    }
+  }
+}
+
 TEST_F(StringImplTest, cappedLength) {
   auto input = std::string("abcd");
   ASSERT_EQ(cappedLength</*isAscii*/ true>(input, 1), 1);
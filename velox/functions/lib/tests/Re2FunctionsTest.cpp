@@ -57,6 +57,8 @@ class Re2FunctionsTest : public test::FunctionBaseTest {
     exec::registerStatefulVectorFunction(
         "re2_extract_all", re2ExtractAllSignatures(), makeRe2ExtractAll);
     exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
+    exec::registerStatefulVectorFunction(
+        "like_any", likeAnySignatures(), makeLikeAny);
   }
 
  protected:
@@ -945,6 +947,79 @@ TEST_F(Re2FunctionsTest, likePatternAndEscape) {
       "Escape character must be followed by '%', '_' or the escape character itself");
 }
 
+TEST_F(Re2FunctionsTest, likeAny) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>({
+      "abc",
+      "xxbyc",
+      "log: error in module foo",
+      "log: warning in module bar",
+      "",
+      std::nullopt,
+      "\u4FE1\u5FF5 \u7231 \u5E0C",
+      "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz_error_",
+  })});
+  const std::vector<std::string> patterns = {
+      "a%",
+      "%b_c%",
+      "%error%module%",
+      "%warning%b_r",
+      "\u4FE1%\u7231_%",
+      "___",
+      "%\\_%",
+  };
+  std::string likeAny = "like_any(c0";
+  std::string disjunction;
+  for (const auto& pattern : patterns) {
+    likeAny += fmt::format(", '{}'", pattern);
+    disjunction += fmt::format(
+        "{}c0 like '{}'", disjunction.empty() ? "" : " OR ", pattern);
+  }
+  likeAny += ")";
+  assertEqualVectors(evaluate(disjunction, data), evaluate(likeAny, data));
+  assertEqualVectors(
+      makeNullableFlatVector<bool>(
+          {true, true, true, true, false, std::nullopt, true, false}),
+      evaluate(likeAny, data));
+
+  // Only patterns that need a regular expression.
+  assertEqualVectors(
+      evaluate("c0 like '%_b_%' OR c0 like '%e%o%'", data),
+      evaluate("like_any(c0, '%_b_%', '%e%o%')", data));
+}
+
+TEST_F(Re2FunctionsTest, likeDisjunctionRewrite) {
+  auto rowType = ROW({"c0", "c1"}, {VARCHAR(), VARCHAR()});
+  auto rewrite = [&](const std::string& expr) {
+    return rewriteLikeDisjunction(
+        "like", "like_any", makeTypedExpr(expr, rowType));
+  };
+  auto assertEqualExprs = [&](const core::TypedExprPtr& actual,
+                              const std::string& expected) {
+    ASSERT_TRUE(actual != nullptr);
+    ASSERT_TRUE(*actual == *makeTypedExpr(expected, rowType))
+        << actual->toString();
+  };
+
+  assertEqualExprs(
+      rewrite("c0 like 'a%' OR c0 like '%b%c'"),
+      "like_any(c0, 'a%', '%b%c')");
+
+  // Other disjuncts are kept in place.
+  auto rewritten = rewrite(
+      "c0 like 'a%' OR c1 like 'x' escape '#' OR c0 like '%b%c' OR "
+      "c1 like 'y%'");
+  ASSERT_TRUE(rewritten != nullptr);
+  ASSERT_EQ(rewritten->inputs().size(), 3);
+  assertEqualExprs(rewritten->inputs()[0], "like_any(c0, 'a%', '%b%c')");
+  assertEqualExprs(rewritten->inputs()[1], "c1 like 'x' escape '#'");
+  assertEqualExprs(rewritten->inputs()[2], "c1 like 'y%'");
+
+  // Nothing to combine.
+  EXPECT_EQ(rewrite("c0 like 'a%' OR c1 like 'b%'"), nullptr);
+  EXPECT_EQ(rewrite("c0 like 'a%' AND c0 like 'b%'"), nullptr);
+  EXPECT_EQ(rewrite("c0 like 'a%' OR c0 like 'b%' escape '#'"), nullptr);
+}
+
 TEST_F(Re2FunctionsTest, likePatternUnicode) {
   // Input contains unicode.
   testLike("你abc", "______", false);
@@ -1471,5 +1546,29 @@ TEST_F(Re2FunctionsTest, limit) {
   ASSERT_NO_THROW(evaluate("regexp_like(c0, c2)", data));
 }
 
+TEST_F(Re2FunctionsTest, maxCompiledRegexesConfig) {
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          100,
+          [](auto row) { return fmt::format("Apples and oranges {}", row); }),
+      makeFlatVector<std::string>(
+          100,
+          [](auto row) { return fmt::format("Apples (.*) oranges {}", row); }),
+  });
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprMaxCompiledRegexes, "100"},
+  });
+
+  auto expected = makeFlatVector<bool>(100, [](auto /*row*/) { return true; });
+  assertEqualVectors(expected, evaluate("regexp_like(c0, c1)", data));
+  // The second evaluation gets the compiled expressions from the cache shared
+  // by all function instances.
+  assertEqualVectors(expected, evaluate("regexp_like(c0, c1)", data));
+  assertEqualVectors(
+      makeFlatVector<std::string>(
+          100, [](auto /*row*/) { return std::string("and"); }),
+      evaluate("regexp_extract(c0, c1, 1)", data));
+}
+
 } // namespace
 } // namespace facebook::velox::functions
@@ -97,9 +97,12 @@ void registerRankInternal(
       exec::FunctionSignatureBuilder().returnType(returnType).build(),
   };
 
+  // percent_rank() depends on the number of rows in the partition.
+  exec::WindowFunction::Metadata metadata{TRank != RankType::kPercentRank};
   exec::registerWindowFunction(
       name,
       std::move(signatures),
+      metadata,
       [name](
           const std::vector<exec::WindowFunctionArg>& /*args*/,
           const TypePtr& resultType,
@@ -18,6 +18,7 @@
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SmallArraySet.h"
 #include "velox/type/FloatingPointUtil.h"
 
 namespace facebook::velox::functions {
@@ -94,31 +95,41 @@ class ArrayDistinctFunction : public exec::VectorFunction {
     auto* rawNewSizes = newLengths->asMutable<vector_size_t>();
     auto* rawNewOffsets = newOffsets->asMutable<vector_size_t>();
 
-    // Process the rows: store unique values in the hash table.
+    // Process the rows: store unique values in the hash table or, for short
+    // arrays, in a small set that is scanned linearly.
     util::floating_point::HashSetNaNAware<T> uniqueSet;
+    SmallArraySet<T> smallUniqueSet;
+
+    auto addDistinct =
+        [&](auto& set, vector_size_t offset, vector_size_t size) {
+          bool hasNulls = false;
+          for (vector_size_t i = offset; i < offset + size; ++i) {
+            if (elements->isNullAt(i)) {
+              if (!hasNulls) {
+                hasNulls = true;
+                rawNewIndices[indicesCursor++] = i;
+              }
+            } else {
+              auto value = elements->valueAt<T>(i);
+
+              if (set.insert(value).second) {
+                rawNewIndices[indicesCursor++] = i;
+              }
+            }
+          }
+          set.clear();
+        };
 
     rows.applyToSelected([&](vector_size_t row) {
       auto size = arrayVector->sizeAt(row);
       auto offset = arrayVector->offsetAt(row);
 
       rawNewOffsets[row] = indicesCursor;
-      bool hasNulls = false;
-      for (vector_size_t i = offset; i < offset + size; ++i) {
-        if (elements->isNullAt(i)) {
-          if (!hasNulls) {
-            hasNulls = true;
-            rawNewIndices[indicesCursor++] = i;
-          }
-        } else {
-          auto value = elements->valueAt<T>(i);
-
-          if (uniqueSet.insert(value).second) {
-            rawNewIndices[indicesCursor++] = i;
-          }
-        }
+      if (size <= SmallArraySet<T>::kMaxSize) {
+        addDistinct(smallUniqueSet, offset, size);
+      } else {
+        addDistinct(uniqueSet, offset, size);
       }
-
-      uniqueSet.clear();
       rawNewSizes[row] = indicesCursor - rawNewOffsets[row];
     });
 
@@ -16,14 +16,19 @@
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
+#include "velox/functions/lib/SmallArraySet.h"
 #include "velox/type/FloatingPointUtil.h"
 
 namespace facebook::velox::functions {
 namespace {
-template <typename T>
+template <
+    typename T,
+    typename TSet = util::floating_point::HashSetNaNAware<T>>
 struct SetWithNull {
   SetWithNull(vector_size_t initialSetSize = kInitialSetSize) {
-    set.reserve(initialSetSize);
+    if constexpr (!std::is_same_v<TSet, SmallArraySet<T>>) {
+      set.reserve(initialSetSize);
+    }
   }
 
   void reset() {
@@ -35,20 +40,24 @@ struct SetWithNull {
     return !hasNull && set.empty();
   }
 
-  util::floating_point::HashSetNaNAware<T> set;
+  TSet set;
   bool hasNull{false};
   static constexpr vector_size_t kInitialSetSize{128};
 };
 
+// Set for the elements of arrays of up to SmallArraySet::kMaxSize elements.
+template <typename T>
+using SmallSetWithNull = SetWithNull<T, SmallArraySet<T>>;
+
 // Generates a set based on the elements of an ArrayVector. Note that we take
 // rightSet as a parameter (instead of returning a new one) to reuse the
 // allocated memory.
-template <typename T, typename TVector>
+template <typename T, typename TVector, typename TSet>
 void generateSet(
     const ArrayVector* arrayVector,
     const TVector* arrayElements,
     vector_size_t idx,
-    SetWithNull<T>& rightSet) {
+    SetWithNull<T, TSet>& rightSet) {
   auto size = arrayVector->sizeAt(idx);
   auto offset = arrayVector->offsetAt(idx);
   rightSet.reset();
@@ -163,10 +172,10 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
 
     // Lambda that process each row. This is detached from the code so we can
     // apply it differently based on whether the right-hand side set is constant
-    // or not.
+    // or not and whether the arrays are small enough for SmallArraySet.
     auto processRow = [&](vector_size_t row,
-                          const SetWithNull<T>& rightSet,
-                          SetWithNull<T>& outputSet) {
+                          const auto& rightSet,
+                          auto& outputSet) {
       auto idx = decodedLeftArray->index(row);
       auto size = baseLeftArray->sizeAt(idx);
       auto offset = baseLeftArray->offsetAt(idx);
@@ -214,11 +223,23 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
     };
 
     SetWithNull<T> outputSet;
+    SmallSetWithNull<T> smallOutputSet;
+
+    // The output of a row has at most as many values as the left-hand side
+    // array.
+    auto isLeftSmall = [&](vector_size_t row) {
+      return baseLeftArray->sizeAt(decodedLeftArray->index(row)) <=
+          SmallArraySet<T>::kMaxSize;
+    };
 
     // Optimized case when the right-hand side array is constant.
     if (constantSet_.has_value()) {
       rows.applyToSelected([&](vector_size_t row) {
-        processRow(row, *constantSet_, outputSet);
+        if (isLeftSmall(row)) {
+          processRow(row, *constantSet_, smallOutputSet);
+        } else {
+          processRow(row, *constantSet_, outputSet);
+        }
       });
     }
     // General case when no arrays are constant and both sets need to be
@@ -230,11 +251,19 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
       auto decodedRightElements =
           decodeArrayElements(rightHolder, rightElementsHolder, rows);
       SetWithNull<T> rightSet;
+      SmallSetWithNull<T> smallRightSet;
       auto rightArrayVector = rightHolder.get()->base()->as<ArrayVector>();
       rows.applyToSelected([&](vector_size_t row) {
         auto idx = rightHolder.get()->index(row);
-        generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
-        processRow(row, rightSet, outputSet);
+        if (isLeftSmall(row) &&
+            rightArrayVector->sizeAt(idx) <= SmallArraySet<T>::kMaxSize) {
+          generateSet<T>(
+              rightArrayVector, decodedRightElements, idx, smallRightSet);
+          processRow(row, smallRightSet, smallOutputSet);
+        } else {
+          generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
+          processRow(row, rightSet, outputSet);
+        }
       });
     }
 
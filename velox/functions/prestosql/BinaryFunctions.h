@@ -243,18 +243,33 @@ FOLLY_ALWAYS_INLINE static uint8_t fromHex(char c) {
   VELOX_USER_FAIL("Invalid hex character: {}", c);
 }
 
+// Returns the value of hex digit 'c' or -1 if 'c' is not a hex digit.
+FOLLY_ALWAYS_INLINE static int32_t hexDigitValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'A' && c <= 'F') {
+    return 10 + c - 'A';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return 10 + c - 'a';
+  }
+  return -1;
+}
+
+/// Invalid input is reported with a Status instead of an exception, so that
+/// try(from_hex(x)) over dirty data does not throw for each bad row.
 template <typename T>
 struct FromHexFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE void call(
+  FOLLY_ALWAYS_INLINE Status call(
       out_type<Varchar>& result,
       const arg_type<Varbinary>& input) {
-    VELOX_USER_CHECK_EQ(
-        input.size() % 2,
-        0,
-        "Invalid input length for from_hex(): {}",
-        input.size());
+    if (input.size() % 2 != 0) {
+      return Status::UserError(
+          "Invalid input length for from_hex(): {}", input.size());
+    }
 
     const auto resultSize = input.size() / 2;
     result.resize(resultSize);
@@ -263,9 +278,16 @@ struct FromHexFunction {
     char* resultBuffer = result.data();
 
     for (auto i = 0; i < resultSize; ++i) {
-      resultBuffer[i] =
-          (fromHex(inputBuffer[i * 2]) << 4) | fromHex(inputBuffer[i * 2 + 1]);
+      const auto high = hexDigitValue(inputBuffer[i * 2]);
+      const auto low = hexDigitValue(inputBuffer[i * 2 + 1]);
+      if (high < 0 || low < 0) {
+        return Status::UserError(
+            "Invalid hex character: {}",
+            high < 0 ? inputBuffer[i * 2] : inputBuffer[i * 2 + 1]);
+      }
+      resultBuffer[i] = (high << 4) | low;
     }
+    return Status::OK();
   }
 };
 
@@ -232,11 +232,61 @@ class ComparisonSimdFunction : public exec::VectorFunction {
     return true;
   }
 
+  bool supportsFusedEval(const std::vector<TypePtr>& argTypes) const override {
+    switch (argTypes[0]->kind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool applyFused(
+      const std::vector<TypePtr>& argTypes,
+      vector_size_t size,
+      const void* const* args,
+      void* result) const override {
+    auto* rawResult = static_cast<bool*>(result);
+    switch (argTypes[0]->kind()) {
+      case TypeKind::TINYINT:
+        return compareFused<int8_t>(size, args, rawResult);
+      case TypeKind::SMALLINT:
+        return compareFused<int16_t>(size, args, rawResult);
+      case TypeKind::INTEGER:
+        return compareFused<int32_t>(size, args, rawResult);
+      case TypeKind::BIGINT:
+        return compareFused<int64_t>(size, args, rawResult);
+      case TypeKind::REAL:
+        return compareFused<float>(size, args, rawResult);
+      case TypeKind::DOUBLE:
+        return compareFused<double>(size, args, rawResult);
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
   exec::FunctionCanonicalName getCanonicalName() const override {
     return std::is_same_v<ComparisonOp, std::less<>>
         ? exec::FunctionCanonicalName::kLt
         : exec::FunctionCanonicalName::kUnknown;
   }
+
+ private:
+  template <typename T>
+  static bool
+  compareFused(vector_size_t size, const void* const* args, bool* result) {
+    const auto* lhs = static_cast<const T*>(args[0]);
+    const auto* rhs = static_cast<const T*>(args[1]);
+    for (auto i = 0; i < size; ++i) {
+      result[i] = ComparisonOp()(lhs[i], rhs[i]);
+    }
+    return true;
+  }
 };
 
 } // namespace
@@ -191,7 +191,7 @@ struct WeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getWeek(getDateTime(timestamp, this->timeZone_));
+    result = getWeek(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -218,7 +218,7 @@ struct YearFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getYear(getDateTime(timestamp, this->timeZone_));
+    result = getYear(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -245,7 +245,7 @@ struct QuarterFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getQuarter(getDateTime(timestamp, this->timeZone_));
+    result = getQuarter(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -272,7 +272,7 @@ struct MonthFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getMonth(getDateTime(timestamp, this->timeZone_));
+    result = getMonth(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -295,7 +295,7 @@ struct DayFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_mday;
+    result = this->getDateTime(timestamp).tm_mday;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -326,21 +326,22 @@ struct LastDayOfMonthFunction : public InitSessionTimezone<T>,
                                 public TimestampWithTimezoneSupport<T> {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
-  FOLLY_ALWAYS_INLINE void call(
+  FOLLY_ALWAYS_INLINE Status call(
       out_type<Date>& result,
       const arg_type<Timestamp>& timestamp) {
-    auto dt = getDateTime(timestamp, this->timeZone_);
+    auto dt = this->getDateTime(timestamp);
     int64_t daysSinceEpochFromDate;
     auto status =
         util::lastDayOfMonthSinceEpochFromDate(dt, daysSinceEpochFromDate);
     if (!status.ok()) {
       VELOX_DCHECK(status.isUserError());
-      VELOX_USER_FAIL(status.message());
+      return status;
     }
     result = daysSinceEpochFromDate;
+    return Status::OK();
   }
 
-  FOLLY_ALWAYS_INLINE void call(
+  FOLLY_ALWAYS_INLINE Status call(
       out_type<Date>& result,
       const arg_type<Date>& date) {
     auto dt = getDateTime(date);
@@ -349,12 +350,13 @@ struct LastDayOfMonthFunction : public InitSessionTimezone<T>,
         util::lastDayOfMonthSinceEpochFromDate(dt, daysSinceEpochFromDate);
     if (!status.ok()) {
       VELOX_DCHECK(status.isUserError());
-      VELOX_USER_FAIL(status.message());
+      return status;
     }
     result = daysSinceEpochFromDate;
+    return Status::OK();
   }
 
-  FOLLY_ALWAYS_INLINE void call(
+  FOLLY_ALWAYS_INLINE Status call(
       out_type<Date>& result,
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     auto timestamp = this->toTimestamp(timestampWithTimezone);
@@ -364,9 +366,10 @@ struct LastDayOfMonthFunction : public InitSessionTimezone<T>,
         util::lastDayOfMonthSinceEpochFromDate(dt, daysSinceEpochFromDate);
     if (!status.ok()) {
       VELOX_DCHECK(status.isUserError());
-      VELOX_USER_FAIL(status.message());
+      return status;
     }
     result = daysSinceEpochFromDate;
+    return Status::OK();
   }
 };
 
@@ -525,7 +528,7 @@ struct DayOfWeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfWeek(getDateTime(timestamp, this->timeZone_));
+    result = getDayOfWeek(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -552,7 +555,7 @@ struct DayOfYearFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDayOfYear(getDateTime(timestamp, this->timeZone_));
+    result = getDayOfYear(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -596,7 +599,7 @@ struct YearOfWeekFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = computeYearOfWeek(getDateTime(timestamp, this->timeZone_));
+    result = computeYearOfWeek(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -619,7 +622,7 @@ struct HourFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_hour;
+    result = this->getDateTime(timestamp).tm_hour;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
@@ -642,7 +645,7 @@ struct MinuteFunction : public InitSessionTimezone<T>,
   FOLLY_ALWAYS_INLINE void call(
       int64_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_min;
+    result = this->getDateTime(timestamp).tm_min;
   }
 
   FOLLY_ALWAYS_INLINE void call(int64_t& result, const arg_type<Date>& date) {
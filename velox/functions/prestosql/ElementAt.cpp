@@ -36,6 +36,13 @@ class ElementAtFunction : public SubscriptImpl<
                               /* indexStartsAtOne */ true> {
  public:
   explicit ElementAtFunction(bool allowcaching) : SubscriptImpl(allowcaching) {}
+
+  // Out of bound accesses return null, which is also the result for the
+  // elements and keys pruned by the reader. Negative array indices are not
+  // extracted as subfields.
+  bool canPushdown() const override {
+    return true;
+  }
 };
 } // namespace
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/expression/DecodedArgs.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Filter.h"
 
@@ -544,6 +545,9 @@ class InPredicate : public exec::VectorFunction {
           }
         }
       });
+    } else if constexpr (
+        std::is_same_v<T, int64_t> || std::is_same_v<T, int32_t>) {
+      testValuesSimd(rows, flatArg->rawValues(), rawResults);
     } else {
       rows.applyToSelected([&](auto row) {
         bool pass = testFunction(flatArg->valueAtFast(row));
@@ -552,6 +556,48 @@ class InPredicate : public exec::VectorFunction {
     }
   }
 
+  // Tests the 'rawValues' of 'rows' a SIMD batch at a time and sets the bits
+  // of 'rawResults'. The filter probes its hash table for all the lanes of a
+  // batch at once instead of one value at a time. Used for integers without
+  // nulls.
+  template <typename T>
+  void testValuesSimd(
+      const SelectivityVector& rows,
+      const T* rawValues,
+      uint64_t* rawResults) const {
+    constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+    const auto* selectedBits = rows.asRange().bits();
+    const auto end = rows.end();
+    auto testRow = [&](vector_size_t row) {
+      if (rows.isValid(row)) {
+        bits::setBit(rawResults, row, filter_->testInt64(rawValues[row]));
+      }
+    };
+    auto row = rows.begin();
+    const auto firstBatch = std::min<vector_size_t>(
+        bits::roundUp(row, kBatchSize), end);
+    for (; row < firstBatch; ++row) {
+      testRow(row);
+    }
+    // Batches are aligned to kBatchSize, which divides 64, so that a batch
+    // is in one word of bits. Unselected lanes are tested but not stored.
+    for (; row + kBatchSize <= end; row += kBatchSize) {
+      const auto shift = row % 64;
+      const uint64_t selected =
+          selectedBits[row / 64] & (bits::lowMask(kBatchSize) << shift);
+      if (selected == 0) {
+        continue;
+      }
+      const uint64_t pass = simd::toBitMask(
+          filter_->testValues(xsimd::load_unaligned(rawValues + row)));
+      auto& word = rawResults[row / 64];
+      word = (word & ~selected) | ((pass << shift) & selected);
+    }
+    for (; row < end; ++row) {
+      testRow(row);
+    }
+  }
+
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
 };
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/prestosql/json/SIMDJsonUtil.h"
 #include "velox/functions/prestosql/types/JsonType.h"
@@ -183,6 +184,159 @@ class JsonParseFunction : public exec::VectorFunction {
 
 } // namespace
 
+namespace {
+// Paths extracted from one JSON column and the call that extracts them
+// together.
+struct JsonPaths {
+  core::TypedExprPtr json;
+  std::vector<core::TypedExprPtr> paths;
+  core::TypedExprPtr extractCall;
+};
+
+// Returns true if 'expr' is a json_extract_scalar call with a constant path
+// over a column.
+bool isExtractScalarOfColumn(
+    const core::TypedExprPtr& expr,
+    const std::string& name) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != name || call->inputs().size() != 2) {
+    return false;
+  }
+  const auto& json = call->inputs()[0];
+  if (!dynamic_cast<const core::FieldAccessTypedExpr*>(json.get()) &&
+      !dynamic_cast<const core::DereferenceTypedExpr*>(json.get())) {
+    return false;
+  }
+  const auto* path =
+      dynamic_cast<const core::ConstantTypedExpr*>(call->inputs()[1].get());
+  return path != nullptr && !path->hasValueVector() &&
+      !path->value().isNull();
+}
+
+JsonPaths* findPaths(
+    std::vector<JsonPaths>& allPaths,
+    const core::TypedExprPtr& json) {
+  for (auto& paths : allPaths) {
+    if (*paths.json == *json) {
+      return &paths;
+    }
+  }
+  return nullptr;
+}
+
+// Adds the paths of the json_extract_scalar calls in 'expr' to 'allPaths'.
+void collectPaths(
+    const core::TypedExprPtr& expr,
+    const std::string& name,
+    std::vector<JsonPaths>& allPaths) {
+  if (isExtractScalarOfColumn(expr, name)) {
+    const auto& json = expr->inputs()[0];
+    const auto& path = expr->inputs()[1];
+    auto* paths = findPaths(allPaths, json);
+    if (paths == nullptr) {
+      allPaths.push_back({json, {}, nullptr});
+      paths = &allPaths.back();
+    }
+    for (const auto& existing : paths->paths) {
+      if (*existing == *path) {
+        return;
+      }
+    }
+    paths->paths.push_back(path);
+    return;
+  }
+  if (!dynamic_cast<const core::CallTypedExpr*>(expr.get()) &&
+      !dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return;
+  }
+  for (const auto& input : expr->inputs()) {
+    collectPaths(input, name, allPaths);
+  }
+}
+
+// Returns 'expr' with the json_extract_scalar calls replaced by subscripts of
+// the shared extract calls in 'allPaths' or nullptr if 'expr' has no such
+// calls.
+core::TypedExprPtr rewritePaths(
+    const core::TypedExprPtr& expr,
+    const std::string& name,
+    const std::string& subscriptName,
+    std::vector<JsonPaths>& allPaths) {
+  if (isExtractScalarOfColumn(expr, name)) {
+    auto* paths = findPaths(allPaths, expr->inputs()[0]);
+    if (paths->extractCall == nullptr) {
+      return nullptr;
+    }
+    int64_t index = 0;
+    while (!(*paths->paths[index] == *expr->inputs()[1])) {
+      ++index;
+    }
+    return std::make_shared<core::CallTypedExpr>(
+        VARCHAR(),
+        std::vector<core::TypedExprPtr>{
+            paths->extractCall,
+            std::make_shared<core::ConstantTypedExpr>(
+                BIGINT(), variant(index + 1))},
+        subscriptName);
+  }
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  const auto* cast = dynamic_cast<const core::CastTypedExpr*>(expr.get());
+  if (call == nullptr && cast == nullptr) {
+    return nullptr;
+  }
+  bool rewritten = false;
+  std::vector<core::TypedExprPtr> inputs;
+  inputs.reserve(expr->inputs().size());
+  for (const auto& input : expr->inputs()) {
+    auto newInput = rewritePaths(input, name, subscriptName, allPaths);
+    rewritten |= newInput != nullptr;
+    inputs.push_back(newInput != nullptr ? newInput : input);
+  }
+  if (!rewritten) {
+    return nullptr;
+  }
+  if (call != nullptr) {
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(), std::move(inputs), call->name());
+  }
+  return std::make_shared<core::CastTypedExpr>(
+      expr->type(), std::move(inputs), cast->nullOnFailure());
+}
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  const auto name = prefix + "json_extract_scalar";
+  const auto subscriptName = prefix + "subscript";
+  std::vector<JsonPaths> allPaths;
+  for (const auto& expr : exprs) {
+    collectPaths(expr, name, allPaths);
+  }
+  bool shared = false;
+  for (auto& paths : allPaths) {
+    if (paths.paths.size() < 2) {
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{paths.json};
+    inputs.insert(inputs.end(), paths.paths.begin(), paths.paths.end());
+    paths.extractCall = std::make_shared<core::CallTypedExpr>(
+        ARRAY(VARCHAR()), std::move(inputs), "$internal$json_extract_scalars");
+    shared = true;
+  }
+  if (!shared ||
+      !exec::getVectorFunctionSignatures(subscriptName).has_value()) {
+    return {};
+  }
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    auto newExpr = rewritePaths(expr, name, subscriptName, allPaths);
+    rewritten.push_back(newExpr != nullptr ? newExpr : expr);
+  }
+  return rewritten;
+}
+
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_json_format,
     JsonFormatFunction::signatures(),
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/core/Expressions.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonPathTokenizer.h"
@@ -189,6 +190,58 @@ struct JsonArrayGetFunction {
   }
 };
 
+namespace detail {
+
+// Extracts the scalar at 'jsonPath' in 'json' as a string into 'resultStr'.
+// 'json' is either the JSON text or a parsed document. Returns
+// NO_SUCH_FIELD if the path does not map to a single scalar.
+template <typename TJson>
+simdjson::error_code extractScalar(
+    TJson& json,
+    const StringView& jsonPath,
+    std::optional<std::string>& resultStr) {
+  bool resultPopulated = false;
+  auto consumer = [&resultStr, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      resultStr = std::nullopt;
+      return simdjson::SUCCESS;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        resultStr = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
+      }
+    }
+    return simdjson::SUCCESS;
+  };
+
+  auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
+  SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
+
+  return resultStr.has_value() ? simdjson::SUCCESS : simdjson::NO_SUCH_FIELD;
+}
+
+} // namespace detail
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -201,61 +254,69 @@ struct JsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    return callImpl(result, json, jsonPath) == simdjson::SUCCESS;
+    std::optional<std::string> resultStr;
+    if (detail::extractScalar(json, jsonPath, resultStr) != simdjson::SUCCESS) {
+      return false;
+    }
+    result.copy_from(*resultStr);
+    return true;
   }
+};
 
- private:
-  FOLLY_ALWAYS_INLINE bool callImpl(
-      out_type<Varchar>& result,
+// $internal$json_extract_scalars(json, json_path1, json_path2, ...) ->
+// array(varchar)
+// Returns json_extract_scalar(json, json_path) for each of the paths, with a
+// null element for a path that json_extract_scalar returns null for. The JSON
+// is parsed once for all the paths. Calls are made by
+// rewriteJsonExtractScalars() for expressions that extract several paths from
+// the same JSON column.
+template <typename T>
+struct JsonExtractScalarsFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE void call(
+      out_type<Array<Varchar>>& result,
       const arg_type<Json>& json,
-      const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
+      const arg_type<Variadic<Varchar>>& jsonPaths) {
+    simdjson::padded_string paddedJson(json.data(), json.size());
+    simdjson::ondemand::document jsonDoc;
+    bool parsed = !simdjsonParse(paddedJson).get(jsonDoc);
     std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return simdjson::SUCCESS;
+    for (const auto& jsonPath : jsonPaths) {
+      if (!parsed || !jsonPath.has_value()) {
+        result.add_null();
+        continue;
       }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
+      resultStr.reset();
+      const auto error =
+          detail::extractScalar(jsonDoc, jsonPath.value(), resultStr);
+      if (error == simdjson::SUCCESS) {
+        result.add_item().copy_from(*resultStr);
+      } else {
+        result.add_null();
+      }
+      if (error == simdjson::SUCCESS || error == simdjson::NO_SUCH_FIELD) {
+        jsonDoc.rewind();
+      } else {
+        // The document may be left in an error state. Parse it again so that
+        // the other paths are extracted as if on their own.
+        parsed = !simdjsonParse(paddedJson).get(jsonDoc);
       }
-      return simdjson::SUCCESS;
-    };
-
-    auto& extractor = SIMDJsonExtractor::getInstance(jsonPath);
-    SIMDJSON_TRY(simdJsonExtract(json, extractor, consumer));
-
-    if (resultStr.has_value()) {
-      result.copy_from(*resultStr);
-      return simdjson::SUCCESS;
-    } else {
-      return simdjson::NO_SUCH_FIELD;
     }
   }
 };
 
+/// Rewrites json_extract_scalar calls that extract two or more constant paths
+/// from the same column into subscripts of one $internal$json_extract_scalars
+/// call over all the paths. The compiler evaluates the shared call once, so
+/// the JSON of each row is parsed once instead of once per path. Calls inside
+/// function calls and casts in any of 'exprs' are rewritten. 'prefix' is the
+/// prefix of the names of the Presto functions. Returns an empty vector if
+/// there is nothing to rewrite.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalars(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
 template <typename T>
 struct JsonExtractFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
@@ -13,7 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/functions/prestosql/Reduce.h"
+
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/CheckedArithmetic.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 
 namespace facebook::velox::functions {
@@ -230,8 +233,292 @@ class ReduceFunction : public exec::VectorFunction {
     context.moveOrCopyResult(localResult, rows, result);
   }
 };
+
+enum class ReduceKind { kSum, kCount, kGreatest, kLeast };
+
+// Same ordering as in greatest and least: NaN is larger than any other value.
+template <typename T>
+bool greaterThan(T lhs, T rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(lhs)) {
+      return true;
+    }
+    if (std::isnan(rhs)) {
+      return false;
+    }
+  }
+  return lhs > rhs;
+}
+
+template <typename T>
+bool smallerThan(T lhs, T rhs) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(lhs)) {
+      return false;
+    }
+    if (std::isnan(rhs)) {
+      return true;
+    }
+  }
+  return lhs < rhs;
+}
+
+/// Evaluates reduce(array, initialState, inputFunction, s -> s) for the input
+/// functions recognized by rewriteReduceCall as a loop over the elements of
+/// each array. The result, including nulls and errors, is the same as the
+/// result of applying the input function to one element at a time: a null
+/// element makes the result null and stops the accumulation, an overflow
+/// before the first null element raises the error of the checked 'plus'.
+template <typename T, ReduceKind kind>
+class SegmentedReduceFunction : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    VELOX_CHECK_EQ(args.size(), 2);
+    exec::LocalDecodedVector arrayDecoder(context, *args[0], rows);
+    auto& decodedArray = *arrayDecoder.get();
+
+    checkArraySizes(rows, decodedArray, context);
+
+    exec::LocalSelectivityVector remainingRows(context, rows);
+    context.deselectErrors(*remainingRows);
+
+    exec::LocalDecodedVector initialState(context, *args[1], rows);
+
+    context.ensureWritable(rows, outputType, result);
+    auto* flatResult = result->asFlatVector<T>();
+
+    const auto* arrayVector = decodedArray.base()->as<ArrayVector>();
+    const auto* rawOffsets = arrayVector->rawOffsets();
+    const auto* rawSizes = arrayVector->rawSizes();
+    const auto* indices = decodedArray.indices();
+
+    if constexpr (kind == ReduceKind::kCount) {
+      context.applyToSelectedNoThrow(*remainingRows, [&](auto row) {
+        const auto state = initialState->valueAt<T>(row);
+        const auto size = rawSizes[indices[row]];
+        T count;
+        if (size > std::numeric_limits<T>::max() ||
+            __builtin_add_overflow(state, static_cast<T>(size), &count)) {
+          // Adding 1 at a time overflows when the state reaches the maximum.
+          checkedPlus<T>(std::numeric_limits<T>::max(), 1);
+        }
+        flatResult->set(row, count);
+      });
+      return;
+    }
+
+    const auto& elements = arrayVector->elements();
+    SelectivityVector elementRows(elements->size());
+    exec::LocalDecodedVector decodedElements(context, *elements, elementRows);
+    context.applyToSelectedNoThrow(*remainingRows, [&](auto row) {
+      const auto array = indices[row];
+      const auto begin = rawOffsets[array];
+      const auto end = begin + rawSizes[array];
+      auto state = initialState->valueAt<T>(row);
+      for (auto i = begin; i < end; ++i) {
+        if (decodedElements->isNullAt(i)) {
+          flatResult->setNull(row, true);
+          return;
+        }
+        const auto value = decodedElements->valueAt<T>(i);
+        if constexpr (kind == ReduceKind::kSum) {
+          if constexpr (std::is_floating_point_v<T>) {
+            state += value;
+          } else {
+            state = checkedPlus<T>(state, value);
+          }
+        } else if constexpr (kind == ReduceKind::kGreatest) {
+          if (greaterThan(value, state)) {
+            state = value;
+          }
+        } else {
+          if (smallerThan(value, state)) {
+            state = value;
+          }
+        }
+      }
+      flatResult->set(row, state);
+    });
+  }
+};
+
+template <ReduceKind kind>
+std::shared_ptr<exec::VectorFunction> createSegmentedReduce(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  switch (inputArgs[1].type->kind()) {
+    case TypeKind::TINYINT:
+      return std::make_shared<SegmentedReduceFunction<int8_t, kind>>();
+    case TypeKind::SMALLINT:
+      return std::make_shared<SegmentedReduceFunction<int16_t, kind>>();
+    case TypeKind::INTEGER:
+      return std::make_shared<SegmentedReduceFunction<int32_t, kind>>();
+    case TypeKind::BIGINT:
+      return std::make_shared<SegmentedReduceFunction<int64_t, kind>>();
+    case TypeKind::REAL:
+      if constexpr (kind != ReduceKind::kCount) {
+        return std::make_shared<SegmentedReduceFunction<float, kind>>();
+      }
+      break;
+    case TypeKind::DOUBLE:
+      if constexpr (kind != ReduceKind::kCount) {
+        return std::make_shared<SegmentedReduceFunction<double, kind>>();
+      }
+      break;
+    default:
+      break;
+  }
+  VELOX_UNSUPPORTED(
+      "Unsupported type for segmented reduce: {}",
+      inputArgs[1].type->toString());
+}
+
+// array(T), T -> T for the numeric types in 'types'.
+std::vector<std::shared_ptr<exec::FunctionSignature>> segmentedReduceSignatures(
+    const std::vector<std::string>& types) {
+  std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+  for (const auto& type : types) {
+    signatures.push_back(exec::FunctionSignatureBuilder()
+                             .returnType(type)
+                             .argumentType(fmt::format("array({})", type))
+                             .argumentType(type)
+                             .build());
+  }
+  return signatures;
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+segmentedReduceSignatures() {
+  return segmentedReduceSignatures(
+      {"tinyint", "smallint", "integer", "bigint", "real", "double"});
+}
+
+// The count is computed from the array sizes, the elements may be of any type.
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+segmentedCountSignatures() {
+  std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+  for (const auto& type : {"integer", "bigint"}) {
+    signatures.push_back(exec::FunctionSignatureBuilder()
+                             .typeVariable("T")
+                             .returnType(type)
+                             .argumentType("array(T)")
+                             .argumentType(type)
+                             .build());
+  }
+  return signatures;
+}
+
+bool isField(const core::TypedExprPtr& expr, const std::string& name) {
+  auto field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  return field != nullptr && field->isInputColumn() && field->name() == name;
+}
+
+bool isOne(const core::TypedExprPtr& expr) {
+  auto constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || constant->hasValueVector() ||
+      constant->value().isNull()) {
+    return false;
+  }
+  switch (constant->value().kind()) {
+    case TypeKind::INTEGER:
+      return constant->value().value<int32_t>() == 1;
+    case TypeKind::BIGINT:
+      return constant->value().value<int64_t>() == 1;
+    default:
+      return false;
+  }
+}
+
+// Returns the name of the function that computes 'inputFunction' over all
+// elements of an array or an empty string if 'inputFunction' is not a
+// recognized sum, count, maximum or minimum.
+std::string segmentedReduceName(
+    const std::string& prefix,
+    const core::LambdaTypedExpr& inputFunction) {
+  const auto& signature = inputFunction.signature();
+  const auto& stateType = signature->childAt(0);
+  const auto& elementType = signature->childAt(1);
+  static const std::vector<TypePtr> kTypes = {
+      TINYINT(), SMALLINT(), INTEGER(), BIGINT(), REAL(), DOUBLE()};
+  if (std::none_of(kTypes.begin(), kTypes.end(), [&](const auto& type) {
+        return *type == *stateType;
+      })) {
+    return "";
+  }
+
+  auto body =
+      dynamic_cast<const core::CallTypedExpr*>(inputFunction.body().get());
+  if (body == nullptr || body->inputs().size() != 2) {
+    return "";
+  }
+  const auto& state = signature->nameOf(0);
+  const auto& element = signature->nameOf(1);
+  const auto& left = body->inputs()[0];
+  const auto& right = body->inputs()[1];
+  const bool stateAndElement = isField(left, state) &&
+      isField(right, element) && *stateType == *elementType;
+
+  if (body->name() == prefix + "plus") {
+    if (stateAndElement ||
+        (isField(left, element) && isField(right, state) &&
+         *stateType == *elementType)) {
+      return "$internal$reduce_sum";
+    }
+    if (isField(left, state) && isOne(right) &&
+        *right->type() == *stateType) {
+      return "$internal$reduce_count";
+    }
+  } else if (body->name() == prefix + "greatest" && stateAndElement) {
+    return "$internal$reduce_greatest";
+  } else if (body->name() == prefix + "least" && stateAndElement) {
+    return "$internal$reduce_least";
+  }
+  return "";
+}
 } // namespace
 
+core::TypedExprPtr rewriteReduceCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != prefix + "reduce" ||
+      call->inputs().size() != 4) {
+    return nullptr;
+  }
+
+  auto inputFunction =
+      dynamic_cast<const core::LambdaTypedExpr*>(call->inputs()[2].get());
+  auto outputFunction =
+      dynamic_cast<const core::LambdaTypedExpr*>(call->inputs()[3].get());
+  if (inputFunction == nullptr || outputFunction == nullptr ||
+      inputFunction->signature()->size() != 2 ||
+      outputFunction->signature()->size() != 1) {
+    return nullptr;
+  }
+
+  // The output function must be s -> s.
+  const auto& outputState = outputFunction->signature()->nameOf(0);
+  if (!isField(outputFunction->body(), outputState)) {
+    return nullptr;
+  }
+
+  auto name = segmentedReduceName(prefix, *inputFunction);
+  if (name.empty() || *call->type() != *call->inputs()[1]->type()) {
+    return nullptr;
+  }
+
+  return std::make_shared<core::CallTypedExpr>(
+      call->type(),
+      std::vector<core::TypedExprPtr>{call->inputs()[0], call->inputs()[1]},
+      name);
+}
+
 /// reduce is null preserving for the array. But since an
 /// expr tree with a lambda depends on all named fields, including
 /// captures, a null in a capture does not automatically make a
@@ -243,4 +530,24 @@ VELOX_DECLARE_VECTOR_FUNCTION_WITH_METADATA(
     exec::VectorFunctionMetadataBuilder().defaultNullBehavior(false).build(),
     std::make_unique<ReduceFunction>());
 
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$reduce_sum,
+    segmentedReduceSignatures(),
+    createSegmentedReduce<ReduceKind::kSum>);
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$reduce_count,
+    segmentedCountSignatures(),
+    createSegmentedReduce<ReduceKind::kCount>);
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$reduce_greatest,
+    segmentedReduceSignatures(),
+    createSegmentedReduce<ReduceKind::kGreatest>);
+
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+    udf_$internal$reduce_least,
+    segmentedReduceSignatures(),
+    createSegmentedReduce<ReduceKind::kLeast>);
+
 } // namespace facebook::velox::functions
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+
+namespace facebook::velox::functions {
+
+/// Analyzes reduce(array, initialState, inputFunction, outputFunction) call to
+/// determine whether it computes a sum, count, maximum or minimum that can be
+/// evaluated in a single pass over the elements of each array instead of
+/// invoking the input function once per element position.
+///
+/// For example, rewrites
+///     reduce(a, 0, (s, x) -> s + x, s -> s)
+/// into
+///     $internal$reduce_sum(a, 0)
+///
+/// Recognized input functions are s + x, x + s, s + 1, greatest(s, x) and
+/// least(s, x) over TINYINT, SMALLINT, INTEGER, BIGINT, REAL and DOUBLE. The
+/// output function must be s -> s.
+///
+/// Returns new expression or nullptr if rewrite is not possible.
+core::TypedExprPtr rewriteReduceCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
+} // namespace facebook::velox::functions
@@ -58,7 +58,7 @@ struct HllAccumulator {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
 
-  void mergeWith(StringView serialized, HashStringAllocator* allocator) {
+  void mergeWith(StringView serialized) {
     auto input = serialized.data();
     if (SparseHll::canDeserialize(input)) {
       if (isSparse_) {
@@ -70,8 +70,9 @@ struct HllAccumulator {
           toDense();
         }
       } else {
-        SparseHll other{input, allocator};
-        other.toDense(denseHll_);
+        // Inserts into the dense registers directly instead of deserializing
+        // 'input' into a temporary SparseHll.
+        SparseHll::toDense(input, denseHll_);
       }
     } else if (DenseHll::canDeserialize(input)) {
       if (isSparse_) {
@@ -254,7 +255,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       auto serialized = decodedHll_.valueAt<StringView>(row);
 
       auto accumulator = value<HllAccumulator>(group);
-      accumulator->mergeWith(serialized, allocator_);
+      accumulator->mergeWith(serialized);
     });
   }
 
@@ -302,7 +303,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       auto serialized = decodedHll_.valueAt<StringView>(row);
 
       auto accumulator = value<HllAccumulator>(group);
-      accumulator->mergeWith(serialized, allocator_);
+      accumulator->mergeWith(serialized);
     });
   }
 
@@ -136,6 +136,19 @@ class MaxAggregate : public MinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if constexpr (
+        std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+        sizeof(T) <= sizeof(int64_t)) {
+      if (const auto* values =
+              BaseAggregate::template flatNoNullsRange<T>(rows, args[0])) {
+        exec::Aggregate::clearNull(group);
+        updateGroup(
+            *exec::Aggregate::value<T>(group),
+            BaseAggregate::template simdMinMax<T, false>(
+                values, rows.begin(), rows.end()));
+        return;
+      }
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
@@ -231,6 +244,19 @@ class MinAggregate : public MinMaxAggregate<T> {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if constexpr (
+        std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+        sizeof(T) <= sizeof(int64_t)) {
+      if (const auto* values =
+              BaseAggregate::template flatNoNullsRange<T>(rows, args[0])) {
+        exec::Aggregate::clearNull(group);
+        updateGroup(
+            *exec::Aggregate::value<T>(group),
+            BaseAggregate::template simdMinMax<T, true>(
+                values, rows.begin(), rows.end()));
+        return;
+      }
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
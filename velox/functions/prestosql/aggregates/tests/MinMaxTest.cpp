@@ -273,6 +273,33 @@ TEST_F(MinMaxTest, maxInterval) {
   doTest(max, INTERVAL_DAY_TIME());
 }
 
+TEST_F(MinMaxTest, flatNoNulls) {
+  // Flat inputs without nulls take the single group SIMD fast path. Put the
+  // extremes in the SIMD lanes and in the remainder.
+  auto data = makeRowVector({
+      makeFlatVector<int8_t>(
+          1'003,
+          [](auto row) {
+            return row == 17 ? 127 : (row == 1'001 ? -128 : row % 100);
+          }),
+      makeFlatVector<int64_t>(
+          1'003,
+          [](auto row) {
+            return row == 1'002 ? std::numeric_limits<int64_t>::max()
+                                : (row == 33 ? -1'000'000 : row * 3);
+          }),
+  });
+  auto expected = makeRowVector({
+      makeFlatVector<int8_t>(std::vector<int8_t>{-128}),
+      makeFlatVector<int8_t>(std::vector<int8_t>{127}),
+      makeFlatVector<int64_t>(std::vector<int64_t>{-1'000'000}),
+      makeFlatVector<int64_t>(
+          std::vector<int64_t>{std::numeric_limits<int64_t>::max()}),
+  });
+  testAggregations(
+      {data}, {}, {"min(c0)", "max(c0)", "min(c1)", "max(c1)"}, {expected});
+}
+
 TEST_F(MinMaxTest, minTinyint) {
   doTest(min, TINYINT());
 }
@@ -110,6 +110,31 @@ TEST_F(SumTest, sumDoubleAndFloat) {
   }
 }
 
+TEST_F(SumTest, flatNoNulls) {
+  // Flat inputs without nulls take the single group fast path. Use a size that
+  // is not a multiple of the SIMD width.
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          1'003,
+          [](auto row) { return std::numeric_limits<int32_t>::max() - row; }),
+      makeFlatVector<int16_t>(1'003, [](auto row) { return row % 7 - 3; }),
+      makeFlatVector<double>(1'003, [](auto row) { return row * 0.25; }),
+      makeFlatVector<int64_t>(1'003, [](auto row) { return row % 5; }),
+  });
+  createDuckDbTable({data});
+
+  testAggregations(
+      {data},
+      {},
+      {"sum(c0)", "sum(c1)", "sum(c2)"},
+      "SELECT sum(c0), sum(c1), sum(c2) FROM tmp");
+  testAggregations(
+      {data},
+      {"c3"},
+      {"sum(c0)", "sum(c1)", "sum(c2)"},
+      "SELECT c3, sum(c0), sum(c1), sum(c2) FROM tmp GROUP BY c3");
+}
+
 TEST_F(SumTest, sumDecimal) {
   // Disable incremental aggregation tests because DecimalAggregate doesn't set
   // StringView::prefix when extracting accumulators, leaving the prefix field
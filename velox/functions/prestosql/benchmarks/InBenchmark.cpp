@@ -126,6 +126,16 @@ BENCHMARK_RELATIVE(in1K) {
   benchmark.run(1'000);
 }
 
+BENCHMARK(fastIn10K) {
+  InBenchmark benchmark;
+  benchmark.runFast(10'000);
+}
+
+BENCHMARK_RELATIVE(in10K) {
+  InBenchmark benchmark;
+  benchmark.run(10'000);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -146,13 +146,28 @@ simdjson::error_code SIMDJsonExtractor::extract(
  *         If any errors are encountered parsing the JSON, returns the error.
  */
 template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer);
+
+template <typename TConsumer>
 simdjson::error_code simdJsonExtract(
     const velox::StringView& json,
     SIMDJsonExtractor& extractor,
     TConsumer&& consumer) {
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, simdjsonParse(paddedJson));
+  return simdJsonExtract(jsonDoc, extractor, std::forward<TConsumer>(consumer));
+}
 
+/// Same as above for a parsed 'jsonDoc'. Several paths can be extracted from
+/// one document by rewinding it before each extraction.
+template <typename TConsumer>
+simdjson::error_code simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    SIMDJsonExtractor& extractor,
+    TConsumer&& consumer) {
   if (extractor.isRootOnlyPath()) {
     // If the path is just to return the original object, call consumer on the
     // document.  Note, we cannot convert this to a value as this is not
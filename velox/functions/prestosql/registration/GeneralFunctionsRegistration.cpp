@@ -19,6 +19,7 @@
 #include "velox/functions/prestosql/Cardinality.h"
 #include "velox/functions/prestosql/GreatestLeast.h"
 #include "velox/functions/prestosql/InPredicate.h"
+#include "velox/functions/prestosql/Reduce.h"
 
 namespace facebook::velox::functions {
 
@@ -72,6 +73,17 @@ void registerGeneralFunctions(const std::string& prefix) {
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_transform, prefix + "transform");
   VELOX_REGISTER_VECTOR_FUNCTION(udf_reduce, prefix + "reduce");
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$reduce_sum, "$internal$reduce_sum");
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$reduce_count, "$internal$reduce_count");
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$reduce_greatest, "$internal$reduce_greatest");
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_$internal$reduce_least, "$internal$reduce_least");
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteReduceCall(prefix, expr);
+  });
   VELOX_REGISTER_VECTOR_FUNCTION(udf_array_filter, prefix + "filter");
   VELOX_REGISTER_VECTOR_FUNCTION(udf_typeof, prefix + "typeof");
 
@@ -30,6 +30,19 @@ void registerJsonFunctions(const std::string& prefix) {
       {prefix + "json_extract_scalar"});
   registerFunction<JsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
+  registerFunction<
+      JsonExtractScalarsFunction,
+      Array<Varchar>,
+      Json,
+      Variadic<Varchar>>({"$internal$json_extract_scalars"});
+  registerFunction<
+      JsonExtractScalarsFunction,
+      Array<Varchar>,
+      Varchar,
+      Variadic<Varchar>>({"$internal$json_extract_scalars"});
+  exec::registerExpressionSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalars(prefix, exprs);
+  });
 
   registerFunction<JsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
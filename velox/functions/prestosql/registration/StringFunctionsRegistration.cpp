@@ -80,6 +80,11 @@ void registerSimpleFunctions(const std::string& prefix) {
 
   exec::registerStatefulVectorFunction(
       prefix + "like", likeSignatures(), makeLike);
+  exec::registerStatefulVectorFunction(
+      "$internal$like_any", likeAnySignatures(), makeLikeAny);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteLikeDisjunction(prefix + "like", "$internal$like_any", expr);
+  });
 
   registerFunction<Re2RegexpReplacePresto, Varchar, Varchar, Constant<Varchar>>(
       {prefix + "regexp_replace"});
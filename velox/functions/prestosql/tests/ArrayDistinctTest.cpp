@@ -332,6 +332,30 @@ TEST_F(ArrayDistinctTest, constant) {
   assertEqualVectors(expected, result);
 }
 
+// Arrays of up to 16 elements use a linear scan instead of a hash set. Verify
+// both paths and the transition between them.
+TEST_F(ArrayDistinctTest, smallAndLargeArrays) {
+  const vector_size_t size = 40;
+  auto array = makeArrayVector<int64_t>(
+      size, [](auto row) { return row; }, [](auto, auto i) { return i % 7; });
+  auto expected = makeArrayVector<int64_t>(
+      size,
+      [](auto row) { return std::min(row, 7); },
+      [](auto, auto i) { return i; });
+  testExpr(expected, "array_distinct(C0)", {array});
+
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto doubleArray = makeNullableArrayVector<double>({
+      {nan, 1.0, nan, std::nullopt, 1.0, -0.0, 0.0, std::nullopt},
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 1, nan, nan},
+  });
+  auto expectedDouble = makeNullableArrayVector<double>({
+      {nan, 1.0, std::nullopt, -0.0},
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, nan},
+  });
+  testExpr(expectedDouble, "array_distinct(C0)", {doubleArray});
+}
+
 TEST_F(ArrayDistinctTest, unknownType) {
   // array_distinct(ARRAY[]) -> []
   auto emptyArrayVector = makeArrayVector<UnknownValue>({{}});
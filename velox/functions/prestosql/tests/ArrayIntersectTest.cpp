@@ -316,6 +316,41 @@ TEST_F(ArrayIntersectTest, deterministic) {
   testExpr(expectedC1C0, "array_intersect(ARRAY[1,4,-2], C0)", {c0});
 }
 
+// Arrays of up to 16 elements use a linear scan instead of a hash set. Verify
+// both paths and the transition between them.
+TEST_F(ArrayIntersectTest, smallAndLargeArrays) {
+  const vector_size_t size = 40;
+  auto left = makeArrayVector<int64_t>(
+      size, [](auto row) { return row; }, [](auto, auto i) { return i % 10; });
+  auto rightSize = [](auto row) { return (row * 7) % 23; };
+  auto right = makeArrayVector<int64_t>(
+      size, rightSize, [](auto, auto i) { return 2 * (i % 5); });
+  auto expected = makeArrayVector<int64_t>(
+      size,
+      [&](auto row) {
+        const auto numLeftEven = (std::min(row, 10) + 1) / 2;
+        return std::min(numLeftEven, std::min(rightSize(row), 5));
+      },
+      [](auto, auto i) { return 2 * i; });
+  testExpr(expected, "array_intersect(C0, C1)", {left, right});
+
+  auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto doubleLeft = makeNullableArrayVector<double>({
+      {nan, 1.0, nan, std::nullopt, 2.0, std::nullopt},
+      {nan, 1.0, nan, std::nullopt, 2.0, std::nullopt},
+  });
+  auto doubleRight = makeNullableArrayVector<double>({
+      {std::nullopt, nan, 2.0},
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, nan},
+  });
+  auto expectedDouble = makeNullableArrayVector<double>({
+      {nan, std::nullopt, 2.0},
+      {nan, 1.0, 2.0},
+  });
+  testExpr(
+      expectedDouble, "array_intersect(C0, C1)", {doubleLeft, doubleRight});
+}
+
 TEST_F(ArrayIntersectTest, dictionaryEncodedElementsInConstant) {
   exec::registerVectorFunction(
       "testing_dictionary_array_elements",
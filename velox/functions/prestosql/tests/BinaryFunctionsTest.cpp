@@ -363,6 +363,12 @@ TEST_F(BinaryFunctionsTest, fromHex) {
   EXPECT_THROW(fromHex("fg"), VeloxUserError);
   EXPECT_THROW(fromHex("fff"), VeloxUserError);
 
+  auto input =
+      makeRowVector({makeFlatVector<std::string>({"61", "6g", "616", "6162"})});
+  auto expected = makeNullableFlatVector<std::string>(
+      {"a", std::nullopt, std::nullopt, "ab"}, VARBINARY());
+  assertEqualVectors(expected, evaluate("try(from_hex(c0))", input));
+
   const auto fromHexToBase64 = [&](std::optional<std::string> value) {
     return evaluateOnce<std::string>("to_base64(from_hex(c0))", value);
   };
@@ -730,6 +730,24 @@ TEST_F(DateTimeFunctionsTest, hour) {
   EXPECT_EQ(8, hour(Timestamp(998423705, 321000000)));
 }
 
+TEST_F(DateTimeFunctionsTest, hourAcrossTimeZoneTransitions) {
+  setQueryTimeZone("America/Los_Angeles");
+  // The offset of the last period is cached. Go back and forth over the
+  // transitions to and from daylight saving time in 2024.
+  auto data = makeRowVector({makeFlatVector<Timestamp>({
+      Timestamp(1710061200, 0), // 2024-03-10 09:00 UTC, 01:00 PST.
+      Timestamp(1710064800, 0), // 2024-03-10 10:00 UTC, 03:00 PDT.
+      Timestamp(1710061200, 0),
+      Timestamp(1730620800, 0), // 2024-11-03 08:00 UTC, 01:00 PDT.
+      Timestamp(1730624400, 0), // 2024-11-03 09:00 UTC, 01:00 PST.
+      Timestamp(1730628000, 0), // 2024-11-03 10:00 UTC, 02:00 PST.
+      Timestamp(1710068400, 0), // 2024-03-10 11:00 UTC, 04:00 PDT.
+  })});
+  assertEqualVectors(
+      makeFlatVector<int64_t>({1, 3, 1, 1, 1, 2, 4}),
+      evaluate("hour(c0)", data));
+}
+
 TEST_F(DateTimeFunctionsTest, hourTimestampWithTimezone) {
   EXPECT_EQ(
       20,
@@ -270,6 +270,46 @@ TEST_F(InPredicateTest, integer) {
   testConstantValues<int32_t>();
 }
 
+TEST_F(InPredicateTest, largeInList) {
+  // Sparse values that make a hash table filter. Row 'i' has 'i * 1'000' and
+  // is in the list if 'i' is a multiple of 3 below 3'000.
+  std::vector<std::optional<int64_t>> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(i * 3'000);
+  }
+  const auto inList = getInList<int64_t>(values);
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(5'003, [](auto row) { return row * 1'000; }),
+      makeFlatVector<int32_t>(5'003, [](auto row) { return row * 1'000; }),
+  });
+  auto expected = [](auto row) { return row % 3 == 0 && row < 3'000; };
+
+  for (const auto& column : {"c0", "c1"}) {
+    SCOPED_TRACE(column);
+    const auto expression = fmt::format("{} IN ({})", column, inList);
+    assertEqualVectors(
+        makeFlatVector<bool>(data->size(), expected),
+        evaluate(expression, data));
+
+    // Only selected rows are set, including the ones before the first and
+    // after the last full SIMD batch.
+    SelectivityVector rows(data->size(), false);
+    for (auto row = 3; row < data->size() - 2; row += 2) {
+      rows.setValid(row, true);
+    }
+    rows.setValidRange(100, 300, true);
+    rows.updateBounds();
+    auto result = evaluate(expression, data, rows);
+    rows.applyToSelected([&](auto row) {
+      ASSERT_FALSE(result->isNullAt(row)) << row;
+      ASSERT_EQ(
+          result->asUnchecked<SimpleVector<bool>>()->valueAt(row),
+          expected(row))
+          << row;
+    });
+  }
+}
+
 TEST_F(InPredicateTest, smallint) {
   testValues<int16_t>();
   testConstantValues<int16_t>();
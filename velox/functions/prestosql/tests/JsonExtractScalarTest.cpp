@@ -235,6 +235,45 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, sharedParse) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {R"({"a": "x", "b": 10, "c": {"d": true}})",
+       R"({"b": 20, "c": [1, 2]})",
+       R"({"a": [1], "b": 1.5, "c": {"d": null}})",
+       R"({"a": "y", "b": })",
+       "not json",
+       std::nullopt},
+      JSON())});
+  const std::vector<std::string> exprs = {
+      "json_extract_scalar(c0, '$.a')",
+      "cast(json_extract_scalar(c0, '$.b') as double) + 1",
+      "json_extract_scalar(c0, '$.c.d')",
+      "concat(json_extract_scalar(c0, '$.a'), '!')",
+  };
+
+  // The paths are extracted by one call that parses the JSON once.
+  auto exprSet = compileExpressions(exprs, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find("$internal$json_extract_scalars"),
+      std::string::npos)
+      << exprSet->toString();
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(exprs.size());
+  exprSet->eval(rows, context, results);
+  for (auto i = 0; i < exprs.size(); ++i) {
+    SCOPED_TRACE(exprs[i]);
+    velox::test::assertEqualVectors(evaluate(exprs[i], data), results[i]);
+  }
+
+  // A single path is extracted as before.
+  exprSet = compileExpressions({exprs[0]}, asRowType(data->type()));
+  ASSERT_EQ(
+      exprSet->toString().find("$internal$json_extract_scalars"),
+      std::string::npos);
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -269,3 +269,78 @@ TEST_F(ReduceTest, limit) {
       {123 * 1'000, 123 * 9'000, std::nullopt, 123 * 10, std::nullopt});
   assertEqualVectors(expected, result);
 }
+
+// Verify that sum, count, maximum and minimum input functions are evaluated in
+// a single pass over the elements and produce the same results as the lambda.
+// The output function 's -> s * 1' prevents the rewrite.
+TEST_F(ReduceTest, segmented) {
+  auto data = makeRowVector({
+      makeArrayVectorFromJson<int64_t>({
+          "[1, 2, 3]",
+          "[]",
+          "null",
+          "[4, null, 5]",
+          "[10, -20, 30, -40]",
+          "[7]",
+      }),
+      makeArrayVectorFromJson<double>({
+          "[1.5, 2.5]",
+          "[]",
+          "null",
+          "[NaN, 1.0]",
+          "[-1.0, null]",
+          "[0.1, 0.2, 0.3]",
+      }),
+      makeNullableFlatVector<int64_t>({0, 5, 1, 2, 3, std::nullopt}),
+  });
+
+  auto testReduce = [&](const std::string& expression,
+                        const std::string& internalName) {
+    SCOPED_TRACE(expression);
+    auto segmented = fmt::format(expression, "s -> s");
+    auto exprSet = compileExpression(segmented, asRowType(data->type()));
+    ASSERT_EQ(exprSet->expr(0)->name(), internalName);
+
+    auto expected = evaluate(fmt::format(expression, "s -> s * 1"), data);
+    assertEqualVectors(expected, evaluate(segmented, data));
+  };
+
+  testReduce("reduce(c0, c2, (s, x) -> s + x, {})", "$internal$reduce_sum");
+  testReduce("reduce(c0, c2, (s, x) -> x + s, {})", "$internal$reduce_sum");
+  testReduce("reduce(c0, c2, (s, x) -> s + 1, {})", "$internal$reduce_count");
+  testReduce(
+      "reduce(c0, c2, (s, x) -> greatest(s, x), {})",
+      "$internal$reduce_greatest");
+  testReduce(
+      "reduce(c0, c2, (s, x) -> least(s, x), {})", "$internal$reduce_least");
+  testReduce("reduce(c1, 0.0, (s, x) -> s + x, {})", "$internal$reduce_sum");
+  testReduce(
+      "reduce(c1, 0.0, (s, x) -> greatest(s, x), {})",
+      "$internal$reduce_greatest");
+  testReduce(
+      "reduce(c1, 0.0, (s, x) -> least(s, x), {})", "$internal$reduce_least");
+
+  // Other input functions are evaluated element by element.
+  auto exprSet = compileExpression(
+      "reduce(c0, 0, (s, x) -> s + x * 2, s -> s)", asRowType(data->type()));
+  ASSERT_EQ(exprSet->expr(0)->name(), "reduce");
+
+  // Overflow before the first null element is an error.
+  data = makeRowVector({
+      makeArrayVectorFromJson<int64_t>({
+          "[1, 2]",
+          "[9223372036854775807, 1, null]",
+          "[null, 9223372036854775807, 1]",
+      }),
+  });
+  VELOX_ASSERT_THROW(
+      evaluate("reduce(c0, 0, (s, x) -> s + x, s -> s)", data),
+      "integer overflow");
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({3, std::nullopt, std::nullopt}),
+      evaluate("try(reduce(c0, 0, (s, x) -> s + x, s -> s))", data));
+  VELOX_ASSERT_THROW(
+      evaluate(
+          "reduce(c0, 9223372036854775806, (s, x) -> s + 1, s -> s)", data),
+      "integer overflow");
+}
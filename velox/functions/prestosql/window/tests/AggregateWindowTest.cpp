@@ -175,6 +175,23 @@ TEST_F(AggregateWindowTest, rangeNullsOrder) {
       {input}, "array_agg(c0)", overClause, frameClause, expected);
 }
 
+// Tests sliding frames that are large enough to be computed with a segment
+// tree.
+TEST_F(AggregateWindowTest, largeSlidingFrames) {
+  auto input = {
+      makeSinglePartitionVector(1'000), makeSinglePartitionVector(1'500)};
+  const std::vector<std::string> frameClauses = {
+      "rows between 100 preceding and current row",
+      "rows between 300 preceding and 70 following",
+      "rows between current row and 500 following",
+      "rows between 1000 preceding and 1000 following",
+  };
+  for (const auto& function : kAggregateFunctions) {
+    WindowTestBase::testWindowFunction(
+        input, function, kOverClauses, frameClauses);
+  }
+}
+
 // Test for aggregates that return NULL as the default value for empty frames
 // against DuckDb.
 TEST_F(AggregateWindowTest, nullEmptyResult) {
@@ -36,7 +36,7 @@ struct YearFunction : public InitSessionTimezone<T> {
   FOLLY_ALWAYS_INLINE void call(
       int32_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getYear(getDateTime(timestamp, this->timeZone_));
+    result = getYear(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int32_t& result, const arg_type<Date>& date) {
@@ -90,7 +90,7 @@ struct WeekFunction : public InitSessionTimezone<T> {
   FOLLY_ALWAYS_INLINE void call(
       int32_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getWeek(getDateTime(timestamp, this->timeZone_));
+    result = getWeek(this->getDateTime(timestamp));
   }
 
   FOLLY_ALWAYS_INLINE void call(int32_t& result, const arg_type<Date>& date) {
@@ -708,7 +708,7 @@ struct HourFunction : public InitSessionTimezone<T> {
   FOLLY_ALWAYS_INLINE void call(
       int32_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_hour;
+    result = this->getDateTime(timestamp).tm_hour;
   }
 };
 
@@ -719,7 +719,7 @@ struct MinuteFunction : public InitSessionTimezone<T> {
   FOLLY_ALWAYS_INLINE void call(
       int32_t& result,
       const arg_type<Timestamp>& timestamp) {
-    result = getDateTime(timestamp, this->timeZone_).tm_min;
+    result = this->getDateTime(timestamp).tm_min;
   }
 };
 
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/sparksql/MightContain.h"
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/expression/DecodedArgs.h"
+
+namespace facebook::velox::functions::sparksql {
+namespace {
+
+class BloomFilterMightContainFunction : public exec::VectorFunction {
+ public:
+  explicit BloomFilterMightContainFunction(BloomFilter<> bloomFilter)
+      : bloomFilter_(std::move(bloomFilter)) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    context.ensureWritable(rows, outputType, result);
+    auto* flatResult = result->asUnchecked<FlatVector<bool>>();
+    if (!bloomFilter_.isSet()) {
+      rows.applyToSelected([&](auto row) { flatResult->set(row, false); });
+      return;
+    }
+
+    exec::DecodedArgs decodedArgs(rows, {args[1]}, context);
+    auto* values = decodedArgs.at(0);
+    if (values->isIdentityMapping() && rows.isAllSelected()) {
+      // Flat input without nulls. Probes a batch of hashes at a time so that
+      // the cache misses of the probes overlap.
+      auto* rawValues = values->data<int64_t>();
+      flatResult->clearNulls(rows);
+      auto* rawResult = flatResult->mutableRawValues<uint64_t>();
+      uint64_t hashes[kBatchSize];
+      for (auto begin = rows.begin(); begin < rows.end(); begin += kBatchSize) {
+        const auto numRows = std::min(kBatchSize, rows.end() - begin);
+        for (auto i = 0; i < numRows; ++i) {
+          hashes[i] = folly::hasher<int64_t>()(rawValues[begin + i]);
+        }
+        bloomFilter_.mayContain(hashes, numRows, rawResult, begin);
+      }
+      return;
+    }
+
+    rows.applyToSelected([&](auto row) {
+      flatResult->set(
+          row,
+          bloomFilter_.mayContain(
+              folly::hasher<int64_t>()(values->valueAt<int64_t>(row))));
+    });
+  }
+
+ private:
+  static constexpr vector_size_t kBatchSize = 1'024;
+
+  BloomFilter<> bloomFilter_;
+};
+
+} // namespace
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> mightContainSignatures() {
+  return {
+      exec::FunctionSignatureBuilder()
+          .returnType("boolean")
+          .argumentType("varbinary")
+          .argumentType("bigint")
+          .build(),
+  };
+}
+
+std::shared_ptr<exec::VectorFunction> makeMightContain(
+    const std::string& /*name*/,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  BloomFilter<> bloomFilter;
+  const auto& serialized = inputArgs[0].constantValue;
+  if (serialized != nullptr && !serialized->isNullAt(0)) {
+    bloomFilter.merge(serialized->as<ConstantVector<StringView>>()
+                          ->valueAt(0)
+                          .str()
+                          .c_str());
+  }
+  return std::make_shared<BloomFilterMightContainFunction>(
+      std::move(bloomFilter));
+}
+
+} // namespace facebook::velox::functions::sparksql
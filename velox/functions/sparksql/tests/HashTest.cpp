@@ -227,5 +227,48 @@ TEST_F(HashTest, row) {
   assertEqualVectors(makeFlatVector<int32_t>({42, 42}), hash(row));
 }
 
+// Flat and constant fixed-width columns are hashed a column at a time. Verify
+// that the result matches hashing the same values under a dictionary, which
+// hashes them a row at a time.
+TEST_F(HashTest, fixedWidthColumns) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int8_t>(size, [](auto row) { return row % 128; }),
+      makeFlatVector<int16_t>(
+          size, [](auto row) { return row * 7; }, nullEvery(5)),
+      makeFlatVector<int32_t>(size, [](auto row) { return row * 1'001; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row * 1'000'003; }, nullEvery(7)),
+      makeFlatVector<float>(size, [](auto row) { return row * 0.5f; }),
+      makeFlatVector<double>(size, [](auto row) { return row * -0.25; }),
+      makeConstant<int64_t>(123, size),
+  });
+  // Separate indices for each column prevent peeling of the dictionaries.
+  std::vector<VectorPtr> dictionaries;
+  for (const auto& child : data->children()) {
+    auto indices = makeIndices(size, [](auto row) { return row; });
+    dictionaries.push_back(wrapInDictionary(indices, size, child));
+  }
+  auto dictionaryData = makeRowVector(dictionaries);
+
+  for (const auto& function : {"hash", "xxhash64"}) {
+    SCOPED_TRACE(function);
+    auto expression = fmt::format("{}(c0, c1, c2, c3, c4, c5, c6)", function);
+    assertEqualVectors(
+        evaluate(expression, dictionaryData), evaluate(expression, data));
+
+    // Partial selection.
+    SelectivityVector rows(size);
+    for (auto row = 0; row < size; row += 3) {
+      rows.setValid(row, false);
+    }
+    rows.updateBounds();
+    assertEqualVectors(
+        evaluate(expression, dictionaryData, rows),
+        evaluate(expression, data, rows),
+        rows);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
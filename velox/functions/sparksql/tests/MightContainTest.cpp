@@ -84,6 +84,20 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, largeFlatInput) {
+  // Flat input without nulls is probed in batches.
+  constexpr int32_t kSize = 3'000;
+  auto serialized = getSerializedBloomFilter(kSize);
+  BloomFilter bloomFilter;
+  bloomFilter.merge(serialized.data());
+  auto value = makeFlatVector<int64_t>(
+      2 * kSize, [](vector_size_t row) { return row * 7; });
+  auto expected = makeFlatVector<bool>(2 * kSize, [&](vector_size_t row) {
+    return bloomFilter.mayContain(folly::hasher<int64_t>()(row * 7));
+  });
+  testMightContain(serialized, value, expected);
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
@@ -550,6 +550,40 @@ TEST_F(FunctionRegistryTest, resolveFunctionsBasedOnPriority) {
   ASSERT_EQ(*result5, *REAL());
 }
 
+TEST_F(FunctionRegistryTest, resolutionCache) {
+  const std::string func = "func_with_cached_resolution";
+  registerFunction<TestFunction, Varchar, Varchar, Varchar>({func});
+
+  // Registration clears the cache.
+  const auto& registry = exec::simpleFunctions();
+  ASSERT_EQ(registry.resolutionCacheSize(), 0);
+
+  auto result = registry.resolveFunction(func, {VARCHAR(), VARCHAR()});
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(*result->type(), *VARCHAR());
+  ASSERT_EQ(registry.resolutionCacheSize(), 1);
+
+  result = registry.resolveFunction(func, {VARCHAR(), VARCHAR()});
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(*result->type(), *VARCHAR());
+  ASSERT_EQ(registry.resolutionCacheSize(), 1);
+
+  // Failed resolutions are not cached.
+  ASSERT_FALSE(registry.resolveFunction(func, {BIGINT()}).has_value());
+  ASSERT_EQ(registry.resolutionCacheSize(), 1);
+
+  registerFunction<TestFunction, int32_t, Variadic<Varchar>>({func});
+  ASSERT_EQ(registry.resolutionCacheSize(), 0);
+
+  result = registry.resolveFunction(func, {VARCHAR(), VARCHAR(), VARCHAR()});
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(*result->type(), *INTEGER());
+  result = registry.resolveFunction(func, {VARCHAR(), VARCHAR()});
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(*result->type(), *VARCHAR());
+  ASSERT_EQ(registry.resolutionCacheSize(), 2);
+}
+
 TEST_F(FunctionRegistryTest, resolveSpecialForms) {
   auto andResult =
       resolveFunctionOrCallableSpecialForm("and", {BOOLEAN(), BOOLEAN()});
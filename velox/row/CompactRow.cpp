@@ -420,6 +420,53 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    char* const* buffers,
+    int32_t* rowSizes) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  std::vector<vector_size_t> childIndices(size);
+  for (auto i = 0; i < size; ++i) {
+    childIndices[i] = decoded_.index(offset + i);
+  }
+
+  // Values follow each other after the null flags. 'rowSizes' tracks the
+  // offset of the next value in each row.
+  std::fill(rowSizes, rowSizes + size, rowNullBytes_);
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (childIsFixedWidth_[i]) {
+      // Null fixed-width values take space too.
+      if (child.valueBytes_ > 0) {
+        child.serializeFixedWidthColumn(
+            childIndices.data(), size, i, rowSizes, buffers);
+        for (auto row = 0; row < size; ++row) {
+          rowSizes[row] += child.valueBytes_;
+        }
+      } else {
+        for (auto row = 0; row < size; ++row) {
+          if (child.isNullAt(childIndices[row])) {
+            bits::setBit(buffers[row], i, true);
+          }
+        }
+      }
+      continue;
+    }
+
+    for (auto row = 0; row < size; ++row) {
+      const auto childIndex = childIndices[row];
+      if (child.isNullAt(childIndex)) {
+        bits::setBit(buffers[row], i, true);
+        continue;
+      }
+      rowSizes[row] += child.serializeVariableWidth(
+          childIndex, buffers[row] + rowSizes[row]);
+    }
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -439,6 +486,67 @@ void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   }
 }
 
+void CompactRow::serializeFixedWidthColumn(
+    const vector_size_t* indices,
+    vector_size_t size,
+    int32_t field,
+    const int32_t* valueOffsets,
+    char* const* buffers) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  // Dispatches on the type once per column instead of once per value.
+  auto writeValues = [&](auto writeValue) {
+    for (auto i = 0; i < size; ++i) {
+      if (mayHaveNulls && decoded_.isNullAt(indices[i])) {
+        bits::setBit(buffers[i], field, true);
+        continue;
+      }
+      writeValue(indices[i], buffers[i] + valueOffsets[i]);
+    }
+  };
+  // Values are not aligned in the serialized rows.
+  auto writeTypedValues = [&](auto* typedNull) {
+    using T = std::remove_pointer_t<decltype(typedNull)>;
+    const auto* values = decoded_.data<T>();
+    writeValues([&](vector_size_t index, char* buffer) {
+      memcpy(buffer, &values[decoded_.index(index)], sizeof(T));
+    });
+  };
+
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      writeValues([&](vector_size_t index, char* buffer) {
+        *reinterpret_cast<bool*>(buffer) = decoded_.valueAt<bool>(index);
+      });
+      break;
+    case TypeKind::TIMESTAMP:
+      writeValues([&](vector_size_t index, char* buffer) {
+        auto micros = decoded_.valueAt<Timestamp>(index).toMicros();
+        memcpy(buffer, &micros, sizeof(int64_t));
+      });
+      break;
+    default:
+      switch (valueBytes_) {
+        case 1:
+          writeTypedValues(static_cast<int8_t*>(nullptr));
+          break;
+        case 2:
+          writeTypedValues(static_cast<int16_t*>(nullptr));
+          break;
+        case 4:
+          writeTypedValues(static_cast<int32_t*>(nullptr));
+          break;
+        case 8:
+          writeTypedValues(static_cast<int64_t*>(nullptr));
+          break;
+        default:
+          writeValues([&](vector_size_t index, char* buffer) {
+            serializeFixedWidth(index, buffer);
+          });
+      }
+  }
+}
+
 void CompactRow::serializeFixedWidth(
     vector_size_t offset,
     vector_size_t size,
@@ -36,6 +36,17 @@ class CompactRow {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes rows between 'offset' and 'offset + size' into 'buffers', one
+  /// buffer per row, and stores the number of bytes written for each row in
+  /// 'rowSizes'. Produces the same bytes as serialize(index, buffer), but
+  /// writes one column for all rows before moving to the next column. Each
+  /// buffer must have sufficient capacity and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      char* const* buffers,
+      int32_t* rowSizes);
+
   /// Deserializes multiple rows into a RowVector of specified type. The type
   /// must match the contents of the serialized rows.
   static RowVectorPtr deserialize(
@@ -64,6 +75,16 @@ class CompactRow {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes fixed-width values at 'indices' into 'buffers', one value per
+  /// buffer at 'valueOffsets'. Sets bit 'field' of the buffer for null
+  /// values.
+  void serializeFixedWidthColumn(
+      const vector_size_t* indices,
+      vector_size_t size,
+      int32_t field,
+      const int32_t* valueOffsets,
+      char* const* buffers);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
@@ -240,6 +240,32 @@ struct StructBatchIterator : UnsafeRowDataBatchIterator {
     return columnData_;
   }
 
+  /**
+   * @return true if the next element is fixed width and can be read with
+   * nextFieldOffset() instead of nextColumnBatch().
+   */
+  bool nextIsFixedWidth() const {
+    return isFixedWidth(childTypes_[idx_]) && !childTypes_[idx_]->isUnKnown();
+  }
+
+  /**
+   * Moves to the next element without materializing its column batch.
+   * @return the offset of the next element's field in each struct. A fixed
+   * width value is stored at this offset.
+   */
+  size_t nextFieldOffset() {
+    return UnsafeRow::getNullLength(numElements_) +
+        idx_++ * UnsafeRow::kFieldWidthBytes;
+  }
+
+  /**
+   * @return the serialized structs. The null bit of element i of a struct is
+   * bit i of its data.
+   */
+  const std::vector<std::optional<std::string_view>>& structs() const {
+    return data_;
+  }
+
   /**
    * @return the number of elements in the idx-th row.
    */
@@ -705,14 +731,81 @@ struct UnsafeRowDeserializer {
 
     std::vector<VectorPtr> columnVectors(numFields);
     for (size_t i = 0; i < numFields; ++i) {
+      const auto& childType = rowType.childAt(i);
+      if (StructBatchIteratorPtr->nextIsFixedWidth()) {
+        // Reads fixed width fields from the structs directly without going
+        // through a column batch and a PrimitiveBatchIterator.
+        columnVectors[i] = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+            gatherFixedWidthColumn,
+            childType->kind(),
+            StructBatchIteratorPtr->structs(),
+            i,
+            StructBatchIteratorPtr->nextFieldOffset(),
+            childType,
+            pool);
+        continue;
+      }
       columnVectors[i] = deserialize(
-          StructBatchIteratorPtr->nextColumnBatch(), rowType.childAt(i), pool);
+          StructBatchIteratorPtr->nextColumnBatch(), childType, pool);
     }
 
     return std::make_shared<RowVector>(
         pool, type, nulls, numStructs, std::move(columnVectors));
   }
 
+  /**
+   * Creates a FlatVector from a fixed width field of a batch of structs in
+   * one pass over the structs. The type dispatch happens once per column.
+   * @tparam Kind the field's type kind.
+   * @param structs the serialized structs. std::nullopt for null structs.
+   * @param field the index of the field in the structs.
+   * @param fieldOffset the offset of the field's value in each struct.
+   * @param type the field type.
+   * @param pool
+   * @return a FlatVector
+   */
+  template <TypeKind Kind>
+  static VectorPtr gatherFixedWidthColumn(
+      const std::vector<std::optional<std::string_view>>& structs,
+      size_t field,
+      size_t fieldOffset,
+      const TypePtr& type,
+      memory::MemoryPool* pool) {
+    if constexpr (!TypeTraits<Kind>::isFixedWidth) {
+      VELOX_UNREACHABLE("Unexpected variable width type: {}", type);
+    } else {
+      using T = typename TypeTraits<Kind>::NativeType;
+      using SerializedType = typename ScalarTraits<Kind>::SerializedType;
+      const auto size = structs.size();
+      auto vector = BaseVector::create<FlatVector<T>>(type, size, pool);
+      uint64_t* rawNulls = nullptr;
+      T* rawValues = nullptr;
+      if constexpr (!std::is_same_v<T, bool>) {
+        rawValues = vector->mutableRawValues();
+      }
+
+      for (size_t i = 0; i < size; ++i) {
+        if (!structs[i] || bits::isBitSet(structs[i]->data(), field)) {
+          if (rawNulls == nullptr) {
+            rawNulls = vector->mutableRawNulls();
+          }
+          bits::setNull(rawNulls, i, true);
+          continue;
+        }
+        const auto value = *reinterpret_cast<const SerializedType*>(
+            structs[i]->data() + fieldOffset);
+        if constexpr (std::is_same_v<T, bool>) {
+          vector->set(i, value);
+        } else if constexpr (std::is_same_v<T, Timestamp>) {
+          rawValues[i] = Timestamp::fromMicros(value);
+        } else {
+          rawValues[i] = value;
+        }
+      }
+      return vector;
+    }
+  }
+
   /**
    * Converts a list of PrimitiveBatchIterators to a FlatVector
    * @tparam Kind the element's type kind.
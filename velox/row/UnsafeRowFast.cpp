@@ -155,6 +155,55 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    char* const* buffers,
+    int32_t* rowSizes) {
+  VELOX_DCHECK_EQ(typeKind_, TypeKind::ROW);
+  std::vector<vector_size_t> childIndices(size);
+  for (auto i = 0; i < size; ++i) {
+    childIndices[i] = decoded_.index(offset + i);
+  }
+
+  // Variable-width values start after the null flags and the fixed-width
+  // fields. 'rowSizes' tracks the end of the variable-width section of each
+  // row.
+  std::fill(
+      rowSizes,
+      rowSizes + size,
+      rowNullBytes_ + kFieldWidth * children_.size());
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (childIsFixedWidth_[i]) {
+      child.serializeFixedWidthColumn(
+          childIndices.data(),
+          size,
+          i,
+          rowNullBytes_ + i * kFieldWidth,
+          buffers);
+      continue;
+    }
+
+    for (auto row = 0; row < size; ++row) {
+      auto* buffer = buffers[row];
+      const auto childIndex = childIndices[row];
+      if (child.isNullAt(childIndex)) {
+        bits::setBit(buffer, i, true);
+        continue;
+      }
+      const int64_t variableWidthOffset = rowSizes[row];
+      auto valueSize = child.serializeVariableWidth(
+          childIndex, buffer + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | valueSize;
+      reinterpret_cast<uint64_t*>(buffer + rowNullBytes_)[i] = sizeAndOffset;
+      rowSizes[row] += alignBytes(valueSize);
+    }
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -187,6 +236,66 @@ void UnsafeRowFast::serializeFixedWidth(
   }
 }
 
+void UnsafeRowFast::serializeFixedWidthColumn(
+    const vector_size_t* indices,
+    vector_size_t size,
+    int32_t field,
+    int32_t valueOffset,
+    char* const* buffers) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  const bool mayHaveNulls = decoded_.mayHaveNulls();
+  // Dispatches on the type once per column instead of once per value.
+  auto writeValues = [&](auto writeValue) {
+    for (auto i = 0; i < size; ++i) {
+      if (mayHaveNulls && decoded_.isNullAt(indices[i])) {
+        bits::setBit(buffers[i], field, true);
+        continue;
+      }
+      writeValue(indices[i], buffers[i] + valueOffset);
+    }
+  };
+  auto writeTypedValues = [&](auto* typedNull) {
+    using T = std::remove_pointer_t<decltype(typedNull)>;
+    const auto* values = decoded_.data<T>();
+    writeValues([&](vector_size_t index, char* buffer) {
+      *reinterpret_cast<T*>(buffer) = values[decoded_.index(index)];
+    });
+  };
+
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      writeValues([&](vector_size_t index, char* buffer) {
+        *reinterpret_cast<bool*>(buffer) = decoded_.valueAt<bool>(index);
+      });
+      break;
+    case TypeKind::TIMESTAMP:
+      writeValues([&](vector_size_t index, char* buffer) {
+        *reinterpret_cast<int64_t*>(buffer) =
+            decoded_.valueAt<Timestamp>(index).toMicros();
+      });
+      break;
+    default:
+      switch (valueBytes_) {
+        case 1:
+          writeTypedValues(static_cast<int8_t*>(nullptr));
+          break;
+        case 2:
+          writeTypedValues(static_cast<int16_t*>(nullptr));
+          break;
+        case 4:
+          writeTypedValues(static_cast<int32_t*>(nullptr));
+          break;
+        case 8:
+          writeTypedValues(static_cast<int64_t*>(nullptr));
+          break;
+        default:
+          writeValues([&](vector_size_t index, char* buffer) {
+            serializeFixedWidth(index, buffer);
+          });
+      }
+  }
+}
+
 int32_t UnsafeRowFast::serializeVariableWidth(
     vector_size_t index,
     char* buffer) {
@@ -36,6 +36,18 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Serializes rows between 'offset' and 'offset + size' into 'buffers', one
+  /// buffer per row, and stores the number of bytes written for each row in
+  /// 'rowSizes'. Produces the same bytes as serialize(index, buffer), but
+  /// writes each fixed-width column for all rows before moving to the next
+  /// column, then writes the variable-width columns. Each buffer must have
+  /// sufficient capacity and set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      char* const* buffers,
+      int32_t* rowSizes);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -57,6 +69,15 @@ class UnsafeRowFast {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes fixed-width values at 'indices' into 'buffers' at 'valueOffset',
+  /// one value per buffer. Sets bit 'field' of the buffer for null values.
+  void serializeFixedWidthColumn(
+      const vector_size_t* indices,
+      vector_size_t size,
+      int32_t field,
+      int32_t valueOffset,
+      char* const* buffers);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
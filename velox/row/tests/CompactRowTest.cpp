@@ -76,6 +76,21 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // Serializing all rows in one batch must produce the same bytes.
+    BufferPtr batchBuffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    std::vector<char*> rowBuffers;
+    offset = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      rowBuffers.push_back(batchBuffer->asMutable<char>() + offset);
+      offset += serialized[i].size();
+    }
+    std::vector<int32_t> rowSizes(numRows);
+    row.serialize(0, numRows, rowBuffers.data(), rowSizes.data());
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(rowSizes[i], serialized[i].size()) << i;
+    }
+    ASSERT_EQ(memcmp(batchBuffer->as<char>(), rawBuffer, totalSize), 0);
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
@@ -175,6 +175,21 @@ TEST_F(UnsafeRowFuzzTests, fast) {
 
       serialized.push_back(std::string_view(buffers_[i], rowSize));
     }
+
+    // Serializing all rows in one batch must produce the same bytes.
+    std::vector<std::string> batchBuffers;
+    batchBuffers.reserve(data->size());
+    std::vector<char*> rowBuffers;
+    for (auto i = 0; i < data->size(); ++i) {
+      batchBuffers.emplace_back(serialized[i]->size(), '\0');
+      rowBuffers.push_back(batchBuffers.back().data());
+    }
+    std::vector<int32_t> rowSizes(data->size());
+    fast.serialize(0, data->size(), rowBuffers.data(), rowSizes.data());
+    for (auto i = 0; i < data->size(); ++i) {
+      EXPECT_EQ(rowSizes[i], serialized[i]->size()) << i;
+      EXPECT_EQ(batchBuffers[i], serialized[i].value()) << i;
+    }
     return serialized;
   });
 }
@@ -498,8 +498,7 @@ vector_size_t readNulls(
   const auto numBytes = BaseVector::byteSize<bool>(size);
 
   source->readBytes(rawNulls, numBytes);
-  bits::reverseBits(rawNulls, numBytes);
-  bits::negate(reinterpret_cast<char*>(rawNulls), numBytes * 8);
+  bits::reverseAndNegateBits(rawNulls, numBytes);
   // Add incoming nulls if any.
   if (incomingNulls) {
     bits::scatterBits(
@@ -524,6 +523,47 @@ vector_size_t readNulls(
       nulls, resultOffset, resultOffset + numNewValues);
 }
 
+// Keeps the memory of the deserialized input alive while a Buffer refers to
+// it.
+struct InputReleaser {
+  explicit InputReleaser(std::shared_ptr<const void> inputOwner)
+      : inputOwner_(std::move(inputOwner)) {}
+  void addRef() const {}
+  void release() const {}
+
+ private:
+  std::shared_ptr<const void> inputOwner_;
+};
+
+// True if the values of T are serialized in the layout of T, so that
+// deserialized values without nulls can be used in place.
+template <typename T>
+constexpr bool kCanReadValuesInPlace =
+    (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+    std::is_floating_point_v<T> || std::is_same_v<T, int128_t>;
+
+// Returns a view over the next 'size' values of 'source' if these are
+// contiguous and aligned for T. The view keeps 'inputOwner' alive. Returns
+// nullptr and leaves 'source' unchanged otherwise.
+template <typename T>
+BufferPtr readValuesInPlace(
+    ByteInputStream* source,
+    vector_size_t size,
+    const std::shared_ptr<const void>& inputOwner) {
+  const int32_t numBytes = size * sizeof(T);
+  const auto position = source->tellp();
+  const auto view = source->nextView(numBytes);
+  if (static_cast<int32_t>(view.size()) != numBytes ||
+      reinterpret_cast<uintptr_t>(view.data()) % alignof(T) != 0) {
+    source->seekp(position);
+    return nullptr;
+  }
+  return BufferView<InputReleaser>::create(
+      reinterpret_cast<const uint8_t*>(view.data()),
+      numBytes,
+      InputReleaser(inputOwner));
+}
+
 template <typename T>
 void read(
     ByteInputStream* source,
@@ -542,6 +582,16 @@ void read(
   auto nullCount = readNulls(
       source, size, resultOffset, incomingNulls, numIncomingNulls, *flatResult);
 
+  if constexpr (kCanReadValuesInPlace<T>) {
+    if (opts.inputOwner != nullptr && resultOffset == 0 && nullCount == 0 &&
+        numNewValues == size && size > 0 && !type->isLongDecimal()) {
+      if (auto values = readValuesInPlace<T>(source, size, opts.inputOwner)) {
+        flatResult->unsafeSetValues(std::move(values));
+        return;
+      }
+    }
+  }
+
   BufferPtr values = flatResult->mutableValues(resultOffset + numNewValues);
   if constexpr (std::is_same_v<T, Timestamp>) {
     if (opts.useLosslessTimestamp) {
@@ -1118,8 +1168,7 @@ vector_size_t valueCount(
   auto rawNulls = nullsHolder.get(bits::nwords(size));
   auto numBytes = bits::nbytes(size);
   source->readBytes(rawNulls, numBytes);
-  bits::reverseBits(reinterpret_cast<uint8_t*>(rawNulls), numBytes);
-  bits::negate(reinterpret_cast<char*>(rawNulls), numBytes * 8);
+  bits::reverseAndNegateBits(reinterpret_cast<uint8_t*>(rawNulls), numBytes);
   if (copy) {
     copy->resize(bits::nwords(size));
     memcpy(copy->data(), rawNulls, numBytes);
@@ -3653,6 +3702,108 @@ FlushSizes flushStreams(
   }
 }
 
+// Compresses pages with the codec of the serializer options and stops
+// attempting compression for a number of pages each time the compression
+// ratio misses 'minCompressionRatio'. The more times compression misses the
+// target, the longer it is skipped. Shared by the iterative and batch
+// serializers so that both adapt to incompressible data.
+class PageCompressor {
+ public:
+  explicit PageCompressor(const SerdeOpts& opts)
+      : codec_(common::compressionKindToCodec(opts.compressionKind)),
+        minCompressionRatio_(opts.minCompressionRatio) {}
+
+  bool compressionEnabled() const {
+    return needCompression(*codec_);
+  }
+
+  size_t maxCompressedLength(size_t size) const {
+    return compressionEnabled() ? codec_->maxCompressedLength(size) : size;
+  }
+
+  void flush(
+      const std::vector<std::unique_ptr<VectorStream>>& streams,
+      int32_t numRows,
+      const StreamArena& arena,
+      OutputStream* out) {
+    constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
+    if (!compressionEnabled()) {
+      flushStreams(streams, numRows, arena, *codec_, minCompressionRatio_, out);
+      return;
+    }
+    if (numCompressionToSkip_ > 0) {
+      const auto noCompressionCodec = common::compressionKindToCodec(
+          common::CompressionKind::CompressionKind_NONE);
+      auto [size, ignore] =
+          flushStreams(streams, numRows, arena, *noCompressionCodec, 1, out);
+      stats_.compressionSkippedBytes += size;
+      --numCompressionToSkip_;
+      ++stats_.numCompressionSkipped;
+      return;
+    }
+    auto [size, compressedSize] = flushStreams(
+        streams, numRows, arena, *codec_, minCompressionRatio_, out);
+    stats_.compressionInputBytes += size;
+    stats_.compressedBytes += compressedSize;
+    if (compressedSize > size * minCompressionRatio_) {
+      ++stats_.numCompressionMisses;
+      numCompressionToSkip_ = std::min<int64_t>(
+          kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
+    }
+  }
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() const {
+    std::unordered_map<std::string, RuntimeCounter> map;
+    map.insert(
+        {{"compressedBytes",
+          RuntimeCounter(stats_.compressedBytes, RuntimeCounter::Unit::kBytes)},
+         {"compressionInputBytes",
+          RuntimeCounter(
+              stats_.compressionInputBytes, RuntimeCounter::Unit::kBytes)},
+         {"compressionSkippedBytes",
+          RuntimeCounter(
+              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
+    if (stats_.compressionInputBytes > 0) {
+      // Compressed size as a percentage of the input of the attempted
+      // compressions. Aggregated over serializers, min and max show the
+      // spread between destinations.
+      map.insert(
+          {"compressionRatioPct",
+           RuntimeCounter(
+               stats_.compressedBytes * 100 / stats_.compressionInputBytes)});
+      map.insert(
+          {"compressionMisses", RuntimeCounter(stats_.numCompressionMisses)});
+    }
+    return map;
+  }
+
+ private:
+  struct CompressionStats {
+    // Number of times compression was not attempted.
+    int32_t numCompressionSkipped{0};
+
+    // Number of times compression was attempted and missed the target ratio.
+    int32_t numCompressionMisses{0};
+
+    // uncompressed size for which compression was attempted.
+    int64_t compressionInputBytes{0};
+
+    // Compressed bytes.
+    int64_t compressedBytes{0};
+
+    // Bytes for which compression was not attempted because of past
+    // non-performance.
+    int64_t compressionSkippedBytes{0};
+  };
+
+  const std::unique_ptr<folly::io::Codec> codec_;
+  const float minCompressionRatio_;
+
+  // Count of forthcoming compressions to skip.
+  int32_t numCompressionToSkip_{0};
+  CompressionStats stats_;
+};
+
 template <TypeKind Kind>
 void estimateConstantSerializedSize(
     const VectorPtr& vector,
@@ -3741,9 +3892,7 @@ void estimateDictionarySerializedSize(
 class PrestoBatchVectorSerializer : public BatchVectorSerializer {
  public:
   PrestoBatchVectorSerializer(memory::MemoryPool* pool, const SerdeOpts& opts)
-      : pool_(pool),
-        codec_(common::compressionKindToCodec(opts.compressionKind)),
-        opts_(opts) {}
+      : pool_(pool), opts_(opts), compressor_(opts) {}
 
   void serialize(
       const RowVectorPtr& vector,
@@ -3770,8 +3919,11 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
       }
     }
 
-    flushStreams(
-        streams, numRows, arena, *codec_, opts_.minCompressionRatio, stream);
+    compressor_.flush(streams, numRows, arena, stream);
+  }
+
+  std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
+    return compressor_.runtimeStats();
   }
 
   void estimateSerializedSize(
@@ -3913,8 +4065,8 @@ class PrestoBatchVectorSerializer : public BatchVectorSerializer {
   }
 
   memory::MemoryPool* pool_;
-  const std::unique_ptr<folly::io::Codec> codec_;
   SerdeOpts opts_;
+  PageCompressor compressor_;
 };
 
 class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
@@ -3926,7 +4078,7 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       const SerdeOpts& opts)
       : opts_(opts),
         streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(opts.compressionKind)) {
+        compressor_(opts) {
     const auto types = rowType->children();
     const auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -3971,64 +4123,18 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
       dataSize += stream->serializedSize();
     }
 
-    auto compressedSize = needCompression(*codec_)
-        ? codec_->maxCompressedLength(dataSize)
-        : dataSize;
-    return kHeaderSize + compressedSize;
+    return kHeaderSize + compressor_.maxCompressedLength(dataSize);
   }
 
   // The SerializedPage layout is:
   // numRows(4) | codec(1) | uncompressedSize(4) | compressedSize(4) |
   // checksum(8) | data
   void flush(OutputStream* out) override {
-    constexpr int32_t kMaxCompressionAttemptsToSkip = 30;
-    if (!needCompression(*codec_)) {
-      flushStreams(
-          streams_,
-          numRows_,
-          *streamArena_,
-          *codec_,
-          opts_.minCompressionRatio,
-          out);
-    } else {
-      if (numCompressionToSkip_ > 0) {
-        const auto noCompressionCodec = common::compressionKindToCodec(
-            common::CompressionKind::CompressionKind_NONE);
-        auto [size, ignore] = flushStreams(
-            streams_, numRows_, *streamArena_, *noCompressionCodec, 1, out);
-        stats_.compressionSkippedBytes += size;
-        --numCompressionToSkip_;
-        ++stats_.numCompressionSkipped;
-      } else {
-        auto [size, compressedSize] = flushStreams(
-            streams_,
-            numRows_,
-            *streamArena_,
-            *codec_,
-            opts_.minCompressionRatio,
-            out);
-        stats_.compressionInputBytes += size;
-        stats_.compressedBytes += compressedSize;
-        if (compressedSize > size * opts_.minCompressionRatio) {
-          numCompressionToSkip_ = std::min<int64_t>(
-              kMaxCompressionAttemptsToSkip, 1 + stats_.numCompressionSkipped);
-        }
-      }
-    }
+    compressor_.flush(streams_, numRows_, *streamArena_, out);
   }
 
   std::unordered_map<std::string, RuntimeCounter> runtimeStats() override {
-    std::unordered_map<std::string, RuntimeCounter> map;
-    map.insert(
-        {{"compressedBytes",
-          RuntimeCounter(stats_.compressedBytes, RuntimeCounter::Unit::kBytes)},
-         {"compressionInputBytes",
-          RuntimeCounter(
-              stats_.compressionInputBytes, RuntimeCounter::Unit::kBytes)},
-         {"compressionSkippedBytes",
-          RuntimeCounter(
-              stats_.compressionSkippedBytes, RuntimeCounter::Unit::kBytes)}});
-    return map;
+    return compressor_.runtimeStats();
   }
 
   void clear() override {
@@ -4039,31 +4145,12 @@ class PrestoIterativeVectorSerializer : public IterativeVectorSerializer {
   }
 
  private:
-  struct CompressionStats {
-    // Number of times compression was not attempted.
-    int32_t numCompressionSkipped{0};
-
-    // uncompressed size for which compression was attempted.
-    int64_t compressionInputBytes{0};
-
-    // Compressed bytes.
-    int64_t compressedBytes{0};
-
-    // Bytes for which compression was not attempted because of past
-    // non-performance.
-    int64_t compressionSkippedBytes{0};
-  };
-
   const SerdeOpts opts_;
   StreamArena* const streamArena_;
-  const std::unique_ptr<folly::io::Codec> codec_;
+  PageCompressor compressor_;
 
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
-
-  // Count of forthcoming compressions to skip.
-  int32_t numCompressionToSkip_{0};
-  CompressionStats stats_;
 };
 } // namespace
 
@@ -4220,14 +4307,24 @@ void PrestoVectorSerde::deserialize(
     auto compressBuf = folly::IOBuf::create(header.compressedSize);
     source->readBytes(compressBuf->writableData(), header.compressedSize);
     compressBuf->append(header.compressedSize);
-    auto uncompress =
+    std::shared_ptr<folly::IOBuf> uncompress =
         codec->uncompress(compressBuf.get(), header.uncompressedSize);
     ByteRange byteRange{
         uncompress->writableData(), (int32_t)uncompress->length(), 0};
     ByteInputStream uncompressedSource({byteRange});
 
+    auto uncompressedOptions = prestoOptions;
+    if (uncompressedOptions.inputOwner != nullptr) {
+      // Values read in place refer to the uncompressed copy, not to the input.
+      uncompressedOptions.inputOwner = uncompress;
+    }
     readTopColumns(
-        uncompressedSource, type, pool, *result, resultOffset, prestoOptions);
+        uncompressedSource,
+        type,
+        pool,
+        *result,
+        resultOffset,
+        uncompressedOptions);
   }
 }
 
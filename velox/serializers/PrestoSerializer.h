@@ -72,6 +72,15 @@ class PrestoVectorSerde : public VectorSerde {
     /// than this causes subsequent compression attempts to be skipped. The more
     /// times compression misses the target the less frequently it is tried.
     float minCompressionRatio{0.8};
+
+    /// Owner of the memory the deserialized ByteInputStream reads from, e.g.
+    /// the page holding the IOBufs. If set, fixed-width columns without nulls
+    /// whose values are contiguous and aligned in that memory are deserialized
+    /// as Buffer views over it instead of being copied. The views keep a
+    /// reference to 'inputOwner', or to the uncompressed copy of a compressed
+    /// page. Applies only to columns deserialized at result offset 0. Not used
+    /// by serialization.
+    std::shared_ptr<const void> inputOwner;
   };
 
   /// Adds the serialized sizes of the rows of 'vector' in 'ranges[i]' to
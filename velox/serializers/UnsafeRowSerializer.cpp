@@ -40,19 +40,18 @@ class UnsafeRowVectorSerializer : public IterativeVectorSerializer {
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges,
       Scratch& /*scratch*/) override {
-    size_t totalSize = 0;
     row::UnsafeRowFast unsafeRow(vector);
-    if (auto fixedRowSize =
-            row::UnsafeRowFast::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
+    const auto fixedRowSize =
+        row::UnsafeRowFast::fixedRowSize(asRowType(vector->type()));
 
-    } else {
-      for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += unsafeRow.rowSize(i) + sizeof(TRowSize);
-        }
+    rowSizes_.clear();
+    size_t totalSize = 0;
+    for (const auto& range : ranges) {
+      for (auto i = range.begin; i < range.begin + range.size; ++i) {
+        rowSizes_.push_back(
+            fixedRowSize.has_value() ? fixedRowSize.value()
+                                     : unsafeRow.rowSize(i));
+        totalSize += rowSizes_.back() + sizeof(TRowSize);
       }
     }
 
@@ -64,17 +63,29 @@ class UnsafeRowVectorSerializer : public IterativeVectorSerializer {
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
+    // Rows follow each other, each preceded by its size.
+    rowBuffers_.resize(rowSizes_.size());
     size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size =
-            unsafeRow.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    for (auto i = 0; i < rowSizes_.size(); ++i) {
+      rowBuffers_[i] = rawBuffer + offset + sizeof(TRowSize);
+      offset += sizeof(TRowSize) + rowSizes_[i];
+    }
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write row data one range at a time.
+    vector_size_t numRows = 0;
+    for (const auto& range : ranges) {
+      unsafeRow.serialize(
+          range.begin,
+          range.size,
+          rowBuffers_.data() + numRows,
+          rowSizes_.data() + numRows);
+      numRows += range.size;
+    }
+
+    // Write raw sizes. Needs to be in big endian order.
+    for (auto i = 0; i < numRows; ++i) {
+      *(TRowSize*)(rowBuffers_[i] - sizeof(TRowSize)) =
+          folly::Endian::big<TRowSize>(rowSizes_[i]);
     }
   }
 
@@ -96,6 +107,10 @@ class UnsafeRowVectorSerializer : public IterativeVectorSerializer {
  private:
   memory::MemoryPool* const pool_;
   std::vector<BufferPtr> buffers_;
+
+  // Sizes and start of the rows of the last append(). Reused across calls.
+  std::vector<char*> rowBuffers_;
+  std::vector<int32_t> rowSizes_;
 };
 
 // Read from the stream until the full row is concatenated.
@@ -985,6 +985,57 @@ TEST_P(PrestoSerializerTest, multiPage) {
   }
 }
 
+TEST_P(PrestoSerializerTest, deserializeInPlace) {
+  auto data = makeRowVector({
+      makeFlatVector<int8_t>(1'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row * 3; }),
+      makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; }),
+      makeFlatVector<int32_t>(
+          1'000, [](auto row) { return row; }, nullEvery(5)),
+      makeFlatVector<std::string>(
+          1'000, [](auto row) { return std::string(row % 20, 'x'); }),
+  });
+  std::ostringstream out;
+  serialize(data, &out, nullptr);
+  serialize(data, &out, nullptr);
+  auto input = std::make_shared<std::string>(out.str());
+
+  auto rowType = asRowType(data->type());
+  auto byteStream = toByteStream(*input);
+  auto options = getParamSerdeOptions(nullptr);
+  options.inputOwner = input;
+  RowVectorPtr result;
+  serde_->deserialize(&byteStream, pool_.get(), rowType, &result, 0, &options);
+  assertEqualVectors(data, result);
+
+  // Bytes are always aligned, so the TINYINT column refers to the input. The
+  // column with nulls is copied.
+  ASSERT_TRUE(result->childAt(0)->values()->isView());
+  ASSERT_FALSE(result->childAt(3)->values()->isView());
+  if (options.compressionKind == common::CompressionKind_NONE) {
+    // Referenced by 'input', 'options' and the adopted buffers.
+    ASSERT_GT(input.use_count(), 2);
+  }
+
+  // Appending the second page copies the values read in place.
+  serde_->deserialize(
+      &byteStream, pool_.get(), rowType, &result, data->size(), &options);
+  ASSERT_TRUE(byteStream.atEnd());
+  ASSERT_EQ(result->size(), 2 * data->size());
+  for (auto i = 0; i < data->childrenSize(); ++i) {
+    ASSERT_FALSE(result->childAt(i)->values()->isView());
+  }
+  auto expected = BaseVector::create<RowVector>(
+      data->type(), 2 * data->size(), pool());
+  expected->copy(data.get(), 0, 0, data->size());
+  expected->copy(data.get(), data->size(), 0, data->size());
+  assertEqualVectors(expected, result);
+
+  result.reset();
+  options.inputOwner.reset();
+  ASSERT_EQ(input.use_count(), 1);
+}
+
 TEST_P(PrestoSerializerTest, timestampWithNanosecondPrecision) {
   // Verify that nanosecond precision is preserved when the right options are
   // passed to the serde.
@@ -1186,6 +1237,34 @@ TEST_P(PrestoSerializerTest, serializeNoRowsSelectedBatchVectorSerializer) {
   assertEqualVectors(deserialized, expected);
 }
 
+TEST_P(PrestoSerializerTest, batchVectorSerializerSkipsCompression) {
+  if (GetParam() == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  auto paramOptions = getParamSerdeOptions(nullptr);
+  // No codec achieves this ratio, so each attempt is followed by skipped
+  // pages.
+  paramOptions.minCompressionRatio = 0.0000001;
+  auto serializer = serde_->createBatchSerializer(pool_.get(), &paramOptions);
+  auto rowVector = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row % 7; })});
+  for (auto i = 0; i < 10; ++i) {
+    std::ostringstream out;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream output(&out, &listener);
+    serializer->serialize(rowVector, &output);
+    auto deserialized =
+        deserialize(asRowType(rowVector->type()), out.str(), nullptr);
+    assertEqualVectors(rowVector, deserialized);
+  }
+
+  auto stats = serializer->runtimeStats();
+  ASSERT_LT(0, stats.at("compressionInputBytes").value);
+  ASSERT_LT(0, stats.at("compressionSkippedBytes").value);
+  ASSERT_LT(0, stats.at("compressionMisses").value);
+  ASSERT_LT(0, stats.at("compressionRatioPct").value);
+}
+
 TEST_P(PrestoSerializerTest, lazy) {
   constexpr int kSize = 1000;
   auto rowVector = makeTestVector(kSize);
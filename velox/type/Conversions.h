@@ -19,6 +19,8 @@
 #include <folly/Conv.h>
 #include <folly/Expected.h>
 #include <cctype>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -80,6 +82,109 @@ Expected<T> callFollyTo(const F& v) {
   return result.value();
 }
 
+/// Returns true if the 8 bytes of 'chunk' are all ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+/// Returns the value of the 8 ASCII digits in 'chunk', loaded from memory in
+/// little endian order. Combines pairs, then quads of digits with 3
+/// multiplications instead of 8 dependent multiply-adds.
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  // 100 + (1000000 << 32).
+  constexpr uint64_t kMul1 = 0x000F424000000064;
+  // 1 + (10000 << 32).
+  constexpr uint64_t kMul2 = 0x0000271000000001;
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >>
+      32;
+}
+
+/// Parses 'v' if it is an optional '-' followed by 1 to 18 ASCII digits. Such
+/// values fit in int64_t without overflow checks. Returns false for any other
+/// input, which is then parsed by the general conversion.
+inline bool tryParseShortInteger(folly::StringPiece v, int64_t& result) {
+  const char* data = v.data();
+  const auto size = v.size();
+  size_t pos = 0;
+  const bool negative = size > 0 && data[0] == '-';
+  if (negative) {
+    pos = 1;
+  }
+  if (size == pos || size - pos > 18) {
+    return false;
+  }
+  uint64_t value = 0;
+  for (; pos + 8 <= size; pos += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, data + pos, sizeof(chunk));
+    if (!isEightDigits(chunk)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; pos < size; ++pos) {
+    const uint8_t digit = data[pos] - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  result = negative ? -static_cast<int64_t>(value) : value;
+  return true;
+}
+
+/// Parses 'v' if it is an optional '-' followed by digits with an optional
+/// '.' between digits, with at most 15 digits in total. The digits are then an
+/// exact double and dividing by an exact power of 10 rounds correctly, so the
+/// result is the same as the general conversion. Returns false for any other
+/// input.
+inline bool tryParseShortDouble(folly::StringPiece v, double& result) {
+  static constexpr double kPowersOfTen[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+      1e13, 1e14, 1e15};
+  const char* data = v.data();
+  const auto size = v.size();
+  size_t pos = 0;
+  const bool negative = size > 0 && data[0] == '-';
+  if (negative) {
+    pos = 1;
+  }
+  if (size == pos || size - pos > 16) {
+    return false;
+  }
+  uint64_t mantissa = 0;
+  int32_t numDigits = 0;
+  int32_t numFractionDigits = -1;
+  for (; pos < size; ++pos) {
+    const uint8_t digit = data[pos] - '0';
+    if (digit <= 9) {
+      mantissa = mantissa * 10 + digit;
+      ++numDigits;
+      if (numFractionDigits >= 0) {
+        ++numFractionDigits;
+      }
+    } else if (data[pos] == '.' && numDigits > 0 && numFractionDigits < 0) {
+      numFractionDigits = 0;
+    } else {
+      return false;
+    }
+  }
+  if (numDigits > 15 || numFractionDigits == 0) {
+    return false;
+  }
+  double value = static_cast<double>(mantissa);
+  if (numFractionDigits > 0) {
+    value /= kPowersOfTen[numFractionDigits];
+  }
+  result = negative ? -value : value;
+  return true;
+}
+
 } // namespace detail
 
 /// To BOOLEAN converter.
@@ -260,24 +365,22 @@ struct Converter<
     if constexpr (TPolicy::truncate) {
       return convertStringToInt(v);
     } else {
+      int64_t value;
+      if (detail::tryParseShortInteger(v, value) &&
+          value >= std::numeric_limits<T>::min() &&
+          value <= std::numeric_limits<T>::max()) {
+        return static_cast<T>(value);
+      }
       return detail::callFollyTo<T>(v);
     }
   }
 
   static Expected<T> tryCast(const StringView& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(folly::StringPiece(v));
-    } else {
-      return detail::callFollyTo<T>(folly::StringPiece(v));
-    }
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const std::string& v) {
-    if constexpr (TPolicy::truncate) {
-      return convertStringToInt(v);
-    } else {
-      return detail::callFollyTo<T>(v);
-    }
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const bool& v) {
@@ -420,15 +523,22 @@ struct Converter<
   }
 
   static Expected<T> tryCast(folly::StringPiece v) {
+    // REAL is not parsed through double to avoid double rounding.
+    if constexpr (std::is_same_v<T, double>) {
+      double value;
+      if (detail::tryParseShortDouble(v, value)) {
+        return value;
+      }
+    }
     return tryCast<folly::StringPiece>(v);
   }
 
   static Expected<T> tryCast(const StringView& v) {
-    return tryCast<folly::StringPiece>(folly::StringPiece(v));
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const std::string& v) {
-    return tryCast<std::string>(v);
+    return tryCast(folly::StringPiece(v));
   }
 
   static Expected<T> tryCast(const bool& v) {
@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +197,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -395,10 +404,8 @@ folly::dynamic BigintValuesUsingBitmask::serialize() const {
   obj["max"] = max_;
 
   folly::dynamic values = folly::dynamic::array;
-  for (size_t i = 0; i < bitmask_.size(); ++i) {
-    if (bitmask_[i]) {
-      values.push_back(i + min_);
-    }
+  for (auto value : this->values()) {
+    values.push_back(value);
   }
   obj["values"] = values;
 
@@ -422,17 +429,7 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
       min_ == otherBigintValues->min_ && max_ == otherBigintValues->max_ &&
       bitmask_.size() == otherBigintValues->bitmask_.size();
 
-  if (!res) {
-    return false;
-  }
-
-  for (size_t i = 0; i < bitmask_.size(); ++i) {
-    if (bitmask_.at(i) != otherBigintValues->bitmask_.at(i)) {
-      return false;
-    }
-  }
-
-  return true;
+  return res && bitmask_ == otherBigintValues->bitmask_;
 }
 
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
@@ -489,6 +486,46 @@ bool NegatedBigintValuesUsingBitmask::testingEquals(const Filter& other) const {
       nonNegated_->testingEquals(*(otherNegatedBigintValues->nonNegated_));
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = folly::hexlify(bits);
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  std::string bits;
+  VELOX_CHECK(folly::unhexlify(obj["bloomFilter"].asString(), bits));
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloomFilter->min_ || max_ != otherBloomFilter->max_) {
+    return false;
+  }
+  const auto& otherBits = *otherBloomFilter->bloomFilter_;
+  if (bloomFilter_->serializedSize() != otherBits.serializedSize()) {
+    return false;
+  }
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  std::string otherSerialized(otherBits.serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBits.serialize(otherSerialized.data());
+  return bits == otherSerialized;
+}
+
 template <>
 folly::dynamic FloatingPointRange<float>::serialize() const {
   auto obj = AbstractRange::serializeBase("FloatRange");
@@ -768,10 +805,10 @@ BigintValuesUsingBitmask::BigintValuesUsingBitmask(
   VELOX_CHECK(min < max, "min must be less than max");
   VELOX_CHECK(values.size() > 1, "values must contain at least 2 entries");
 
-  bitmask_.resize(max - min + 1);
+  bitmask_.resize(bits::nwords(max - min + 1));
 
   for (int64_t value : values) {
-    bitmask_[value - min] = true;
+    bits::setBit(bitmask_.data(), value - min);
   }
 }
 
@@ -779,16 +816,43 @@ bool BigintValuesUsingBitmask::testInt64(int64_t value) const {
   if (value < min_ || value > max_) {
     return false;
   }
-  return bitmask_[value - min_];
+  return isSet(value);
+}
+
+xsimd::batch_bool<int64_t> BigintValuesUsingBitmask::testValues(
+    xsimd::batch<int64_t> x) const {
+  const auto inRange = (x >= xsimd::broadcast<int64_t>(min_)) &
+      (x <= xsimd::broadcast<int64_t>(max_));
+  if (simd::toBitMask(inRange) == 0) {
+    return xsimd::batch_bool<int64_t>(false);
+  }
+  // Lanes out of range may wrap around but their words are not loaded.
+  const auto offsets = simd::reinterpretBatch<uint64_t>(
+      x - xsimd::broadcast<int64_t>(min_));
+  const auto words = simd::maskGather(
+      xsimd::broadcast<int64_t>(0),
+      inRange,
+      reinterpret_cast<const int64_t*>(bitmask_.data()),
+      simd::reinterpretBatch<int64_t>(offsets >> 6));
+  const auto bits = (simd::reinterpretBatch<uint64_t>(words) >>
+                     (offsets & xsimd::broadcast<uint64_t>(63))) &
+      xsimd::broadcast<uint64_t>(1);
+  return simd::reinterpretBatch<int64_t>(bits) != xsimd::broadcast<int64_t>(0);
+}
+
+xsimd::batch_bool<int32_t> BigintValuesUsingBitmask::testValues(
+    xsimd::batch<int32_t> x) const {
+  auto first = simd::toBitMask(testValues(simd::getHalf<int64_t, 0>(x)));
+  auto second = simd::toBitMask(testValues(simd::getHalf<int64_t, 1>(x)));
+  return simd::fromBitMask<int32_t>(
+      first | (second << xsimd::batch<int64_t>::size));
 }
 
 std::vector<int64_t> BigintValuesUsingBitmask::values() const {
   std::vector<int64_t> values;
-  for (int i = 0; i < bitmask_.size(); i++) {
-    if (bitmask_[i]) {
-      values.push_back(min_ + i);
-    }
-  }
+  bits::forEachSetBit(bitmask_.data(), 0, max_ - min_ + 1, [&](auto i) {
+    values.push_back(min_ + i);
+  });
   return values;
 }
 
@@ -1415,6 +1479,39 @@ bool BigintMultiRange::testInt64(int64_t value) const {
   return ranges_[place - 1]->testInt64(value);
 }
 
+template <typename T>
+xsimd::batch_bool<T> BigintMultiRange::testRanges(xsimd::batch<T> x) const {
+  auto result = ranges_[0]->testValues(x);
+  for (auto i = 1; i < ranges_.size(); ++i) {
+    result = result | ranges_[i]->testValues(x);
+  }
+  return result;
+}
+
+xsimd::batch_bool<int64_t> BigintMultiRange::testValues(
+    xsimd::batch<int64_t> x) const {
+  if (ranges_.size() > kMaxSimdRanges) {
+    return Filter::testValues(x);
+  }
+  return testRanges(x);
+}
+
+xsimd::batch_bool<int32_t> BigintMultiRange::testValues(
+    xsimd::batch<int32_t> x) const {
+  if (ranges_.size() > kMaxSimdRanges) {
+    return Filter::testValues(x);
+  }
+  return testRanges(x);
+}
+
+xsimd::batch_bool<int16_t> BigintMultiRange::testValues(
+    xsimd::batch<int16_t> x) const {
+  if (ranges_.size() > kMaxSimdRanges) {
+    return Filter::testValues(x);
+  }
+  return testRanges(x);
+}
+
 bool BigintMultiRange::testInt64Range(int64_t min, int64_t max, bool hasNull)
     const {
   if (hasNull && nullAllowed_) {
@@ -2133,7 +2230,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
         auto min = std::max(min_, range->lower());
         auto max = std::min(max_, range->upper());
         for (auto i = min; i <= max; ++i) {
-          if (bitmask_[i - min_] && range->testInt64(i)) {
+          if (isSet(i) && range->testInt64(i)) {
             valuesToKeep.push_back(i);
           }
         }
@@ -2160,13 +2257,78 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
 
   std::vector<int64_t> valuesToKeep;
   for (auto i = min; i <= max; ++i) {
-    if (bitmask_[i - min_] && other->testInt64(i)) {
+    if (isSet(i) && other->testInt64(i)) {
       valuesToKeep.push_back(i);
     }
   }
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min == max) {
+    return testInt64(min);
+  }
+  return !(min > max_ || max < min_);
+}
+
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  const bool bothNullAllowed = nullAllowed_ && other->testNull();
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      auto min = std::max(min_, otherRange->lower());
+      auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // The intersection of two Bloom filters cannot be represented by
+      // either, so keep the bits of 'this' and intersect the ranges.
+      auto otherBloom = static_cast<const BigintValuesUsingBloomFilter*>(other);
+      auto min = std::max(min_, otherBloom->min_);
+      auto max = std::min(max_, otherBloom->max_);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      const auto values = other->kind() ==
+              FilterKind::kBigintValuesUsingHashTable
+          ? static_cast<const BigintValuesUsingHashTable*>(other)->values()
+          : static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      std::vector<int64_t> valuesToKeep;
+      valuesToKeep.reserve(values.size());
+      for (auto value : values) {
+        if (testInt64(value)) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      return createBigintValues(valuesToKeep, bothNullAllowed);
+    }
+    default:
+      return other->clone(bothNullAllowed);
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1075,6 +1078,14 @@ class BigintValuesUsingBitmask final : public Filter {
 
   bool testInt64(int64_t value) const final;
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return Filter::testValues(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1085,7 +1096,13 @@ class BigintValuesUsingBitmask final : public Filter {
   std::unique_ptr<Filter>
   mergeWith(int64_t min, int64_t max, const Filter* other) const;
 
-  std::vector<bool> bitmask_;
+  bool isSet(int64_t value) const {
+    return bits::isBitSet(bitmask_.data(), value - min_);
+  }
+
+  // Bit 'value - min_' is set for each passing value. Stored as words so
+  // that testValues() can gather the bits of a batch.
+  std::vector<uint64_t> bitmask_;
   const int64_t min_;
   const int64_t max_;
 };
@@ -1212,6 +1229,18 @@ class NegatedBigintValuesUsingBitmask final : public Filter {
     return !nonNegated_->testInt64(value);
   }
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1227,6 +1256,99 @@ class NegatedBigintValuesUsingBitmask final : public Filter {
   std::unique_ptr<BigintValuesUsingBitmask> nonNegated_;
 };
 
+/// IN-list filter for integral data types backed by a Bloom filter. Used for
+/// runtime join filters where the build side has too many distinct keys for
+/// an exact IN-list. May pass values that are not in the list (false
+/// positives), so the consumer must still verify the matches, e.g. by probing
+/// the hash table. Values outside of [min, max] are rejected exactly.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter over hashValue() of the values that
+  /// pass the filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(min),
+        max_(max),
+        bloomFilter_(std::move(bloomFilter)) {
+    VELOX_CHECK_LE(min_, max_);
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+    VELOX_CHECK(bloomFilter_->isSet());
+  }
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  /// Returns the hash of 'value' to insert into the Bloom filter passed to
+  /// the constructor.
+  static uint64_t hashValue(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BigintValuesUsingBloomFilter>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  bool testInt64(int64_t value) const final {
+    if (value < min_ || value > max_) {
+      return false;
+    }
+    return bloomFilter_->mayContain(hashValue(value));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  /// Combines 'this' with 'other'. Filters that can be applied exactly, like
+  /// ranges and IN-lists, are narrowed or filtered through the Bloom filter.
+  /// If 'other' cannot be combined, the result is 'other' alone. This passes
+  /// a superset of the values passing both filters, which is consistent with
+  /// the false positives allowed by this filter.
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {} bytes {}",
+        min_,
+        max_,
+        bloomFilter_->serializedSize(),
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  // Shared between the clones of 'this', e.g. when a runtime join filter is
+  // pushed into the scans of many drivers.
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 /// Base class for range filters on floating point and string data types.
 class AbstractRange : public Filter {
  public:
@@ -1898,8 +2020,9 @@ class BytesValues final : public Filter {
   }
 
   bool testBytes(const char* value, int32_t length) const final {
+    // Looks up a string_view to avoid copying 'value' into a std::string.
     return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+        values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -1945,6 +2068,12 @@ class BigintMultiRange final : public Filter {
 
   bool testInt64(int64_t value) const final;
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t>) const final;
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1966,6 +2095,14 @@ class BigintMultiRange final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Above this many ranges, testValues() tests each lane with a binary search
+  // instead of testing all ranges on the whole batch.
+  static constexpr int32_t kMaxSimdRanges = 8;
+
+  // Returns the lanes of 'x' that are in any of 'ranges_'.
+  template <typename T>
+  xsimd::batch_bool<T> testRanges(xsimd::batch<T> x) const;
+
   const std::vector<std::unique_ptr<BigintRange>> ranges_;
   std::vector<int64_t> lowerBounds_;
 };
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -153,6 +154,27 @@ struct StringView {
     return !(*this == other);
   }
 
+  /// Returns true if 'this' and 'other' have the same size and first
+  /// kPrefixSize bytes. Only reads the inline part, so it can be used as a
+  /// first check on strings whose data is not contiguous, e.g. strings in a
+  /// RowContainer.
+  bool sizeAndPrefixEquals(const StringView& other) const {
+    return sizeAndPrefixAsInt64() == other.sizeAndPrefixAsInt64();
+  }
+
+  /// Returns the result of compare() if it is decided by the first
+  /// kPrefixSize bytes and the sizes, std::nullopt otherwise. Only reads the
+  /// inline part like sizeAndPrefixEquals().
+  std::optional<int32_t> comparePrefix(const StringView& other) const {
+    if (prefixAsInt() != other.prefixAsInt()) {
+      return memcmp(prefix_, other.prefix_, kPrefixSize);
+    }
+    if (std::min(size_, other.size_) <= kPrefixSize) {
+      return static_cast<int32_t>(size_ - other.size_);
+    }
+    return std::nullopt;
+  }
+
   // Returns 0, if this == other
   //       < 0, if this < other
   //       > 0, if this > other
@@ -739,12 +739,87 @@ Status parserError(const char* str, size_t len) {
       std::string(str, len));
 }
 
+// Returns the value of the 2 ASCII digits at 'buf' or -1 if these are not
+// digits.
+inline int32_t parseTwoDigits(const char* buf) {
+  const uint8_t high = buf[0] - '0';
+  const uint8_t low = buf[1] - '0';
+  return high <= 9 && low <= 9 ? high * 10 + low : -1;
+}
+
+// Parses the fixed width forms 'YYYY-MM-DD' and 'YYYY-MM-DD hh:mm:ss' with an
+// optional fraction of 1 to 9 digits, which are most timestamps in text data.
+// All fields are at known offsets, so this avoids the per-character branches
+// of tryParseTimestampString(). Returns false for any other input, which is
+// then handled by tryParseTimestampString() with the same result for valid
+// input.
+bool tryParseFixedWidthTimestamp(
+    const char* buf,
+    size_t len,
+    Timestamp& result) {
+  if ((len != 10 && len < 19) || len == 20 || len > 29) {
+    return false;
+  }
+  if (buf[4] != '-' || buf[7] != '-') {
+    return false;
+  }
+  const auto century = parseTwoDigits(buf);
+  const auto yearOfCentury = parseTwoDigits(buf + 2);
+  const auto month = parseTwoDigits(buf + 5);
+  const auto day = parseTwoDigits(buf + 8);
+  if (century < 0 || yearOfCentury < 0 ||
+      !isValidDate(century * 100 + yearOfCentury, month, day)) {
+    return false;
+  }
+  int64_t daysSinceEpoch;
+  if (!daysSinceEpochFromDate(
+           century * 100 + yearOfCentury, month, day, daysSinceEpoch)
+           .ok()) {
+    return false;
+  }
+  if (len == 10) {
+    result = fromDatetime(daysSinceEpoch, 0);
+    return true;
+  }
+
+  if ((buf[10] != ' ' && buf[10] != 'T') || buf[13] != ':' ||
+      buf[16] != ':') {
+    return false;
+  }
+  const auto hour = parseTwoDigits(buf + 11);
+  const auto minute = parseTwoDigits(buf + 14);
+  const auto second = parseTwoDigits(buf + 17);
+  if (hour < 0 || hour >= 24 || minute < 0 || minute >= 60 || second < 0 ||
+      second > 60) {
+    return false;
+  }
+  int32_t micros = 0;
+  if (len > 19) {
+    if (buf[19] != '.') {
+      return false;
+    }
+    int32_t multiplier = 100000;
+    for (size_t pos = 20; pos < len; ++pos, multiplier /= 10) {
+      const uint8_t digit = buf[pos] - '0';
+      if (digit > 9) {
+        return false;
+      }
+      micros += digit * multiplier;
+    }
+  }
+  result = fromDatetime(daysSinceEpoch, fromTime(hour, minute, second, micros));
+  return true;
+}
+
 } // namespace
 
 Expected<Timestamp> fromTimestampString(const char* str, size_t len) {
   size_t pos;
   Timestamp resultTimestamp;
 
+  if (tryParseFixedWidthTimestamp(str, len, resultTimestamp)) {
+    return resultTimestamp;
+  }
   if (!tryParseTimestampString(str, len, pos, resultTimestamp)) {
     return folly::makeUnexpected(parserError(str, len));
   }
@@ -764,6 +839,9 @@ Expected<std::pair<Timestamp, int64_t>> fromTimestampWithTimezoneString(
   size_t pos;
   Timestamp resultTimestamp;
 
+  if (tryParseFixedWidthTimestamp(str, len, resultTimestamp)) {
+    return std::pair<Timestamp, int64_t>(resultTimestamp, -1);
+  }
   if (!tryParseTimestampString(str, len, pos, resultTimestamp)) {
     return folly::makeUnexpected(parserError(str, len));
   }
@@ -588,6 +588,48 @@ TEST_F(ConversionsTest, toIntegeralTypes) {
   }
 }
 
+TEST_F(ConversionsTest, shortNumbersFromString) {
+  int64_t intValue;
+  EXPECT_TRUE(detail::tryParseShortInteger("0", intValue));
+  EXPECT_EQ(intValue, 0);
+  EXPECT_TRUE(detail::tryParseShortInteger("-1234567890", intValue));
+  EXPECT_EQ(intValue, -1234567890);
+  EXPECT_TRUE(detail::tryParseShortInteger("999999999999999999", intValue));
+  EXPECT_EQ(intValue, 999'999'999'999'999'999);
+  EXPECT_FALSE(detail::tryParseShortInteger("", intValue));
+  EXPECT_FALSE(detail::tryParseShortInteger("-", intValue));
+  EXPECT_FALSE(detail::tryParseShortInteger("1234567a", intValue));
+  EXPECT_FALSE(detail::tryParseShortInteger("12345678:", intValue));
+  EXPECT_FALSE(detail::tryParseShortInteger("+1", intValue));
+  EXPECT_FALSE(detail::tryParseShortInteger("1000000000000000000", intValue));
+
+  double doubleValue;
+  EXPECT_TRUE(detail::tryParseShortDouble("-12.5", doubleValue));
+  EXPECT_EQ(doubleValue, -12.5);
+  EXPECT_TRUE(detail::tryParseShortDouble("0.1", doubleValue));
+  EXPECT_EQ(doubleValue, 0.1);
+  EXPECT_TRUE(detail::tryParseShortDouble("12345.6789012345", doubleValue));
+  EXPECT_EQ(doubleValue, 12345.6789012345);
+  EXPECT_FALSE(detail::tryParseShortDouble("1.", doubleValue));
+  EXPECT_FALSE(detail::tryParseShortDouble(".5", doubleValue));
+  EXPECT_FALSE(detail::tryParseShortDouble("1e5", doubleValue));
+  EXPECT_FALSE(detail::tryParseShortDouble("1.2.3", doubleValue));
+  EXPECT_FALSE(detail::tryParseShortDouble("1234567890.1234567", doubleValue));
+
+  // Values outside of the target type fall back to the general conversion.
+  testConversion<std::string, int8_t>(
+      {"127", "-128", "0012"}, {127, -128, 12});
+  testConversion<std::string, int8_t>(
+      {"128", "-129"}, {}, false, false, /*expectError*/ true);
+  testConversion<std::string, int64_t>(
+      {"9223372036854775807", "-9223372036854775808"},
+      {std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()});
+  testConversion<std::string, double>(
+      {"1.5", "-0.25", "1e3", "12345678901234567"},
+      {1.5, -0.25, 1000.0, 12345678901234567.0});
+}
+
 TEST_F(ConversionsTest, toString) {
   // From integral types.
   {
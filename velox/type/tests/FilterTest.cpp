@@ -452,6 +452,116 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(11, 11, false));
   EXPECT_FALSE(filter->testInt64Range(-10, -5, false));
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
+
+  auto testInt64 = [&](int64_t x) { return filter->testInt64(x); };
+  int64_t n4[] = {1, 2, 1000, INT64_MIN};
+  checkSimd(filter.get(), n4, testInt64);
+  int64_t outOfRange[] = {-1, 1001, INT64_MAX, 0};
+  checkSimd(filter.get(), outOfRange, testInt64);
+  int32_t n8[] = {100, 99, 64, 1000, -1000, 10, 0, 1001};
+  checkSimd(filter.get(), n8, testInt64);
+  int16_t n16[] = {
+      2, 1, 1000, -1000, 1, 10, 0, 1111, 2, 1, 999, 100, 1, 1, 0, 63};
+  checkSimd(filter.get(), n16, testInt64);
+
+  auto negated =
+      createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
+  ASSERT_TRUE(dynamic_cast<NegatedBigintValuesUsingBitmask*>(negated.get()));
+  auto testNegated = [&](int64_t x) { return negated->testInt64(x); };
+  checkSimd(negated.get(), n4, testNegated);
+  checkSimd(negated.get(), outOfRange, testNegated);
+  checkSimd(negated.get(), n8, testNegated);
+  checkSimd(negated.get(), n16, testNegated);
+}
+
+namespace {
+std::unique_ptr<BigintValuesUsingBloomFilter> makeBloomFilter(
+    const std::vector<int64_t>& values,
+    bool nullAllowed) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(values.size());
+  for (auto value : values) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hashValue(value));
+  }
+  const auto [min, max] = std::minmax_element(values.begin(), values.end());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      *min, *max, std::move(bloomFilter), nullAllowed);
+}
+} // namespace
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(i * 1'000'003L);
+  }
+  auto filter = makeBloomFilter(values, false);
+  for (auto value : values) {
+    ASSERT_TRUE(filter->testInt64(value));
+    ASSERT_TRUE(filter->testInt64Range(value, value, false));
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-1));
+  EXPECT_FALSE(filter->testInt64(values.back() + 1));
+
+  // Values not in the list are mostly rejected.
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 10'000; ++i) {
+    numFalsePositives += filter->testInt64(i * 1'000'003L + 1);
+  }
+  EXPECT_LT(numFalsePositives, 500);
+
+  EXPECT_TRUE(filter->testInt64Range(-100, 100, false));
+  EXPECT_FALSE(filter->testInt64Range(-100, -1, false));
+  EXPECT_FALSE(filter->testInt64Range(
+      values.back() + 1, std::numeric_limits<int64_t>::max(), false));
+  EXPECT_FALSE(filter->testInt64Range(-100, -1, true));
+  EXPECT_TRUE(makeBloomFilter(values, true)->testInt64Range(-100, -1, true));
+
+  auto clone = filter->clone(true);
+  EXPECT_TRUE(clone->testNull());
+  EXPECT_TRUE(clone->testInt64(values[10]));
+}
+
+TEST(FilterTest, mergeWithBigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(i * 7);
+  }
+  auto bloomFilter = makeBloomFilter(values, false);
+
+  // Range narrows the bounds of the Bloom filter.
+  BigintRange range(100, 200, false);
+  auto merged = bloomFilter->mergeWith(&range);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(105));
+  EXPECT_FALSE(merged->testInt64(98));
+  EXPECT_FALSE(merged->testInt64(203));
+
+  BigintRange disjointRange(-100, -1, false);
+  EXPECT_EQ(
+      bloomFilter->mergeWith(&disjointRange)->kind(),
+      FilterKind::kAlwaysFalse);
+
+  // IN-list becomes an exact IN-list.
+  auto inList = createBigintValues({7, 14, 15, 10'000}, false);
+  merged = bloomFilter->mergeWith(inList.get());
+  ASSERT_NE(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(7));
+  EXPECT_TRUE(merged->testInt64(14));
+  EXPECT_FALSE(merged->testInt64(10'000));
+
+  // Is not null drops the nulls.
+  auto nullableBloomFilter = makeBloomFilter(values, true);
+  IsNotNull isNotNull;
+  merged = nullableBloomFilter->mergeWith(&isNotNull);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_FALSE(merged->testNull());
+
+  // Filters that cannot be combined with the Bloom filter are kept as is.
+  NegatedBigintRange negatedRange(0, 10, false);
+  merged = bloomFilter->mergeWith(&negatedRange);
+  ASSERT_EQ(merged->kind(), FilterKind::kNegatedBigintRange);
+  EXPECT_FALSE(merged->testInt64(7));
 }
 
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
@@ -590,6 +700,15 @@ TEST(FilterTest, bigintMultiRange) {
   EXPECT_TRUE(filter->testInt64Range(105, 115, true));
   EXPECT_FALSE(filter->testInt64Range(15, 45, false));
   EXPECT_FALSE(filter->testInt64Range(15, 45, true));
+
+  auto testInt64 = [&](int64_t x) { return filter->testInt64(x); };
+  int64_t n4[] = {1, 50, 120, 121};
+  checkSimd(filter.get(), n4, testInt64);
+  int32_t n8[] = {0, 1, 10, 11, 99, 100, 120, -5};
+  checkSimd(filter.get(), n8, testInt64);
+  int16_t n16[] = {
+      0, 1, 10, 11, 99, 100, 120, -5, 5, 110, 200, 1, 2, 3, 121, 119};
+  checkSimd(filter.get(), n16, testInt64);
 }
 
 TEST(FilterTest, boolValue) {
@@ -58,6 +58,43 @@ TEST(StringView, comparison) {
       StringView("in hoc signo vinces, Constantinus"));
 }
 
+TEST(StringView, comparePrefix) {
+  auto sign = [](int32_t value) { return (value > 0) - (value < 0); };
+  std::vector<std::string> values = {
+      "",
+      "a",
+      "abc",
+      "abcd",
+      "abce",
+      "abcde",
+      "abcdefghijklmnop",
+      "abcdefghijklmnoq",
+      "abcdefghijklmnopq",
+      "b",
+      "bcdefghijklmnopqrstuv",
+  };
+  for (const auto& left : values) {
+    for (const auto& right : values) {
+      SCOPED_TRACE(fmt::format("{} vs. {}", left, right));
+      StringView leftView(left);
+      StringView rightView(right);
+      const auto expected = sign(leftView.compare(rightView));
+      if (auto result = leftView.comparePrefix(rightView)) {
+        EXPECT_EQ(expected, sign(result.value()));
+      } else {
+        // Only undecided if both extend past the prefix with the same prefix.
+        EXPECT_GT(left.size(), StringView::kPrefixSize);
+        EXPECT_GT(right.size(), StringView::kPrefixSize);
+        EXPECT_EQ(left.substr(0, 4), right.substr(0, 4));
+      }
+      const bool samePrefix = left.substr(0, 4) == right.substr(0, 4);
+      EXPECT_EQ(
+          left.size() == right.size() && samePrefix,
+          leftView.sizeAndPrefixEquals(rightView));
+    }
+  }
+}
+
 TEST(StringView, container) {
   std::vector<std::string> strings = {
       "May",
@@ -300,6 +300,30 @@ TEST(DateTimeUtilTest, fromTimestampString) {
   EXPECT_EQ(Timestamp(946729316, 0), parseTimestamp("2000-01-01T 12:21:56"));
 }
 
+TEST(DateTimeUtilTest, fromFixedWidthTimestampString) {
+  EXPECT_EQ(
+      Timestamp(946729316, 100'000'000),
+      parseTimestamp("2000-01-01 12:21:56.1"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'000'000),
+      parseTimestamp("2000-01-01 12:21:56.123"));
+  EXPECT_EQ(
+      Timestamp(946729316, 123'456'000),
+      parseTimestamp("2000-01-01T12:21:56.123456789"));
+  EXPECT_EQ(Timestamp(951782400, 0), parseTimestamp("2000-02-29"));
+  EXPECT_EQ(
+      std::make_pair(Timestamp(946729316, 0), int64_t(-1)),
+      parseTimestampWithTimezone("2000-01-01 12:21:56"));
+
+  const std::string_view parserError = "Unable to parse timestamp value: ";
+  VELOX_ASSERT_THROW(parseTimestamp("2001-02-29"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-13-01"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 24:00:00"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 12:60:00"), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 12:21:56."), parserError);
+  VELOX_ASSERT_THROW(parseTimestamp("2000-01-01 12:21:56.1x"), parserError);
+}
+
 TEST(DateTimeUtilTest, fromTimestampStringInvalid) {
   const std::string_view parserError = "Unable to parse timestamp value: ";
   const std::string_view overflowError = "integer overflow: ";
@@ -587,10 +587,65 @@ void ArrayVectorBase::copyRangesImpl(
           }
         });
     outRanges.reserve(totalCount);
-    applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
-      if (source->isNullAt(sourceIndex)) {
-        setNull(targetIndex, true);
+
+    // Appends a range of children to copy. If we're copying two adjacent
+    // ranges, merge them. This only works if they're consecutive.
+    auto addChildRange = [&](vector_size_t copyOffset, vector_size_t copySize) {
+      if (!outRanges.empty() &&
+          (outRanges.back().sourceIndex + outRanges.back().count ==
+           copyOffset)) {
+        outRanges.back().count += copySize;
       } else {
+        outRanges.push_back({copyOffset, childSize, copySize});
+      }
+    };
+
+    // A flat source without nulls whose rows have contiguous children is
+    // copied one range at a time: the children are one range and the offsets
+    // are shifted without looking at each row.
+    const bool flatNoNulls = source == leafSource && !source->mayHaveNulls();
+    const auto* sourceOffsets = sourceArray->rawOffsets();
+    const auto* sourceSizes = sourceArray->rawSizes();
+    for (const auto& range : ranges) {
+      if (range.count == 0) {
+        continue;
+      }
+      if (flatNoNulls && range.count > 1 &&
+          sourceArray->hasContiguousRanges(
+              range.sourceIndex, range.sourceIndex + range.count)) {
+        if (setNotNulls) {
+          bits::fillBits(
+              mutableRawNulls(),
+              range.targetIndex,
+              range.targetIndex + range.count,
+              bits::kNotNull);
+        }
+        const auto lastIndex = range.sourceIndex + range.count - 1;
+        const auto copyOffset = sourceOffsets[range.sourceIndex];
+        const auto copySize =
+            sourceOffsets[lastIndex] + sourceSizes[lastIndex] - copyOffset;
+        const auto delta = childSize - copyOffset;
+        for (auto i = 0; i < range.count; ++i) {
+          mutableOffsets[range.targetIndex + i] =
+              sourceOffsets[range.sourceIndex + i] + delta;
+        }
+        std::memcpy(
+            mutableSizes + range.targetIndex,
+            sourceSizes + range.sourceIndex,
+            range.count * sizeof(vector_size_t));
+        if (copySize > 0) {
+          addChildRange(copyOffset, copySize);
+        }
+        childSize += copySize;
+        continue;
+      }
+      for (auto i = 0; i < range.count; ++i) {
+        const auto targetIndex = range.targetIndex + i;
+        const auto sourceIndex = range.sourceIndex + i;
+        if (source->isNullAt(sourceIndex)) {
+          setNull(targetIndex, true);
+          continue;
+        }
         if (setNotNulls) {
           setNull(targetIndex, false);
         }
@@ -598,24 +653,14 @@ void ArrayVectorBase::copyRangesImpl(
         auto copySize = sourceArray->sizeAt(wrappedIndex);
 
         if (copySize > 0) {
-          auto copyOffset = sourceArray->offsetAt(wrappedIndex);
-
-          // If we're copying two adjacent ranges, merge them.  This only
-          // works if they're consecutive.
-          if (!outRanges.empty() &&
-              (outRanges.back().sourceIndex + outRanges.back().count ==
-               copyOffset)) {
-            outRanges.back().count += copySize;
-          } else {
-            outRanges.push_back({copyOffset, childSize, copySize});
-          }
+          addChildRange(sourceArray->offsetAt(wrappedIndex), copySize);
         }
 
         mutableOffsets[targetIndex] = childSize;
         mutableSizes[targetIndex] = copySize;
         childSize += copySize;
       }
-    });
+    }
 
     targetValues->get()->resize(childSize);
     targetValues->get()->copyRanges(sourceValues, outRanges);
@@ -355,6 +355,19 @@ struct ArrayVectorBase : BaseVector {
   /// size] ranges. Throws in case overlaps are found.
   void checkRanges() const;
 
+  /// Returns true if the ranges of rows in [begin, end) follow each other in
+  /// the child vector without gaps, i.e. the offsets are Arrow style with the
+  /// offset of each row being the end of the previous row. Such rows can be
+  /// copied or exported as one range of children.
+  bool hasContiguousRanges(vector_size_t begin, vector_size_t end) const {
+    for (auto i = begin + 1; i < end; ++i) {
+      if (rawOffsets_[i - 1] + rawSizes_[i - 1] != rawOffsets_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
  protected:
   ArrayVectorBase(
       velox::memory::MemoryPool* pool,
@@ -16,6 +16,7 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/LazyVector.h"
 
@@ -31,6 +32,22 @@ std::vector<vector_size_t> makeConsecutiveIndices(size_t size) {
   }
   return consecutiveIndices;
 }
+
+// Sets 'runs[i]' to the index of the run of 'sequence' that covers row 'i' for
+// the first 'size' rows.
+void expandRunLengths(
+    const BaseVector& sequence,
+    vector_size_t size,
+    vector_size_t* runs) {
+  const auto* lengths = sequence.wrapInfo()->as<vector_size_t>();
+  const auto numRuns = sequence.valueVector()->size();
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; run < numRuns && row < size; ++run) {
+    const auto end = std::min(size, row + lengths[run]);
+    std::fill(runs + row, runs + end, run);
+    row = end;
+  }
+}
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -147,6 +164,13 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // A sequence is a dictionary without nulls whose indices are given as run
+    // lengths.
+    copiedIndices_.resize(size_ > 0 ? size_ : 1);
+    expandRunLengths(*vector, size_, copiedIndices_.data());
+    indices_ = copiedIndices_.data();
+    values = vector->valueVector().get();
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -181,6 +205,11 @@ void DecodedVector::combineWrappers(
         values = values->valueVector().get();
         break;
       }
+      case VectorEncoding::Simple::SEQUENCE: {
+        applySequenceWrapper(*values, rows);
+        values = values->valueVector().get();
+        break;
+      }
       default:
         VELOX_CHECK(false, "Unsupported vector encoding");
     }
@@ -197,6 +226,11 @@ void DecodedVector::applyDictionaryWrapper(
 
   auto newIndices = dictionaryVector.wrapInfo()->as<vector_size_t>();
   auto newNulls = dictionaryVector.rawNulls();
+  if (!nulls_ &&
+      (!rows || (rows->begin() == 0 && rows->isAllSelected()))) {
+    applyDictionaryWrapperDense(newIndices, newNulls);
+    return;
+  }
   if (newNulls) {
     hasExtraNulls_ = true;
     mayHaveNulls_ = true;
@@ -226,6 +260,58 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+void DecodedVector::applyDictionaryWrapperDense(
+    const vector_size_t* newIndices,
+    const uint64_t* newNulls) {
+  // The SIMD gathers may read past the end of the indices. Pad the copy so
+  // that these reads stay inside the allocation.
+  constexpr int32_t kPadding = xsimd::batch<vector_size_t>::size;
+  const vector_size_t* currentIndices;
+  if (indicesNotCopied()) {
+    currentIndices = indices_;
+    copiedIndices_.reserve(size_ + kPadding);
+    copiedIndices_.resize(size_);
+  } else {
+    copiedIndices_.reserve(size_ + kPadding);
+    currentIndices = copiedIndices_.data();
+  }
+  indices_ = copiedIndices_.data();
+
+  const folly::Range<const vector_size_t*> indexRange(currentIndices, size_);
+  if (newNulls) {
+    hasExtraNulls_ = true;
+    mayHaveNulls_ = true;
+    copiedNulls_.resize(std::max<size_t>(bits::nwords(size_), 1));
+    simd::gatherBits(newNulls, indexRange, copiedNulls_.data());
+    nulls_ = copiedNulls_.data();
+  }
+  simd::transpose(newIndices, indexRange, copiedIndices_.data());
+  if (newNulls) {
+    // The indices of null positions of the dictionary may be out of range.
+    bits::forEachUnsetBit(nulls_, 0, size_, [&](vector_size_t row) {
+      copiedIndices_[row] = 0;
+    });
+  }
+}
+
+void DecodedVector::applySequenceWrapper(
+    const BaseVector& sequenceVector,
+    const SelectivityVector* rows) {
+  if (size_ == 0 || (rows && !rows->hasSelections())) {
+    // No further processing is needed.
+    return;
+  }
+
+  std::vector<vector_size_t> runs(sequenceVector.size());
+  expandRunLengths(sequenceVector, runs.size(), runs.data());
+  makeIndicesMutable();
+  applyToRows(rows, [&](vector_size_t row) {
+    if (!nulls_ || !bits::isBitNull(nulls_, row)) {
+      copiedIndices_[row] = runs[copiedIndices_[row]];
+    }
+  });
+}
+
 void DecodedVector::fillInIndices() {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
@@ -339,6 +339,18 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  // Fast path of applyDictionaryWrapper() for when all rows are selected and
+  // there are no nulls from the previous wrappers. Composes the indices and
+  // gathers the nulls with SIMD.
+  void applyDictionaryWrapperDense(
+      const vector_size_t* newIndices,
+      const uint64_t* newNulls);
+
+  // Maps the indices of 'rows' through the run lengths of 'sequenceVector'.
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
   void copyNulls(vector_size_t size);
 
   void fillInIndices();
@@ -188,7 +188,9 @@ void FlatVector<T>::copyValuesAndNulls(
       }
     } else {
       auto* sourceValues = flatSource->rawValues();
-      if (toSourceRow) {
+      if (toSourceRow && rows.isAllSelected()) {
+        gatherValues(sourceValues, rows.begin(), rows.end(), toSourceRow);
+      } else if (toSourceRow) {
         rows.applyToSelected([&](auto row) {
           auto sourceRow = toSourceRow[row];
           VELOX_DCHECK_GT(source->size(), sourceRow);
@@ -285,6 +287,32 @@ void FlatVector<T>::copyValuesAndNulls(
   }
 }
 
+template <typename T>
+void FlatVector<T>::gatherValues(
+    const T* sourceValues,
+    vector_size_t begin,
+    vector_size_t end,
+    const vector_size_t* toSourceRow) {
+  auto row = begin;
+  if constexpr (
+      std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+    using TWord = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+    constexpr int32_t kBatch = xsimd::batch<TWord>::size;
+    // Gather whole batches only so that 'toSourceRow' is not read past 'end'.
+    const auto numGathered = (end - begin) / kBatch * kBatch;
+    if (numGathered > 0) {
+      simd::transpose(
+          reinterpret_cast<const TWord*>(sourceValues),
+          folly::Range<const vector_size_t*>(toSourceRow + begin, numGathered),
+          reinterpret_cast<TWord*>(rawValues_) + begin);
+    }
+    row += numGathered;
+  }
+  for (; row < end; ++row) {
+    rawValues_[row] = sourceValues[toSourceRow[row]];
+  }
+}
+
 template <typename T>
 void FlatVector<T>::copyRanges(
     const BaseVector* source,
@@ -301,12 +329,32 @@ void FlatVector<T>::copyRanges(
     auto leaf =
         source->wrappedVector()->asUnchecked<SimpleVector<StringView>>();
     if (BaseVector::pool_ != leaf->pool()) {
+      // Copy the strings that are not inlined into one new string buffer.
+      size_t totalBytes = 0;
+      applyToEachRow(ranges, [&](auto /*targetIndex*/, auto sourceIndex) {
+        if (!source->isNullAt(sourceIndex)) {
+          const auto value = leaf->valueAt(source->wrappedIndex(sourceIndex));
+          if (!value.isInline()) {
+            totalBytes += value.size();
+          }
+        }
+      });
+      char* buffer =
+          totalBytes > 0 ? getRawStringBufferWithSpace(totalBytes) : nullptr;
+      ensureValues();
       applyToEachRow(ranges, [&](auto targetIndex, auto sourceIndex) {
         if (source->isNullAt(sourceIndex)) {
           this->setNull(targetIndex, true);
+          return;
+        }
+        this->setNull(targetIndex, false);
+        const auto value = leaf->valueAt(source->wrappedIndex(sourceIndex));
+        if (value.isInline()) {
+          rawValues_[targetIndex] = value;
         } else {
-          this->set(
-              targetIndex, leaf->valueAt(source->wrappedIndex(sourceIndex)));
+          std::memcpy(buffer, value.data(), value.size());
+          rawValues_[targetIndex] = StringView(buffer, value.size());
+          buffer += value.size();
         }
       });
       return;
@@ -529,6 +529,15 @@ class FlatVector final : public SimpleVector<T> {
       const SelectivityVector& rows,
       const vector_size_t* toSourceRow);
 
+  // Sets the value of each row in [begin, end) to
+  // sourceValues[toSourceRow[row]]. Uses SIMD gathers for 4 and 8 byte
+  // values.
+  void gatherValues(
+      const T* sourceValues,
+      vector_size_t begin,
+      vector_size_t end,
+      const vector_size_t* toSourceRow);
+
   // Ensures that the values buffer has space for 'newSize' elements and is
   // mutable. Sets elements between the old and new sizes to 'initialValue' if
   // the new size > old size.
@@ -54,6 +54,21 @@ std::string SelectivityVector::toString(
   return out.str();
 }
 
+void SelectivityVector::makeSparseRows() const {
+  const vector_size_t maxRows = (end_ - begin_) / kSparseRatio;
+  sparseRows_.clear();
+  sparse_ = bits::testSetBits(bits_.data(), begin_, end_, [&](auto row) {
+    if (sparseRows_.size() == maxRows) {
+      return false;
+    }
+    sparseRows_.push_back(row);
+    return true;
+  });
+  if (!*sparse_) {
+    sparseRows_.clear();
+  }
+}
+
 void SelectivityVector::copyNulls(uint64_t* dest, const uint64_t* src) const {
   if (isAllSelected()) {
     bits::copyBits(src, 0, dest, 0, size_);
@@ -38,6 +38,15 @@ namespace velox {
 // that where previously filtered by another filter / column
 class SelectivityVector {
  public:
+  /// applyToSelected() and testSelected() iterate over a list of the selected
+  /// rows instead of the bits if at most 1 / kSparseRatio of the rows in
+  /// [begin(), end()) are selected and the range has at least
+  /// kMinSparseRange rows. The list is made on first use and kept until the
+  /// selection changes, so that the bits of a very selective filter result
+  /// are scanned once and not by every expression that uses the result.
+  static constexpr vector_size_t kSparseRatio = 64;
+  static constexpr vector_size_t kMinSparseRange = 1'024;
+
   SelectivityVector() {}
 
   explicit SelectivityVector(vector_size_t length, bool allSelected = true) {
@@ -88,6 +97,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = value ? size_ : 0;
     allSelected_ = value;
+    sparse_.reset();
   }
 
   /**
@@ -99,6 +109,7 @@ class SelectivityVector {
     VELOX_DCHECK_LT(idx, bits_.size() * sizeof(bits_[0]) * 8);
     bits::setBit(bits_.data(), idx, valid);
     allSelected_.reset();
+    sparse_.reset();
   }
 
   /**
@@ -114,6 +125,7 @@ class SelectivityVector {
     VELOX_DCHECK_LE(end, bits_.size() * sizeof(bits_[0]) * 8);
     bits::fillBits(bits_.data(), begin, end, valid);
     allSelected_.reset();
+    sparse_.reset();
   }
 
   /**
@@ -131,6 +143,7 @@ class SelectivityVector {
    * updateBounds() need to be called explicitly if data is modified.
    */
   MutableRange<bool> asMutableRange() {
+    sparse_.reset();
     return MutableRange<bool>(bits_.data(), begin_, end_);
   }
 
@@ -157,6 +170,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = 0;
     allSelected_ = false;
+    sparse_.reset();
   }
 
   /**
@@ -167,6 +181,7 @@ class SelectivityVector {
     begin_ = 0;
     end_ = size_;
     allSelected_ = true;
+    sparse_.reset();
   }
 
   void setFromBits(const uint64_t* bits, int32_t size) {
@@ -283,6 +298,7 @@ class SelectivityVector {
    * index (noting that the range in between may contain not selected indices).
    */
   void updateBounds() {
+    sparse_.reset();
     begin_ = bits::findFirstBit(bits_.data(), 0, size_);
     if (begin_ == -1) {
       begin_ = 0;
@@ -371,6 +387,21 @@ class SelectivityVector {
   }
 
  private:
+  // Returns the selected rows if there are few of them compared to the size of
+  // [begin_, end_) or nullptr if the rows should be read from 'bits_'.
+  const std::vector<vector_size_t>* sparseRows() const {
+    if (end_ - begin_ < kMinSparseRange) {
+      return nullptr;
+    }
+    if (!sparse_.has_value()) {
+      makeSparseRows();
+    }
+    return *sparse_ ? &sparseRows_ : nullptr;
+  }
+
+  // Sets 'sparse_' and 'sparseRows_'.
+  void makeSparseRows() const;
+
   // The vector of bits for what is selected vs not (1 is selected).
   std::vector<uint64_t> bits_;
 
@@ -385,6 +416,13 @@ class SelectivityVector {
 
   mutable std::optional<bool> allSelected_;
 
+  // True if 'sparseRows_' has the selected rows, false if there are too many
+  // selected rows for a list to pay off. Computed on first use and reset
+  // together with 'allSelected_' when the bits change.
+  mutable std::optional<bool> sparse_;
+
+  mutable std::vector<vector_size_t> sparseRows_;
+
   friend class SelectivityIterator;
 };
 
@@ -436,6 +474,10 @@ inline void SelectivityVector::applyToSelected(Callable func) const {
     for (vector_size_t row = begin_; row < end_; ++row) {
       func(row);
     }
+  } else if (const auto* rows = sparseRows()) {
+    for (const auto row : *rows) {
+      func(row);
+    }
   } else {
     bits::forEachSetBit(bits_.data(), begin_, end_, func);
   }
@@ -451,6 +493,14 @@ inline bool SelectivityVector::testSelected(Callable func) const {
     }
     return true;
   }
+  if (const auto* rows = sparseRows()) {
+    for (const auto row : *rows) {
+      if (!func(row)) {
+        return false;
+      }
+    }
+    return true;
+  }
   return bits::testSetBits(bits_.data(), begin_, end_, func);
 }
 
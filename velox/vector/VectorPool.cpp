@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorPool.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox {
 
@@ -84,6 +85,115 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
   return numReleased;
 }
 
+BufferPtr VectorPool::getBuffer(size_t size) {
+  // The smallest size class whose buffers all fit 'size'.
+  const int32_t sizeClass = size <= (1UL << kMinBufferCapacityShift)
+      ? 0
+      : 64 - __builtin_clzll(size - 1) - kMinBufferCapacityShift;
+  if (sizeClass < kNumBufferSizeClasses) {
+    auto& cached = buffers_[sizeClass];
+    if (cached.size > 0) {
+      auto buffer = std::move(cached.buffers[--cached.size]);
+      buffer->setSize(size);
+      return buffer;
+    }
+  }
+  return AlignedBuffer::allocate<char>(size, pool_);
+}
+
+bool VectorPool::releaseBuffer(BufferPtr& buffer) {
+  if (buffer == nullptr || !buffer->unique() || !buffer->isMutable() ||
+      buffer->isView() || buffer->pool() != pool_) {
+    return false;
+  }
+  const auto capacity = buffer->capacity();
+  if (capacity < (1UL << kMinBufferCapacityShift)) {
+    return false;
+  }
+  const int32_t sizeClass =
+      63 - __builtin_clzll(capacity) - kMinBufferCapacityShift;
+  if (sizeClass >= kNumBufferSizeClasses) {
+    return false;
+  }
+  auto& cached = buffers_[sizeClass];
+  if (cached.size >= kNumPerBufferSizeClass) {
+    return false;
+  }
+  cached.buffers[cached.size++] = std::move(buffer);
+  return true;
+}
+
+size_t VectorPool::releaseBuffers(VectorPtr& vector) {
+  if (vector == nullptr || !vector.unique() || vector->pool() != pool_) {
+    return 0;
+  }
+  if (release(vector)) {
+    return 1;
+  }
+
+  // Copies the buffers and children out of 'vector' so that they become
+  // singly referenced once 'vector' is freed.
+  std::vector<BufferPtr> buffers;
+  std::vector<VectorPtr> children;
+  buffers.push_back(vector->nulls());
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      buffers.push_back(vector->values());
+      if (vector->typeKind() == TypeKind::VARCHAR ||
+          vector->typeKind() == TypeKind::VARBINARY) {
+        for (const auto& stringBuffer :
+             vector->asFlatVector<StringView>()->stringBuffers()) {
+          buffers.push_back(stringBuffer);
+        }
+      }
+      break;
+    case VectorEncoding::Simple::DICTIONARY:
+      buffers.push_back(vector->wrapInfo());
+      children.push_back(vector->valueVector());
+      break;
+    case VectorEncoding::Simple::ARRAY: {
+      auto* arrayVector = vector->asUnchecked<ArrayVector>();
+      buffers.push_back(arrayVector->offsets());
+      buffers.push_back(arrayVector->sizes());
+      children.push_back(arrayVector->elements());
+      break;
+    }
+    case VectorEncoding::Simple::MAP: {
+      auto* mapVector = vector->asUnchecked<MapVector>();
+      buffers.push_back(mapVector->offsets());
+      buffers.push_back(mapVector->sizes());
+      children.push_back(mapVector->mapKeys());
+      children.push_back(mapVector->mapValues());
+      break;
+    }
+    case VectorEncoding::Simple::ROW:
+      children = vector->asUnchecked<RowVector>()->children();
+      break;
+    default:
+      break;
+  }
+  vector.reset();
+
+  size_t numReleased = 0;
+  for (auto& buffer : buffers) {
+    if (releaseBuffer(buffer)) {
+      ++numReleased;
+    }
+  }
+  for (auto& child : children) {
+    numReleased += releaseBuffers(child);
+  }
+  return numReleased;
+}
+
+size_t VectorPool::numCachedBuffers() const {
+  size_t numBuffers = 0;
+  for (const auto& cached : buffers_) {
+    numBuffers += cached.size;
+  }
+  return numBuffers;
+}
+
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
   // values Buffer and an uninitialized or unique and mutable nulls Buffer.
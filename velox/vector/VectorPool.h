@@ -27,6 +27,11 @@ namespace facebook::velox {
 /// type, complex and custom types are not supported. Calling 'get' for an
 /// unsupported type already returns a newly allocated vector. Calling 'release'
 /// for an unsupported type is a no-op.
+///
+/// Also caches up to 4 buffers per power of two capacity between 1KB and 4MB
+/// for use as nulls, dictionary indices, offsets, sizes or string data. The
+/// buffers come from vectors given to 'releaseBuffers' and from
+/// 'releaseBuffer'.
 class VectorPool {
  public:
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
@@ -42,6 +47,27 @@ class VectorPool {
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  /// Returns a buffer with at least 'size' bytes of capacity and size set to
+  /// 'size'. The buffer is recycled if one of sufficient capacity is cached,
+  /// else allocated from 'pool_'. The contents are not initialized.
+  BufferPtr getBuffer(size_t size);
+
+  /// Moves 'buffer' into 'this' if it is singly referenced, mutable, not a
+  /// view, allocated from 'pool_' and there is space. Returns true if
+  /// 'buffer' has been moved into this pool.
+  bool releaseBuffer(BufferPtr& buffer);
+
+  /// Takes the memory of 'vector' if it is singly referenced and allocated
+  /// from 'pool_', and resets 'vector' in that case. Vectors that 'release'
+  /// accepts are cached whole. From the others the nulls, values, string
+  /// buffers, dictionary indices and offsets and sizes go to the buffer
+  /// cache, recursing into children and dictionary base vectors. Returns the
+  /// number of vectors and buffers that were moved into this pool.
+  size_t releaseBuffers(VectorPtr& vector);
+
+  /// Returns the number of buffers in the buffer cache.
+  size_t numCachedBuffers() const;
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
@@ -60,6 +86,17 @@ class VectorPool {
         memory::MemoryPool& pool);
   };
 
+  /// Capacity of the smallest buffer size class. Smaller buffers are not worth
+  /// recycling.
+  static constexpr int32_t kMinBufferCapacityShift = 10;
+  static constexpr int32_t kNumBufferSizeClasses = 13;
+  static constexpr int32_t kNumPerBufferSizeClass = 4;
+
+  struct BufferSizeClass {
+    int32_t size{0};
+    std::array<BufferPtr, kNumPerBufferSizeClass> buffers;
+  };
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +104,10 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of recycled buffers. Size class i holds buffers with a capacity of
+  /// at least 2^(kMinBufferCapacityShift + i) bytes.
+  std::array<BufferSizeClass, kNumBufferSizeClasses> buffers_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -133,6 +133,12 @@ class BatchVectorSerializer {
 
   /// Serializes all rows in a vector.
   void serialize(const RowVectorPtr& vector, OutputStream* stream);
+
+  /// Returns serializer-dependent counters accumulated over all serialize()
+  /// calls, e.g. about compression.
+  virtual std::unordered_map<std::string, RuntimeCounter> runtimeStats() {
+    return {};
+  }
 };
 
 class VectorSerde {
@@ -30,18 +30,24 @@ namespace facebook::velox {
 
 namespace {
 
-// The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
-static constexpr size_t kMaxBuffers{3};
+// Most supported conversions use one buffer for nulls (0), one for values (1),
+// and one for offsets (2). The string view layout uses a variable number of
+// buffers.
+static constexpr size_t kDefaultNumBuffers{3};
 
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kDefaultNumBuffers, nullptr),
+        bufferPtrs_(kDefaultNumBuffers) {}
+
+  // Makes room for `numBuffers` buffers. Must be called before the buffers
+  // are set.
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers, nullptr);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -58,7 +64,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -89,11 +95,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -249,9 +255,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
     case TypeKind::UNKNOWN:
       return "n"; // NullType
     case TypeKind::TIMESTAMP:
@@ -548,6 +554,80 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Element of the Arrow Utf8View and BinaryView layouts. Strings of up to 12
+// bytes are inlined the same way as in StringView. Longer strings keep a 4 byte
+// prefix and reference their data by buffer index and offset instead of a
+// pointer.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[StringView::kPrefixSize];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+
+// Imports strings in the Arrow view layout. The string buffers are wrapped
+// without copying. Only the views are converted because Velox references
+// strings that are not inlined by pointer.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto numStringBuffers = arrowArray.n_buffers - 3;
+  const auto* sizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  std::vector<BufferPtr> stringBuffers;
+  stringBuffers.reserve(numStringBuffers);
+  for (auto i = 0; i < numStringBuffers; ++i) {
+    stringBuffers.emplace_back(
+        wrapInBufferView(arrowArray.buffers[2 + i], sizes[i]));
+  }
+
+  const auto length = arrowArray.length;
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  const auto* views =
+      static_cast<const ArrowStringView*>(arrowArray.buffers[1]);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  for (auto i = 0; i < length; ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+      continue;
+    }
+    const auto& view = views[i];
+    if (StringView::isInline(view.size)) {
+      std::memcpy(&rawStringViews[i], &view, sizeof(StringView));
+    } else {
+      VELOX_USER_CHECK(
+          view.bufferIndex >= 0 && view.bufferIndex < numStringBuffers,
+          "Invalid string view buffer index: {}",
+          view.bufferIndex);
+      rawStringViews[i] = StringView(
+          static_cast<const char*>(arrowArray.buffers[2 + view.bufferIndex]) +
+              view.offset,
+          view.size);
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 // This functions does two things: (a) sets the value of null_count, and (b)
 // the validity buffer (if there is at least one null row).
 void exportValidityBitmap(
@@ -664,6 +744,100 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Exports strings in the Arrow view layout. The buffers are nulls (0), views
+// (1), the string buffers of 'vec' (2 to n - 2) and the sizes of the string
+// buffers (n - 1). Only the views are copied. Strings outside of the string
+// buffers of 'vec' are copied into one extra string buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  std::vector<std::pair<const char*, int32_t>> bufferStarts;
+  bufferStarts.reserve(stringBuffers.size());
+  for (int32_t i = 0; i < stringBuffers.size(); ++i) {
+    bufferStarts.emplace_back(stringBuffers[i]->as<char>(), i);
+  }
+  std::sort(bufferStarts.begin(), bufferStarts.end());
+
+  // Returns the index of the string buffer that contains 'value' or -1.
+  auto findBuffer = [&](const StringView& value) -> int32_t {
+    auto it = std::upper_bound(
+        bufferStarts.begin(),
+        bufferStarts.end(),
+        std::make_pair(value.data(), std::numeric_limits<int32_t>::max()));
+    if (it == bufferStarts.begin()) {
+      return -1;
+    }
+    --it;
+    const size_t offset = value.data() - it->first;
+    if (offset + value.size() > stringBuffers[it->second]->size() ||
+        offset > std::numeric_limits<int32_t>::max()) {
+      return -1;
+    }
+    return it->second;
+  };
+
+  holder.setBuffer(
+      1,
+      AlignedBuffer::allocate<uint8_t>(
+          checkedMultiply<size_t>(out.length, sizeof(ArrowStringView)), pool));
+  auto* views = holder.getBufferAs<ArrowStringView>(1);
+  std::vector<StringView> copied;
+  size_t copiedSize = 0;
+  vector_size_t j = 0; // index into views
+  rows.apply([&](vector_size_t i) {
+    auto& view = views[j++];
+    if (vec.isNullAt(i)) {
+      std::memset(&view, 0, sizeof(view));
+      return;
+    }
+    const auto value = vec.valueAtFast(i);
+    if (value.isInline()) {
+      std::memcpy(&view, &value, sizeof(view));
+      return;
+    }
+    view.size = value.size();
+    std::memcpy(view.prefix, value.data(), sizeof(view.prefix));
+    view.bufferIndex = findBuffer(value);
+    if (view.bufferIndex >= 0) {
+      view.offset = value.data() - stringBuffers[view.bufferIndex]->as<char>();
+    } else {
+      view.bufferIndex = stringBuffers.size();
+      view.offset = copiedSize;
+      copied.push_back(value);
+      copiedSize += value.size();
+      VELOX_CHECK_LT(copiedSize, std::numeric_limits<int32_t>::max());
+    }
+  });
+
+  const auto numStringBuffers = stringBuffers.size() + (copied.empty() ? 0 : 1);
+  out.n_buffers = 3 + numStringBuffers;
+  holder.resizeBuffers(out.n_buffers);
+  out.buffers = holder.getArrowBuffers();
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+  }
+  if (!copied.empty()) {
+    auto buffer = AlignedBuffer::allocate<char>(copiedSize, pool);
+    auto* rawBuffer = buffer->asMutable<char>();
+    for (const auto& value : copied) {
+      std::memcpy(rawBuffer, value.data(), value.size());
+      rawBuffer += value.size();
+    }
+    holder.setBuffer(2 + stringBuffers.size(), buffer);
+  }
+  auto sizes = AlignedBuffer::allocate<int64_t>(numStringBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (auto i = 0; i < numStringBuffers; ++i) {
+    rawSizes[i] =
+        i < stringBuffers.size() ? stringBuffers[i]->size() : copiedSize;
+  }
+  holder.setBuffer(2 + numStringBuffers, sizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
@@ -688,8 +862,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -734,16 +921,6 @@ void exportRows(
   }
 }
 
-template <typename Vector>
-bool isCompact(const Vector& vec) {
-  for (vector_size_t i = 1; i < vec.size(); ++i) {
-    if (vec.offsetAt(i - 1) + vec.sizeAt(i - 1) != vec.offsetAt(i)) {
-      return false;
-    }
-  }
-  return true;
-}
-
 template <typename Vector>
 void exportOffsets(
     const Vector& vec,
@@ -755,7 +932,7 @@ void exportOffsets(
   auto offsets = AlignedBuffer::allocate<vector_size_t>(
       checkedPlus<size_t>(out.length, 1), pool);
   auto rawOffsets = offsets->asMutable<vector_size_t>();
-  if (!rows.changed() && isCompact(vec)) {
+  if (!rows.changed() && vec.hasContiguousRanges(0, vec.size())) {
     memcpy(rawOffsets, vec.rawOffsets(), sizeof(vector_size_t) * vec.size());
     rawOffsets[vec.size()] = vec.size() == 0
         ? 0
@@ -1077,6 +1254,16 @@ TypePtr importFromArrowImpl(
     case 'U':
       return VARCHAR();
 
+    // Utf8View and BinaryView.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     // Same for binary.
     case 'z':
     case 'Z':
@@ -1660,6 +1847,10 @@ bool isREE(const ArrowSchema& arrowSchema) {
   return arrowSchema.format[0] == '+' && arrowSchema.format[1] == 'r';
 }
 
+bool isStringView(const ArrowSchema& arrowSchema) {
+  return arrowSchema.format[0] == 'v';
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1712,6 +1903,10 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
+  if (isStringView(arrowSchema)) {
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  }
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
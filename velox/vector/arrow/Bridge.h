@@ -36,6 +36,10 @@ struct ArrowOptions {
   bool flattenDictionary{false};
   bool flattenConstant{false};
   TimestampUnit timestampUnit = TimestampUnit::kNano;
+  /// If true, VARCHAR and VARBINARY are exported in the Arrow Utf8View and
+  /// BinaryView layouts, which share the string buffers of the Velox vector
+  /// instead of copying the strings into a single buffer.
+  bool exportToStringView{false};
 };
 
 namespace facebook::velox {
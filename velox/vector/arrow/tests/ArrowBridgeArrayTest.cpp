@@ -1543,6 +1543,57 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
     });
   }
 
+  void testImportStringView() {
+    options_.exportToStringView = true;
+
+    // Strings in two string buffers. Strings longer than 12 bytes are not
+    // inlined.
+    auto first = vectorMaker_.flatVectorNullable<std::string>({
+        "short",
+        "a string which is not inlined",
+        std::nullopt,
+        "",
+    });
+    auto second = vectorMaker_.flatVectorNullable<std::string>({
+        std::nullopt,
+        "another string which is not inlined",
+        "twelve bytes",
+        "thirteen byte",
+    });
+    auto vector = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), first->size() + second->size(), pool_.get());
+    vector->copy(first.get(), 0, 0, first->size());
+    vector->copy(second.get(), first->size(), 0, second->size());
+    ASSERT_EQ(2, vector->stringBuffers().size());
+
+    ArrowSchema arrowSchema;
+    ArrowArray arrowArray;
+    velox::exportToArrow(vector, arrowSchema, options_);
+    velox::exportToArrow(vector, arrowArray, pool_.get(), options_);
+    EXPECT_STREQ("vu", arrowSchema.format);
+    // Nulls, views, the two string buffers and their sizes.
+    EXPECT_EQ(5, arrowArray.n_buffers);
+
+    auto result = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    test::assertEqualVectors(vector, result);
+
+    // Strings that are not inlined are not copied.
+    auto* flatResult = result->asFlatVector<StringView>();
+    for (auto i = 0; i < vector->size(); ++i) {
+      if (!vector->isNullAt(i) && !vector->valueAt(i).isInline()) {
+        EXPECT_EQ(vector->valueAt(i).data(), flatResult->valueAt(i).data());
+      }
+    }
+
+    if (isViewer()) {
+      arrowArray.release(&arrowArray);
+      arrowSchema.release(&arrowSchema);
+    } else {
+      EXPECT_EQ(arrowArray.release, nullptr);
+      EXPECT_EQ(arrowSchema.release, nullptr);
+    }
+  }
+
   void testImportREE() {
     testImportREENoRuns();
     testImportREESingleRun();
@@ -1752,6 +1803,10 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
   testImportRow();
 }
@@ -1805,6 +1860,10 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
   testImportRow();
 }
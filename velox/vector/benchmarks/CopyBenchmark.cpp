@@ -360,6 +360,51 @@ BENCHMARK_MULTI(copyStructNonContiguous) {
   return kIter * kSize;
 }
 
+BENCHMARK_MULTI(copyBigintWithIndices) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{
+      memory::memoryManager()->addLeafPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+  constexpr vector_size_t kSize = 10'000;
+  auto source = vectorMaker.flatVector<int64_t>(kSize, folly::identity);
+  std::vector<vector_size_t> toSourceRow(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    toSourceRow[i] = (i * 31) % kSize;
+  }
+  auto target = BaseVector::create(BIGINT(), kSize, pool.get());
+  SelectivityVector rows(kSize);
+  suspender.dismiss();
+  constexpr int kIter = 100;
+  for (int i = 0; i < kIter; ++i) {
+    target->copy(source.get(), rows, toSourceRow.data());
+  }
+  return kIter * kSize;
+}
+
+BENCHMARK_MULTI(copyVarcharRangesAcrossPools) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{
+      memory::memoryManager()->addLeafPool()};
+  std::shared_ptr<memory::MemoryPool> sourcePool{
+      memory::memoryManager()->addLeafPool()};
+  test::VectorMaker vectorMaker{sourcePool.get()};
+  constexpr vector_size_t kSize = 2'000;
+  auto source = vectorMaker.flatVector<std::string>(kSize, [](auto row) {
+    return std::string(4 + row % 40, 'a' + row % 26);
+  });
+  std::vector<BaseVector::CopyRange> ranges;
+  for (int i = 0; i < kSize; i += 2) {
+    ranges.push_back({i, i / 2, 1});
+  }
+  suspender.dismiss();
+  constexpr int kIter = 100;
+  for (int i = 0; i < kIter; ++i) {
+    auto target = BaseVector::create(VARCHAR(), kSize / 2, pool.get());
+    target->copyRanges(source.get(), ranges);
+  }
+  return kIter * kSize / 2;
+}
+
 } // namespace
 } // namespace facebook::velox
 
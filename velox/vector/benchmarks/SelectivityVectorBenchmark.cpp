@@ -300,6 +300,34 @@ BENCHMARK_PARAM(BM_operatorEquals, 1000000);
 BENCHMARK_PARAM(BM_operatorEquals, 10000000);
 BENCHMARK_DRAW_LINE();
 
+// applyToSelected Tests
+
+// Iterates 10 times over a vector with one row in 1000 selected, as done by
+// the expressions downstream of a very selective filter.
+void BM_applyToSelectedSparse(uint32_t iterations, size_t numEntries) {
+  folly::BenchmarkSuspender suspender;
+  SelectivityVector vector(numEntries, false);
+  for (size_t i = 0; i < numEntries; i += 1'000) {
+    vector.setValid(i, true);
+  }
+  vector.updateBounds();
+  suspender.dismiss();
+
+  size_t sum = 0;
+  for (uint32_t i = 0; i < iterations; ++i) {
+    for (auto j = 0; j < 10; ++j) {
+      vector.applyToSelected([&](auto row) { sum += row; });
+    }
+  }
+  folly::doNotOptimizeAway(sum);
+  suspender.rehire();
+}
+
+BENCHMARK_PARAM(BM_applyToSelectedSparse, 1000);
+BENCHMARK_PARAM(BM_applyToSelectedSparse, 10000);
+BENCHMARK_PARAM(BM_applyToSelectedSparse, 1000000);
+BENCHMARK_DRAW_LINE();
+
 } // namespace test
 } // namespace velox
 } // namespace facebook
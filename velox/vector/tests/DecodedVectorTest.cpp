@@ -19,6 +19,7 @@
 #include <gflags/gflags.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <numeric>
 #include <optional>
 
 #include "velox/type/Variant.h"
@@ -674,6 +675,115 @@ TEST_F(DecodedVectorTest, dictionaryOverConstant) {
   testDictionaryOverConstant(arrayVector, 5); // null
 }
 
+TEST_F(DecodedVectorTest, nestedDictionariesWithNulls) {
+  const vector_size_t size = 1'001;
+  VectorPtr vector =
+      makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  // Three levels of dictionaries, the middle one adds nulls.
+  vector = wrapInDictionary(
+      makeIndices(size, [](auto row) { return (row * 7) % size; }),
+      size,
+      vector);
+  vector = BaseVector::wrapInDictionary(
+      makeNulls(size, [](auto row) { return row % 11 == 0; }),
+      makeIndices(size, [](auto row) { return size - 1 - row; }),
+      size,
+      vector);
+  vector = wrapInDictionary(
+      makeIndices(size, [](auto row) { return (row * 3) % size; }),
+      size,
+      vector);
+  auto* simpleVector = vector->as<SimpleVector<int64_t>>();
+
+  auto assertDecoded = [&](const SelectivityVector& rows) {
+    DecodedVector decoded(*vector, rows);
+    rows.applyToSelected([&](auto row) {
+      ASSERT_EQ(simpleVector->isNullAt(row), decoded.isNullAt(row)) << row;
+      if (!decoded.isNullAt(row)) {
+        ASSERT_EQ(simpleVector->valueAt(row), decoded.valueAt<int64_t>(row))
+            << row;
+      }
+    });
+  };
+
+  assertDecoded(SelectivityVector(size));
+
+  SelectivityVector rows(size);
+  rows.setValidRange(0, 10, false);
+  rows.updateBounds();
+  assertDecoded(rows);
+
+  rows.setAll();
+  rows.setValid(500, false);
+  rows.updateBounds();
+  assertDecoded(rows);
+}
+
+TEST_F(DecodedVectorTest, sequence) {
+  std::vector<std::optional<int32_t>> data = {
+      1, 1, 1, std::nullopt, 2, 2, std::nullopt, std::nullopt, 3, 1};
+  auto sequence = vectorMaker_.sequenceVector<int32_t>(data);
+  ASSERT_EQ(VectorEncoding::Simple::SEQUENCE, sequence->encoding());
+
+  auto assertDecoded = [&](const DecodedVector& decoded,
+                           const std::vector<vector_size_t>& rows,
+                           auto toDataIndex) {
+    ASSERT_FALSE(decoded.isIdentityMapping());
+    ASSERT_FALSE(decoded.isConstantMapping());
+    for (auto row : rows) {
+      const auto& expected = data[toDataIndex(row)];
+      ASSERT_EQ(!expected.has_value(), decoded.isNullAt(row)) << row;
+      if (expected.has_value()) {
+        ASSERT_EQ(expected.value(), decoded.valueAt<int32_t>(row)) << row;
+      }
+    }
+  };
+
+  std::vector<vector_size_t> allRows(data.size());
+  std::iota(allRows.begin(), allRows.end(), 0);
+  auto identity = [](auto row) { return row; };
+  {
+    DecodedVector decoded(*sequence);
+    assertDecoded(decoded, allRows, identity);
+  }
+
+  // Decode a subset of rows.
+  {
+    SelectivityVector rows(data.size(), false);
+    rows.setValid(2, true);
+    rows.setValid(5, true);
+    rows.setValid(9, true);
+    rows.updateBounds();
+    DecodedVector decoded(*sequence, rows);
+    assertDecoded(decoded, {2, 5, 9}, identity);
+  }
+
+  // Dictionary over sequence.
+  {
+    auto dictionary = wrapInDictionary(
+        makeIndicesInReverse(data.size()), data.size(), sequence);
+    DecodedVector decoded(*dictionary);
+    assertDecoded(decoded, allRows, [&](auto row) {
+      return data.size() - 1 - row;
+    });
+  }
+
+  // Sequence over dictionary. Rows 0-2 are data[8], rows 3-5 are data[4] and
+  // rows 6-9 are data[3].
+  {
+    auto dictionary = wrapInDictionary(
+        makeIndices({8, 4, 3}),
+        3,
+        vectorMaker_.flatVectorNullable<int32_t>(data));
+    auto sequenceOverDictionary = std::make_shared<SequenceVector<int32_t>>(
+        pool(), data.size(), dictionary, makeIndices({3, 3, 4}));
+    DecodedVector decoded(*sequenceOverDictionary);
+    assertDecoded(decoded, allRows, [](auto row) {
+      return row < 3 ? 8 : (row < 6 ? 4 : 3);
+    });
+  }
+}
+
 TEST_F(DecodedVectorTest, wrapOnDictionaryEncoding) {
   // This test exercises the use-case of unnesting the children of a rowVector
   // and making sure the wrap over the row vector is correctly applied on its
@@ -619,4 +619,70 @@ TEST(SelectivityVectorTest, copyNulls) {
   }
 }
 
+TEST(SelectivityVectorTest, sparse) {
+  constexpr vector_size_t kSize = 10'000;
+  auto expectRows = [](const SelectivityVector& rows,
+                       const std::vector<vector_size_t>& expected) {
+    std::vector<vector_size_t> actual;
+    rows.applyToSelected([&](auto row) { actual.push_back(row); });
+    ASSERT_EQ(expected, actual);
+    actual.clear();
+    rows.testSelected([&](auto row) {
+      actual.push_back(row);
+      return true;
+    });
+    ASSERT_EQ(expected, actual);
+    ASSERT_EQ(expected.size(), rows.countSelected());
+  };
+
+  SelectivityVector rows(kSize, false);
+  std::vector<vector_size_t> expected;
+  for (auto i = 3; i < kSize; i += 997) {
+    rows.setValid(i, true);
+    expected.push_back(i);
+  }
+  rows.updateBounds();
+  expectRows(rows, expected);
+  // Iterate again over the cached list.
+  expectRows(rows, expected);
+
+  // Changes to the bits are seen by the next iteration.
+  rows.setValid(5, true);
+  rows.setValid(3, false);
+  rows.updateBounds();
+  expected[0] = 5;
+  expectRows(rows, expected);
+
+  auto copy = rows;
+  expectRows(copy, expected);
+
+  bits::setBit(rows.asMutableRange().bits(), 6);
+  rows.updateBounds();
+  expected.insert(expected.begin() + 1, 6);
+  expectRows(rows, expected);
+
+  // Stop early.
+  std::vector<vector_size_t> actual;
+  ASSERT_FALSE(rows.testSelected([&](auto row) {
+    actual.push_back(row);
+    return actual.size() < 3;
+  }));
+  ASSERT_EQ(
+      std::vector<vector_size_t>(expected.begin(), expected.begin() + 3),
+      actual);
+
+  // Too many rows for a list.
+  rows.setValidRange(100, 1'000, true);
+  rows.updateBounds();
+  expected.clear();
+  rows.applyToSelected([&](auto row) { expected.push_back(row); });
+  ASSERT_EQ(expected.size(), rows.countSelected());
+  expectRows(rows, expected);
+
+  rows.clearAll();
+  expectRows(rows, {});
+  rows.setAll();
+  ASSERT_EQ(kSize, rows.countSelected());
+}
+
 } // namespace facebook::velox
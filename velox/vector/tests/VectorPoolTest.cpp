@@ -136,6 +136,58 @@ TEST_F(VectorPoolTest, vectorRecycler) {
   }
 }
 
+TEST_F(VectorPoolTest, buffers) {
+  VectorPool vectorPool(pool());
+
+  auto buffer = vectorPool.getBuffer(3'000);
+  ASSERT_EQ(buffer->size(), 3'000);
+  auto* bufferPtr = buffer.get();
+  ASSERT_TRUE(vectorPool.releaseBuffer(buffer));
+  ASSERT_EQ(buffer, nullptr);
+  ASSERT_EQ(vectorPool.numCachedBuffers(), 1);
+
+  // A larger size than the capacity of the cached buffer allocates.
+  auto largeBuffer = vectorPool.getBuffer(100'000);
+  ASSERT_NE(largeBuffer.get(), bufferPtr);
+  auto recycled = vectorPool.getBuffer(2'000);
+  ASSERT_EQ(recycled.get(), bufferPtr);
+  ASSERT_EQ(recycled->size(), 2'000);
+  ASSERT_EQ(vectorPool.numCachedBuffers(), 0);
+
+  // Shared and small buffers are not recycled.
+  auto copy = recycled;
+  ASSERT_FALSE(vectorPool.releaseBuffer(recycled));
+  auto small = AlignedBuffer::allocate<char>(100, pool());
+  ASSERT_FALSE(vectorPool.releaseBuffer(small));
+}
+
+TEST_F(VectorPoolTest, releaseBuffers) {
+  VectorPool vectorPool(pool());
+
+  // A dictionary over an array gives its indices, nulls, offsets and sizes
+  // to the buffer cache and its flat elements to the vector cache.
+  auto base = makeArrayVector<int64_t>(
+      1'000, [](auto row) { return row % 5; }, [](auto row) { return row; });
+  auto* elementsPtr = base->elements().get();
+  auto indices = makeIndices(1'000, [](auto row) { return row; });
+  auto nulls = allocateNulls(10'000, pool());
+  VectorPtr dictionary =
+      BaseVector::wrapInDictionary(nulls, indices, 1'000, base);
+  base.reset();
+  indices.reset();
+  nulls.reset();
+  ASSERT_EQ(vectorPool.releaseBuffers(dictionary), 5);
+  ASSERT_EQ(dictionary, nullptr);
+  ASSERT_EQ(vectorPool.numCachedBuffers(), 4);
+  ASSERT_EQ(vectorPool.get(BIGINT(), 100).get(), elementsPtr);
+
+  // A vector referenced elsewhere is left in place.
+  auto flat = makeFlatVector<int64_t>(1'000, [](auto row) { return row; });
+  auto copy = flat;
+  ASSERT_EQ(vectorPool.releaseBuffers(flat), 0);
+  ASSERT_NE(flat, nullptr);
+}
+
 TEST_F(VectorPoolTest, customTypes) {
   VectorPool vectorPool(pool());
 
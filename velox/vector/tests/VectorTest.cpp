@@ -3070,6 +3070,74 @@ TEST_F(VectorTest, toCopyRanges) {
   testRoundTrip();
 }
 
+TEST_F(VectorTest, copyWithToSourceRow) {
+  const vector_size_t size = 1'003;
+  std::vector<vector_size_t> toSourceRow(size);
+  for (auto i = 0; i < size; ++i) {
+    toSourceRow[i] = (i * 7) % size;
+  }
+
+  auto test = [&](const VectorPtr& source) {
+    SCOPED_TRACE(source->type()->toString());
+    auto target = BaseVector::create(source->type(), size, pool());
+    SelectivityVector allRows(size);
+    target->copy(source.get(), allRows, toSourceRow.data());
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_TRUE(target->equalValueAt(source.get(), i, toSourceRow[i])) << i;
+    }
+
+    // Partial selection.
+    target = BaseVector::create(source->type(), size, pool());
+    SelectivityVector rows(size);
+    rows.setValidRange(0, 5, false);
+    rows.updateBounds();
+    target->copy(source.get(), rows, toSourceRow.data());
+    rows.applyToSelected([&](auto row) {
+      ASSERT_TRUE(target->equalValueAt(source.get(), row, toSourceRow[row]))
+          << row;
+    });
+  };
+
+  test(makeFlatVector<int32_t>(size, [](auto row) { return row; }));
+  test(makeFlatVector<int64_t>(size, [](auto row) { return row * 3; }));
+  test(makeFlatVector<float>(size, [](auto row) { return row * 0.5; }));
+  test(makeFlatVector<double>(size, [](auto row) { return row * 0.25; }));
+  test(makeFlatVector<int16_t>(size, [](auto row) { return row; }));
+  test(makeFlatVector<int64_t>(
+      size, [](auto row) { return row; }, nullEvery(5)));
+}
+
+TEST_F(VectorTest, copyRangesStringsFromOtherPool) {
+  auto otherPool = memory::memoryManager()->addLeafPool();
+  test::VectorMaker otherMaker(otherPool.get());
+  auto source = otherMaker.flatVectorNullable<std::string>({
+      "short",
+      std::nullopt,
+      "a string which is not inlined",
+      "another string which is not inlined",
+      "",
+  });
+
+  auto target = BaseVector::create(VARCHAR(), 6, pool());
+  std::vector<BaseVector::CopyRange> ranges = {{0, 1, 2}, {2, 3, 3}};
+  target->copyRanges(source.get(), ranges);
+  source.reset();
+  otherPool.reset();
+
+  auto expected = makeNullableFlatVector<std::string>({
+      std::nullopt,
+      "short",
+      std::nullopt,
+      "a string which is not inlined",
+      "another string which is not inlined",
+      "",
+  });
+  target->setNull(0, true);
+  test::assertEqualVectors(expected, target);
+  // The strings that are not inlined are copied into one buffer.
+  ASSERT_EQ(1, target->asFlatVector<StringView>()->stringBuffers().size());
+}
+
 TEST_F(VectorTest, rowCopyRanges) {
   RowVectorPtr rowVectorDest = makeRowVector(
       {makeFlatVector<int32_t>({1, 2}), makeFlatVector<int32_t>({1, 2})});
@@ -3805,5 +3873,38 @@ TEST_F(VectorTest, arrayCopyTargetNullOffsets) {
   test::assertEqualVectors(source, target);
 }
 
+TEST_F(VectorTest, copyContiguousArrayRanges) {
+  auto source = makeArrayVector<int64_t>(
+      100, [](auto i) { return i % 5; }, [](auto i, auto j) { return i + j; });
+  auto* sourceArray = source->asUnchecked<ArrayVector>();
+  ASSERT_TRUE(sourceArray->hasContiguousRanges(0, source->size()));
+
+  auto target = BaseVector::create(source->type(), 200, pool());
+  std::vector<BaseVector::CopyRange> ranges = {
+      {10, 0, 50}, {0, 50, 1}, {60, 100, 40}, {60, 150, 40}};
+  target->copyRanges(source.get(), ranges);
+  for (const auto& range : ranges) {
+    for (auto i = 0; i < range.count; ++i) {
+      ASSERT_TRUE(target->equalValueAt(
+          source.get(), range.targetIndex + i, range.sourceIndex + i));
+    }
+  }
+  auto* targetArray = target->asUnchecked<ArrayVector>();
+  ASSERT_TRUE(targetArray->hasContiguousRanges(0, 51));
+  ASSERT_FALSE(targetArray->hasContiguousRanges(0, source->size()));
+
+  // Swapping the ranges of two rows makes the offsets non-contiguous.
+  auto* offsets = sourceArray->offsets()->asMutable<vector_size_t>();
+  auto* sizes = sourceArray->sizes()->asMutable<vector_size_t>();
+  std::swap(offsets[1], offsets[2]);
+  std::swap(sizes[1], sizes[2]);
+  ASSERT_FALSE(sourceArray->hasContiguousRanges(0, 3));
+  ASSERT_TRUE(sourceArray->hasContiguousRanges(3, source->size()));
+  target->copy(source.get(), 0, 0, 10);
+  for (auto i = 0; i < 10; ++i) {
+    ASSERT_TRUE(target->equalValueAt(source.get(), i, i));
+  }
+}
+
 } // namespace
 } // namespace facebook::velox